@@ -0,0 +1,5 @@
+SOURCES = sha.cpp
+CONFIG -= qt dylib release debug_and_release
+CONFIG += debug console
+isEmpty(QMAKE_CFLAGS_SHA):error("This compiler does not support SHA")
+else:QMAKE_CXXFLAGS += $$QMAKE_CFLAGS_SHA
@@ -182,3 +182,19 @@ struct Scaled
 QList<QImage> images = ...;
 QFuture<QImage> thumbnails = QtConcurrent::mapped(images, Scaled(100));
 //! [14]
+
+//! [15]
+QList<QImage> images = ...;
+
+// scaling takes about 2 ms per image
+QFuture<QImage> thumbnails = QtConcurrent::mapped(images, scaled,
+                                                  QtConcurrent::ChunkingPolicy::adaptive(2000000));
+
+// the work per item varies a lot: hand out ever smaller blocks
+QtConcurrent::map(images, normalize, QtConcurrent::ChunkingPolicy::guided());
+
+QList<int> numbers = ...;
+int sum = QtConcurrent::mappedReduced(numbers, square, add,
+                                      QtConcurrent::OrderedReduce | QtConcurrent::ParallelReduce,
+                                      QtConcurrent::ChunkingPolicy::fixedSize(1024)).result();
+//! [15]
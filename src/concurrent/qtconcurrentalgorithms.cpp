@@ -0,0 +1,146 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+/*!
+    \fn QFuture<void> QtConcurrent::forEach(int begin, int end, Function function, const QtConcurrent::ChunkingPolicy &policy)
+    \since 5.3
+
+    Calls \a function once for each index from \a begin up to, but not
+    including, \a end. The indexes are divided into blocks for the threads
+    as given by \a policy; see QtConcurrent::ChunkingPolicy.
+
+    The \a function is called concurrently and must take the index as an
+    \c int.
+
+    \sa blockingForEach()
+*/
+
+/*!
+    \fn void QtConcurrent::blockingForEach(int begin, int end, Function function, const QtConcurrent::ChunkingPolicy &policy)
+    \since 5.3
+
+    Calls \a function once for each index from \a begin up to, but not
+    including, \a end, with the indexes divided into blocks as given by
+    \a policy.
+
+    \note This function will block until all indexes have been processed.
+
+    \sa forEach()
+*/
+
+/*!
+    \fn QFuture<void> QtConcurrent::sort(RandomAccessIterator begin, RandomAccessIterator end)
+    \since 5.3
+
+    Sorts the items from \a begin to \a end in ascending order, using
+    \c{operator<()}. This is the same as calling sort() with
+    \c{std::less<T>()}.
+*/
+
+/*!
+    \fn QFuture<void> QtConcurrent::sort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+    \since 5.3
+
+    Sorts the items from \a begin to \a end using \a lessThan to compare
+    them, on the threads of the global QThreadPool. The returned future
+    finishes when the items are sorted; they must not be accessed before.
+
+    The sort is stable: items that compare equal keep their order. The
+    items are divided into blocks that are sorted concurrently with
+    std::stable_sort(), and the blocks are then merged in passes. Each
+    merge pass is split into pieces of equal size, so all threads take
+    part until the end. A buffer with room for all items is allocated
+    while sorting, so the item type must have a default constructor.
+
+    \a lessThan is called concurrently and must not modify any state.
+
+    \sa qStableSort()
+*/
+
+/*!
+    \fn QFuture<void> QtConcurrent::inclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, OutputIterator result)
+    \since 5.3
+
+    Writes the running totals of the items from \a begin to \a end to the
+    range starting at \a result, using \c{operator+()}: the first result
+    is the first item, the second the sum of the first two items, and so
+    on.
+
+    \sa exclusiveScan()
+*/
+
+/*!
+    \fn QFuture<void> QtConcurrent::inclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, OutputIterator result, BinaryOperation operation)
+    \since 5.3
+
+    Writes the running reduction of the items from \a begin to \a end with
+    \a operation to the range starting at \a result, on the threads of the
+    global QThreadPool. The result for each item includes the item itself.
+
+    \a operation must be associative, as the items are reduced in blocks
+    that are combined afterwards. It is called with two values of the item
+    type and must return the combined value. \a result must be a random
+    access iterator; it may be equal to \a begin to scan in place.
+*/
+
+/*!
+    \fn QFuture<void> QtConcurrent::exclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, OutputIterator result, T init)
+    \since 5.3
+
+    Writes the running totals of the items from \a begin to \a end to the
+    range starting at \a result, using \c{operator+()}, not including the
+    item itself: the first result is \a init, the second \a init plus the
+    first item, and so on.
+
+    \sa inclusiveScan()
+*/
+
+/*!
+    \fn QFuture<void> QtConcurrent::exclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, OutputIterator result, T init, BinaryOperation operation)
+    \since 5.3
+
+    Writes the running reduction of the items from \a begin to \a end with
+    \a operation, starting with \a init, to the range starting at
+    \a result. The result for each item does not include the item itself.
+
+    \a operation must be associative. \a result must be a random access
+    iterator; it may be equal to \a begin to scan in place.
+*/
@@ -0,0 +1,463 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QTCONCURRENT_ALGORITHMS_H
+#define QTCONCURRENT_ALGORITHMS_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#ifndef QT_NO_CONCURRENT
+
+#include <QtConcurrent/qtconcurrentiteratekernel.h>
+#include <QtConcurrent/qtconcurrentrun.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+
+#ifdef Q_QDOC
+
+namespace QtConcurrent {
+
+    QFuture<void> forEach(int begin, int end, Function function,
+                          const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
+    void blockingForEach(int begin, int end, Function function,
+                         const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
+
+    QFuture<void> sort(RandomAccessIterator begin, RandomAccessIterator end);
+    QFuture<void> sort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan);
+
+    QFuture<void> inclusiveScan(RandomAccessIterator begin, RandomAccessIterator end,
+                                OutputIterator result);
+    QFuture<void> inclusiveScan(RandomAccessIterator begin, RandomAccessIterator end,
+                                OutputIterator result, BinaryOperation operation);
+    QFuture<void> exclusiveScan(RandomAccessIterator begin, RandomAccessIterator end,
+                                OutputIterator result, T init);
+    QFuture<void> exclusiveScan(RandomAccessIterator begin, RandomAccessIterator end,
+                                OutputIterator result, T init, BinaryOperation operation);
+
+} // namespace QtConcurrent
+
+#else
+
+namespace QtConcurrent {
+
+/*
+    Below these sizes, sorting and scanning are done by the calling
+    thread alone; the blocks that the work is divided into are at least
+    as large.
+*/
+enum {
+    MinimumSortBlockSize = 2048,
+    MinimumScanBlockSize = 4096
+};
+
+// An iterator over the integers, so that index ranges can be
+// processed by IterateKernel.
+class IndexIterator
+{
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef int difference_type;
+    typedef const int *pointer;
+    typedef int reference;
+
+    inline IndexIterator(int i) : i(i) { }
+    inline int operator*() const { return i; }
+    inline IndexIterator &operator++() { ++i; return *this; }
+    inline int operator-(const IndexIterator &other) const { return i - other.i; }
+    inline bool operator==(const IndexIterator &other) const { return i == other.i; }
+    inline bool operator!=(const IndexIterator &other) const { return i != other.i; }
+
+    int i;
+};
+
+template <typename Functor>
+class ForEachKernel : public IterateKernel<IndexIterator, void>
+{
+    Functor function;
+public:
+    typedef void ReturnType;
+    ForEachKernel(int begin, int end, Functor _function)
+        : IterateKernel<IndexIterator, void>(begin, end), function(_function)
+    { }
+
+    bool runIterations(IndexIterator sequenceBeginIterator, int beginIndex, int endIndex, void *)
+    {
+        const int first = *sequenceBeginIterator;
+        for (int i = beginIndex; i < endIndex; ++i)
+            function(first + i);
+        return false;
+    }
+};
+
+template <typename Functor>
+inline ThreadEngineStarter<void> startForEach(int begin, int end, Functor function,
+                                              const ChunkingPolicy &policy = ChunkingPolicy())
+{
+    return startThreadEngine(withChunkingPolicy(new ForEachKernel<Functor>(begin, qMax(begin, end), function), policy));
+}
+
+inline int idealBlockCount()
+{
+    // a few blocks per thread, so that threads that finish early can help
+    return qMax(QThreadPool::globalInstance()->maxThreadCount(), 1) * 4;
+}
+
+inline int divideIntoBlocks(int count, int minimumBlockSize)
+{
+    return qMax((count + idealBlockCount() - 1) / idealBlockCount(), minimumBlockSize);
+}
+
+template <typename RandomAccessIterator, typename LessThan>
+struct SortBlocks
+{
+    RandomAccessIterator begin;
+    int count;
+    int blockSize;
+    LessThan lessThan;
+
+    void operator()(int block)
+    {
+        const int first = block * blockSize;
+        std::stable_sort(begin + first, begin + qMin(first + blockSize, count), lessThan);
+    }
+};
+
+/*
+    Returns how many of the first \a k items of the stable merge of \a a
+    (of length \a m) and \a b (of length \a n) come from \a a.
+*/
+template <typename Iterator, typename LessThan>
+int mergeCoRank(int k, Iterator a, int m, Iterator b, int n, LessThan &lessThan)
+{
+    int low = qMax(0, k - n);
+    int high = qMin(k, m);
+    while (low < high) {
+        const int i = low + (high - low) / 2;
+        const int j = k - i;
+        // items of a go first among equal items
+        if (i < m && j > 0 && !lessThan(*(b + (j - 1)), *(a + i)))
+            low = i + 1;
+        else
+            high = i;
+    }
+    return low;
+}
+
+/*
+    One pass of a bottom-up merge sort: merges pairs of sorted runs of
+    length width from source into destination. The output is divided
+    into pieces of blockSize items that are merged independently, so
+    that even the last merge of a sort runs on all threads.
+*/
+template <typename SourceIterator, typename DestinationIterator, typename LessThan>
+struct MergePass
+{
+    SourceIterator source;
+    DestinationIterator destination;
+    int count;
+    int width;
+    int blockSize;
+    LessThan lessThan;
+
+    void operator()(int piece)
+    {
+        const int pieceBegin = piece * blockSize;
+        const int pieceEnd = qMin(pieceBegin + blockSize, count);
+        for (int pairBegin = pieceBegin - pieceBegin % (2 * width); pairBegin < pieceEnd; pairBegin += 2 * width) {
+            const int middle = qMin(pairBegin + width, count);
+            const int pairEnd = qMin(pairBegin + 2 * width, count);
+            const int from = qMax(pieceBegin, pairBegin) - pairBegin;
+            const int to = qMin(pieceEnd, pairEnd) - pairBegin;
+
+            const SourceIterator a = source + pairBegin;
+            const SourceIterator b = source + middle;
+            const int m = middle - pairBegin;
+            const int n = pairEnd - middle;
+            const int i0 = mergeCoRank(from, a, m, b, n, lessThan);
+            const int i1 = mergeCoRank(to, a, m, b, n, lessThan);
+            std::merge(a + i0, a + i1, b + (from - i0), b + (to - i1),
+                       destination + (pairBegin + from), lessThan);
+        }
+    }
+};
+
+template <typename SourceIterator, typename DestinationIterator>
+struct CopyBlocks
+{
+    SourceIterator source;
+    DestinationIterator destination;
+    int count;
+    int blockSize;
+
+    void operator()(int block)
+    {
+        const int first = block * blockSize;
+        std::copy(source + first, source + qMin(first + blockSize, count), destination + first);
+    }
+};
+
+template <typename RandomAccessIterator, typename LessThan>
+void parallelSort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+
+    const int count = int(end - begin);
+    const int blockSize = divideIntoBlocks(count, MinimumSortBlockSize);
+    if (count <= blockSize) {
+        std::stable_sort(begin, end, lessThan);
+        return;
+    }
+    const int blockCount = (count + blockSize - 1) / blockSize;
+
+    SortBlocks<RandomAccessIterator, LessThan> sortBlocks = { begin, count, blockSize, lessThan };
+    startForEach(0, blockCount, sortBlocks, ChunkingPolicy::fixedSize(1)).startBlocking();
+
+    // merge runs back and forth between the sequence and a buffer
+    QVector<T> buffer(count);
+    bool inBuffer = false;
+    for (int width = blockSize; width < count; width *= 2) {
+        if (inBuffer) {
+            MergePass<T *, RandomAccessIterator, LessThan> pass = { buffer.data(), begin, count, width, blockSize, lessThan };
+            startForEach(0, blockCount, pass, ChunkingPolicy::fixedSize(1)).startBlocking();
+        } else {
+            MergePass<RandomAccessIterator, T *, LessThan> pass = { begin, buffer.data(), count, width, blockSize, lessThan };
+            startForEach(0, blockCount, pass, ChunkingPolicy::fixedSize(1)).startBlocking();
+        }
+        inBuffer = !inBuffer;
+    }
+
+    if (inBuffer) {
+        CopyBlocks<T *, RandomAccessIterator> copyBack = { buffer.data(), begin, count, blockSize };
+        startForEach(0, blockCount, copyBack, ChunkingPolicy::fixedSize(1)).startBlocking();
+    }
+}
+
+// Reduces each block of the input to a single value.
+template <typename InputIterator, typename T, typename BinaryOperation>
+struct ScanBlockSums
+{
+    InputIterator begin;
+    T *sums;
+    int count;
+    int blockSize;
+    BinaryOperation operation;
+
+    void operator()(int block)
+    {
+        const int first = block * blockSize;
+        const int last = qMin(first + blockSize, count);
+        T sum = *(begin + first);
+        for (int i = first + 1; i < last; ++i)
+            sum = operation(sum, *(begin + i));
+        sums[block] = sum;
+    }
+};
+
+// Scans each block of the input, starting from the reduction of all
+// blocks before it. Reads each item before writing the result, so that
+// the input may be scanned in place.
+template <typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+struct ScanBlocks
+{
+    InputIterator begin;
+    OutputIterator result;
+    const T *offsets;
+    int count;
+    int blockSize;
+    bool inclusive;
+    BinaryOperation operation;
+
+    void operator()(int block)
+    {
+        const int first = block * blockSize;
+        const int last = qMin(first + blockSize, count);
+        if (inclusive) {
+            T running = block > 0 ? operation(offsets[block], *(begin + first)) : T(*(begin + first));
+            *(result + first) = running;
+            for (int i = first + 1; i < last; ++i) {
+                running = operation(running, *(begin + i));
+                *(result + i) = running;
+            }
+        } else {
+            T running = offsets[block];
+            for (int i = first; i < last; ++i) {
+                const T item = *(begin + i);
+                *(result + i) = running;
+                running = operation(running, item);
+            }
+        }
+    }
+};
+
+/*
+    Scans in three steps: each block is reduced on its own, the block
+    sums are scanned by this thread, and then each block is scanned
+    starting from the reduction of the blocks before it. The operation
+    is called about twice as often as by a sequential scan, but all
+    threads share the work.
+*/
+template <typename InputIterator, typename OutputIterator, typename BinaryOperation>
+void parallelScan(InputIterator begin, InputIterator end, OutputIterator result,
+                  const typename std::iterator_traits<InputIterator>::value_type *init,
+                  BinaryOperation operation)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+
+    const int count = int(end - begin);
+    if (count <= 0)
+        return;
+    const int blockSize = divideIntoBlocks(count, MinimumScanBlockSize);
+    const int blockCount = (count + blockSize - 1) / blockSize;
+
+    QVector<T> offsets(blockCount);
+    if (blockCount > 1) {
+        QVector<T> sums(blockCount);
+        ScanBlockSums<InputIterator, T, BinaryOperation> reduceBlocks = { begin, sums.data(), count, blockSize, operation };
+        startForEach(0, blockCount - 1, reduceBlocks, ChunkingPolicy::fixedSize(1)).startBlocking();
+
+        // offsets[0] is only used by an exclusive scan
+        if (init)
+            offsets[0] = *init;
+        for (int block = 1; block < blockCount; ++block) {
+            offsets[block] = (block > 1 || init) ? operation(offsets.at(block - 1), sums.at(block - 1))
+                                                 : sums.at(0);
+        }
+    } else if (init) {
+        offsets[0] = *init;
+    }
+
+    ScanBlocks<InputIterator, OutputIterator, T, BinaryOperation> scanBlocks = { begin, result, offsets.constData(), count, blockSize, init == 0, operation };
+    startForEach(0, blockCount, scanBlocks, ChunkingPolicy::fixedSize(1)).startBlocking();
+}
+
+template <typename InputIterator, typename OutputIterator, typename BinaryOperation>
+void parallelInclusiveScan(InputIterator begin, InputIterator end, OutputIterator result,
+                           BinaryOperation operation)
+{
+    parallelScan(begin, end, result, 0, operation);
+}
+
+template <typename InputIterator, typename OutputIterator, typename BinaryOperation>
+void parallelExclusiveScan(InputIterator begin, InputIterator end, OutputIterator result,
+                           typename std::iterator_traits<InputIterator>::value_type init,
+                           BinaryOperation operation)
+{
+    parallelScan(begin, end, result, &init, operation);
+}
+
+// forEach() on index ranges
+template <typename Functor>
+QFuture<void> forEach(int begin, int end, Functor function, const ChunkingPolicy &policy = ChunkingPolicy())
+{
+    return startForEach(begin, end, function, policy);
+}
+
+// blocking forEach() on index ranges
+template <typename Functor>
+void blockingForEach(int begin, int end, Functor function, const ChunkingPolicy &policy = ChunkingPolicy())
+{
+    startForEach(begin, end, function, policy).startBlocking();
+}
+
+// sort()
+template <typename RandomAccessIterator, typename LessThan>
+QFuture<void> sort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+{
+    return QtConcurrent::run(&parallelSort<RandomAccessIterator, LessThan>, begin, end, lessThan);
+}
+
+template <typename RandomAccessIterator>
+QFuture<void> sort(RandomAccessIterator begin, RandomAccessIterator end)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
+    return QtConcurrent::sort(begin, end, std::less<T>());
+}
+
+// inclusiveScan()
+template <typename InputIterator, typename OutputIterator, typename BinaryOperation>
+QFuture<void> inclusiveScan(InputIterator begin, InputIterator end, OutputIterator result,
+                            BinaryOperation operation)
+{
+    return QtConcurrent::run(&parallelInclusiveScan<InputIterator, OutputIterator, BinaryOperation>,
+                             begin, end, result, operation);
+}
+
+template <typename InputIterator, typename OutputIterator>
+QFuture<void> inclusiveScan(InputIterator begin, InputIterator end, OutputIterator result)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type T;
+    return QtConcurrent::inclusiveScan(begin, end, result, std::plus<T>());
+}
+
+// exclusiveScan()
+template <typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+QFuture<void> exclusiveScan(InputIterator begin, InputIterator end, OutputIterator result,
+                            T init, BinaryOperation operation)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type ValueType;
+    return QtConcurrent::run(&parallelExclusiveScan<InputIterator, OutputIterator, BinaryOperation>,
+                             begin, end, result, ValueType(init), operation);
+}
+
+template <typename InputIterator, typename OutputIterator, typename T>
+QFuture<void> exclusiveScan(InputIterator begin, InputIterator end, OutputIterator result, T init)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type ValueType;
+    return QtConcurrent::exclusiveScan(begin, end, result, init, std::plus<ValueType>());
+}
+
+} // namespace QtConcurrent
+
+#endif // Q_QDOC
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
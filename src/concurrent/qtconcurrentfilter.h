@@ -56,24 +56,26 @@ QT_BEGIN_NAMESPACE
 
 namespace QtConcurrent {
 
-    QFuture<void> filter(Sequence &sequence, FilterFunction filterFunction);
+    QFuture<void> filter(Sequence &sequence, FilterFunction filterFunction, const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
 
     template <typename T>
-    QFuture<T> filtered(const Sequence &sequence, FilterFunction filterFunction);
+    QFuture<T> filtered(const Sequence &sequence, FilterFunction filterFunction, const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
     template <typename T>
-    QFuture<T> filtered(ConstIterator begin, ConstIterator end, FilterFunction filterFunction);
+    QFuture<T> filtered(ConstIterator begin, ConstIterator end, FilterFunction filterFunction, const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
 
     template <typename T>
     QFuture<T> filteredReduced(const Sequence &sequence,
                                FilterFunction filterFunction,
                                ReduceFunction reduceFunction,
-                               QtConcurrent::ReduceOptions reduceOptions = UnorderedReduce | SequentialReduce);
+                               QtConcurrent::ReduceOptions reduceOptions = UnorderedReduce | SequentialReduce,
+                               const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
     template <typename T>
     QFuture<T> filteredReduced(ConstIterator begin,
                                ConstIterator end,
                                FilterFunction filterFunction,
                                ReduceFunction reduceFunction,
-                               QtConcurrent::ReduceOptions reduceOptions = UnorderedReduce | SequentialReduce);
+                               QtConcurrent::ReduceOptions reduceOptions = UnorderedReduce | SequentialReduce,
+                               const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
 
     void blockingFilter(Sequence &sequence, FilterFunction filterFunction);
 
@@ -101,17 +103,18 @@ namespace QtConcurrent {
 namespace QtConcurrent {
 
 template <typename Sequence, typename KeepFunctor, typename ReduceFunctor>
-ThreadEngineStarter<void> filterInternal(Sequence &sequence, KeepFunctor keep, ReduceFunctor reduce)
+ThreadEngineStarter<void> filterInternal(Sequence &sequence, KeepFunctor keep, ReduceFunctor reduce,
+                                         const ChunkingPolicy &policy = ChunkingPolicy())
 {
     typedef FilterKernel<Sequence, KeepFunctor, ReduceFunctor> KernelType;
-    return startThreadEngine(new KernelType(sequence, keep, reduce));
+    return startThreadEngine(withChunkingPolicy(new KernelType(sequence, keep, reduce), policy));
 }
 
 // filter() on sequences
 template <typename Sequence, typename KeepFunctor>
-QFuture<void> filter(Sequence &sequence, KeepFunctor keep)
+QFuture<void> filter(Sequence &sequence, KeepFunctor keep, const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return filterInternal(sequence, QtPrivate::createFunctionWrapper(keep), QtPrivate::PushBackWrapper());
+    return filterInternal(sequence, QtPrivate::createFunctionWrapper(keep), QtPrivate::PushBackWrapper(), policy);
 }
 
 // filteredReduced() on sequences
@@ -119,22 +122,25 @@ template <typename ResultType, typename Sequence, typename KeepFunctor, typename
 QFuture<ResultType> filteredReduced(const Sequence &sequence,
                                     KeepFunctor keep,
                                     ReduceFunctor reduce,
-                                    ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+                                    ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce),
+                                    const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return startFilteredReduced<ResultType>(sequence, QtPrivate::createFunctionWrapper(keep), QtPrivate::createFunctionWrapper(reduce), options);
+    return startFilteredReduced<ResultType>(sequence, QtPrivate::createFunctionWrapper(keep), QtPrivate::createFunctionWrapper(reduce), options, policy);
 }
 
 template <typename Sequence, typename KeepFunctor, typename ReduceFunctor>
 QFuture<typename QtPrivate::ReduceResultType<ReduceFunctor>::ResultType> filteredReduced(const Sequence &sequence,
                                     KeepFunctor keep,
                                     ReduceFunctor reduce,
-                                    ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+                                    ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce),
+                                    const ChunkingPolicy &policy = ChunkingPolicy())
 {
     return startFilteredReduced<typename QtPrivate::ReduceResultType<ReduceFunctor>::ResultType>
             (sequence,
              QtPrivate::createFunctionWrapper(keep),
              QtPrivate::createFunctionWrapper(reduce),
-             options);
+             options,
+             policy);
 }
 
 // filteredReduced() on iterators
@@ -143,9 +149,10 @@ QFuture<ResultType> filteredReduced(Iterator begin,
                                     Iterator end,
                                     KeepFunctor keep,
                                     ReduceFunctor reduce,
-                                    ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+                                    ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce),
+                                    const ChunkingPolicy &policy = ChunkingPolicy())
 {
-   return startFilteredReduced<ResultType>(begin, end, QtPrivate::createFunctionWrapper(keep), QtPrivate::createFunctionWrapper(reduce), options);
+   return startFilteredReduced<ResultType>(begin, end, QtPrivate::createFunctionWrapper(keep), QtPrivate::createFunctionWrapper(reduce), options, policy);
 }
 
 template <typename Iterator, typename KeepFunctor, typename ReduceFunctor>
@@ -153,27 +160,29 @@ QFuture<typename QtPrivate::ReduceResultType<ReduceFunctor>::ResultType> filtere
                                     Iterator end,
                                     KeepFunctor keep,
                                     ReduceFunctor reduce,
-                                    ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+                                    ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce),
+                                    const ChunkingPolicy &policy = ChunkingPolicy())
 {
    return startFilteredReduced<typename QtPrivate::ReduceResultType<ReduceFunctor>::ResultType>
            (begin, end,
             QtPrivate::createFunctionWrapper(keep),
             QtPrivate::createFunctionWrapper(reduce),
-            options);
+            options,
+            policy);
 }
 
 // filtered() on sequences
 template <typename Sequence, typename KeepFunctor>
-QFuture<typename Sequence::value_type> filtered(const Sequence &sequence, KeepFunctor keep)
+QFuture<typename Sequence::value_type> filtered(const Sequence &sequence, KeepFunctor keep, const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return startFiltered(sequence, QtPrivate::createFunctionWrapper(keep));
+    return startFiltered(sequence, QtPrivate::createFunctionWrapper(keep), policy);
 }
 
 // filtered() on iterators
 template <typename Iterator, typename KeepFunctor>
-QFuture<typename qValueType<Iterator>::value_type> filtered(Iterator begin, Iterator end, KeepFunctor keep)
+QFuture<typename qValueType<Iterator>::value_type> filtered(Iterator begin, Iterator end, KeepFunctor keep, const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return startFiltered(begin, end, QtPrivate::createFunctionWrapper(keep));
+    return startFiltered(begin, end, QtPrivate::createFunctionWrapper(keep), policy);
 }
 
 // blocking filter() on sequences
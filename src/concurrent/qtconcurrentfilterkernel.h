@@ -297,43 +297,47 @@ public:
 template <typename Iterator, typename KeepFunctor>
 inline
 ThreadEngineStarter<typename qValueType<Iterator>::value_type>
-startFiltered(Iterator begin, Iterator end, KeepFunctor functor)
+startFiltered(Iterator begin, Iterator end, KeepFunctor functor,
+              const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return startThreadEngine(new FilteredEachKernel<Iterator, KeepFunctor>(begin, end, functor));
+    return startThreadEngine(withChunkingPolicy(new FilteredEachKernel<Iterator, KeepFunctor>(begin, end, functor), policy));
 }
 
 template <typename Sequence, typename KeepFunctor>
 inline ThreadEngineStarter<typename Sequence::value_type>
-startFiltered(const Sequence &sequence, KeepFunctor functor)
+startFiltered(const Sequence &sequence, KeepFunctor functor,
+              const ChunkingPolicy &policy = ChunkingPolicy())
 {
     typedef SequenceHolder1<Sequence,
                             FilteredEachKernel<typename Sequence::const_iterator, KeepFunctor>,
                             KeepFunctor>
         SequenceHolderType;
-        return startThreadEngine(new SequenceHolderType(sequence, functor));
+        return startThreadEngine(withChunkingPolicy(new SequenceHolderType(sequence, functor), policy));
 }
 
 template <typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor>
 inline ThreadEngineStarter<ResultType> startFilteredReduced(const Sequence & sequence,
                                                            MapFunctor mapFunctor, ReduceFunctor reduceFunctor,
-                                                           ReduceOptions options)
+                                                           ReduceOptions options,
+                                                           const ChunkingPolicy &policy = ChunkingPolicy())
 {
     typedef typename Sequence::const_iterator Iterator;
     typedef ReduceKernel<ReduceFunctor, ResultType, typename qValueType<Iterator>::value_type > Reducer;
     typedef FilteredReducedKernel<ResultType, Iterator, MapFunctor, ReduceFunctor, Reducer> FilteredReduceType;
     typedef SequenceHolder2<Sequence, FilteredReduceType, MapFunctor, ReduceFunctor> SequenceHolderType;
-    return startThreadEngine(new SequenceHolderType(sequence, mapFunctor, reduceFunctor, options));
+    return startThreadEngine(withChunkingPolicy(new SequenceHolderType(sequence, mapFunctor, reduceFunctor, options), policy));
 }
 
 
 template <typename ResultType, typename Iterator, typename MapFunctor, typename ReduceFunctor>
 inline ThreadEngineStarter<ResultType> startFilteredReduced(Iterator begin, Iterator end,
                                                            MapFunctor mapFunctor, ReduceFunctor reduceFunctor,
-                                                           ReduceOptions options)
+                                                           ReduceOptions options,
+                                                           const ChunkingPolicy &policy = ChunkingPolicy())
 {
     typedef ReduceKernel<ReduceFunctor, ResultType, typename qValueType<Iterator>::value_type> Reducer;
     typedef FilteredReducedKernel<ResultType, Iterator, MapFunctor, ReduceFunctor, Reducer> FilteredReduceType;
-    return startThreadEngine(new FilteredReduceType(begin, end, mapFunctor, reduceFunctor, options));
+    return startThreadEngine(withChunkingPolicy(new FilteredReduceType(begin, end, mapFunctor, reduceFunctor, options), policy));
 }
 
 
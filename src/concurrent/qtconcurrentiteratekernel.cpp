@@ -64,7 +64,8 @@ QT_BEGIN_NAMESPACE
 
 enum {
     TargetRatio = 100,
-    MedianSize = 7
+    MedianSize = 7,
+    TargetBlockCost = 20000 // in nanoseconds, for blocks sized from a cost hint
 };
 
 #if defined(Q_OS_MAC)
@@ -137,6 +138,94 @@ static double elapsed(qint64 after, qint64 before)
 
 namespace QtConcurrent {
 
+/*!
+    \class QtConcurrent::ChunkingPolicy
+    \inmodule QtConcurrent
+    \since 5.3
+    \brief The ChunkingPolicy class tells how the items of a sequence are
+    divided into blocks for the threads.
+
+    QtConcurrent::map(), QtConcurrent::filter() and the related functions
+    hand the items of a random access sequence to the threads in blocks. The
+    threads reserve a block at a time, so larger blocks mean less overhead
+    per item, while smaller blocks spread the work more evenly.
+
+    The default policy, adaptive(), starts with blocks of one item and
+    makes them larger for as long as handing out a block takes a noticeable
+    share of the time, up to an even share of the sequence per thread. If
+    you know how long the function takes per item, pass it as a cost hint
+    so that the blocks start out at about the right size. Near the end of
+    the sequence, blocks never get larger than an even share of the items
+    that are left, so that the threads finish at about the same time.
+
+    fixedSize() always hands out blocks of the given size, which suits
+    functions of known and even cost. guided() hands out an even share of
+    the items that are left, but no fewer than a given minimum, so that
+    blocks start large and get smaller as the work runs out; this suits
+    functions whose cost varies a lot from item to item.
+
+    Sequences that don't have random access iterators are always processed
+    one item at a time.
+
+    \sa QtConcurrent::map(), QtConcurrent::filter()
+*/
+
+/*!
+    \enum QtConcurrent::ChunkingPolicy::Mode
+
+    \value Adaptive The block size is adjusted from timing measurements.
+    \value FixedSize All blocks have the same size.
+    \value Guided Each block is an even share of the items that are left.
+*/
+
+/*!
+    \fn QtConcurrent::ChunkingPolicy::ChunkingPolicy()
+
+    Constructs the default policy, which is the same as adaptive() without
+    a cost hint.
+*/
+
+/*!
+    \fn QtConcurrent::ChunkingPolicy QtConcurrent::ChunkingPolicy::adaptive(qint64 costHint)
+
+    Returns a policy that adjusts the block size from timing measurements.
+    If \a costHint is larger than 0, it is the estimated time per item in
+    nanoseconds, and is used to choose the first block size.
+*/
+
+/*!
+    \fn QtConcurrent::ChunkingPolicy QtConcurrent::ChunkingPolicy::fixedSize(int chunkSize)
+
+    Returns a policy that hands out blocks of \a chunkSize items.
+*/
+
+/*!
+    \fn QtConcurrent::ChunkingPolicy QtConcurrent::ChunkingPolicy::guided(int minimumChunkSize)
+
+    Returns a policy that hands out an even share of the items that are
+    left, but no fewer than \a minimumChunkSize items.
+*/
+
+/*!
+    \fn QtConcurrent::ChunkingPolicy::Mode QtConcurrent::ChunkingPolicy::mode() const
+
+    Returns how the block size is chosen.
+*/
+
+/*!
+    \fn int QtConcurrent::ChunkingPolicy::chunkSize() const
+
+    Returns the block size of a fixedSize() policy, or the minimum block size
+    of a guided() policy.
+*/
+
+/*!
+    \fn qint64 QtConcurrent::ChunkingPolicy::costHint() const
+
+    Returns the estimated time per item in nanoseconds that an adaptive()
+    policy was created with, or 0 if there is none.
+*/
+
 /*! \internal
 
 */
@@ -190,6 +279,86 @@ int BlockSizeManager::blockSize()
     return m_blockSize;
 }
 
+/*! \internal
+
+*/
+BlockSizeManagerV2::BlockSizeManagerV2(int iterationCount, const ChunkingPolicy &policy)
+    : policy(policy),
+      threadCount(qMax(QThreadPool::globalInstance()->maxThreadCount(), 1)),
+      maxBlockSize(qMax(iterationCount / (threadCount * 2), 1)),
+      beforeUser(0), afterUser(0),
+      controlPartElapsed(MedianSize), userPartElapsed(MedianSize),
+      m_blockSize(1)
+{
+    switch (policy.mode()) {
+    case ChunkingPolicy::Adaptive:
+        // With a cost hint, start with blocks that are expensive enough
+        // instead of ramping up from a single iteration.
+        if (policy.costHint() > 0)
+            m_blockSize = int(qBound(Q_INT64_C(1), TargetBlockCost / policy.costHint(), qint64(maxBlockSize)));
+        break;
+    case ChunkingPolicy::FixedSize:
+    case ChunkingPolicy::Guided:
+        m_blockSize = policy.chunkSize();
+        break;
+    }
+}
+
+// Records the time before user code.
+void BlockSizeManagerV2::timeBeforeUser()
+{
+    if (!isTiming())
+        return;
+
+    beforeUser = getticks();
+    controlPartElapsed.addValue(elapsed(beforeUser, afterUser));
+}
+
+// Records the time after user code and adjusts the block size if we are
+// spending too much time in the control code compared with the user code.
+void BlockSizeManagerV2::timeAfterUser()
+{
+    if (!isTiming())
+        return;
+
+    afterUser = getticks();
+    userPartElapsed.addValue(elapsed(afterUser, beforeUser));
+
+    if (controlPartElapsed.isMedianValid() == false)
+        return;
+
+    if (controlPartElapsed.median() * TargetRatio < userPartElapsed.median())
+        return;
+
+    m_blockSize = qMin(m_blockSize * 2,  maxBlockSize);
+
+    // Reset the medians after adjusting the block size so we get
+    // new measurements with the new block size.
+    controlPartElapsed.reset();
+    userPartElapsed.reset();
+}
+
+/*
+    Returns the number of iterations to reserve next, given that
+    \a remainingIterations are not reserved yet.
+*/
+int BlockSizeManagerV2::blockSize(int remainingIterations)
+{
+    switch (policy.mode()) {
+    case ChunkingPolicy::FixedSize:
+        return m_blockSize;
+    case ChunkingPolicy::Guided:
+        // a share of what is left, but not less than the minimum
+        return qMax(remainingIterations / threadCount, m_blockSize);
+    case ChunkingPolicy::Adaptive:
+        break;
+    }
+
+    // Don't let one thread reserve more than its share of the last
+    // iterations, or the others run out of work while it is still busy.
+    return qMax(qMin(m_blockSize, remainingIterations / threadCount), 1);
+}
+
 } // namespace QtConcurrent
 
 QT_END_NAMESPACE
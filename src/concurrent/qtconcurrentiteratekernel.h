@@ -55,10 +55,44 @@
 QT_BEGIN_NAMESPACE
 
 
-#ifndef Q_QDOC
-
 namespace QtConcurrent {
 
+class ChunkingPolicy
+{
+public:
+    enum Mode {
+        Adaptive,
+        FixedSize,
+        Guided
+    };
+
+    inline ChunkingPolicy()
+        : m_mode(Adaptive), m_chunkSize(1), m_costHint(0)
+    { }
+
+    static inline ChunkingPolicy adaptive(qint64 costHint = 0)
+    { return ChunkingPolicy(Adaptive, 1, qMax(costHint, Q_INT64_C(0))); }
+    static inline ChunkingPolicy fixedSize(int chunkSize)
+    { return ChunkingPolicy(FixedSize, qMax(chunkSize, 1), 0); }
+    static inline ChunkingPolicy guided(int minimumChunkSize = 1)
+    { return ChunkingPolicy(Guided, qMax(minimumChunkSize, 1), 0); }
+
+    inline Mode mode() const { return m_mode; }
+    inline int chunkSize() const { return m_chunkSize; }
+    inline qint64 costHint() const { return m_costHint; }
+
+private:
+    inline ChunkingPolicy(Mode mode, int chunkSize, qint64 costHint)
+        : m_mode(mode), m_chunkSize(chunkSize), m_costHint(costHint)
+    { }
+
+    Mode m_mode;
+    int m_chunkSize;
+    qint64 m_costHint;
+};
+
+#ifndef Q_QDOC
+
 /*
     The BlockSizeManager class manages how many iterations a thread should
     reserve and process at a time. This is done by measuring the time spent
@@ -88,6 +122,35 @@ private:
     int m_blockSize;
 };
 
+/*
+    Like BlockSizeManager, but follows a ChunkingPolicy and takes the
+    number of iterations that are left into account, so that the last
+    blocks get smaller and all threads finish at about the same time.
+    BlockSizeManager is kept as it is for binary compatibility.
+*/
+class Q_CONCURRENT_EXPORT BlockSizeManagerV2
+{
+public:
+    explicit BlockSizeManagerV2(int iterationCount, const ChunkingPolicy &policy = ChunkingPolicy());
+    void timeBeforeUser();
+    void timeAfterUser();
+    int blockSize(int remainingIterations);
+private:
+    inline bool isTiming() const
+    {
+        return (policy.mode() == ChunkingPolicy::Adaptive && m_blockSize < maxBlockSize);
+    }
+
+    const ChunkingPolicy policy;
+    const int threadCount;
+    const int maxBlockSize;
+    qint64 beforeUser;
+    qint64 afterUser;
+    Median<double> controlPartElapsed;
+    Median<double> userPartElapsed;
+    int m_blockSize;
+};
+
 template <typename T>
 class ResultReporter
 {
@@ -196,18 +259,19 @@ public:
 
     ThreadFunctionResult forThreadFunction()
     {
-        BlockSizeManager blockSizeManager(iterationCount);
+        BlockSizeManagerV2 blockSizeManager(iterationCount, chunkingPolicy);
         ResultReporter<T> resultReporter(this);
 
         for(;;) {
             if (this->isCanceled())
                 break;
 
-            const int currentBlockSize = blockSizeManager.blockSize();
-
-            if (currentIndex.load() >= iterationCount)
+            const int reservedIndex = currentIndex.load();
+            if (reservedIndex >= iterationCount)
                 break;
 
+            const int currentBlockSize = blockSizeManager.blockSize(iterationCount - reservedIndex);
+
             // Atomically reserve a block of iterationCount for this thread.
             const int beginIndex = currentIndex.fetchAndAddRelease(currentBlockSize);
             const int endIndex = qMin(beginIndex + currentBlockSize, iterationCount);
@@ -293,8 +357,16 @@ public:
 
     bool progressReportingEnabled;
     QAtomicInt completed;
+    ChunkingPolicy chunkingPolicy;
 };
 
+template <typename Kernel>
+inline Kernel *withChunkingPolicy(Kernel *kernel, const ChunkingPolicy &policy)
+{
+    kernel->chunkingPolicy = policy;
+    return kernel;
+}
+
 } // namespace QtConcurrent
 
 #endif //Q_QDOC
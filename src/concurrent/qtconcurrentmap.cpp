@@ -63,8 +63,17 @@
     \value OrderedReduce Reduction is done in the order of the
     original sequence.
     \value SequentialReduce Reduction is done sequentially: only one
-    thread will enter the reduce function at a time. (Parallel reduction
-    might be supported in a future version of Qt Concurrent.)
+    thread will enter the reduce function at a time.
+    \value ParallelReduce Reduction is done in parallel (since Qt 5.3):
+    each thread reduces the results of its blocks into a partial result of
+    its own, and adjacent partial results are combined in a tree by
+    passing one as the intermediate result to the reduce function. The
+    reduce function must therefore be associative, be safe to call from
+    several threads at once on different results, and a default-constructed
+    result must not change a result it is reduced into. The original order
+    is kept. This option only takes effect when the map or filter function
+    returns the type of the final result; otherwise, reduction is done
+    sequentially.
 */
 
 /*!
@@ -155,10 +164,23 @@
     control the order in which the reduction is done. If
     QtConcurrent::UnorderedReduce is used (the default), the order is
     undefined, while QtConcurrent::OrderedReduce ensures that the reduction
-    is done in the order of the original sequence.
+    is done in the order of the original sequence. When the map function
+    returns the type of the final result, as when summing numbers,
+    QtConcurrent::ParallelReduce lets all threads reduce at the same time.
 
     \section1 Additional API Features
 
+    \section2 Controlling the Block Size
+
+    The items are handed to the threads in blocks. By default, the size of
+    the blocks is adjusted while the map function runs, starting with a
+    single item. A QtConcurrent::ChunkingPolicy passed as the last argument
+    sets a fixed block size, lets the blocks shrink as the end of the
+    sequence comes closer, or tells how expensive the map function is so
+    that the blocks start out at a suitable size:
+
+    \snippet code/src_concurrent_qtconcurrentmap.cpp 15
+
     \section2 Using Iterators instead of Sequence
 
     Each of the above functions has a variant that takes an iterator range
@@ -232,41 +254,53 @@
 */
 
 /*!
-    \fn QFuture<void> QtConcurrent::map(Sequence &sequence, MapFunction function)
+    \fn QFuture<void> QtConcurrent::map(Sequence &sequence, MapFunction function, const QtConcurrent::ChunkingPolicy &policy)
 
     Calls \a function once for each item in \a sequence. The \a function is
     passed a reference to the item, so that any modifications done to the item
     will appear in \a sequence.
+
+    The items are divided into blocks for the threads as given by \a policy;
+    see QtConcurrent::ChunkingPolicy.
 */
 
 /*!
-    \fn QFuture<void> QtConcurrent::map(Iterator begin, Iterator end, MapFunction function)
+    \fn QFuture<void> QtConcurrent::map(Iterator begin, Iterator end, MapFunction function, const QtConcurrent::ChunkingPolicy &policy)
 
     Calls \a function once for each item from \a begin to \a end. The
     \a function is passed a reference to the item, so that any modifications
     done to the item will appear in the sequence which the iterators belong to.
+
+    The items are divided into blocks for the threads as given by \a policy;
+    see QtConcurrent::ChunkingPolicy.
 */
 
 /*!
-    \fn QFuture<T> QtConcurrent::mapped(const Sequence &sequence, MapFunction function)
+    \fn QFuture<T> QtConcurrent::mapped(const Sequence &sequence, MapFunction function, const QtConcurrent::ChunkingPolicy &policy)
 
     Calls \a function once for each item in \a sequence and returns a future
     with each mapped item as a result. You can use QFuture::const_iterator or
     QFutureIterator to iterate through the results.
+
+    The items are divided into blocks for the threads as given by \a policy;
+    see QtConcurrent::ChunkingPolicy.
 */
 
 /*!
-    \fn QFuture<T> QtConcurrent::mapped(ConstIterator begin, ConstIterator end, MapFunction function)
+    \fn QFuture<T> QtConcurrent::mapped(ConstIterator begin, ConstIterator end, MapFunction function, const QtConcurrent::ChunkingPolicy &policy)
 
     Calls \a function once for each item from \a begin to \a end and returns a
     future with each mapped item as a result. You can use
     QFuture::const_iterator or QFutureIterator to iterate through the results.
+
+    The items are divided into blocks for the threads as given by \a policy;
+    see QtConcurrent::ChunkingPolicy.
 */
 
 /*!
     \fn QFuture<T> QtConcurrent::mappedReduced(const Sequence &sequence,
     MapFunction mapFunction, ReduceFunction reduceFunction,
-    QtConcurrent::ReduceOptions reduceOptions)
+    QtConcurrent::ReduceOptions reduceOptions, const QtConcurrent::ChunkingPolicy &policy)
 
     Calls \a mapFunction once for each item in \a sequence. The return value of
     each \a mapFunction is passed to \a reduceFunction.
@@ -274,12 +308,15 @@
     Note that while \a mapFunction is called concurrently, only one thread at a
     time will call \a reduceFunction. The order in which \a reduceFunction is
     called is determined by \a reduceOptions.
+
+    The items are divided into blocks for the threads as given by \a policy;
+    see QtConcurrent::ChunkingPolicy.
 */
 
 /*!
     \fn QFuture<T> QtConcurrent::mappedReduced(ConstIterator begin,
     ConstIterator end, MapFunction mapFunction, ReduceFunction reduceFunction,
-    QtConcurrent::ReduceOptions reduceOptions)
+    QtConcurrent::ReduceOptions reduceOptions, const QtConcurrent::ChunkingPolicy &policy)
 
     Calls \a mapFunction once for each item from \a begin to \a end. The return
     value of each \a mapFunction is passed to \a reduceFunction.
@@ -289,6 +326,9 @@
     \a reduceFunction is called is undefined.
 
     \note QtConcurrent::OrderedReduce results in the ordered reduction.
+
+    The items are divided into blocks for the threads as given by \a policy;
+    see QtConcurrent::ChunkingPolicy.
 */
 
 /*!
@@ -58,25 +58,27 @@ QT_BEGIN_NAMESPACE
 
 namespace QtConcurrent {
 
-    QFuture<void> map(Sequence &sequence, MapFunction function);
-    QFuture<void> map(Iterator begin, Iterator end, MapFunction function);
+    QFuture<void> map(Sequence &sequence, MapFunction function, const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
+    QFuture<void> map(Iterator begin, Iterator end, MapFunction function, const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
 
     template <typename T>
-    QFuture<T> mapped(const Sequence &sequence, MapFunction function);
+    QFuture<T> mapped(const Sequence &sequence, MapFunction function, const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
     template <typename T>
-    QFuture<T> mapped(ConstIterator begin, ConstIterator end, MapFunction function);
+    QFuture<T> mapped(ConstIterator begin, ConstIterator end, MapFunction function, const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
 
     template <typename T>
     QFuture<T> mappedReduced(const Sequence &sequence,
                              MapFunction function,
                              ReduceFunction function,
-                             QtConcurrent::ReduceOptions options = UnorderedReduce | SequentialReduce);
+                             QtConcurrent::ReduceOptions options = UnorderedReduce | SequentialReduce,
+                             const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
     template <typename T>
     QFuture<T> mappedReduced(ConstIterator begin,
                              ConstIterator end,
                              MapFunction function,
                              ReduceFunction function,
-                             QtConcurrent::ReduceOptions options = UnorderedReduce | SequentialReduce);
+                             QtConcurrent::ReduceOptions options = UnorderedReduce | SequentialReduce,
+                             const QtConcurrent::ChunkingPolicy &policy = QtConcurrent::ChunkingPolicy());
 
     void blockingMap(Sequence &sequence, MapFunction function);
     void blockingMap(Iterator begin, Iterator end, MapFunction function);
@@ -106,16 +108,16 @@ namespace QtConcurrent {
 
 // map() on sequences
 template <typename Sequence, typename MapFunctor>
-QFuture<void> map(Sequence &sequence, MapFunctor map)
+QFuture<void> map(Sequence &sequence, MapFunctor map, const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return startMap(sequence.begin(), sequence.end(), QtPrivate::createFunctionWrapper(map));
+    return startMap(sequence.begin(), sequence.end(), QtPrivate::createFunctionWrapper(map), policy);
 }
 
 // map() on iterators
 template <typename Iterator, typename MapFunctor>
-QFuture<void> map(Iterator begin, Iterator end, MapFunctor map)
+QFuture<void> map(Iterator begin, Iterator end, MapFunctor map, const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return startMap(begin, end, QtPrivate::createFunctionWrapper(map));
+    return startMap(begin, end, QtPrivate::createFunctionWrapper(map), policy);
 }
 
 // mappedReduced() for sequences.
@@ -123,26 +125,30 @@ template <typename ResultType, typename Sequence, typename MapFunctor, typename
 QFuture<ResultType> mappedReduced(const Sequence &sequence,
                                   MapFunctor map,
                                   ReduceFunctor reduce,
-                                  ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+                                  ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce),
+                                  const ChunkingPolicy &policy = ChunkingPolicy())
 {
     return startMappedReduced<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType, ResultType>
         (sequence,
          QtPrivate::createFunctionWrapper(map),
          QtPrivate::createFunctionWrapper(reduce),
-         options);
+         options,
+         policy);
 }
 
 template <typename Sequence, typename MapFunctor, typename ReduceFunctor>
 QFuture<typename QtPrivate::ReduceResultType<ReduceFunctor>::ResultType> mappedReduced(const Sequence &sequence,
                                   MapFunctor map,
                                   ReduceFunctor reduce,
-                                  ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+                                  ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce),
+                                  const ChunkingPolicy &policy = ChunkingPolicy())
 {
     return startMappedReduced<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType, typename QtPrivate::ReduceResultType<ReduceFunctor>::ResultType>
         (sequence,
          QtPrivate::createFunctionWrapper(map),
          QtPrivate::createFunctionWrapper(reduce),
-         options);
+         options,
+         policy);
 }
 
 // mappedReduced() for iterators
@@ -151,13 +157,15 @@ QFuture<ResultType> mappedReduced(Iterator begin,
                                   Iterator end,
                                   MapFunctor map,
                                   ReduceFunctor reduce,
-                                  ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+                                  ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce),
+                                  const ChunkingPolicy &policy = ChunkingPolicy())
 {
     return startMappedReduced<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType, ResultType>
         (begin, end,
          QtPrivate::createFunctionWrapper(map),
          QtPrivate::createFunctionWrapper(reduce),
-         options);
+         options,
+         policy);
 }
 
 template <typename Iterator, typename MapFunctor, typename ReduceFunctor>
@@ -165,27 +173,29 @@ QFuture<typename QtPrivate::ReduceResultType<ReduceFunctor>::ResultType> mappedR
                                   Iterator end,
                                   MapFunctor map,
                                   ReduceFunctor reduce,
-                                  ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+                                  ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce),
+                                  const ChunkingPolicy &policy = ChunkingPolicy())
 {
     return startMappedReduced<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType, typename QtPrivate::ReduceResultType<ReduceFunctor>::ResultType>
         (begin, end,
          QtPrivate::createFunctionWrapper(map),
          QtPrivate::createFunctionWrapper(reduce),
-         options);
+         options,
+         policy);
 }
 
 // mapped() for sequences
 template <typename Sequence, typename MapFunctor>
-QFuture<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType> mapped(const Sequence &sequence, MapFunctor map)
+QFuture<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType> mapped(const Sequence &sequence, MapFunctor map, const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return startMapped<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType>(sequence, QtPrivate::createFunctionWrapper(map));
+    return startMapped<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType>(sequence, QtPrivate::createFunctionWrapper(map), policy);
 }
 
 // mapped() for iterator ranges.
 template <typename Iterator, typename MapFunctor>
-QFuture<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType> mapped(Iterator begin, Iterator end, MapFunctor map)
+QFuture<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType> mapped(Iterator begin, Iterator end, MapFunctor map, const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return startMapped<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType>(begin, end, QtPrivate::createFunctionWrapper(map));
+    return startMapped<typename QtPrivate::MapResultType<void, MapFunctor>::ResultType>(begin, end, QtPrivate::createFunctionWrapper(map), policy);
 }
 
 // blockingMap() for sequences
@@ -194,15 +194,17 @@ public:
 };
 
 template <typename Iterator, typename Functor>
-inline ThreadEngineStarter<void> startMap(Iterator begin, Iterator end, Functor functor)
+inline ThreadEngineStarter<void> startMap(Iterator begin, Iterator end, Functor functor,
+                                          const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return startThreadEngine(new MapKernel<Iterator, Functor>(begin, end, functor));
+    return startThreadEngine(withChunkingPolicy(new MapKernel<Iterator, Functor>(begin, end, functor), policy));
 }
 
 template <typename T, typename Iterator, typename Functor>
-inline ThreadEngineStarter<T> startMapped(Iterator begin, Iterator end, Functor functor)
+inline ThreadEngineStarter<T> startMapped(Iterator begin, Iterator end, Functor functor,
+                                          const ChunkingPolicy &policy = ChunkingPolicy())
 {
-    return startThreadEngine(new MappedEachKernel<Iterator, Functor>(begin, end, functor));
+    return startThreadEngine(withChunkingPolicy(new MappedEachKernel<Iterator, Functor>(begin, end, functor), policy));
 }
 
 /*
@@ -228,35 +230,38 @@ struct SequenceHolder1 : public Base
 };
 
 template <typename T, typename Sequence, typename Functor>
-inline ThreadEngineStarter<T> startMapped(const Sequence &sequence, Functor functor)
+inline ThreadEngineStarter<T> startMapped(const Sequence &sequence, Functor functor,
+                                          const ChunkingPolicy &policy = ChunkingPolicy())
 {
     typedef SequenceHolder1<Sequence,
                             MappedEachKernel<typename Sequence::const_iterator , Functor>, Functor>
                             SequenceHolderType;
 
-    return startThreadEngine(new SequenceHolderType(sequence, functor));
+    return startThreadEngine(withChunkingPolicy(new SequenceHolderType(sequence, functor), policy));
 }
 
 template <typename IntermediateType, typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor>
 inline ThreadEngineStarter<ResultType> startMappedReduced(const Sequence & sequence,
                                                            MapFunctor mapFunctor, ReduceFunctor reduceFunctor,
-                                                           ReduceOptions options)
+                                                           ReduceOptions options,
+                                                           const ChunkingPolicy &policy = ChunkingPolicy())
 {
     typedef typename Sequence::const_iterator Iterator;
     typedef ReduceKernel<ReduceFunctor, ResultType, IntermediateType> Reducer;
     typedef MappedReducedKernel<ResultType, Iterator, MapFunctor, ReduceFunctor, Reducer> MappedReduceType;
     typedef SequenceHolder2<Sequence, MappedReduceType, MapFunctor, ReduceFunctor> SequenceHolderType;
-    return startThreadEngine(new SequenceHolderType(sequence, mapFunctor, reduceFunctor, options));
+    return startThreadEngine(withChunkingPolicy(new SequenceHolderType(sequence, mapFunctor, reduceFunctor, options), policy));
 }
 
 template <typename IntermediateType, typename ResultType, typename Iterator, typename MapFunctor, typename ReduceFunctor>
 inline ThreadEngineStarter<ResultType> startMappedReduced(Iterator begin, Iterator end,
                                                            MapFunctor mapFunctor, ReduceFunctor reduceFunctor,
-                                                           ReduceOptions options)
+                                                           ReduceOptions options,
+                                                           const ChunkingPolicy &policy = ChunkingPolicy())
 {
     typedef ReduceKernel<ReduceFunctor, ResultType, IntermediateType> Reducer;
     typedef MappedReducedKernel<ResultType, Iterator, MapFunctor, ReduceFunctor, Reducer> MappedReduceType;
-    return startThreadEngine(new MappedReduceType(begin, end, mapFunctor, reduceFunctor, options));
+    return startThreadEngine(withChunkingPolicy(new MappedReduceType(begin, end, mapFunctor, reduceFunctor, options), policy));
 }
 
 } // namespace QtConcurrent
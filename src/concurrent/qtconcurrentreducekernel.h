@@ -52,6 +52,7 @@
 #include <QtCore/qmutex.h>
 #include <QtCore/qthread.h>
 #include <QtCore/qthreadpool.h>
+#include <QtCore/qtypetraits.h>
 #include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
@@ -89,25 +90,41 @@ public:
 enum ReduceOption {
     UnorderedReduce = 0x1,
     OrderedReduce = 0x2,
-    SequentialReduce = 0x4
-    // ParallelReduce = 0x8
+    SequentialReduce = 0x4,
+    ParallelReduce = 0x8
 };
 Q_DECLARE_FLAGS(ReduceOptions, ReduceOption)
 Q_DECLARE_OPERATORS_FOR_FLAGS(ReduceOptions)
 
 #ifndef Q_QDOC
 
+// A partial result of ParallelReduce: the reduction of a range of
+// consecutive iterations, keyed by the beginning of the range.
+template <typename ReduceResultType>
+class PartialResult
+{
+public:
+    int end;
+    ReduceResultType value;
+};
+
 // supports both ordered and out-of-order reduction
 template <typename ReduceFunctor, typename ReduceResultType, typename T>
 class ReduceKernel
 {
     typedef QMap<int, IntermediateResults<T> > ResultsMap;
+    typedef QMap<int, PartialResult<ReduceResultType> > PartialResultsMap;
+
+    // Partial results can only be combined with the reduce function when
+    // they have the type of the intermediate results.
+    typedef QtPrivate::is_same<ReduceResultType, T> CanReduceInParallel;
 
     const ReduceOptions reduceOptions;
 
     QMutex mutex;
     int progress, resultsMapSize, threadCount;
     ResultsMap resultsMap;
+    PartialResultsMap partialResults;
 
     bool canReduce(int begin) const
     {
@@ -137,6 +154,92 @@ class ReduceKernel
         }
     }
 
+    bool isParallel() const
+    {
+        return (reduceOptions & ParallelReduce) && CanReduceInParallel::value;
+    }
+
+    void reduceInParallel(ReduceFunctor &, const IntermediateResults<T> &, QtPrivate::false_type)
+    {
+        Q_UNREACHABLE();
+    }
+
+    /*
+        Reduces a block of results into a partial result without holding
+        the lock, then combines it with the partial results of adjacent
+        ranges, in order, for as long as there are any. Combining takes
+        the neighbours out of the map so that other threads can combine
+        other ranges at the same time; the ranges are thereby reduced in
+        a tree rather than one after the other.
+    */
+    void reduceInParallel(ReduceFunctor &reduce, const IntermediateResults<T> &result, QtPrivate::true_type)
+    {
+        int begin = result.begin;
+        PartialResult<ReduceResultType> partial;
+        partial.end = result.end;
+        partial.value = ReduceResultType();
+        reduceResult(reduce, partial.value, result);
+
+        QMutexLocker locker(&mutex);
+        for (;;) {
+            typename PartialResultsMap::iterator right = partialResults.find(partial.end);
+            typename PartialResultsMap::iterator left = partialResults.lowerBound(begin);
+            if (left != partialResults.begin() && (left - 1).value().end == begin)
+                --left;
+            else
+                left = partialResults.end();
+
+            if (left == partialResults.end() && right == partialResults.end()) {
+                partialResults.insert(begin, partial);
+                ++resultsMapSize;
+                return;
+            }
+
+            // QMap::erase() leaves the other iterator valid
+            const bool hasLeft = left != partialResults.end();
+            const bool hasRight = right != partialResults.end();
+            int leftBegin = begin;
+            PartialResult<ReduceResultType> leftPartial, rightPartial;
+            if (hasLeft) {
+                leftBegin = left.key();
+                qSwap(leftPartial.value, left.value().value);
+                partialResults.erase(left);
+                --resultsMapSize;
+            }
+            if (hasRight) {
+                rightPartial.end = right.value().end;
+                qSwap(rightPartial.value, right.value().value);
+                partialResults.erase(right);
+                --resultsMapSize;
+            }
+
+            locker.unlock();
+            if (hasLeft) {
+                reduce(leftPartial.value, partial.value);
+                qSwap(partial.value, leftPartial.value);
+                begin = leftBegin;
+            }
+            if (hasRight) {
+                reduce(partial.value, rightPartial.value);
+                partial.end = rightPartial.end;
+            }
+            locker.relock();
+        }
+    }
+
+    void finishInParallel(ReduceFunctor &, ReduceResultType &, QtPrivate::false_type)
+    { }
+
+    void finishInParallel(ReduceFunctor &reduce, ReduceResultType &r, QtPrivate::true_type)
+    {
+        typename PartialResultsMap::iterator it = partialResults.begin();
+        while (it != partialResults.end()) {
+            reduce(r, it.value().value);
+            ++it;
+        }
+        partialResults.clear();
+    }
+
 public:
     ReduceKernel(ReduceOptions _reduceOptions)
         : reduceOptions(_reduceOptions), progress(0), resultsMapSize(0),
@@ -147,6 +250,11 @@ public:
                    ReduceResultType &r,
                    const IntermediateResults<T> &result)
     {
+        if (isParallel()) {
+            reduceInParallel(reduce, result, CanReduceInParallel());
+            return;
+        }
+
         QMutexLocker locker(&mutex);
         if (!canReduce(result.begin)) {
             ++resultsMapSize;
@@ -205,7 +313,10 @@ public:
     // final reduction
     void finish(ReduceFunctor &reduce, ReduceResultType &r)
     {
-        reduceResults(reduce, r, resultsMap);
+        if (isParallel())
+            finishInParallel(reduce, r, CanReduceInParallel());
+        else
+            reduceResults(reduce, r, resultsMap);
     }
 
     inline bool shouldThrottle()
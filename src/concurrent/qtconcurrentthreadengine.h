@@ -178,9 +178,16 @@ public:
     void asynchronousFinish()
     {
         finish();
-        futureInterfaceTyped()->reportFinished(result());
+        if (T *r = result())
+            futureInterfaceTyped()->reportResult(r, -1);
+
+        // Release the engine and its typed reference before reporting the
+        // future as finished, so that waiters and continuations woken up by
+        // reportFinished() hold the last references to the results.
+        QFutureInterfaceBase finishedInterface(*futureInterface);
         delete futureInterfaceTyped();
         delete this;
+        finishedInterface.reportFinished();
     }
 
 
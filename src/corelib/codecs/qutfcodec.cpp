@@ -44,10 +44,181 @@
 #include "qendian.h"
 #include "qchar.h"
 
+#include "private/qsimd_p.h"
+
 QT_BEGIN_NAMESPACE
 
 enum { Endian = 0, Data = 1 };
 
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+static inline uint qBitScanReverse(uint v)
+{
+    Q_ASSERT(v);
+#if defined(Q_CC_GNU)
+    return 31 - __builtin_clz(v);
+#else
+    uint result = 0;
+    while (v >>= 1)
+        ++result;
+    return result;
+#endif
+}
+#endif
+
+#if defined(__SSE2__)
+static inline bool simdEncodeAscii(uchar *&dst, const ushort *&nextAscii, const ushort *&src, const ushort *end)
+{
+    // do sixteen characters at a time
+    for ( ; end - src >= 16; src += 16, dst += 16) {
+        __m128i data1 = _mm_loadu_si128((const __m128i*)src);
+        __m128i data2 = _mm_loadu_si128(1+(const __m128i*)src);
+
+        // check if everything is ASCII
+        // the highest ASCII value is U+007F
+        // Do the packing directly:
+        // The PACKUSWB instruction packs a signed 16-bit integer to an unsigned 8-bit
+        // with saturation. That is, anything from 0x0100 to 0x7fff is saturated to 0xff,
+        // while all negatives (0x8000 to 0xffff) get saturated to 0x00. To detect non-ASCII,
+        // we simply do a signed greater-than comparison to 0x00. That means we detect NULs as
+        // "non-ASCII", but it's an acceptable compromise.
+        __m128i packed = _mm_packus_epi16(data1, data2);
+        __m128i nonAscii = _mm_cmpgt_epi8(packed, _mm_setzero_si128());
+
+        // store, even if there are non-ASCII characters here
+        _mm_storeu_si128((__m128i*)dst, packed);
+
+        // n will contain 1 bit set per character in [data1, data2] that is non-ASCII (or NUL)
+        uint n = ~_mm_movemask_epi8(nonAscii) & 0xffff;
+        if (n) {
+            // find the next probable ASCII character
+            // we don't want to load 32 bytes again in this loop if we know there are non-ASCII
+            // characters still coming
+            nextAscii = src + qBitScanReverse(n) + 1;
+
+            // advance over the characters that were ASCII
+            while (!(n & 1)) {
+                ++dst;
+                ++src;
+                n >>= 1;
+            }
+            return false;
+        }
+    }
+    nextAscii = end;
+    return src == end;
+}
+
+static inline bool simdDecodeAscii(ushort *&dst, const uchar *&nextAscii, const uchar *&src, const uchar *end)
+{
+    // do sixteen characters at a time
+    for ( ; end - src >= 16; src += 16, dst += 16) {
+        __m128i data = _mm_loadu_si128((const __m128i*)src);
+
+        // check if everything is ASCII
+        // movemask extracts the high bit of every byte, so n is non-zero if something isn't ASCII
+        uint n = _mm_movemask_epi8(data);
+        if (n) {
+            // find the next probable ASCII character
+            // we don't want to load 16 bytes again in this loop if we know there are non-ASCII
+            // characters still coming
+            nextAscii = src + qBitScanReverse(n) + 1;
+
+            // copy the front part that is still ASCII
+            while (!(n & 1)) {
+                *dst++ = *src++;
+                n >>= 1;
+            }
+            return false;
+        }
+
+        // unpack
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi8(data, _mm_setzero_si128()));
+        _mm_storeu_si128(1+(__m128i*)dst, _mm_unpackhi_epi8(data, _mm_setzero_si128()));
+    }
+    nextAscii = end;
+    return src == end;
+}
+#elif defined(__ARM_NEON__)
+// Refer to the documentation of the SSE2 implementation.
+// NEON has no movemask, so we narrow the comparison result and check it
+// as a 64-bit integer instead; each byte of that integer is 0xff for a
+// non-ASCII character (or a NUL when encoding).
+static inline uint neonNonAsciiMask(uint8x8_t nonAscii)
+{
+    quint64 m = vget_lane_u64(vreinterpret_u64_u8(nonAscii), 0);
+    uint n = 0;
+    for (int i = 0; i < 8; ++i) {
+        if (m & (Q_UINT64_C(0x80) << (8 * i)))
+            n |= 1U << i;
+    }
+    return n;
+}
+
+static inline bool simdEncodeAscii(uchar *&dst, const ushort *&nextAscii, const ushort *&src, const ushort *end)
+{
+    // do eight characters at a time
+    const uint16x8_t asciiMax = vdupq_n_u16(0x7f);
+    for ( ; end - src >= 8; src += 8, dst += 8) {
+        const uint16x8_t data = vld1q_u16(src);
+
+        // narrow and store, even if there are non-ASCII characters here
+        vst1_u8(dst, vmovn_u16(data));
+
+        // a lane is non-ASCII if it's greater than U+007F
+        const uint8x8_t nonAscii = vmovn_u16(vcgtq_u16(data, asciiMax));
+        if (vget_lane_u64(vreinterpret_u64_u8(nonAscii), 0)) {
+            uint n = neonNonAsciiMask(nonAscii);
+            nextAscii = src + qBitScanReverse(n) + 1;
+            while (!(n & 1)) {
+                ++dst;
+                ++src;
+                n >>= 1;
+            }
+            return false;
+        }
+    }
+    nextAscii = end;
+    return src == end;
+}
+
+static inline bool simdDecodeAscii(ushort *&dst, const uchar *&nextAscii, const uchar *&src, const uchar *end)
+{
+    // do eight characters at a time
+    for ( ; end - src >= 8; src += 8, dst += 8) {
+        const uint8x8_t data = vld1_u8(src);
+
+        // the high bit is set on every non-ASCII byte
+        const uint8x8_t nonAscii = vtst_u8(data, vdup_n_u8(0x80));
+        if (vget_lane_u64(vreinterpret_u64_u8(nonAscii), 0)) {
+            uint n = neonNonAsciiMask(nonAscii);
+            nextAscii = src + qBitScanReverse(n) + 1;
+            while (!(n & 1)) {
+                *dst++ = *src++;
+                n >>= 1;
+            }
+            return false;
+        }
+
+        // widen and store
+        vst1q_u16(dst, vmovl_u8(data));
+    }
+    nextAscii = end;
+    return src == end;
+}
+#else
+static inline bool simdEncodeAscii(uchar *, const ushort *&nextAscii, const ushort *, const ushort *end)
+{
+    nextAscii = end;
+    return false;
+}
+
+static inline bool simdDecodeAscii(ushort *, const uchar *&nextAscii, const uchar *, const uchar *end)
+{
+    nextAscii = end;
+    return false;
+}
+#endif
+
 QByteArray QUtf8::convertFromUnicode(const QChar *uc, int len, QTextCodec::ConverterState *state)
 {
     uchar replacement = '?';
@@ -74,7 +245,17 @@ QByteArray QUtf8::convertFromUnicode(const QChar *uc, int len, QTextCodec::Conve
     }
 
     const QChar *end = ch + len;
+    const ushort *nextAscii = reinterpret_cast<const ushort *>(ch);
     while (ch < end) {
+        if (surrogate_high < 0 && reinterpret_cast<const ushort *>(ch) >= nextAscii) {
+            // convert a run of US-ASCII characters in bulk
+            const ushort *src = reinterpret_cast<const ushort *>(ch);
+            bool done = simdEncodeAscii(cursor, nextAscii, src, reinterpret_cast<const ushort *>(end));
+            ch = reinterpret_cast<const QChar *>(src);
+            if (done)
+                break;
+        }
+
         uint u = ch->unicode();
         if (surrogate_high >= 0) {
             if (ch->isLowSurrogate()) {
@@ -164,7 +345,23 @@ QString QUtf8::convertToUnicode(const char *chars, int len, QTextCodec::Converte
     uchar ch;
     int invalid = 0;
 
+    const uchar *src = reinterpret_cast<const uchar *>(chars);
+    const uchar *end = src + len;
+    const uchar *nextAscii = src;
     for (int i = 0; i < len; ++i) {
+        if (!need && src + i >= nextAscii) {
+            // convert a run of US-ASCII characters in bulk
+            const uchar *start = src + i;
+            const uchar *ptr = start;
+            bool done = simdDecodeAscii(qch, nextAscii, ptr, end);
+            if (ptr != start) {
+                headerdone = true;
+                i += ptr - start;
+            }
+            if (done)
+                break;
+        }
+
         ch = chars[i];
         if (need) {
             if ((ch&0xc0) == 0x80) {
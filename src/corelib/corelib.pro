@@ -27,6 +27,8 @@ ANDROID_BUNDLED_JAR_DEPENDENCIES = \
 
 load(qt_module)
 
+CONFIG += simd
+
 include(animation/animation.pri)
 include(arch/arch.pri)
 include(global/global.pri)
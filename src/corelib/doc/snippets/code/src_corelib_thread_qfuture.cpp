@@ -62,3 +62,26 @@ i.toBack();
 while (i.hasPrevious())
     qDebug() << i.previous();
 //! [2]
+
+
+//! [3]
+QFuture<QByteArray> download = QtConcurrent::run(readFile, fileName);
+
+QFuture<int> count = download.then(QThreadPool::globalInstance(), [](const QByteArray &data) {
+    return parseRecords(data);
+}).then([](const QList<Record> &records) {
+    return records.count();
+});
+//! [3]
+
+
+//! [4]
+QList<QFuture<Image> > futures;
+foreach (const QString &fileName, fileNames)
+    futures.append(QtConcurrent::run(loadImage, fileName));
+
+QtFuture::whenAll(futures).then([](const QList<QFuture<Image> > &images) {
+    foreach (const QFuture<Image> &image, images)
+        addThumbnail(image.result());
+});
+//! [4]
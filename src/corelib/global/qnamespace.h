@@ -512,6 +512,7 @@ public:
         AA_SynthesizeTouchForUnhandledMouseEvents = 11,
         AA_SynthesizeMouseForUnhandledTouchEvents = 12,
         AA_UseHighDpiPixmaps = 13,
+        AA_UseEpollEventDispatcher = 14,
 
         // Add new attributes before this line
         AA_AttributeCount
@@ -1240,6 +1241,7 @@ public:
         DirectConnection,
         QueuedConnection,
         BlockingQueuedConnection,
+        QueuedCoalescedConnection,
         UniqueConnection =  0x80
     };
 
@@ -10,6 +10,7 @@ HEADERS +=  \
         io/qdir.h \
         io/qdir_p.h \
         io/qdiriterator.h \
+        io/qdiriterator_p.h \
         io/qfile.h \
         io/qfiledevice.h \
         io/qfiledevice_p.h \
@@ -21,6 +22,7 @@ HEADERS +=  \
         io/qlockfile.h \
         io/qlockfile_p.h \
         io/qnoncontiguousbytedevice_p.h \
+        io/qparalleldiriterator.h \
         io/qprocess.h \
         io/qprocess_p.h \
         io/qtextstream.h \
@@ -70,6 +72,7 @@ SOURCES += \
         io/qiodevice.cpp \
         io/qlockfile.cpp \
         io/qnoncontiguousbytedevice.cpp \
+        io/qparalleldiriterator.cpp \
         io/qprocess.cpp \
         io/qtextstream.cpp \
         io/qtemporarydir.cpp \
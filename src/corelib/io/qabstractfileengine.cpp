@@ -493,6 +493,23 @@ bool QAbstractFileEngine::copy(const QString &newName)
     return false;
 }
 
+/*!
+    \since 5.3
+
+    Copies the contents of this file, which is open for reading, into the
+    empty \a target file, which is open for writing, without reading the
+    data into memory. Returns \c true on success. If this is not possible,
+    false is returned and nothing has been copied, so that the caller can
+    copy the data itself.
+
+    This implementation returns \c false.
+*/
+bool QAbstractFileEngine::cloneTo(QAbstractFileEngine *target)
+{
+    Q_UNUSED(target);
+    return false;
+}
+
 /*!
     Requests that the file be renamed to \a newName in the file
     system. If the operation succeeds return true; otherwise return
@@ -833,6 +850,79 @@ bool QAbstractFileEngine::unmap(uchar *address)
     return extension(UnMapExtension, &options);
 }
 
+/*!
+    \since 5.3
+
+    Reads from the file into the \a count \a buffers, filling each one
+    before moving on to the next, and returns the number of bytes read, or
+    -1 if an error occurred.
+
+    This function bases its behavior on calling extension() with
+    ReadVectorExtensionOption. If the engine does not support this
+    extension, read() is called for each buffer.
+
+    \sa writeVector(), supportsExtension()
+*/
+qint64 QAbstractFileEngine::readVector(const QIODevice::Buffer *buffers, int count)
+{
+    if (supportsExtension(ReadVectorExtension)) {
+        ReadVectorExtensionOption option;
+        option.buffers = buffers;
+        option.count = count;
+        VectorExtensionReturn r;
+        if (!extension(ReadVectorExtension, &option, &r))
+            return -1;
+        return r.result;
+    }
+
+    qint64 readSoFar = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 readBytes = read(buffers[i].data, buffers[i].size);
+        if (readBytes < 0)
+            return readSoFar ? readSoFar : readBytes;
+        readSoFar += readBytes;
+        if (readBytes < buffers[i].size)
+            break;
+    }
+    return readSoFar;
+}
+
+/*!
+    \since 5.3
+
+    Writes the \a count \a buffers to the file, in order, and returns the
+    number of bytes written, or -1 if an error occurred.
+
+    This function bases its behavior on calling extension() with
+    WriteVectorExtensionOption. If the engine does not support this
+    extension, write() is called for each buffer.
+
+    \sa readVector(), supportsExtension()
+*/
+qint64 QAbstractFileEngine::writeVector(const QByteArrayView *buffers, int count)
+{
+    if (supportsExtension(WriteVectorExtension)) {
+        WriteVectorExtensionOption option;
+        option.buffers = buffers;
+        option.count = count;
+        VectorExtensionReturn r;
+        if (!extension(WriteVectorExtension, &option, &r))
+            return -1;
+        return r.result;
+    }
+
+    qint64 writtenSoFar = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 written = write(buffers[i].data(), buffers[i].size());
+        if (written < 0)
+            return writtenSoFar ? writtenSoFar : written;
+        writtenSoFar += written;
+        if (written < buffers[i].size())
+            break;
+    }
+    return writtenSoFar;
+}
+
 /*!
     \since 4.3
     \class QAbstractFileEngineIterator
@@ -1165,6 +1255,16 @@ qint64 QAbstractFileEngine::readLine(char *data, qint64 maxlen)
 
    \value UnMapExtension Whether the file engine provides the ability to
    unmap memory that was previously mapped.
+
+   \value ReadVectorExtension Whether the file engine can read into several
+   buffers with one call. The input argument is a ReadVectorExtensionOption
+   and the number of bytes read, or -1, is stored in the
+   VectorExtensionReturn output. This value was introduced in Qt 5.3.
+
+   \value WriteVectorExtension Whether the file engine can write several
+   buffers with one call. The input argument is a WriteVectorExtensionOption
+   and the number of bytes written, or -1, is stored in the
+   VectorExtensionReturn output. This value was introduced in Qt 5.3.
 */
 
 /*!
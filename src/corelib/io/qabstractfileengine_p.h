@@ -131,6 +131,7 @@ public:
     virtual bool isSequential() const;
     virtual bool remove();
     virtual bool copy(const QString &newName);
+    virtual bool cloneTo(QAbstractFileEngine *target);
     virtual bool rename(const QString &newName);
     virtual bool renameOverwrite(const QString &newName);
     virtual bool link(const QString &newName);
@@ -151,6 +152,8 @@ public:
     bool atEnd() const;
     uchar *map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags);
     bool unmap(uchar *ptr);
+    qint64 readVector(const QIODevice::Buffer *buffers, int count);
+    qint64 writeVector(const QByteArrayView *buffers, int count);
 
     typedef QAbstractFileEngineIterator Iterator;
     virtual Iterator *beginEntryList(QDir::Filters filters, const QStringList &filterNames);
@@ -167,7 +170,9 @@ public:
         AtEndExtension,
         FastReadLineExtension,
         MapExtension,
-        UnMapExtension
+        UnMapExtension,
+        ReadVectorExtension,
+        WriteVectorExtension
     };
     class ExtensionOption
     {};
@@ -190,6 +195,21 @@ public:
         uchar *address;
     };
 
+    class ReadVectorExtensionOption : public ExtensionOption {
+    public:
+        const QIODevice::Buffer *buffers;
+        int count;
+    };
+    class WriteVectorExtensionOption : public ExtensionOption {
+    public:
+        const QByteArrayView *buffers;
+        int count;
+    };
+    class VectorExtensionReturn : public ExtensionReturn {
+    public:
+        qint64 result;
+    };
+
     virtual bool extension(Extension extension, const ExtensionOption *option = 0, ExtensionReturn *output = 0);
     virtual bool supportsExtension(Extension extension) const;
 
@@ -88,76 +88,29 @@
 */
 
 #include "qdiriterator.h"
+#include "qdiriterator_p.h"
 #include "qdir_p.h"
 #include "qabstractfileengine_p.h"
 
-#include <QtCore/qset.h>
-#include <QtCore/qstack.h>
 #include <QtCore/qvariant.h>
 
-#include <QtCore/private/qfilesystemiterator_p.h>
-#include <QtCore/private/qfilesystementry_p.h>
 #include <QtCore/private/qfilesystemmetadata_p.h>
 #include <QtCore/private/qfilesystemengine_p.h>
 #include <QtCore/private/qfileinfo_p.h>
 
 QT_BEGIN_NAMESPACE
 
-template <class Iterator>
-class QDirIteratorPrivateIteratorStack : public QStack<Iterator *>
-{
-public:
-    ~QDirIteratorPrivateIteratorStack()
-    {
-        qDeleteAll(*this);
-    }
-};
-
-class QDirIteratorPrivate
-{
-public:
-    QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
-                        QDir::Filters filters, QDirIterator::IteratorFlags flags, bool resolveEngine = true);
-
-    void advance();
-
-    bool entryMatches(const QString & fileName, const QFileInfo &fileInfo);
-    void pushDirectory(const QFileInfo &fileInfo);
-    void checkAndPushDirectory(const QFileInfo &);
-    bool matchesFilters(const QString &fileName, const QFileInfo &fi) const;
-
-    QScopedPointer<QAbstractFileEngine> engine;
-
-    QFileSystemEntry dirEntry;
-    const QStringList nameFilters;
-    const QDir::Filters filters;
-    const QDirIterator::IteratorFlags iteratorFlags;
-
-#ifndef QT_NO_REGEXP
-    QVector<QRegExp> nameRegExps;
-#endif
-
-    QDirIteratorPrivateIteratorStack<QAbstractFileEngineIterator> fileEngineIterators;
-#ifndef QT_NO_FILESYSTEMITERATOR
-    QDirIteratorPrivateIteratorStack<QFileSystemIterator> nativeIterators;
-#endif
-
-    QFileInfo currentFileInfo;
-    QFileInfo nextFileInfo;
-
-    // Loop protection
-    QSet<QString> visitedLinks;
-};
-
 /*!
     \internal
 */
 QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
-                                         QDir::Filters filters, QDirIterator::IteratorFlags flags, bool resolveEngine)
+                                         QDir::Filters filters, QDirIterator::IteratorFlags flags, bool resolveEngine,
+                                         QFileInfoList *deferredDirectories)
     : dirEntry(entry)
       , nameFilters(nameFilters.contains(QLatin1String("*")) ? QStringList() : nameFilters)
       , filters(QDir::NoFilter == filters ? QDir::AllEntries : filters)
       , iteratorFlags(flags)
+      , deferredDirectories(deferredDirectories)
 {
 #ifndef QT_NO_REGEXP
     nameRegExps.reserve(nameFilters.size());
@@ -189,7 +142,7 @@ void QDirIteratorPrivate::pushDirectory(const QFileInfo &fileInfo)
         path = fileInfo.canonicalFilePath();
 #endif
 
-    if (iteratorFlags & QDirIterator::FollowSymlinks)
+    if ((iteratorFlags & QDirIterator::FollowSymlinks) && !deferredDirectories)
         visitedLinks << fileInfo.canonicalFilePath();
 
     if (engine) {
@@ -225,6 +178,21 @@ inline bool QDirIteratorPrivate::entryMatches(const QString & fileName, const QF
     return false;
 }
 
+/*!
+    \internal
+*/
+bool QDirIteratorPrivate::hasNext() const
+{
+    if (engine)
+        return !fileEngineIterators.isEmpty();
+    else
+#ifndef QT_NO_FILESYSTEMITERATOR
+        return !nativeIterators.isEmpty();
+#else
+        return false;
+#endif
+}
+
 /*!
     \internal
 */
@@ -299,7 +267,10 @@ void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
         visitedLinks.contains(fileInfo.canonicalFilePath()))
         return;
 
-    pushDirectory(fileInfo);
+    if (deferredDirectories)
+        deferredDirectories->append(fileInfo);
+    else
+        pushDirectory(fileInfo);
 }
 
 /*!
@@ -498,14 +469,7 @@ QString QDirIterator::next()
 */
 bool QDirIterator::hasNext() const
 {
-    if (d->engine)
-        return !d->fileEngineIterators.isEmpty();
-    else
-#ifndef QT_NO_FILESYSTEMITERATOR
-        return !d->nativeIterators.isEmpty();
-#else
-        return false;
-#endif
+    return d->hasNext();
 }
 
 /*!
@@ -785,25 +785,28 @@ QFile::copy(const QString &newName)
                     close();
                     d->setError(QFile::CopyError, tr("Cannot open for output"));
                 } else {
-                    char block[4096];
-                    qint64 totalRead = 0;
-                    while(!atEnd()) {
-                        qint64 in = read(block, sizeof(block));
-                        if (in <= 0)
-                            break;
-                        totalRead += in;
-                        if(in != out.write(block, in)) {
-                            close();
-                            d->setError(QFile::CopyError, tr("Failure to write block"));
-                            error = true;
-                            break;
+                    // Let the file engine copy it without reading it in if it can.
+                    if (!d->engine()->cloneTo(static_cast<QFile &>(out).d_func()->engine())) {
+                        char block[4096];
+                        qint64 totalRead = 0;
+                        while(!atEnd()) {
+                            qint64 in = read(block, sizeof(block));
+                            if (in <= 0)
+                                break;
+                            totalRead += in;
+                            if(in != out.write(block, in)) {
+                                close();
+                                d->setError(QFile::CopyError, tr("Failure to write block"));
+                                error = true;
+                                break;
+                            }
                         }
-                    }
 
-                    if (totalRead != size()) {
-                        // Unable to read from the source. The error string is
-                        // already set from read().
-                        error = true;
+                        if (totalRead != size()) {
+                            // Unable to read from the source. The error string is
+                            // already set from read().
+                            error = true;
+                        }
                     }
                     if (!error && !out.rename(newName)) {
                         error = true;
@@ -574,6 +574,76 @@ qint64 QFileDevice::writeData(const char *data, qint64 len)
     return len;
 }
 
+/*!
+    \internal
+
+    Reads straight into \a buffers through the file engine, which does it
+    with one readv() for plain file descriptors.
+*/
+qint64 QFileDevicePrivate::readDataVector(const QIODevice::Buffer *buffers, int count)
+{
+    Q_Q(QFileDevice);
+    q->unsetError();
+    if (!ensureFlushed())
+        return -1;
+
+    qint64 len = 0;
+    for (int i = 0; i < count; ++i)
+        len += buffers[i].size;
+    if (!len)
+        return 0;
+
+    const qint64 read = fileEngine->readVector(buffers, count);
+    if (read < 0) {
+        QFileDevice::FileError err = fileEngine->error();
+        if (err == QFileDevice::UnspecifiedError)
+            err = QFileDevice::ReadError;
+        setError(err, fileEngine->errorString());
+    }
+
+    if (read < len) {
+        // may be at the end of file, stop caching size so that it's rechecked
+        cachedSize = 0;
+    }
+
+    return read;
+}
+
+/*!
+    \internal
+
+    Hands \a buffers to the file engine in one go, unless they are small
+    enough to go through the write buffer.
+*/
+qint64 QFileDevicePrivate::writeDataVector(const QByteArrayView *buffers, int count)
+{
+    Q_Q(QFileDevice);
+    const bool buffered = !(openMode & QIODevice::Unbuffered);
+
+    qint64 len = 0;
+    for (int i = 0; i < count; ++i)
+        len += buffers[i].size();
+
+    if (buffered && writeBuffer.size() + len <= QFILE_WRITEBUFFER_SIZE)
+        return QIODevicePrivate::writeDataVector(buffers, count);
+
+    q->unsetError();
+    lastWasWrite = true;
+
+    // Keep the data in order: whatever is buffered goes out first.
+    if (buffered && !writeBuffer.isEmpty() && !q->flush())
+        return -1;
+
+    const qint64 ret = fileEngine->writeVector(buffers, count);
+    if (ret < 0) {
+        QFileDevice::FileError err = fileEngine->error();
+        if (err == QFileDevice::UnspecifiedError)
+            err = QFileDevice::WriteError;
+        setError(err, fileEngine->errorString());
+    }
+    return ret;
+}
+
 /*!
     Returns the file error status.
 
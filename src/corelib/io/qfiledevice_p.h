@@ -74,6 +74,9 @@ protected:
 
     bool putCharHelper(char c);
 
+    qint64 readDataVector(const QIODevice::Buffer *buffers, int count);
+    qint64 writeDataVector(const QByteArrayView *buffers, int count);
+
     void setError(QFileDevice::FileError err);
     void setError(QFileDevice::FileError err, const QString &errorString);
     void setError(QFileDevice::FileError err, int errNum);
@@ -237,37 +237,42 @@ static void fillStat64fromStat32(struct stat64 *statBuf64, const struct stat &st
 }
 #endif
 
-void QFileSystemMetaData::fillFromStatBuf(const QT_STATBUF &statBuffer)
+void QFileSystemMetaData::fillFromMode(mode_t mode)
 {
     // Permissions
-    if (statBuffer.st_mode & S_IRUSR)
+    if (mode & S_IRUSR)
         entryFlags |= QFileSystemMetaData::OwnerReadPermission;
-    if (statBuffer.st_mode & S_IWUSR)
+    if (mode & S_IWUSR)
         entryFlags |= QFileSystemMetaData::OwnerWritePermission;
-    if (statBuffer.st_mode & S_IXUSR)
+    if (mode & S_IXUSR)
         entryFlags |= QFileSystemMetaData::OwnerExecutePermission;
 
-    if (statBuffer.st_mode & S_IRGRP)
+    if (mode & S_IRGRP)
         entryFlags |= QFileSystemMetaData::GroupReadPermission;
-    if (statBuffer.st_mode & S_IWGRP)
+    if (mode & S_IWGRP)
         entryFlags |= QFileSystemMetaData::GroupWritePermission;
-    if (statBuffer.st_mode & S_IXGRP)
+    if (mode & S_IXGRP)
         entryFlags |= QFileSystemMetaData::GroupExecutePermission;
 
-    if (statBuffer.st_mode & S_IROTH)
+    if (mode & S_IROTH)
         entryFlags |= QFileSystemMetaData::OtherReadPermission;
-    if (statBuffer.st_mode & S_IWOTH)
+    if (mode & S_IWOTH)
         entryFlags |= QFileSystemMetaData::OtherWritePermission;
-    if (statBuffer.st_mode & S_IXOTH)
+    if (mode & S_IXOTH)
         entryFlags |= QFileSystemMetaData::OtherExecutePermission;
 
     // Type
-    if ((statBuffer.st_mode & S_IFMT) == S_IFREG)
+    if ((mode & S_IFMT) == S_IFREG)
         entryFlags |= QFileSystemMetaData::FileType;
-    else if ((statBuffer.st_mode & S_IFMT) == S_IFDIR)
+    else if ((mode & S_IFMT) == S_IFDIR)
         entryFlags |= QFileSystemMetaData::DirectoryType;
     else
         entryFlags |= QFileSystemMetaData::SequentialType;
+}
+
+void QFileSystemMetaData::fillFromStatBuf(const QT_STATBUF &statBuffer)
+{
+    fillFromMode(statBuffer.st_mode);
 
     // Attributes
     entryFlags |= QFileSystemMetaData::ExistsAttribute;
@@ -287,6 +292,41 @@ void QFileSystemMetaData::fillFromStatBuf(const QT_STATBUF &statBuffer)
     groupId_ = statBuffer.st_gid;
 }
 
+#ifdef QT_FILESYSTEM_HAVE_STATX
+// Unlike fillFromStatBuf(), this only marks as known what the kernel actually
+// returned, so callers can ask statx() for just the fields they need.
+void QFileSystemMetaData::fillFromStatxBuf(const struct statx &statxBuffer)
+{
+    const unsigned int mask = statxBuffer.stx_mask;
+
+    if ((mask & (STATX_TYPE | STATX_MODE)) == (STATX_TYPE | STATX_MODE)) {
+        fillFromMode(statxBuffer.stx_mode);
+        knownFlagsMask |= QFileSystemMetaData::PosixModeFlags;
+    }
+
+    entryFlags |= QFileSystemMetaData::ExistsAttribute;
+
+    if (mask & STATX_SIZE) {
+        size_ = statxBuffer.stx_size;
+        knownFlagsMask |= QFileSystemMetaData::SizeAttribute;
+    }
+
+    const unsigned int timesMask = STATX_CTIME | STATX_MTIME | STATX_ATIME;
+    if ((mask & timesMask) == timesMask) {
+        creationTime_ = statxBuffer.stx_ctime.tv_sec ? statxBuffer.stx_ctime.tv_sec : statxBuffer.stx_mtime.tv_sec;
+        modificationTime_ = statxBuffer.stx_mtime.tv_sec;
+        accessTime_ = statxBuffer.stx_atime.tv_sec;
+        knownFlagsMask |= QFileSystemMetaData::Times;
+    }
+
+    if ((mask & (STATX_UID | STATX_GID)) == (STATX_UID | STATX_GID)) {
+        userId_ = statxBuffer.stx_uid;
+        groupId_ = statxBuffer.stx_gid;
+        knownFlagsMask |= QFileSystemMetaData::OwnerIds;
+    }
+}
+#endif
+
 void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
 {
 #if defined(Q_OS_QNX)
@@ -332,9 +372,17 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
     }
 #elif defined(_DIRENT_HAVE_D_TYPE) || defined(Q_OS_BSD4)
     // BSD4 includes Mac OS X
+    fillFromDirEnt(entry.d_name, entry.d_type);
+#else
+    Q_UNUSED(entry)
+#endif
+}
 
+#if defined(_DIRENT_HAVE_D_TYPE) || defined(Q_OS_BSD4)
+void QFileSystemMetaData::fillFromDirEnt(const char *name, unsigned char type)
+{
     // ### This will clear all entry flags and knownFlagsMask
-    switch (entry.d_type)
+    switch (type)
     {
     case DT_DIR:
         knownFlagsMask = QFileSystemMetaData::LinkType
@@ -387,11 +435,20 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
     case DT_UNKNOWN:
     default:
         clear();
+        entryFlags = 0;
     }
+
+#if !defined(Q_OS_MACX)
+    // Hidden files are just dot files here, so QFileInfo::isHidden() needs no
+    // further lookup.
+    if (name[0] == '.')
+        entryFlags |= QFileSystemMetaData::HiddenAttribute;
+    knownFlagsMask |= QFileSystemMetaData::HiddenAttribute;
 #else
-    Q_UNUSED(entry)
+    Q_UNUSED(name)
 #endif
 }
+#endif
 
 #endif
 
@@ -94,6 +94,7 @@ public:
                              QFileSystemMetaData::MetaDataFlags what);
 #if defined(Q_OS_UNIX)
     static bool fillMetaData(int fd, QFileSystemMetaData &data); // what = PosixStatFlags
+    static bool cloneFile(int srcfd, int dstfd);
 #endif
 #if defined(Q_OS_WIN)
 
@@ -131,6 +132,10 @@ public:
                                                                   QFileSystemMetaData &data);
 private:
     static QString slowCanonicalized(const QString &path);
+#ifdef QT_FILESYSTEM_HAVE_STATX
+    static int fillMetaDataStatx(const char *nativeFilePath, QFileSystemMetaData &data,
+                                 QFileSystemMetaData::MetaDataFlags what);
+#endif
 #if defined(Q_OS_WIN)
     static void clearWinStatData(QFileSystemMetaData &data);
 #endif
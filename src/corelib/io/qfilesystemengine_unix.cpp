@@ -43,6 +43,7 @@
 #include "qplatformdefs.h"
 #include "qfilesystemengine_p.h"
 #include "qfile.h"
+#include "private/qcore_unix_p.h"
 
 #include <QtCore/qvarlengtharray.h>
 
@@ -59,6 +60,16 @@
 # include <CoreFoundation/CFBundle.h>
 #endif
 
+#if defined(Q_OS_LINUX)
+# include <sys/ioctl.h>
+# include <sys/sendfile.h>
+# include <sys/syscall.h>
+# include <linux/fs.h>
+# ifndef FICLONE
+#  define FICLONE _IOW(0x94, 9, int)
+# endif
+#endif
+
 QT_BEGIN_NAMESPACE
 
 #if defined(Q_OS_MACX)
@@ -421,6 +432,74 @@ QString QFileSystemEngine::bundleName(const QFileSystemEntry &entry)
 }
 #endif
 
+#ifdef QT_FILESYSTEM_HAVE_STATX
+// Asks statx() for just the stat fields in \a what, leaving the others unknown
+// until somebody needs them. Returns 1 if the entry exists, 0 if it does not
+// and -1 if statx() is not usable here, in which case nothing was filled in.
+//static
+int QFileSystemEngine::fillMetaDataStatx(const char *nativeFilePath, QFileSystemMetaData &data,
+                                         QFileSystemMetaData::MetaDataFlags what)
+{
+    unsigned int mask = STATX_TYPE | STATX_MODE;
+    if (what & QFileSystemMetaData::SizeAttribute)
+        mask |= STATX_SIZE;
+    if (what & QFileSystemMetaData::Times)
+        mask |= STATX_CTIME | STATX_MTIME | STATX_ATIME;
+    if (what & QFileSystemMetaData::OwnerIds)
+        mask |= STATX_UID | STATX_GID;
+
+    bool entryExists = true;
+
+    struct statx statxBuffer;
+    bool statxBufferValid = false;
+    if (what & QFileSystemMetaData::LinkType) {
+        if (::statx(AT_FDCWD, nativeFilePath, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT, mask, &statxBuffer) == 0) {
+            if (S_ISLNK(statxBuffer.stx_mode)) {
+                data.entryFlags |= QFileSystemMetaData::LinkType;
+            } else {
+                statxBufferValid = true;
+                data.entryFlags &= ~QFileSystemMetaData::PosixModeFlags;
+            }
+        } else if (errno == ENOSYS || errno == EPERM) {
+            // Kernel too old or the call is filtered out (e.g. by seccomp)
+            return -1;
+        } else {
+            entryExists = false;
+        }
+
+        data.knownFlagsMask |= QFileSystemMetaData::LinkType;
+    }
+
+    if (statxBufferValid || (what & (QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::ExistsAttribute))) {
+        if (entryExists && !statxBufferValid) {
+            if (::statx(AT_FDCWD, nativeFilePath, AT_NO_AUTOMOUNT, mask, &statxBuffer) == 0)
+                statxBufferValid = true;
+            else if (errno == ENOSYS || errno == EPERM)
+                return -1;
+        }
+
+        if (statxBufferValid) {
+            data.fillFromStatxBuf(statxBuffer);
+        } else {
+            entryExists = false;
+            data.creationTime_ = 0;
+            data.modificationTime_ = 0;
+            data.accessTime_ = 0;
+            data.size_ = 0;
+            data.userId_ = (uint) -2;
+            data.groupId_ = (uint) -2;
+            // known, like after a failed stat(): there is nothing to fetch
+            data.entryFlags &= ~QFileSystemMetaData::PosixStatFlags;
+            data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags;
+        }
+
+        data.knownFlagsMask |= QFileSystemMetaData::ExistsAttribute;
+    }
+
+    return entryExists ? 1 : 0;
+}
+#endif
+
 //static
 bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
         QFileSystemMetaData::MetaDataFlags what)
@@ -436,6 +515,10 @@ bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemM
     }
 #endif // defined(Q_OS_MACX)
 
+#ifdef QT_FILESYSTEM_HAVE_STATX
+    const QFileSystemMetaData::MetaDataFlags requested = what;
+#endif
+
     if (what & QFileSystemMetaData::PosixStatFlags)
         what |= QFileSystemMetaData::PosixStatFlags;
 
@@ -457,9 +540,22 @@ bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemM
 
     bool entryExists = true; // innocent until proven otherwise
 
+    bool statDone = false;
+#ifdef QT_FILESYSTEM_HAVE_STATX
+    if (what & (QFileSystemMetaData::LinkType | QFileSystemMetaData::PosixStatFlags)) {
+        const int result = fillMetaDataStatx(nativeFilePath, data, requested);
+        if (result != -1) {
+            statDone = true;
+            entryExists = (result == 1);
+            // Stat fields that were not asked for have not been fetched
+            what &= ~QFileSystemMetaData::PosixStatFlags | requested;
+        }
+    }
+#endif
+
     QT_STATBUF statBuffer;
     bool statBufferValid = false;
-    if (what & QFileSystemMetaData::LinkType) {
+    if (!statDone && (what & QFileSystemMetaData::LinkType)) {
         if (QT_LSTAT(nativeFilePath, &statBuffer) == 0) {
             if (S_ISLNK(statBuffer.st_mode)) {
                 data.entryFlags |= QFileSystemMetaData::LinkType;
@@ -474,7 +570,7 @@ bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemM
         data.knownFlagsMask |= QFileSystemMetaData::LinkType;
     }
 
-    if (statBufferValid || (what & QFileSystemMetaData::PosixStatFlags)) {
+    if (!statDone && (statBufferValid || (what & QFileSystemMetaData::PosixStatFlags))) {
         if (entryExists && !statBufferValid)
             statBufferValid = (QT_STAT(nativeFilePath, &statBuffer) == 0);
 
@@ -629,6 +725,66 @@ bool QFileSystemEngine::createLink(const QFileSystemEntry &source, const QFileSy
     return false;
 }
 
+// Copies the contents of the file open on \a srcfd into the empty file open
+// on \a dstfd without going through user space. Returns false, having copied
+// nothing, if it can't.
+//static
+bool QFileSystemEngine::cloneFile(int srcfd, int dstfd)
+{
+    QT_STATBUF statBuffer;
+    if (QT_FSTAT(srcfd, &statBuffer) == -1 || !S_ISREG(statBuffer.st_mode))
+        return false; // let QFile do the copy
+
+#if defined(Q_OS_LINUX)
+    // Share the data blocks, on file systems that can (Btrfs, XFS).
+    if (::ioctl(dstfd, FICLONE, srcfd) == 0)
+        return true;
+
+    // Otherwise have the kernel copy the data. Both calls move at most
+    // 2 GB - 4 KB at a time.
+    const size_t chunkSize = 0x7ffff000;
+    qint64 copied = 0;
+# ifdef SYS_copy_file_range
+    bool useCopyFileRange = true;
+# endif
+    forever {
+        ssize_t n;
+# ifdef SYS_copy_file_range
+        if (useCopyFileRange) {
+            EINTR_LOOP(n, ssize_t(::syscall(SYS_copy_file_range, srcfd, (void *)0, dstfd, (void *)0,
+                                            chunkSize, 0u)));
+            if (n == -1 && copied == 0) {
+                // Older kernels don't have it or can't copy across file
+                // systems; sendfile() can.
+                useCopyFileRange = false;
+                continue;
+            }
+        } else
+# endif
+        {
+            EINTR_LOOP(n, ::sendfile(dstfd, srcfd, 0, chunkSize));
+        }
+
+        if (n == 0)
+            return true;
+        if (n == -1) {
+            if (copied) {
+                // A real error such as ENOSPC, but QFile has no way to pick up
+                // a partial copy, so start over for it.
+                QT_FTRUNCATE(dstfd, 0);
+                QT_LSEEK(srcfd, 0, SEEK_SET);
+                QT_LSEEK(dstfd, 0, SEEK_SET);
+            }
+            return false;
+        }
+        copied += n;
+    }
+#else
+    Q_UNUSED(dstfd);
+    return false;
+#endif
+}
+
 //static
 bool QFileSystemEngine::copyFile(const QFileSystemEntry &source, const QFileSystemEntry &target, QSystemError &error)
 {
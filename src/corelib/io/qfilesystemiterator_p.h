@@ -92,6 +92,12 @@ private:
     bool uncFallback;
     int uncShareIndex;
     bool onlyDirs;
+#elif defined(Q_OS_LINUX)
+    int dirFd;
+    QScopedPointer<char, QScopedPointerPodDeleter> buffer;
+    int bufferSize;
+    int bufferPos;
+    int lastError;
 #else
     QT_DIR *dir;
     QT_DIRENT *dirEntry;
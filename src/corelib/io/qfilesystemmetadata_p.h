@@ -66,6 +66,10 @@
 #  endif
 #endif
 
+#if defined(Q_OS_LINUX) && defined(STATX_BASIC_STATS)
+#  define QT_FILESYSTEM_HAVE_STATX
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QFileSystemEngine;
@@ -138,6 +142,13 @@ public:
 
         OwnerIds            = UserId | GroupId,
 
+        PosixModeFlags      = QFileSystemMetaData::OtherPermissions
+                            | QFileSystemMetaData::GroupPermissions
+                            | QFileSystemMetaData::OwnerPermissions
+                            | QFileSystemMetaData::FileType
+                            | QFileSystemMetaData::DirectoryType
+                            | QFileSystemMetaData::SequentialType,
+
         PosixStatFlags      = QFileSystemMetaData::OtherPermissions
                             | QFileSystemMetaData::GroupPermissions
                             | QFileSystemMetaData::OwnerPermissions
@@ -214,6 +225,12 @@ public:
 #ifdef Q_OS_UNIX
     void fillFromStatBuf(const QT_STATBUF &statBuffer);
     void fillFromDirEnt(const QT_DIRENT &statBuffer);
+#if defined(_DIRENT_HAVE_D_TYPE) || defined(Q_OS_BSD4)
+    void fillFromDirEnt(const char *name, unsigned char type);
+#endif
+#endif
+#ifdef QT_FILESYSTEM_HAVE_STATX
+    void fillFromStatxBuf(const struct statx &statxBuffer);
 #endif
 
 #if defined(Q_OS_WIN)
@@ -224,6 +241,10 @@ public:
 private:
     friend class QFileSystemEngine;
 
+#ifdef Q_OS_UNIX
+    void fillFromMode(mode_t mode);
+#endif
+
     MetaDataFlags knownFlagsMask;
     MetaDataFlags entryFlags;
 
@@ -815,6 +815,28 @@ bool QFSFileEngine::extension(Extension extension, const ExtensionOption *option
         UnMapExtensionOption *options = (UnMapExtensionOption*)option;
         return d->unmap(options->address);
     }
+#ifndef Q_OS_WIN
+    if (extension == ReadVectorExtension && d->fd != -1 && !d->fh) {
+        const ReadVectorExtensionOption *options = static_cast<const ReadVectorExtensionOption *>(option);
+        VectorExtensionReturn *returnValue = static_cast<VectorExtensionReturn *>(output);
+        if (d->lastIOCommand != QFSFileEnginePrivate::IOReadCommand) {
+            flush();
+            d->lastIOCommand = QFSFileEnginePrivate::IOReadCommand;
+        }
+        returnValue->result = d->nativeReadVector(options->buffers, options->count);
+        return returnValue->result != -1;
+    }
+    if (extension == WriteVectorExtension && d->fd != -1 && !d->fh) {
+        const WriteVectorExtensionOption *options = static_cast<const WriteVectorExtensionOption *>(option);
+        VectorExtensionReturn *returnValue = static_cast<VectorExtensionReturn *>(output);
+        if (d->lastIOCommand != QFSFileEnginePrivate::IOWriteCommand) {
+            flush();
+            d->lastIOCommand = QFSFileEnginePrivate::IOWriteCommand;
+        }
+        returnValue->result = d->nativeWriteVector(options->buffers, options->count);
+        return returnValue->result != -1;
+    }
+#endif
 
     return false;
 }
@@ -833,6 +855,13 @@ bool QFSFileEngine::supportsExtension(Extension extension) const
         return true;
     if (extension == UnMapExtension || extension == MapExtension)
         return true;
+#ifndef Q_OS_WIN
+    // readv() and writev() need the file descriptor; stdio streams have
+    // their own buffer.
+    if ((extension == ReadVectorExtension || extension == WriteVectorExtension)
+        && d->fd != -1 && !d->fh)
+        return true;
+#endif
     return false;
 }
 
@@ -88,6 +88,7 @@ public:
     bool isSequential() const;
     bool remove();
     bool copy(const QString &newName);
+    bool cloneTo(QAbstractFileEngine *target);
     bool rename(const QString &newName);
     bool renameOverwrite(const QString &newName);
     bool link(const QString &newName);
@@ -167,6 +168,10 @@ public:
     qint64 readLineFdFh(char *data, qint64 maxlen);
     qint64 nativeWrite(const char *data, qint64 len);
     qint64 writeFdFh(const char *data, qint64 len);
+#ifndef Q_OS_WIN
+    qint64 nativeReadVector(const QIODevice::Buffer *buffers, int count);
+    qint64 nativeWriteVector(const QByteArrayView *buffers, int count);
+#endif
     int nativeHandle() const;
     bool nativeIsSequential() const;
 #ifndef Q_OS_WIN
@@ -54,6 +54,7 @@
 #include "qvarlengtharray.h"
 
 #include <sys/mman.h>
+#include <sys/uio.h>
 #include <stdlib.h>
 #include <limits.h>
 #include <errno.h>
@@ -350,6 +351,103 @@ qint64 QFSFileEnginePrivate::nativeWrite(const char *data, qint64 len)
     return writeFdFh(data, len);
 }
 
+#ifndef IOV_MAX
+#  define IOV_MAX 16
+#endif
+
+/*
+    Drops the first \a transferred bytes from the \a count iovecs at \a iov,
+    so that the next readv() or writev() carries on where this one stopped.
+*/
+static void qt_iovec_advance(struct iovec *&iov, int &count, size_t transferred)
+{
+    while (count && transferred >= iov->iov_len) {
+        transferred -= iov->iov_len;
+        ++iov;
+        --count;
+    }
+    if (count) {
+        iov->iov_base = static_cast<char *>(iov->iov_base) + transferred;
+        iov->iov_len -= transferred;
+    }
+}
+
+/*!
+    \internal
+
+    Like readFdFh(), but scatters the data over \a count \a buffers with
+    readv().
+*/
+qint64 QFSFileEnginePrivate::nativeReadVector(const QIODevice::Buffer *buffers, int count)
+{
+    Q_Q(QFSFileEngine);
+
+    QVarLengthArray<struct iovec, 16> iovs(count);
+    for (int i = 0; i < count; ++i) {
+        if (buffers[i].size < 0 || buffers[i].size != qint64(size_t(buffers[i].size))) {
+            q->setError(QFile::ReadError, qt_error_string(EINVAL));
+            return -1;
+        }
+        iovs[i].iov_base = buffers[i].data;
+        iovs[i].iov_len = size_t(buffers[i].size);
+    }
+
+    struct iovec *iov = iovs.data();
+    int remaining = count;
+    qint64 readBytes = 0;
+    ssize_t result;
+    do {
+        EINTR_LOOP(result, ::readv(fd, iov, qMin(remaining, int(IOV_MAX))));
+        if (result > 0) {
+            readBytes += result;
+            qt_iovec_advance(iov, remaining, size_t(result));
+        }
+    } while (result > 0 && remaining);
+
+    if (result == -1 && readBytes == 0) {
+        q->setError(QFile::ReadError, qt_error_string(errno));
+        return -1;
+    }
+    return readBytes;
+}
+
+/*!
+    \internal
+
+    Like writeFdFh(), but gathers the data from \a count \a buffers with
+    writev().
+*/
+qint64 QFSFileEnginePrivate::nativeWriteVector(const QByteArrayView *buffers, int count)
+{
+    Q_Q(QFSFileEngine);
+
+    QVarLengthArray<struct iovec, 16> iovs(count);
+    qint64 len = 0;
+    for (int i = 0; i < count; ++i) {
+        iovs[i].iov_base = const_cast<char *>(buffers[i].data());
+        iovs[i].iov_len = size_t(buffers[i].size());
+        len += buffers[i].size();
+    }
+
+    struct iovec *iov = iovs.data();
+    int remaining = count;
+    qint64 writtenBytes = 0;
+    ssize_t result;
+    do {
+        EINTR_LOOP(result, ::writev(fd, iov, qMin(remaining, int(IOV_MAX))));
+        if (result > 0) {
+            writtenBytes += result;
+            qt_iovec_advance(iov, remaining, size_t(result));
+        }
+    } while (result > 0 && remaining);
+
+    if (len && writtenBytes == 0) {
+        q->setError(errno == ENOSPC ? QFile::ResourceError : QFile::WriteError, qt_error_string(errno));
+        return -1;
+    }
+    return writtenBytes;
+}
+
 /*!
     \internal
 */
@@ -405,6 +503,20 @@ bool QFSFileEngine::copy(const QString &newName)
     return ret;
 }
 
+bool QFSFileEngine::cloneTo(QAbstractFileEngine *target)
+{
+    Q_D(QFSFileEngine);
+    if ((target->fileFlags(LocalDiskFlag) & LocalDiskFlag) == 0)
+        return false;
+
+    // Stay clear of stdio streams, they have their own buffer.
+    int srcfd = d->fh ? -1 : d->fd;
+    int dstfd = target->handle();
+    if (srcfd == -1 || dstfd == -1)
+        return false;
+    return QFileSystemEngine::cloneFile(srcfd, dstfd);
+}
+
 bool QFSFileEngine::renameOverwrite(const QString &newName)
 {
     // On Unix, rename() overwrites.
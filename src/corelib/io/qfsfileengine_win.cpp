@@ -508,6 +508,13 @@ bool QFSFileEngine::copy(const QString &copyName)
     return ret;
 }
 
+bool QFSFileEngine::cloneTo(QAbstractFileEngine *target)
+{
+    // copy() uses CopyFile(), which already avoids the round trip.
+    Q_UNUSED(target);
+    return false;
+}
+
 bool QFSFileEngine::rename(const QString &newName)
 {
     Q_D(QFSFileEngine);
@@ -936,6 +936,130 @@ qint64 QIODevice::read(char *data, qint64 maxSize)
 #pragma pop
 #endif
 
+/*!
+    \class QIODevice::Buffer
+    \inmodule QtCore
+    \since 5.3
+    \brief The Buffer class describes a block of memory that a vectored
+    read fills.
+
+    \sa QIODevice::read()
+*/
+
+/*!
+    \variable QIODevice::Buffer::data
+
+    The start of the block.
+*/
+
+/*!
+    \variable QIODevice::Buffer::size
+
+    The size of the block, in bytes.
+*/
+
+/*!
+    \fn qint64 QIODevice::read(const QVarLengthArray<Buffer, Prealloc> &buffers)
+    \overload
+    \since 5.3
+
+    Reads data from the device into \a buffers, filling each buffer
+    before moving on to the next one, and returns the number of bytes
+    read. As with readv(), the read stops at the first buffer that could
+    not be filled. If an error occurs before anything was read, this
+    function returns -1.
+
+    Data already in QIODevice's buffer is copied out first. After that, if
+    the device is unbuffered or the buffers add up to more than QIODevice
+    would buffer itself, the data is read straight into \a buffers. QFile,
+    QUdpSocket and a QTcpSocket opened with QIODevice::Unbuffered then read
+    all the buffers with one system call where the platform supports it.
+
+    \sa write()
+*/
+qint64 QIODevice::readBuffers(const Buffer *buffers, int count)
+{
+    Q_D(QIODevice);
+
+    qint64 remaining = 0;
+    for (int i = 0; i < count; ++i) {
+        if (buffers[i].size < 0) {
+            qWarning("QIODevice::read: Called with maxSize < 0");
+            return qint64(-1);
+        }
+        remaining += buffers[i].size;
+    }
+
+    // Go through read() while the internal buffer has data, in text mode,
+    // and for small reads, which are better served by filling the buffer.
+    qint64 readSoFar = 0;
+    int i = 0;
+    while (i < count && (!d->buffer.isEmpty() || (d->openMode & Text)
+                         || (!(d->openMode & Unbuffered) && remaining < QIODEVICE_BUFFERSIZE))) {
+        const qint64 readBytes = read(buffers[i].data, buffers[i].size);
+        if (readBytes < 0)
+            return readSoFar ? readSoFar : readBytes;
+        readSoFar += readBytes;
+        remaining -= readBytes;
+        if (readBytes < buffers[i].size)
+            return readSoFar;
+        ++i;
+    }
+    if (i == count)
+        return readSoFar;
+
+    if (d->firstRead) {
+        CHECK_READABLE(read, qint64(-1));
+        d->firstRead = false;
+        if (d->isSequential()) {
+            d->pPos = &d->seqDumpPos;
+            d->pDevicePos = &d->seqDumpPos;
+        }
+    }
+
+    // Make sure the device is positioned correctly.
+    if (d->pos != d->devicePos && !d->isSequential() && !seek(d->pos))
+        return readSoFar ? readSoFar : qint64(-1);
+    const qint64 readFromDevice = d->readDataVector(buffers + i, count - i);
+    if (readFromDevice < 0)
+        return readSoFar ? readSoFar : readFromDevice;
+    *d->pPos += readFromDevice;
+    *d->pDevicePos += readFromDevice;
+    return readSoFar + readFromDevice;
+}
+
+/*!
+    \internal
+
+    Reads from the device into \a count \a buffers, bypassing the
+    QIODevice buffer, and returns the number of bytes read or -1 on error.
+    Subclasses reimplement this to read with a single system call; this
+    implementation calls readData() for each buffer.
+*/
+qint64 QIODevicePrivate::readDataVector(const QIODevice::Buffer *buffers, int count)
+{
+    Q_Q(QIODevice);
+    qint64 readSoFar = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 readBytes = q->readData(buffers[i].data, buffers[i].size);
+        if (readBytes < 0) {
+            if (!readSoFar)
+                return readBytes;
+            break;
+        }
+        // readData() may look at pos(), so keep it current between calls
+        *pPos += readBytes;
+        *pDevicePos += readBytes;
+        readSoFar += readBytes;
+        if (readBytes < buffers[i].size)
+            break;
+    }
+    // the caller moves the position for the whole read
+    *pPos -= readSoFar;
+    *pDevicePos -= readSoFar;
+    return readSoFar;
+}
+
 /*!
     \overload
 
@@ -1429,6 +1553,98 @@ void QIODevice::ungetChar(char c)
         --d->pos;
 }
 
+/*!
+    \fn qint64 QIODevice::write(const QVarLengthArray<QByteArrayView, Prealloc> &buffers)
+    \overload
+    \since 5.3
+
+    Writes the contents of \a buffers to the device, in order, and returns
+    the number of bytes that were actually written, or -1 if an error
+    occurred. As with writev(), fewer bytes than requested may be written.
+
+    This saves joining the buffers into one block first. QFile, QUdpSocket
+    and a QTcpSocket opened with QIODevice::Unbuffered write all the buffers
+    with one system call where the platform supports it, unless the data
+    fits in their write buffer anyway. On a connected QUdpSocket, the
+    buffers are sent as one datagram.
+
+    \sa read()
+*/
+qint64 QIODevice::writeBuffers(const QByteArrayView *buffers, int count)
+{
+    Q_D(QIODevice);
+    CHECK_WRITABLE(write, qint64(-1));
+
+    const bool sequential = d->isSequential();
+#ifdef Q_OS_WIN
+    if (d->openMode & Text) {
+        // write() translates the line endings
+        qint64 writtenSoFar = 0;
+        for (int i = 0; i < count; ++i) {
+            const qint64 written = write(buffers[i].data(), buffers[i].size());
+            if (written < 0)
+                return writtenSoFar ? writtenSoFar : written;
+            writtenSoFar += written;
+            if (written < buffers[i].size())
+                break;
+        }
+        return writtenSoFar;
+    }
+#endif
+
+    // Make sure the device is positioned correctly.
+    if (d->pos != d->devicePos && !sequential && !seek(d->pos))
+        return qint64(-1);
+
+    qint64 written = d->writeDataVector(buffers, count);
+    if (written > 0) {
+        if (!sequential) {
+            d->pos += written;
+            d->devicePos += written;
+        }
+        if (!d->buffer.isEmpty() && !sequential)
+            d->buffer.skip(written);
+    }
+    return written;
+}
+
+/*!
+    \internal
+
+    Writes \a count \a buffers to the device and returns the number of
+    bytes written or -1 on error. Subclasses reimplement this to write with
+    a single system call; this implementation calls writeData() for each
+    buffer.
+*/
+qint64 QIODevicePrivate::writeDataVector(const QByteArrayView *buffers, int count)
+{
+    Q_Q(QIODevice);
+    const bool sequential = isSequential();
+    qint64 writtenSoFar = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 written = q->writeData(buffers[i].data(), buffers[i].size());
+        if (written < 0) {
+            if (!writtenSoFar)
+                return written;
+            break;
+        }
+        // writeData() may look at pos(), so keep it current between calls
+        if (!sequential) {
+            pos += written;
+            devicePos += written;
+        }
+        writtenSoFar += written;
+        if (written < buffers[i].size())
+            break;
+    }
+    // the caller moves the position for the whole write
+    if (!sequential) {
+        pos -= writtenSoFar;
+        devicePos -= writtenSoFar;
+    }
+    return writtenSoFar;
+}
+
 /*! \fn bool QIODevice::putChar(char c)
 
     Writes the character \a c to the device. Returns \c true on success;
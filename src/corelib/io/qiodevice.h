@@ -50,6 +50,7 @@
 #include <QtCore/qscopedpointer.h>
 #endif
 #include <QtCore/qstring.h>
+#include <QtCore/qvarlengtharray.h>
 
 #ifdef open
 #error qiodevice.h must be included before any header file that defines open
@@ -82,6 +83,12 @@ public:
     };
     Q_DECLARE_FLAGS(OpenMode, OpenModeFlag)
 
+    struct Buffer
+    {
+        char *data;
+        qint64 size;
+    };
+
     QIODevice();
 #ifndef QT_NO_QOBJECT
     explicit QIODevice(QObject *parent);
@@ -118,11 +125,17 @@ public:
     qint64 readLine(char *data, qint64 maxlen);
     QByteArray readLine(qint64 maxlen = 0);
     virtual bool canReadLine() const;
+    template <int Prealloc>
+    inline qint64 read(const QVarLengthArray<Buffer, Prealloc> &buffers)
+    { return readBuffers(buffers.constData(), buffers.size()); }
 
     qint64 write(const char *data, qint64 len);
     qint64 write(const char *data);
     inline qint64 write(const QByteArray &data)
     { return write(data.constData(), data.size()); }
+    template <int Prealloc>
+    inline qint64 write(const QVarLengthArray<QByteArrayView, Prealloc> &buffers)
+    { return writeBuffers(buffers.constData(), buffers.size()); }
 
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
@@ -163,10 +176,15 @@ protected:
 #endif
 
 private:
+    qint64 readBuffers(const Buffer *buffers, int count);
+    qint64 writeBuffers(const QByteArrayView *buffers, int count);
+
     Q_DECLARE_PRIVATE(QIODevice)
     Q_DISABLE_COPY(QIODevice)
 };
 
+Q_DECLARE_TYPEINFO(QIODevice::Buffer, Q_PRIMITIVE_TYPE);
+
 Q_DECLARE_OPERATORS_FOR_FLAGS(QIODevice::OpenMode)
 
 #if !defined(QT_NO_DEBUG_STREAM)
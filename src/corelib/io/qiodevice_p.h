@@ -242,6 +242,9 @@ public:
     virtual qint64 peek(char *data, qint64 maxSize);
     virtual QByteArray peek(qint64 maxSize);
 
+    virtual qint64 readDataVector(const QIODevice::Buffer *buffers, int count);
+    virtual qint64 writeDataVector(const QByteArrayView *buffers, int count);
+
 #ifdef QT_NO_QOBJECT
     QIODevice *q_ptr;
 #endif
@@ -0,0 +1,592 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+/*!
+    \since 5.3
+    \class QParallelDirIterator
+    \inmodule QtCore
+    \brief The QParallelDirIterator class lists directory trees using several threads.
+
+    QParallelDirIterator takes the same filters and flags as QDirIterator and
+    is used the same way, but when QDirIterator::Subdirectories is set, it
+    lists subdirectories concurrently on a QThreadPool. This pays off when each
+    directory listing has to wait for the file system, as on network file
+    systems, or when the tree is very large:
+
+    \code
+    QParallelDirIterator it("/usr/share", QStringList() << "*.png",
+                            QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        index(it.next());
+    \endcode
+
+    Entries are returned in no particular order. Unlike with QDirIterator, the
+    contents of a directory do not necessarily follow the directory itself, and
+    the order can change from one run to the next.
+
+    Entries are handed over through a queue holding at most maxQueueSize()
+    entries; the pool threads pause when it is full until the caller catches
+    up. When there is nothing to return yet but a directory is still waiting to
+    be listed, hasNext() and next() list it on the calling thread rather than
+    wait for the pool, so iteration keeps going when the pool is busy with
+    other work.
+
+    \sa QDirIterator, QThreadPool
+*/
+
+#include "qparalleldiriterator.h"
+#include "qdiriterator_p.h"
+
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+
+QT_BEGIN_NAMESPACE
+
+enum {
+    // Entries and subdirectories are passed on in batches, so that the threads
+    // do not fight over the lock for every single entry
+    ResultBatchSize = 64,
+    SubdirectoryBatchSize = 4,
+
+    DefaultMaxQueueSize = 4096
+};
+
+class QParallelDirScan
+{
+public:
+    explicit QParallelDirScan(const QFileSystemEntry &entry)
+        : entry(entry)
+    {
+    }
+
+    QFileSystemEntry entry;
+    // Created when the scan first runs, so that waiting scans hold no directory open
+    QScopedPointer<QDirIteratorPrivate> iterator;
+    QFileInfoList subdirectories;
+};
+
+// Shared by the iterator and the pool threads working for it, so that an
+// iterator destroyed before the end does not have to wait for them.
+class QParallelDirWalk : public QSharedData
+{
+public:
+    QParallelDirWalk(const QStringList &nameFilters, QDir::Filters filters,
+                     QDirIterator::IteratorFlags flags);
+    ~QParallelDirWalk();
+
+    void run(QParallelDirScan *scan, bool forConsumer);
+    void startWorkers();
+    void work();
+
+    const QStringList nameFilters;
+    const QDir::Filters filters;
+    const QDirIterator::IteratorFlags iteratorFlags;
+
+    QThreadPool *pool;
+    int maxQueueSize;
+
+    QMutex mutex;
+    QWaitCondition resultsAvailable;
+    QQueue<QFileInfo> results;
+    QList<QParallelDirScan *> pendingScans;
+    int activeScans;
+    int runningWorkers;
+    bool cancelled;
+
+    // Loop protection
+    QSet<QString> visitedLinks;
+};
+
+#ifndef QT_NO_THREAD
+class QParallelDirWorker : public QRunnable
+{
+public:
+    explicit QParallelDirWorker(QParallelDirWalk *walk)
+        : walk(walk)
+    {
+    }
+
+    void run()
+    {
+        walk->work();
+    }
+
+private:
+    QExplicitlySharedDataPointer<QParallelDirWalk> walk;
+};
+#endif
+
+class QParallelDirIteratorPrivate
+{
+public:
+    QParallelDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
+                                QDir::Filters filters, QDirIterator::IteratorFlags flags);
+    ~QParallelDirIteratorPrivate();
+
+    void start();
+    bool waitForResult(QMutexLocker &locker);
+    bool advance();
+
+    QFileSystemEntry dirEntry;
+    QExplicitlySharedDataPointer<QParallelDirWalk> walk;
+    bool started;
+
+    QFileInfo currentFileInfo;
+};
+
+/*!
+    \internal
+*/
+QParallelDirWalk::QParallelDirWalk(const QStringList &nameFilters, QDir::Filters filters,
+                                   QDirIterator::IteratorFlags flags)
+    : nameFilters(nameFilters)
+    , filters(filters)
+    , iteratorFlags(flags)
+#ifndef QT_NO_THREAD
+    , pool(QThreadPool::globalInstance())
+#else
+    , pool(0)
+#endif
+    , maxQueueSize(DefaultMaxQueueSize)
+    , activeScans(0)
+    , runningWorkers(0)
+    , cancelled(false)
+{
+}
+
+/*!
+    \internal
+*/
+QParallelDirWalk::~QParallelDirWalk()
+{
+    qDeleteAll(pendingScans);
+}
+
+/*!
+    \internal
+
+    Lists the directory of \a scan until it is done or, on a pool thread, until
+    the result queue is full. The consumer (\a forConsumer) stops as soon as
+    there is something to return. A scan that stops early is queued again,
+    first in line, to be resumed by whoever gets to it next.
+*/
+void QParallelDirWalk::run(QParallelDirScan *scan, bool forConsumer)
+{
+    if (!scan->iterator) {
+        scan->iterator.reset(new QDirIteratorPrivate(scan->entry, nameFilters, filters, iteratorFlags,
+                                                     true, &scan->subdirectories));
+    }
+    QDirIteratorPrivate *it = scan->iterator.data();
+
+    QFileInfoList batch;
+    QStringList canonicalPaths;
+    forever {
+        const bool atEnd = !it->hasNext();
+        if (!atEnd) {
+            it->advance();
+            batch.append(it->currentFileInfo);
+            if (batch.size() < ResultBatchSize && scan->subdirectories.size() < SubdirectoryBatchSize)
+                continue;
+        }
+
+        // Done outside the lock, as it may need a few system calls per directory
+        if (iteratorFlags & QDirIterator::FollowSymlinks) {
+            for (int i = 0; i < scan->subdirectories.size(); ++i)
+                canonicalPaths.append(scan->subdirectories.at(i).canonicalFilePath());
+        }
+
+        QMutexLocker locker(&mutex);
+        if (cancelled) {
+            --activeScans;
+            locker.unlock();
+            delete scan;
+            return;
+        }
+
+        results.append(batch);
+        for (int i = 0; i < scan->subdirectories.size(); ++i) {
+            if (!canonicalPaths.isEmpty()) {
+                const QString &canonicalPath = canonicalPaths.at(i);
+                if (visitedLinks.contains(canonicalPath))
+                    continue;
+                visitedLinks.insert(canonicalPath);
+            }
+            pendingScans.append(new QParallelDirScan(QFileSystemEntry(scan->subdirectories.at(i).filePath())));
+        }
+        batch.clear();
+        canonicalPaths.clear();
+        scan->subdirectories.clear();
+
+        const bool stop = atEnd || (forConsumer ? !results.isEmpty() : results.size() >= maxQueueSize);
+        if (stop) {
+            --activeScans;
+            if (!atEnd)
+                pendingScans.prepend(scan);
+        }
+        resultsAvailable.wakeAll();
+        startWorkers();
+
+        if (stop) {
+            locker.unlock();
+            if (atEnd)
+                delete scan;
+            return;
+        }
+    }
+}
+
+/*!
+    \internal
+
+    Queues as many workers as the pool allows and there are directories to
+    list. Must be called with the mutex held.
+*/
+void QParallelDirWalk::startWorkers()
+{
+#ifndef QT_NO_THREAD
+    if (!pool || cancelled || results.size() >= maxQueueSize)
+        return;
+
+    const int maxWorkers = qMin(qMax(1, pool->maxThreadCount()), activeScans + pendingScans.size());
+    while (runningWorkers < maxWorkers) {
+        ++runningWorkers;
+        pool->start(new QParallelDirWorker(this));
+    }
+#endif
+}
+
+/*!
+    \internal
+*/
+void QParallelDirWalk::work()
+{
+    QMutexLocker locker(&mutex);
+    while (!cancelled && !pendingScans.isEmpty() && results.size() < maxQueueSize) {
+        QParallelDirScan *scan = pendingScans.takeFirst();
+        ++activeScans;
+        locker.unlock();
+        run(scan, false);
+        locker.relock();
+    }
+    --runningWorkers;
+}
+
+/*!
+    \internal
+*/
+QParallelDirIteratorPrivate::QParallelDirIteratorPrivate(const QFileSystemEntry &entry,
+                                                         const QStringList &nameFilters,
+                                                         QDir::Filters filters,
+                                                         QDirIterator::IteratorFlags flags)
+    : dirEntry(entry)
+    , walk(new QParallelDirWalk(nameFilters, filters, flags))
+    , started(false)
+{
+}
+
+/*!
+    \internal
+*/
+QParallelDirIteratorPrivate::~QParallelDirIteratorPrivate()
+{
+    // Workers still running finish their current batch and let go of the walk
+    QMutexLocker locker(&walk->mutex);
+    walk->cancelled = true;
+}
+
+/*!
+    \internal
+*/
+void QParallelDirIteratorPrivate::start()
+{
+    started = true;
+
+    const QDirIterator::IteratorFlags followSubdirectories = QDirIterator::Subdirectories
+                                                           | QDirIterator::FollowSymlinks;
+    if ((walk->iteratorFlags & followSubdirectories) == followSubdirectories)
+        walk->visitedLinks.insert(QFileInfo(dirEntry.filePath()).canonicalFilePath());
+
+    QMutexLocker locker(&walk->mutex);
+    walk->pendingScans.append(new QParallelDirScan(dirEntry));
+    walk->startWorkers();
+}
+
+/*!
+    \internal
+
+    Returns \c true once there is a result to take, or \c false if the walk is
+    over. \a locker must hold the walk's mutex.
+*/
+bool QParallelDirIteratorPrivate::waitForResult(QMutexLocker &locker)
+{
+    if (!started) {
+        locker.unlock();
+        start();
+        locker.relock();
+    }
+
+    forever {
+        if (!walk->results.isEmpty())
+            return true;
+
+        if (!walk->pendingScans.isEmpty()) {
+            // Rather than wait for the pool, which may be busy, list it here
+            QParallelDirScan *scan = walk->pendingScans.takeFirst();
+            ++walk->activeScans;
+            locker.unlock();
+            walk->run(scan, true);
+            locker.relock();
+        } else if (walk->activeScans) {
+            walk->resultsAvailable.wait(&walk->mutex);
+        } else {
+            return false;
+        }
+    }
+}
+
+/*!
+    \internal
+*/
+bool QParallelDirIteratorPrivate::advance()
+{
+    QMutexLocker locker(&walk->mutex);
+    if (!waitForResult(locker)) {
+        currentFileInfo = QFileInfo();
+        return false;
+    }
+
+    currentFileInfo = walk->results.dequeue();
+    if (walk->results.size() <= walk->maxQueueSize / 2)
+        walk->startWorkers();
+    return true;
+}
+
+/*!
+    Constructs a QParallelDirIterator that can iterate over \a dir's
+    entrylist, using \a dir's name filters and regular filters. You can pass
+    options via \a flags to decide how the directory should be iterated.
+
+    The sorting in \a dir is ignored.
+
+    \sa QDirIterator::QDirIterator()
+*/
+QParallelDirIterator::QParallelDirIterator(const QDir &dir, QDirIterator::IteratorFlags flags)
+    : d(new QParallelDirIteratorPrivate(QFileSystemEntry(dir.path()), dir.nameFilters(), dir.filter(), flags))
+{
+}
+
+/*!
+    Constructs a QParallelDirIterator that can iterate over \a path, with no
+    name filtering and \a filters for entry filtering. You can pass options
+    via \a flags to decide how the directory should be iterated.
+
+    \sa QDirIterator::QDirIterator()
+*/
+QParallelDirIterator::QParallelDirIterator(const QString &path, QDir::Filters filters,
+                                           QDirIterator::IteratorFlags flags)
+    : d(new QParallelDirIteratorPrivate(QFileSystemEntry(path), QStringList(), filters, flags))
+{
+}
+
+/*!
+    Constructs a QParallelDirIterator that can iterate over \a path. You can
+    pass options via \a flags to decide how the directory should be iterated.
+
+    \sa QDirIterator::QDirIterator()
+*/
+QParallelDirIterator::QParallelDirIterator(const QString &path, QDirIterator::IteratorFlags flags)
+    : d(new QParallelDirIteratorPrivate(QFileSystemEntry(path), QStringList(), QDir::NoFilter, flags))
+{
+}
+
+/*!
+    Constructs a QParallelDirIterator that can iterate over \a path, using \a
+    nameFilters and \a filters. You can pass options via \a flags to decide
+    how the directory should be iterated.
+
+    \sa QDirIterator::QDirIterator()
+*/
+QParallelDirIterator::QParallelDirIterator(const QString &path, const QStringList &nameFilters,
+                                           QDir::Filters filters, QDirIterator::IteratorFlags flags)
+    : d(new QParallelDirIteratorPrivate(QFileSystemEntry(path), nameFilters, filters, flags))
+{
+}
+
+/*!
+    Destroys the QParallelDirIterator. Directories that are still being listed
+    are abandoned; this does not wait for the pool threads.
+*/
+QParallelDirIterator::~QParallelDirIterator()
+{
+}
+
+/*!
+    Sets the thread pool that subdirectories are listed on to \a pool. By
+    default, QThreadPool::globalInstance() is used. If \a pool is 0, the whole
+    tree is listed on the thread calling hasNext() and next().
+
+    This must be called before the iteration starts.
+
+    \sa threadPool()
+*/
+void QParallelDirIterator::setThreadPool(QThreadPool *pool)
+{
+    if (d->started) {
+        qWarning("QParallelDirIterator::setThreadPool: Iteration has already started");
+        return;
+    }
+    d->walk->pool = pool;
+}
+
+/*!
+    Returns the thread pool that subdirectories are listed on.
+
+    \sa setThreadPool()
+*/
+QThreadPool *QParallelDirIterator::threadPool() const
+{
+    return d->walk->pool;
+}
+
+/*!
+    Sets the number of entries that may be waiting to be returned before the
+    pool threads pause to \a size. The default is 4096.
+
+    This must be called before the iteration starts.
+
+    \sa maxQueueSize()
+*/
+void QParallelDirIterator::setMaxQueueSize(int size)
+{
+    if (d->started) {
+        qWarning("QParallelDirIterator::setMaxQueueSize: Iteration has already started");
+        return;
+    }
+    d->walk->maxQueueSize = qMax(1, size);
+}
+
+/*!
+    Returns the number of entries that may be waiting to be returned before
+    the pool threads pause.
+
+    \sa setMaxQueueSize()
+*/
+int QParallelDirIterator::maxQueueSize() const
+{
+    return d->walk->maxQueueSize;
+}
+
+/*!
+    Advances the iterator to the next entry, and returns the file path of this
+    new entry. If hasNext() returns \c false, this function does nothing, and
+    returns a null QString.
+
+    This may block until one of the pool threads has found the next entry.
+
+    \sa hasNext(), fileName(), filePath(), fileInfo()
+*/
+QString QParallelDirIterator::next()
+{
+    if (!d->advance())
+        return QString();
+    return filePath();
+}
+
+/*!
+    Returns \c true if there is at least one more entry in the directory tree;
+    otherwise, false is returned.
+
+    This may block until the pool threads have either found another entry or
+    finished listing the tree.
+
+    \sa next()
+*/
+bool QParallelDirIterator::hasNext() const
+{
+    QMutexLocker locker(&d->walk->mutex);
+    return d->waitForResult(locker);
+}
+
+/*!
+    Returns the file name for the current directory entry, without the path
+    prepended.
+
+    \sa filePath(), fileInfo()
+*/
+QString QParallelDirIterator::fileName() const
+{
+    return d->currentFileInfo.fileName();
+}
+
+/*!
+    Returns the full file path for the current directory entry.
+
+    \sa fileInfo(), fileName()
+*/
+QString QParallelDirIterator::filePath() const
+{
+    return d->currentFileInfo.filePath();
+}
+
+/*!
+    Returns a QFileInfo for the current directory entry.
+
+    \sa filePath(), fileName()
+*/
+QFileInfo QParallelDirIterator::fileInfo() const
+{
+    return d->currentFileInfo;
+}
+
+/*!
+    Returns the base directory of the iterator.
+*/
+QString QParallelDirIterator::path() const
+{
+    return d->dirEntry.filePath();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QPARALLELDIRITERATOR_H
+#define QPARALLELDIRITERATOR_H
+
+#include <QtCore/qdiriterator.h>
+
+QT_BEGIN_NAMESPACE
+
+
+class QThreadPool;
+class QParallelDirIteratorPrivate;
+class Q_CORE_EXPORT QParallelDirIterator {
+public:
+    QParallelDirIterator(const QDir &dir,
+                         QDirIterator::IteratorFlags flags = QDirIterator::NoIteratorFlags);
+    QParallelDirIterator(const QString &path,
+                         QDirIterator::IteratorFlags flags = QDirIterator::NoIteratorFlags);
+    QParallelDirIterator(const QString &path,
+                         QDir::Filters filter,
+                         QDirIterator::IteratorFlags flags = QDirIterator::NoIteratorFlags);
+    QParallelDirIterator(const QString &path,
+                         const QStringList &nameFilters,
+                         QDir::Filters filters = QDir::NoFilter,
+                         QDirIterator::IteratorFlags flags = QDirIterator::NoIteratorFlags);
+
+    ~QParallelDirIterator();
+
+    void setThreadPool(QThreadPool *pool);
+    QThreadPool *threadPool() const;
+
+    void setMaxQueueSize(int size);
+    int maxQueueSize() const;
+
+    QString next();
+    bool hasNext() const;
+
+    QString fileName() const;
+    QString filePath() const;
+    QFileInfo fileInfo() const;
+    QString path() const;
+
+private:
+    Q_DISABLE_COPY(QParallelDirIterator)
+
+    QScopedPointer<QParallelDirIteratorPrivate> d;
+};
+
+QT_END_NAMESPACE
+
+#endif
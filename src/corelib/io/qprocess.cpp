@@ -1534,6 +1534,9 @@ QString QProcess::workingDirectory() const
     process in this directory. The default behavior is to start the
     process in the working directory of the calling process.
 
+    On Unix, except on QNX, the process fails to start if the directory
+    cannot be entered.
+
     \note On QNX, this may cause all application threads to
     temporarily freeze.
 
@@ -104,8 +104,10 @@ QT_END_NAMESPACE
 #include <qelapsedtimer.h>
 
 #include <errno.h>
+#include <signal.h>
 #include <stdlib.h>
 #include <string.h>
+#include <typeinfo>
 #ifdef Q_OS_QNX
 #include "qvarlengtharray.h"
 
@@ -113,11 +115,91 @@ QT_END_NAMESPACE
 #include <sys/neutrino.h>
 #endif
 
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+#if !defined(SYS_pidfd_open) && !defined(__alpha__)
+#define SYS_pidfd_open 434
+#endif
+// vfork() suspends only the calling thread and shares the address space
+// with the child, so starting a child does not copy the page tables.
+#define QPROCESS_USE_VFORK
+#ifdef SYS_pidfd_open
+// each child is watched through its own pidfd, so there is no need for
+// the SIGCHLD handler and the process manager thread.
+#define QPROCESS_USE_PIDFD
+#endif
+#endif
+
 QT_BEGIN_NAMESPACE
 
-// POSIX requires PIPE_BUF to be 512 or larger
-// so we will use 512
-static const int errorBufferMax = 512;
+// What the child writes to childStartedPipe if it cannot start the
+// program. This is less than PIPE_BUF, so the write is atomic.
+struct QProcessChildError
+{
+    int code;
+    char function[8];
+};
+
+#ifdef QPROCESS_USE_PIDFD
+static QBasicAtomicInt qt_pidfd_support = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+static inline int qt_pidfd_open(pid_t pid)
+{
+    return int(::syscall(SYS_pidfd_open, pid, 0));
+}
+
+static bool qt_use_pidfd()
+{
+    int support = qt_pidfd_support.load();
+    if (support == 0) {
+        // pidfd_open() appeared in Linux 5.3; it may also be filtered out
+        int fd = qt_pidfd_open(::getpid());
+        if (fd != -1)
+            qt_safe_close(fd);
+        support = fd != -1 ? 1 : -1;
+        qt_pidfd_support.store(support);
+    }
+    return support > 0;
+}
+#else
+static inline bool qt_use_pidfd()
+{
+    return false;
+}
+#endif
+
+#ifdef QPROCESS_USE_VFORK
+static bool qt_use_vfork(const QProcess *process)
+{
+    // a reimplemented setupChildProcess() may do anything, including
+    // things that are not safe while sharing the memory of the parent.
+#if defined(QT_NO_RTTI) || (defined(Q_CC_GNU) && !defined(__GXX_RTTI))
+    Q_UNUSED(process);
+    return false;
+#else
+    return typeid(*process) == typeid(QProcess);
+#endif
+}
+
+/*
+    Called in the vfork()ed child. Handlers installed by the parent must not
+    run in the child while it shares the parent's memory, so all signals are
+    blocked around vfork(); reset the handlers before unblocking them.
+*/
+static void qt_reset_signals_in_child(const sigset_t *oldMask)
+{
+    for (int signum = 1; signum < NSIG; ++signum) {
+        struct sigaction action;
+        if (::sigaction(signum, 0, &action) == 0
+                && action.sa_handler != SIG_DFL && action.sa_handler != SIG_IGN) {
+            action.sa_handler = SIG_DFL;
+            action.sa_flags = 0;
+            ::sigaction(signum, &action, 0);
+        }
+    }
+    ::sigprocmask(SIG_SETMASK, oldMask, 0);
+}
+#endif
 
 static int qt_qprocess_deadChild_pipe[2];
 static struct sigaction qt_sa_old_sigchld_handler;
@@ -570,14 +652,18 @@ void QProcessPrivate::startProcess()
     qDebug("QProcessPrivate::startProcess()");
 #endif
 
-    processManager()->start();
+    // With a pidfd, the death notifications come from the child's pidfd,
+    // which replaces the death pipe.
+    const bool usePidfd = qt_use_pidfd();
+    if (!usePidfd)
+        processManager()->start();
 
     // Initialize pipes
     if (!createChannel(stdinChannel) ||
         !createChannel(stdoutChannel) ||
         !createChannel(stderrChannel) ||
         qt_create_pipe(childStartedPipe) != 0 ||
-        qt_create_pipe(deathPipe) != 0) {
+        (!usePidfd && qt_create_pipe(deathPipe) != 0)) {
         processError = QProcess::FailedToStart;
         q->setErrorString(qt_error_string(errno));
         emit q->error(processError);
@@ -590,11 +676,6 @@ void QProcessPrivate::startProcess()
                                                     QSocketNotifier::Read, q);
         QObject::connect(startupSocketNotifier, SIGNAL(activated(int)),
                          q, SLOT(_q_startupNotification()));
-
-        deathNotifier = new QSocketNotifier(deathPipe[0],
-                                            QSocketNotifier::Read, q);
-        QObject::connect(deathNotifier, SIGNAL(activated(int)),
-                         q, SLOT(_q_processDied()));
     }
 
     // Start the process (platform dependent)
@@ -677,9 +758,22 @@ void QProcessPrivate::startProcess()
     }
 
     // Start the process manager, and fork off the child process.
-    processManager()->lock();
+    if (!usePidfd)
+        processManager()->lock();
 #if defined(Q_OS_QNX)
     pid_t childPid = spawnChild(workingDirPtr, argv, envp);
+#elif defined(QPROCESS_USE_VFORK)
+    const bool useVfork = qt_use_vfork(q);
+    sigset_t oldMask;
+    if (useVfork) {
+        sigset_t allSignals;
+        sigfillset(&allSignals);
+        pthread_sigmask(SIG_SETMASK, &allSignals, &oldMask);
+    }
+    pid_t childPid = useVfork ? vfork() : fork();
+    int lastForkErrno = errno;
+    if (useVfork && childPid != 0)
+        pthread_sigmask(SIG_SETMASK, &oldMask, 0);
 #else
     pid_t childPid = fork();
     int lastForkErrno = errno;
@@ -714,7 +808,8 @@ void QProcessPrivate::startProcess()
 #if defined (QPROCESS_DEBUG)
         qDebug("fork failed: %s", qPrintable(qt_error_string(lastForkErrno)));
 #endif
-        processManager()->unlock();
+        if (!usePidfd)
+            processManager()->unlock();
         q->setProcessState(QProcess::NotRunning);
         processError = QProcess::FailedToStart;
         q->setErrorString(QProcess::tr("Resource error (fork failure): %1").arg(qt_error_string(lastForkErrno)));
@@ -725,20 +820,52 @@ void QProcessPrivate::startProcess()
 
     // Start the child.
     if (childPid == 0) {
+#ifdef QPROCESS_USE_VFORK
+        if (useVfork)
+            qt_reset_signals_in_child(&oldMask);
+#endif
         execChild(workingDirPtr, path, argv, envp);
         ::_exit(-1);
     }
 #endif
 
-    // Register the child. In the mean time, we can get a SIGCHLD, so we need
-    // to keep the lock held to avoid a race to catch the child.
-    processManager()->add(childPid, q);
-    pid = Q_PID(childPid);
-    processManager()->unlock();
+#ifdef QPROCESS_USE_PIDFD
+    if (usePidfd) {
+        // Nobody else reaps our child, so its pid cannot be reused before
+        // we have the pidfd.
+        deathPipe[0] = qt_pidfd_open(childPid);
+        if (deathPipe[0] == -1) {
+            int lastPidfdErrno = errno;
+            ::kill(childPid, SIGKILL);
+            qt_safe_waitpid(childPid, 0, 0);
+            q->setProcessState(QProcess::NotRunning);
+            processError = QProcess::FailedToStart;
+            q->setErrorString(QProcess::tr("Resource error (pidfd_open failure): %1").arg(qt_error_string(lastPidfdErrno)));
+            emit q->error(processError);
+            cleanup();
+            return;
+        }
+        pid = Q_PID(childPid);
+    } else
+#endif
+    {
+        // Register the child. In the mean time, we can get a SIGCHLD, so we need
+        // to keep the lock held to avoid a race to catch the child.
+        processManager()->add(childPid, q);
+        pid = Q_PID(childPid);
+        processManager()->unlock();
+        ::fcntl(deathPipe[0], F_SETFL, ::fcntl(deathPipe[0], F_GETFL) | O_NONBLOCK);
+    }
+
+    if (threadData->hasEventDispatcher()) {
+        deathNotifier = new QSocketNotifier(deathPipe[0],
+                                            QSocketNotifier::Read, q);
+        QObject::connect(deathNotifier, SIGNAL(activated(int)),
+                         q, SLOT(_q_processDied()));
+    }
 
     // parent
     // close the ends we don't use and make all pipes non-blocking
-    ::fcntl(deathPipe[0], F_SETFL, ::fcntl(deathPipe[0], F_GETFL) | O_NONBLOCK);
     qt_safe_close(childStartedPipe[1]);
     childStartedPipe[1] = -1;
 
@@ -861,8 +988,8 @@ pid_t QProcessPrivate::spawnChild(const char *workingDir, char **argv, char **en
     pid_t childPid = doSpawn(fd_count, fd_map.data(), argv, envp, workingDir, false);
 
     if (childPid == -1) {
-        QString error = qt_error_string(errno);
-        qt_safe_write(childStartedPipe[1], error.data(), error.length() * sizeof(QChar));
+        QProcessChildError error = { errno, "" };
+        qt_safe_write(childStartedPipe[1], &error, sizeof(error));
         qt_safe_close(childStartedPipe[1]);
         childStartedPipe[1] = -1;
     }
@@ -872,6 +999,11 @@ pid_t QProcessPrivate::spawnChild(const char *workingDir, char **argv, char **en
 
 #else
 
+/*
+    Runs in the child, which may share its memory with the parent (see
+    QPROCESS_USE_VFORK): it must neither allocate memory nor modify this
+    object.
+*/
 void QProcessPrivate::execChild(const char *workingDir, char **path, char **argv, char **envp)
 {
     ::signal(SIGPIPE, SIG_DFL);         // reset the signal that we ignored
@@ -899,9 +1031,10 @@ void QProcessPrivate::execChild(const char *workingDir, char **path, char **argv
     qt_safe_close(childStartedPipe[0]);
 
     // enter the working directory
-    if (workingDir) {
-        if (QT_CHDIR(workingDir) == -1)
-            qWarning("QProcessPrivate::execChild() failed to chdir to %s", workingDir);
+    if (workingDir && QT_CHDIR(workingDir) == -1) {
+        QProcessChildError error = { errno, "chdir" };
+        qt_safe_write(childStartedPipe[1], &error, sizeof(error));
+        return;
     }
 
     // this is a virtual call, and it base behavior is to do nothing.
@@ -930,19 +1063,17 @@ void QProcessPrivate::execChild(const char *workingDir, char **path, char **argv
     }
 
     // notify failure
-    QString error = qt_error_string(errno);
+    QProcessChildError error = { errno, "" };
 #if defined (QPROCESS_DEBUG)
-    fprintf(stderr, "QProcessPrivate::execChild() failed (%s), notifying parent process\n", qPrintable(error));
+    fprintf(stderr, "QProcessPrivate::execChild() failed (%s), notifying parent process\n", strerror(error.code));
 #endif
-    qt_safe_write(childStartedPipe[1], error.data(), error.length() * sizeof(QChar));
-    qt_safe_close(childStartedPipe[1]);
-    childStartedPipe[1] = -1;
+    qt_safe_write(childStartedPipe[1], &error, sizeof(error));
 }
 #endif
 
 bool QProcessPrivate::processStarted()
 {
-    ushort buf[errorBufferMax];
+    QProcessChildError buf;
     int i = qt_safe_read(childStartedPipe[0], &buf, sizeof buf);
     if (startupSocketNotifier) {
         startupSocketNotifier->setEnabled(false);
@@ -957,8 +1088,12 @@ bool QProcessPrivate::processStarted()
 #endif
 
     // did we read an error message?
-    if (i > 0)
-        q_func()->setErrorString(QString((const QChar *)buf, i / sizeof(QChar)));
+    if (i > 0) {
+        QString errorString = qt_error_string(i == sizeof buf ? buf.code : -1);
+        if (i == sizeof buf && buf.function[0])
+            errorString = QLatin1String(buf.function) + QLatin1String(": ") + errorString;
+        q_func()->setErrorString(errorString);
+    }
 
     return i <= 0;
 }
@@ -1146,8 +1281,9 @@ bool QProcessPrivate::waitForReadyRead(int msecs)
         FD_ZERO(&fdread);
         FD_ZERO(&fdwrite);
 
-        int nfds = deathPipe[0];
-        FD_SET(deathPipe[0], &fdread);
+        int nfds = -1;
+        if (deathPipe[0] != -1)
+            add_fd(nfds, deathPipe[0], &fdread);
 
         if (processState == QProcess::Starting)
             add_fd(nfds, childStartedPipe[0], &fdread);
@@ -1222,8 +1358,9 @@ bool QProcessPrivate::waitForBytesWritten(int msecs)
         FD_ZERO(&fdread);
         FD_ZERO(&fdwrite);
 
-        int nfds = deathPipe[0];
-        FD_SET(deathPipe[0], &fdread);
+        int nfds = -1;
+        if (deathPipe[0] != -1)
+            add_fd(nfds, deathPipe[0], &fdread);
 
         if (processState == QProcess::Starting)
             add_fd(nfds, childStartedPipe[0], &fdread);
@@ -1302,7 +1439,7 @@ bool QProcessPrivate::waitForFinished(int msecs)
         if (stderrChannel.pipe[0] != -1)
             add_fd(nfds, stderrChannel.pipe[0], &fdread);
 
-        if (processState == QProcess::Running)
+        if (processState == QProcess::Running && deathPipe[0] != -1)
             add_fd(nfds, deathPipe[0], &fdread);
 
         if (!writeBuffer.isEmpty() && stdinChannel.pipe[1] != -1)
@@ -1355,21 +1492,34 @@ bool QProcessPrivate::waitForWrite(int msecs)
 void QProcessPrivate::findExitCode()
 {
     Q_Q(QProcess);
-    processManager()->remove(q);
+    // only children watched by the process manager have a serial number
+    if (serial)
+        processManager()->remove(q);
 }
 
 bool QProcessPrivate::waitForDeadChild()
 {
     Q_Q(QProcess);
 
-    // read a byte from the death pipe
-    char c;
-    qt_safe_read(deathPipe[0], &c, 1);
+    // read a byte from the death pipe; a pidfd has nothing to read
+    if (serial) {
+        char c;
+        qt_safe_read(deathPipe[0], &c, 1);
+    }
 
     // check if our process is dead
     int exitStatus;
     if (qt_safe_waitpid(pid_t(pid), &exitStatus, WNOHANG) > 0) {
-        processManager()->remove(q);
+        if (serial) {
+            processManager()->remove(q);
+        } else {
+            // unlike the death pipe, the pidfd stays readable; stop watching
+            // it so that waiting from a slot does not see the death again.
+            if (deathNotifier)
+                deathNotifier->setEnabled(false);
+            qt_safe_close(deathPipe[0]);
+            deathPipe[0] = INVALID_Q_PIPE;
+        }
         crashed = !WIFEXITED(exitStatus);
         exitCode = WEXITSTATUS(exitStatus);
 #if defined QPROCESS_DEBUG
@@ -1544,7 +1694,8 @@ bool QProcessPrivate::startDetached(const QString &program, const QStringList &a
 
 void QProcessPrivate::initializeProcessManager()
 {
-    (void) processManager();
+    if (!qt_use_pidfd())
+        (void) processManager();
 }
 
 QT_END_NAMESPACE
@@ -341,6 +341,21 @@ qint64 QSaveFile::writeData(const char *data, qint64 len)
     return ret;
 }
 
+/*!
+    \internal
+*/
+qint64 QSaveFilePrivate::writeDataVector(const QByteArrayView *buffers, int count)
+{
+    if (writeError != QFileDevice::NoError)
+        return -1;
+
+    const qint64 ret = QFileDevicePrivate::writeDataVector(buffers, count);
+
+    if (error != QFileDevice::NoError)
+        writeError = error;
+    return ret;
+}
+
 /*!
   Allows writing over the existing file if necessary.
 
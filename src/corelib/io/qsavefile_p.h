@@ -69,6 +69,8 @@ protected:
     QSaveFilePrivate();
     ~QSaveFilePrivate();
 
+    qint64 writeDataVector(const QByteArrayView *buffers, int count);
+
     QString fileName;
 
     QFileDevice::FileError writeError;
@@ -45,6 +45,7 @@
 #include <qdebug.h>
 #include "qjsonparser_p.h"
 #include "qjson_p.h"
+#include <private/qlocale_tools_p.h>
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -698,30 +699,27 @@ bool Parser::parseNumber(QJsonPrivate::Value *val, int baseOffset)
         return false;
     }
 
-    QByteArray number(start, json - start);
-    DEBUG << "numberstring" << number;
-
-    if (isInt) {
-        bool ok;
-        int n = number.toInt(&ok);
-        if (ok && n < (1<<25) && n > -(1<<25)) {
-            val->int_value = n;
-            val->latinOrIntValue = true;
-            END;
-            return true;
-        }
-    }
-
-    bool ok;
     union {
         quint64 ui;
         double d;
     };
-    d = number.toDouble(&ok);
+    if (!qstrtodFast(start, int(json - start), &d)) {
+        QByteArray number(start, json - start);
+        DEBUG << "numberstring" << number;
 
-    if (!ok) {
-        lastError = QJsonParseError::IllegalNumber;
-        return false;
+        bool ok;
+        d = number.toDouble(&ok);
+        if (!ok) {
+            lastError = QJsonParseError::IllegalNumber;
+            return false;
+        }
+    }
+
+    if (isInt && d < (1<<25) && d > -(1<<25)) {
+        val->int_value = int(d);
+        val->latinOrIntValue = true;
+        END;
+        return true;
     }
 
     int pos = reserveSpace(sizeof(double));
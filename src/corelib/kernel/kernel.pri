@@ -132,6 +132,13 @@ unix|integrity {
         LIBS_PRIVATE +=$$QT_LIBS_GLIB
     }
 
+    linux {
+        SOURCES += \
+            kernel/qeventdispatcher_epoll.cpp
+        HEADERS += \
+            kernel/qeventdispatcher_epoll_p.h
+    }
+
    contains(QT_CONFIG, clock-gettime):include($$QT_SOURCE_TREE/config.tests/unix/clock-gettime/clock-gettime.pri)
 
     !android {
@@ -81,6 +81,9 @@
 #    if !defined(QT_NO_GLIB)
 #      include "qeventdispatcher_glib_p.h"
 #    endif
+#    if defined(Q_OS_LINUX)
+#      include "qeventdispatcher_epoll_p.h"
+#    endif
 #    include "qeventdispatcher_unix_p.h"
 #  endif
 #endif
@@ -300,7 +303,9 @@ bool QCoreApplicationPrivate::is_app_closing = false;
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
     QThreadData *currentThreadData = QThreadData::current();
-    return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
+    // events still in the inbox are not counted one by one
+    return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset
+            + (currentThreadData->postEventList.hasInboxEvents() ? 1 : 0);
 }
 
 QAbstractEventDispatcher *QCoreApplicationPrivate::eventDispatcher = 0;
@@ -442,6 +447,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         QMutexLocker locker(&threadData->postEventList.mutex);
+        threadData->postEventList.drainInbox();
         for (int i = 0; i < threadData->postEventList.size(); ++i) {
             const QPostEvent &pe = threadData->postEventList.at(i);
             if (pe.event) {
@@ -464,6 +470,11 @@ void QCoreApplicationPrivate::createEventDispatcher()
 #  if defined(Q_OS_BLACKBERRY)
     eventDispatcher = new QEventDispatcherBlackberry(q);
 #  else
+#  if defined(Q_OS_LINUX)
+    if (QEventDispatcherEpoll::isRequested())
+        eventDispatcher = new QEventDispatcherEpoll(q);
+    else
+#  endif
 #  if !defined(QT_NO_GLIB)
     if (qEnvironmentVariableIsEmpty("QT_NO_GLIB") && QEventDispatcherGlib::versionSupported())
         eventDispatcher = new QEventDispatcherGlib(q);
@@ -1234,6 +1245,43 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // Queued calls are never compressed and there is nothing to sort for the
+    // normal priority, so they skip the mutex and go through the inbox.
+    // This keeps threads that post to a busy thread from queueing up on
+    // the mutex.
+    if (priority == Qt::NormalEventPriority && event->type() == QEvent::MetaCall) {
+        // delete the event on exceptions to protect against memory leaks
+        QScopedPointer<QEvent> eventDeleter(event);
+        QPostEventNode *node = new QPostEventNode;
+        node->event = QPostEvent(receiver, event, priority);
+        eventDeleter.take();
+
+        // Announce ourselves before checking the thread again: once we
+        // see that the object has not moved, moveToThread() waits for us
+        // and picks up whatever we push to the old thread.
+        forever {
+            data->postEventList.producers.ref();
+            if (data == *pdata)
+                break;
+            data->postEventList.producers.deref();
+            data = *pdata;
+            if (!data) {
+                delete node;
+                delete event;
+                return;
+            }
+        }
+
+        event->posted = true;
+        data->postEventList.enqueue(node);
+        data->postEventList.producers.deref();
+
+        QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+        if (dispatcher)
+            dispatcher->wakeUp();
+        return;
+    }
+
     // lock the post event mutex
     data->postEventList.mutex.lock();
 
@@ -1253,6 +1301,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QMutexUnlocker locker(&data->postEventList.mutex);
 
+    // keep the order of events of equal priority
+    data->postEventList.drainInbox();
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1361,6 +1412,9 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
     QMutexLocker locker(&data->postEventList.mutex);
 
+    // take the events posted through the inbox in one batch
+    data->postEventList.drainInbox();
+
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
     // events, canWait will be set to false.
@@ -1516,6 +1570,15 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 {
     QThreadData *data = receiver ? receiver->d_func()->threadData : QThreadData::current();
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.drainInbox();
+
+    // queued calls batched behind the one being delivered count as posted
+    if (eventType == 0 || eventType == QEvent::MetaCall) {
+        for (QMetaCallBatch *batch = data->postEventList.batches; batch; batch = batch->outer) {
+            if (!receiver || batch->receiver == receiver)
+                batch->cancelled.store(1);
+        }
+    }
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
@@ -1581,6 +1644,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.drainInbox();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -313,6 +313,7 @@ private:
     friend class QCoreApplication;
     friend class QCoreApplicationPrivate;
     friend class QThreadData;
+    friend class QPostEventList;
     friend class QApplication;
     friend class QApplicationPrivate;
     friend class QShortcutMap;
@@ -0,0 +1,675 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplatformdefs.h"
+
+#include "qcoreapplication.h"
+#include "qelapsedtimer.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include "qeventdispatcher_epoll_p.h"
+#include <private/qthread_p.h>
+#include <private/qcoreapplication_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <limits.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#ifndef QT_NO_EVENTFD
+#  include <sys/eventfd.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+enum { MaxEpollEvents = 256 };
+
+static const char *const socketNotifierTypeNames[] = { "Read", "Write", "Exception" };
+
+QEventDispatcherEpollPrivate::QEventDispatcherEpollPrivate()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1)
+        qFatal("QEventDispatcherEpollPrivate(): Unable to create epoll instance: %s",
+               qPrintable(qt_error_string(errno)));
+
+#ifndef QT_NO_EVENTFD
+    thread_pipe[0] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (thread_pipe[0] != -1)
+        thread_pipe[1] = -1;
+    else // fall through the next "if"
+#endif
+    if (qt_safe_pipe(thread_pipe, O_NONBLOCK) == -1)
+        qFatal("QEventDispatcherEpollPrivate(): Can not continue without a thread pipe");
+
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = thread_pipe[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, thread_pipe[0], &ev) == -1)
+        qFatal("QEventDispatcherEpollPrivate(): Unable to watch the thread pipe: %s",
+               qPrintable(qt_error_string(errno)));
+
+    // timerfd takes absolute expiry times on the clock QTimerInfoList uses,
+    // which is only stable when that clock is monotonic
+    timerFd = -1;
+    armedTimeout.tv_sec = -1;
+    armedTimeout.tv_nsec = 0;
+    if (QElapsedTimer::isMonotonic()) {
+        timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (timerFd != -1) {
+            ev.events = EPOLLIN;
+            ev.data.fd = timerFd;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &ev) == -1) {
+                qt_safe_close(timerFd);
+                timerFd = -1;
+            }
+        }
+    }
+}
+
+QEventDispatcherEpollPrivate::~QEventDispatcherEpollPrivate()
+{
+    qt_safe_close(epollFd);
+    if (timerFd != -1)
+        qt_safe_close(timerFd);
+    qt_safe_close(thread_pipe[0]);
+    if (thread_pipe[1] != -1)
+        qt_safe_close(thread_pipe[1]);
+
+    // cleanup timers
+    qDeleteAll(timerList);
+}
+
+/*
+    Brings the epoll registration of \a fd in line with the notifiers that
+    are enabled for it. Returns false if the descriptor is invalid.
+*/
+bool QEventDispatcherEpollPrivate::updateInterest(int fd, QEpollSocketNotifiers &sn)
+{
+    quint32 events = 0;
+    if (sn.notifiers[QSocketNotifier::Read])
+        events |= EPOLLIN;
+    if (sn.notifiers[QSocketNotifier::Write])
+        events |= EPOLLOUT;
+    if (sn.notifiers[QSocketNotifier::Exception])
+        events |= EPOLLPRI;
+    // Hang-ups and errors are always reported and are delivered to read
+    // and write notifiers. With only an exception notifier nobody would
+    // consume them, so report them once instead of on every wait.
+    if (events == EPOLLPRI)
+        events |= EPOLLET;
+
+    if (sn.alwaysReady || events == sn.events)
+        return true;
+
+    epoll_event ev;
+    ev.events = events;
+    ev.data.fd = fd;
+
+    if (!events) {
+        // the descriptor may already have been closed, which removes it
+        // from the epoll set on its own, so errors do not matter here
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &ev);
+        sn.events = 0;
+        return true;
+    }
+
+    int ret;
+    if (!sn.events) {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    } else {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+        if (ret == -1 && errno == ENOENT) {
+            // closed and reopened behind our back
+            ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+        }
+    }
+
+    if (ret == -1) {
+        if (errno == EPERM) {
+            // select() reports regular files as always readable and
+            // writable, while epoll refuses them; emulate select()
+            sn.alwaysReady = true;
+            sn.events = 0;
+            alwaysReadyFds.append(fd);
+            return true;
+        }
+        return false;
+    }
+
+    sn.events = events;
+    return true;
+}
+
+void QEventDispatcherEpollPrivate::setSocketNotifierPending(int fd, QEpollSocketNotifiers &sn, int type)
+{
+    if (!sn.notifiers[type] || (sn.pending & (1u << type)))
+        return;
+    sn.pending |= 1u << type;
+    PendingNotifier pending = { fd, type };
+    pendingList.append(pending);
+}
+
+/*
+    Sets timerFd to expire when the next timer is due, so that the kernel
+    wakes us up with nanosecond precision instead of after an epoll_wait()
+    timeout rounded up to whole milliseconds. If \a includeTimers is false
+    or there is no timer to wait for, timerFd is disarmed.
+*/
+void QEventDispatcherEpollPrivate::armTimer(bool includeTimers)
+{
+    timespec timeout;
+    const bool haveTimer = includeTimers && timerList.nextTimeout(timeout);
+    if (!haveTimer) {
+        timeout.tv_sec = -1;
+        timeout.tv_nsec = 0;
+    }
+    if (timeout.tv_sec == armedTimeout.tv_sec
+            && (!haveTimer || timeout.tv_nsec == armedTimeout.tv_nsec))
+        return;
+
+    itimerspec spec;
+    spec.it_interval.tv_sec = 0;
+    spec.it_interval.tv_nsec = 0;
+    if (haveTimer) {
+        spec.it_value = timeout;
+        // an all-zero value would disarm the timer instead of firing it
+        if (!spec.it_value.tv_sec && !spec.it_value.tv_nsec)
+            spec.it_value.tv_nsec = 1;
+    } else {
+        spec.it_value.tv_sec = 0;
+        spec.it_value.tv_nsec = 0;
+    }
+    timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, 0);
+    armedTimeout = timeout;
+}
+
+int QEventDispatcherEpollPrivate::waitForWakeUpOnly(timespec *timeout)
+{
+    pollfd pfd;
+    pfd.fd = thread_pipe[0];
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int ret;
+    do {
+        int ms = -1;
+        if (timeout)
+            ms = int(qMin<qint64>(INT_MAX, qint64(timeout->tv_sec) * 1000
+                                           + (timeout->tv_nsec + 999999) / 1000000));
+        ret = ::poll(&pfd, 1, ms);
+    } while (ret == -1 && errno == EINTR && !timeout);
+
+    if (ret > 0) {
+        processThreadWakeUp();
+        return 1;
+    }
+    return 0;
+}
+
+int QEventDispatcherEpollPrivate::doPoll(QEventLoop::ProcessEventsFlags flags, timespec *timeout)
+{
+    Q_Q(QEventDispatcherEpoll);
+
+    if (flags & QEventLoop::ExcludeSocketNotifiers)
+        return waitForWakeUpOnly(timeout);
+
+    // descriptors epoll cannot watch are always ready, so do not block
+    timespec zero = { 0l, 0l };
+    bool haveAlwaysReady = false;
+    for (int i = 0; i < alwaysReadyFds.size(); ++i) {
+        QHash<int, QEpollSocketNotifiers>::iterator it = socketNotifiers.find(alwaysReadyFds.at(i));
+        if (it == socketNotifiers.end() || !it->alwaysReady) {
+            alwaysReadyFds.remove(i--);
+            continue;
+        }
+        setSocketNotifierPending(it.key(), *it, QSocketNotifier::Read);
+        setSocketNotifierPending(it.key(), *it, QSocketNotifier::Write);
+        haveAlwaysReady = true;
+    }
+    if (haveAlwaysReady)
+        timeout = &zero;
+
+    timespec deadline;
+    if (timeout)
+        deadline = qt_gettime() + *timeout;
+
+    epoll_event events[MaxEpollEvents];
+    int nsel;
+    forever {
+        int ms = -1;
+        if (timeout) {
+            timespec remaining = deadline - qt_gettime();
+            if (remaining.tv_sec < 0)
+                remaining = zero;
+            // round up so that we do not wake up just before a timer is due
+            ms = int(qMin<qint64>(INT_MAX, qint64(remaining.tv_sec) * 1000
+                                           + (remaining.tv_nsec + 999999) / 1000000));
+        }
+        nsel = epoll_wait(epollFd, events, MaxEpollEvents, ms);
+        if (nsel != -1 || errno != EINTR)
+            break;
+    }
+
+    if (nsel == -1) {
+        // EBADF, EFAULT and EINVAL all mean our own state is broken
+        perror("epoll_wait");
+        nsel = 0;
+    }
+
+    int nevents = 0;
+    for (int i = 0; i < nsel; ++i) {
+        const int fd = events[i].data.fd;
+        const quint32 revents = events[i].events;
+        if (fd == thread_pipe[0]) {
+            processThreadWakeUp();
+            ++nevents;
+            continue;
+        }
+        if (fd == timerFd) {
+            // the timers themselves are activated by processEvents()
+            quint64 expirations;
+            if (::read(timerFd, &expirations, sizeof(expirations)) == -1) {
+                // spurious wakeup, nothing to consume
+            }
+            armedTimeout.tv_sec = -1;
+            continue;
+        }
+
+        QHash<int, QEpollSocketNotifiers>::iterator it = socketNotifiers.find(fd);
+        if (it == socketNotifiers.end())
+            continue;
+        // like select(), errors and hang-ups make a socket both readable
+        // and writable so that the owner notices them
+        if (revents & (EPOLLIN | EPOLLHUP | EPOLLERR))
+            setSocketNotifierPending(fd, *it, QSocketNotifier::Read);
+        if (revents & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+            setSocketNotifierPending(fd, *it, QSocketNotifier::Write);
+        if (revents & EPOLLPRI)
+            setSocketNotifierPending(fd, *it, QSocketNotifier::Exception);
+    }
+
+    return nevents + q->activateSocketNotifiers();
+}
+
+void QEventDispatcherEpollPrivate::processThreadWakeUp()
+{
+    // some other thread woke us up... consume the data on the thread pipe so that
+    // epoll_wait doesn't immediately return next time
+#ifndef QT_NO_EVENTFD
+    if (thread_pipe[1] == -1) {
+        // eventfd
+        eventfd_t value;
+        eventfd_read(thread_pipe[0], &value);
+    } else
+#endif
+    {
+        char c[16];
+        while (::read(thread_pipe[0], c, sizeof(c)) > 0) {
+        }
+    }
+
+    if (!wakeUps.testAndSetRelease(1, 0)) {
+        // hopefully, this is dead code
+        qWarning("QEventDispatcherEpoll: internal error, wakeUps.testAndSetRelease(1, 0) failed!");
+    }
+}
+
+int QEventDispatcherEpollPrivate::activateSocketNotifiers()
+{
+    if (pendingList.isEmpty())
+        return 0;
+
+    // Take the whole list: a notifier may run a nested event loop, which
+    // then starts a list of its own. The epoll ready list is round-robin
+    // already, so unlike the select() dispatcher there is no need to shuffle
+    // the activation order for fairness.
+    QPodList<PendingNotifier, 32> list;
+    qSwap(list, pendingList);
+
+    int n_act = 0;
+    QEvent event(QEvent::SockAct);
+    for (int i = 0; i < list.size(); ++i) {
+        const PendingNotifier &pending = list.at(i);
+        QHash<int, QEpollSocketNotifiers>::iterator it = socketNotifiers.find(pending.fd);
+        // the notifier may have been disabled or deleted by an earlier one
+        if (it == socketNotifiers.end() || !(it->pending & (1u << pending.type)))
+            continue;
+        it->pending &= ~(1u << pending.type);
+        QCoreApplication::sendEvent(it->notifiers[pending.type], &event);
+        ++n_act;
+    }
+    return n_act;
+}
+
+/*!
+    \class QEventDispatcherEpoll
+    \internal
+    \since 5.3
+
+    \brief The QEventDispatcherEpoll class is an event dispatcher for Linux
+    that waits with epoll(7) instead of select().
+
+    Socket notifiers are added to a persistent epoll set when they are
+    enabled and removed when they are disabled, so the cost of waiting no
+    longer grows with the number of idle sockets, and there is no
+    FD_SETSIZE limit on the descriptors that can be watched. Timers are
+    managed by the same QTimerInfoList as in QEventDispatcherUNIX, but the
+    dispatcher waits for them on a timerfd(2) instead of passing a timeout
+    to the kernel, which avoids rounding every wakeup up to a millisecond.
+
+    QCoreApplication and QThread use this dispatcher when isRequested()
+    returns true.
+*/
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QObject *parent)
+    : QAbstractEventDispatcher(*new QEventDispatcherEpollPrivate, parent)
+{ }
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent)
+    : QAbstractEventDispatcher(dd, parent)
+{ }
+
+QEventDispatcherEpoll::~QEventDispatcherEpoll()
+{
+}
+
+/*!
+    Returns true if the application asked for the epoll dispatcher, either
+    by setting the Qt::AA_UseEpollEventDispatcher attribute or the
+    \c QT_USE_EPOLL environment variable.
+*/
+bool QEventDispatcherEpoll::isRequested()
+{
+    return QCoreApplication::testAttribute(Qt::AA_UseEpollEventDispatcher)
+            || !qEnvironmentVariableIsEmpty("QT_USE_EPOLL");
+}
+
+/*!
+    \internal
+*/
+void QEventDispatcherEpoll::registerTimer(int timerId, int interval, Qt::TimerType timerType, QObject *obj)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1 || interval < 0 || !obj) {
+        qWarning("QEventDispatcherEpoll::registerTimer: invalid arguments");
+        return;
+    } else if (obj->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QObject::startTimer: timers cannot be started from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    d->timerList.registerTimer(timerId, interval, timerType, obj);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimer(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: invalid argument");
+        return false;
+    } else if (thread() != QThread::currentThread()) {
+        qWarning("QObject::killTimer: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimer(timerId);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimers(QObject *object)
+{
+#ifndef QT_NO_DEBUG
+    if (!object) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: invalid argument");
+        return false;
+    } else if (object->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QObject::killTimers: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimers(object);
+}
+
+QList<QEventDispatcherEpoll::TimerInfo>
+QEventDispatcherEpoll::registeredTimers(QObject *object) const
+{
+    if (!object) {
+        qWarning("QEventDispatcherEpoll:registeredTimers: invalid argument");
+        return QList<TimerInfo>();
+    }
+
+    Q_D(const QEventDispatcherEpoll);
+    return d->timerList.registeredTimers(object);
+}
+
+int QEventDispatcherEpoll::remainingTime(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::remainingTime: invalid argument");
+        return -1;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.timerRemainingTime(timerId);
+}
+
+void QEventDispatcherEpoll::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    int type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (sockfd < 0) {
+        qWarning("QSocketNotifier: Internal error");
+        return;
+    } else if (notifier->thread() != thread()
+               || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be enabled from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    QHash<int, QEpollSocketNotifiers>::iterator it = d->socketNotifiers.find(sockfd);
+    if (it == d->socketNotifiers.end()) {
+        QEpollSocketNotifiers sn;
+        sn.notifiers[0] = sn.notifiers[1] = sn.notifiers[2] = 0;
+        sn.events = 0;
+        sn.pending = 0;
+        sn.alwaysReady = false;
+        it = d->socketNotifiers.insert(sockfd, sn);
+    } else if (it->notifiers[type]) {
+        qWarning("QSocketNotifier: Multiple socket notifiers for "
+                 "same socket %d and type %s", sockfd, socketNotifierTypeNames[type]);
+    }
+
+    it->notifiers[type] = notifier;
+    it->pending &= ~(1u << type);
+    if (!d->updateInterest(sockfd, *it)) {
+        qWarning("QSocketNotifier: Invalid socket %d and type '%s', disabling...",
+                 sockfd, socketNotifierTypeNames[type]);
+        notifier->setEnabled(false);
+    }
+}
+
+void QEventDispatcherEpoll::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    int type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (sockfd < 0) {
+        qWarning("QSocketNotifier: Internal error");
+        return;
+    } else if (notifier->thread() != thread()
+               || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be disabled from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    QHash<int, QEpollSocketNotifiers>::iterator it = d->socketNotifiers.find(sockfd);
+    if (it == d->socketNotifiers.end() || it->notifiers[type] != notifier)
+        return;
+
+    it->notifiers[type] = 0;
+    it->pending &= ~(1u << type);     // drop it from the activation list
+    d->updateInterest(sockfd, *it);
+    if (!it->notifiers[0] && !it->notifiers[1] && !it->notifiers[2])
+        d->socketNotifiers.erase(it);
+}
+
+int QEventDispatcherEpoll::activateTimers()
+{
+    Q_ASSERT(thread() == QThread::currentThread());
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.activateTimers();
+}
+
+int QEventDispatcherEpoll::activateSocketNotifiers()
+{
+    Q_D(QEventDispatcherEpoll);
+    return d->activateSocketNotifiers();
+}
+
+bool QEventDispatcherEpoll::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.store(0);
+
+    // we are awake, broadcast it
+    emit awake();
+    QCoreApplicationPrivate::sendPostedEvents(0, 0, d->threadData);
+
+    int nevents = 0;
+    const bool canWait = (d->threadData->canWaitLocked()
+                          && !d->interrupt.load()
+                          && (flags & QEventLoop::WaitForMoreEvents));
+
+    if (canWait)
+        emit aboutToBlock();
+
+    if (!d->interrupt.load()) {
+        // return the maximum time we can wait for an event.
+        timespec *tm = 0;
+        timespec wait_tm = { 0l, 0l };
+        if (d->timerFd != -1 && !(flags & QEventLoop::ExcludeSocketNotifiers)) {
+            // the timers wake up epoll_wait() through the timerfd
+            d->armTimer(!(flags & QEventLoop::X11ExcludeTimers));
+        } else if (!(flags & QEventLoop::X11ExcludeTimers)) {
+            if (d->timerList.timerWait(wait_tm))
+                tm = &wait_tm;
+        }
+
+        if (!canWait) {
+            if (!tm)
+                tm = &wait_tm;
+
+            // no time to wait
+            tm->tv_sec  = 0l;
+            tm->tv_nsec = 0l;
+        }
+
+        nevents = d->doPoll(flags, tm);
+
+        // activate timers
+        if (! (flags & QEventLoop::X11ExcludeTimers)) {
+            nevents += activateTimers();
+        }
+    }
+    // return true if we handled events, false otherwise
+    return (nevents > 0);
+}
+
+bool QEventDispatcherEpoll::hasPendingEvents()
+{
+    extern uint qGlobalPostedEventsCount(); // from qapplication.cpp
+    return qGlobalPostedEventsCount();
+}
+
+void QEventDispatcherEpoll::wakeUp()
+{
+    Q_D(QEventDispatcherEpoll);
+    if (d->wakeUps.testAndSetAcquire(0, 1)) {
+#ifndef QT_NO_EVENTFD
+        if (d->thread_pipe[1] == -1) {
+            // eventfd
+            eventfd_t value = 1;
+            int ret;
+            EINTR_LOOP(ret, eventfd_write(d->thread_pipe[0], value));
+            return;
+        }
+#endif
+        char c = 0;
+        qt_safe_write( d->thread_pipe[1], &c, 1 );
+    }
+}
+
+void QEventDispatcherEpoll::interrupt()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.store(1);
+    wakeUp();
+}
+
+void QEventDispatcherEpoll::flush()
+{ }
+
+QT_END_NAMESPACE
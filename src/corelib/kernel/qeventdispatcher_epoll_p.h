@@ -0,0 +1,156 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QEVENTDISPATCHER_EPOLL_P_H
+#define QEVENTDISPATCHER_EPOLL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "QtCore/qabstracteventdispatcher.h"
+#include "QtCore/qhash.h"
+#include "QtCore/qvector.h"
+#include "private/qabstracteventdispatcher_p.h"
+#include "private/qcore_unix_p.h"
+#include "private/qpodlist_p.h"
+#include "private/qtimerinfo_unix_p.h"
+
+QT_BEGIN_NAMESPACE
+
+// The notifiers registered for one file descriptor. The descriptor is added
+// to the epoll set once and only modified when the set of enabled notifier
+// types changes.
+struct QEpollSocketNotifiers
+{
+    QSocketNotifier *notifiers[3]; // read, write and exception
+    quint32 events;                // interest currently registered with epoll
+    uint pending : 3;              // types waiting in the activation list
+    uint alwaysReady : 1;          // not pollable (regular files), always ready like select()
+};
+
+class QEventDispatcherEpollPrivate;
+
+class Q_CORE_EXPORT QEventDispatcherEpoll : public QAbstractEventDispatcher
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QEventDispatcherEpoll)
+
+public:
+    explicit QEventDispatcherEpoll(QObject *parent = 0);
+    ~QEventDispatcherEpoll();
+
+    bool processEvents(QEventLoop::ProcessEventsFlags flags);
+    bool hasPendingEvents();
+
+    void registerSocketNotifier(QSocketNotifier *notifier);
+    void unregisterSocketNotifier(QSocketNotifier *notifier);
+
+    void registerTimer(int timerId, int interval, Qt::TimerType timerType, QObject *object);
+    bool unregisterTimer(int timerId);
+    bool unregisterTimers(QObject *object);
+    QList<TimerInfo> registeredTimers(QObject *object) const;
+
+    int remainingTime(int timerId);
+
+    void wakeUp();
+    void interrupt();
+    void flush();
+
+    static bool isRequested();
+
+protected:
+    QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent = 0);
+
+    int activateTimers();
+    int activateSocketNotifiers();
+};
+
+class Q_CORE_EXPORT QEventDispatcherEpollPrivate : public QAbstractEventDispatcherPrivate
+{
+    Q_DECLARE_PUBLIC(QEventDispatcherEpoll)
+
+public:
+    QEventDispatcherEpollPrivate();
+    ~QEventDispatcherEpollPrivate();
+
+    int doPoll(QEventLoop::ProcessEventsFlags flags, timespec *timeout);
+    void armTimer(bool includeTimers);
+    int waitForWakeUpOnly(timespec *timeout);
+    void processThreadWakeUp();
+    bool updateInterest(int fd, QEpollSocketNotifiers &sn);
+    void setSocketNotifierPending(int fd, QEpollSocketNotifiers &sn, int type);
+    int activateSocketNotifiers();
+
+    int epollFd;
+
+    // if thread_pipe[1] is -1, then eventfd(7) is in use and is stored in thread_pipe[0]
+    int thread_pipe[2];
+
+    // timerfd(2) that wakes us up for the next timer, or -1 when the kernel
+    // lacks timerfd or the clock is not monotonic; armedTimeout is the
+    // absolute expiry it is set to, with a negative tv_sec when disarmed
+    int timerFd;
+    timespec armedTimeout;
+
+    QHash<int, QEpollSocketNotifiers> socketNotifiers;
+    QVector<int> alwaysReadyFds;
+
+    struct PendingNotifier { int fd; int type; };
+    QPodList<PendingNotifier, 32> pendingList;
+
+    QTimerInfoList timerList;
+
+    QAtomicInt wakeUps;
+    QAtomicInt interrupt; // bool
+};
+
+QT_END_NAMESPACE
+
+#endif // QEVENTDISPATCHER_EPOLL_P_H
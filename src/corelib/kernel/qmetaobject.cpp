@@ -2138,6 +2138,9 @@ bool QMetaMethod::invoke(QObject *object,
                          ? Qt::DirectConnection
                          : Qt::QueuedConnection;
     }
+    // there is no connection to coalesce calls on
+    if (connectionType == Qt::QueuedCoalescedConnection)
+        connectionType = Qt::QueuedConnection;
 
 #ifdef QT_NO_THREAD
     if (connectionType == Qt::BlockingQueuedConnection) {
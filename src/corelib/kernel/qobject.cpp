@@ -63,6 +63,7 @@
 #include <qsharedpointer.h>
 
 #include <private/qorderedmutexlocker_p.h>
+#include <private/qfreelist_p.h>
 
 #include <new>
 
@@ -232,7 +233,7 @@ QObjectPrivate::~QObjectPrivate()
             QAbstractEventDispatcherPrivate::releaseTimerId(extraData->runningTimers.at(i));
     }
 
-    if (postedEvents)
+    if (postedEvents || threadData->postEventList.hasInboxEvents())
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
     threadData->deref();
@@ -278,26 +279,190 @@ static void computeOffsets(const QMetaObject *metaobject, int *signalOffset, int
     of the receiver must be locked when touching the pointers of this
     linked list.
 */
-class QObjectConnectionListVector : public QVector<QObjectPrivate::ConnectionList>
+/*
+  The connection lists of a sender: one list per signal, and allsignals for
+  the connections to all signals.
+
+  QMetaObject::activate() walks the lists without locking. Everything else
+  holds the signalSlotLock() of the sender. An activation registers in
+  activations before it loads any connection, so a function that takes a
+  connection out of the lists can tell whether an activation may still be
+  walking through it:
+
+  - the array of lists is never reallocated; resize() publishes a bigger
+    copy and retires the old one,
+  - cleanConnectionLists() unlinks the disconnected connections, which
+    become orphans,
+  - deleteOrphans() deletes the retired arrays and the orphans once no
+    activation is running. The slot objects of connections disconnected
+    during an activation are destroyed then as well.
+*/
+class QObjectConnectionListVector
 {
 public:
-    bool orphaned; //the QObject owner of this vector has been destroyed while the vector was inUse
+    struct ListArray
+    {
+        int count;
+        ListArray *nextRetired;
+        QObjectPrivate::ConnectionList lists[1];
+    };
+
+    QAtomicInt orphaned; //the QObject owner of this vector has been destroyed while the vector was inUse
     bool dirty; //some Connection have been disconnected (their receiver is 0) but not removed from the list yet
-    int inUse; //number of functions that are currently accessing this object or its connections
+    QAtomicInt inUse; //number of functions that are currently accessing this object or its connections, with the lock held
+    QAtomicInt activations; //number of QMetaObject::activate() calls walking the lists without the lock
+    QAtomicInt currentConnectionId; //id of the latest connection, wrapping around; activations skip the ones made after they started
+    QAtomicInt cleanupPending; //set while there are disconnected connections or retired arrays to delete
+    QAtomicPointer<ListArray> lists;
     QObjectPrivate::ConnectionList allsignals;
+    ListArray *retired;
+    QObjectPrivate::Connection *orphans;
 
     QObjectConnectionListVector()
-        : QVector<QObjectPrivate::ConnectionList>(), orphaned(false), dirty(false), inUse(0)
+        : orphaned(0), dirty(false), inUse(0), retired(0), orphans(0)
     { }
+    ~QObjectConnectionListVector();
+
+    // Returns true if \a c was made after the connection with id \a lastId.
+    // Ids wrap around, so \a c is new if its id is one of those handed out
+    // since, rather than if it is higher.
+    bool isNewConnection(const QObjectPrivate::Connection *c, uint lastId) const
+    {
+        return c->id - lastId - 1 < uint(currentConnectionId.load()) - lastId;
+    }
+
+    int count() const
+    {
+        const ListArray *array = lists.load();
+        return array ? array->count : 0;
+    }
+
+    const QObjectPrivate::ConnectionList &at(int at) const
+    {
+        return lists.load()->lists[at];
+    }
 
     QObjectPrivate::ConnectionList &operator[](int at)
     {
         if (at < 0)
             return allsignals;
-        return QVector<QObjectPrivate::ConnectionList>::operator[](at);
+        return lists.load()->lists[at];
     }
+
+    void resize(int size);
+
+    void setDirty()
+    {
+        dirty = true;
+        cleanupPending.store(1);
+    }
+
+    // Must be called after the change that hides a connection from new
+    // activations, so that none of them can miss that change.
+    bool isActivating()
+    {
+        return !activations.testAndSetOrdered(0, 0);
+    }
+
+    typedef QVarLengthArray<QtPrivate::QSlotObjectBase *, 4> SlotObjectList;
+    void deleteOrphans(SlotObjectList *slotObjects);
 };
 
+QObjectConnectionListVector::~QObjectConnectionListVector()
+{
+    // the lists have been emptied by ~QObject and no activation is running
+    SlotObjectList slotObjects;
+    deleteOrphans(&slotObjects);
+    for (int i = 0; i < slotObjects.size(); ++i)
+        slotObjects.at(i)->destroyIfLastRef();
+    ::free(lists.load());
+}
+
+/*
+  Grows the array of lists to \a size. Activations that have loaded the
+  current array keep using it, so it is retired instead of freed.
+*/
+void QObjectConnectionListVector::resize(int size)
+{
+    ListArray *old = lists.load();
+    const int oldCount = old ? old->count : 0;
+    if (size <= oldCount)
+        return;
+
+    ListArray *array = static_cast<ListArray *>(::malloc(sizeof(ListArray)
+                                                         + (size - 1) * sizeof(QObjectPrivate::ConnectionList)));
+    Q_CHECK_PTR(array);
+    array->count = size;
+    array->nextRetired = 0;
+    for (int i = 0; i < size; ++i) {
+        QObjectPrivate::ConnectionList *list = new (&array->lists[i]) QObjectPrivate::ConnectionList;
+        if (i < oldCount) {
+            list->first.store(old->lists[i].first.load());
+            list->last = old->lists[i].last;
+        }
+    }
+    lists.storeRelease(array);
+
+    if (old) {
+        old->nextRetired = retired;
+        retired = old;
+        cleanupPending.store(1);
+    }
+}
+
+/*
+  Deletes the retired arrays and the orphaned connections unless an
+  activation is running. The slot objects the deleted connections still own
+  are added to \a slotObjects, to be destroyed by the caller once the
+  signalSlotLock() is released; if \a slotObjects is 0, those connections
+  are kept for later.
+*/
+void QObjectConnectionListVector::deleteOrphans(SlotObjectList *slotObjects)
+{
+    if ((retired || orphans) && !isActivating()) {
+        while (ListArray *array = retired) {
+            retired = array->nextRetired;
+            ::free(array);
+        }
+
+        QObjectPrivate::Connection **prev = &orphans;
+        while (QObjectPrivate::Connection *c = *prev) {
+            if (c->isSlotObject) {
+                if (!slotObjects) {
+                    prev = &c->nextOrphan;
+                    continue;
+                }
+                c->isSlotObject = false;
+                slotObjects->append(c->slotObj);
+            }
+            *prev = c->nextOrphan;
+            c->deref();
+        }
+    }
+    cleanupPending.store(dirty || retired || orphans);
+}
+
+/*
+  Deletes the connections of \a sender that have been disconnected while
+  an activation was running. Called when the last activation returns.
+*/
+static void deleteDisconnectedConnections(QObject *sender)
+{
+    QObjectConnectionListVector::SlotObjectList slotObjects;
+    {
+        QMutexLocker locker(signalSlotLock(sender));
+        QObjectPrivate *d = QObjectPrivate::get(sender);
+        QObjectConnectionListVector *connectionLists = d->connectionLists.load();
+        // a function using the lists cleans up when it is done
+        if (!connectionLists || connectionLists->inUse.load())
+            return;
+        d->cleanConnectionLists();
+        connectionLists->deleteOrphans(&slotObjects);
+    }
+    for (int i = 0; i < slotObjects.size(); ++i)
+        slotObjects.at(i)->destroyIfLastRef();
+}
+
 // Used by QAccessibleWidget
 bool QObjectPrivate::isSender(const QObject *receiver, const char *signal) const
 {
@@ -306,15 +471,15 @@ bool QObjectPrivate::isSender(const QObject *receiver, const char *signal) const
     if (signal_index < 0)
         return false;
     QMutexLocker locker(signalSlotLock(q));
-    if (connectionLists) {
+    if (QObjectConnectionListVector *connectionLists = this->connectionLists.load()) {
         if (signal_index < connectionLists->count()) {
             const QObjectPrivate::Connection *c =
-                connectionLists->at(signal_index).first;
+                connectionLists->at(signal_index).first.load();
 
             while (c) {
-                if (c->receiver == receiver)
+                if (c->receiver.load() == receiver)
                     return true;
-                c = c->nextConnectionList;
+                c = c->nextConnectionList.load();
             }
         }
     }
@@ -330,14 +495,14 @@ QObjectList QObjectPrivate::receiverList(const char *signal) const
     if (signal_index < 0)
         return returnValue;
     QMutexLocker locker(signalSlotLock(q));
-    if (connectionLists) {
+    if (QObjectConnectionListVector *connectionLists = this->connectionLists.load()) {
         if (signal_index < connectionLists->count()) {
-            const QObjectPrivate::Connection *c = connectionLists->at(signal_index).first;
+            const QObjectPrivate::Connection *c = connectionLists->at(signal_index).first.load();
 
             while (c) {
-                if (c->receiver)
-                    returnValue << c->receiver;
-                c = c->nextConnectionList;
+                if (QObject *receiver = c->receiver.load())
+                    returnValue << receiver;
+                c = c->nextConnectionList.load();
             }
         }
     }
@@ -367,22 +532,32 @@ QObjectList QObjectPrivate::senderList() const
 void QObjectPrivate::addConnection(int signal, Connection *c)
 {
     Q_ASSERT(c->sender == q_ptr);
-    if (!connectionLists)
+    QObjectConnectionListVector *connectionLists = this->connectionLists.load();
+    if (!connectionLists) {
         connectionLists = new QObjectConnectionListVector();
+        this->connectionLists.storeRelease(connectionLists);
+    }
+    // size the array for all signals at once, growing it retires the old one
     if (signal >= connectionLists->count())
-        connectionLists->resize(signal + 1);
+        connectionLists->resize(qMax(signal + 1, QMetaObjectPrivate::absoluteSignalCount(q_ptr->metaObject())));
+
+    QObjectPrivate *receiverPrivate = QObjectPrivate::get(c->receiver.load());
+    c->receiverThreadData.store(receiverPrivate->threadData);
+    c->id = uint(connectionLists->currentConnectionId.load()) + 1;
+    connectionLists->currentConnectionId.store(int(c->id));
 
+    // publish the connection to QMetaObject::activate()
     ConnectionList &connectionList = (*connectionLists)[signal];
     if (connectionList.last) {
-        connectionList.last->nextConnectionList = c;
+        connectionList.last->nextConnectionList.storeRelease(c);
     } else {
-        connectionList.first = c;
+        connectionList.first.storeRelease(c);
     }
     connectionList.last = c;
 
     cleanConnectionLists();
 
-    c->prev = &(QObjectPrivate::get(c->receiver)->senders);
+    c->prev = &receiverPrivate->senders;
     c->next = *c->prev;
     *c->prev = c;
     if (c->next)
@@ -397,7 +572,8 @@ void QObjectPrivate::addConnection(int signal, Connection *c)
 
 void QObjectPrivate::cleanConnectionLists()
 {
-    if (connectionLists->dirty && !connectionLists->inUse) {
+    QObjectConnectionListVector *connectionLists = this->connectionLists.load();
+    if (connectionLists->dirty && !connectionLists->inUse.load()) {
         // remove broken connections
         for (int signal = -1; signal < connectionLists->count(); ++signal) {
             QObjectPrivate::ConnectionList &connectionList =
@@ -408,19 +584,21 @@ void QObjectPrivate::cleanConnectionLists()
             // at the end of the cleanup.
             QObjectPrivate::Connection *last = 0;
 
-            QObjectPrivate::Connection **prev = &connectionList.first;
-            QObjectPrivate::Connection *c = *prev;
+            QAtomicPointer<QObjectPrivate::Connection> *prev = &connectionList.first;
+            QObjectPrivate::Connection *c = prev->load();
             while (c) {
-                if (c->receiver) {
+                QObjectPrivate::Connection *next = c->nextConnectionList.load();
+                if (c->receiver.load()) {
                     last = c;
                     prev = &c->nextConnectionList;
-                    c = *prev;
                 } else {
-                    QObjectPrivate::Connection *next = c->nextConnectionList;
-                    *prev = next;
-                    c->deref();
-                    c = next;
+                    // an activation may still be walking through c,
+                    // deleteOrphans() deletes it once none is running
+                    prev->storeRelease(next);
+                    c->nextOrphan = connectionLists->orphans;
+                    connectionLists->orphans = c;
                 }
+                c = next;
             }
 
             // Correct the connection list's last pointer.
@@ -429,6 +607,134 @@ void QObjectPrivate::cleanConnectionLists()
         }
         connectionLists->dirty = false;
     }
+    connectionLists->deleteOrphans(0);
+}
+
+namespace {
+struct QMetaCallEventFreeListConstants : public QFreeListDefaultConstants
+{
+    enum {
+        InitialNextValue = 0,
+        BlockCount = 4
+    };
+
+    static const int Sizes[BlockCount];
+};
+
+const int QMetaCallEventFreeListConstants::Sizes[QMetaCallEventFreeListConstants::BlockCount] = {
+    128,
+    512,
+    2048,
+    8192
+};
+
+enum {
+    MetaCallEventPoolSize = 128 + 512 + 2048 + 8192
+};
+
+// Every QMetaCallEvent is preceded by a header that tells operator delete
+// whether it came from the pool, and which element of the pool it uses.
+union QMetaCallEventHeader
+{
+    int id;
+    double alignment;
+};
+
+struct QMetaCallEventSlot
+{
+    QMetaCallEventHeader header;
+    union {
+        void *p;
+        double d;
+        qint64 i;
+    } storage[(sizeof(QMetaCallEvent) + sizeof(double) - 1) / sizeof(double)];
+};
+
+typedef QFreeList<QMetaCallEventSlot, QMetaCallEventFreeListConstants> QMetaCallEventFreeList;
+
+QBasicAtomicPointer<QMetaCallEventFreeList> metaCallEventPool = Q_BASIC_ATOMIC_INITIALIZER(0);
+// One reference for every event in the pool, and one released when the
+// library is unloaded. Posted events may outlive the destruction of static
+// objects, so the pool is deleted together with the last of them.
+QBasicAtomicInt metaCallEventPoolRefs = Q_BASIC_ATOMIC_INITIALIZER(1);
+
+// Returns false if the pool is full or has been released.
+bool refMetaCallEventPool()
+{
+    for (;;) {
+        const int refs = metaCallEventPoolRefs.load();
+        if (refs == 0 || refs > MetaCallEventPoolSize)
+            return false;
+        if (metaCallEventPoolRefs.testAndSetRelaxed(refs, refs + 1))
+            return true;
+    }
+}
+
+void derefMetaCallEventPool()
+{
+    if (!metaCallEventPoolRefs.deref())
+        delete metaCallEventPool.fetchAndStoreAcquire(0);
+}
+
+QMetaCallEventFreeList *metaCallEventFreeList()
+{
+    QMetaCallEventFreeList *pool = metaCallEventPool.loadAcquire();
+    if (!pool) {
+        pool = new QMetaCallEventFreeList;
+        if (!metaCallEventPool.testAndSetOrdered(0, pool)) {
+            delete pool;
+            pool = metaCallEventPool.loadAcquire();
+        }
+    }
+    return pool;
+}
+} // unnamed namespace
+
+static void releaseMetaCallEventPool()
+{
+    derefMetaCallEventPool();
+}
+Q_DESTRUCTOR_FUNCTION(releaseMetaCallEventPool)
+
+/*!
+    \internal
+
+    Queued calls are allocated from a lock-free pool, since they are usually
+    created in one thread and deleted in another. Events of subclasses and
+    events allocated while the pool is exhausted come from the heap.
+ */
+void *QMetaCallEvent::operator new(size_t size)
+{
+    if (size == sizeof(QMetaCallEvent)) {
+        if (refMetaCallEventPool()) {
+            QMetaCallEventFreeList *pool = metaCallEventFreeList();
+            const int id = pool->next();
+            QMetaCallEventSlot &slot = (*pool)[id];
+            slot.header.id = id;
+            return slot.storage;
+        }
+    }
+
+    QMetaCallEventHeader *header = static_cast<QMetaCallEventHeader *>(::malloc(sizeof(QMetaCallEventHeader) + size));
+    Q_CHECK_PTR(header);
+    header->id = -1;
+    return header + 1;
+}
+
+/*!
+    \internal
+ */
+void QMetaCallEvent::operator delete(void *ptr)
+{
+    if (!ptr)
+        return;
+    QMetaCallEventHeader *header = static_cast<QMetaCallEventHeader *>(ptr) - 1;
+    if (header->id < 0) {
+        ::free(header);
+        return;
+    }
+    metaCallEventPool.load()->release(header->id);
+    derefMetaCallEventPool();
 }
 
 /*!
@@ -439,7 +745,9 @@ QMetaCallEvent::QMetaCallEvent(ushort method_offset, ushort method_relative, QOb
                                int nargs, int *types, void **args, QSemaphore *semaphore)
     : QEvent(MetaCall), slotObj_(0), sender_(sender), signalId_(signalId),
       nargs_(nargs), types_(types), args_(args), semaphore_(semaphore),
-      callFunction_(callFunction), method_offset_(method_offset), method_relative_(method_relative)
+      callFunction_(callFunction), nextCall_(0), lastCall_(this), coalescedConnection_(0),
+      method_offset_(method_offset), method_relative_(method_relative),
+      ownsArguments_(false), storageUsed_(0)
 { }
 
 /*!
@@ -449,7 +757,9 @@ QMetaCallEvent::QMetaCallEvent(QtPrivate::QSlotObjectBase *slotO, const QObject
                                int nargs, int *types, void **args, QSemaphore *semaphore)
     : QEvent(MetaCall), slotObj_(slotO), sender_(sender), signalId_(signalId),
       nargs_(nargs), types_(types), args_(args), semaphore_(semaphore),
-      callFunction_(0), method_offset_(0), method_relative_(ushort(-1))
+      callFunction_(0), nextCall_(0), lastCall_(this), coalescedConnection_(0),
+      method_offset_(0), method_relative_(ushort(-1)),
+      ownsArguments_(false), storageUsed_(0)
 {
     if (slotObj_)
         slotObj_->ref();
@@ -462,11 +772,19 @@ QMetaCallEvent::~QMetaCallEvent()
 {
     if (types_) {
         for (int i = 0; i < nargs_; ++i) {
-            if (types_[i] && args_[i])
-                QMetaType::destroy(types_[i], args_[i]);
+            if (types_[i] && args_[i]) {
+                if (isInlineArgument(args_[i]))
+                    QMetaType::destruct(types_[i], args_[i]);
+                else
+                    QMetaType::destroy(types_[i], args_[i]);
+            }
+        }
+        if (!ownsArguments_) {
+            free(types_);
+            free(args_);
+        } else if (args_ != preallocatedArgs_) {
+            free(args_); // the types are stored in the same block
         }
-        free(types_);
-        free(args_);
     }
 #ifndef QT_NO_THREAD
     if (semaphore_)
@@ -474,6 +792,20 @@ QMetaCallEvent::~QMetaCallEvent()
 #endif
     if (slotObj_)
         slotObj_->destroyIfLastRef();
+
+    if (coalescedConnection_) {
+        // not delivered; drop the call it would have picked up
+        delete coalescedConnection_->coalescedCall.fetchAndStoreOrdered(0);
+        coalescedConnection_->deref();
+    }
+
+    QMetaCallEvent *call = nextCall_;
+    while (call) {
+        QMetaCallEvent *next = call->nextCall_;
+        call->nextCall_ = 0;
+        delete call;
+        call = next;
+    }
 }
 
 /*!
@@ -481,7 +813,15 @@ QMetaCallEvent::~QMetaCallEvent()
  */
 void QMetaCallEvent::placeMetaCall(QObject *object)
 {
-    if (slotObj_) {
+    if (coalescedConnection_) {
+        // Emissions from now on post a new event; this one must not drop
+        // their call when it is destroyed.
+        QScopedPointer<QMetaCallEvent> call(coalescedConnection_->coalescedCall.fetchAndStoreOrdered(0));
+        coalescedConnection_->deref();
+        coalescedConnection_ = 0;
+        if (call)
+            call->placeMetaCall(object);
+    } else if (slotObj_) {
         slotObj_->call(object, args_);
     } else if (callFunction_ && method_offset_ <= object->metaObject()->methodOffset()) {
         callFunction_(object, QMetaObject::InvokeMetaMethod, method_relative_, args_);
@@ -490,6 +830,96 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+/*!
+    \internal
+
+    Allocates the arrays for \a nargs arguments, including the return value
+    at index 0, which is set to none. The event must not have arguments yet.
+ */
+void QMetaCallEvent::allocateArguments(int nargs)
+{
+    Q_ASSERT(!types_ && !args_);
+    if (nargs <= PreallocatedArguments) {
+        args_ = preallocatedArgs_;
+        types_ = preallocatedTypes_;
+    } else {
+        args_ = static_cast<void **>(malloc(nargs * (sizeof(void *) + sizeof(int))));
+        Q_CHECK_PTR(args_);
+        types_ = reinterpret_cast<int *>(args_ + nargs);
+    }
+    nargs_ = nargs;
+    ownsArguments_ = true;
+    for (int i = 0; i < nargs; ++i) {
+        types_[i] = 0;
+        args_[i] = 0;
+    }
+}
+
+/*!
+    \internal
+
+    Stores a copy of \a copy, of the meta type \a type, as argument \a index.
+    Small values are constructed inside the event. Only builtin types are
+    assumed to be aligned to at most 8 bytes if they are larger than that.
+ */
+void QMetaCallEvent::constructArgument(int index, int type, const void *copy)
+{
+    Q_ASSERT(ownsArguments_ && index > 0 && index < nargs_);
+    types_[index] = type;
+
+    const int size = QMetaType::sizeOf(type);
+    const int slotCount = (size + int(sizeof(storage_[0])) - 1) / int(sizeof(storage_[0]));
+    if (size > 0 && (size <= int(sizeof(storage_[0])) || (type < QMetaType::User && size <= 2 * int(sizeof(storage_[0]))))
+        && storageUsed_ + slotCount <= InlineStorageSlots) {
+        args_[index] = QMetaType::construct(type, storage_ + storageUsed_, copy);
+        storageUsed_ += slotCount;
+    } else {
+        args_[index] = QMetaType::create(type, copy);
+    }
+}
+
+/*!
+    \internal
+
+    Appends \a call to the calls delivered with this event, which takes
+    ownership of it.
+ */
+void QMetaCallEvent::appendCall(QMetaCallEvent *call)
+{
+    Q_ASSERT(!call->nextCall_ && canBatch() && call->canBatch());
+    lastCall_->nextCall_ = call;
+    lastCall_ = call->lastCall_;
+}
+
+/*!
+    \internal
+
+    Detaches and returns the calls after \a call, which must be this event or
+    one of the calls appended to it.
+ */
+QMetaCallEvent *QMetaCallEvent::takeCallsAfter(QMetaCallEvent *call)
+{
+    QMetaCallEvent *rest = call->nextCall_;
+    if (rest) {
+        call->nextCall_ = 0;
+        rest->lastCall_ = lastCall_;
+        lastCall_ = call;
+    }
+    return rest;
+}
+
+/*!
+    \internal
+
+    Turns this event into the notification for a Qt::QueuedCoalescedConnection:
+    when delivered, it places the latest call stored in \a connection.
+ */
+void QMetaCallEvent::setCoalescedConnection(QObjectPrivate::Connection *connection)
+{
+    connection->ref();
+    coalescedConnection_ = connection;
+}
+
 /*!
     \class QObject
     \inmodule QtCore
@@ -828,39 +1258,38 @@ QObject::~QObject()
         d->currentSender->ref = 0;
     d->currentSender = 0;
 
-    if (d->connectionLists || d->senders) {
+    QObjectConnectionListVector *deadConnectionLists = 0;
+    if (d->connectionLists.load() || d->senders) {
         QMutex *signalSlotMutex = signalSlotLock(this);
         QMutexLocker locker(signalSlotMutex);
 
         // disconnect all receivers
-        if (d->connectionLists) {
-            ++d->connectionLists->inUse;
-            int connectionListsCount = d->connectionLists->count();
+        if (QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+            connectionLists->inUse.ref();
+            int connectionListsCount = connectionLists->count();
             for (int signal = -1; signal < connectionListsCount; ++signal) {
                 QObjectPrivate::ConnectionList &connectionList =
-                    (*d->connectionLists)[signal];
-
-                while (QObjectPrivate::Connection *c = connectionList.first) {
-                    if (!c->receiver) {
-                        connectionList.first = c->nextConnectionList;
-                        c->deref();
-                        continue;
+                    (*connectionLists)[signal];
+
+                while (QObjectPrivate::Connection *c = connectionList.first.load()) {
+                    if (QObject *receiver = c->receiver.load()) {
+                        QMutex *m = signalSlotLock(receiver);
+                        bool needToUnlock = QOrderedMutexLocker::relock(signalSlotMutex, m);
+
+                        if (c->receiver.load()) {
+                            *c->prev = c->next;
+                            if (c->next) c->next->prev = c->prev;
+                        }
+                        c->receiver.store(0);
+                        if (needToUnlock)
+                            m->unlock();
                     }
 
-                    QMutex *m = signalSlotLock(c->receiver);
-                    bool needToUnlock = QOrderedMutexLocker::relock(signalSlotMutex, m);
-
-                    if (c->receiver) {
-                        *c->prev = c->next;
-                        if (c->next) c->next->prev = c->prev;
-                    }
-                    c->receiver = 0;
-                    if (needToUnlock)
-                        m->unlock();
+                    connectionList.first.store(c->nextConnectionList.load());
 
-                    connectionList.first = c->nextConnectionList;
-
-                    // The destroy operation must happen outside the lock
+                    // The destroy operation must happen outside the lock.
+                    // This also destroys the slot objects of the connections
+                    // disconnected during an activation.
                     if (c->isSlotObject) {
                         c->isSlotObject = false;
                         locker.unlock();
@@ -871,12 +1300,13 @@ QObject::~QObject()
                 }
             }
 
-            if (!--d->connectionLists->inUse) {
-                delete d->connectionLists;
+            if (!connectionLists->inUse.deref() && !connectionLists->activations.load()) {
+                // deleted below, without the lock
+                deadConnectionLists = connectionLists;
             } else {
-                d->connectionLists->orphaned = true;
+                connectionLists->orphaned.storeRelease(1);
             }
-            d->connectionLists = 0;
+            d->connectionLists.store(0);
         }
 
         /* Disconnect all senders:
@@ -905,13 +1335,15 @@ QObject::~QObject()
                 m->unlock();
                 continue;
             }
-            node->receiver = 0;
-            QObjectConnectionListVector *senderLists = sender->d_func()->connectionLists;
+            node->receiver.store(0);
+            QObjectConnectionListVector *senderLists = sender->d_func()->connectionLists.load();
             if (senderLists)
-                senderLists->dirty = true;
+                senderLists->setDirty();
 
+            // an activation of the sender may be about to call the slot
+            // object; it is destroyed with the connection then
             QtPrivate::QSlotObjectBase *slotObj = Q_NULLPTR;
-            if (node->isSlotObject) {
+            if (node->isSlotObject && !(senderLists && senderLists->isActivating())) {
                 slotObj = node->slotObj;
                 node->isSlotObject = false;
             }
@@ -929,6 +1361,7 @@ QObject::~QObject()
             }
         }
     }
+    delete deadConnectionLists;
 
     if (!d->children.isEmpty())
         d->deleteChildren();
@@ -941,6 +1374,7 @@ QObject::~QObject()
 
 QObjectPrivate::Connection::~Connection()
 {
+    delete coalescedCall.load();
     if (ownArgumentTypes) {
         const int *v = argumentTypes.load();
         if (v != &DIRECT_CONNECTION_ONLY)
@@ -1142,9 +1576,45 @@ bool QObject::event(QEvent *e)
         {
             QMetaCallEvent *mce = static_cast<QMetaCallEvent*>(e);
 
-            QConnectionSenderSwitcher sw(this, const_cast<QObject*>(mce->sender()), mce->signalId());
+            if (!mce->nextCall()) {
+                QConnectionSenderSwitcher sw(this, const_cast<QObject*>(mce->sender()), mce->signalId());
+
+                mce->placeMetaCall(this);
+                break;
+            }
 
-            mce->placeMetaCall(this);
+            // Consecutive queued calls, batched by QPostEventList::drainInbox().
+            // Stop if one of them deletes this object, if the remaining ones
+            // are removed with QCoreApplication::removePostedEvents(), or if
+            // moveToThread() moves them to another thread along with this object.
+            QPointer<QObject> guard(this);
+            QThreadData *threadData = d_func()->threadData;
+            QMetaCallBatch batch;
+            batch.receiver = this;
+            batch.event = mce;
+            {
+                QMutexLocker locker(&threadData->postEventList.mutex);
+                batch.outer = threadData->postEventList.batches;
+                threadData->postEventList.batches = &batch;
+            }
+            for (QMetaCallEvent *call = mce; call; call = call->nextCall()) {
+                batch.current = call;
+                {
+                    QConnectionSenderSwitcher sw(this, const_cast<QObject*>(call->sender()), call->signalId());
+                    call->placeMetaCall(this);
+                }
+                if (!guard || batch.cancelled.load() || d_func()->threadData != threadData)
+                    break;
+            }
+            {
+                QMutexLocker locker(&threadData->postEventList.mutex);
+                QMetaCallBatch **link = &threadData->postEventList.batches;
+                while (*link != &batch)
+                    link = &(*link)->outer;
+                *link = batch.outer;
+            }
+            if (!guard)
+                return true;
             break;
         }
 
@@ -1395,10 +1865,25 @@ void QObject::moveToThread(QThread *targetThread)
     currentData->ref();
 
     // move the object
+    currentData->postEventList.drainInbox();
     d_func()->setThreadData_helper(currentData, targetData);
 
+    // Events may have been posted without the lock by threads that saw the
+    // old thread data; wait for them and send what they posted after their
+    // receivers.
+    while (currentData->postEventList.producers.fetchAndAddOrdered(0))
+        QThread::yieldCurrentThread();
+    if (currentData->postEventList.drainInbox() && targetData->eventDispatcher.load()) {
+        targetData->canWait = false;
+        targetData->eventDispatcher.load()->wakeUp();
+    }
+
     locker.unlock();
 
+    // let emitting threads know where the receivers live now; this takes the
+    // signalSlotLock(), so it must happen without the post event list locked
+    d_func()->setReceiverThreadData_helper();
+
     // now currentData can commit suicide if it wants to
     currentData->deref();
 }
@@ -1418,8 +1903,12 @@ void QObjectPrivate::setThreadData_helper(QThreadData *currentData, QThreadData
 {
     Q_Q(QObject);
 
+    // move the queued calls of a batch being delivered first; they were
+    // posted before any event that is still in the list
+    int eventsMoved = currentData->postEventList.moveBatchedCalls(q, &targetData->postEventList);
+    postedEvents += eventsMoved;
+
     // move posted events
-    int eventsMoved = 0;
     for (int i = 0; i < currentData->postEventList.size(); ++i) {
         const QPostEvent &pe = currentData->postEventList.at(i);
         if (!pe.event)
@@ -1452,6 +1941,21 @@ void QObjectPrivate::setThreadData_helper(QThreadData *currentData, QThreadData
     }
 }
 
+void QObjectPrivate::setReceiverThreadData_helper()
+{
+    Q_Q(QObject);
+    {
+        QMutexLocker locker(signalSlotLock(q));
+        for (Connection *c = senders; c; c = c->next)
+            c->receiverThreadData.store(threadData);
+    }
+
+    for (int i = 0; i < children.size(); ++i) {
+        QObject *child = children.at(i);
+        child->d_func()->setReceiverThreadData_helper();
+    }
+}
+
 void QObjectPrivate::_q_reregisterTimers(void *pointer)
 {
     Q_Q(QObject);
@@ -2292,13 +2796,13 @@ int QObject::receivers(const char *signal) const
         }
 
         QMutexLocker locker(signalSlotLock(this));
-        if (d->connectionLists) {
-            if (signal_index < d->connectionLists->count()) {
+        if (QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+            if (signal_index < connectionLists->count()) {
                 const QObjectPrivate::Connection *c =
-                    d->connectionLists->at(signal_index).first;
+                    connectionLists->at(signal_index).first.load();
                 while (c) {
-                    receivers += c->receiver ? 1 : 0;
-                    c = c->nextConnectionList;
+                    receivers += c->receiver.load() ? 1 : 0;
+                    c = c->nextConnectionList.load();
                 }
             }
         }
@@ -2343,14 +2847,14 @@ bool QObject::isSignalConnected(const QMetaMethod &signal) const
         return d->isSignalConnected(signalIndex);
 
     QMutexLocker locker(signalSlotLock(this));
-    if (d->connectionLists) {
-        if (signalIndex < uint(d->connectionLists->count())) {
+    if (QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+        if (signalIndex < uint(connectionLists->count())) {
             const QObjectPrivate::Connection *c =
-                d->connectionLists->at(signalIndex).first;
+                connectionLists->at(signalIndex).first.load();
             while (c) {
-                if (c->receiver)
+                if (c->receiver.load())
                     return true;
-                c = c->nextConnectionList;
+                c = c->nextConnectionList.load();
             }
         }
     }
@@ -2596,7 +3100,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const char *sign
     }
 
     int *types = 0;
-    if ((type == Qt::QueuedConnection)
+    if ((type == Qt::QueuedConnection || type == Qt::QueuedCoalescedConnection)
             && !(types = queuedConnectionTypes(signalTypes.constData(), signalTypes.size()))) {
         return QMetaObject::Connection(0);
     }
@@ -2679,7 +3183,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const QMetaMetho
     }
 
     int *types = 0;
-    if ((type == Qt::QueuedConnection)
+    if ((type == Qt::QueuedConnection || type == Qt::QueuedCoalescedConnection)
             && !(types = queuedConnectionTypes(signal.parameterTypes())))
         return QMetaObject::Connection(0);
 
@@ -3122,17 +3626,17 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
                                signalSlotLock(receiver));
 
     if (type & Qt::UniqueConnection) {
-        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists;
+        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists.load();
         if (connectionLists && connectionLists->count() > signal_index) {
             const QObjectPrivate::Connection *c2 =
-                (*connectionLists)[signal_index].first;
+                (*connectionLists)[signal_index].first.load();
 
             int method_index_absolute = method_index + method_offset;
 
             while (c2) {
-                if (c2->receiver == receiver && c2->method() == method_index_absolute)
+                if (c2->receiver.load() == receiver && c2->method() == method_index_absolute)
                     return 0;
-                c2 = c2->nextConnectionList;
+                c2 = c2->nextConnectionList.load();
             }
         }
         type &= Qt::UniqueConnection - 1;
@@ -3141,13 +3645,13 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     QScopedPointer<QObjectPrivate::Connection> c(new QObjectPrivate::Connection);
     c->sender = s;
     c->signal_index = signal_index;
-    c->receiver = r;
+    c->receiver.store(r);
     c->method_relative = method_index;
     c->method_offset = method_offset;
     c->connectionType = type;
     c->isSlotObject = false;
     c->argumentTypes.store(types);
-    c->nextConnectionList = 0;
+    c->nextConnectionList.store(0);
     c->callFunction = callFunction;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.data());
@@ -3199,18 +3703,15 @@ bool QMetaObjectPrivate::disconnectHelper(QObjectPrivate::Connection *c,
 {
     bool success = false;
     while (c) {
-        if (c->receiver
-            && (receiver == 0 || (c->receiver == receiver
+        QObject *r = c->receiver.load();
+        if (r
+            && (receiver == 0 || (r == receiver
                            && (method_index < 0 || c->method() == method_index)
                            && (slot == 0 || (c->isSlotObject && c->slotObj->compare(slot)))))) {
-            bool needToUnlock = false;
-            QMutex *receiverMutex = 0;
-            if (c->receiver) {
-                receiverMutex = signalSlotLock(c->receiver);
-                // need to relock this receiver and sender in the correct order
-                needToUnlock = QOrderedMutexLocker::relock(senderMutex, receiverMutex);
-            }
-            if (c->receiver) {
+            QMutex *receiverMutex = signalSlotLock(r);
+            // need to relock this receiver and sender in the correct order
+            bool needToUnlock = QOrderedMutexLocker::relock(senderMutex, receiverMutex);
+            if (c->receiver.load()) {
                 *c->prev = c->next;
                 if (c->next)
                     c->next->prev = c->prev;
@@ -3219,9 +3720,13 @@ bool QMetaObjectPrivate::disconnectHelper(QObjectPrivate::Connection *c,
             if (needToUnlock)
                 receiverMutex->unlock();
 
-            c->receiver = 0;
+            c->receiver.store(0);
+            QObjectConnectionListVector *connectionLists = QObjectPrivate::get(c->sender)->connectionLists.load();
+            connectionLists->setDirty();
 
-            if (c->isSlotObject) {
+            // an activation may be about to call the slot object; it is
+            // destroyed with the connection then
+            if (c->isSlotObject && !connectionLists->isActivating()) {
                 c->isSlotObject = false;
                 senderMutex->unlock();
                 c->slotObj->destroyIfLastRef();
@@ -3233,7 +3738,7 @@ bool QMetaObjectPrivate::disconnectHelper(QObjectPrivate::Connection *c,
             if (disconnectType == DisconnectOne)
                 return success;
         }
-        c = c->nextConnectionList;
+        c = c->nextConnectionList.load();
     }
     return success;
 }
@@ -3255,39 +3760,45 @@ bool QMetaObjectPrivate::disconnect(const QObject *sender,
     QMutex *senderMutex = signalSlotLock(sender);
     QMutexLocker locker(senderMutex);
 
-    QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists;
+    QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists.load();
     if (!connectionLists)
         return false;
 
     // prevent incoming connections changing the connectionLists while unlocked
-    ++connectionLists->inUse;
+    connectionLists->inUse.ref();
 
     bool success = false;
     if (signal_index < 0) {
         // remove from all connection lists
         for (int sig_index = -1; sig_index < connectionLists->count(); ++sig_index) {
             QObjectPrivate::Connection *c =
-                (*connectionLists)[sig_index].first;
-            if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType)) {
+                (*connectionLists)[sig_index].first.load();
+            if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType))
                 success = true;
-                connectionLists->dirty = true;
-            }
         }
     } else if (signal_index < connectionLists->count()) {
         QObjectPrivate::Connection *c =
-            (*connectionLists)[signal_index].first;
-        if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType)) {
+            (*connectionLists)[signal_index].first.load();
+        if (disconnectHelper(c, receiver, method_index, slot, senderMutex, disconnectType))
             success = true;
-            connectionLists->dirty = true;
-        }
     }
 
-    --connectionLists->inUse;
-    Q_ASSERT(connectionLists->inUse >= 0);
-    if (connectionLists->orphaned && !connectionLists->inUse)
-        delete connectionLists;
+    const bool inUse = connectionLists->inUse.deref();
+    Q_ASSERT(connectionLists->inUse.load() >= 0);
+    QObjectConnectionListVector::SlotObjectList slotObjects;
+    bool deleteConnectionLists = false;
+    if (connectionLists->orphaned.load()) {
+        deleteConnectionLists = !inUse && !connectionLists->activations.load();
+    } else if (!inUse) {
+        QObjectPrivate::get(s)->cleanConnectionLists();
+        connectionLists->deleteOrphans(&slotObjects);
+    }
 
     locker.unlock();
+    if (deleteConnectionLists)
+        delete connectionLists;
+    for (int i = 0; i < slotObjects.size(); ++i)
+        slotObjects.at(i)->destroyIfLastRef();
     if (success) {
         QMetaMethod smethod = QMetaObjectPrivate::signal(smeta, signal_index);
         if (smethod.isValid())
@@ -3403,8 +3914,11 @@ void QMetaObject::connectSlotsByName(QObject *o)
     \internal
 
     \a signal must be in the signal index range (see QObjectPrivate::signalIndex()).
+    The caller keeps \a receiver alive, either because it lives in the current
+    thread or by holding its signalSlotLock().
 */
-static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connection *c, void **argv)
+static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connection *c, void **argv,
+                            QObject *receiver)
 {
     const int *argumentTypes = c->argumentTypes.load();
     if (!argumentTypes && argumentTypes != &DIRECT_CONNECTION_ONLY) {
@@ -3423,18 +3937,26 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     int nargs = 1; // include return type
     while (argumentTypes[nargs-1])
         ++nargs;
-    int *types = (int *) malloc(nargs*sizeof(int));
-    Q_CHECK_PTR(types);
-    void **args = (void **) malloc(nargs*sizeof(void *));
-    Q_CHECK_PTR(args);
-    types[0] = 0; // return type
-    args[0] = 0; // return value
-    for (int n = 1; n < nargs; ++n)
-        args[n] = QMetaType::create((types[n] = argumentTypes[n-1]), argv[n]);
     QMetaCallEvent *ev = c->isSlotObject ?
-        new QMetaCallEvent(c->slotObj, sender, signal, nargs, types, args) :
-        new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal, nargs, types, args);
-    QCoreApplication::postEvent(c->receiver, ev);
+        new QMetaCallEvent(c->slotObj, sender, signal) :
+        new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal);
+    ev->allocateArguments(nargs);
+    for (int n = 1; n < nargs; ++n)
+        ev->constructArgument(n, argumentTypes[n-1], argv[n]);
+
+    if (c->connectionType == Qt::QueuedCoalescedConnection) {
+        // Only the latest call is kept in the connection. The first one
+        // since the last delivery posts an event that picks it up.
+        if (QMetaCallEvent *previous = c->coalescedCall.fetchAndStoreOrdered(ev)) {
+            delete previous;
+            return;
+        }
+        ev = c->isSlotObject ?
+            new QMetaCallEvent(c->slotObj, sender, signal) :
+            new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal);
+        ev->setCoalescedConnection(c);
+    }
+    QCoreApplication::postEvent(receiver, ev);
 }
 
 /*!
@@ -3473,68 +3995,86 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
     }
 
     Qt::HANDLE currentThreadId = QThread::currentThreadId();
+    QThreadData * const currentThreadData = QThreadData::current(false);
 
     {
-    QMutexLocker locker(signalSlotLock(sender));
+    // The lists are walked without locking the sender; see
+    // QObjectConnectionListVector for how they are kept valid meanwhile.
     struct ConnectionListsRef {
+        QObject *sender;
         QObjectConnectionListVector *connectionLists;
-        ConnectionListsRef(QObjectConnectionListVector *connectionLists) : connectionLists(connectionLists)
+        ConnectionListsRef(QObject *sender)
+            : sender(sender), connectionLists(sender->d_func()->connectionLists.loadAcquire())
         {
             if (connectionLists)
-                ++connectionLists->inUse;
+                connectionLists->activations.ref();
         }
         ~ConnectionListsRef()
         {
-            if (!connectionLists)
+            if (!connectionLists || connectionLists->activations.deref())
                 return;
 
-            --connectionLists->inUse;
-            Q_ASSERT(connectionLists->inUse >= 0);
-            if (connectionLists->orphaned) {
-                if (!connectionLists->inUse)
+            if (connectionLists->orphaned.loadAcquire()) {
+                // the sender has been deleted by a slot
+                if (!connectionLists->inUse.loadAcquire())
                     delete connectionLists;
+            } else if (connectionLists->cleanupPending.load()) {
+                deleteDisconnectedConnections(sender);
             }
         }
 
         QObjectConnectionListVector *operator->() const { return connectionLists; }
     };
-    ConnectionListsRef connectionLists = sender->d_func()->connectionLists;
+    ConnectionListsRef connectionLists(sender);
     if (!connectionLists.connectionLists) {
-        locker.unlock();
         if (qt_signal_spy_callback_set.signal_end_callback != 0)
             qt_signal_spy_callback_set.signal_end_callback(sender, signal_index);
         return;
     }
 
+    // Connections made during the signal emission are not emitted in this
+    // emission.
+    const uint lastConnectionId = uint(connectionLists->currentConnectionId.load());
+    QObjectConnectionListVector::ListArray *lists = connectionLists->lists.loadAcquire();
+
     const QObjectPrivate::ConnectionList *list;
-    if (signal_index < connectionLists->count())
-        list = &connectionLists->at(signal_index);
+    if (lists && signal_index < lists->count)
+        list = &lists->lists[signal_index];
     else
         list = &connectionLists->allsignals;
 
     do {
-        QObjectPrivate::Connection *c = list->first;
-        if (!c) continue;
-        // We need to check against last here to ensure that signals added
-        // during the signal emission are not emitted in this emission.
-        QObjectPrivate::Connection *last = list->last;
+        QObjectPrivate::Connection *c = list->first.loadAcquire();
+        if (!c || connectionLists->isNewConnection(c, lastConnectionId)) continue;
 
         do {
-            if (!c->receiver)
+            QObject * const receiver = c->receiver.load();
+            if (!receiver)
                 continue;
 
-            QObject * const receiver = c->receiver;
-            const bool receiverInSameThread = currentThreadId == receiver->d_func()->threadData->threadId;
+            // A receiver living in this thread can neither be deleted nor
+            // moved to another thread while we are here, and a direct call
+            // from another thread needs the receiver to outlive it anyway.
+            // Any other receiver is kept alive by holding its signalSlotLock()
+            // until the call is queued.
+            bool receiverInSameThread = currentThreadData && c->receiverThreadData.load() == currentThreadData;
+            const bool lockReceiver = !receiverInSameThread && c->connectionType != Qt::DirectConnection;
+            QMutexLocker locker(lockReceiver ? signalSlotLock(receiver) : 0);
+            if (lockReceiver) {
+                if (c->receiver.load() != receiver)
+                    continue; // disconnected meanwhile
+                receiverInSameThread = currentThreadId == receiver->d_func()->threadData->threadId;
+            }
 
             // determine if this connection should be sent immediately or
             // put into the event queue
             if ((c->connectionType == Qt::AutoConnection && !receiverInSameThread)
-                || (c->connectionType == Qt::QueuedConnection)) {
-                queued_activate(sender, signal_index, c, argv ? argv : empty_argv);
+                || (c->connectionType == Qt::QueuedConnection)
+                || (c->connectionType == Qt::QueuedCoalescedConnection)) {
+                queued_activate(sender, signal_index, c, argv ? argv : empty_argv, receiver);
                 continue;
 #ifndef QT_NO_THREAD
             } else if (c->connectionType == Qt::BlockingQueuedConnection) {
-                locker.unlock();
                 if (receiverInSameThread) {
                     qWarning("Qt: Dead lock detected while activating a BlockingQueuedConnection: "
                     "Sender is %s(%p), receiver is %s(%p)",
@@ -3546,8 +4086,8 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                     new QMetaCallEvent(c->slotObj, sender, signal_index, 0, 0, argv ? argv : empty_argv, &semaphore) :
                     new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal_index, 0, 0, argv ? argv : empty_argv, &semaphore);
                 QCoreApplication::postEvent(receiver, ev);
+                locker.unlock();
                 semaphore.acquire();
-                locker.relock();
                 continue;
 #endif
             }
@@ -3564,13 +4104,6 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                 QScopedPointer<QtPrivate::QSlotObjectBase, QSlotObjectBaseDeleter> obj(c->slotObj);
                 locker.unlock();
                 obj->call(receiver, argv ? argv : empty_argv);
-
-                // Make sure the slot object gets destroyed before the mutex is locked again, as the
-                // destructor of the slot object might also lock a mutex from the signalSlotLock() mutex pool,
-                // and that would deadlock if the pool happens to return the same mutex.
-                obj.reset();
-
-                locker.relock();
             } else if (callFunction && c->method_offset <= receiver->metaObject()->methodOffset()) {
                 //we compare the vtable to make sure we are not in the destructor of the object.
                 locker.unlock();
@@ -3581,7 +4114,6 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
 
                 if (qt_signal_spy_callback_set.slot_end_callback != 0)
                     qt_signal_spy_callback_set.slot_end_callback(receiver, c->method());
-                locker.relock();
             } else {
                 const int method = method_relative + c->method_offset;
                 locker.unlock();
@@ -3596,15 +4128,13 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
 
                 if (qt_signal_spy_callback_set.slot_end_callback != 0)
                     qt_signal_spy_callback_set.slot_end_callback(receiver, method);
-
-                locker.relock();
             }
 
-            if (connectionLists->orphaned)
+            if (connectionLists->orphaned.load())
                 break;
-        } while (c != last && (c = c->nextConnectionList) != 0);
+        } while ((c = c->nextConnectionList.loadAcquire()) != 0 && !connectionLists->isNewConnection(c, lastConnectionId));
 
-        if (connectionLists->orphaned)
+        if (connectionLists->orphaned.load())
             break;
     } while (list != &connectionLists->allsignals &&
         //start over for all signals;
@@ -3873,27 +4403,28 @@ void QObject::dumpObjectInfo()
     // first, look for connections where this object is the sender
     qDebug("  SIGNALS OUT");
 
-    if (d->connectionLists) {
-        for (int signal_index = 0; signal_index < d->connectionLists->count(); ++signal_index) {
+    if (QObjectConnectionListVector *connectionLists = d->connectionLists.load()) {
+        for (int signal_index = 0; signal_index < connectionLists->count(); ++signal_index) {
             const QMetaMethod signal = QMetaObjectPrivate::signal(metaObject(), signal_index);
             qDebug("        signal: %s", signal.methodSignature().constData());
 
             // receivers
             const QObjectPrivate::Connection *c =
-                d->connectionLists->at(signal_index).first;
+                connectionLists->at(signal_index).first.load();
             while (c) {
-                if (!c->receiver) {
+                QObject *receiver = c->receiver.load();
+                if (!receiver) {
                     qDebug("          <Disconnected receiver>");
-                    c = c->nextConnectionList;
+                    c = c->nextConnectionList.load();
                     continue;
                 }
-                const QMetaObject *receiverMetaObject = c->receiver->metaObject();
+                const QMetaObject *receiverMetaObject = receiver->metaObject();
                 const QMetaMethod method = receiverMetaObject->method(c->method());
                 qDebug("          --> %s::%s %s",
                        receiverMetaObject->className(),
-                       c->receiver->objectName().isEmpty() ? "unnamed" : qPrintable(c->receiver->objectName()),
+                       receiver->objectName().isEmpty() ? "unnamed" : qPrintable(receiver->objectName()),
                        method.methodSignature().constData());
-                c = c->nextConnectionList;
+                c = c->nextConnectionList.load();
             }
         }
     } else {
@@ -4467,17 +4998,17 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
                                signalSlotLock(receiver));
 
     if (type & Qt::UniqueConnection) {
-        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists;
+        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(s)->connectionLists.load();
         if (connectionLists && connectionLists->count() > signal_index) {
             const QObjectPrivate::Connection *c2 =
-                (*connectionLists)[signal_index].first;
+                (*connectionLists)[signal_index].first.load();
 
             while (c2) {
-                if (c2->receiver == receiver && c2->isSlotObject && c2->slotObj->compare(slot)) {
+                if (c2->receiver.load() == receiver && c2->isSlotObject && c2->slotObj->compare(slot)) {
                     slotObj->destroyIfLastRef();
                     return QMetaObject::Connection();
                 }
-                c2 = c2->nextConnectionList;
+                c2 = c2->nextConnectionList.load();
             }
         }
         type = static_cast<Qt::ConnectionType>(type ^ Qt::UniqueConnection);
@@ -4486,7 +5017,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     QScopedPointer<QObjectPrivate::Connection> c(new QObjectPrivate::Connection);
     c->sender = s;
     c->signal_index = signal_index;
-    c->receiver = r;
+    c->receiver.store(r);
     c->slotObj = slotObj;
     c->connectionType = type;
     c->isSlotObject = true;
@@ -4518,30 +5049,36 @@ bool QObject::disconnect(const QMetaObject::Connection &connection)
 {
     QObjectPrivate::Connection *c = static_cast<QObjectPrivate::Connection *>(connection.d_ptr);
 
-    if (!c || !c->receiver)
+    if (!c || !c->receiver.load())
         return false;
 
     QMutex *senderMutex = signalSlotLock(c->sender);
-    QMutex *receiverMutex = signalSlotLock(c->receiver);
+    QMutex *receiverMutex = signalSlotLock(c->receiver.load());
 
+    QtPrivate::QSlotObjectBase *slotObj = Q_NULLPTR;
     {
         QOrderedMutexLocker locker(senderMutex, receiverMutex);
 
-        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(c->sender)->connectionLists;
+        QObjectConnectionListVector *connectionLists = QObjectPrivate::get(c->sender)->connectionLists.load();
         Q_ASSERT(connectionLists);
-        connectionLists->dirty = true;
+        connectionLists->setDirty();
 
         *c->prev = c->next;
         if (c->next)
             c->next->prev = c->prev;
-        c->receiver = 0;
+        c->receiver.store(0);
+
+        // an activation may be about to call the slot object; it is
+        // destroyed with the connection then
+        if (c->isSlotObject && !connectionLists->isActivating()) {
+            slotObj = c->slotObj;
+            c->isSlotObject = false;
+        }
     }
 
     // destroy the QSlotObject, if possible
-    if (c->isSlotObject) {
-        c->slotObj->destroyIfLastRef();
-        c->isSlotObject = false;
-    }
+    if (slotObj)
+        slotObj->destroyIfLastRef();
 
     const_cast<QMetaObject::Connection &>(connection).d_ptr = 0;
     c->deref(); // has been removed from the QMetaObject::Connection object
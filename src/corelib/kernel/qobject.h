@@ -231,7 +231,7 @@ public:
                           "Return type of the slot is not compatible with the return type of the signal.");
 
         const int *types = 0;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection || type == Qt::QueuedCoalescedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal),
@@ -271,7 +271,7 @@ public:
                           "Return type of the slot is not compatible with the return type of the signal.");
 
         const int *types = 0;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection || type == Qt::QueuedCoalescedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal), context, 0,
@@ -341,7 +341,7 @@ public:
                           "No Q_OBJECT in the class with the signal");
 
         const int *types = 0;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection || type == Qt::QueuedCoalescedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal), context, 0,
@@ -68,6 +68,7 @@ QT_BEGIN_NAMESPACE
 class QVariant;
 class QThreadData;
 class QObjectConnectionListVector;
+class QMetaCallEvent;
 namespace QtSharedPointer { struct ExternalRefCountData; }
 
 /* for Qt Test */
@@ -124,28 +125,42 @@ public:
     };
 
     typedef void (*StaticMetaCallFunction)(QObject *, QMetaObject::Call, int, void **);
+    // QMetaObject::activate() reads the connection lists without locking:
+    // receiver, receiverThreadData and the list pointers are atomic, and a
+    // connection is deleted only once no activation can reach it (see
+    // QObjectConnectionListVector).
     struct Connection
     {
         QObject *sender;
-        QObject *receiver;
+        QAtomicPointer<QObject> receiver;
+        // thread data of the receiver, tells activate() whether the receiver
+        // lives in the emitting thread without touching the receiver
+        QAtomicPointer<QThreadData> receiverThreadData;
         union {
             StaticMetaCallFunction callFunction;
             QtPrivate::QSlotObjectBase *slotObj;
         };
         // The next pointer for the singly-linked ConnectionList
-        Connection *nextConnectionList;
+        QAtomicPointer<Connection> nextConnectionList;
         //senders linked list
         Connection *next;
         Connection **prev;
+        // next connection waiting to be deleted after it has been removed from the list
+        Connection *nextOrphan;
         QAtomicPointer<const int> argumentTypes;
         QAtomicInt ref_;
+        // latest call of a Qt::QueuedCoalescedConnection that is not delivered yet
+        QAtomicPointer<QMetaCallEvent> coalescedCall;
+        // increasing in the order of connection and wrapping around, see
+        // QObjectConnectionListVector::currentConnectionId
+        uint id;
         ushort method_offset;
         ushort method_relative;
         uint signal_index : 27; // In signal range (see QObjectPrivate::signalIndex())
-        ushort connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 4 == blocking
+        ushort connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 3 == blocking, 4 == queued coalesced
         ushort isSlotObject : 1;
         ushort ownArgumentTypes : 1;
-        Connection() : nextConnectionList(0), ref_(2), ownArgumentTypes(true) {
+        Connection() : nextConnectionList(0), nextOrphan(0), ref_(2), id(0), ownArgumentTypes(true) {
             //ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
         }
         ~Connection();
@@ -153,7 +168,7 @@ public:
         void ref() { ref_.ref(); }
         void deref() {
             if (!ref_.deref()) {
-                Q_ASSERT(!receiver);
+                Q_ASSERT(!receiver.load());
                 delete this;
             }
         }
@@ -161,8 +176,8 @@ public:
     // ConnectionList is a singly-linked list
     struct ConnectionList {
         ConnectionList() : first(0), last(0) {}
-        Connection *first;
-        Connection *last;
+        QAtomicPointer<Connection> first;
+        Connection *last; // only accessed with the signalSlotLock() held
     };
 
     struct Sender
@@ -180,6 +195,7 @@ public:
     void setParent_helper(QObject *);
     void moveToThread_helper();
     void setThreadData_helper(QThreadData *currentData, QThreadData *targetData);
+    void setReceiverThreadData_helper();
     void _q_reregisterTimers(void *pointer);
 
     bool isSender(const QObject *receiver, const char *signal) const;
@@ -227,7 +243,7 @@ public:
     ExtraData *extraData;    // extra data set by the user
     QThreadData *threadData; // id of the thread that owns the object
 
-    QObjectConnectionListVector *connectionLists;
+    QAtomicPointer<QObjectConnectionListVector> connectionLists;
 
     Connection *senders;     // linked list of connections connected to this object
     Sender *currentSender;   // object currently activating the object
@@ -385,7 +401,33 @@ public:
 
     virtual void placeMetaCall(QObject *object);
 
+    // Argument storage owned by the event: the arrays for up to
+    // PreallocatedArguments arguments and small argument values live inside
+    // the event itself, so that most queued calls need a single allocation.
+    void allocateArguments(int nargs);
+    void constructArgument(int index, int type, const void *copy);
+
+    // Queued calls to the same receiver that are delivered together with
+    // this one, see QPostEventList::drainInbox().
+    inline QMetaCallEvent *nextCall() const { return nextCall_; }
+    inline bool canBatch() const { return !semaphore_; }
+    void appendCall(QMetaCallEvent *call);
+    QMetaCallEvent *takeCallsAfter(QMetaCallEvent *call);
+
+    void setCoalescedConnection(QObjectPrivate::Connection *connection);
+
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
+
 private:
+    enum {
+        PreallocatedArguments = 4,
+        InlineStorageSlots = 4
+    };
+
+    inline bool isInlineArgument(const void *arg) const
+    { return arg >= static_cast<const void *>(storage_) && arg < static_cast<const void *>(storage_ + InlineStorageSlots); }
+
     QtPrivate::QSlotObjectBase *slotObj_;
     const QObject *sender_;
     int signalId_;
@@ -394,8 +436,20 @@ private:
     void **args_;
     QSemaphore *semaphore_;
     QObjectPrivate::StaticMetaCallFunction callFunction_;
+    QMetaCallEvent *nextCall_;
+    QMetaCallEvent *lastCall_;
+    QObjectPrivate::Connection *coalescedConnection_;
     ushort method_offset_;
     ushort method_relative_;
+    ushort ownsArguments_ : 1;
+    ushort storageUsed_ : 15;
+    int preallocatedTypes_[PreallocatedArguments];
+    void *preallocatedArgs_[PreallocatedArguments];
+    union {
+        void *p;
+        double d;
+        qint64 i;
+    } storage_[InlineStorageSlots];
 };
 
 class QBoolBlocker
@@ -52,6 +52,8 @@
 #  include <QThread>
 #endif
 
+#include <qvarlengtharray.h>
+
 #include <sys/times.h>
 
 QT_BEGIN_NAMESPACE
@@ -60,10 +62,13 @@ Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
 
 /*
  * Internal functions for manipulating timer data structures.  The
- * timerBitVec array is used for keeping track of timer identifiers.
+ * timers are kept in a binary min-heap stored in the list itself, so
+ * registering, unregistering and rescheduling a timer are O(log n)
+ * instead of a linear search through a sorted list.
  */
 
 QTimerInfoList::QTimerInfoList()
+    : nextSequence(0)
 {
 #if (_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC) && !defined(Q_OS_NACL)
     if (!QElapsedTimer::isMonotonic()) {
@@ -176,17 +181,99 @@ void QTimerInfoList::repairTimersIfNeeded()
 #endif
 
 /*
-  insert timer info into list
+  Timers expiring at the same time fire in the order they were
+  (re)inserted, like they did when the timers were a sorted list.
 */
-void QTimerInfoList::timerInsert(QTimerInfo *ti)
+static inline bool timerLessThan(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    if (t1->timeout < t2->timeout)
+        return true;
+    if (t2->timeout < t1->timeout)
+        return false;
+    return t1->sequence < t2->sequence;
+}
+
+inline void QTimerInfoList::heapPlace(int index, QTimerInfo *t)
+{
+    (*this)[index] = t;
+    t->heapIndex = index;
+}
+
+void QTimerInfoList::heapSiftUp(int index)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
+    QTimerInfo *t = at(index);
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        QTimerInfo *p = at(parent);
+        if (!timerLessThan(t, p))
             break;
+        heapPlace(index, p);
+        index = parent;
+    }
+    heapPlace(index, t);
+}
+
+void QTimerInfoList::heapSiftDown(int index)
+{
+    QTimerInfo *t = at(index);
+    const int n = size();
+    forever {
+        int child = 2 * index + 1;
+        if (child >= n)
+            break;
+        if (child + 1 < n && timerLessThan(at(child + 1), at(child)))
+            ++child;
+        QTimerInfo *c = at(child);
+        if (!timerLessThan(c, t))
+            break;
+        heapPlace(index, c);
+        index = child;
+    }
+    heapPlace(index, t);
+}
+
+void QTimerInfoList::heapRemoveAt(int index)
+{
+    QTimerInfo *last = takeLast();
+    if (index == size())
+        return;
+    heapPlace(index, last);
+    if (index > 0 && timerLessThan(last, at((index - 1) / 2)))
+        heapSiftUp(index);
+    else
+        heapSiftDown(index);
+}
+
+/*
+  Returns the number of timers that have expired at \a currentTime.
+*/
+int QTimerInfoList::expiredTimerCount(const timespec &currentTime) const
+{
+    // only the subtrees below an expired timer can hold more expired timers
+    int count = 0;
+    QVarLengthArray<int, 64> stack;
+    if (!isEmpty())
+        stack.append(0);
+    while (!stack.isEmpty()) {
+        int index = stack.last();
+        stack.removeLast();
+        if (currentTime < at(index)->timeout)
+            continue;
+        ++count;
+        for (int child = 2 * index + 1; child <= 2 * index + 2 && child < size(); ++child)
+            stack.append(child);
     }
-    insert(index+1, ti);
+    return count;
+}
+
+/*
+  insert timer info into list
+*/
+void QTimerInfoList::timerInsert(QTimerInfo *ti)
+{
+    ti->sequence = nextSequence++;
+    append(ti);
+    heapSiftUp(size() - 1);
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -378,6 +465,39 @@ static void calculateNextTimeout(QTimerInfo *t, timespec currentTime)
 #endif
 }
 
+/*
+  Returns the absolute time at which the next timer that is not already
+  active expires, or false if no timers are waiting. The time uses the
+  same clock as updateCurrentTime().
+*/
+bool QTimerInfoList::nextTimeout(timespec &tm) const
+{
+    // Timers being activated sit at the top of the heap while their event
+    // is delivered; the first waiting timer is the earliest one that only
+    // has active timers above it.
+    const QTimerInfo *t = 0;
+    QVarLengthArray<int, 16> stack;
+    if (!isEmpty())
+        stack.append(0);
+    while (!stack.isEmpty()) {
+        int index = stack.last();
+        stack.removeLast();
+        const QTimerInfo *candidate = at(index);
+        if (!candidate->activateRef) {
+            if (!t || timerLessThan(candidate, t))
+                t = candidate;
+            continue;
+        }
+        for (int child = 2 * index + 1; child <= 2 * index + 2 && child < size(); ++child)
+            stack.append(child);
+    }
+
+    if (!t)
+        return false;
+    tm = t->timeout;
+    return true;
+}
+
 /*
   Returns the time to wait for the next timer, or null if no timers
   are waiting.
@@ -387,21 +507,13 @@ bool QTimerInfoList::timerWait(timespec &tm)
     timespec currentTime = updateCurrentTime();
     repairTimersIfNeeded();
 
-    // Find first waiting timer not already active
-    QTimerInfo *t = 0;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
-        }
-    }
-
-    if (!t)
+    timespec timeout;
+    if (!nextTimeout(timeout))
       return false;
 
-    if (currentTime < t->timeout) {
+    if (currentTime < timeout) {
         // time to wait
-        tm = roundToMillisecond(t->timeout - currentTime);
+        tm = roundToMillisecond(timeout - currentTime);
     } else {
         // no time to wait
         tm.tv_sec  = 0;
@@ -422,16 +534,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timersById.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -494,6 +603,7 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
     }
 
     timerInsert(t);
+    timersById.insert(timerId, t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -508,41 +618,45 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
     // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t->activateRef)
-                *(t->activateRef) = 0;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t)
+        return false; // id not found
+
+    heapRemoveAt(t->heapIndex);
+    if (t == firstTimerInfo)
+        firstTimerInfo = 0;
+    if (t->activateRef)
+        *(t->activateRef) = 0;
+    delete t;
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
+
+    // compact the remaining timers in place and rebuild the heap once
+    int kept = 0;
     for (int i = 0; i < count(); ++i) {
         QTimerInfo *t = at(i);
         if (t->obj == object) {
             // object found
-            removeAt(i);
+            timersById.remove(t->id);
             if (t == firstTimerInfo)
                 firstTimerInfo = 0;
             if (t->activateRef)
                 *(t->activateRef) = 0;
             delete t;
-            // move back one so that we don't skip the new current item
-            --i;
+        } else {
+            heapPlace(kept++, t);
         }
     }
+    if (kept != count()) {
+        erase(begin() + kept, end());
+        for (int i = kept / 2 - 1; i >= 0; --i)
+            heapSiftDown(i);
+    }
     return true;
 }
 
@@ -579,11 +693,7 @@ int QTimerInfoList::activateTimers()
 
 
     // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
-    }
+    maxCount = expiredTimerCount(currentTime);
 
     //fire the timers.
     while (maxCount--) {
@@ -604,9 +714,6 @@ int QTimerInfoList::activateTimers()
             firstTimerInfo = currentTimerInfo;
         }
 
-        // remove from list
-        removeFirst();
-
 #ifdef QTIMERINFO_DEBUG
         float diff;
         if (currentTime < currentTimerInfo->expected) {
@@ -630,8 +737,10 @@ int QTimerInfoList::activateTimers()
         // determine next timeout time
         calculateNextTimeout(currentTimerInfo, currentTime);
 
-        // reinsert timer
-        timerInsert(currentTimerInfo);
+        // reinsert timer; its timeout only moved forward, so it can only
+        // sink from the top of the heap
+        currentTimerInfo->sequence = nextSequence++;
+        heapSiftDown(0);
         if (currentTimerInfo->interval > 0)
             n_act++;
 
@@ -56,6 +56,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -69,6 +70,8 @@ struct QTimerInfo {
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    int heapIndex;    // - position in QTimerInfoList
+    quint64 sequence; // - insertion order, breaks ties between equal timeouts
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -92,6 +95,17 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    // The list is kept as a binary min-heap ordered by (timeout, sequence),
+    // so first() is always the timer that expires next.
+    QHash<int, QTimerInfo *> timersById;
+    quint64 nextSequence;
+
+    void heapPlace(int index, QTimerInfo *t);
+    void heapSiftUp(int index);
+    void heapSiftDown(int index);
+    void heapRemoveAt(int index);
+    int expiredTimerCount(const timespec &currentTime) const;
+
 public:
     QTimerInfoList();
 
@@ -102,6 +116,7 @@ public:
     void repairTimersIfNeeded();
 
     bool timerWait(timespec &);
+    bool nextTimeout(timespec &) const;
     void timerInsert(QTimerInfo *);
 
     int timerRemainingTime(int timerId);
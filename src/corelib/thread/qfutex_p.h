@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QFUTEX_P_H
+#define QFUTEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the implementation.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qmutex_p.h"
+
+#ifdef QT_LINUX_FUTEX
+
+#include <QtCore/qatomic.h>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+
+#ifndef FUTEX_PRIVATE_FLAG
+#  define FUTEX_PRIVATE_FLAG 0
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QtLinuxFutex {
+
+inline int _q_futex(QBasicAtomicInt *futex, int op, int val, const struct timespec *timeout = 0) Q_DECL_NOTHROW
+{
+    // we use __NR_futex because some libcs (like Android's bionic) don't
+    // provide SYS_futex etc.
+    return syscall(__NR_futex, reinterpret_cast<int *>(futex), op | FUTEX_PRIVATE_FLAG,
+                   val, timeout, 0, 0);
+}
+
+// Sleeps until woken up, unless \a futex does not hold \a expectedValue any
+// more. Returns false if \a timeout expired.
+inline bool futexWait(QBasicAtomicInt &futex, int expectedValue,
+                      const struct timespec *timeout = 0) Q_DECL_NOTHROW
+{
+    return _q_futex(&futex, FUTEX_WAIT, expectedValue, timeout) == 0 || errno != ETIMEDOUT;
+}
+
+inline void futexWakeOne(QBasicAtomicInt &futex) Q_DECL_NOTHROW
+{
+    _q_futex(&futex, FUTEX_WAKE, 1);
+}
+
+inline void futexWakeAll(QBasicAtomicInt &futex) Q_DECL_NOTHROW
+{
+    _q_futex(&futex, FUTEX_WAKE, INT_MAX);
+}
+
+} // namespace QtLinuxFutex
+
+QT_END_NAMESPACE
+
+#endif // QT_LINUX_FUTEX
+
+#endif // QFUTEX_P_H
@@ -48,9 +48,34 @@
 
 #include <QtCore/qfutureinterface.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvector.h>
+
+#ifdef Q_COMPILER_DECLTYPE
+#include <utility>
+#endif
 
 QT_BEGIN_NAMESPACE
 
+namespace QtPrivate {
+
+struct FutureInterfaceAccess;
+
+#ifdef Q_COMPILER_DECLTYPE
+template <typename Function, typename T>
+struct ContinuationResultType
+{
+    typedef decltype(std::declval<Function>()(std::declval<T>())) Type;
+};
+
+template <typename Function>
+struct ContinuationResultType<Function, void>
+{
+    typedef decltype(std::declval<Function>()()) Type;
+};
+#endif
+
+} // namespace QtPrivate
 
 template <typename T>
 class QFutureWatcher;
@@ -101,6 +126,13 @@ public:
     inline T resultAt(int index) const;
     bool isResultReadyAt(int resultIndex) const { return d.isResultReadyAt(resultIndex); }
 
+#ifdef Q_COMPILER_DECLTYPE
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResultType<Function, T>::Type> then(Function function) const;
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResultType<Function, T>::Type> then(QThreadPool *pool, Function function) const;
+#endif
+
     operator T() const { return result(); }
     QList<T> results() const { return d.results(); }
 
@@ -241,8 +273,16 @@ public:
     QString progressText() const { return d.progressText(); }
     void waitForFinished() { d.waitForFinished(); }
 
+#ifdef Q_COMPILER_DECLTYPE
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResultType<Function, void>::Type> then(Function function) const;
+    template <typename Function>
+    QFuture<typename QtPrivate::ContinuationResultType<Function, void>::Type> then(QThreadPool *pool, Function function) const;
+#endif
+
 private:
     friend class QFutureWatcher<void>;
+    friend struct QtPrivate::FutureInterfaceAccess;
 
 #ifdef QFUTURE_TEST
 public:
@@ -267,6 +307,306 @@ QFuture<void> qToVoidFuture(const QFuture<T> &future)
     return QFuture<void>(future.d);
 }
 
+namespace QtPrivate {
+
+struct FutureInterfaceAccess
+{
+    template <typename T>
+    static void addContinuation(const QFuture<T> &future, ContinuationBase *continuation)
+    { future.d.addContinuation(continuation); }
+};
+
+#ifdef Q_COMPILER_DECLTYPE
+template <typename T>
+struct ContinuationArgument
+{
+    static bool isAvailable(const QFutureInterface<T> &parent)
+    { return parent.resultCount() > 0; }
+
+    template <typename Function>
+    static typename ContinuationResultType<Function, T>::Type apply(Function &function, const QFutureInterface<T> &parent)
+    { return function(parent.resultReference(0)); }
+};
+
+template <>
+struct ContinuationArgument<void>
+{
+    static bool isAvailable(const QFutureInterface<void> &)
+    { return true; }
+
+    template <typename Function>
+    static typename ContinuationResultType<Function, void>::Type apply(Function &function, const QFutureInterface<void> &)
+    { return function(); }
+};
+
+template <typename R>
+struct ContinuationReporter
+{
+    template <typename Function, typename T>
+    static void report(QFutureInterface<R> &promise, Function &function, const QFutureInterface<T> &parent)
+    { promise.reportResult(ContinuationArgument<T>::apply(function, parent)); }
+};
+
+template <>
+struct ContinuationReporter<void>
+{
+    template <typename Function, typename T>
+    static void report(QFutureInterface<void> &, Function &function, const QFutureInterface<T> &parent)
+    { ContinuationArgument<T>::apply(function, parent); }
+};
+
+template <typename Function, typename T, typename R>
+class Continuation : public ContinuationBase
+{
+public:
+    Continuation(Function function, const QFutureInterface<R> &promise, const QFutureInterfaceBase &parent)
+        : function(function), promise(promise), parentResults(parent)
+    { }
+
+    ~Continuation()
+    {
+        // dropped without being run because the parent never finished
+        if (!promise.isFinished()) {
+            promise.reportCanceled();
+            promise.reportFinished();
+        }
+    }
+
+    void parentFinished(const QFutureInterfaceBase &parentInterface)
+    {
+        parent = QFutureInterface<T>(parentInterface);
+        parentResults.release(parentInterface);
+    }
+
+    void run()
+    {
+        if (!promise.isCanceled() && (parent.isCanceled() || !ContinuationArgument<T>::isAvailable(parent))) {
+#ifndef QT_NO_EXCEPTIONS
+            ExceptionStore &exceptionStore = parent.exceptionStore();
+            if (exceptionStore.hasException())
+                promise.reportException(*exceptionStore.exception().exception());
+#endif
+            promise.reportCanceled();
+        }
+
+        if (promise.isCanceled()) {
+            promise.reportFinished();
+            return;
+        }
+
+#ifndef QT_NO_EXCEPTIONS
+        try {
+#endif
+            ContinuationReporter<R>::report(promise, function, parent);
+#ifndef QT_NO_EXCEPTIONS
+        } catch (QException &e) {
+            promise.reportException(e);
+        } catch (...) {
+            promise.reportException(QUnhandledException());
+        }
+#endif
+        promise.reportFinished();
+    }
+
+private:
+    Function function;
+    QFutureInterface<R> promise;
+    QFutureInterface<T> parent;
+    ContinuationParentResults<T> parentResults;
+};
+#endif // Q_COMPILER_DECLTYPE
+
+// Completion of one of the futures passed to QtFuture::whenAll() or
+// QtFuture::whenAny(); forwards the finished future to the shared context.
+template <typename T, typename Context>
+class WhenContinuation : public ContinuationBase
+{
+public:
+    WhenContinuation(Context *context, int index, const QFutureInterfaceBase &parent)
+        : context(context), index(index), parentResults(parent)
+    { }
+
+    void parentFinished(const QFutureInterfaceBase &parentInterface)
+    {
+        parent = QFutureInterface<T>(parentInterface).future();
+        parentResults.release(parentInterface);
+    }
+
+    void run()
+    {
+        context->futureFinished(index, parent);
+    }
+
+private:
+    QExplicitlySharedDataPointer<Context> context;
+    int index;
+    QFuture<T> parent;
+    ContinuationParentResults<T> parentResults;
+};
+
+// The context is shared by all continuations of one whenAll()/whenAny() call and
+// is destroyed together with the last of them. If that happens before the
+// combined future was reported, one of the input futures was destroyed without
+// ever finishing and the combined future is canceled.
+template <typename R>
+class WhenContextBase : public QSharedData
+{
+public:
+    WhenContextBase()
+    { promise.reportStarted(); }
+
+    ~WhenContextBase()
+    {
+        if (!promise.isFinished()) {
+            promise.reportCanceled();
+            promise.reportFinished();
+        }
+    }
+
+    QFutureInterface<R> promise;
+};
+
+template <typename T>
+class WhenAllContext : public WhenContextBase<QList<QFuture<T> > >
+{
+public:
+    explicit WhenAllContext(int count)
+        : futures(count), remaining(count)
+    { }
+
+    void futureFinished(int index, const QFuture<T> &future)
+    {
+        futures.data()[index] = future;
+        if (!remaining.deref()) {
+            this->promise.reportResult(futures.toList());
+            this->promise.reportFinished();
+        }
+    }
+
+    QVector<QFuture<T> > futures;
+    QAtomicInt remaining;
+};
+
+} // namespace QtPrivate
+
+namespace QtFuture {
+
+template <typename T>
+struct WhenAnyResult
+{
+    WhenAnyResult()
+        : index(-1)
+    { }
+    WhenAnyResult(int index, const QFuture<T> &future)
+        : index(index), future(future)
+    { }
+
+    int index;
+    QFuture<T> future;
+};
+
+} // namespace QtFuture
+
+namespace QtPrivate {
+
+template <typename T>
+class WhenAnyContext : public WhenContextBase<QtFuture::WhenAnyResult<T> >
+{
+public:
+    WhenAnyContext()
+        : done(0)
+    { }
+
+    void futureFinished(int index, const QFuture<T> &future)
+    {
+        if (done.testAndSetOrdered(0, 1)) {
+            this->promise.reportResult(QtFuture::WhenAnyResult<T>(index, future));
+            this->promise.reportFinished();
+        }
+    }
+
+    QAtomicInt done;
+};
+
+} // namespace QtPrivate
+
+#ifdef Q_COMPILER_DECLTYPE
+template <typename T>
+template <typename Function>
+QFuture<typename QtPrivate::ContinuationResultType<Function, T>::Type> QFuture<T>::then(Function function) const
+{
+    return then(0, function);
+}
+
+template <typename T>
+template <typename Function>
+QFuture<typename QtPrivate::ContinuationResultType<Function, T>::Type> QFuture<T>::then(QThreadPool *pool, Function function) const
+{
+    typedef typename QtPrivate::ContinuationResultType<Function, T>::Type R;
+    QFutureInterface<R> promise;
+    promise.reportStarted();
+    QFuture<R> result = promise.future();
+    d.addContinuation(new QtPrivate::Continuation<Function, T, R>(function, promise, d), pool);
+    return result;
+}
+
+template <typename Function>
+QFuture<typename QtPrivate::ContinuationResultType<Function, void>::Type> QFuture<void>::then(Function function) const
+{
+    return then(0, function);
+}
+
+template <typename Function>
+QFuture<typename QtPrivate::ContinuationResultType<Function, void>::Type> QFuture<void>::then(QThreadPool *pool, Function function) const
+{
+    typedef typename QtPrivate::ContinuationResultType<Function, void>::Type R;
+    QFutureInterface<R> promise;
+    promise.reportStarted();
+    QFuture<R> result = promise.future();
+    d.addContinuation(new QtPrivate::Continuation<Function, void, R>(function, promise, d), pool);
+    return result;
+}
+#endif // Q_COMPILER_DECLTYPE
+
+namespace QtFuture {
+
+template <typename T>
+QFuture<QList<QFuture<T> > > whenAll(const QList<QFuture<T> > &futures)
+{
+    typedef QtPrivate::WhenAllContext<T> Context;
+    QExplicitlySharedDataPointer<Context> context(new Context(futures.count()));
+    QFuture<QList<QFuture<T> > > result = context->promise.future();
+
+    if (futures.isEmpty()) {
+        context->promise.reportResult(QList<QFuture<T> >());
+        context->promise.reportFinished();
+        return result;
+    }
+
+    for (int i = 0; i < futures.count(); ++i)
+        QtPrivate::FutureInterfaceAccess::addContinuation(futures.at(i), new QtPrivate::WhenContinuation<T, Context>(context.data(), i, futures.at(i).d));
+    return result;
+}
+
+template <typename T>
+QFuture<WhenAnyResult<T> > whenAny(const QList<QFuture<T> > &futures)
+{
+    typedef QtPrivate::WhenAnyContext<T> Context;
+    QExplicitlySharedDataPointer<Context> context(new Context);
+    QFuture<WhenAnyResult<T> > result = context->promise.future();
+
+    if (futures.isEmpty()) {
+        context->promise.reportFinished();
+        return result;
+    }
+
+    for (int i = 0; i < futures.count(); ++i)
+        QtPrivate::FutureInterfaceAccess::addContinuation(futures.at(i), new QtPrivate::WhenContinuation<T, Context>(context.data(), i, futures.at(i).d));
+    return result;
+}
+
+} // namespace QtFuture
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_QFUTURE
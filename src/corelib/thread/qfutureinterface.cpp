@@ -270,6 +270,13 @@ void QFutureInterfaceBase::reportFinished()
         d->state = State((d->state & ~Running) | Finished);
         d->waitCondition.wakeAll();
         d->sendCallOut(QFutureCallOutEvent(QFutureCallOutEvent::Finished));
+
+        if (!d->continuations.isEmpty()) {
+            QVector<QFutureInterfaceBasePrivate::Continuation> continuations;
+            continuations.swap(d->continuations);
+            locker.unlock();
+            QFutureInterfaceBasePrivate::runContinuations(continuations, *this);
+        }
     }
 }
 
@@ -364,6 +371,27 @@ void QFutureInterfaceBase::setRunnable(QRunnable *runnable)
     d->runnable = runnable;
 }
 
+// Attaches a continuation that is run once this future has finished. The
+// continuation is run on the thread that reports the future as finished, or
+// started on pool if one is given. If the future has already finished,
+// the continuation is run (or started) right away.
+void QFutureInterfaceBase::addContinuation(QtPrivate::ContinuationBase *continuation,
+                                           QThreadPool *pool)
+{
+    QFutureInterfaceBasePrivate::Continuation c;
+    c.continuation = continuation;
+    c.pool = pool;
+
+    QMutexLocker locker(&d->m_mutex);
+    if (!(d->state & Finished)) {
+        d->continuations.append(c);
+        return;
+    }
+    locker.unlock();
+
+    QFutureInterfaceBasePrivate::runContinuations(QVector<QFutureInterfaceBasePrivate::Continuation>() << c, *this);
+}
+
 void QFutureInterfaceBase::setFilterMode(bool enable)
 {
     QMutexLocker locker(&d->m_mutex);
@@ -449,6 +477,17 @@ QFutureInterfaceBasePrivate::QFutureInterfaceBasePrivate(QFutureInterfaceBase::S
     progressTime.invalidate();
 }
 
+QFutureInterfaceBasePrivate::~QFutureInterfaceBasePrivate()
+{
+    // continuations of a future that never finished are dropped; they
+    // cancel whatever they would have produced when they are deleted.
+    for (int i = 0; i < continuations.count(); ++i) {
+        QtPrivate::ContinuationBase *continuation = continuations.at(i).continuation;
+        if (continuation->autoDelete())
+            delete continuation;
+    }
+}
+
 int QFutureInterfaceBasePrivate::internal_resultCount() const
 {
     return m_results.count(); // ### subtract canceled results.
@@ -577,6 +616,27 @@ void QFutureInterfaceBasePrivate::disconnectOutputInterface(QFutureCallOutInterf
     interface->callOutInterfaceDisconnected();
 }
 
+// Must be called without holding the mutex, continuations are free to
+// access the parent future and to finish other futures.
+void QFutureInterfaceBasePrivate::runContinuations(const QVector<Continuation> &continuations,
+                                                   const QFutureInterfaceBase &parent)
+{
+    for (int i = 0; i < continuations.count(); ++i) {
+        QtPrivate::ContinuationBase *continuation = continuations.at(i).continuation;
+        continuation->parentFinished(parent);
+
+        QThreadPool *pool = continuations.at(i).pool.data();
+        if (pool) {
+            pool->start(continuation);
+        } else {
+            const bool autoDelete = continuation->autoDelete();
+            continuation->run();
+            if (autoDelete)
+                delete continuation;
+        }
+    }
+}
+
 void QFutureInterfaceBasePrivate::setState(QFutureInterfaceBase::State newState)
 {
     state = newState;
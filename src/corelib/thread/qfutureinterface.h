@@ -54,9 +54,27 @@ QT_BEGIN_NAMESPACE
 
 
 template <typename T> class QFuture;
+class QFutureInterfaceBase;
 class QFutureInterfaceBasePrivate;
 class QFutureWatcherBase;
 class QFutureWatcherBasePrivate;
+class QThreadPool;
+
+namespace QtPrivate {
+
+// A continuation is attached to a future with QFutureInterfaceBase::addContinuation()
+// and is run once when that future finishes. parentFinished() is called first, on the
+// finishing thread, so that the continuation can take a reference to the results
+// before it is run directly or handed to a thread pool.
+class ContinuationBase : public QRunnable
+{
+public:
+    virtual void parentFinished(const QFutureInterfaceBase &parent) = 0;
+};
+
+template <typename T> class ContinuationParentResults;
+
+} // namespace QtPrivate
 
 class Q_CORE_EXPORT QFutureInterfaceBase
 {
@@ -85,6 +103,7 @@ public:
     void reportResultsReady(int beginIndex, int endIndex);
 
     void setRunnable(QRunnable *runnable);
+    void addContinuation(QtPrivate::ContinuationBase *continuation, QThreadPool *pool = 0);
     void setFilterMode(bool enable);
     void setProgressRange(int minimum, int maximum);
     int progressMinimum() const;
@@ -140,6 +159,7 @@ private:
 private:
     friend class QFutureWatcherBase;
     friend class QFutureWatcherBasePrivate;
+    template <typename T> friend class QtPrivate::ContinuationParentResults;
 };
 
 template <typename T>
@@ -156,6 +176,11 @@ public:
     {
         refT();
     }
+    explicit QFutureInterface(const QFutureInterfaceBase &other) // internal
+        : QFutureInterfaceBase(other)
+    {
+        refT();
+    }
     ~QFutureInterface()
     {
         if (!derefT())
@@ -291,6 +316,9 @@ public:
     QFutureInterface<void>(const QFutureInterface<void> &other)
         : QFutureInterfaceBase(other)
     { }
+    explicit QFutureInterface<void>(const QFutureInterfaceBase &other) // internal
+        : QFutureInterfaceBase(other)
+    { }
 
     static QFutureInterface<void> canceledResult()
     { return QFutureInterface(State(Started | Finished | Canceled)); }
@@ -308,6 +336,55 @@ public:
     void reportFinished(const void * = 0) { QFutureInterfaceBase::reportFinished(); }
 };
 
+namespace QtPrivate {
+
+// Held by a continuation from the moment it is attached to a future until
+// parentFinished() gives it a typed reference of its own. Without it, the
+// results would be cleared as soon as the last QFuture<T> for the parent
+// goes away, which happens before the parent finishes if the continuation
+// was attached to a temporary, for instance QtConcurrent::mapped(...).then(f).
+template <typename T>
+class ContinuationParentResults
+{
+public:
+    explicit ContinuationParentResults(const QFutureInterfaceBase &parent)
+        : results(&static_cast<ResultStore<T> &>(const_cast<QFutureInterfaceBase &>(parent).resultStoreBase()))
+    {
+        parent.refT();
+    }
+
+    ~ContinuationParentResults()
+    {
+        // dropped together with a parent that never finished; nobody else
+        // holds a typed reference that could clear the results
+        if (results)
+            results->clear();
+    }
+
+    // parent must be held by a QFutureInterface<T> or QFuture<T> already
+    void release(const QFutureInterfaceBase &parent)
+    {
+        if (results) {
+            parent.derefT();
+            results = 0;
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(ContinuationParentResults)
+    ResultStore<T> *results;
+};
+
+template <>
+class ContinuationParentResults<void>
+{
+public:
+    explicit ContinuationParentResults(const QFutureInterfaceBase &) { }
+    void release(const QFutureInterfaceBase &) { }
+};
+
+} // namespace QtPrivate
+
 QT_END_NAMESPACE
 #endif // QT_NO_QFUTURE
 
@@ -58,6 +58,9 @@
 #include <QtCore/qlist.h>
 #include <QtCore/qwaitcondition.h>
 #include <QtCore/qrunnable.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -128,6 +131,13 @@ class QFutureInterfaceBasePrivate
 {
 public:
     QFutureInterfaceBasePrivate(QFutureInterfaceBase::State initialState);
+    ~QFutureInterfaceBasePrivate();
+
+    struct Continuation
+    {
+        QtPrivate::ContinuationBase *continuation;
+        QPointer<QThreadPool> pool;
+    };
 
     // When the last QFuture<T> reference is removed, we need to make
     // sure that data stored in the ResultStore is cleaned out.
@@ -169,6 +179,7 @@ public:
     QtPrivate::ExceptionStore m_exceptionStore;
     QString m_progressText;
     QRunnable *runnable;
+    QVector<Continuation> continuations;
 
     // Internal functions that does not change the mutex state.
     // The mutex must be locked when calling these.
@@ -181,6 +192,8 @@ public:
     void sendCallOuts(const QFutureCallOutEvent &callOut1, const QFutureCallOutEvent &callOut2);
     void connectOutputInterface(QFutureCallOutInterface *iface);
     void disconnectOutputInterface(QFutureCallOutInterface *iface);
+    static void runContinuations(const QVector<Continuation> &continuations,
+                                 const QFutureInterfaceBase &parent);
 
     void setState(QFutureInterfaceBase::State state);
 };
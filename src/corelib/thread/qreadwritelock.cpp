@@ -46,8 +46,11 @@
 #include "qmutex.h"
 #include "qthread.h"
 #include "qwaitcondition.h"
+#include "qelapsedtimer.h"
 
 #include "qreadwritelock_p.h"
+#include "qfutex_p.h"
+#include <private/qsimd_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -142,29 +145,30 @@ QReadWriteLock::~QReadWriteLock()
 */
 void QReadWriteLock::lockForRead()
 {
-    QMutexLocker lock(&d->mutex);
+    if (!d->recursive) {
+        if (!d->fastTryLockForRead() && !d->spinLock(false))
+            d->lockForRead(-1, false);
+        return;
+    }
 
-    Qt::HANDLE self = 0;
-    if (d->recursive) {
-        self = QThread::currentThreadId();
+    QMutexLocker lock(&d->mutex);
 
-        QHash<Qt::HANDLE, int>::iterator it = d->currentReaders.find(self);
-        if (it != d->currentReaders.end()) {
-            ++it.value();
-            ++d->accessCount;
-            Q_ASSERT_X(d->accessCount > 0, "QReadWriteLock::lockForRead()",
-                       "Overflow in lock counter");
-            return;
-        }
+    Qt::HANDLE self = QThread::currentThreadId();
+    QHash<Qt::HANDLE, int>::iterator it = d->currentReaders.find(self);
+    if (it != d->currentReaders.end()) {
+        ++it.value();
+        ++d->accessCount;
+        Q_ASSERT_X(d->accessCount > 0, "QReadWriteLock::lockForRead()",
+                   "Overflow in lock counter");
+        return;
     }
 
     while (d->accessCount < 0 || d->waitingWriters) {
         ++d->waitingReaders;
-        d->readerWait.wait(&d->mutex);
+        d->wait(QReadWriteLockPrivate::Readers, -1, 0);
         --d->waitingReaders;
     }
-    if (d->recursive)
-        d->currentReaders.insert(self, 1);
+    d->currentReaders.insert(self, 1);
 
     ++d->accessCount;
     Q_ASSERT_X(d->accessCount > 0, "QReadWriteLock::lockForRead()", "Overflow in lock counter");
@@ -188,26 +192,24 @@ void QReadWriteLock::lockForRead()
 */
 bool QReadWriteLock::tryLockForRead()
 {
-    QMutexLocker lock(&d->mutex);
+    if (!d->recursive)
+        return d->fastTryLockForRead() || d->lockForRead(0, true);
 
-    Qt::HANDLE self = 0;
-    if (d->recursive) {
-        self = QThread::currentThreadId();
+    QMutexLocker lock(&d->mutex);
 
-        QHash<Qt::HANDLE, int>::iterator it = d->currentReaders.find(self);
-        if (it != d->currentReaders.end()) {
-            ++it.value();
-            ++d->accessCount;
-            Q_ASSERT_X(d->accessCount > 0, "QReadWriteLock::tryLockForRead()",
-                       "Overflow in lock counter");
-            return true;
-        }
+    Qt::HANDLE self = QThread::currentThreadId();
+    QHash<Qt::HANDLE, int>::iterator it = d->currentReaders.find(self);
+    if (it != d->currentReaders.end()) {
+        ++it.value();
+        ++d->accessCount;
+        Q_ASSERT_X(d->accessCount > 0, "QReadWriteLock::tryLockForRead()",
+                   "Overflow in lock counter");
+        return true;
     }
 
     if (d->accessCount < 0)
         return false;
-    if (d->recursive)
-        d->currentReaders.insert(self, 1);
+    d->currentReaders.insert(self, 1);
 
     ++d->accessCount;
     Q_ASSERT_X(d->accessCount > 0, "QReadWriteLock::tryLockForRead()", "Overflow in lock counter");
@@ -236,31 +238,35 @@ bool QReadWriteLock::tryLockForRead()
 */
 bool QReadWriteLock::tryLockForRead(int timeout)
 {
-    QMutexLocker lock(&d->mutex);
+    if (!d->recursive) {
+        if (d->fastTryLockForRead() || (timeout != 0 && d->spinLock(false)))
+            return true;
+        return d->lockForRead(timeout, false);
+    }
 
-    Qt::HANDLE self = 0;
-    if (d->recursive) {
-        self = QThread::currentThreadId();
+    QElapsedTimer timer;
+    if (timeout > 0)
+        timer.start();
+    QMutexLocker lock(&d->mutex);
 
-        QHash<Qt::HANDLE, int>::iterator it = d->currentReaders.find(self);
-        if (it != d->currentReaders.end()) {
-            ++it.value();
-            ++d->accessCount;
-            Q_ASSERT_X(d->accessCount > 0, "QReadWriteLock::tryLockForRead()",
-                       "Overflow in lock counter");
-            return true;
-        }
+    Qt::HANDLE self = QThread::currentThreadId();
+    QHash<Qt::HANDLE, int>::iterator it = d->currentReaders.find(self);
+    if (it != d->currentReaders.end()) {
+        ++it.value();
+        ++d->accessCount;
+        Q_ASSERT_X(d->accessCount > 0, "QReadWriteLock::tryLockForRead()",
+                   "Overflow in lock counter");
+        return true;
     }
 
     while (d->accessCount < 0 || d->waitingWriters) {
         ++d->waitingReaders;
-        bool success = d->readerWait.wait(&d->mutex, timeout < 0 ? ULONG_MAX : ulong(timeout));
+        bool success = d->wait(QReadWriteLockPrivate::Readers, timeout, &timer);
         --d->waitingReaders;
         if (!success)
             return false;
     }
-    if (d->recursive)
-        d->currentReaders.insert(self, 1);
+    d->currentReaders.insert(self, 1);
 
     ++d->accessCount;
     Q_ASSERT_X(d->accessCount > 0, "QReadWriteLock::tryLockForRead()", "Overflow in lock counter");
@@ -281,27 +287,28 @@ bool QReadWriteLock::tryLockForRead(int timeout)
 */
 void QReadWriteLock::lockForWrite()
 {
-    QMutexLocker lock(&d->mutex);
+    if (!d->recursive) {
+        if (!d->fastTryLockForWrite() && !d->spinLock(true))
+            d->lockForWrite(-1);
+        return;
+    }
 
-    Qt::HANDLE self = 0;
-    if (d->recursive) {
-        self = QThread::currentThreadId();
+    QMutexLocker lock(&d->mutex);
 
-        if (d->currentWriter == self) {
-            --d->accessCount;
-            Q_ASSERT_X(d->accessCount < 0, "QReadWriteLock::lockForWrite()",
-                       "Overflow in lock counter");
-            return;
-        }
+    Qt::HANDLE self = QThread::currentThreadId();
+    if (d->currentWriter == self) {
+        --d->accessCount;
+        Q_ASSERT_X(d->accessCount < 0, "QReadWriteLock::lockForWrite()",
+                   "Overflow in lock counter");
+        return;
     }
 
     while (d->accessCount != 0) {
         ++d->waitingWriters;
-        d->writerWait.wait(&d->mutex);
+        d->wait(QReadWriteLockPrivate::Writers, -1, 0);
         --d->waitingWriters;
     }
-    if (d->recursive)
-        d->currentWriter = self;
+    d->currentWriter = self;
 
     --d->accessCount;
     Q_ASSERT_X(d->accessCount < 0, "QReadWriteLock::lockForWrite()", "Overflow in lock counter");
@@ -324,24 +331,22 @@ void QReadWriteLock::lockForWrite()
 */
 bool QReadWriteLock::tryLockForWrite()
 {
-    QMutexLocker lock(&d->mutex);
+    if (!d->recursive)
+        return d->fastTryLockForWrite() || d->lockForWrite(0);
 
-    Qt::HANDLE self = 0;
-    if (d->recursive) {
-        self = QThread::currentThreadId();
+    QMutexLocker lock(&d->mutex);
 
-        if (d->currentWriter == self) {
-            --d->accessCount;
-            Q_ASSERT_X(d->accessCount < 0, "QReadWriteLock::lockForWrite()",
-                       "Overflow in lock counter");
-            return true;
-        }
+    Qt::HANDLE self = QThread::currentThreadId();
+    if (d->currentWriter == self) {
+        --d->accessCount;
+        Q_ASSERT_X(d->accessCount < 0, "QReadWriteLock::lockForWrite()",
+                   "Overflow in lock counter");
+        return true;
     }
 
     if (d->accessCount != 0)
         return false;
-    if (d->recursive)
-        d->currentWriter = self;
+    d->currentWriter = self;
 
     --d->accessCount;
     Q_ASSERT_X(d->accessCount < 0, "QReadWriteLock::tryLockForWrite()",
@@ -371,30 +376,37 @@ bool QReadWriteLock::tryLockForWrite()
 */
 bool QReadWriteLock::tryLockForWrite(int timeout)
 {
-    QMutexLocker lock(&d->mutex);
+    if (!d->recursive) {
+        if (d->fastTryLockForWrite() || (timeout != 0 && d->spinLock(true)))
+            return true;
+        return d->lockForWrite(timeout);
+    }
 
-    Qt::HANDLE self = 0;
-    if (d->recursive) {
-        self = QThread::currentThreadId();
+    QElapsedTimer timer;
+    if (timeout > 0)
+        timer.start();
+    QMutexLocker lock(&d->mutex);
 
-        if (d->currentWriter == self) {
-            --d->accessCount;
-            Q_ASSERT_X(d->accessCount < 0, "QReadWriteLock::lockForWrite()",
-                       "Overflow in lock counter");
-            return true;
-        }
+    Qt::HANDLE self = QThread::currentThreadId();
+    if (d->currentWriter == self) {
+        --d->accessCount;
+        Q_ASSERT_X(d->accessCount < 0, "QReadWriteLock::lockForWrite()",
+                   "Overflow in lock counter");
+        return true;
     }
 
     while (d->accessCount != 0) {
         ++d->waitingWriters;
-        bool success = d->writerWait.wait(&d->mutex, timeout < 0 ? ULONG_MAX : ulong(timeout));
+        bool success = d->wait(QReadWriteLockPrivate::Writers, timeout, &timer);
         --d->waitingWriters;
-
-        if (!success)
+        if (!success) {
+            // readers may have waited for this writer only
+            if (!d->waitingWriters && d->waitingReaders && d->accessCount > 0)
+                d->wake(QReadWriteLockPrivate::Readers);
             return false;
+        }
     }
-    if (d->recursive)
-        d->currentWriter = self;
+    d->currentWriter = self;
 
     --d->accessCount;
     Q_ASSERT_X(d->accessCount < 0, "QReadWriteLock::tryLockForWrite()",
@@ -413,6 +425,12 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
 */
 void QReadWriteLock::unlock()
 {
+    if (!d->recursive) {
+        if (!d->fastTryUnlock())
+            d->unlock();
+        return;
+    }
+
     QMutexLocker lock(&d->mutex);
 
     Q_ASSERT_X(d->accessCount != 0, "QReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
@@ -420,13 +438,11 @@ void QReadWriteLock::unlock()
     bool unlocked = false;
     if (d->accessCount > 0) {
         // releasing a read lock
-        if (d->recursive) {
-            Qt::HANDLE self = QThread::currentThreadId();
-            QHash<Qt::HANDLE, int>::iterator it = d->currentReaders.find(self);
-            if (it != d->currentReaders.end()) {
-                if (--it.value() <= 0)
-                    d->currentReaders.erase(it);
-            }
+        Qt::HANDLE self = QThread::currentThreadId();
+        QHash<Qt::HANDLE, int>::iterator it = d->currentReaders.find(self);
+        if (it != d->currentReaders.end()) {
+            if (--it.value() <= 0)
+                d->currentReaders.erase(it);
         }
 
         unlocked = --d->accessCount == 0;
@@ -438,11 +454,267 @@ void QReadWriteLock::unlock()
 
     if (unlocked) {
         if (d->waitingWriters) {
-            d->writerWait.wakeOne();
+            d->wake(QReadWriteLockPrivate::Writers);
         } else if (d->waitingReaders) {
-            d->readerWait.wakeAll();
+            d->wake(QReadWriteLockPrivate::Readers);
+        }
+    }
+}
+
+/*
+    Non-recursive locks without waiters: one atomic operation each.
+*/
+bool QReadWriteLockPrivate::fastTryLockForRead()
+{
+    int s = state.load();
+    while (!(s & (LockedForWrite | Contended))) {
+        Q_ASSERT_X((s & ReaderMask) != ReaderMask, "QReadWriteLock::lockForRead()",
+                   "Overflow in lock counter");
+        if (state.testAndSetAcquire(s, s + 1))
+            return true;
+        s = state.load();
+    }
+    return false;
+}
+
+bool QReadWriteLockPrivate::fastTryLockForWrite()
+{
+    return state.testAndSetAcquire(0, LockedForWrite);
+}
+
+bool QReadWriteLockPrivate::fastTryUnlock()
+{
+    int s = state.load();
+    while (!(s & Contended)) {
+        Q_ASSERT_X(s != 0, "QReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
+        if (state.testAndSetRelease(s, s == LockedForWrite ? 0 : s - 1))
+            return true;
+        s = state.load();
+    }
+    return false;
+}
+
+/*
+    Busy-waits for a while for the lock to become available before the
+    caller goes to sleep, which is much cheaper when the lock is held only
+    briefly. Like adaptive mutexes, it spins up to about twice the average
+    number of spins that got the lock recently, and not at all on a single
+    CPU or once another thread sleeps on the lock.
+*/
+bool QReadWriteLockPrivate::spinLock(bool forWrite)
+{
+    enum { MaxSpinCount = 100 };
+    static const bool multipleCpus = QThread::idealThreadCount() > 1;
+    if (!multipleCpus)
+        return false;
+
+    const int average = spinCount.load();
+    const int maxSpins = qMin(int(MaxSpinCount), average * 2 + 10);
+    int spins = 0;
+    while (spins < maxSpins && !(state.load() & Contended)) {
+        ++spins;
+        if (forWrite ? fastTryLockForWrite() : fastTryLockForRead()) {
+            spinCount.store(average + (spins - average) / 8);
+            return true;
+        }
+#ifdef __SSE2__
+        _mm_pause();
+#endif
+    }
+    spinCount.store(average + (maxSpins - average) / 8);
+    return false;
+}
+
+/*
+    Slow paths of the non-recursive locks. Setting Contended makes every
+    later lock and unlock come here, under the mutex, so that whoever
+    frees the lock sees the waiters. A negative \a timeout waits forever.
+*/
+bool QReadWriteLockPrivate::lockForRead(int timeout, bool overtakeWriters)
+{
+    QElapsedTimer timer;
+    if (timeout > 0)
+        timer.start();
+    QMutexLocker lock(&mutex);
+
+    forever {
+        const int s = state.load();
+        if (!(s & LockedForWrite) && (overtakeWriters || !waitingWriters)) {
+            Q_ASSERT_X((s & ReaderMask) != ReaderMask, "QReadWriteLock::lockForRead()",
+                       "Overflow in lock counter");
+            if (state.testAndSetAcquire(s, s + 1))
+                return true;
+            continue; // readers came or left through the fast path
         }
+        if (timeout == 0)
+            return false;
+        if (!(s & Contended) && !state.testAndSetRelaxed(s, s | Contended))
+            continue;
+
+        ++waitingReaders;
+        const bool success = wait(Readers, timeout, &timer);
+        --waitingReaders;
+        if (!success) {
+            if (!(state.load() & (ReaderMask | LockedForWrite)))
+                wakeWaiters();
+            return false;
+        }
+    }
+}
+
+bool QReadWriteLockPrivate::lockForWrite(int timeout)
+{
+    QElapsedTimer timer;
+    if (timeout > 0)
+        timer.start();
+    QMutexLocker lock(&mutex);
+
+    forever {
+        const int s = state.load();
+        if (!(s & (ReaderMask | LockedForWrite))) {
+            if (state.testAndSetAcquire(s, s | LockedForWrite))
+                return true;
+            continue;
+        }
+        if (timeout == 0)
+            return false;
+        if (!(s & Contended) && !state.testAndSetRelaxed(s, s | Contended))
+            continue;
+
+        ++waitingWriters;
+        const bool success = wait(Writers, timeout, &timer);
+        --waitingWriters;
+        if (!success) {
+            const int s = state.load();
+            if (!(s & (ReaderMask | LockedForWrite))) {
+                // we might have taken the wake up of another writer
+                wakeWaiters();
+            } else if (!(s & LockedForWrite) && !waitingWriters && waitingReaders) {
+                // readers may have waited for this writer only
+                wake(Readers);
+            }
+            return false;
+        }
+    }
+}
+
+void QReadWriteLockPrivate::unlock()
+{
+    QMutexLocker lock(&mutex);
+
+    int s, newState;
+    do {
+        s = state.load();
+        Q_ASSERT_X(s & (ReaderMask | LockedForWrite), "QReadWriteLock::unlock()",
+                   "Cannot unlock an unlocked lock");
+        newState = (s & LockedForWrite) ? s & ~LockedForWrite : s - 1;
+    } while (!state.testAndSetRelease(s, newState));
+
+    if (!(newState & (ReaderMask | LockedForWrite)))
+        wakeWaiters(&lock);
+}
+
+/*
+    Called with the mutex locked once the lock is free. Writers go first.
+    Once no thread sleeps any more, the lock goes back to the fast path;
+    woken up readers that have to wait again set Contended again. If \a lock
+    is given, it is unlocked before the waiters are woken up, so that they
+    do not block on the mutex right away.
+*/
+void QReadWriteLockPrivate::wakeWaiters(QMutexLocker *lock)
+{
+    if (waitingWriters) {
+        wake(Writers, lock);
+        return;
+    }
+
+    int s = state.load();
+    while (!state.testAndSetRelaxed(s, s & ~Contended))
+        s = state.load();
+    if (waitingReaders)
+        wake(Readers, lock);
+}
+
+/*
+    Waits with the mutex locked until woken up by wake(). Returns false if
+    \a timeout milliseconds have elapsed on \a timer; a negative \a timeout
+    waits forever.
+*/
+bool QReadWriteLockPrivate::wait(Waiters waiters, int timeout, QElapsedTimer *timer)
+{
+    if (timeout == 0)
+        return false;
+#ifdef QT_LINUX_FUTEX
+    QAtomicInt &wakeups = waiters == Readers ? readerWakeups : writerWakeups;
+    const int expectedValue = wakeups.load();
+    struct timespec ts, *pts = 0;
+    if (timeout > 0) {
+        const qint64 remaining = qint64(timeout) * 1000 * 1000 - timer->nsecsElapsed();
+        if (remaining <= 0)
+            return false;
+        ts.tv_sec = remaining / Q_INT64_C(1000000000);
+        ts.tv_nsec = remaining % Q_INT64_C(1000000000);
+        pts = &ts;
+    }
+
+    mutex.unlock();
+    const bool success = QtLinuxFutex::futexWait(wakeups, expectedValue, pts);
+    mutex.lock();
+    return success;
+#else
+    QWaitCondition &condition = waiters == Readers ? readerWait : writerWait;
+    unsigned long time = ULONG_MAX;
+    if (timeout > 0) {
+        const qint64 remaining = timeout - timer->elapsed();
+        if (remaining <= 0)
+            return false;
+        time = remaining;
+    }
+    return condition.wait(&mutex, time);
+#endif
+}
+
+/*
+    Wakes up one waiting writer or all waiting readers, after unlocking
+    \a lock if given.
+*/
+void QReadWriteLockPrivate::wake(Waiters waiters, QMutexLocker *lock)
+{
+#ifdef QT_LINUX_FUTEX
+    QAtomicInt &wakeups = waiters == Readers ? readerWakeups : writerWakeups;
+    wakeups.ref();
+    if (lock)
+        lock->unlock();
+    if (waiters == Writers)
+        QtLinuxFutex::futexWakeOne(wakeups);
+    else
+        QtLinuxFutex::futexWakeAll(wakeups);
+#else
+    if (waiters == Writers)
+        writerWait.wakeOne();
+    else
+        readerWait.wakeAll();
+    if (lock)
+        lock->unlock();
+#endif
+}
+
+/*
+    Used by QWaitCondition::wait() to relock the lock the same way.
+*/
+QReadWriteLockPrivate::StateForWaitCondition QReadWriteLockPrivate::stateForWaitCondition() const
+{
+    if (recursive) {
+        if (accessCount > 0)
+            return ReadLocked;
+        if (accessCount == -1)
+            return WriteLocked;
+        return accessCount ? RecursivelyWriteLocked : Unlocked;
     }
+    const int s = state.load();
+    if (s & LockedForWrite)
+        return WriteLocked;
+    return (s & ReaderMask) ? ReadLocked : Unlocked;
 }
 
 /*!
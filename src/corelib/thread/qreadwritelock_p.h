@@ -55,26 +55,75 @@
 
 #include <QtCore/qglobal.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+#include "qmutex_p.h"
 
 #ifndef QT_NO_THREAD
 
 QT_BEGIN_NAMESPACE
 
+class QElapsedTimer;
+
 struct QReadWriteLockPrivate
 {
     QReadWriteLockPrivate(QReadWriteLock::RecursionMode recursionMode)
-        : accessCount(0), waitingReaders(0), waitingWriters(0),
+        : state(0), waitingReaders(0), waitingWriters(0), spinCount(0), accessCount(0),
           recursive(recursionMode == QReadWriteLock::Recursive), currentWriter(0)
     { }
 
+    // A non-recursive lock is held in state: the number of readers, or
+    // LockedForWrite. As long as no thread waits, it is locked and unlocked
+    // with a single atomic operation. Once a thread waits, it sets Contended
+    // and everybody goes through the mutex until the waiters are gone.
+    enum State {
+        ReaderMask = 0x0fffffff,
+        LockedForWrite = 0x10000000,
+        Contended = 0x20000000
+    };
+    QAtomicInt state;
+
+    bool fastTryLockForRead();
+    bool fastTryLockForWrite();
+    bool fastTryUnlock();
+    bool spinLock(bool forWrite);
+    bool lockForRead(int timeout, bool overtakeWriters);
+    bool lockForWrite(int timeout);
+    void unlock();
+
+    enum StateForWaitCondition {
+        Unlocked,
+        ReadLocked,
+        WriteLocked,
+        RecursivelyWriteLocked
+    };
+    StateForWaitCondition stateForWaitCondition() const;
+
+    // the rest is protected by the mutex
     QMutex mutex;
+#ifdef QT_LINUX_FUTEX
+    QAtomicInt readerWakeups;
+    QAtomicInt writerWakeups;
+#else
     QWaitCondition readerWait;
     QWaitCondition writerWait;
+#endif
+
+    enum Waiters { Readers, Writers };
+    bool wait(Waiters waiters, int timeout, QElapsedTimer *timer);
+    void wake(Waiters waiters, QMutexLocker *lock = 0);
+    void wakeWaiters(QMutexLocker *lock = 0);
 
-    int accessCount;
     int waitingReaders;
     int waitingWriters;
 
+    // average number of spins that got the lock, see spinLock()
+    QAtomicInt spinCount;
+
+    // recursive locks keep track of their owners instead of using state
+    int accessCount;
+
     bool recursive;
     Qt::HANDLE currentWriter;
     QHash<Qt::HANDLE, int> currentReaders;
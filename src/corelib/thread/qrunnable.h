@@ -43,13 +43,14 @@
 #define QRUNNABLE_H
 
 #include <QtCore/qglobal.h>
+#include <QtCore/qatomic.h>
 
 QT_BEGIN_NAMESPACE
 
 
 class QRunnable
 {
-    int ref;
+    QAtomicInt ref;
 
     friend class QThreadPool;
     friend class QThreadPoolPrivate;
@@ -61,8 +62,8 @@ public:
     QRunnable() : ref(0) { }
     virtual ~QRunnable() { }
 
-    bool autoDelete() const { return ref != -1; }
-    void setAutoDelete(bool _autoDelete) { ref = _autoDelete ? 0 : -1; }
+    bool autoDelete() const { return ref.load() != -1; }
+    void setAutoDelete(bool _autoDelete) { ref.store(_autoDelete ? 0 : -1); }
 };
 
 QT_END_NAMESPACE
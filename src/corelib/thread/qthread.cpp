@@ -47,12 +47,134 @@
 
 #include <qeventloop.h>
 #include <qhash.h>
+#include <qvarlengtharray.h>
 
 #include "qthread_p.h"
 #include "private/qcoreapplication_p.h"
 
 QT_BEGIN_NAMESPACE
 
+/*
+  QPostEventList
+*/
+
+/*
+  Moves the events waiting in the inbox into the list of their receiver's
+  thread, oldest first, and returns how many were moved. The mutex of
+  that list must be locked; this is normally the list itself, except
+  when QObject::moveToThread() collects the events that were posted to
+  the old thread while the object was being moved.
+*/
+int QPostEventList::drainInbox()
+{
+    if (!inbox.load())
+        return 0;
+    QPostEventNode *node = inbox.fetchAndStoreAcquire(0);
+
+    // the inbox is a stack; reverse it to restore the posting order
+    QPostEventNode *fifo = 0;
+    while (node) {
+        QPostEventNode *next = node->next;
+        node->next = fifo;
+        fifo = node;
+        node = next;
+    }
+
+    int count = 0;
+    while (fifo) {
+        QPostEventNode *next = fifo->next;
+        QObjectPrivate *r = QObjectPrivate::get(fifo->event.receiver);
+        QPostEventList &list = r->threadData->postEventList;
+        if (!list.appendToLastCall(fifo->event)) {
+            list.addEvent(fifo->event);
+            ++r->postedEvents;
+        }
+        delete fifo;
+        fifo = next;
+        ++count;
+    }
+    return count;
+}
+
+static bool hasEventFilters(QObject *object)
+{
+    QObjectPrivate *d = QObjectPrivate::get(object);
+    if (!d->extraData)
+        return false;
+    // filters that have been deleted leave a null entry behind
+    const QList<QPointer<QObject> > &filters = d->extraData->eventFilters;
+    for (int i = 0; i < filters.size(); ++i) {
+        if (filters.at(i))
+            return true;
+    }
+    return false;
+}
+
+/*
+  Consecutive queued calls to the same receiver are delivered as one event,
+  see QObject::event(). If the last event in the list is a queued call to
+  the receiver of pe that has not been sent yet, the call in pe is
+  appended to it and true is returned.
+
+  Calls are not batched if an event filter would see the event, since it
+  would see one event for several calls. Event filters of the receiver and
+  of the application can only be installed from the receiver's thread and
+  the main thread, which is where the calls are moved into the list.
+*/
+bool QPostEventList::appendToLastCall(const QPostEvent &pe)
+{
+    if (isEmpty())
+        return false;
+    const QPostEvent &lastEvent = last();
+    if (!lastEvent.event || lastEvent.receiver != pe.receiver || pe.priority != Qt::NormalEventPriority
+        || lastEvent.priority != pe.priority || lastEvent.event->type() != QEvent::MetaCall)
+        return false;
+
+    QMetaCallEvent *lastCall = static_cast<QMetaCallEvent *>(lastEvent.event);
+    QMetaCallEvent *call = static_cast<QMetaCallEvent *>(pe.event);
+    if (!lastCall->canBatch() || !call->canBatch())
+        return false;
+
+    if (hasEventFilters(pe.receiver))
+        return false;
+    QCoreApplication *app = QCoreApplication::instance();
+    if (app && QObjectPrivate::get(app)->threadData == QObjectPrivate::get(pe.receiver)->threadData
+        && hasEventFilters(app))
+        return false;
+
+    // owned by lastCall from now on
+    call->posted = false;
+    lastCall->appendCall(call);
+    return true;
+}
+
+/*
+  Moves the calls to receiver that are batched behind the one being
+  delivered into target, as events of their own, and returns how many
+  events were added. Used by QObject::moveToThread() with the mutexes of
+  both lists locked.
+*/
+int QPostEventList::moveBatchedCalls(QObject *receiver, QPostEventList *target)
+{
+    // outermost batch first, in the order the calls were posted
+    QVarLengthArray<QMetaCallBatch *, 4> matching;
+    for (QMetaCallBatch *batch = batches; batch; batch = batch->outer) {
+        if (batch->receiver == receiver && !batch->cancelled.load())
+            matching.append(batch);
+    }
+
+    int count = 0;
+    for (int i = matching.size() - 1; i >= 0; --i) {
+        QMetaCallBatch *batch = matching.at(i);
+        if (QMetaCallEvent *rest = batch->event->takeCallsAfter(batch->current)) {
+            rest->posted = true;
+            target->addEvent(QPostEvent(receiver, rest, Qt::NormalEventPriority));
+            ++count;
+        }
+    }
+    return count;
+}
+
 /*
   QThreadData
 */
@@ -83,6 +205,7 @@ QThreadData::~QThreadData()
     thread = 0;
     delete t;
 
+    postEventList.drainInbox();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -91,8 +91,34 @@ inline bool operator<(const QPostEvent &first, const QPostEvent &second)
     return first.priority > second.priority;
 }
 
+// A posted event waiting in the lock-free inbox of a QPostEventList
+// Queued calls that QObject::event() is delivering as one batch, see
+// QPostEventList::appendToLastCall(). QCoreApplication::removePostedEvents()
+// cancels the calls of a batch that have not been delivered yet, and
+// QObject::moveToThread() moves them to the receiver's new thread.
+struct QMetaCallBatch
+{
+    QObject *receiver;
+    QMetaCallEvent *event;
+    QMetaCallEvent *current; // the call being delivered
+    QMetaCallBatch *outer;
+    QAtomicInt cancelled;
+};
+
+struct QPostEventNode
+{
+    QPostEvent event;
+    QPostEventNode *next;
+};
+
 // This class holds the list of posted events.
 //  The list has to be kept sorted by priority
+//
+// Events of normal priority that cannot be compressed may instead be pushed
+// onto the inbox without taking the mutex. The inbox is a lock-free stack
+// that is moved into the list in one batch by drainInbox(), which must be
+// called with the mutex held before the list is read or events are added
+// to it, so that events of equal priority stay in the order they were posted.
 class QPostEventList : public QVector<QPostEvent>
 {
 public:
@@ -106,10 +132,35 @@ public:
 
     QMutex mutex;
 
+    // events posted without the mutex, newest first
+    QAtomicPointer<QPostEventNode> inbox;
+    // number of threads about to push onto the inbox, see
+    // QCoreApplication::postEvent() and QObject::moveToThread()
+    QAtomicInt producers;
+
+    // the batches of queued calls being delivered, innermost first
+    QMetaCallBatch *batches;
+
     inline QPostEventList()
-        : QVector<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0)
+        : QVector<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0), batches(0)
     { }
 
+    inline bool hasInboxEvents() const
+    { return inbox.load() != 0; }
+
+    void enqueue(QPostEventNode *node)
+    {
+        QPostEventNode *head;
+        do {
+            head = inbox.load();
+            node->next = head;
+        } while (!inbox.testAndSetRelease(head, node));
+    }
+
+    int drainInbox();
+    bool appendToLastCall(const QPostEvent &pe);
+    int moveBatchedCalls(QObject *receiver, QPostEventList *target);
+
     void addEvent(const QPostEvent &ev) {
         int priority = ev.priority;
         if (isEmpty() ||
@@ -237,7 +288,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasInboxEvents();
     }
 
     // This class provides per-thread (by way of being a QThreadData
@@ -51,6 +51,9 @@
 #  if !defined(QT_NO_GLIB)
 #    include "../kernel/qeventdispatcher_glib_p.h"
 #  endif
+#  if defined(Q_OS_LINUX)
+#    include "../kernel/qeventdispatcher_epoll_p.h"
+#  endif
 #  include <private/qeventdispatcher_unix_p.h>
 #endif
 
@@ -266,6 +269,11 @@ void QThreadPrivate::createEventDispatcher(QThreadData *data)
 #if defined(Q_OS_BLACKBERRY)
     data->eventDispatcher.storeRelease(new QEventDispatcherBlackberry);
 #else
+#if defined(Q_OS_LINUX)
+    if (QEventDispatcherEpoll::isRequested())
+        data->eventDispatcher.storeRelease(new QEventDispatcherEpoll);
+    else
+#endif
 #if !defined(QT_NO_GLIB)
     if (qEnvironmentVariableIsEmpty("QT_NO_GLIB")
         && qEnvironmentVariableIsEmpty("QT_NO_THREADED_GLIB")
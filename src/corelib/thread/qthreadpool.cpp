@@ -58,13 +58,38 @@ class QThreadPoolThread : public QThread
 {
 public:
     QThreadPoolThread(QThreadPoolPrivate *manager);
+    ~QThreadPoolThread();
     void run();
     void registerThreadInactive();
 
+    // xorshift, to pick the first thread to steal from
+    uint nextRandom()
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    QWorkStealingDeque *localQueue; // only in work-stealing mode
+    uint seed;
 };
 
+#if defined(Q_COMPILER_THREAD_LOCAL)
+#  define Q_THREADPOOL_THREAD_LOCAL thread_local
+#elif defined(Q_OS_LINUX) && (defined(Q_CC_GNU) || defined(Q_CC_INTEL)) && !defined(QT_LINUXBASE)
+#  define Q_THREADPOOL_THREAD_LOCAL __thread
+#elif defined(Q_CC_MSVC) && !defined(Q_OS_WINCE)
+#  define Q_THREADPOOL_THREAD_LOCAL __declspec(thread)
+#endif
+
+#ifdef Q_THREADPOOL_THREAD_LOCAL
+// the pool thread running on this thread, if any
+static Q_THREADPOOL_THREAD_LOCAL QThreadPoolThread *currentPoolThread = 0;
+#endif
+
 /*
     QThreadPool private class.
 */
@@ -74,14 +99,23 @@ public:
     \internal
 */
 QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
-    :manager(manager), runnable(0)
+    :manager(manager), runnable(0), localQueue(0),
+     seed(uint(quintptr(this) >> 4) | 1)
 { }
 
+QThreadPoolThread::~QThreadPoolThread()
+{
+    delete localQueue;
+}
+
 /*
     \internal
 */
 void QThreadPoolThread::run()
 {
+#ifdef Q_THREADPOOL_THREAD_LOCAL
+    currentPoolThread = this;
+#endif
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -107,19 +141,35 @@ void QThreadPoolThread::run()
                     throw;
                 }
 #endif
-                locker.relock();
-
-                if (autoDelete && !--r->ref)
+                if (autoDelete && !r->ref.deref())
                     delete r;
+
+                // in work-stealing mode, carry on with our own and stolen
+                // tasks for as long as there are any, without the lock
+                if ((localQueue || manager->workStealing.load())
+                    && (r = manager->takeUnlockedTask(this)) != 0) {
+                    continue;
+                }
+                locker.relock();
             }
 
             // if too many threads are active, expire this thread
             if (manager->tooManyThreadsActive())
                 break;
 
-            r = !manager->queue.isEmpty() ? manager->queue.takeFirst().first : 0;
+            r = 0;
+            if (!manager->queue.isEmpty()) {
+                r = manager->queue.first().first;
+                manager->takeQueuedTask(0);
+            }
         } while (r != 0);
 
+        // tasks on our own deque must not wait for us while we sleep or exit
+        if (localQueue && manager->requeueLocalTasks(this)
+            && !manager->isExiting && !manager->tooManyThreadsActive()) {
+            continue;
+        }
+
         if (manager->isExiting) {
             registerThreadInactive();
             break;
@@ -127,6 +177,18 @@ void QThreadPoolThread::run()
 
         // if too many threads are active, expire this thread
         bool expired = manager->tooManyThreadsActive();
+        const bool stealing = !expired && manager->workStealing.load();
+        if (stealing) {
+            // Tell the threads pushing to their own deques that we are about
+            // to wait before looking at those deques a last time; they wake
+            // us up if they push after we looked.
+            manager->idleThreads.ref();
+            runnable = manager->stealTask(this);
+            if (runnable) {
+                manager->idleThreads.deref();
+                continue;
+            }
+        }
         if (!expired) {
             ++manager->waitingThreads;
             registerThreadInactive();
@@ -137,9 +199,12 @@ void QThreadPoolThread::run()
             if (expired)
                 --manager->waitingThreads;
         }
+        if (stealing)
+            manager->idleThreads.deref();
         if (expired) {
             manager->expiredThreads.enqueue(this);
             registerThreadInactive();
+            manager->updateSaturation();
             break;
         }
     }
@@ -161,9 +226,142 @@ QThreadPoolPrivate:: QThreadPoolPrivate()
       maxThreadCount(qAbs(QThread::idealThreadCount())),
       reservedThreads(0),
       waitingThreads(0),
-      activeThreads(0)
+      activeThreads(0),
+      workStealing(0),
+      stealingThreadCount(0),
+      idleThreads(0),
+      urgentTasks(0),
+      saturated(0)
 { }
 
+/*
+    Returns the pool thread we are running on if it has a deque of its own
+    to push tasks to, or 0.
+*/
+QThreadPoolThread *QThreadPoolPrivate::currentStealingThread() const
+{
+#ifdef Q_THREADPOOL_THREAD_LOCAL
+    QThreadPoolThread *thread = currentPoolThread;
+    if (thread && thread->manager == this && thread->localQueue && workStealing.load())
+        return thread;
+#endif
+    return 0;
+}
+
+/*
+    Pushes \a runnable onto the deque of \a thread, which must be the
+    current thread, and makes sure that an idle thread comes to steal it.
+    Returns false if the deque is full.
+*/
+bool QThreadPoolPrivate::pushLocalTask(QThreadPoolThread *thread, QRunnable *runnable)
+{
+    const bool autoDelete = runnable->autoDelete();
+    if (autoDelete)
+        runnable->ref.ref();
+    if (!thread->localQueue->push(runnable)) {
+        if (autoDelete)
+            runnable->ref.deref();
+        return false;
+    }
+
+    // only take the lock if there is a thread to wake up or to start
+    if (idleThreads.load() || !saturated.load()) {
+        QMutexLocker locker(&mutex);
+        if (waitingThreads > 0) {
+            --waitingThreads;
+            runnableReady.wakeOne();
+        } else if (!isExiting && activeThreadCount() < maxThreadCount) {
+            // start a thread that will find the task by stealing it
+            if (!expiredThreads.isEmpty()) {
+                QThreadPoolThread *expiredThread = expiredThreads.dequeue();
+                Q_ASSERT(expiredThread->runnable == 0);
+                ++activeThreads;
+                expiredThread->start();
+            } else {
+                startThread();
+            }
+        }
+        updateSaturation();
+    }
+    return true;
+}
+
+/*
+    Returns a task for \a thread to run next without taking the lock: the
+    most recent one from its own deque, or one stolen from another thread.
+    Returns 0 if there is none, or if queued tasks with a higher priority
+    are waiting.
+*/
+QRunnable *QThreadPoolPrivate::takeUnlockedTask(QThreadPoolThread *thread)
+{
+    if (urgentTasks.load())
+        return 0;
+    if (thread->localQueue) {
+        if (QRunnable *runnable = thread->localQueue->pop())
+            return runnable;
+    }
+    return workStealing.load() ? stealTask(thread) : 0;
+}
+
+/*
+    Takes the oldest task from the deque of another thread, starting with
+    a random one.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    const int count = stealingThreadCount.loadAcquire();
+    if (count == 0)
+        return 0;
+    const uint first = thief->nextRandom() % uint(count);
+    for (int i = 0; i < count; ++i) {
+        QThreadPoolThread *victim = stealingThreads[(first + i) % uint(count)].load();
+        if (victim == thief)
+            continue;
+        // steal() fails when another thread got there first; try again
+        // for as long as the deque has tasks
+        do {
+            if (QRunnable *runnable = victim->localQueue->steal())
+                return runnable;
+        } while (!victim->localQueue->isEmpty());
+    }
+    return 0;
+}
+
+/*
+    Moves the tasks left on the deque of \a thread to the shared queue.
+    Must be called by that thread with the lock held. Returns the number
+    of tasks moved.
+*/
+int QThreadPoolPrivate::requeueLocalTasks(QThreadPoolThread *thread)
+{
+    int count = 0;
+    while (QRunnable *runnable = thread->localQueue->pop()) {
+        insertTask(runnable, 0);
+        ++count;
+    }
+    return count;
+}
+
+/*
+    Removes the task at \a index from the shared queue.
+*/
+void QThreadPoolPrivate::takeQueuedTask(int index)
+{
+    if (queue.at(index).second > 0)
+        urgentTasks.deref();
+    queue.removeAt(index);
+}
+
+/*
+    Updates the hint that tells threads pushing to their own deques
+    whether the pool could start another thread. Must be called with the
+    lock held.
+*/
+void QThreadPoolPrivate::updateSaturation()
+{
+    saturated.store(activeThreadCount() >= maxThreadCount);
+}
+
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
 {
     if (allThreads.isEmpty()) {
@@ -192,9 +390,10 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
         ++activeThreads;
 
         if (task->autoDelete())
-            ++task->ref;
+            task->ref.ref();
         thread->runnable = task;
         thread->start();
+        updateSaturation();
         return true;
     }
 
@@ -211,7 +410,14 @@ inline bool operator<(const QPair<QRunnable *, int> &p, int priority)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     if (runnable->autoDelete())
-        ++runnable->ref;
+        runnable->ref.ref();
+    insertTask(runnable, priority);
+}
+
+void QThreadPoolPrivate::insertTask(QRunnable *runnable, int priority)
+{
+    if (priority > 0)
+        urgentTasks.ref();
 
     // put it on the queue
     QList<QPair<QRunnable *, int> >::const_iterator begin = queue.constBegin();
@@ -233,7 +439,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
 {
     // try to push tasks on the queue to any available threads
     while (!queue.isEmpty() && tryStart(queue.first().first))
-        queue.removeFirst();
+        takeQueuedTask(0);
 }
 
 bool QThreadPoolPrivate::tooManyThreadsActive() const
@@ -252,10 +458,18 @@ void QThreadPoolPrivate::startThread(QRunnable *runnable)
     allThreads.insert(thread.data());
     ++activeThreads;
 
-    if (runnable->autoDelete())
-        ++runnable->ref;
+    const int stealingThreadIndex = stealingThreadCount.load();
+    if (workStealing.load() && stealingThreadIndex < MaxStealingThreads) {
+        thread->localQueue = new QWorkStealingDeque;
+        stealingThreads[stealingThreadIndex].store(thread.data());
+        stealingThreadCount.storeRelease(stealingThreadIndex + 1);
+    }
+
+    if (runnable && runnable->autoDelete())
+        runnable->ref.ref();
     thread->runnable = runnable;
     thread.take()->start();
+    updateSaturation();
 }
 
 /*!
@@ -285,6 +499,10 @@ void QThreadPoolPrivate::reset()
 
     waitingThreads = 0;
     expiredThreads.clear();
+    for (int i = 0; i < stealingThreadCount.load(); ++i)
+        stealingThreads[i].store(0);
+    stealingThreadCount.store(0);
+    updateSaturation();
 
     isExiting = false;
 }
@@ -312,10 +530,21 @@ void QThreadPoolPrivate::clear()
     for (QList<QPair<QRunnable *, int> >::const_iterator it = queue.constBegin();
          it != queue.constEnd(); ++it) {
         QRunnable* r = it->first;
-        if (r->autoDelete() && !--r->ref)
+        if (r->autoDelete() && !r->ref.deref())
             delete r;
     }
     queue.clear();
+    urgentTasks.store(0);
+
+    // the tasks that were pushed to the threads' own deques
+    for (int i = 0; i < stealingThreadCount.load(); ++i) {
+        QWorkStealingDeque *deque = stealingThreads[i].load()->localQueue;
+        while (!deque->isEmpty()) {
+            QRunnable *r = deque->steal();
+            if (r && r->autoDelete() && !r->ref.deref())
+                delete r;
+        }
+    }
 }
 
 /*!
@@ -331,13 +560,25 @@ void QThreadPoolPrivate::stealRunnable(QRunnable *runnable)
     bool found = false;
     {
         QMutexLocker locker(&mutex);
+#ifdef Q_THREADPOOL_THREAD_LOCAL
+        // A pool thread about to block must not hold on to the tasks on its
+        // own deque: the one waited for is taken from the shared queue below,
+        // and waiting threads are woken up for the others.
+        QThreadPoolThread *thread = currentPoolThread;
+        if (thread && thread->manager == this && thread->localQueue) {
+            for (int moved = requeueLocalTasks(thread); moved > 0 && waitingThreads > 0; --moved) {
+                --waitingThreads;
+                runnableReady.wakeOne();
+            }
+        }
+#endif
         QList<QPair<QRunnable *, int> >::iterator it = queue.begin();
         QList<QPair<QRunnable *, int> >::iterator end = queue.end();
 
         while (it != end) {
             if (it->first == runnable) {
                 found = true;
-                queue.erase(it);
+                takeQueuedTask(it - queue.begin());
                 break;
             }
             ++it;
@@ -348,7 +589,7 @@ void QThreadPoolPrivate::stealRunnable(QRunnable *runnable)
         return;
 
     const bool autoDelete = runnable->autoDelete();
-    bool del = autoDelete && !--runnable->ref;
+    bool del = autoDelete && !runnable->ref.deref();
 
     runnable->run();
 
@@ -455,6 +696,13 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0) {
+        if (QThreadPoolThread *thread = d->currentStealingThread()) {
+            if (d->pushLocalTask(thread, runnable))
+                return;
+        }
+    }
+
     QMutexLocker locker(&d->mutex);
     if (!d->tryStart(runnable)) {
         d->enqueueTask(runnable, priority);
@@ -552,6 +800,7 @@ void QThreadPool::setMaxThreadCount(int maxThreadCount)
 
     d->maxThreadCount = maxThreadCount;
     d->tryToStartMoreThreads();
+    d->updateSaturation();
 }
 
 /*! \property QThreadPool::activeThreadCount
@@ -571,6 +820,44 @@ int QThreadPool::activeThreadCount() const
     return d->activeThreadCount();
 }
 
+/*! \property QThreadPool::workStealingEnabled
+    \since 5.3
+
+    This property holds whether the thread pool balances its work by work
+    stealing.
+
+    By default, all runnables go through one queue that is shared by the
+    threads of the pool and ordered by priority. With work stealing
+    enabled, each thread of the pool also has a queue of its own:
+    runnables that a runnable in the pool starts with the default priority
+    are put on the queue of its thread without locking, each thread runs
+    the most recent runnables from its own queue first, and threads that
+    run out of work take the oldest runnables from the queues of other
+    threads. This helps when many short runnables are started from within
+    the pool, for example by recursively splitting up work.
+
+    Runnables started from outside the pool or with a priority other than
+    0 still go through the shared queue, and queued runnables with a
+    priority above 0 are run before those on the threads' own queues.
+
+    The default value is false. Threads that were started before work
+    stealing was enabled do not get a queue of their own, so it is best
+    enabled before the first call to start().
+*/
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.load();
+}
+
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->workStealing.store(enabled);
+}
+
 /*!
     Reserves one thread, disregarding activeThreadCount() and maxThreadCount().
 
@@ -588,6 +875,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateSaturation();
 }
 
 /*!
@@ -608,6 +896,7 @@ void QThreadPool::releaseThread()
     QMutexLocker locker(&d->mutex);
     --d->reservedThreads;
     d->tryToStartMoreThreads();
+    d->updateSaturation();
 }
 
 /*!
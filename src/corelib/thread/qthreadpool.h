@@ -60,6 +60,7 @@ class Q_CORE_EXPORT QThreadPool : public QObject
     Q_PROPERTY(int expiryTimeout READ expiryTimeout WRITE setExpiryTimeout)
     Q_PROPERTY(int maxThreadCount READ maxThreadCount WRITE setMaxThreadCount)
     Q_PROPERTY(int activeThreadCount READ activeThreadCount)
+    Q_PROPERTY(bool workStealingEnabled READ isWorkStealingEnabled WRITE setWorkStealingEnabled)
     friend class QFutureInterfaceBase;
 
 public:
@@ -79,6 +80,9 @@ public:
 
     int activeThreadCount() const;
 
+    bool isWorkStealingEnabled() const;
+    void setWorkStealingEnabled(bool enabled);
+
     void reserveThread();
     void releaseThread();
 
@@ -65,6 +65,79 @@
 QT_BEGIN_NAMESPACE
 
 class QThreadPoolThread;
+
+/*
+    The task deque of one pool thread in work-stealing mode, after Chase and
+    Lev. The owning thread pushes and pops at the bottom without locking,
+    other threads steal from the top. The capacity is fixed; when it is
+    full, tasks go to the pool's shared queue instead.
+*/
+class QWorkStealingDeque
+{
+public:
+    enum { Capacity = 4096 };
+
+    QWorkStealingDeque()
+        : top(0), bottom(0)
+    { }
+
+    // owner only
+    bool push(QRunnable *runnable)
+    {
+        const int b = bottom.load();
+        if (distance(top.loadAcquire(), b) >= int(Capacity))
+            return false;
+        tasks[b & (Capacity - 1)].store(runnable);
+        bottom.storeRelease(b + 1);
+        return true;
+    }
+
+    // owner only
+    QRunnable *pop()
+    {
+        const int b = bottom.load() - 1;
+        bottom.fetchAndStoreOrdered(b);
+        const int t = top.load();
+        if (distance(t, b) < 0) {
+            bottom.store(b + 1);
+            return 0;
+        }
+        QRunnable *runnable = tasks[b & (Capacity - 1)].load();
+        if (t == b) {
+            // the last task; a thief may be taking it as well
+            if (!top.testAndSetOrdered(t, t + 1))
+                runnable = 0;
+            bottom.store(b + 1);
+        }
+        return runnable;
+    }
+
+    // any thread; may fail spuriously when racing with other threads
+    QRunnable *steal()
+    {
+        const int t = top.fetchAndAddOrdered(0);
+        const int b = bottom.loadAcquire();
+        if (distance(t, b) <= 0)
+            return 0;
+        QRunnable *runnable = tasks[t & (Capacity - 1)].load();
+        if (!top.testAndSetOrdered(t, t + 1))
+            return 0;
+        return runnable;
+    }
+
+    bool isEmpty() const
+    { return distance(top.load(), bottom.load()) <= 0; }
+
+private:
+    // the indexes only ever grow and may wrap around
+    static int distance(int from, int to)
+    { return int(uint(to) - uint(from)); }
+
+    QAtomicInt top;
+    QAtomicInt bottom;
+    QAtomicPointer<QRunnable> tasks[Capacity];
+};
+
 class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QThreadPool)
@@ -75,6 +148,7 @@ public:
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
+    void insertTask(QRunnable *task, int priority);
     int activeThreadCount() const;
 
     void tryToStartMoreThreads();
@@ -86,6 +160,14 @@ public:
     void clear();
     void stealRunnable(QRunnable *);
 
+    QThreadPoolThread *currentStealingThread() const;
+    bool pushLocalTask(QThreadPoolThread *thread, QRunnable *runnable);
+    QRunnable *takeUnlockedTask(QThreadPoolThread *thread);
+    QRunnable *stealTask(QThreadPoolThread *thief);
+    int requeueLocalTasks(QThreadPoolThread *thread);
+    void takeQueuedTask(int index);
+    void updateSaturation();
+
     mutable QMutex mutex;
     QWaitCondition runnableReady;
     QSet<QThreadPoolThread *> allThreads;
@@ -99,6 +181,16 @@ public:
     int reservedThreads;
     int waitingThreads;
     int activeThreads;
+
+    // work stealing; the threads that own a deque are listed in
+    // stealingThreads, which only grows until the pool is reset
+    enum { MaxStealingThreads = 256 };
+    QAtomicInt workStealing;
+    QAtomicPointer<QThreadPoolThread> stealingThreads[MaxStealingThreads];
+    QAtomicInt stealingThreadCount;
+    QAtomicInt idleThreads;     // threads looking for tasks before they wait
+    QAtomicInt urgentTasks;     // queued tasks with a priority above 0
+    QAtomicInt saturated;       // activeThreadCount() >= maxThreadCount
 };
 
 QT_END_NAMESPACE
@@ -214,9 +214,13 @@ bool QWaitCondition::wait(QMutex *mutex, unsigned long time)
 
 bool QWaitCondition::wait(QReadWriteLock *readWriteLock, unsigned long time)
 {
-    if (!readWriteLock || readWriteLock->d->accessCount == 0)
+    if (!readWriteLock)
         return false;
-    if (readWriteLock->d->accessCount < -1) {
+    const QReadWriteLockPrivate::StateForWaitCondition previousState =
+            readWriteLock->d->stateForWaitCondition();
+    if (previousState == QReadWriteLockPrivate::Unlocked)
+        return false;
+    if (previousState == QReadWriteLockPrivate::RecursivelyWriteLocked) {
         qWarning("QWaitCondition: cannot wait on QReadWriteLocks with recursive lockForWrite()");
         return false;
     }
@@ -224,12 +228,11 @@ bool QWaitCondition::wait(QReadWriteLock *readWriteLock, unsigned long time)
     report_error(pthread_mutex_lock(&d->mutex), "QWaitCondition::wait()", "mutex lock");
     ++d->waiters;
 
-    int previousAccessCount = readWriteLock->d->accessCount;
     readWriteLock->unlock();
 
     bool returnValue = d->wait(time);
 
-    if (previousAccessCount < 0)
+    if (previousState == QReadWriteLockPrivate::WriteLocked)
         readWriteLock->lockForWrite();
     else
         readWriteLock->lockForRead();
@@ -0,0 +1,377 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qarena.h"
+#include "qthread.h"
+
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+// Blocks grow geometrically, so that a busy arena asks the system for
+// memory only a few times.
+static const size_t MaxBlockGrowth = 16 * 1024 * 1024;
+
+struct QArena::Block
+{
+    Block *next;
+    char *end;
+
+    char *data() { return reinterpret_cast<char *>(this + 1); }
+};
+
+// Every allocation is preceded by a header naming the arena it came from,
+// so that finding the owner of a pointer does not depend on the number of
+// blocks or arenas. The payload is at least pointer-sized, which leaves
+// room to link the allocation into QArena::m_released when it is released
+// from another thread.
+struct QArena::Header
+{
+    QArena *arena;
+    size_t size;
+
+    static Header *of(const void *ptr)
+    { return const_cast<Header *>(static_cast<const Header *>(ptr) - 1); }
+    Header *&nextReleased() { return *reinterpret_cast<Header **>(this + 1); }
+};
+
+/*!
+    \class QArena
+    \inmodule QtCore
+    \since 5.3
+    \brief The QArena class provides a bump allocator for short-lived
+    data.
+
+    \ingroup tools
+    \reentrant
+
+    A QArena hands out memory from large blocks obtained from the system,
+    by advancing a pointer. Individual allocations are not returned to the
+    system; instead, reset() recycles all of them at once, and the
+    destructor releases the blocks. Code that builds many temporary
+    objects, such as the parser of a single request, then costs a few
+    block allocations instead of one malloc() and free() per object.
+
+    The arena is only used by code that asks for it: either directly
+    through allocate() and deallocate(), or through QArenaAllocator, which
+    lets standard containers keep their elements in an arena:
+
+    \code
+    QArena arena;
+    for (;;) {
+        std::vector<Token, QArenaAllocator<Token> > tokens((QArenaAllocator<Token>(&arena)));
+        parseRequest(nextRequest(), &tokens);
+        handleTokens(tokens);
+        tokens.clear();
+        arena.reset();
+    }
+    \endcode
+
+    The implicitly shared Qt containers, such as QString, QVector, QList
+    and QHash, always allocate from the system heap: their data can be
+    shared with copies that outlive the arena or are used in other
+    threads.
+
+    Every allocation records the arena it belongs to, so owner() and
+    deallocate() take constant time. Releasing the most recent allocation
+    makes its memory available again straight away.
+
+    Only the thread that created the arena may allocate from it or reset
+    it. Memory may be released from any thread; releases from other
+    threads are only accounted for, and the memory itself is reused once
+    the arena is reset.
+
+    \warning Memory from an arena must not be used after the arena has
+    been reset or destroyed.
+
+    \sa QArenaAllocator
+*/
+
+/*!
+    \enum QArena::anonymous
+
+    \value DefaultBlockSize The size of the first block of an arena, if
+           none is given to the constructor.
+    \value DefaultAlignment The alignment of the memory returned by
+           allocate() when no alignment is requested.
+*/
+
+/*!
+    Constructs an arena whose first block holds \a blockSize bytes. No
+    memory is allocated until the first allocation. The arena belongs to
+    the thread that constructs it.
+*/
+QArena::QArena(int blockSize)
+    : m_blocks(0), m_cursor(0), m_limit(0), m_last(0), m_size(0),
+      m_blockSize(qMax(blockSize, 256)), m_thread(QThread::currentThreadId()),
+      m_released(0)
+{
+}
+
+/*!
+    Destroys the arena and releases all of its memory.
+*/
+QArena::~QArena()
+{
+    while (m_blocks) {
+        Block *b = m_blocks;
+        m_blocks = b->next;
+        ::free(b);
+    }
+}
+
+/*!
+    Allocates \a size bytes aligned to \a alignment, which must be a power
+    of two, and returns a pointer to them. Alignments smaller than a
+    pointer are rounded up.
+
+    The memory stays valid until it is passed to deallocate(), or until
+    the arena is reset or destroyed. This function may only be called from
+    the thread that created the arena.
+*/
+void *QArena::allocate(size_t size, size_t alignment)
+{
+    Q_ASSERT(alignment && !(alignment & (alignment - 1)));
+    Q_ASSERT_X(m_thread == QThread::currentThreadId(), "QArena::allocate",
+               "Arena used in a different thread");
+    alignment = qMax(alignment, sizeof(void *));
+    const size_t used = qMax(size, sizeof(void *));
+    if (m_cursor) {
+        const quintptr p = (quintptr(m_cursor) + sizeof(Header) + alignment - 1) & ~quintptr(alignment - 1);
+        if (p <= quintptr(m_limit) && used <= size_t(quintptr(m_limit) - p)) {
+            char *ptr = reinterpret_cast<char *>(p);
+            Header *h = Header::of(ptr);
+            h->arena = this;
+            h->size = size;
+            m_cursor = ptr + used;
+            m_last = ptr;
+            m_size += size;
+            return ptr;
+        }
+    }
+    return allocateSlow(size, alignment);
+}
+
+void *QArena::allocateSlow(size_t size, size_t alignment)
+{
+    collectReleased();
+
+    const size_t needed = qMax(size, sizeof(void *)) + sizeof(Header) + alignment;
+    size_t blockSize = m_blockSize;
+    if (m_blocks)
+        blockSize = qMax(blockSize, qMin(size_t(m_blocks->end - m_blocks->data()) * 2, MaxBlockGrowth));
+    blockSize = qMax(blockSize, needed);
+
+    Block *b = static_cast<Block *>(::malloc(sizeof(Block) + blockSize));
+    Q_CHECK_PTR(b);
+    b->end = b->data() + blockSize;
+    b->next = m_blocks;
+    m_blocks = b;
+    m_cursor = b->data();
+    m_limit = b->end;
+    return allocate(size, alignment);
+}
+
+/*!
+    Releases \a ptr, which must have been returned by allocate() and not
+    been released yet. Passing a null pointer does nothing.
+
+    On the thread that created the arena, the memory of the most recent
+    allocation becomes available again at once. This function may be
+    called from any thread.
+*/
+void QArena::deallocate(void *ptr)
+{
+    if (!ptr)
+        return;
+    Header *h = Header::of(ptr);
+    Q_ASSERT_X(h->arena == this, "QArena::deallocate", "Pointer does not belong to this arena");
+
+    if (m_thread != QThread::currentThreadId()) {
+        // leave the blocks alone; the owning thread accounts for the
+        // release the next time it needs to
+        Header *head;
+        do {
+            head = m_released.load();
+            h->nextReleased() = head;
+        } while (!m_released.testAndSetRelease(head, h));
+        return;
+    }
+
+    collectReleased();
+    m_size -= h->size;
+    if (ptr == m_last) {
+        m_cursor = reinterpret_cast<char *>(h);
+        m_last = 0;
+    }
+}
+
+void QArena::collectReleased()
+{
+    Header *h = m_released.fetchAndStoreAcquire(0);
+    while (h) {
+        m_size -= h->size;
+        h = h->nextReleased();
+    }
+}
+
+/*!
+    Returns \c true if \a ptr was handed out by this arena; otherwise
+    returns \c false. \a ptr must be null or have been returned by the
+    allocate() function of some QArena.
+
+    \sa owner()
+*/
+bool QArena::owns(const void *ptr) const
+{
+    return ptr && Header::of(ptr)->arena == this;
+}
+
+/*!
+    Returns the arena that handed out \a ptr, which must have been
+    returned by allocate() and not been released yet, or 0 if \a ptr is
+    null. This takes constant time.
+*/
+QArena *QArena::owner(const void *ptr)
+{
+    return ptr ? Header::of(ptr)->arena : 0;
+}
+
+/*!
+    Makes all memory handed out by the arena available again. The largest
+    block is kept for the allocations that follow; the others are
+    released. This function may only be called from the thread that
+    created the arena.
+
+    Any memory still in use from the arena becomes invalid.
+*/
+void QArena::reset()
+{
+    Q_ASSERT_X(m_thread == QThread::currentThreadId(), "QArena::reset",
+               "Arena used in a different thread");
+    m_released.store(0);
+    m_size = 0;
+    m_last = 0;
+    if (!m_blocks)
+        return;
+    while (Block *b = m_blocks->next) {
+        m_blocks->next = b->next;
+        ::free(b);
+    }
+    m_cursor = m_blocks->data();
+    m_limit = m_blocks->end;
+}
+
+/*!
+    Returns the number of bytes currently handed out by the arena and not
+    released.
+
+    \sa capacity()
+*/
+qint64 QArena::size() const
+{
+    qint64 size = m_size;
+    for (Header *h = m_released.loadAcquire(); h; h = h->nextReleased())
+        size -= h->size;
+    return size;
+}
+
+/*!
+    Returns the number of bytes the arena has obtained from the system.
+
+    \sa size()
+*/
+qint64 QArena::capacity() const
+{
+    qint64 total = 0;
+    for (const Block *b = m_blocks; b; b = b->next)
+        total += b->end - reinterpret_cast<const char *>(b + 1);
+    return total;
+}
+
+/*!
+    \class QArenaAllocator
+    \inmodule QtCore
+    \since 5.3
+    \brief The QArenaAllocator class lets standard containers allocate
+    from a QArena.
+
+    \ingroup tools
+    \reentrant
+
+    QArenaAllocator meets the requirements of a C++ standard library
+    allocator. A container opts into an arena by being constructed with
+    an allocator for it:
+
+    \code
+    QArena arena;
+    typedef std::map<int, QByteArray, std::less<int>,
+                     QArenaAllocator<std::pair<const int, QByteArray> > > Map;
+    Map map((std::less<int>()), Map::allocator_type(&arena));
+    \endcode
+
+    The container must be destroyed before the arena is reset or
+    destroyed. Only the arena's own thread may insert into the container,
+    but it may be destroyed on any thread.
+
+    \sa QArena
+*/
+
+/*!
+    \fn QArenaAllocator::QArenaAllocator(QArena *arena)
+
+    Constructs an allocator that takes memory from \a arena.
+*/
+
+/*!
+    \fn QArenaAllocator::QArenaAllocator(const QArenaAllocator<U> &other)
+
+    Constructs an allocator for the arena of \a other.
+*/
+
+/*!
+    \fn QArena *QArenaAllocator::arena() const
+
+    Returns the arena this allocator takes memory from.
+*/
+
+QT_END_NAMESPACE
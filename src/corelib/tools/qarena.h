@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QARENA_H
+#define QARENA_H
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qnamespace.h>
+
+#include <new>
+
+QT_BEGIN_NAMESPACE
+
+
+class Q_CORE_EXPORT QArena
+{
+public:
+    enum { DefaultBlockSize = 64 * 1024 };
+    enum { DefaultAlignment = 2 * sizeof(void *) };
+
+    explicit QArena(int blockSize = DefaultBlockSize);
+    ~QArena();
+
+    void *allocate(size_t size, size_t alignment = DefaultAlignment);
+    void deallocate(void *ptr);
+    bool owns(const void *ptr) const;
+    void reset();
+
+    qint64 size() const;
+    qint64 capacity() const;
+
+    static QArena *owner(const void *ptr);
+
+private:
+    Q_DISABLE_COPY(QArena)
+
+    struct Block;
+    struct Header;
+
+    void *allocateSlow(size_t size, size_t alignment);
+    void collectReleased();
+
+    Block *m_blocks;
+    char *m_cursor;
+    char *m_limit;
+    char *m_last;
+    qint64 m_size;
+    int m_blockSize;
+    Qt::HANDLE m_thread;
+    QAtomicPointer<Header> m_released;
+};
+
+template <typename T>
+class QArenaAllocator
+{
+public:
+    typedef T value_type;
+    typedef T *pointer;
+    typedef const T *const_pointer;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind { typedef QArenaAllocator<U> other; };
+
+    explicit QArenaAllocator(QArena *arena) : m_arena(arena) { Q_ASSERT(arena); }
+    template <typename U>
+    QArenaAllocator(const QArenaAllocator<U> &other) : m_arena(other.arena()) {}
+
+    QArena *arena() const { return m_arena; }
+
+    pointer allocate(size_type n, const void * = 0)
+    { return static_cast<pointer>(m_arena->allocate(n * sizeof(T), Q_ALIGNOF(T))); }
+    void deallocate(pointer p, size_type) { m_arena->deallocate(p); }
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+    size_type max_size() const { return size_type(-1) / sizeof(T); }
+    void construct(pointer p, const T &t) { new (p) T(t); }
+    void destroy(pointer p) { p->~T(); }
+
+private:
+    QArena *m_arena;
+};
+
+template <typename T, typename U>
+inline bool operator==(const QArenaAllocator<T> &a, const QArenaAllocator<U> &b)
+{ return a.arena() == b.arena(); }
+template <typename T, typename U>
+inline bool operator!=(const QArenaAllocator<T> &a, const QArenaAllocator<U> &b)
+{ return a.arena() != b.arena(); }
+
+QT_END_NAMESPACE
+
+#endif // QARENA_H
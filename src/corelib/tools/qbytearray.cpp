@@ -42,11 +42,13 @@
 #include "qbytearray.h"
 #include "qbytearraymatcher.h"
 #include "qtools_p.h"
+#include "qsimd_p.h"
 #include "qstring.h"
 #include "qlist.h"
 #include "qlocale.h"
 #include "qlocale_p.h"
 #include "qscopedpointer.h"
+#include "qvarlengtharray.h"
 #include <qdatastream.h>
 
 #ifndef QT_NO_COMPRESS
@@ -2335,11 +2337,9 @@ int QByteArray::indexOf(char ch, int from) const
     if (from < 0)
         from = qMax(from + d->size, 0);
     if (from < d->size) {
-        const char *n = d->data() + from - 1;
-        const char *e = d->data() + d->size;
-        while (++n != e)
-        if (*n == ch)
-            return  n - d->data();
+        const char *n = static_cast<const char *>(memchr(d->data() + from, ch, d->size - from));
+        if (n)
+            return n - d->data();
     }
     return -1;
 }
@@ -2511,11 +2511,30 @@ int QByteArray::count(const char *str) const
 
 int QByteArray::count(char ch) const
 {
+    const uchar *b = reinterpret_cast<const uchar *>(d->data());
+    const uchar *e = b + d->size;
     int num = 0;
-    const char *i = d->data() + d->size;
-    const char *b = d->data();
-    while (i != b)
-        if (*--i == ch)
+#if defined(QT_COMPILER_SUPPORTS_AVX2) && !defined(QT_BOOTSTRAPPED)
+    if (qCpuHasFeature(AVX2)) {
+        extern int qt_count_char_avx2(const uchar *&b, const uchar *e, uchar c);
+        num = qt_count_char_avx2(b, e, ch);
+    }
+#endif
+#if defined(__SSE2__)
+    // The comparison yields -1 for every match, so subtracting it counts the
+    // matches in each byte lane. The lanes are summed before they overflow.
+    const __m128i c = _mm_set1_epi8(ch);
+    while (e - b >= 16) {
+        const uchar *chunkEnd = b + qMin<qptrdiff>((e - b) & ~qptrdiff(15), 255 * 16);
+        __m128i counts = _mm_setzero_si128();
+        for ( ; b != chunkEnd; b += 16)
+            counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)b), c));
+        counts = _mm_sad_epu8(counts, _mm_setzero_si128());
+        num += _mm_cvtsi128_si32(counts) + _mm_cvtsi128_si32(_mm_srli_si128(counts, 8));
+    }
+#endif
+    for ( ; b != e; ++b)
+        if (*b == uchar(ch))
             ++num;
     return num;
 }
@@ -4367,4 +4386,622 @@ QByteArray QByteArray::toPercentEncoding(const QByteArray &exclude, const QByteA
     \internal
 */
 
+/*!
+    \class QByteArrayView
+    \inmodule QtCore
+    \since 5.3
+    \brief The QByteArrayView class provides a non-owning view on a sequence of bytes.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    \reentrant
+
+    QByteArrayView provides a read-only subset of the QByteArray API
+    that operates on a pointer and a size, without reference counting
+    and without requiring the bytes to be stored in a QByteArray.
+
+    A QByteArrayView can be constructed implicitly from a QByteArray or
+    from a '\\0'-terminated string, so functions taking a QByteArrayView
+    accept both without a conversion cost. Slicing with left(), mid(),
+    right() and trimmed() only adjusts the pointer and the size. The
+    number conversion functions parse the bytes without allocating on
+    the heap.
+
+    Calling toByteArray() returns a copy of the data as a real
+    QByteArray instance.
+
+    \warning A QByteArrayView is only valid as long as the bytes it
+    refers to exist. If the underlying data is modified or deleted, the
+    view points to an invalid memory location.
+
+    \sa QByteArray, QStringView
+*/
+
+/*!
+    \typedef QByteArrayView::value_type
+    Typedef for \c char.
+*/
+
+/*!
+    \typedef QByteArrayView::const_iterator
+    Typedef for \c{const char *}.
+*/
+
+/*!
+    \typedef QByteArrayView::iterator
+    Typedef for \c{const char *}. A QByteArrayView never modifies the
+    bytes it refers to.
+*/
+
+/*!
+    \fn QByteArrayView::QByteArrayView()
+
+    Constructs a null byte array view.
+
+    \sa isNull()
+*/
+
+/*!
+    \fn QByteArrayView::QByteArrayView(const char *data, int size)
+
+    Constructs a view on the first \a size bytes of \a data.
+*/
+
+/*!
+    \fn QByteArrayView::QByteArrayView(const char *data)
+
+    Constructs a view on the '\\0'-terminated string \a data, not
+    including the terminator. The view is null if \a data is 0.
+*/
+
+/*!
+    \fn QByteArrayView::QByteArrayView(const QByteArray &ba)
+
+    Constructs a view on the whole of \a ba. The view is null if \a ba
+    is null.
+*/
+
+/*!
+    \fn int QByteArrayView::size() const
+
+    Returns the number of bytes in the view.
+*/
+
+/*!
+    \fn int QByteArrayView::length() const
+
+    Same as size().
+*/
+
+/*!
+    \fn bool QByteArrayView::isEmpty() const
+
+    Returns \c true if the view has no bytes; otherwise returns \c false.
+*/
+
+/*!
+    \fn bool QByteArrayView::isNull() const
+
+    Returns \c true if the view does not refer to any data; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn const char *QByteArrayView::data() const
+
+    Returns a pointer to the first byte of the view. The data is not
+    necessarily '\\0'-terminated.
+*/
+
+/*!
+    \fn const char *QByteArrayView::constData() const
+
+    Same as data().
+*/
+
+/*!
+    \fn char QByteArrayView::at(int i) const
+
+    Returns the byte at index position \a i. \a i must be a valid index
+    position in the view.
+*/
+
+/*!
+    \fn char QByteArrayView::operator[](int i) const
+
+    Same as at(\a i).
+*/
+
+/*!
+    \fn QByteArrayView::const_iterator QByteArrayView::begin() const
+
+    Returns an STL-style iterator pointing to the first byte in the view.
+*/
+
+/*!
+    \fn QByteArrayView::const_iterator QByteArrayView::cbegin() const
+
+    Same as begin().
+*/
+
+/*!
+    \fn QByteArrayView::const_iterator QByteArrayView::end() const
+
+    Returns an STL-style iterator pointing to the imaginary byte after
+    the last byte in the view.
+*/
+
+/*!
+    \fn QByteArrayView::const_iterator QByteArrayView::cend() const
+
+    Same as end().
+*/
+
+/*!
+    \fn void QByteArrayView::truncate(int pos)
+
+    Shrinks the view to the first \a pos bytes. If \a pos is beyond the
+    end of the view, nothing happens.
+*/
+
+/*!
+    \fn void QByteArrayView::chop(int n)
+
+    Removes \a n bytes from the end of the view. If \a n is greater than
+    size(), the result is an empty view.
+*/
+
+/*!
+    \fn bool QByteArrayView::contains(char c) const
+
+    Returns \c true if the view contains the byte \a c; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool QByteArrayView::contains(QByteArrayView a) const
+    \overload contains()
+*/
+
+/*!
+    \fn int QByteArrayView::indexOf(const QByteArray &a, int from) const
+    \overload indexOf()
+*/
+
+/*!
+    \fn int QByteArrayView::indexOf(const char *a, int from) const
+    \overload indexOf()
+*/
+
+/*!
+    \fn bool QByteArrayView::contains(const QByteArray &a) const
+    \overload contains()
+*/
+
+/*!
+    \fn bool QByteArrayView::contains(const char *a) const
+    \overload contains()
+*/
+
+/*!
+    \fn bool QByteArrayView::startsWith(const QByteArray &a) const
+    \overload startsWith()
+*/
+
+/*!
+    \fn bool QByteArrayView::startsWith(const char *a) const
+    \overload startsWith()
+*/
+
+/*!
+    \fn bool QByteArrayView::endsWith(const QByteArray &a) const
+    \overload endsWith()
+*/
+
+/*!
+    \fn bool QByteArrayView::endsWith(const char *a) const
+    \overload endsWith()
+*/
+
+/*!
+    \fn bool QByteArrayView::startsWith(char c) const
+    \overload startsWith()
+*/
+
+/*!
+    \fn bool QByteArrayView::endsWith(char c) const
+    \overload endsWith()
+*/
+
+/*!
+    Returns a view on the \a n leftmost bytes.
+
+    The whole view is returned if \a n is greater than size(), and an
+    empty view if \a n is negative, as with QByteArray::left().
+
+    \sa right(), mid()
+*/
+QByteArrayView QByteArrayView::left(int n) const
+{
+    if (n >= m_size)
+        return *this;
+    return QByteArrayView(m_data, qMax(n, 0));
+}
+
+/*!
+    Returns a view on the \a n rightmost bytes.
+
+    The whole view is returned if \a n is greater than size(), and an
+    empty view if \a n is negative, as with QByteArray::right().
+
+    \sa left(), mid()
+*/
+QByteArrayView QByteArrayView::right(int n) const
+{
+    if (n >= m_size)
+        return *this;
+    n = qMax(n, 0);
+    return QByteArrayView(m_data + m_size - n, n);
+}
+
+/*!
+    Returns a view on \a n bytes starting at position \a pos.
+
+    If \a pos exceeds size(), a null view is returned. If \a n is -1
+    (the default), or \a pos + \a n >= size(), the view contains all
+    bytes starting at position \a pos until the end.
+
+    \sa left(), right(), QByteArray::mid()
+*/
+QByteArrayView QByteArrayView::mid(int pos, int n) const
+{
+    if (pos > m_size)
+        return QByteArrayView();
+    if (n < 0)
+        n = m_size - pos;
+    if (pos < 0) {
+        n += pos;
+        pos = 0;
+    }
+    if (n + pos > m_size)
+        n = m_size - pos;
+    return QByteArrayView(m_data + pos, qMax(n, 0));
+}
+
+/*!
+    Returns a view with the whitespace at the start and the end removed.
+    No bytes are copied.
+
+    \sa QByteArray::trimmed()
+*/
+QByteArrayView QByteArrayView::trimmed() const
+{
+    if (m_size == 0)
+        return *this;
+    int start = 0;
+    int end = m_size - 1;
+    while (start <= end && isspace(uchar(m_data[start])))
+        start++;
+    if (start <= end) {
+        while (end && isspace(uchar(m_data[end])))
+            end--;
+    }
+    return QByteArrayView(m_data + start, end - start + 1);
+}
+
+/*!
+    Returns the index position of the first occurrence of the byte \a c
+    in the view, searching forward from index position \a from. Returns
+    -1 if \a c could not be found.
+*/
+int QByteArrayView::indexOf(char c, int from) const
+{
+    if (from < 0)
+        from = qMax(from + m_size, 0);
+    if (from < m_size) {
+        const char *n = static_cast<const char *>(memchr(m_data + from, c, m_size - from));
+        if (n)
+            return n - m_data;
+    }
+    return -1;
+}
+
+/*!
+    \overload
+
+    Returns the index position of the first occurrence of \a a in the
+    view, searching forward from index position \a from. Returns -1 if
+    \a a could not be found.
+*/
+int QByteArrayView::indexOf(QByteArrayView a, int from) const
+{
+    const int ol = a.m_size;
+    if (ol == 0)
+        return from;
+    if (ol == 1)
+        return indexOf(*a.m_data, from);
+    if (from > m_size || ol + from > m_size)
+        return -1;
+    return qFindByteArray(m_data, m_size, from, a.m_data, ol);
+}
+
+/*!
+    Returns the index position of the last occurrence of the byte \a c
+    in the view, searching backward from index position \a from. If
+    \a from is -1 (the default), the search starts at the last byte.
+    Returns -1 if \a c could not be found.
+*/
+int QByteArrayView::lastIndexOf(char c, int from) const
+{
+    if (from < 0)
+        from += m_size;
+    else if (from > m_size)
+        from = m_size - 1;
+    if (from >= 0) {
+        const char *b = m_data;
+        const char *n = m_data + from + 1;
+        while (n-- != b)
+            if (*n == c)
+                return n - b;
+    }
+    return -1;
+}
+
+/*!
+    Returns \c true if the view starts with \a a; otherwise returns
+    \c false.
+
+    \sa endsWith()
+*/
+bool QByteArrayView::startsWith(QByteArrayView a) const
+{
+    if (a.m_size == 0)
+        return true;
+    if (m_size < a.m_size)
+        return false;
+    return memcmp(m_data, a.m_data, a.m_size) == 0;
+}
+
+/*!
+    Returns \c true if the view ends with \a a; otherwise returns
+    \c false.
+
+    \sa startsWith()
+*/
+bool QByteArrayView::endsWith(QByteArrayView a) const
+{
+    if (a.m_size == 0)
+        return true;
+    if (m_size < a.m_size)
+        return false;
+    return memcmp(m_data + m_size - a.m_size, a.m_data, a.m_size) == 0;
+}
+
+/*!
+    Compares the view with \a a and returns an integer less than, equal
+    to, or greater than zero if the view is less than, equal to, or
+    greater than \a a. Bytes are compared as unsigned values.
+*/
+int QByteArrayView::compare(QByteArrayView a) const
+{
+    const int len = qMin(m_size, a.m_size);
+    const int r = len ? memcmp(m_data, a.m_data, len) : 0;
+    return r ? r : m_size - a.m_size;
+}
+
+/*!
+    Returns a copy of the viewed bytes as a QByteArray. A null view
+    gives a null byte array.
+*/
+QByteArray QByteArrayView::toByteArray() const
+{
+    if (!m_data)
+        return QByteArray();
+    return QByteArray(m_data, m_size);
+}
+
+namespace {
+// The number parsers in QLocalePrivate want '\0'-terminated input;
+// copy the view to the stack so that short numbers never allocate.
+class QByteArrayViewNulTerminated
+{
+public:
+    explicit QByteArrayViewNulTerminated(QByteArrayView v)
+        : buffer(v.size() + 1)
+    {
+        memcpy(buffer.data(), v.constData(), v.size());
+        buffer[v.size()] = '\0';
+    }
+    const char *constData() const { return buffer.constData(); }
+private:
+    QVarLengthArray<char, 64> buffer;
+};
+}
+
+/*!
+    Returns the view converted to a \c {long long} using base \a base,
+    which is 10 by default and must be between 2 and 36, or 0.
+
+    Returns 0 if the conversion fails.
+
+    If \a ok is not 0: if a conversion error occurs, *\a{ok} is set to
+    false; otherwise *\a{ok} is set to true.
+
+    \note The conversion of the number is performed in the default C
+    locale, irrespective of the user's locale.
+
+    \sa QByteArray::toLongLong()
+*/
+qlonglong QByteArrayView::toLongLong(bool *ok, int base) const
+{
+#if defined(QT_CHECK_RANGE)
+    if (base != 0 && (base < 2 || base > 36)) {
+        qWarning("QByteArrayView::toLongLong: Invalid base %d", base);
+        base = 10;
+    }
+#endif
+
+    return QLocalePrivate::bytearrayToLongLong(QByteArrayViewNulTerminated(*this).constData(), base, ok);
+}
+
+/*!
+    Returns the view converted to an \c {unsigned long long} using base
+    \a base. Returns 0 if the conversion fails.
+
+    \sa toLongLong(), QByteArray::toULongLong()
+*/
+qulonglong QByteArrayView::toULongLong(bool *ok, int base) const
+{
+#if defined(QT_CHECK_RANGE)
+    if (base != 0 && (base < 2 || base > 36)) {
+        qWarning("QByteArrayView::toULongLong: Invalid base %d", base);
+        base = 10;
+    }
+#endif
+
+    return QLocalePrivate::bytearrayToUnsLongLong(QByteArrayViewNulTerminated(*this).constData(), base, ok);
+}
+
+/*!
+    Returns the view converted to an \c int using base \a base.
+    Returns 0 if the conversion fails.
+
+    \sa toLongLong(), QByteArray::toInt()
+*/
+int QByteArrayView::toInt(bool *ok, int base) const
+{
+    qlonglong v = toLongLong(ok, base);
+    if (v < INT_MIN || v > INT_MAX) {
+        if (ok)
+            *ok = false;
+        v = 0;
+    }
+    return int(v);
+}
+
+/*!
+    Returns the view converted to an \c {unsigned int} using base
+    \a base. Returns 0 if the conversion fails.
+
+    \sa toULongLong(), QByteArray::toUInt()
+*/
+uint QByteArrayView::toUInt(bool *ok, int base) const
+{
+    qulonglong v = toULongLong(ok, base);
+    if (v > UINT_MAX) {
+        if (ok)
+            *ok = false;
+        v = 0;
+    }
+    return uint(v);
+}
+
+/*!
+    Returns the view converted to a \c short using base \a base.
+    Returns 0 if the conversion fails.
+
+    \sa toLongLong(), QByteArray::toShort()
+*/
+short QByteArrayView::toShort(bool *ok, int base) const
+{
+    qlonglong v = toLongLong(ok, base);
+    if (v < SHRT_MIN || v > SHRT_MAX) {
+        if (ok)
+            *ok = false;
+        v = 0;
+    }
+    return short(v);
+}
+
+/*!
+    Returns the view converted to an \c {unsigned short} using base
+    \a base. Returns 0 if the conversion fails.
+
+    \sa toULongLong(), QByteArray::toUShort()
+*/
+ushort QByteArrayView::toUShort(bool *ok, int base) const
+{
+    qulonglong v = toULongLong(ok, base);
+    if (v > USHRT_MAX) {
+        if (ok)
+            *ok = false;
+        v = 0;
+    }
+    return ushort(v);
+}
+
+/*!
+    Returns the view converted to a \c double value. Returns 0.0 if the
+    conversion fails.
+
+    \note The conversion of the number is performed in the default C
+    locale, irrespective of the user's locale.
+
+    \sa QByteArray::toDouble()
+*/
+double QByteArrayView::toDouble(bool *ok) const
+{
+    return QLocalePrivate::bytearrayToDouble(QByteArrayViewNulTerminated(*this).constData(), ok);
+}
+
+/*!
+    Returns the view converted to a \c float value. Returns 0.0 if the
+    conversion fails.
+
+    \sa toDouble(), QByteArray::toFloat()
+*/
+float QByteArrayView::toFloat(bool *ok) const
+{
+    return float(toDouble(ok));
+}
+
+/*!
+    \fn bool operator==(QByteArrayView a1, QByteArrayView a2)
+    \relates QByteArrayView
+
+    Returns \c true if \a a1 is equal to \a a2; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool operator!=(QByteArrayView a1, QByteArrayView a2)
+    \relates QByteArrayView
+
+    Returns \c true if \a a1 is not equal to \a a2; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool operator<(QByteArrayView a1, QByteArrayView a2)
+    \relates QByteArrayView
+
+    Returns \c true if \a a1 is lexically less than \a a2; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool operator<=(QByteArrayView a1, QByteArrayView a2)
+    \relates QByteArrayView
+
+    Returns \c true if \a a1 is lexically less than or equal to \a a2;
+    otherwise returns \c false.
+*/
+
+/*!
+    \fn bool operator>(QByteArrayView a1, QByteArrayView a2)
+    \relates QByteArrayView
+
+    Returns \c true if \a a1 is lexically greater than \a a2; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool operator>=(QByteArrayView a1, QByteArrayView a2)
+    \relates QByteArrayView
+
+    Returns \c true if \a a1 is lexically greater than or equal to
+    \a a2; otherwise returns \c false.
+*/
+
 QT_END_NAMESPACE
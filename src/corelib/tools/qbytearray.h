@@ -114,6 +114,7 @@ Q_CORE_EXPORT int qsnprintf(char *str, size_t n, const char *fmt, ...);
 Q_CORE_EXPORT quint16 qChecksum(const char *s, uint len);
 
 class QByteRef;
+class QByteArrayView;
 class QString;
 class QDataStream;
 template <typename T> class QList;
@@ -619,6 +620,97 @@ inline QByteArray qUncompress(const QByteArray& data)
 
 Q_DECLARE_SHARED(QByteArray)
 
+class Q_CORE_EXPORT QByteArrayView
+{
+    const char *m_data;
+    int m_size;
+public:
+    typedef char value_type;
+    typedef const char *const_iterator;
+    typedef const_iterator iterator;
+
+    Q_DECL_CONSTEXPR inline QByteArrayView() : m_data(0), m_size(0) {}
+    Q_DECL_CONSTEXPR inline QByteArrayView(const char *data, int size) : m_data(data), m_size(size) {}
+    inline QByteArrayView(const char *data) : m_data(data), m_size(int(qstrlen(data))) {}
+    inline QByteArrayView(const QByteArray &ba)
+        : m_data(ba.isNull() ? 0 : ba.constData()), m_size(ba.size()) {}
+
+    inline int size() const { return m_size; }
+    inline int length() const { return m_size; }
+    inline bool isEmpty() const { return m_size == 0; }
+    inline bool isNull() const { return m_data == 0; }
+
+    inline const char *data() const { return m_data; }
+    inline const char *constData() const { return m_data; }
+
+    inline char at(int i) const { Q_ASSERT(uint(i) < uint(size())); return m_data[i]; }
+    inline char operator[](int i) const { return at(i); }
+
+    inline const_iterator begin() const { return m_data; }
+    inline const_iterator cbegin() const { return m_data; }
+    inline const_iterator end() const { return m_data + m_size; }
+    inline const_iterator cend() const { return m_data + m_size; }
+
+    QByteArrayView left(int n) const Q_REQUIRED_RESULT;
+    QByteArrayView right(int n) const Q_REQUIRED_RESULT;
+    QByteArrayView mid(int pos, int n = -1) const Q_REQUIRED_RESULT;
+    QByteArrayView trimmed() const Q_REQUIRED_RESULT;
+
+    inline void truncate(int pos) { if (pos < m_size) m_size = qMax(pos, 0); }
+    inline void chop(int n) { if (n > 0) m_size = qMax(m_size - n, 0); }
+
+    // the QByteArray and const char * overloads keep calls unambiguous
+    // next to the char ones, as QByteArray converts to an integer
+    int indexOf(char c, int from = 0) const;
+    int indexOf(QByteArrayView a, int from = 0) const;
+    inline int indexOf(const QByteArray &a, int from = 0) const
+    { return indexOf(QByteArrayView(a), from); }
+    inline int indexOf(const char *a, int from = 0) const
+    { return indexOf(QByteArrayView(a), from); }
+    int lastIndexOf(char c, int from = -1) const;
+
+    inline bool contains(char c) const { return indexOf(c) != -1; }
+    inline bool contains(QByteArrayView a) const { return indexOf(a) != -1; }
+    inline bool contains(const QByteArray &a) const { return indexOf(QByteArrayView(a)) != -1; }
+    inline bool contains(const char *a) const { return indexOf(QByteArrayView(a)) != -1; }
+
+    bool startsWith(QByteArrayView a) const;
+    inline bool startsWith(const QByteArray &a) const { return startsWith(QByteArrayView(a)); }
+    inline bool startsWith(const char *a) const { return startsWith(QByteArrayView(a)); }
+    inline bool startsWith(char c) const { return m_size > 0 && m_data[0] == c; }
+    bool endsWith(QByteArrayView a) const;
+    inline bool endsWith(const QByteArray &a) const { return endsWith(QByteArrayView(a)); }
+    inline bool endsWith(const char *a) const { return endsWith(QByteArrayView(a)); }
+    inline bool endsWith(char c) const { return m_size > 0 && m_data[m_size - 1] == c; }
+
+    int compare(QByteArrayView a) const;
+
+    QByteArray toByteArray() const Q_REQUIRED_RESULT;
+
+    short toShort(bool *ok = 0, int base = 10) const;
+    ushort toUShort(bool *ok = 0, int base = 10) const;
+    int toInt(bool *ok = 0, int base = 10) const;
+    uint toUInt(bool *ok = 0, int base = 10) const;
+    qlonglong toLongLong(bool *ok = 0, int base = 10) const;
+    qulonglong toULongLong(bool *ok = 0, int base = 10) const;
+    float toFloat(bool *ok = 0) const;
+    double toDouble(bool *ok = 0) const;
+};
+Q_DECLARE_TYPEINFO(QByteArrayView, Q_PRIMITIVE_TYPE);
+
+inline bool operator==(QByteArrayView a1, QByteArrayView a2)
+{ return a1.size() == a2.size() && (!a1.size() || memcmp(a1.constData(), a2.constData(), a1.size()) == 0); }
+inline bool operator!=(QByteArrayView a1, QByteArrayView a2)
+{ return !(a1 == a2); }
+inline bool operator<(QByteArrayView a1, QByteArrayView a2)
+{ return a1.compare(a2) < 0; }
+inline bool operator<=(QByteArrayView a1, QByteArrayView a2)
+{ return a1.compare(a2) <= 0; }
+inline bool operator>(QByteArrayView a1, QByteArrayView a2)
+{ return a1.compare(a2) > 0; }
+inline bool operator>=(QByteArrayView a1, QByteArrayView a2)
+{ return a1.compare(a2) >= 0; }
+
 QT_END_NAMESPACE
 
 #ifdef QT_USE_QSTRINGBUILDER
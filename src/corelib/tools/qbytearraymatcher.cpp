@@ -41,10 +41,79 @@
 
 #include "qbytearraymatcher.h"
 
+#include "qsimd_p.h"
+
 #include <limits.h>
 
 QT_BEGIN_NAMESPACE
 
+#if defined(__SSE2__)
+static inline uint lowestBit(uint mask)
+{
+    Q_ASSERT(mask);
+#if defined(Q_CC_GNU)
+    return __builtin_ctz(mask);
+#else
+    uint i = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+static int findBytesSse2(const uchar *cc, int l, int &index, const uchar *puc, int pl)
+{
+    // Compare the first and the last byte of the pattern against sixteen
+    // candidate positions at a time; only the positions where both match
+    // are compared in full.
+    const __m128i first = _mm_set1_epi8(puc[0]);
+    const __m128i last = _mm_set1_epi8(puc[pl - 1]);
+    for ( ; index + pl - 1 + 16 <= l; index += 16) {
+        const __m128i blockFirst = _mm_loadu_si128((const __m128i *)(cc + index));
+        const __m128i blockLast = _mm_loadu_si128((const __m128i *)(cc + index + pl - 1));
+        uint mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first),
+                                                    _mm_cmpeq_epi8(blockLast, last)));
+        while (mask) {
+            const int candidate = index + lowestBit(mask);
+            if (pl <= 2 || memcmp(cc + candidate + 1, puc + 1, pl - 2) == 0)
+                return candidate;
+            mask &= mask - 1;
+        }
+    }
+    return -1;
+}
+#endif
+
+/*
+    Searches for the pattern \a puc with the SIMD instructions available,
+    starting at \a index. If there is no match, \a index is advanced to the
+    first position that still has to be searched with the scalar code.
+*/
+static inline int simd_find(const uchar *cc, int l, int &index, const uchar *puc, int pl)
+{
+    if (pl == 0)
+        return -1;
+#if defined(QT_COMPILER_SUPPORTS_AVX2) && !defined(QT_BOOTSTRAPPED)
+    if (qCpuHasFeature(AVX2)) {
+        extern int qt_find_bytes_avx2(const uchar *cc, int l, int &index, const uchar *puc, int pl);
+        const int idx = qt_find_bytes_avx2(cc, l, index, puc, pl);
+        if (idx != -1)
+            return idx;
+    }
+#endif
+#if defined(__SSE2__)
+    return findBytesSse2(cc, l, index, puc, pl);
+#else
+    Q_UNUSED(cc);
+    Q_UNUSED(l);
+    Q_UNUSED(index);
+    Q_UNUSED(puc);
+    return -1;
+#endif
+}
+
 static inline void bm_init_skiptable(const uchar *cc, int len, uchar *skiptable)
 {
     int l = qMin(len, 255);
@@ -200,10 +269,7 @@ void QByteArrayMatcher::setPattern(const QByteArray &pattern)
 */
 int QByteArrayMatcher::indexIn(const QByteArray &ba, int from) const
 {
-    if (from < 0)
-        from = 0;
-    return bm_find(reinterpret_cast<const uchar *>(ba.constData()), ba.size(), from,
-                   p.p, p.l, p.q_skiptable);
+    return indexIn(ba.constData(), ba.size(), from);
 }
 
 /*!
@@ -217,8 +283,11 @@ int QByteArrayMatcher::indexIn(const char *str, int len, int from) const
 {
     if (from < 0)
         from = 0;
-    return bm_find(reinterpret_cast<const uchar *>(str), len, from,
-                   p.p, p.l, p.q_skiptable);
+    const uchar *cc = reinterpret_cast<const uchar *>(str);
+    const int idx = simd_find(cc, len, from, p.p, p.l);
+    if (idx != -1)
+        return idx;
+    return bm_find(cc, len, from, p.p, p.l, p.q_skiptable);
 }
 
 /*!
@@ -238,11 +307,9 @@ static int findChar(const char *str, int len, char ch, int from)
     if (from < 0)
         from = qMax(from + len, 0);
     if (from < len) {
-        const uchar *n = s + from - 1;
-        const uchar *e = s + len;
-        while (++n != e)
-            if (*n == c)
-                return  n - s;
+        const uchar *n = static_cast<const uchar *>(memchr(s + from, c, len - from));
+        if (n)
+            return n - s;
     }
     return -1;
 }
@@ -288,12 +355,18 @@ int qFindByteArray(
     if (sl == 1)
         return findChar(haystack0, haystackLen, needle[0], from);
 
+    const int simdIdx = simd_find((const uchar *)haystack0, l, from, (const uchar *)needle, sl);
+    if (simdIdx != -1)
+        return simdIdx;
+    if (from > l - sl)
+        return -1;
+
     /*
       We use the Boyer-Moore algorithm in cases where the overhead
       for the skip table should pay off, otherwise we use a simple
       hash function.
     */
-    if (l > 500 && sl > 5)
+    if (l - from > 500 && sl > 5)
         return qFindByteArrayBoyerMoore(haystack0, haystackLen, from,
                                         needle, needleLen);
 
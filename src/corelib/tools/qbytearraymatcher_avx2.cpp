@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <private/qsimd_p.h>
+
+#include <string.h>
+
+#ifdef QT_COMPILER_SUPPORTS_AVX2
+
+#ifndef __AVX2__
+#error "AVX2 not enabled in this file, cannot proceed"
+#endif
+
+QT_BEGIN_NAMESPACE
+
+static inline uint lowestBit(uint mask)
+{
+#if defined(Q_CC_GNU)
+    return __builtin_ctz(mask);
+#else
+    uint i = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+// Refer to findBytesSse2() in qbytearraymatcher.cpp; this does the same for
+// thirty-two candidate positions at a time.
+int qt_find_bytes_avx2(const uchar *cc, int l, int &index, const uchar *puc, int pl)
+{
+    const __m256i first = _mm256_set1_epi8(puc[0]);
+    const __m256i last = _mm256_set1_epi8(puc[pl - 1]);
+    for ( ; index + pl - 1 + 32 <= l; index += 32) {
+        const __m256i blockFirst = _mm256_loadu_si256((const __m256i *)(cc + index));
+        const __m256i blockLast = _mm256_loadu_si256((const __m256i *)(cc + index + pl - 1));
+        uint mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first),
+                                                          _mm256_cmpeq_epi8(blockLast, last)));
+        while (mask) {
+            const int candidate = index + lowestBit(mask);
+            if (pl <= 2 || memcmp(cc + candidate + 1, puc + 1, pl - 2) == 0)
+                return candidate;
+            mask &= mask - 1;
+        }
+    }
+    return -1;
+}
+
+// Refer to QByteArray::count(char).
+int qt_count_char_avx2(const uchar *&b, const uchar *e, uchar c)
+{
+    const __m256i pattern = _mm256_set1_epi8(c);
+    int num = 0;
+    while (e - b >= 32) {
+        const uchar *chunkEnd = b + qMin<qptrdiff>((e - b) & ~qptrdiff(31), 255 * 32);
+        __m256i counts = _mm256_setzero_si256();
+        for ( ; b != chunkEnd; b += 32)
+            counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)b), pattern));
+        counts = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+        num += _mm256_extract_epi32(counts, 0) + _mm256_extract_epi32(counts, 2)
+             + _mm256_extract_epi32(counts, 4) + _mm256_extract_epi32(counts, 6);
+    }
+    return num;
+}
+
+QT_END_NAMESPACE
+
+#endif
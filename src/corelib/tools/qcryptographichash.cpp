@@ -43,6 +43,11 @@
 #include <qcryptographichash.h>
 #include <qiodevice.h>
 
+#ifndef QT_BOOTSTRAPPED
+#include <qfiledevice.h>
+#include <private/qsimd_p.h>
+#endif
+
 #include "../../3rdparty/sha1/sha1.cpp"
 
 #if defined(QT_BOOTSTRAPPED) && !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1)
@@ -165,6 +170,101 @@ public:
     QByteArray result;
 };
 
+#if defined(QT_COMPILER_SUPPORTS_SHA) && !defined(QT_BOOTSTRAPPED)
+void qt_sha1_blocks_sha(quint32 *state, const uchar *data, qint64 blocks);
+#  ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+void qt_sha256_blocks_sha(quint32 *state, const uchar *data, qint64 blocks);
+#  endif
+#endif
+
+/*
+    The block loops below hand whole 64-byte blocks to the SHA extension
+    kernels when the CPU has them, and only route the partial blocks at
+    either end through the byte-oriented reference implementations.
+*/
+static void sha1Blocks(Sha1State *state, const uchar *data, qint64 blocks)
+{
+#if defined(QT_COMPILER_SUPPORTS_SHA) && !defined(QT_BOOTSTRAPPED)
+    if (qCpuHasFeature(SHA)) {
+        quint32 h[5] = { state->h0, state->h1, state->h2, state->h3, state->h4 };
+        qt_sha1_blocks_sha(h, data, blocks);
+        state->h0 = h[0];
+        state->h1 = h[1];
+        state->h2 = h[2];
+        state->h3 = h[3];
+        state->h4 = h[4];
+        return;
+    }
+#endif
+    for ( ; blocks; --blocks, data += 64)
+        sha1ProcessChunk(state, data);
+}
+
+static void sha1AddData(Sha1State *state, const uchar *data, qint64 len)
+{
+    const int rest = int(state->messageSize & 63);
+    if (rest && len >= 64 - rest) {
+        // complete the buffered block first
+        sha1Update(state, data, 64 - rest);
+        data += 64 - rest;
+        len -= 64 - rest;
+    }
+
+    if (!(state->messageSize & 63) && len >= 64) {
+        const qint64 blocks = len / 64;
+        sha1Blocks(state, data, blocks);
+        state->messageSize += blocks * 64;
+        data += blocks * 64;
+        len -= blocks * 64;
+    }
+
+    sha1Update(state, data, len);
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+static void sha256Blocks(SHA256Context *context, const uchar *data, qint64 blocks)
+{
+#if defined(QT_COMPILER_SUPPORTS_SHA) && !defined(QT_BOOTSTRAPPED)
+    if (qCpuHasFeature(SHA)) {
+        qt_sha256_blocks_sha(context->Intermediate_Hash, data, blocks);
+        return;
+    }
+#endif
+    for ( ; blocks; --blocks, data += 64) {
+        memcpy(context->Message_Block, data, 64);
+        SHA224_256ProcessMessageBlock(context);
+    }
+}
+
+// Used for both SHA-224 and SHA-256, which share the compression function.
+static void sha256AddData(SHA256Context *context, const uchar *data, qint64 len)
+{
+    if (context->Message_Block_Index && !context->Corrupted && !context->Computed) {
+        const int fill = int(qMin<qint64>(len, SHA256_Message_Block_Size - context->Message_Block_Index));
+        SHA256Input(context, data, fill);
+        data += fill;
+        len -= fill;
+    }
+
+    if (!context->Message_Block_Index && !context->Corrupted && !context->Computed && len >= 64) {
+        const qint64 blocks = len / 64;
+        const quint64 oldLength = quint64(context->Length_High) << 32 | context->Length_Low;
+        const quint64 newLength = oldLength + quint64(blocks) * 512;
+        if (newLength < oldLength) {
+            context->Corrupted = shaInputTooLong;
+            return;
+        }
+        sha256Blocks(context, data, blocks);
+        context->Length_High = quint32(newLength >> 32);
+        context->Length_Low = quint32(newLength);
+        data += blocks * 64;
+        len -= blocks * 64;
+    }
+
+    SHA256Input(context, data, uint(len));
+}
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
 /*!
   \class QCryptographicHash
   \inmodule QtCore
@@ -273,7 +373,7 @@ void QCryptographicHash::addData(const char *data, int length)
 {
     switch (d->method) {
     case Sha1:
-        sha1Update(&d->sha1Context, (const unsigned char *)data, length);
+        sha1AddData(&d->sha1Context, (const unsigned char *)data, length);
         break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
     default:
@@ -288,10 +388,10 @@ void QCryptographicHash::addData(const char *data, int length)
         MD5Update(&d->md5Context, (const unsigned char *)data, length);
         break;
     case Sha224:
-        SHA224Input(&d->sha224Context, reinterpret_cast<const unsigned char *>(data), length);
+        sha256AddData(&d->sha224Context, reinterpret_cast<const unsigned char *>(data), length);
         break;
     case Sha256:
-        SHA256Input(&d->sha256Context, reinterpret_cast<const unsigned char *>(data), length);
+        sha256AddData(&d->sha256Context, reinterpret_cast<const unsigned char *>(data), length);
         break;
     case Sha384:
         SHA384Input(&d->sha384Context, reinterpret_cast<const unsigned char *>(data), length);
@@ -337,7 +437,30 @@ bool QCryptographicHash::addData(QIODevice* device)
     if (!device->isOpen())
         return false;
 
-    char buffer[1024];
+#ifndef QT_BOOTSTRAPPED
+    // Hash large regular files straight out of mapped windows instead of
+    // copying them through a read buffer.
+    QFileDevice *file = qobject_cast<QFileDevice *>(device);
+    if (file && !file->isSequential() && !file->isTextModeEnabled()) {
+        const qint64 mapThreshold = 1024 * 1024;
+        const qint64 windowSize = 64 * 1024 * 1024;
+        const qint64 size = file->size();
+        qint64 offset = file->pos();
+        while (size - offset >= mapThreshold) {
+            const qint64 length = qMin(windowSize, size - offset);
+            uchar *window = file->map(offset, length);
+            if (!window)
+                break;
+            addData(reinterpret_cast<const char *>(window), int(length));
+            file->unmap(window);
+            offset += length;
+        }
+        if (offset != file->pos() && !file->seek(offset))
+            return false;
+    }
+#endif
+
+    char buffer[16384];
     int length;
 
     while ((length = device->read(buffer,sizeof(buffer))) > 0)
@@ -446,4 +569,154 @@ QByteArray QCryptographicHash::hash(const QByteArray &data, Algorithm method)
     return hash.result();
 }
 
+#if defined(QT_COMPILER_SUPPORTS_AVX2) && !defined(QT_BOOTSTRAPPED) && !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1)
+void qt_sha1_block_x8_avx2(quint32 (*state)[8], const uchar *const blocks[8]);
+void qt_sha256_block_x8_avx2(quint32 (*state)[8], const uchar *const blocks[8]);
+
+namespace {
+struct HashLane
+{
+    int item;               // index into the input list, or -1 when idle
+    qint64 block;           // next block to process
+    qint64 fullBlocks;      // blocks taken directly from the input
+    int totalTailBlocks;    // padding blocks in tail (1 or 2)
+    uchar tail[128];
+};
+}
+
+/*
+    Hashes the items of \a data eight at a time, one per 32-bit lane of
+    the AVX2 kernels. Whenever a lane finishes its message it is refilled
+    with the next pending item; the final padded block(s) of each item are
+    assembled in the lane's tail buffer.
+*/
+static QList<QByteArray> multiBufferHash(const QList<QByteArray> &data,
+                                         QCryptographicHash::Algorithm method)
+{
+    int words;
+    quint32 iv[8];
+    switch (method) {
+    case QCryptographicHash::Sha1: {
+        Sha1State init;
+        sha1InitState(&init);
+        iv[0] = init.h0;
+        iv[1] = init.h1;
+        iv[2] = init.h2;
+        iv[3] = init.h3;
+        iv[4] = init.h4;
+        words = 5;
+        break;
+    }
+    case QCryptographicHash::Sha224:
+    case QCryptographicHash::Sha256: {
+        SHA256Context init;
+        if (method == QCryptographicHash::Sha224)
+            SHA224Reset(&init);
+        else
+            SHA256Reset(&init);
+        memcpy(iv, init.Intermediate_Hash, sizeof iv);
+        words = method == QCryptographicHash::Sha224 ? 7 : 8;
+        break;
+    }
+    default:
+        Q_UNREACHABLE();
+        return QList<QByteArray>();
+    }
+
+    static const uchar idleBlock[64] = { 0 };
+    QList<QByteArray> results;
+    results.reserve(data.size());
+    for (int i = 0; i < data.size(); ++i)
+        results.append(QByteArray());
+
+    quint32 state[8][8];
+    HashLane lanes[8];
+    int next = 0;
+    int active = 0;
+    for (int lane = 0; lane < 8; ++lane)
+        lanes[lane].item = -1;
+
+    forever {
+        // refill idle lanes
+        for (int lane = 0; lane < 8 && next < data.size(); ++lane) {
+            HashLane &l = lanes[lane];
+            if (l.item != -1)
+                continue;
+            const QByteArray &input = data.at(next);
+            l.item = next++;
+            l.block = 0;
+            l.fullBlocks = input.size() / 64;
+            const int rest = input.size() % 64;
+            l.totalTailBlocks = rest < 56 ? 1 : 2;
+            memset(l.tail, 0, sizeof l.tail);
+            memcpy(l.tail, input.constData() + l.fullBlocks * 64, rest);
+            l.tail[rest] = 0x80;
+            qToBigEndian(quint64(input.size()) << 3, l.tail + l.totalTailBlocks * 64 - 8);
+            for (int w = 0; w < 8; ++w)
+                state[w][lane] = iv[w];
+            ++active;
+        }
+        if (!active)
+            break;
+
+        const uchar *blocks[8];
+        for (int lane = 0; lane < 8; ++lane) {
+            const HashLane &l = lanes[lane];
+            if (l.item == -1)
+                blocks[lane] = idleBlock;
+            else if (l.block < l.fullBlocks)
+                blocks[lane] = reinterpret_cast<const uchar *>(data.at(l.item).constData()) + l.block * 64;
+            else
+                blocks[lane] = l.tail + (l.block - l.fullBlocks) * 64;
+        }
+
+        if (method == QCryptographicHash::Sha1)
+            qt_sha1_block_x8_avx2(state, blocks);
+        else
+            qt_sha256_block_x8_avx2(state, blocks);
+
+        for (int lane = 0; lane < 8; ++lane) {
+            HashLane &l = lanes[lane];
+            if (l.item == -1 || ++l.block < l.fullBlocks + l.totalTailBlocks)
+                continue;
+            QByteArray &digest = results[l.item];
+            digest.resize(words * 4);
+            for (int w = 0; w < words; ++w)
+                qToBigEndian(state[w][lane], reinterpret_cast<uchar *>(digest.data()) + w * 4);
+            l.item = -1;
+            --active;
+        }
+    }
+    return results;
+}
+#endif
+
+/*!
+  \overload hash()
+  \since 5.3
+
+  Returns the hashes of each of the byte arrays in \a data using \a method,
+  in the same order.
+
+  Hashing many independent inputs at once can be considerably faster than
+  hashing them one after the other: on processors with AVX2 but without the
+  SHA extensions, SHA-1, SHA-224 and SHA-256 are computed for eight inputs in
+  parallel. This works best when the inputs are of similar size, such as
+  fixed-size chunks of a larger file.
+*/
+QList<QByteArray> QCryptographicHash::hash(const QList<QByteArray> &data, Algorithm method)
+{
+#if defined(QT_COMPILER_SUPPORTS_AVX2) && !defined(QT_BOOTSTRAPPED) && !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1)
+    // the SHA extensions hash a single stream faster than eight AVX2 lanes
+    if (data.size() > 1 && qCpuHasFeature(AVX2) && !qCpuHasFeature(SHA)
+            && (method == Sha1 || method == Sha224 || method == Sha256))
+        return multiBufferHash(data, method);
+#endif
+    QList<QByteArray> results;
+    results.reserve(data.size());
+    for (int i = 0; i < data.size(); ++i)
+        results.append(hash(data.at(i), method));
+    return results;
+}
+
 QT_END_NAMESPACE
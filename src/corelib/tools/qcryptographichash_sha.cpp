@@ -0,0 +1,237 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/qsimd_p.h>
+
+#ifdef QT_COMPILER_SUPPORTS_SHA
+
+#if !defined(__SHA__) && !defined(Q_CC_MSVC)
+#error "SHA extensions not enabled in this file, cannot proceed"
+#endif
+
+#include <immintrin.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Block functions for the Intel SHA extensions. Both work directly on the
+    chaining state of the reference implementations, process any number of
+    complete 64-byte blocks and leave buffering and padding to the caller.
+    The round structure follows Intel's "New Instructions Supporting the
+    Secure Hash Algorithm on Intel Architecture Processors" (2013).
+*/
+
+template <int Func>
+static inline void sha1Rounds4(__m128i &abcd, __m128i &e, __m128i &nextE, __m128i w)
+{
+    e = _mm_sha1nexte_epu32(e, w);
+    nextE = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e, Func);
+}
+
+void qt_sha1_blocks_sha(quint32 *state, const uchar *data, qint64 blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(Q_INT64_C(0x0001020304050607),
+                                            Q_INT64_C(0x08090a0b0c0d0e0f));
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0x1b);
+    __m128i e0 = _mm_set_epi32(int(state[4]), 0, 0, 0);
+    __m128i e1;
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i savedAbcd = abcd;
+        const __m128i savedE = e0;
+        const __m128i *msg = reinterpret_cast<const __m128i *>(data);
+        __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128(msg), byteSwap);
+        __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128(msg + 1), byteSwap);
+        __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128(msg + 2), byteSwap);
+        __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128(msg + 3), byteSwap);
+
+        // group g uses w[g % 4], then completes w[g + 1], and starts on
+        // w[g + 2] and w[g + 3] of the message schedule
+        e0 = _mm_add_epi32(e0, w0);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+        sha1Rounds4<0>(abcd, e1, e0, w1);
+        w0 = _mm_sha1msg1_epu32(w0, w1);
+
+        sha1Rounds4<0>(abcd, e0, e1, w2);
+        w1 = _mm_sha1msg1_epu32(w1, w2);
+        w0 = _mm_xor_si128(w0, w2);
+
+#define SHA1_SCHEDULE(wNext, wCur, wPrev, wPrev2) \
+        wNext = _mm_sha1msg2_epu32(wNext, wCur); \
+        wPrev = _mm_sha1msg1_epu32(wPrev, wCur); \
+        wPrev2 = _mm_xor_si128(wPrev2, wCur)
+
+        sha1Rounds4<0>(abcd, e1, e0, w3);
+        SHA1_SCHEDULE(w0, w3, w2, w1);
+        sha1Rounds4<0>(abcd, e0, e1, w0);
+        SHA1_SCHEDULE(w1, w0, w3, w2);
+
+        sha1Rounds4<1>(abcd, e1, e0, w1);
+        SHA1_SCHEDULE(w2, w1, w0, w3);
+        sha1Rounds4<1>(abcd, e0, e1, w2);
+        SHA1_SCHEDULE(w3, w2, w1, w0);
+        sha1Rounds4<1>(abcd, e1, e0, w3);
+        SHA1_SCHEDULE(w0, w3, w2, w1);
+        sha1Rounds4<1>(abcd, e0, e1, w0);
+        SHA1_SCHEDULE(w1, w0, w3, w2);
+        sha1Rounds4<1>(abcd, e1, e0, w1);
+        SHA1_SCHEDULE(w2, w1, w0, w3);
+
+        sha1Rounds4<2>(abcd, e0, e1, w2);
+        SHA1_SCHEDULE(w3, w2, w1, w0);
+        sha1Rounds4<2>(abcd, e1, e0, w3);
+        SHA1_SCHEDULE(w0, w3, w2, w1);
+        sha1Rounds4<2>(abcd, e0, e1, w0);
+        SHA1_SCHEDULE(w1, w0, w3, w2);
+        sha1Rounds4<2>(abcd, e1, e0, w1);
+        SHA1_SCHEDULE(w2, w1, w0, w3);
+        sha1Rounds4<2>(abcd, e0, e1, w2);
+        SHA1_SCHEDULE(w3, w2, w1, w0);
+
+        sha1Rounds4<3>(abcd, e1, e0, w3);
+        SHA1_SCHEDULE(w0, w3, w2, w1);
+        sha1Rounds4<3>(abcd, e0, e1, w0);
+        SHA1_SCHEDULE(w1, w0, w3, w2);
+#undef SHA1_SCHEDULE
+
+        sha1Rounds4<3>(abcd, e1, e0, w1);
+        w2 = _mm_sha1msg2_epu32(w2, w1);
+        w3 = _mm_xor_si128(w3, w1);
+
+        sha1Rounds4<3>(abcd, e0, e1, w2);
+        w3 = _mm_sha1msg2_epu32(w3, w2);
+
+        sha1Rounds4<3>(abcd, e1, e0, w3);
+
+        e0 = _mm_sha1nexte_epu32(e0, savedE);
+        abcd = _mm_add_epi32(abcd, savedAbcd);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = quint32(_mm_extract_epi32(e0, 3));
+}
+
+static const quint32 sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static inline void sha256Rounds4(__m128i &abef, __m128i &cdgh, __m128i w, int group)
+{
+    const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sha256RoundConstants) + group);
+    const __m128i wk = _mm_add_epi32(w, k);
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0e));
+}
+
+// completes w[4 * group + 4 ... 4 * group + 7] in wNext
+static inline void sha256Schedule(__m128i &wNext, __m128i wCur, __m128i wPrev)
+{
+    wNext = _mm_add_epi32(wNext, _mm_alignr_epi8(wCur, wPrev, 4));
+    wNext = _mm_sha256msg2_epu32(wNext, wCur);
+}
+
+void qt_sha256_blocks_sha(quint32 *state, const uchar *data, qint64 blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(Q_INT64_C(0x0c0d0e0f08090a0b),
+                                            Q_INT64_C(0x0405060700010203));
+
+    // the instructions want the state as ABEF and CDGH
+    const __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0xb1);
+    const __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4)), 0x1b);
+    __m128i abef = _mm_alignr_epi8(dcba, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, dcba, 0xf0);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i savedAbef = abef;
+        const __m128i savedCdgh = cdgh;
+        const __m128i *msg = reinterpret_cast<const __m128i *>(data);
+        __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128(msg), byteSwap);
+        __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128(msg + 1), byteSwap);
+        __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128(msg + 2), byteSwap);
+        __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128(msg + 3), byteSwap);
+
+        sha256Rounds4(abef, cdgh, w0, 0);
+        sha256Rounds4(abef, cdgh, w1, 1);
+        w0 = _mm_sha256msg1_epu32(w0, w1);
+        sha256Rounds4(abef, cdgh, w2, 2);
+        w1 = _mm_sha256msg1_epu32(w1, w2);
+
+        for (int group = 3; group < 13; group += 4) {
+            sha256Rounds4(abef, cdgh, w3, group);
+            sha256Schedule(w0, w3, w2);
+            w2 = _mm_sha256msg1_epu32(w2, w3);
+            sha256Rounds4(abef, cdgh, w0, group + 1);
+            sha256Schedule(w1, w0, w3);
+            w3 = _mm_sha256msg1_epu32(w3, w0);
+            sha256Rounds4(abef, cdgh, w1, group + 2);
+            sha256Schedule(w2, w1, w0);
+            w0 = _mm_sha256msg1_epu32(w0, w1);
+            sha256Rounds4(abef, cdgh, w2, group + 3);
+            sha256Schedule(w3, w2, w1);
+            w1 = _mm_sha256msg1_epu32(w1, w2);
+        }
+
+        sha256Rounds4(abef, cdgh, w3, 15);
+
+        abef = _mm_add_epi32(abef, savedAbef);
+        cdgh = _mm_add_epi32(cdgh, savedCdgh);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_COMPILER_SUPPORTS_SHA
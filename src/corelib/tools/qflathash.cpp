@@ -0,0 +1,840 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qflathash.h"
+
+QT_BEGIN_NAMESPACE
+
+extern uint qt_qhash_global_seed();
+
+const QFlatHashData QFlatHashData::shared_null = {
+    Q_REFCOUNT_INITIALIZE_STATIC, 0, 0, 0, 0, 0
+};
+
+QFlatHashData *QFlatHashData::allocate(int capacity, int nodeSize, int nodeAlign)
+{
+    Q_ASSERT(capacity >= MinimumCapacity && !(capacity & (capacity - 1)));
+
+    // the node array directly follows the control bytes; as the capacity
+    // is a multiple of GroupSize, it is always aligned to at least that
+    const int alignment = qMax<int>(GroupSize, nodeAlign);
+    int nodeOffset = controlOffset() + capacity;
+    nodeOffset = (nodeOffset + alignment - 1) & ~(alignment - 1);
+
+    void *mem = qMallocAligned(size_t(nodeOffset) + size_t(capacity) * nodeSize, alignment);
+    Q_CHECK_PTR(mem);
+
+    QFlatHashData *d = static_cast<QFlatHashData *>(mem);
+    d->ref.initializeOwned();
+    d->size = 0;
+    d->capacity = capacity;
+    d->growthLeft = maximumLoad(capacity);
+    d->seed = qt_qhash_global_seed();
+    d->nodeOffset = nodeOffset;
+    ::memset(d->controlBytes(), Empty, capacity);
+    return d;
+}
+
+void QFlatHashData::free(QFlatHashData *d)
+{
+    if (d != &shared_null)
+        qFreeAligned(d);
+}
+
+int QFlatHashData::capacityForSize(int size)
+{
+    if (size <= 0)
+        return 0;
+    int capacity = MinimumCapacity;
+    while (maximumLoad(capacity) < size)
+        capacity <<= 1;
+    return capacity;
+}
+
+/*!
+    \class QFlatHash
+    \inmodule QtCore
+    \brief The QFlatHash class is a template class that provides an open
+    addressing hash table.
+    \since 5.3
+
+    \ingroup tools
+    \ingroup shared
+
+    \reentrant
+
+    QFlatHash<Key, T> stores (key, value) pairs and provides very fast
+    lookup of the value associated with a key. Its API is modeled after
+    QHash, and the same requirements apply to the key type: it must
+    provide \c operator==() and a global qHash(Key, uint) function. Unlike
+    QHash, QFlatHash does not support multiple values per key.
+
+    QHash allocates every item in a separate node and chains the items of
+    a bucket through pointers. QFlatHash instead stores its items inline
+    in a single array and resolves collisions by probing the array. Next
+    to the items it keeps one control byte per slot, holding seven bits of
+    the item's hash; lookups compare sixteen control bytes at a time (using
+    SSE2 where available) and only compare keys whose control byte
+    matches. This results in far fewer cache misses and no per-item
+    allocation overhead, which matters most for large hashes that are
+    looked up much more often than they are modified.
+
+    The price for this is that inserting into a QFlatHash may move its
+    items, which invalidates all iterators and all references to its
+    values. Removing an item leaves the others where they are, so
+    references to the remaining values and iterators to other items stay
+    valid. QFlatHash uses the same seed as QHash, and just like QHash, its
+    iteration order is arbitrary.
+
+    QFlatHash is \l{implicitly shared}.
+
+    \sa QFlatSet, QHash
+*/
+
+/*! \fn QFlatHash::QFlatHash()
+
+    Constructs an empty hash. This does not allocate any memory.
+
+    \sa clear()
+*/
+
+/*! \fn QFlatHash::QFlatHash(std::initializer_list<std::pair<Key,T> > list)
+
+    Constructs a hash with a copy of each of the elements in the
+    initializer list \a list.
+
+    This function is only available if the program is being
+    compiled in C++11 mode.
+*/
+
+/*! \fn QFlatHash::QFlatHash(const QFlatHash<Key, T> &other)
+
+    Constructs a copy of \a other.
+
+    This operation occurs in \l{constant time}, because QFlatHash is
+    \l{implicitly shared}. If a shared instance is modified, it will be
+    copied (copy-on-write), and this takes \l{linear time}.
+
+    \sa operator=()
+*/
+
+/*! \fn QFlatHash::QFlatHash(QFlatHash<Key, T> &&other)
+
+    Move-constructs a QFlatHash instance, making it point at the same
+    object that \a other was pointing to.
+*/
+
+/*! \fn QFlatHash::~QFlatHash()
+
+    Destroys the hash. References to the values in the hash and all
+    iterators of this hash become invalid.
+*/
+
+/*! \fn QFlatHash<Key, T> &QFlatHash::operator=(const QFlatHash<Key, T> &other)
+
+    Assigns \a other to this hash and returns a reference to this hash.
+*/
+
+/*! \fn QFlatHash<Key, T> &QFlatHash::operator=(QFlatHash<Key, T> &&other)
+
+    Move-assigns \a other to this QFlatHash instance.
+*/
+
+/*! \fn void QFlatHash::swap(QFlatHash<Key, T> &other)
+
+    Swaps hash \a other with this hash. This operation is very
+    fast and never fails.
+*/
+
+/*! \fn bool QFlatHash::operator==(const QFlatHash<Key, T> &other) const
+
+    Returns \c true if \a other contains the same (key, value) pairs as
+    this hash; otherwise returns \c false.
+
+    This function requires the value type to implement \c operator==().
+
+    \sa operator!=()
+*/
+
+/*! \fn bool QFlatHash::operator!=(const QFlatHash<Key, T> &other) const
+
+    Returns \c true if \a other is not equal to this hash; otherwise
+    returns \c false.
+
+    \sa operator==()
+*/
+
+/*! \fn int QFlatHash::size() const
+
+    Returns the number of items in the hash.
+
+    \sa isEmpty(), count()
+*/
+
+/*! \fn int QFlatHash::count() const
+
+    \overload
+
+    Same as size().
+*/
+
+/*! \fn bool QFlatHash::isEmpty() const
+
+    Returns \c true if the hash contains no items; otherwise returns
+    false.
+
+    \sa size()
+*/
+
+/*! \fn bool QFlatHash::empty() const
+
+    This function is provided for STL compatibility. It is equivalent
+    to isEmpty(), returning true if the hash is empty; otherwise
+    returns \c false.
+*/
+
+/*! \fn int QFlatHash::capacity() const
+
+    Returns the number of items the hash can hold before it needs to
+    grow its internal table.
+
+    \sa reserve(), squeeze()
+*/
+
+/*! \fn void QFlatHash::reserve(int size)
+
+    Ensures that the hash can hold at least \a size items without
+    growing its internal table.
+
+    Since growing rehashes every item, calling this function before
+    inserting a known number of items can save a lot of time.
+
+    \sa squeeze(), capacity()
+*/
+
+/*! \fn void QFlatHash::squeeze()
+
+    Shrinks the internal table to the smallest size that can still
+    hold all the items in the hash, to save memory.
+
+    \sa reserve(), capacity()
+*/
+
+/*! \fn void QFlatHash::detach()
+
+    \internal
+
+    Detaches this hash from any other hashes with which it may share
+    data.
+
+    \sa isDetached()
+*/
+
+/*! \fn bool QFlatHash::isDetached() const
+
+    \internal
+
+    Returns \c true if the hash's internal data isn't shared with any
+    other hash object; otherwise returns \c false.
+
+    \sa detach()
+*/
+
+/*! \fn void QFlatHash::setSharable(bool sharable)
+
+    \internal
+*/
+
+/*! \fn bool QFlatHash::isSharedWith(const QFlatHash<Key, T> &other) const
+
+    \internal
+*/
+
+/*! \fn void QFlatHash::clear()
+
+    Removes all items from the hash and frees the memory it used.
+
+    \sa remove()
+*/
+
+/*! \fn int QFlatHash::remove(const Key &key)
+
+    Removes the item that has the \a key from the hash. Returns 1 if
+    an item was removed, and 0 otherwise.
+
+    \sa clear(), take()
+*/
+
+/*! \fn T QFlatHash::take(const Key &key)
+
+    Removes the item with the \a key from the hash and returns
+    the value associated with it.
+
+    If the item does not exist in the hash, the function simply
+    returns a \l{default-constructed value}.
+
+    \sa remove()
+*/
+
+/*! \fn bool QFlatHash::contains(const Key &key) const
+
+    Returns \c true if the hash contains an item with the \a key;
+    otherwise returns \c false.
+
+    \sa count()
+*/
+
+/*! \fn int QFlatHash::count(const Key &key) const
+
+    Returns 1 if the hash contains an item with the \a key, and 0
+    otherwise.
+
+    \sa contains()
+*/
+
+/*! \fn const T QFlatHash::value(const Key &key) const
+
+    Returns the value associated with the \a key.
+
+    If the hash contains no item with the \a key, the function
+    returns a \l{default-constructed value}.
+
+    \sa key(), values(), contains(), operator[]()
+*/
+
+/*! \fn const T QFlatHash::value(const Key &key, const T &defaultValue) const
+    \overload
+
+    If the hash contains no item with the given \a key, the function returns
+    \a defaultValue.
+*/
+
+/*! \fn T &QFlatHash::operator[](const Key &key)
+
+    Returns the value associated with the \a key as a modifiable
+    reference.
+
+    If the hash contains no item with the \a key, the function inserts
+    a \l{default-constructed value} into the hash with the \a key, and
+    returns a reference to it.
+
+    The reference is invalidated by the next insertion into the hash,
+    and by removing the item it refers to.
+
+    \sa insert(), value()
+*/
+
+/*! \fn const T QFlatHash::operator[](const Key &key) const
+
+    \overload
+
+    Same as value().
+*/
+
+/*! \fn const Key QFlatHash::key(const T &value) const
+
+    Returns the first key mapped to \a value, or a
+    \l{default-constructed value} if the hash contains no such item.
+
+    This function can be slow (\l{linear time}), because QFlatHash's
+    internal data structure is optimized for fast lookup by key, not
+    by value.
+
+    \sa value()
+*/
+
+/*! \fn const Key QFlatHash::key(const T &value, const Key &defaultKey) const
+    \overload
+
+    Returns the first key mapped to \a value, or \a defaultKey if the
+    hash contains no such item.
+*/
+
+/*! \fn QList<Key> QFlatHash::keys() const
+
+    Returns a list containing all the keys in the hash, in an
+    arbitrary order.
+
+    \sa values(), key()
+*/
+
+/*! \fn QList<T> QFlatHash::values() const
+
+    Returns a list containing all the values in the hash, in an
+    arbitrary order.
+
+    \sa keys(), value()
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::begin()
+
+    Returns an \l{STL-style iterators}{STL-style iterator} pointing to the first item in
+    the hash.
+
+    \sa constBegin(), end()
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::begin() const
+
+    \overload
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::cbegin() const
+
+    Returns a const \l{STL-style iterators}{STL-style iterator} pointing to the first item
+    in the hash.
+
+    \sa begin(), cend()
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::constBegin() const
+
+    Returns a const \l{STL-style iterators}{STL-style iterator} pointing to the first item
+    in the hash.
+
+    \sa begin(), constEnd()
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::end()
+
+    Returns an \l{STL-style iterators}{STL-style iterator} pointing to the imaginary item
+    after the last item in the hash.
+
+    \sa begin(), constEnd()
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::end() const
+
+    \overload
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::cend() const
+
+    Returns a const \l{STL-style iterators}{STL-style iterator} pointing to the imaginary
+    item after the last item in the hash.
+
+    \sa cbegin(), end()
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::constEnd() const
+
+    Returns a const \l{STL-style iterators}{STL-style iterator} pointing to the imaginary
+    item after the last item in the hash.
+
+    \sa constBegin(), end()
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::erase(iterator pos)
+
+    Removes the (key, value) pair associated with the iterator \a pos
+    from the hash, and returns an iterator to the next item in the
+    hash.
+
+    Unlike inserting, erasing does not invalidate other iterators.
+
+    \sa remove(), take(), find()
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::find(const Key &key)
+
+    Returns an iterator pointing to the item with the \a key in the
+    hash, or end() if the hash contains no item with the key.
+
+    \sa value(), contains()
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::find(const Key &key) const
+
+    \overload
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::constFind(const Key &key) const
+
+    Returns an iterator pointing to the item with the \a key in the
+    hash, or constEnd() if the hash contains no item with the key.
+
+    \sa find()
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::insert(const Key &key, const T &value)
+
+    Inserts a new item with the \a key and a value of \a value.
+
+    If there is already an item with the \a key, that item's value
+    is replaced with \a value.
+
+    Inserting invalidates all iterators and references into the hash.
+
+    \sa operator[]()
+*/
+
+/*! \typedef QFlatHash::difference_type
+
+    Typedef for ptrdiff_t. Provided for STL compatibility.
+*/
+
+/*! \typedef QFlatHash::key_type
+
+    Typedef for Key. Provided for STL compatibility.
+*/
+
+/*! \typedef QFlatHash::mapped_type
+
+    Typedef for T. Provided for STL compatibility.
+*/
+
+/*! \typedef QFlatHash::size_type
+
+    Typedef for int. Provided for STL compatibility.
+*/
+
+/*! \class QFlatHash::iterator
+    \inmodule QtCore
+    \brief The QFlatHash::iterator class provides an STL-style non-const iterator for QFlatHash.
+
+    QFlatHash::iterator works like QHash::iterator, except that it
+    is invalidated by any insertion into the hash.
+
+    \sa QFlatHash::const_iterator
+*/
+
+/*! \fn QFlatHash::iterator::iterator()
+
+    Constructs an uninitialized iterator.
+*/
+
+/*! \fn const Key &QFlatHash::iterator::key() const
+
+    Returns the current item's key.
+
+    \sa value()
+*/
+
+/*! \fn T &QFlatHash::iterator::value() const
+
+    Returns a modifiable reference to the current item's value.
+
+    \sa key(), operator*()
+*/
+
+/*! \fn T &QFlatHash::iterator::operator*() const
+
+    Returns a modifiable reference to the current item's value.
+
+    Same as value().
+*/
+
+/*! \fn T *QFlatHash::iterator::operator->() const
+
+    Returns a pointer to the current item's value.
+*/
+
+/*!
+    \fn bool QFlatHash::iterator::operator==(const iterator &other) const
+    \fn bool QFlatHash::iterator::operator==(const const_iterator &other) const
+
+    Returns \c true if \a other points to the same item as this
+    iterator; otherwise returns \c false.
+*/
+
+/*!
+    \fn bool QFlatHash::iterator::operator!=(const iterator &other) const
+    \fn bool QFlatHash::iterator::operator!=(const const_iterator &other) const
+
+    Returns \c true if \a other points to a different item than this
+    iterator; otherwise returns \c false.
+*/
+
+/*!
+    \fn QFlatHash::iterator &QFlatHash::iterator::operator++()
+
+    The prefix ++ operator (\c{++i}) advances the iterator to the
+    next item in the hash and returns an iterator to the new current
+    item.
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::iterator::operator++(int)
+
+    \overload
+
+    The postfix ++ operator (\c{i++}) advances the iterator to the
+    next item in the hash and returns an iterator to the previously
+    current item.
+*/
+
+/*!
+    \fn QFlatHash::iterator &QFlatHash::iterator::operator--()
+
+    The prefix -- operator (\c{--i}) makes the preceding item
+    current and returns an iterator pointing to the new current item.
+*/
+
+/*!
+    \fn QFlatHash::iterator QFlatHash::iterator::operator--(int)
+
+    \overload
+
+    The postfix -- operator (\c{i--}) makes the preceding item
+    current and returns an iterator pointing to the previously
+    current item.
+*/
+
+/*! \class QFlatHash::const_iterator
+    \inmodule QtCore
+    \brief The QFlatHash::const_iterator class provides an STL-style const iterator for QFlatHash.
+
+    \sa QFlatHash::iterator
+*/
+
+/*! \fn QFlatHash::const_iterator::const_iterator()
+
+    Constructs an uninitialized iterator.
+*/
+
+/*! \fn QFlatHash::const_iterator::const_iterator(const iterator &other)
+
+    Constructs a copy of \a other.
+*/
+
+/*! \fn const Key &QFlatHash::const_iterator::key() const
+
+    Returns the current item's key.
+*/
+
+/*! \fn const T &QFlatHash::const_iterator::value() const
+
+    Returns the current item's value.
+*/
+
+/*! \fn const T &QFlatHash::const_iterator::operator*() const
+
+    Same as value().
+*/
+
+/*! \fn const T *QFlatHash::const_iterator::operator->() const
+
+    Returns a pointer to the current item's value.
+*/
+
+/*! \fn bool QFlatHash::const_iterator::operator==(const const_iterator &other) const
+
+    Returns \c true if \a other points to the same item as this
+    iterator; otherwise returns \c false.
+*/
+
+/*! \fn bool QFlatHash::const_iterator::operator!=(const const_iterator &other) const
+
+    Returns \c true if \a other points to a different item than this
+    iterator; otherwise returns \c false.
+*/
+
+/*!
+    \fn QFlatHash::const_iterator &QFlatHash::const_iterator::operator++()
+    \fn QFlatHash::const_iterator QFlatHash::const_iterator::operator++(int)
+
+    Advances the iterator to the next item in the hash.
+*/
+
+/*!
+    \fn QFlatHash::const_iterator &QFlatHash::const_iterator::operator--()
+    \fn QFlatHash::const_iterator QFlatHash::const_iterator::operator--(int)
+
+    Makes the preceding item current.
+*/
+
+/*!
+    \class QFlatSet
+    \inmodule QtCore
+    \brief The QFlatSet class is a template class that provides an open
+    addressing hash-table-based set.
+    \since 5.3
+
+    \ingroup tools
+    \ingroup shared
+    \reentrant
+
+    QFlatSet<T> is to QFlatHash what QSet is to QHash: it stores values
+    in an unspecified order and provides very fast lookup of the values.
+    Internally, QFlatSet<T> is implemented as a QFlatHash.
+
+    As with QFlatHash, inserting into the set invalidates all iterators.
+
+    \sa QFlatHash, QSet
+*/
+
+/*! \fn QFlatSet::QFlatSet()
+
+    Constructs an empty set.
+*/
+
+/*! \fn QFlatSet::QFlatSet(std::initializer_list<T> list)
+
+    Constructs a set with a copy of each of the elements in the
+    initializer list \a list.
+
+    This function is only available if the program is being
+    compiled in C++11 mode.
+*/
+
+/*! \fn void QFlatSet::swap(QFlatSet<T> &other)
+
+    Swaps set \a other with this set. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    \fn bool QFlatSet::operator==(const QFlatSet<T> &other) const
+
+    Returns \c true if the \a other set is equal to this set; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool QFlatSet::operator!=(const QFlatSet<T> &other) const
+
+    Returns \c true if the \a other set is not equal to this set; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn int QFlatSet::size() const
+    \fn int QFlatSet::count() const
+
+    Returns the number of items in the set.
+*/
+
+/*!
+    \fn bool QFlatSet::isEmpty() const
+    \fn bool QFlatSet::empty() const
+
+    Returns \c true if the set contains no elements; otherwise returns
+    false.
+*/
+
+/*!
+    \fn int QFlatSet::capacity() const
+    \fn void QFlatSet::reserve(int size)
+    \fn void QFlatSet::squeeze()
+
+    See QFlatHash::capacity(), QFlatHash::reserve() and QFlatHash::squeeze().
+*/
+
+/*!
+    \fn void QFlatSet::detach()
+    \fn bool QFlatSet::isDetached() const
+
+    \internal
+*/
+
+/*!
+    \fn void QFlatSet::clear()
+
+    Removes all elements from the set.
+*/
+
+/*!
+    \fn bool QFlatSet::remove(const T &value)
+
+    Removes any occurrence of item \a value from the set. Returns
+    true if an item was actually removed; otherwise returns \c false.
+*/
+
+/*!
+    \fn bool QFlatSet::contains(const T &value) const
+
+    Returns \c true if the set contains item \a value; otherwise returns
+    false.
+*/
+
+/*!
+    \fn QFlatSet::const_iterator QFlatSet::insert(const T &value)
+
+    Inserts item \a value into the set, if \a value isn't already
+    in the set, and returns an iterator pointing at the inserted
+    item.
+*/
+
+/*!
+    \fn QFlatSet::const_iterator QFlatSet::find(const T &value) const
+    \fn QFlatSet::const_iterator QFlatSet::constFind(const T &value) const
+
+    Returns a const iterator positioned at the item \a value in the
+    set, or constEnd() if the set doesn't contain \a value.
+*/
+
+/*!
+    \fn QFlatSet::const_iterator QFlatSet::begin() const
+    \fn QFlatSet::const_iterator QFlatSet::cbegin() const
+    \fn QFlatSet::const_iterator QFlatSet::constBegin() const
+
+    Returns a const \l{STL-style iterators}{STL-style iterator} positioned
+    at the first item in the set.
+*/
+
+/*!
+    \fn QFlatSet::const_iterator QFlatSet::end() const
+    \fn QFlatSet::const_iterator QFlatSet::cend() const
+    \fn QFlatSet::const_iterator QFlatSet::constEnd() const
+
+    Returns a const \l{STL-style iterators}{STL-style iterator} pointing
+    to the imaginary item after the last item in the set.
+*/
+
+/*!
+    \fn QList<T> QFlatSet::toList() const
+    \fn QList<T> QFlatSet::values() const
+
+    Returns a new QList containing the elements in the set, in an
+    arbitrary order.
+*/
+
+/*! \class QFlatSet::const_iterator
+    \inmodule QtCore
+    \brief The QFlatSet::const_iterator class provides an STL-style const iterator for QFlatSet.
+*/
+
+/*! \typedef QFlatSet::iterator
+
+    Synonym for QFlatSet::const_iterator; values in a set can't be
+    modified in place.
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,914 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATHASH_H
+#define QFLATHASH_H
+
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qrefcount.h>
+
+#include <string.h>
+#include <new>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+#include <initializer_list>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+struct Q_CORE_EXPORT QFlatHashData
+{
+    enum {
+        GroupSize = 16,
+        MinimumCapacity = GroupSize
+    };
+
+    // control byte values; a full slot stores the low 7 bits of the hash
+    enum {
+        Empty = -128,
+        Deleted = -2
+    };
+
+    QtPrivate::RefCount ref;
+    int size;
+    int capacity;       // 0 or a power of two, at least GroupSize
+    int growthLeft;     // insertions into empty slots left before we rehash
+    uint seed;
+    int nodeOffset;     // offset of the node array, from the start of this struct
+
+    // the control bytes follow this struct, aligned to GroupSize;
+    // the node array follows the control bytes
+
+    inline signed char *controlBytes()
+    { return reinterpret_cast<signed char *>(this) + controlOffset(); }
+    inline const signed char *controlBytes() const
+    { return reinterpret_cast<const signed char *>(this) + controlOffset(); }
+    inline void *nodes() { return reinterpret_cast<char *>(this) + nodeOffset; }
+    inline const void *nodes() const { return reinterpret_cast<const char *>(this) + nodeOffset; }
+
+    static inline int controlOffset()
+    { return (int(sizeof(QFlatHashData)) + GroupSize - 1) & ~(GroupSize - 1); }
+    static inline int maximumLoad(int capacity) { return capacity - capacity / 8; }
+
+    static QFlatHashData *allocate(int capacity, int nodeSize, int nodeAlign);
+    static void free(QFlatHashData *d);
+    static int capacityForSize(int size);
+
+    static const QFlatHashData shared_null;
+};
+
+// A group of control bytes, probed together. With SSE2 all GroupSize bytes
+// are compared in one instruction; otherwise we fall back to a plain loop.
+class QFlatHashGroup
+{
+public:
+    explicit inline QFlatHashGroup(const signed char *ctrl)
+#if defined(__SSE2__)
+        : c(_mm_load_si128(reinterpret_cast<const __m128i *>(ctrl)))
+#else
+        : c(ctrl)
+#endif
+    {}
+
+    // each of these returns a bit mask with one bit per matching slot
+#if defined(__SSE2__)
+    inline uint match(signed char h2) const
+    { return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), c)); }
+    inline uint matchEmpty() const
+    { return match(QFlatHashData::Empty); }
+    inline uint matchEmptyOrDeleted() const
+    { return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), c)); }
+#else
+    inline uint match(signed char h2) const
+    {
+        uint mask = 0;
+        for (int i = 0; i < QFlatHashData::GroupSize; ++i)
+            mask |= uint(c[i] == h2) << i;
+        return mask;
+    }
+    inline uint matchEmpty() const
+    { return match(QFlatHashData::Empty); }
+    inline uint matchEmptyOrDeleted() const
+    {
+        uint mask = 0;
+        for (int i = 0; i < QFlatHashData::GroupSize; ++i)
+            mask |= uint(c[i] < -1) << i;
+        return mask;
+    }
+#endif
+
+    static inline int lowestBit(uint mask)
+    {
+        Q_ASSERT(mask);
+#if defined(Q_CC_GNU)
+        return __builtin_ctz(mask);
+#else
+        int i = 0;
+        while (!(mask & 1)) {
+            mask >>= 1;
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+private:
+#if defined(__SSE2__)
+    __m128i c;
+#else
+    const signed char *c;
+#endif
+};
+
+template <class Key, class T>
+struct QFlatHashNode
+{
+    inline QFlatHashNode(const Key &key0, const T &value0) : key(key0), value(value0) {}
+
+    Key key;
+    T value;
+};
+
+template <class Key, class T>
+class QFlatHash
+{
+    typedef QFlatHashNode<Key, T> Node;
+
+    QFlatHashData *d;
+
+    static inline int alignOfNode() { return qMax<int>(sizeof(void*), Q_ALIGNOF(Node)); }
+    static inline Node *nodes(QFlatHashData *x) { return static_cast<Node *>(x->nodes()); }
+    static inline const Node *nodes(const QFlatHashData *x) { return static_cast<const Node *>(x->nodes()); }
+
+    static inline uint mix(uint h)
+    {
+        // qHash() of integer types is the identity (xor the seed), so
+        // spread the bits before splitting the hash into H1 and H2
+        h ^= h >> 16;
+        h *= 0x85ebca6bU;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35U;
+        h ^= h >> 16;
+        return h;
+    }
+    static inline uint h1(uint h) { return h >> 7; }
+    static inline signed char h2(uint h) { return static_cast<signed char>(h & 0x7f); }
+
+public:
+    inline QFlatHash() : d(const_cast<QFlatHashData *>(&QFlatHashData::shared_null)) { }
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    inline QFlatHash(std::initializer_list<std::pair<Key,T> > list)
+        : d(const_cast<QFlatHashData *>(&QFlatHashData::shared_null))
+    {
+        reserve(int(list.size()));
+        for (typename std::initializer_list<std::pair<Key,T> >::const_iterator it = list.begin(); it != list.end(); ++it)
+            insert(it->first, it->second);
+    }
+#endif
+    inline QFlatHash(const QFlatHash<Key, T> &other) : d(other.d) { if (!d->ref.ref()) d = duplicate(other.d); }
+    inline ~QFlatHash() { if (!d->ref.deref()) freeData(d); }
+
+    QFlatHash<Key, T> &operator=(const QFlatHash<Key, T> &other);
+#ifdef Q_COMPILER_RVALUE_REFS
+    inline QFlatHash(QFlatHash<Key, T> &&other) : d(other.d)
+    { other.d = const_cast<QFlatHashData *>(&QFlatHashData::shared_null); }
+    inline QFlatHash<Key, T> &operator=(QFlatHash<Key, T> &&other)
+    { qSwap(d, other.d); return *this; }
+#endif
+    inline void swap(QFlatHash<Key, T> &other) { qSwap(d, other.d); }
+
+    bool operator==(const QFlatHash<Key, T> &other) const;
+    inline bool operator!=(const QFlatHash<Key, T> &other) const { return !(*this == other); }
+
+    inline int size() const { return d->size; }
+    inline int count() const { return d->size; }
+    inline bool isEmpty() const { return d->size == 0; }
+
+    inline int capacity() const { return QFlatHashData::maximumLoad(d->capacity); }
+    void reserve(int size);
+    inline void squeeze() { reserve(d->size); }
+
+    inline void detach() { if (d->ref.isShared() && !d->ref.isStatic()) detach_helper(); }
+    inline bool isDetached() const { return !d->ref.isShared(); }
+    inline void setSharable(bool sharable)
+    {
+        if (sharable == d->ref.isSharable())
+            return;
+        if (!sharable) {
+            detach();
+            if (d->ref.isStatic())
+                rehash(QFlatHashData::MinimumCapacity);
+        }
+        d->ref.setSharable(sharable);
+    }
+    inline bool isSharedWith(const QFlatHash<Key, T> &other) const { return d == other.d; }
+
+    void clear();
+
+    int remove(const Key &key);
+    T take(const Key &key);
+
+    inline bool contains(const Key &key) const { return findIndex(key) >= 0; }
+    inline int count(const Key &key) const { return findIndex(key) >= 0 ? 1 : 0; }
+    const Key key(const T &value) const;
+    const Key key(const T &value, const Key &defaultKey) const;
+    const T value(const Key &key) const;
+    const T value(const Key &key, const T &defaultValue) const;
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const;
+
+    QList<Key> keys() const;
+    QList<T> values() const;
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class const_iterator;
+        friend class QFlatHash<Key, T>;
+        QFlatHashData *d;
+        int i;
+
+        inline iterator(QFlatHashData *data, int index) : d(data), i(index) { }
+        inline Node *node() const { return QFlatHash<Key, T>::nodes(d) + i; }
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        inline iterator() : d(0), i(0) { }
+
+        inline const Key &key() const { return node()->key; }
+        inline T &value() const { return node()->value; }
+        inline T &operator*() const { return node()->value; }
+        inline T *operator->() const { return &node()->value; }
+        inline bool operator==(const iterator &o) const { return i == o.i; }
+        inline bool operator!=(const iterator &o) const { return i != o.i; }
+
+        inline iterator &operator++()
+        {
+            const signed char *ctrl = d->controlBytes();
+            do {
+                ++i;
+            } while (i < d->capacity && ctrl[i] < 0);
+            return *this;
+        }
+        inline iterator operator++(int) { iterator r = *this; ++*this; return r; }
+        inline iterator &operator--()
+        {
+            const signed char *ctrl = d->controlBytes();
+            do {
+                --i;
+            } while (i > 0 && ctrl[i] < 0);
+            return *this;
+        }
+        inline iterator operator--(int) { iterator r = *this; --*this; return r; }
+
+        inline bool operator==(const const_iterator &o) const { return i == o.i; }
+        inline bool operator!=(const const_iterator &o) const { return i != o.i; }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class iterator;
+        friend class QFlatHash<Key, T>;
+        const QFlatHashData *d;
+        int i;
+
+        inline const_iterator(const QFlatHashData *data, int index) : d(data), i(index) { }
+        inline const Node *node() const { return QFlatHash<Key, T>::nodes(d) + i; }
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        inline const_iterator() : d(0), i(0) { }
+        inline const_iterator(const iterator &o) : d(o.d), i(o.i) { }
+
+        inline const Key &key() const { return node()->key; }
+        inline const T &value() const { return node()->value; }
+        inline const T &operator*() const { return node()->value; }
+        inline const T *operator->() const { return &node()->value; }
+        inline bool operator==(const const_iterator &o) const { return i == o.i; }
+        inline bool operator!=(const const_iterator &o) const { return i != o.i; }
+
+        inline const_iterator &operator++()
+        {
+            const signed char *ctrl = d->controlBytes();
+            do {
+                ++i;
+            } while (i < d->capacity && ctrl[i] < 0);
+            return *this;
+        }
+        inline const_iterator operator++(int) { const_iterator r = *this; ++*this; return r; }
+        inline const_iterator &operator--()
+        {
+            const signed char *ctrl = d->controlBytes();
+            do {
+                --i;
+            } while (i > 0 && ctrl[i] < 0);
+            return *this;
+        }
+        inline const_iterator operator--(int) { const_iterator r = *this; --*this; return r; }
+    };
+    friend class const_iterator;
+
+    // STL style
+    inline iterator begin() { detach(); return iterator(d, firstIndex()); }
+    inline const_iterator begin() const { return const_iterator(d, firstIndex()); }
+    inline const_iterator cbegin() const { return const_iterator(d, firstIndex()); }
+    inline const_iterator constBegin() const { return const_iterator(d, firstIndex()); }
+    inline iterator end() { detach(); return iterator(d, d->capacity); }
+    inline const_iterator end() const { return const_iterator(d, d->capacity); }
+    inline const_iterator cend() const { return const_iterator(d, d->capacity); }
+    inline const_iterator constEnd() const { return const_iterator(d, d->capacity); }
+
+    iterator erase(iterator it);
+
+    iterator find(const Key &key);
+    const_iterator find(const Key &key) const;
+    const_iterator constFind(const Key &key) const;
+    iterator insert(const Key &key, const T &value);
+
+    // STL compatibility
+    typedef T mapped_type;
+    typedef Key key_type;
+    typedef qptrdiff difference_type;
+    typedef int size_type;
+
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    void detach_helper();
+    static QFlatHashData *duplicate(const QFlatHashData *from);
+    void rehash(int newCapacity);
+    void freeData(QFlatHashData *x);
+    int firstIndex() const;
+    int findIndex(const Key &key) const;
+    int findIndex(const Key &key, uint h) const;
+    int findInsertIndex(uint h) const;
+    int insertIndex(const Key &key, bool *found);
+    void eraseIndex(int index);
+
+    static inline uint hashOf(const Key &key, uint seed) { return mix(qHash(key, seed)); }
+};
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE void QFlatHash<Key, T>::freeData(QFlatHashData *x)
+{
+    if (QTypeInfo<Key>::isComplex || QTypeInfo<T>::isComplex) {
+        const signed char *ctrl = x->controlBytes();
+        Node *n = nodes(x);
+        for (int i = 0; i < x->capacity; ++i) {
+            if (ctrl[i] >= 0)
+                n[i].~Node();
+        }
+    }
+    QFlatHashData::free(x);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QFlatHashData *QFlatHash<Key, T>::duplicate(const QFlatHashData *from)
+{
+    if (from->capacity == 0)
+        return const_cast<QFlatHashData *>(&QFlatHashData::shared_null);
+
+    QFlatHashData *x = QFlatHashData::allocate(from->capacity, sizeof(Node), alignOfNode());
+    x->size = from->size;
+    x->growthLeft = from->growthLeft;
+    x->seed = from->seed;
+
+    // same capacity and seed: every node keeps its slot
+    const signed char *ctrl = from->controlBytes();
+    ::memcpy(x->controlBytes(), ctrl, from->capacity);
+    const Node *src = nodes(from);
+    Node *dst = nodes(x);
+    for (int i = 0; i < from->capacity; ++i) {
+        if (ctrl[i] >= 0)
+            new (dst + i) Node(src[i]);
+    }
+    return x;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::detach_helper()
+{
+    QFlatHashData *x = duplicate(d);
+    if (!d->ref.deref())
+        freeData(d);
+    d = x;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::rehash(int newCapacity)
+{
+    QFlatHashData *x;
+    if (newCapacity) {
+        x = QFlatHashData::allocate(newCapacity, sizeof(Node), alignOfNode());
+        if (d->capacity)
+            x->seed = d->seed;
+        x->size = d->size;
+        x->growthLeft = QFlatHashData::maximumLoad(newCapacity) - d->size;
+        if (!d->ref.isSharable())
+            x->ref.initializeUnsharable();
+    } else {
+        x = const_cast<QFlatHashData *>(&QFlatHashData::shared_null);
+    }
+
+    const bool relocate = !d->ref.isShared() && !QTypeInfo<Key>::isStatic && !QTypeInfo<T>::isStatic;
+    const signed char *ctrl = d->controlBytes();
+    Node *src = nodes(d);
+    signed char *newCtrl = x->controlBytes();
+    Node *dst = nodes(x);
+    for (int i = 0; i < d->capacity; ++i) {
+        if (ctrl[i] < 0)
+            continue;
+        const uint h = hashOf(src[i].key, x->seed);
+        int slot = -1;
+        {
+            // find the first free slot for h in the new table, which has no
+            // deleted slots and can't contain the key yet
+            const int groupMask = (x->capacity / QFlatHashData::GroupSize) - 1;
+            int group = h1(h) & groupMask;
+            for (int step = 1; ; ++step) {
+                const int offset = group * QFlatHashData::GroupSize;
+                const uint mask = QFlatHashGroup(newCtrl + offset).matchEmpty();
+                if (mask) {
+                    slot = offset + QFlatHashGroup::lowestBit(mask);
+                    break;
+                }
+                group = (group + step) & groupMask;
+            }
+        }
+        newCtrl[slot] = h2(h);
+        if (relocate)
+            ::memcpy(static_cast<void *>(dst + slot), static_cast<const void *>(src + i), sizeof(Node));
+        else
+            new (dst + slot) Node(src[i]);
+    }
+
+    if (!d->ref.deref()) {
+        if (relocate)
+            QFlatHashData::free(d);
+        else
+            freeData(d);
+    }
+    d = x;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE int QFlatHash<Key, T>::firstIndex() const
+{
+    const signed char *ctrl = d->controlBytes();
+    int i = 0;
+    while (i < d->capacity && ctrl[i] < 0)
+        ++i;
+    return i;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE int QFlatHash<Key, T>::findIndex(const Key &key) const
+{
+    if (!d->size)
+        return -1;
+    return findIndex(key, hashOf(key, d->seed));
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::findIndex(const Key &key, uint h) const
+{
+    Q_ASSERT(d->capacity);
+    const signed char *ctrl = d->controlBytes();
+    const Node *n = nodes(d);
+    const signed char tag = h2(h);
+    const int groupMask = (d->capacity / QFlatHashData::GroupSize) - 1;
+    int group = h1(h) & groupMask;
+
+    // triangular probing visits every group exactly once, as the number
+    // of groups is a power of two
+    for (int step = 1; step <= groupMask + 1; ++step) {
+        const int offset = group * QFlatHashData::GroupSize;
+        const QFlatHashGroup g(ctrl + offset);
+        uint mask = g.match(tag);
+        while (mask) {
+            const int i = offset + QFlatHashGroup::lowestBit(mask);
+            if (n[i].key == key)
+                return i;
+            mask &= mask - 1;
+        }
+        if (g.matchEmpty())
+            return -1;
+        group = (group + step) & groupMask;
+    }
+    return -1;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::findInsertIndex(uint h) const
+{
+    const signed char *ctrl = d->controlBytes();
+    const int groupMask = (d->capacity / QFlatHashData::GroupSize) - 1;
+    int group = h1(h) & groupMask;
+    for (int step = 1; ; ++step) {
+        const int offset = group * QFlatHashData::GroupSize;
+        const uint mask = QFlatHashGroup(ctrl + offset).matchEmptyOrDeleted();
+        if (mask)
+            return offset + QFlatHashGroup::lowestBit(mask);
+        group = (group + step) & groupMask;
+    }
+}
+
+// Returns the index of \a key, detaching if necessary. If the key was not
+// in the hash yet, a slot is reserved for it and the caller must construct
+// the node.
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::insertIndex(const Key &key, bool *found)
+{
+    detach();
+    if (d->capacity == 0)
+        rehash(QFlatHashData::MinimumCapacity);
+
+    uint h = hashOf(key, d->seed);
+    int i = d->size ? findIndex(key, h) : -1;
+    if (i >= 0) {
+        *found = true;
+        return i;
+    }
+    *found = false;
+
+    i = findInsertIndex(h);
+    signed char *ctrl = d->controlBytes();
+    if (d->growthLeft == 0 && ctrl[i] == QFlatHashData::Empty) {
+        // grow, unless most of the occupied slots are tombstones
+        if (d->size > QFlatHashData::maximumLoad(d->capacity) / 2)
+            rehash(d->capacity * 2);
+        else
+            rehash(d->capacity);
+        i = findInsertIndex(h);
+        ctrl = d->controlBytes();
+    }
+    if (ctrl[i] == QFlatHashData::Empty)
+        --d->growthLeft;
+    ctrl[i] = h2(h);
+    ++d->size;
+    return i;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::eraseIndex(int i)
+{
+    signed char *ctrl = d->controlBytes();
+    nodes(d)[i].~Node();
+
+    // If the group of this slot still has an empty slot, no probe sequence
+    // can have continued past it, so the slot can become empty again.
+    const int offset = i & ~(QFlatHashData::GroupSize - 1);
+    if (QFlatHashGroup(ctrl + offset).matchEmpty()) {
+        ctrl[i] = QFlatHashData::Empty;
+        ++d->growthLeft;
+    } else {
+        ctrl[i] = QFlatHashData::Deleted;
+    }
+    --d->size;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE QFlatHash<Key, T> &QFlatHash<Key, T>::operator=(const QFlatHash<Key, T> &other)
+{
+    if (d != other.d) {
+        QFlatHash<Key, T> copy(other);
+        qSwap(d, copy.d);
+    }
+    return *this;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE bool QFlatHash<Key, T>::operator==(const QFlatHash<Key, T> &other) const
+{
+    if (size() != other.size())
+        return false;
+    if (d == other.d)
+        return true;
+
+    for (const_iterator it = begin(); it != end(); ++it) {
+        const int i = other.findIndex(it.key());
+        if (i < 0 || !(nodes(other.d)[i].value == it.value()))
+            return false;
+    }
+    return true;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::reserve(int asize)
+{
+    const int newCapacity = QFlatHashData::capacityForSize(qMax(asize, d->size));
+    if (newCapacity != d->capacity)
+        rehash(newCapacity);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE void QFlatHash<Key, T>::clear()
+{
+    *this = QFlatHash<Key, T>();
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::remove(const Key &key)
+{
+    if (isEmpty()) // prevents detaching shared null
+        return 0;
+    if (findIndex(key) < 0)
+        return 0;
+    detach();
+    eraseIndex(findIndex(key));
+    return 1;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE T QFlatHash<Key, T>::take(const Key &key)
+{
+    if (isEmpty()) // prevents detaching shared null
+        return T();
+    if (findIndex(key) < 0)
+        return T();
+    detach();
+    const int i = findIndex(key);
+    T t = nodes(d)[i].value;
+    eraseIndex(i);
+    return t;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatHash<Key, T>::key(const T &avalue) const
+{
+    return key(avalue, Key());
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatHash<Key, T>::key(const T &avalue, const Key &defaultKey) const
+{
+    for (const_iterator it = begin(); it != end(); ++it) {
+        if (it.value() == avalue)
+            return it.key();
+    }
+    return defaultKey;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::value(const Key &akey) const
+{
+    const int i = findIndex(akey);
+    return i < 0 ? T() : nodes(d)[i].value;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::value(const Key &akey, const T &defaultValue) const
+{
+    const int i = findIndex(akey);
+    return i < 0 ? defaultValue : nodes(d)[i].value;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T &QFlatHash<Key, T>::operator[](const Key &akey)
+{
+    bool found;
+    const int i = insertIndex(akey, &found);
+    if (!found)
+        new (nodes(d) + i) Node(akey, T());
+    return nodes(d)[i].value;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::operator[](const Key &akey) const
+{
+    return value(akey);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QFlatHash<Key, T>::keys() const
+{
+    QList<Key> res;
+    res.reserve(size());
+    for (const_iterator it = begin(); it != end(); ++it)
+        res.append(it.key());
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<T> QFlatHash<Key, T>::values() const
+{
+    QList<T> res;
+    res.reserve(size());
+    for (const_iterator it = begin(); it != end(); ++it)
+        res.append(it.value());
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::erase(iterator it)
+{
+    if (it == iterator(d, d->capacity))
+        return it;
+
+    if (d->ref.isShared()) {
+        // remember the key, since detaching invalidates the iterator
+        const Key akey = it.key();
+        detach();
+        it = iterator(d, findIndex(akey));
+    }
+
+    iterator next = it;
+    ++next;
+    eraseIndex(it.i);
+    return next;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::find(const Key &akey)
+{
+    detach();
+    const int i = findIndex(akey);
+    return iterator(d, i < 0 ? d->capacity : i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::const_iterator QFlatHash<Key, T>::find(const Key &akey) const
+{
+    return constFind(akey);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::const_iterator QFlatHash<Key, T>::constFind(const Key &akey) const
+{
+    const int i = findIndex(akey);
+    return const_iterator(d, i < 0 ? d->capacity : i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::insert(const Key &akey, const T &avalue)
+{
+    bool found;
+    const int i = insertIndex(akey, &found);
+    Node *n = nodes(d) + i;
+    if (!found)
+        new (n) Node(akey, avalue);
+    else
+        n->value = avalue;
+    return iterator(d, i);
+}
+
+Q_DECLARE_ASSOCIATIVE_ITERATOR(FlatHash)
+Q_DECLARE_MUTABLE_ASSOCIATIVE_ITERATOR(FlatHash)
+
+template <class T>
+class QFlatSet
+{
+    typedef QFlatHash<T, QHashDummyValue> Hash;
+
+public:
+    inline QFlatSet() {}
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    inline QFlatSet(std::initializer_list<T> list)
+    {
+        reserve(int(list.size()));
+        for (typename std::initializer_list<T>::const_iterator it = list.begin(); it != list.end(); ++it)
+            insert(*it);
+    }
+#endif
+
+    inline void swap(QFlatSet<T> &other) { q_hash.swap(other.q_hash); }
+
+    inline bool operator==(const QFlatSet<T> &other) const
+    { return q_hash == other.q_hash; }
+    inline bool operator!=(const QFlatSet<T> &other) const
+    { return q_hash != other.q_hash; }
+
+    inline int size() const { return q_hash.size(); }
+    inline int count() const { return q_hash.count(); }
+    inline bool isEmpty() const { return q_hash.isEmpty(); }
+
+    inline int capacity() const { return q_hash.capacity(); }
+    inline void reserve(int size) { q_hash.reserve(size); }
+    inline void squeeze() { q_hash.squeeze(); }
+
+    inline void detach() { q_hash.detach(); }
+    inline bool isDetached() const { return q_hash.isDetached(); }
+
+    inline void clear() { q_hash.clear(); }
+
+    inline bool remove(const T &value) { return q_hash.remove(value) != 0; }
+    inline bool contains(const T &value) const { return q_hash.contains(value); }
+
+    class const_iterator
+    {
+        typedef typename Hash::const_iterator Iterator;
+        Iterator i;
+        friend class QFlatSet<T>;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        inline const_iterator() {}
+        inline const_iterator(const Iterator &o) : i(o) {}
+        inline const T &operator*() const { return i.key(); }
+        inline const T *operator->() const { return &i.key(); }
+        inline bool operator==(const const_iterator &o) const { return i == o.i; }
+        inline bool operator!=(const const_iterator &o) const { return i != o.i; }
+        inline const_iterator &operator++() { ++i; return *this; }
+        inline const_iterator operator++(int) { const_iterator r = *this; ++i; return r; }
+        inline const_iterator &operator--() { --i; return *this; }
+        inline const_iterator operator--(int) { const_iterator r = *this; --i; return r; }
+    };
+    typedef const_iterator iterator;
+
+    // STL style
+    inline const_iterator begin() const { return q_hash.begin(); }
+    inline const_iterator cbegin() const { return q_hash.begin(); }
+    inline const_iterator constBegin() const { return q_hash.constBegin(); }
+    inline const_iterator end() const { return q_hash.end(); }
+    inline const_iterator cend() const { return q_hash.end(); }
+    inline const_iterator constEnd() const { return q_hash.constEnd(); }
+
+    inline const_iterator find(const T &value) const { return q_hash.find(value); }
+    inline const_iterator constFind(const T &value) const { return q_hash.constFind(value); }
+    inline const_iterator insert(const T &value)
+    { return static_cast<typename Hash::const_iterator>(q_hash.insert(value, QHashDummyValue())); }
+
+    QList<T> toList() const { return q_hash.keys(); }
+    inline QList<T> values() const { return toList(); }
+
+    // STL compatibility
+    typedef T key_type;
+    typedef T value_type;
+    typedef value_type *pointer;
+    typedef const value_type *const_pointer;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    typedef qptrdiff difference_type;
+    typedef int size_type;
+
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    Hash q_hash;
+};
+
+Q_DECLARE_SEQUENTIAL_ITERATOR(FlatSet)
+
+QT_END_NAMESPACE
+
+#endif // QFLATHASH_H
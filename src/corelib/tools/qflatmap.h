@@ -0,0 +1,458 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATMAP_H
+#define QFLATMAP_H
+
+#include <QtCore/qlist.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+#include <initializer_list>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+template <class Key>
+struct QFlatMapIndexLessThan
+{
+    inline QFlatMapIndexLessThan(const Key *keys) : k(keys) {}
+    inline bool operator()(int a, int b) const { return k[a] < k[b]; }
+    const Key *k;
+};
+}
+
+template <class Key, class T>
+class QFlatMap
+{
+    QVector<Key> k;
+    QVector<T> v;
+
+public:
+    inline QFlatMap() { }
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    inline QFlatMap(std::initializer_list<std::pair<Key,T> > list)
+    {
+        k.reserve(int(list.size()));
+        v.reserve(int(list.size()));
+        for (typename std::initializer_list<std::pair<Key,T> >::const_iterator it = list.begin(); it != list.end(); ++it) {
+            k.append(it->first);
+            v.append(it->second);
+        }
+        makeSorted();
+    }
+#endif
+    QFlatMap(const QVector<Key> &keys, const QVector<T> &values);
+    explicit QFlatMap(const QMap<Key, T> &map);
+
+    inline void swap(QFlatMap<Key, T> &other) { k.swap(other.k); v.swap(other.v); }
+
+    inline bool operator==(const QFlatMap<Key, T> &other) const { return k == other.k && v == other.v; }
+    inline bool operator!=(const QFlatMap<Key, T> &other) const { return !(*this == other); }
+
+    QMap<Key, T> toMap() const;
+
+    inline int size() const { return k.size(); }
+    inline int count() const { return k.size(); }
+    inline bool isEmpty() const { return k.isEmpty(); }
+
+    inline int capacity() const { return k.capacity(); }
+    inline void reserve(int size) { k.reserve(size); v.reserve(size); }
+    inline void squeeze() { k.squeeze(); v.squeeze(); }
+
+    inline void detach() { k.detach(); v.detach(); }
+    inline bool isDetached() const { return k.isDetached() && v.isDetached(); }
+
+    inline void clear() { k.clear(); v.clear(); }
+
+    int remove(const Key &key);
+    T take(const Key &key);
+
+    inline bool contains(const Key &key) const { return indexOf(key) >= 0; }
+    inline int count(const Key &key) const { return indexOf(key) >= 0 ? 1 : 0; }
+    const Key key(const T &value, const Key &defaultKey = Key()) const;
+    const T value(const Key &key, const T &defaultValue = T()) const;
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const;
+
+    inline QList<Key> keys() const { return k.toList(); }
+    inline QList<T> values() const { return v.toList(); }
+    inline const QVector<Key> &keyVector() const { return k; }
+    inline const QVector<T> &valueVector() const { return v; }
+
+    inline const Key &firstKey() const { Q_ASSERT(!isEmpty()); return k.first(); }
+    inline const Key &lastKey() const { Q_ASSERT(!isEmpty()); return k.last(); }
+
+    inline T &first() { Q_ASSERT(!isEmpty()); return v.first(); }
+    inline const T &first() const { Q_ASSERT(!isEmpty()); return v.first(); }
+    inline T &last() { Q_ASSERT(!isEmpty()); return v.last(); }
+    inline const T &last() const { Q_ASSERT(!isEmpty()); return v.last(); }
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class const_iterator;
+        friend class QFlatMap<Key, T>;
+        const Key *k;
+        T *v;
+
+        inline iterator(const Key *key, T *value) : k(key), v(value) { }
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        inline iterator() : k(0), v(0) { }
+
+        inline const Key &key() const { return *k; }
+        inline T &value() const { return *v; }
+        inline T &operator*() const { return *v; }
+        inline T *operator->() const { return v; }
+        inline bool operator==(const iterator &o) const { return k == o.k; }
+        inline bool operator!=(const iterator &o) const { return k != o.k; }
+        inline bool operator<(const iterator &o) const { return k < o.k; }
+        inline bool operator<=(const iterator &o) const { return k <= o.k; }
+        inline bool operator>(const iterator &o) const { return k > o.k; }
+        inline bool operator>=(const iterator &o) const { return k >= o.k; }
+
+        inline iterator &operator++() { ++k; ++v; return *this; }
+        inline iterator operator++(int) { iterator r = *this; ++k; ++v; return r; }
+        inline iterator &operator--() { --k; --v; return *this; }
+        inline iterator operator--(int) { iterator r = *this; --k; --v; return r; }
+        inline iterator &operator+=(int j) { k += j; v += j; return *this; }
+        inline iterator &operator-=(int j) { k -= j; v -= j; return *this; }
+        inline iterator operator+(int j) const { return iterator(k + j, v + j); }
+        inline iterator operator-(int j) const { return iterator(k - j, v - j); }
+        inline int operator-(iterator j) const { return int(k - j.k); }
+
+        inline bool operator==(const const_iterator &o) const { return k == o.k; }
+        inline bool operator!=(const const_iterator &o) const { return k != o.k; }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class iterator;
+        friend class QFlatMap<Key, T>;
+        const Key *k;
+        const T *v;
+
+        inline const_iterator(const Key *key, const T *value) : k(key), v(value) { }
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        inline const_iterator() : k(0), v(0) { }
+        inline const_iterator(const iterator &o) : k(o.k), v(o.v) { }
+
+        inline const Key &key() const { return *k; }
+        inline const T &value() const { return *v; }
+        inline const T &operator*() const { return *v; }
+        inline const T *operator->() const { return v; }
+        inline bool operator==(const const_iterator &o) const { return k == o.k; }
+        inline bool operator!=(const const_iterator &o) const { return k != o.k; }
+        inline bool operator<(const const_iterator &o) const { return k < o.k; }
+        inline bool operator<=(const const_iterator &o) const { return k <= o.k; }
+        inline bool operator>(const const_iterator &o) const { return k > o.k; }
+        inline bool operator>=(const const_iterator &o) const { return k >= o.k; }
+
+        inline const_iterator &operator++() { ++k; ++v; return *this; }
+        inline const_iterator operator++(int) { const_iterator r = *this; ++k; ++v; return r; }
+        inline const_iterator &operator--() { --k; --v; return *this; }
+        inline const_iterator operator--(int) { const_iterator r = *this; --k; --v; return r; }
+        inline const_iterator &operator+=(int j) { k += j; v += j; return *this; }
+        inline const_iterator &operator-=(int j) { k -= j; v -= j; return *this; }
+        inline const_iterator operator+(int j) const { return const_iterator(k + j, v + j); }
+        inline const_iterator operator-(int j) const { return const_iterator(k - j, v - j); }
+        inline int operator-(const_iterator j) const { return int(k - j.k); }
+    };
+    friend class const_iterator;
+
+    // STL style
+    inline iterator begin() { return iterator(k.constData(), v.data()); }
+    inline const_iterator begin() const { return const_iterator(k.constData(), v.constData()); }
+    inline const_iterator cbegin() const { return const_iterator(k.constData(), v.constData()); }
+    inline const_iterator constBegin() const { return const_iterator(k.constData(), v.constData()); }
+    inline iterator end() { return begin() + size(); }
+    inline const_iterator end() const { return constBegin() + size(); }
+    inline const_iterator cend() const { return constBegin() + size(); }
+    inline const_iterator constEnd() const { return constBegin() + size(); }
+
+    iterator erase(iterator it);
+
+    iterator find(const Key &key);
+    const_iterator find(const Key &key) const;
+    const_iterator constFind(const Key &key) const;
+    iterator lowerBound(const Key &key);
+    const_iterator lowerBound(const Key &key) const;
+    iterator upperBound(const Key &key);
+    const_iterator upperBound(const Key &key) const;
+    iterator insert(const Key &key, const T &value);
+
+    // STL compatibility
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef qptrdiff difference_type;
+    typedef int size_type;
+
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    void makeSorted();
+    inline int lowerBoundIndex(const Key &key) const
+    { return int(std::lower_bound(k.constBegin(), k.constEnd(), key) - k.constBegin()); }
+    inline int upperBoundIndex(const Key &key) const
+    { return int(std::upper_bound(k.constBegin(), k.constEnd(), key) - k.constBegin()); }
+    inline int indexOf(const Key &key) const
+    {
+        const int i = lowerBoundIndex(key);
+        return (i < k.size() && !(key < k.at(i))) ? i : -1;
+    }
+    inline iterator iteratorAt(int i) { return begin() + i; }
+    inline const_iterator constIteratorAt(int i) const { return constBegin() + i; }
+};
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QFlatMap<Key, T>::QFlatMap(const QVector<Key> &keys, const QVector<T> &values)
+    : k(keys), v(values)
+{
+    Q_ASSERT_X(keys.size() == values.size(), "QFlatMap", "keys and values must have the same size");
+    makeSorted();
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QFlatMap<Key, T>::QFlatMap(const QMap<Key, T> &map)
+{
+    // a QMap is already sorted and has unique keys
+    k.reserve(map.size());
+    v.reserve(map.size());
+    for (typename QMap<Key, T>::const_iterator it = map.constBegin(); it != map.constEnd(); ++it) {
+        k.append(it.key());
+        v.append(it.value());
+    }
+}
+
+// Sorts the keys and values, which were appended in arbitrary order. As with
+// repeated calls to insert(), the last value for a duplicated key wins.
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatMap<Key, T>::makeSorted()
+{
+    const int n = k.size();
+
+    bool sorted = true;
+    for (int i = 1; i < n && sorted; ++i)
+        sorted = k.at(i - 1) < k.at(i);
+    if (sorted)
+        return;
+
+    QVector<int> order(n);
+    for (int i = 0; i < n; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), QtPrivate::QFlatMapIndexLessThan<Key>(k.constData()));
+
+    QVector<Key> sortedKeys;
+    QVector<T> sortedValues;
+    sortedKeys.reserve(n);
+    sortedValues.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const int idx = order.at(i);
+        if (i + 1 < n && !(k.at(idx) < k.at(order.at(i + 1))))
+            continue; // a later duplicate replaces this one
+        sortedKeys.append(k.at(idx));
+        sortedValues.append(v.at(idx));
+    }
+    k.swap(sortedKeys);
+    v.swap(sortedValues);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QMap<Key, T> QFlatMap<Key, T>::toMap() const
+{
+    QMap<Key, T> map;
+    // inserting at the end is amortized constant time
+    for (int i = 0; i < k.size(); ++i)
+        map.insert(map.constEnd(), k.at(i), v.at(i));
+    return map;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatMap<Key, T>::remove(const Key &akey)
+{
+    const int i = indexOf(akey);
+    if (i < 0)
+        return 0;
+    k.remove(i);
+    v.remove(i);
+    return 1;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE T QFlatMap<Key, T>::take(const Key &akey)
+{
+    const int i = indexOf(akey);
+    if (i < 0)
+        return T();
+    T t = v.at(i);
+    k.remove(i);
+    v.remove(i);
+    return t;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatMap<Key, T>::key(const T &avalue, const Key &defaultKey) const
+{
+    const int i = v.indexOf(avalue);
+    return i < 0 ? defaultKey : k.at(i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatMap<Key, T>::value(const Key &akey, const T &defaultValue) const
+{
+    const int i = indexOf(akey);
+    return i < 0 ? defaultValue : v.at(i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T &QFlatMap<Key, T>::operator[](const Key &akey)
+{
+    const int i = lowerBoundIndex(akey);
+    if (i == k.size() || akey < k.at(i)) {
+        k.insert(i, akey);
+        v.insert(i, T());
+    }
+    return v[i];
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatMap<Key, T>::operator[](const Key &akey) const
+{
+    return value(akey);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::erase(iterator it)
+{
+    // the iterator may point into data shared with a copy; only its
+    // position is meaningful
+    const int i = int(it.k - k.constData());
+    k.remove(i);
+    v.remove(i);
+    return iteratorAt(i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::find(const Key &akey)
+{
+    const int i = indexOf(akey);
+    return i < 0 ? end() : iteratorAt(i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T>::const_iterator QFlatMap<Key, T>::find(const Key &akey) const
+{
+    return constFind(akey);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T>::const_iterator QFlatMap<Key, T>::constFind(const Key &akey) const
+{
+    const int i = indexOf(akey);
+    return i < 0 ? constEnd() : constIteratorAt(i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::lowerBound(const Key &akey)
+{
+    return iteratorAt(lowerBoundIndex(akey));
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T>::const_iterator QFlatMap<Key, T>::lowerBound(const Key &akey) const
+{
+    return constIteratorAt(lowerBoundIndex(akey));
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::upperBound(const Key &akey)
+{
+    return iteratorAt(upperBoundIndex(akey));
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T>::const_iterator QFlatMap<Key, T>::upperBound(const Key &akey) const
+{
+    return constIteratorAt(upperBoundIndex(akey));
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::insert(const Key &akey, const T &avalue)
+{
+    // appending in ascending key order is the common case; don't search
+    int i = k.size();
+    if (!k.isEmpty() && !(k.last() < akey))
+        i = lowerBoundIndex(akey);
+
+    if (i < k.size() && !(akey < k.at(i))) {
+        v[i] = avalue;
+    } else {
+        k.insert(i, akey);
+        v.insert(i, avalue);
+    }
+    return iteratorAt(i);
+}
+
+Q_DECLARE_ASSOCIATIVE_ITERATOR(FlatMap)
+
+QT_END_NAMESPACE
+
+#endif // QFLATMAP_H
@@ -58,6 +58,8 @@
 #include <qstring.h>
 #include <qglobal.h>
 #include <qbytearray.h>
+#include <qsmallbytearray.h>
+#include <qsmallstring.h>
 #include <qdatetime.h>
 #include <qbasicatomic.h>
 
@@ -128,6 +130,26 @@ uint qHash(const QStringRef &key, uint seed) Q_DECL_NOTHROW
     return hash(key.unicode(), key.size(), seed);
 }
 
+uint qHash(QStringView key, uint seed) Q_DECL_NOTHROW
+{
+    return hash(key.unicode(), key.size(), seed);
+}
+
+uint qHash(QByteArrayView key, uint seed) Q_DECL_NOTHROW
+{
+    return hash(reinterpret_cast<const uchar *>(key.constData()), key.size(), seed);
+}
+
+uint qHash(const QSmallString &key, uint seed) Q_DECL_NOTHROW
+{
+    return hash(key.unicode(), key.size(), seed);
+}
+
+uint qHash(const QSmallByteArray &key, uint seed) Q_DECL_NOTHROW
+{
+    return hash(reinterpret_cast<const uchar *>(key.constData()), key.size(), seed);
+}
+
 uint qHash(const QBitArray &bitArray, uint seed) Q_DECL_NOTHROW
 {
     int m = bitArray.d.size() - 1;
@@ -231,6 +253,18 @@ static void qt_initialize_qhash_seed()
     }
 }
 
+/*!
+    \internal
+
+    Returns the seed shared by all hashes, initializing it first if
+    needed. Used by QFlatHash.
+*/
+uint qt_qhash_global_seed()
+{
+    qt_initialize_qhash_seed();
+    return uint(qt_qhash_seed.load());
+}
+
 /*!
     \internal
 
@@ -709,6 +743,22 @@ void QHashData::checkSanity()
     Returns the hash value for the \a key, using \a seed to seed the calculation.
 */
 
+/*! \fn uint qHash(QStringView key, uint seed = 0)
+    \relates QHash
+    \since 5.3
+
+    Returns the hash value for the \a key, using \a seed to seed the calculation.
+    The result is the same as for a QString holding the same characters.
+*/
+
+/*! \fn uint qHash(QByteArrayView key, uint seed = 0)
+    \relates QHash
+    \since 5.3
+
+    Returns the hash value for the \a key, using \a seed to seed the calculation.
+    The result is the same as for a QByteArray holding the same bytes.
+*/
+
 /*! \fn uint qHash(QLatin1String key, uint seed = 0)
     \relates QHash
     \since 5.0
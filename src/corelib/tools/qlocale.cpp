@@ -1540,6 +1540,223 @@ double QLocale::toDouble(const QStringRef &s, bool *ok) const
     return d->stringToDouble(s, ok, mode);
 }
 
+/*!
+    Returns the short int represented by the localized string \a s.
+
+    If the conversion fails the function returns 0.
+
+    If \a ok is not null, failure is reported by setting *ok to false, and
+    success by setting *ok to true.
+
+    This function ignores leading and trailing whitespace.
+
+    \sa toUShort(), toString()
+
+    \since 5.3
+*/
+
+short QLocale::toShort(QStringView s, bool *ok) const
+{
+    qlonglong i = toLongLong(s, ok);
+    if (i < SHRT_MIN || i > SHRT_MAX) {
+        if (ok)
+            *ok = false;
+        return 0;
+    }
+    return short(i);
+}
+
+/*!
+    Returns the unsigned short int represented by the localized string \a s.
+
+    If the conversion fails the function returns 0.
+
+    If \a ok is not null, failure is reported by setting *ok to false, and
+    success by setting *ok to true.
+
+    This function ignores leading and trailing whitespace.
+
+    \sa toShort(), toString()
+
+    \since 5.3
+*/
+
+ushort QLocale::toUShort(QStringView s, bool *ok) const
+{
+    qulonglong i = toULongLong(s, ok);
+    if (i > USHRT_MAX) {
+        if (ok)
+            *ok = false;
+        return 0;
+    }
+    return ushort(i);
+}
+
+/*!
+    Returns the int represented by the localized string \a s.
+
+    If the conversion fails the function returns 0.
+
+    If \a ok is not null, failure is reported by setting *ok to false, and
+    success by setting *ok to true.
+
+    This function ignores leading and trailing whitespace.
+
+    \sa toUInt(), toString()
+
+    \since 5.3
+*/
+
+int QLocale::toInt(QStringView s, bool *ok) const
+{
+    qlonglong i = toLongLong(s, ok);
+    if (i < INT_MIN || i > INT_MAX) {
+        if (ok)
+            *ok = false;
+        return 0;
+    }
+    return int(i);
+}
+
+/*!
+    Returns the unsigned int represented by the localized string \a s.
+
+    If the conversion fails the function returns 0.
+
+    If \a ok is not null, failure is reported by setting *ok to false, and
+    success by setting *ok to true.
+
+    This function ignores leading and trailing whitespace.
+
+    \sa toInt(), toString()
+
+    \since 5.3
+*/
+
+uint QLocale::toUInt(QStringView s, bool *ok) const
+{
+    qulonglong i = toULongLong(s, ok);
+    if (i > UINT_MAX) {
+        if (ok)
+            *ok = false;
+        return 0;
+    }
+    return uint(i);
+}
+
+/*!
+    Returns the long long int represented by the localized string \a s.
+
+    If the conversion fails the function returns 0.
+
+    If \a ok is not null, failure is reported by setting *ok to false, and
+    success by setting *ok to true.
+
+    This function ignores leading and trailing whitespace.
+
+    \sa toInt(), toULongLong(), toDouble(), toString()
+
+    \since 5.3
+*/
+
+
+qlonglong QLocale::toLongLong(QStringView s, bool *ok) const
+{
+    QLocalePrivate::GroupSeparatorMode mode
+        = d->m_numberOptions & RejectGroupSeparator
+            ? QLocalePrivate::FailOnGroupSeparators
+            : QLocalePrivate::ParseGroupSeparators;
+
+    return d->stringToLongLong(s, 10, ok, mode);
+}
+
+/*!
+    Returns the unsigned long long int represented by the localized
+    string \a s.
+
+    If the conversion fails the function returns 0.
+
+    If \a ok is not null, failure is reported by setting *ok to false, and
+    success by setting *ok to true.
+
+    This function ignores leading and trailing whitespace.
+
+    \sa toLongLong(), toInt(), toDouble(), toString()
+
+    \since 5.3
+*/
+
+qulonglong QLocale::toULongLong(QStringView s, bool *ok) const
+{
+    QLocalePrivate::GroupSeparatorMode mode
+        = d->m_numberOptions & RejectGroupSeparator
+            ? QLocalePrivate::FailOnGroupSeparators
+            : QLocalePrivate::ParseGroupSeparators;
+
+    return d->stringToUnsLongLong(s, 10, ok, mode);
+}
+
+/*!
+    Returns the float represented by the localized string \a s, or 0.0
+    if the conversion failed.
+
+    If \a ok is not null, reports failure by setting
+    *ok to false and success by setting *ok to true.
+
+    This function ignores leading and trailing whitespace.
+
+    \sa toDouble(), toInt(), toString()
+
+    \since 5.3
+*/
+
+float QLocale::toFloat(QStringView s, bool *ok) const
+{
+    bool myOk;
+    double d = toDouble(s, &myOk);
+    if (!myOk || d > QT_MAX_FLOAT || d < -QT_MAX_FLOAT) {
+        if (ok)
+            *ok = false;
+        return 0.0;
+    }
+    if (ok)
+        *ok = true;
+    return float(d);
+}
+
+/*!
+    Returns the double represented by the localized string \a s, or
+    0.0 if the conversion failed.
+
+    If \a ok is not null, reports failure by setting
+    *ok to false and success by setting *ok to true.
+
+    Unlike QString::toDouble(), this function does not fall back to
+    the "C" locale if the string cannot be interpreted in this
+    locale.
+
+    \snippet code/src_corelib_tools_qlocale.cpp 3
+
+    Notice that the last conversion returns 1234.0, because '.' is the
+    thousands group separator in the German locale.
+
+    This function ignores leading and trailing whitespace.
+
+    \sa toFloat(), toInt(), toString()
+
+    \since 5.3
+*/
+
+double QLocale::toDouble(QStringView s, bool *ok) const
+{
+    QLocalePrivate::GroupSeparatorMode mode
+        = d->m_numberOptions & RejectGroupSeparator
+            ? QLocalePrivate::FailOnGroupSeparators
+            : QLocalePrivate::ParseGroupSeparators;
+
+    return d->stringToDouble(s, ok, mode);
+}
+
 
 /*!
     Returns a localized string representation of \a i.
@@ -2775,6 +2992,7 @@ QString QLocalePrivate::doubleToString(const QChar _zero, const QChar plus, cons
                                        int width,
                                        unsigned flags)
 {
+    const bool shortest = precision == QLocale::FloatingPointShortest;
     if (precision == -1)
         precision = 6;
     if (width == -1)
@@ -2799,58 +3017,70 @@ QString QLocalePrivate::doubleToString(const QChar _zero, const QChar plus, cons
         int decpt, sign;
         QString digits;
 
-#ifdef QT_QLOCALE_USES_FCVT
-        // NOT thread safe!
-        if (form == DFDecimal) {
-            digits = QLatin1String(fcvt(d, precision, &decpt, &sign));
+        if (shortest) {
+            char buff[QDtoaShortestMaxDigits + 1];
+            const int length = qdtoaShortest(d, buff, &decpt, &sign);
+            digits = QString::fromLatin1(buff, length);
+            if (form == DFExponent)
+                precision = length - 1;
+            else if (form == DFDecimal)
+                precision = qMax(length - decpt, 0);
+            else
+                precision = length;
         } else {
+#ifdef QT_QLOCALE_USES_FCVT
+            // NOT thread safe!
+            if (form == DFDecimal) {
+                digits = QLatin1String(fcvt(d, precision, &decpt, &sign));
+            } else {
+                int pr = precision;
+                if (form == DFExponent)
+                    ++pr;
+                else if (form == DFSignificantDigits && pr == 0)
+                    pr = 1;
+                digits = QLatin1String(ecvt(d, pr, &decpt, &sign));
+
+                // Chop trailing zeros
+                if (digits.length() > 0) {
+                    int last_nonzero_idx = digits.length() - 1;
+                    while (last_nonzero_idx > 0
+                           && digits.unicode()[last_nonzero_idx] == QLatin1Char('0'))
+                        --last_nonzero_idx;
+                    digits.truncate(last_nonzero_idx + 1);
+                }
+
+            }
+
+#else
+            int mode;
+            if (form == DFDecimal)
+                mode = 3;
+            else
+                mode = 2;
+
+            /* This next bit is a bit quirky. In DFExponent form, the precision
+               is the number of digits after decpt. So that would suggest using
+               mode=3 for qdtoa. But qdtoa behaves strangely when mode=3 and
+               precision=0. So we get around this by using mode=2 and reasoning
+               that we want precision+1 significant digits, since the decimal
+               point in this mode is always after the first digit. */
             int pr = precision;
             if (form == DFExponent)
                 ++pr;
-            else if (form == DFSignificantDigits && pr == 0)
-                pr = 1;
-            digits = QLatin1String(ecvt(d, pr, &decpt, &sign));
-
-            // Chop trailing zeros
-            if (digits.length() > 0) {
-                int last_nonzero_idx = digits.length() - 1;
-                while (last_nonzero_idx > 0
-                       && digits.unicode()[last_nonzero_idx] == QLatin1Char('0'))
-                    --last_nonzero_idx;
-                digits.truncate(last_nonzero_idx + 1);
-            }
-
-        }
 
-#else
-        int mode;
-        if (form == DFDecimal)
-            mode = 3;
-        else
-            mode = 2;
-
-        /* This next bit is a bit quirky. In DFExponent form, the precision
-           is the number of digits after decpt. So that would suggest using
-           mode=3 for qdtoa. But qdtoa behaves strangely when mode=3 and
-           precision=0. So we get around this by using mode=2 and reasoning
-           that we want precision+1 significant digits, since the decimal
-           point in this mode is always after the first digit. */
-        int pr = precision;
-        if (form == DFExponent)
-            ++pr;
-
-        char *rve = 0;
-        char *buff = 0;
-        QT_TRY {
-            digits = QLatin1String(qdtoa(d, mode, pr, &decpt, &sign, &rve, &buff));
-        } QT_CATCH(...) {
+            char *rve = 0;
+            char *buff = 0;
+            QT_TRY {
+                digits = QLatin1String(qdtoa(d, mode, pr, &decpt, &sign, &rve, &buff));
+            } QT_CATCH(...) {
+                if (buff != 0)
+                    free(buff);
+                QT_RETHROW;
+            }
             if (buff != 0)
                 free(buff);
-            QT_RETHROW;
-        }
-        if (buff != 0)
-            free(buff);
 #endif // QT_QLOCALE_USES_FCVT
+        }
 
         if (_zero.unicode() != '0') {
             ushort z = _zero.unicode() - '0';
@@ -2876,7 +3106,9 @@ QString QLocalePrivate::doubleToString(const QChar _zero, const QChar plus, cons
                 PrecisionMode mode = (flags & Alternate) ?
                             PMSignificantDigits : PMChopTrailingZeros;
 
-                if (decpt != digits.length() && (decpt <= -4 || decpt > precision))
+                // the shortest form only switches to an exponent where %.17g would
+                const int cutoff = shortest ? qMax(precision, int(QDtoaShortestMaxDigits)) : precision;
+                if (decpt != digits.length() && (decpt <= -4 || decpt > cutoff))
                     num_str = exponentForm(_zero, decimal, exponential, group, plus, minus,
                                            digits, decpt, precision, mode,
                                            always_show_decpt);
@@ -3246,76 +3478,13 @@ bool QLocalePrivate::validateChars(const QString &str, NumberMode numMode, QByte
     return true;
 }
 
-double QLocalePrivate::stringToDouble(const QString &number, bool *ok,
-                                        GroupSeparatorMode group_sep_mode) const
-{
-    CharBuff buff;
-    // Do not use the ternary operator - triggers msvc2012 bug in optimized builds
-    QString trimmedNumber;
-    if (group().unicode() == 0xa0)
-        trimmedNumber = number.trimmed();
-    else
-        trimmedNumber = number;
-    if (!numberToCLocale(trimmedNumber.unicode(), trimmedNumber.size(),
-                         group_sep_mode, &buff)) {
-        if (ok != 0)
-            *ok = false;
-        return 0.0;
-    }
-    return bytearrayToDouble(buff.constData(), ok);
-}
-
-qlonglong QLocalePrivate::stringToLongLong(const QString &number, int base,
-                                           bool *ok, GroupSeparatorMode group_sep_mode) const
-{
-    CharBuff buff;
-    // Do not use the ternary operator - triggers msvc2012 bug in optimized builds
-    QString trimmedNumber;
-    if (group().unicode() == 0xa0)
-        trimmedNumber = number.trimmed();
-    else
-        trimmedNumber = number;
-    if (!numberToCLocale(trimmedNumber.unicode(), trimmedNumber.size(),
-                         group_sep_mode, &buff)) {
-        if (ok != 0)
-            *ok = false;
-        return 0;
-    }
-
-    return bytearrayToLongLong(buff.constData(), base, ok);
-}
-
-qulonglong QLocalePrivate::stringToUnsLongLong(const QString &number, int base,
-                                               bool *ok, GroupSeparatorMode group_sep_mode) const
-{
-    CharBuff buff;
-    // Do not use the ternary operator - triggers msvc2012 bug in optimized builds
-    QString trimmedNumber;
-    if (group().unicode() == 0xa0)
-        trimmedNumber = number.trimmed();
-    else
-        trimmedNumber = number;
-    if (!numberToCLocale(trimmedNumber.unicode(), trimmedNumber.size(),
-                         group_sep_mode, &buff)) {
-        if (ok != 0)
-            *ok = false;
-        return 0;
-    }
-
-    return bytearrayToUnsLongLong(buff.constData(), base, ok);
-}
-
-double QLocalePrivate::stringToDouble(const QStringRef &number, bool *ok,
+double QLocalePrivate::stringToDouble(QStringView number, bool *ok,
                                         GroupSeparatorMode group_sep_mode) const
 {
     CharBuff buff;
-    QStringRef trimmedNumber;
-    // Do not use the ternary operator - triggers msvc2012 bug in optimized builds
     if (group().unicode() == 0xa0)
-        trimmedNumber = number.trimmed();
-    else
-        trimmedNumber = number;
-    if (!numberToCLocale(trimmedNumber.unicode(), trimmedNumber.size(),
+        number = number.trimmed();
+    if (!numberToCLocale(number.unicode(), number.size(),
                          group_sep_mode, &buff)) {
         if (ok != 0)
             *ok = false;
@@ -3324,17 +3493,13 @@ double QLocalePrivate::stringToDouble(const QStringRef &number, bool *ok,
     return bytearrayToDouble(buff.constData(), ok);
 }
 
-qlonglong QLocalePrivate::stringToLongLong(const QStringRef &number, int base,
+qlonglong QLocalePrivate::stringToLongLong(QStringView number, int base,
                                            bool *ok, GroupSeparatorMode group_sep_mode) const
 {
     CharBuff buff;
-    QStringRef trimmedNumber;
-    // Do not use the ternary operator - triggers msvc2012 bug in optimized builds
     if (group().unicode() == 0xa0)
-        trimmedNumber = number.trimmed();
-    else
-        trimmedNumber = number;
-    if (!numberToCLocale(trimmedNumber.unicode(), trimmedNumber.size(),
+        number = number.trimmed();
+    if (!numberToCLocale(number.unicode(), number.size(),
                          group_sep_mode, &buff)) {
         if (ok != 0)
             *ok = false;
@@ -3344,17 +3509,13 @@ qlonglong QLocalePrivate::stringToLongLong(const QStringRef &number, int base,
     return bytearrayToLongLong(buff.constData(), base, ok);
 }
 
-qulonglong QLocalePrivate::stringToUnsLongLong(const QStringRef &number, int base,
+qulonglong QLocalePrivate::stringToUnsLongLong(QStringView number, int base,
                                                bool *ok, GroupSeparatorMode group_sep_mode) const
 {
     CharBuff buff;
-    QStringRef trimmedNumber;
-    // Do not use the ternary operator - triggers msvc2012 bug in optimized builds
     if (group().unicode() == 0xa0)
-        trimmedNumber = number.trimmed();
-    else
-        trimmedNumber = number;
-    if (!numberToCLocale(trimmedNumber.unicode(), trimmedNumber.size(),
+        number = number.trimmed();
+    if (!numberToCLocale(number.unicode(), number.size(),
                          group_sep_mode, &buff)) {
         if (ok != 0)
             *ok = false;
@@ -3386,9 +3547,13 @@ double QLocalePrivate::bytearrayToDouble(const char *num, bool *ok, bool *overfl
     if (qstrcmp(num, "-inf") == 0)
         return -qt_inf();
 
+    double d;
+    if (qstrtodFast(num, int(qstrlen(num)), &d))
+        return d;
+
     bool _ok;
     const char *endptr;
-    double d = qstrtod(num, &endptr, &_ok);
+    d = qstrtod(num, &endptr, &_ok);
 
     if (!_ok) {
         // the only way strtod can fail with *endptr != '\0' on a non-empty
@@ -68,6 +68,7 @@ class Q_CORE_EXPORT QLocale
     Q_ENUMS(MeasurementSystem)
     friend class QString;
     friend class QStringRef;
+    friend class QStringView;
     friend class QByteArray;
     friend class QIntValidator;
     friend class QDoubleValidatorPrivate;
@@ -800,6 +801,10 @@ public:
     };
     Q_DECLARE_FLAGS(NumberOptions, NumberOption)
 
+    enum FloatingPointPrecisionOption {
+        FloatingPointShortest = -128
+    };
+
     enum CurrencySymbolFormat {
         CurrencyIsoCode,
         CurrencySymbol,
@@ -842,6 +847,15 @@ public:
     float toFloat(const QStringRef &s, bool *ok = 0) const;
     double toDouble(const QStringRef &s, bool *ok = 0) const;
 
+    short toShort(QStringView s, bool *ok = 0) const;
+    ushort toUShort(QStringView s, bool *ok = 0) const;
+    int toInt(QStringView s, bool *ok = 0) const;
+    uint toUInt(QStringView s, bool *ok = 0) const;
+    qlonglong toLongLong(QStringView s, bool *ok = 0) const;
+    qulonglong toULongLong(QStringView s, bool *ok = 0) const;
+    float toFloat(QStringView s, bool *ok = 0) const;
+    double toDouble(QStringView s, bool *ok = 0) const;
+
     QString toString(qlonglong i) const;
     QString toString(qulonglong i) const;
     inline QString toString(short i) const;
@@ -48,6 +48,7 @@
 #include <limits.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #ifdef Q_OS_WINCE
@@ -472,6 +473,434 @@ qlonglong qstrtoll(const char *nptr, const char **endptr, int base, bool *ok)
     return acc;
 }
 
+/*
+    Shortest round-trip conversion of doubles, using Florian Loitsch's
+    Grisu3 algorithm ("Printing Floating-Point Numbers Quickly and
+    Accurately with Integers", PLDI 2010). Grisu3 works on 64-bit
+    integers only and finds the shortest digit string that reads back as
+    the same double for about 99.5% of all inputs. It recognizes the
+    remaining cases, for which qdtoaShortest() falls back to qdtoa(), or
+    to ecvt() where Qt uses the C library for number formatting.
+*/
+
+namespace {
+struct DiyFp
+{
+    quint64 f;
+    int e;
+};
+
+struct CachedPower
+{
+    quint64 significand;
+    short binaryExponent;
+    short decimalExponent;
+};
+}
+
+// 10^k for k = -348, -340, ..., 340, normalized to a 64-bit significand
+static const CachedPower cachedPowers[] = {
+    { Q_UINT64_C(0xfa8fd5a0081c0288), -1220, -348 },
+    { Q_UINT64_C(0xbaaee17fa23ebf76), -1193, -340 },
+    { Q_UINT64_C(0x8b16fb203055ac76), -1166, -332 },
+    { Q_UINT64_C(0xcf42894a5dce35ea), -1140, -324 },
+    { Q_UINT64_C(0x9a6bb0aa55653b2d), -1113, -316 },
+    { Q_UINT64_C(0xe61acf033d1a45df), -1087, -308 },
+    { Q_UINT64_C(0xab70fe17c79ac6ca), -1060, -300 },
+    { Q_UINT64_C(0xff77b1fcbebcdc4f), -1034, -292 },
+    { Q_UINT64_C(0xbe5691ef416bd60c), -1007, -284 },
+    { Q_UINT64_C(0x8dd01fad907ffc3c),  -980, -276 },
+    { Q_UINT64_C(0xd3515c2831559a83),  -954, -268 },
+    { Q_UINT64_C(0x9d71ac8fada6c9b5),  -927, -260 },
+    { Q_UINT64_C(0xea9c227723ee8bcb),  -901, -252 },
+    { Q_UINT64_C(0xaecc49914078536d),  -874, -244 },
+    { Q_UINT64_C(0x823c12795db6ce57),  -847, -236 },
+    { Q_UINT64_C(0xc21094364dfb5637),  -821, -228 },
+    { Q_UINT64_C(0x9096ea6f3848984f),  -794, -220 },
+    { Q_UINT64_C(0xd77485cb25823ac7),  -768, -212 },
+    { Q_UINT64_C(0xa086cfcd97bf97f4),  -741, -204 },
+    { Q_UINT64_C(0xef340a98172aace5),  -715, -196 },
+    { Q_UINT64_C(0xb23867fb2a35b28e),  -688, -188 },
+    { Q_UINT64_C(0x84c8d4dfd2c63f3b),  -661, -180 },
+    { Q_UINT64_C(0xc5dd44271ad3cdba),  -635, -172 },
+    { Q_UINT64_C(0x936b9fcebb25c996),  -608, -164 },
+    { Q_UINT64_C(0xdbac6c247d62a584),  -582, -156 },
+    { Q_UINT64_C(0xa3ab66580d5fdaf6),  -555, -148 },
+    { Q_UINT64_C(0xf3e2f893dec3f126),  -529, -140 },
+    { Q_UINT64_C(0xb5b5ada8aaff80b8),  -502, -132 },
+    { Q_UINT64_C(0x87625f056c7c4a8b),  -475, -124 },
+    { Q_UINT64_C(0xc9bcff6034c13053),  -449, -116 },
+    { Q_UINT64_C(0x964e858c91ba2655),  -422, -108 },
+    { Q_UINT64_C(0xdff9772470297ebd),  -396, -100 },
+    { Q_UINT64_C(0xa6dfbd9fb8e5b88f),  -369,  -92 },
+    { Q_UINT64_C(0xf8a95fcf88747d94),  -343,  -84 },
+    { Q_UINT64_C(0xb94470938fa89bcf),  -316,  -76 },
+    { Q_UINT64_C(0x8a08f0f8bf0f156b),  -289,  -68 },
+    { Q_UINT64_C(0xcdb02555653131b6),  -263,  -60 },
+    { Q_UINT64_C(0x993fe2c6d07b7fac),  -236,  -52 },
+    { Q_UINT64_C(0xe45c10c42a2b3b06),  -210,  -44 },
+    { Q_UINT64_C(0xaa242499697392d3),  -183,  -36 },
+    { Q_UINT64_C(0xfd87b5f28300ca0e),  -157,  -28 },
+    { Q_UINT64_C(0xbce5086492111aeb),  -130,  -20 },
+    { Q_UINT64_C(0x8cbccc096f5088cc),  -103,  -12 },
+    { Q_UINT64_C(0xd1b71758e219652c),   -77,   -4 },
+    { Q_UINT64_C(0x9c40000000000000),   -50,    4 },
+    { Q_UINT64_C(0xe8d4a51000000000),   -24,   12 },
+    { Q_UINT64_C(0xad78ebc5ac620000),     3,   20 },
+    { Q_UINT64_C(0x813f3978f8940984),    30,   28 },
+    { Q_UINT64_C(0xc097ce7bc90715b3),    56,   36 },
+    { Q_UINT64_C(0x8f7e32ce7bea5c70),    83,   44 },
+    { Q_UINT64_C(0xd5d238a4abe98068),   109,   52 },
+    { Q_UINT64_C(0x9f4f2726179a2245),   136,   60 },
+    { Q_UINT64_C(0xed63a231d4c4fb27),   162,   68 },
+    { Q_UINT64_C(0xb0de65388cc8ada8),   189,   76 },
+    { Q_UINT64_C(0x83c7088e1aab65db),   216,   84 },
+    { Q_UINT64_C(0xc45d1df942711d9a),   242,   92 },
+    { Q_UINT64_C(0x924d692ca61be758),   269,  100 },
+    { Q_UINT64_C(0xda01ee641a708dea),   295,  108 },
+    { Q_UINT64_C(0xa26da3999aef774a),   322,  116 },
+    { Q_UINT64_C(0xf209787bb47d6b85),   348,  124 },
+    { Q_UINT64_C(0xb454e4a179dd1877),   375,  132 },
+    { Q_UINT64_C(0x865b86925b9bc5c2),   402,  140 },
+    { Q_UINT64_C(0xc83553c5c8965d3d),   428,  148 },
+    { Q_UINT64_C(0x952ab45cfa97a0b3),   455,  156 },
+    { Q_UINT64_C(0xde469fbd99a05fe3),   481,  164 },
+    { Q_UINT64_C(0xa59bc234db398c25),   508,  172 },
+    { Q_UINT64_C(0xf6c69a72a3989f5c),   534,  180 },
+    { Q_UINT64_C(0xb7dcbf5354e9bece),   561,  188 },
+    { Q_UINT64_C(0x88fcf317f22241e2),   588,  196 },
+    { Q_UINT64_C(0xcc20ce9bd35c78a5),   614,  204 },
+    { Q_UINT64_C(0x98165af37b2153df),   641,  212 },
+    { Q_UINT64_C(0xe2a0b5dc971f303a),   667,  220 },
+    { Q_UINT64_C(0xa8d9d1535ce3b396),   694,  228 },
+    { Q_UINT64_C(0xfb9b7cd9a4a7443c),   720,  236 },
+    { Q_UINT64_C(0xbb764c4ca7a44410),   747,  244 },
+    { Q_UINT64_C(0x8bab8eefb6409c1a),   774,  252 },
+    { Q_UINT64_C(0xd01fef10a657842c),   800,  260 },
+    { Q_UINT64_C(0x9b10a4e5e9913129),   827,  268 },
+    { Q_UINT64_C(0xe7109bfba19c0c9d),   853,  276 },
+    { Q_UINT64_C(0xac2820d9623bf429),   880,  284 },
+    { Q_UINT64_C(0x80444b5e7aa7cf85),   907,  292 },
+    { Q_UINT64_C(0xbf21e44003acdd2d),   933,  300 },
+    { Q_UINT64_C(0x8e679c2f5e44ff8f),   960,  308 },
+    { Q_UINT64_C(0xd433179d9c8cb841),   986,  316 },
+    { Q_UINT64_C(0x9e19db92b4e31ba9),  1013,  324 },
+    { Q_UINT64_C(0xeb96bf6ebadf77d9),  1039,  332 },
+    { Q_UINT64_C(0xaf87023b9bf0ee6b),  1066,  340 }
+};
+
+enum {
+    CachedPowersOffset = 348,           // -cachedPowers[0].decimalExponent
+    CachedPowersDecimalDistance = 8,
+    MinimalTargetExponent = -60,        // alpha and gamma from the paper
+    MaximalTargetExponent = -32
+};
+
+static inline DiyFp diyFpNormalize(DiyFp x)
+{
+    while (!(x.f & Q_UINT64_C(0xffc0000000000000))) {
+        x.f <<= 10;
+        x.e -= 10;
+    }
+    while (!(x.f & Q_UINT64_C(0x8000000000000000))) {
+        x.f <<= 1;
+        --x.e;
+    }
+    return x;
+}
+
+// Upper 64 bits of the 128-bit product, rounded
+static inline DiyFp diyFpMultiply(DiyFp x, DiyFp y)
+{
+    const quint64 m32 = Q_UINT64_C(0xffffffff);
+    const quint64 a = x.f >> 32, b = x.f & m32;
+    const quint64 c = y.f >> 32, d = y.f & m32;
+    const quint64 ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    const quint64 tmp = (bd >> 32) + (ad & m32) + (bc & m32) + (Q_UINT64_C(1) << 31);
+    DiyFp r;
+    r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+// Moves the last digit of buffer towards w, and checks whether the result is
+// guaranteed to be the closest shortest representation. See section 5 of
+// the paper for the meaning of the parameters.
+static bool grisuRoundWeed(char *buffer, int length, quint64 distanceTooHighW,
+                           quint64 unsafeInterval, quint64 rest, quint64 tenKappa,
+                           quint64 unit)
+{
+    const quint64 smallDistance = distanceTooHighW - unit;
+    const quint64 bigDistance = distanceTooHighW + unit;
+
+    while (rest < smallDistance
+           && unsafeInterval - rest >= tenKappa
+           && (rest + tenKappa < smallDistance
+               || smallDistance - rest >= rest + tenKappa - smallDistance)) {
+        --buffer[length - 1];
+        rest += tenKappa;
+    }
+
+    // if the digit could also have been weeded with respect to the other
+    // end of the uncertainty interval, we cannot tell which one is right
+    if (rest < bigDistance
+            && unsafeInterval - rest >= tenKappa
+            && (rest + tenKappa < bigDistance
+                || bigDistance - rest > rest + tenKappa - bigDistance))
+        return false;
+
+    return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+static bool grisuDigitGen(DiyFp low, DiyFp w, DiyFp high,
+                          char *buffer, int *length, int *kappa)
+{
+    quint64 unit = 1;
+    const DiyFp tooLow = { low.f - unit, low.e };
+    const DiyFp tooHigh = { high.f + unit, high.e };
+    quint64 unsafeInterval = tooHigh.f - tooLow.f;
+
+    const int shift = -w.e;
+    const quint64 one = Q_UINT64_C(1) << shift;
+    quint32 integrals = quint32(tooHigh.f >> shift);
+    quint64 fractionals = tooHigh.f & (one - 1);
+
+    quint32 divisor = 1;
+    *kappa = 1;
+    while (integrals / 10 >= divisor) {
+        divisor *= 10;
+        ++*kappa;
+    }
+
+    *length = 0;
+    while (*kappa > 0) {
+        buffer[(*length)++] = char('0' + integrals / divisor);
+        integrals %= divisor;
+        --*kappa;
+        const quint64 rest = (quint64(integrals) << shift) + fractionals;
+        if (rest < unsafeInterval)
+            return grisuRoundWeed(buffer, *length, tooHigh.f - w.f, unsafeInterval,
+                                  rest, quint64(divisor) << shift, unit);
+        divisor /= 10;
+    }
+
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafeInterval *= 10;
+        buffer[(*length)++] = char('0' + (fractionals >> shift));
+        fractionals &= one - 1;
+        --*kappa;
+        if (fractionals < unsafeInterval)
+            return grisuRoundWeed(buffer, *length, (tooHigh.f - w.f) * unit,
+                                  unsafeInterval, fractionals, one, unit);
+    }
+}
+
+// v must be finite and positive
+static bool grisu3(double v, char *buffer, int *length, int *decimalExponent)
+{
+    quint64 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    const quint64 fraction = bits & Q_UINT64_C(0x000fffffffffffff);
+    const int biasedExponent = int(bits >> 52) & 0x7ff;
+
+    DiyFp w;
+    if (biasedExponent) {
+        w.f = fraction | Q_UINT64_C(0x0010000000000000);
+        w.e = biasedExponent - 1075;
+    } else {
+        w.f = fraction;
+        w.e = -1074;
+    }
+
+    // the boundaries are halfway to the neighbouring doubles; the lower one
+    // is closer if v is a power of two
+    DiyFp plus = { (w.f << 1) + 1, w.e - 1 };
+    plus = diyFpNormalize(plus);
+    DiyFp minus;
+    if (fraction == 0 && biasedExponent > 1) {
+        minus.f = (w.f << 2) - 1;
+        minus.e = w.e - 2;
+    } else {
+        minus.f = (w.f << 1) - 1;
+        minus.e = w.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    w = diyFpNormalize(w);
+
+    // pick 10^mk so that the scaled w has its binary exponent in
+    // [MinimalTargetExponent, MaximalTargetExponent]
+    const int minExponent = MinimalTargetExponent - (w.e + 64);
+    const int k = int(ceil((minExponent + 63) * 0.30102999566398114)); // 1/log2(10)
+    const CachedPower &power =
+            cachedPowers[(CachedPowersOffset + k - 1) / CachedPowersDecimalDistance + 1];
+    const DiyFp tenMk = { power.significand, power.binaryExponent };
+
+    int kappa;
+    const bool result = grisuDigitGen(diyFpMultiply(minus, tenMk), diyFpMultiply(w, tenMk),
+                                      diyFpMultiply(plus, tenMk), buffer, length, &kappa);
+    *decimalExponent = kappa - power.decimalExponent;
+    return result;
+}
+
+int qdtoaShortest(double d, char *digits, int *decpt, int *sign)
+{
+    quint64 bits;
+    memcpy(&bits, &d, sizeof(bits));
+    *sign = int(bits >> 63);
+    if (d == 0) {
+        digits[0] = '0';
+        *decpt = 1;
+        return 1;
+    }
+    if (d < 0)
+        d = -d;
+
+    int length, exponent;
+    if (grisu3(d, digits, &length, &exponent)) {
+        *decpt = length + exponent;
+        return length;
+    }
+
+    int dummySign;
+#ifdef QT_QLOCALE_USES_FCVT
+    // ecvt() has no shortest mode; 17 digits always read back. NOT thread safe!
+    const char *s = ecvt(d, QDtoaShortestMaxDigits, decpt, &dummySign);
+    length = qMin(int(qstrlen(s)), int(QDtoaShortestMaxDigits));
+    while (length > 1 && s[length - 1] == '0')
+        --length;
+    memcpy(digits, s, length);
+#else
+    char *rve = 0;
+    char *buff = 0;
+    QT_TRY {
+        const char *s = qdtoa(d, 0, 0, decpt, &dummySign, &rve, &buff);
+        length = qMin(int(qstrlen(s)), int(QDtoaShortestMaxDigits));
+        while (length > 1 && s[length - 1] == '0')
+            --length;
+        memcpy(digits, s, length);
+    } QT_CATCH(...) {
+        if (buff != 0)
+            free(buff);
+        QT_RETHROW;
+    }
+    if (buff != 0)
+        free(buff);
+#endif
+    return length;
+}
+
+/*
+    Clinger's fast path: a decimal with at most 15 to 16 significant digits
+    and a small exponent is the correctly rounded result of a single IEEE
+    multiplication or division by an exactly representable power of ten.
+    That only holds if the FPU does not compute in extended precision.
+*/
+#if defined(Q_PROCESSOR_X86_32) && !defined(__SSE2_MATH__) && !(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define QT_NO_FAST_STRTOD
+#endif
+
+bool qstrtodFast(const char *num, int len, double *result)
+{
+#ifdef QT_NO_FAST_STRTOD
+    Q_UNUSED(num);
+    Q_UNUSED(len);
+    Q_UNUSED(result);
+    return false;
+#else
+    static const double exactPowersOfTen[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const quint64 maxExactMantissa = Q_UINT64_C(1) << 53;
+
+    const char *s = num;
+    const char *end = num + len;
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+')) {
+        negative = *s == '-';
+        ++s;
+    }
+
+    quint64 mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool anyDigits = false;
+    for (; s < end && uint(*s - '0') < 10; ++s) {
+        anyDigits = true;
+        if (mantissa == 0 && *s == '0')
+            continue;
+        if (++significantDigits > 19)
+            return false;
+        mantissa = mantissa * 10 + (*s - '0');
+    }
+    if (s < end && *s == '.') {
+        for (++s; s < end && uint(*s - '0') < 10; ++s) {
+            anyDigits = true;
+            --exponent;
+            if (mantissa == 0 && *s == '0')
+                continue;
+            if (++significantDigits > 19)
+                return false;
+            mantissa = mantissa * 10 + (*s - '0');
+        }
+    }
+    if (!anyDigits)
+        return false;
+
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        ++s;
+        bool negativeExponent = false;
+        if (s < end && (*s == '-' || *s == '+')) {
+            negativeExponent = *s == '-';
+            ++s;
+        }
+        if (s == end)
+            return false;
+        int e = 0;
+        for (; s < end && uint(*s - '0') < 10; ++s) {
+            if (e >= 10000)
+                return false;
+            e = e * 10 + (*s - '0');
+        }
+        exponent += negativeExponent ? -e : e;
+    }
+    if (s != end)
+        return false;
+
+    if (mantissa == 0) {
+        *result = negative ? -0.0 : 0.0;
+        return true;
+    }
+    if (mantissa > maxExactMantissa)
+        return false;
+
+    double d = double(mantissa);
+    if (exponent < 0) {
+        if (exponent < -22)
+            return false;
+        d /= exactPowersOfTen[-exponent];
+    } else if (exponent > 0) {
+        if (exponent > 22) {
+            // 12e30 is 12000000000e22, as long as the mantissa stays exact
+            const int shift = exponent - 22;
+            if (shift > 15)
+                return false;
+            const quint64 scale = quint64(exactPowersOfTen[shift]);
+            if (mantissa > maxExactMantissa / scale)
+                return false;
+            d = double(mantissa * scale);
+            exponent = 22;
+        }
+        d *= exactPowersOfTen[exponent];
+    }
+    *result = negative ? -d : d;
+    return true;
+#endif // QT_NO_FAST_STRTOD
+}
+
 #ifndef QT_QLOCALE_USES_FCVT
 
 /*        From: NetBSD: strtod.c,v 1.26 1998/02/03 18:44:21 perry Exp */
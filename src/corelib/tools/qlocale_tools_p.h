@@ -110,6 +110,16 @@ bool removeGroupSeparators(QLocalePrivate::CharBuff *num);
 Q_CORE_EXPORT char *qdtoa(double d, int mode, int ndigits, int *decpt,
                           int *sign, char **rve, char **digits_str);
 Q_CORE_EXPORT double qstrtod(const char *s00, char const **se, bool *ok);
+
+enum { QDtoaShortestMaxDigits = 17 };
+// Writes the shortest digits that read back as d (which must be finite)
+// into a buffer of at least QDtoaShortestMaxDigits + 1 chars, and returns
+// the number of digits.
+int qdtoaShortest(double d, char *digits, int *decpt, int *sign);
+// Exact conversion of the common short decimals; returns false if the
+// input needs the full qstrtod() instead.
+bool qstrtodFast(const char *num, int len, double *result);
+
 qlonglong qstrtoll(const char *nptr, const char **endptr, int base, bool *ok);
 qulonglong qstrtoull(const char *nptr, const char **endptr, int base, bool *ok);
 
@@ -1641,6 +1641,35 @@ QRegularExpressionMatch QRegularExpression::match(const QString &subject,
     return QRegularExpressionMatch(*priv);
 }
 
+/*!
+    \since 5.3
+    \overload
+
+    Attempts to match the regular expression against the characters viewed
+    by \a subject, starting at the position \a offset inside the subject,
+    using a match of type \a matchType and honoring the given \a
+    matchOptions.
+
+    The characters are not copied: the viewed data must stay valid and
+    unmodified for as long as the returned QRegularExpressionMatch, and any
+    string obtained from it, is in use. Use
+    QRegularExpressionMatch::capturedRef() to inspect the captures without
+    allocating.
+
+    \sa QRegularExpressionMatch, {normal matching}
+*/
+QRegularExpressionMatch QRegularExpression::match(QStringView subject,
+                                                  int offset,
+                                                  MatchType matchType,
+                                                  MatchOptions matchOptions) const
+{
+    d.data()->compilePattern();
+
+    const QString rawSubject = QString::fromRawData(subject.unicode(), subject.size());
+    QRegularExpressionMatchPrivate *priv = d->doMatch(rawSubject, offset, matchType, matchOptions);
+    return QRegularExpressionMatch(*priv);
+}
+
 /*!
     Attempts to perform a global match of the regular expression against the
     given \a subject string, starting at the position \a offset inside the
@@ -43,6 +43,7 @@
 #include "qsimd_p.h"
 #include <QByteArray>
 #include <stdio.h>
+#include <string.h>
 
 #if defined(Q_OS_WIN)
 #  if defined(Q_OS_WINCE)
@@ -304,6 +305,8 @@ static inline uint detectProcessorFeatures()
         features |= HLE; // Hardware Lock Ellision
     if (cpuid0700EBX & (1u << 11))
         features |= RTM; // Restricted Transactional Memory
+    if (cpuid0700EBX & (1u << 29))
+        features |= SHA; // SHA-1 and SHA-256 extensions
 
     return features;
 }
@@ -330,6 +333,7 @@ static inline uint detectProcessorFeatures()
  avx2
  hle
  rtm
+ sha
   */
 
 // begin generated
@@ -345,11 +349,12 @@ static const char features_string[] =
     " avx2\0"
     " hle\0"
     " rtm\0"
+    " sha\0"
     "\0";
 
 static const int features_indices[] = {
     0,    8,   14,   20,   26,   33,   41,   49,
-   54,   60,   65,   -1
+   54,   60,   65,   70,   -1
 };
 // end generated
 
@@ -406,7 +411,9 @@ void qDetectCpuFeatures()
     if (!disable.isEmpty()) {
         disable.prepend(' ');
         for (int i = 0; i < features_count; ++i) {
-            if (disable.contains(features_string + features_indices[i]))
+            // not QByteArray::contains(), whose search dispatches on the
+            // very features being detected here
+            if (strstr(disable.constData(), features_string + features_indices[i]))
                 f &= ~(1 << i);
         }
     }
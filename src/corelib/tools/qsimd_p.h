@@ -69,6 +69,7 @@
  *  SSE4_2 | x86  | I & C | I & C    | I only |
  *  AVX    | x86  | I & C | I & C    | I & C  |
  *  AVX2   | x86  | I & C | I & C    | I only |
+ *  SHA    | x86  | I & C | None     | I only |
  * I = intrinsics; C = code generation
  */
 
@@ -183,12 +184,16 @@ enum CPUFeatures {
     AVX2        = 0x100,
     HLE         = 0x200,
     RTM         = 0x400,
+    SHA         = 0x800,
 
     // used only to indicate that the CPU detection was initialised
     QSimdInitialized = 0x80000000
 };
 
 static const uint qCompilerCpuFeatures = 0
+#if defined __SHA__
+        | SHA
+#endif
 #if defined __RTM__
         | RTM
 #endif
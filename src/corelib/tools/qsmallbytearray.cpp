@@ -0,0 +1,482 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsmallbytearray.h"
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_STATIC_ASSERT(sizeof(QByteArray) <= QSmallByteArray::InlineCapacity);
+
+/*!
+    \class QSmallByteArray
+    \inmodule QtCore
+    \brief The QSmallByteArray class provides an array of bytes that
+    stores short arrays without allocating memory.
+    \since 5.3
+
+    \ingroup tools
+    \ingroup string-processing
+
+    \reentrant
+
+    QSmallByteArray stores up to InlineCapacity (23) bytes inside the
+    object itself, followed by a terminating '\\0', without any heap
+    allocation. Longer arrays are stored in a QByteArray, which
+    QSmallByteArray shares with the QByteArray it was created from. A
+    QSmallByteArray takes the same space as three pointers on 64-bit
+    platforms.
+
+    QSmallByteArray converts implicitly to QByteArray and can be
+    constructed implicitly from QByteArray and from '\\0'-terminated
+    strings. Converting an array that is stored inline to a QByteArray
+    allocates memory. qHash() returns the same value as for the
+    equivalent QByteArray.
+
+    See the QSmallString documentation for the rationale behind this
+    class.
+
+    \sa QByteArray, QSmallString
+*/
+
+/*!
+    \enum QSmallByteArray::anonymous
+
+    \value InlineCapacity The maximum number of bytes stored without
+    allocating memory.
+*/
+
+/*! \fn QSmallByteArray::QSmallByteArray()
+
+    Constructs an empty byte array.
+*/
+
+/*!
+    Constructs a byte array containing the first \a size bytes of array
+    \a data. If \a size is negative, \a data is assumed to point to a
+    '\\0'-terminated string and its length is determined dynamically.
+*/
+QSmallByteArray::QSmallByteArray(const char *data, int size)
+{
+    if (data && size < 0)
+        size = int(qstrlen(data));
+    if (!data || size <= 0) {
+        initInline();
+    } else if (size <= InlineCapacity) {
+        ::memcpy(d.c, data, size);
+        setInlineSize(size);
+    } else {
+        QByteArray ba(data, size);
+        adoptHeap(ba);
+    }
+}
+
+/*!
+    Constructs a byte array of size \a size with every byte set to
+    character \a ch.
+*/
+QSmallByteArray::QSmallByteArray(int size, char ch)
+{
+    if (size <= 0) {
+        initInline();
+    } else if (size <= InlineCapacity) {
+        ::memset(d.c, ch, size);
+        setInlineSize(size);
+    } else {
+        QByteArray ba(size, ch);
+        adoptHeap(ba);
+    }
+}
+
+/*!
+    Constructs a copy of \a ba. If \a ba fits into the inline storage,
+    its bytes are copied; otherwise the new array shares the data of
+    \a ba.
+*/
+QSmallByteArray::QSmallByteArray(const QByteArray &ba)
+{
+    if (ba.size() <= InlineCapacity) {
+        ::memcpy(d.c, ba.constData(), ba.size());
+        setInlineSize(ba.size());
+    } else {
+        setHeap(ba);
+    }
+}
+
+/*! \fn QSmallByteArray::QSmallByteArray(const QSmallByteArray &other)
+
+    Constructs a copy of \a other.
+*/
+
+/*! \fn QSmallByteArray::QSmallByteArray(QSmallByteArray &&other)
+
+    Move-constructs a QSmallByteArray instance, making it point at the
+    same object that \a other was pointing to. \a other is left empty.
+*/
+
+/*! \fn QSmallByteArray::~QSmallByteArray()
+
+    Destroys the byte array.
+*/
+
+/*!
+    Assigns \a other to this byte array and returns a reference to this
+    byte array.
+*/
+QSmallByteArray &QSmallByteArray::operator=(const QSmallByteArray &other)
+{
+    if (this != &other) {
+        QSmallByteArray copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+/*!
+    \overload operator=()
+
+    Assigns \a ba to this byte array and returns a reference to this
+    byte array.
+*/
+QSmallByteArray &QSmallByteArray::operator=(const QByteArray &ba)
+{
+    QSmallByteArray copy(ba);
+    swap(copy);
+    return *this;
+}
+
+/*!
+    \overload operator=()
+
+    Assigns the '\\0'-terminated string \a str to this byte array and
+    returns a reference to this byte array.
+*/
+QSmallByteArray &QSmallByteArray::operator=(const char *str)
+{
+    QSmallByteArray copy(str);
+    swap(copy);
+    return *this;
+}
+
+/*! \fn QSmallByteArray &QSmallByteArray::operator=(QSmallByteArray &&other)
+
+    Move-assigns \a other to this QSmallByteArray instance.
+*/
+
+/*! \fn void QSmallByteArray::swap(QSmallByteArray &other)
+
+    Swaps byte array \a other with this byte array. This operation is
+    very fast and never fails.
+*/
+
+/*! \fn bool QSmallByteArray::isInline() const
+
+    Returns true if the bytes are stored inside the QSmallByteArray
+    object; returns false if they are stored in a heap-allocated
+    QByteArray.
+*/
+
+/*! \fn int QSmallByteArray::size() const
+
+    Returns the number of bytes in this byte array.
+*/
+
+/*! \fn int QSmallByteArray::count() const
+
+    Same as size().
+*/
+
+/*! \fn int QSmallByteArray::length() const
+
+    Same as size().
+*/
+
+/*! \fn bool QSmallByteArray::isEmpty() const
+
+    Returns true if the byte array has size 0; otherwise returns false.
+*/
+
+/*! \fn int QSmallByteArray::capacity() const
+
+    Returns the maximum number of bytes that can be stored in the byte
+    array without allocating memory. This is InlineCapacity for arrays
+    stored inline.
+*/
+
+/*!
+    Sets the size of the byte array to \a size bytes. If \a size is
+    greater than the current size, the byte array is extended and the
+    new bytes are uninitialized, as with QByteArray::resize(). An array
+    that grows beyond InlineCapacity moves to the heap.
+*/
+void QSmallByteArray::resize(int size)
+{
+    if (size < 0)
+        size = 0;
+    if (!isInline()) {
+        heap().resize(size);
+    } else if (size <= InlineCapacity) {
+        setInlineSize(size);
+    } else {
+        QByteArray ba(size, Qt::Uninitialized);
+        ::memcpy(ba.data(), d.c, this->size());
+        adoptHeap(ba);
+    }
+}
+
+/*!
+    Truncates the byte array at index position \a pos. If \a pos is
+    beyond the end of the array, nothing happens.
+*/
+void QSmallByteArray::truncate(int pos)
+{
+    if (pos < size())
+        resize(pos);
+}
+
+/*!
+    Removes \a n bytes from the end of the byte array. If \a n is greater
+    than size(), the result is an empty byte array.
+*/
+void QSmallByteArray::chop(int n)
+{
+    if (n > 0)
+        resize(size() - n);
+}
+
+/*!
+    Clears the contents of the byte array and makes it empty. Heap
+    memory held by the array is released.
+*/
+void QSmallByteArray::clear()
+{
+    if (!isInline())
+        heap().~QByteArray();
+    initInline();
+}
+
+/*! \fn const char *QSmallByteArray::constData() const
+
+    Returns a pointer to the '\\0'-terminated data stored in the byte
+    array. The pointer remains valid until the byte array is modified,
+    moved or destroyed.
+*/
+
+/*! \fn const char *QSmallByteArray::data() const
+
+    \overload
+*/
+
+/*! \fn char *QSmallByteArray::data()
+
+    Returns a pointer to the data stored in the byte array, which may be
+    used to modify it.
+*/
+
+/*! \fn char QSmallByteArray::at(int i) const
+
+    Returns the byte at index position \a i, which must be a valid index
+    position in the byte array.
+*/
+
+/*! \fn char QSmallByteArray::operator[](int i) const
+
+    Same as at(\a i).
+*/
+
+/*! \fn char &QSmallByteArray::operator[](int i)
+
+    \overload
+
+    Returns the byte at index position \a i as a modifiable reference.
+*/
+
+/*!
+    Appends the first \a len bytes of \a str to this byte array and
+    returns a reference to it.
+*/
+QSmallByteArray &QSmallByteArray::append(const char *str, int len)
+{
+    if (!str || len <= 0)
+        return *this;
+
+    const int oldSize = size();
+    if (!isInline()) {
+        if (str >= heap().constData() && str < heap().constData() + oldSize) {
+            // appending from ourselves; QByteArray::append may reallocate first
+            const QByteArray copy(str, len);
+            heap().append(copy);
+        } else {
+            heap().append(str, len);
+        }
+    } else if (oldSize + len <= InlineCapacity) {
+        ::memmove(d.c + oldSize, str, len);
+        setInlineSize(oldSize + len);
+    } else {
+        QByteArray ba;
+        ba.reserve(oldSize + len);
+        ba.append(d.c, oldSize);
+        ba.append(str, len);
+        adoptHeap(ba);
+    }
+    return *this;
+}
+
+/*! \fn QSmallByteArray &QSmallByteArray::append(char ch)
+
+    \overload append()
+
+    Appends the character \a ch to this byte array.
+*/
+
+/*! \fn QSmallByteArray &QSmallByteArray::append(const char *str)
+
+    \overload append()
+
+    Appends the '\\0'-terminated string \a str to this byte array.
+*/
+
+/*! \fn QSmallByteArray &QSmallByteArray::append(const QByteArray &ba)
+
+    \overload append()
+
+    Appends the byte array \a ba to this byte array.
+*/
+
+/*!
+    \overload append()
+
+    Appends the byte array \a ba to this byte array.
+*/
+QSmallByteArray &QSmallByteArray::append(const QSmallByteArray &ba)
+{
+    if (isEmpty() && !ba.isInline()) {
+        *this = ba;
+        return *this;
+    }
+    return append(ba.constData(), ba.size());
+}
+
+/*! \fn QSmallByteArray &QSmallByteArray::operator+=(char ch)
+
+    Same as append(\a ch).
+*/
+
+/*! \fn QSmallByteArray &QSmallByteArray::operator+=(const char *str)
+
+    Same as append(\a str).
+*/
+
+/*! \fn QSmallByteArray &QSmallByteArray::operator+=(const QByteArray &ba)
+
+    Same as append(\a ba).
+*/
+
+/*! \fn QSmallByteArray &QSmallByteArray::operator+=(const QSmallByteArray &ba)
+
+    Same as append(\a ba).
+*/
+
+/*!
+    Returns the byte array as a QByteArray. This allocates memory if the
+    array is stored inline; otherwise the stored QByteArray is returned.
+
+    \sa isInline()
+*/
+QByteArray QSmallByteArray::toByteArray() const
+{
+    if (!isInline())
+        return heap();
+    if (isEmpty())
+        return QByteArray();
+    return QByteArray(d.c, size());
+}
+
+/*! \fn QSmallByteArray::operator QByteArray() const
+
+    Same as toByteArray().
+*/
+
+/*! \relates QSmallByteArray
+
+    Compares \a a1 with \a a2 bytewise and returns a negative value if
+    \a a1 is less than \a a2, 0 if they are equal, and a positive value
+    if \a a1 is greater than \a a2.
+*/
+int qstrcmp(const QSmallByteArray &a1, const QSmallByteArray &a2)
+{
+    const int l = qMin(a1.size(), a2.size());
+    const int r = ::memcmp(a1.constData(), a2.constData(), l);
+    return r ? r : a1.size() - a2.size();
+}
+
+/*! \fn bool operator==(const QSmallByteArray &a1, const QSmallByteArray &a2)
+    \relates QSmallByteArray
+
+    Returns true if byte array \a a1 is equal to byte array \a a2;
+    otherwise returns false.
+*/
+
+/*! \fn bool operator!=(const QSmallByteArray &a1, const QSmallByteArray &a2)
+    \relates QSmallByteArray
+
+    Returns true if byte array \a a1 is not equal to byte array \a a2;
+    otherwise returns false.
+*/
+
+/*! \fn bool operator<(const QSmallByteArray &a1, const QSmallByteArray &a2)
+    \relates QSmallByteArray
+
+    Returns true if byte array \a a1 is lexically less than byte array
+    \a a2; otherwise returns false.
+*/
+
+/*! \fn uint qHash(const QSmallByteArray &key, uint seed = 0)
+    \relates QSmallByteArray
+
+    Returns the hash value for \a key, using \a seed to seed the
+    calculation. The result is the same as for the equivalent
+    QByteArray.
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,182 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSMALLBYTEARRAY_H
+#define QSMALLBYTEARRAY_H
+
+#include <QtCore/qbytearray.h>
+
+#include <new>
+
+QT_BEGIN_NAMESPACE
+
+
+class Q_CORE_EXPORT QSmallByteArray
+{
+public:
+    enum { InlineCapacity = 23 };
+
+    inline QSmallByteArray() { initInline(); }
+    QSmallByteArray(const char *data, int size = -1);
+    QSmallByteArray(int size, char ch);
+    QSmallByteArray(const QByteArray &ba);
+    inline QSmallByteArray(const QSmallByteArray &other);
+    inline ~QSmallByteArray() { if (!isInline()) heap().~QByteArray(); }
+
+    QSmallByteArray &operator=(const QSmallByteArray &other);
+    QSmallByteArray &operator=(const QByteArray &ba);
+    QSmallByteArray &operator=(const char *str);
+#ifdef Q_COMPILER_RVALUE_REFS
+    inline QSmallByteArray(QSmallByteArray &&other) { d = other.d; other.initInline(); }
+    inline QSmallByteArray &operator=(QSmallByteArray &&other) { swap(other); return *this; }
+#endif
+    inline void swap(QSmallByteArray &other) { Data t = d; d = other.d; other.d = t; }
+
+    inline bool isInline() const { return uchar(d.c[InlineCapacity]) != HeapMarker; }
+    inline int size() const
+    { return isInline() ? InlineCapacity - uchar(d.c[InlineCapacity]) : heap().size(); }
+    inline int count() const { return size(); }
+    inline int length() const { return size(); }
+    inline bool isEmpty() const { return size() == 0; }
+    inline int capacity() const { return isInline() ? int(InlineCapacity) : heap().capacity(); }
+
+    void resize(int size);
+    void truncate(int pos);
+    void chop(int n);
+    void clear();
+
+    inline const char *constData() const { return isInline() ? d.c : heap().constData(); }
+    inline const char *data() const { return constData(); }
+    inline char *data() { return isInline() ? d.c : heap().data(); }
+
+    inline char at(int i) const
+    { Q_ASSERT(uint(i) < uint(size())); return constData()[i]; }
+    inline char operator[](int i) const { return at(i); }
+    inline char &operator[](int i)
+    { Q_ASSERT(uint(i) < uint(size())); return data()[i]; }
+
+    QSmallByteArray &append(const char *str, int len);
+    inline QSmallByteArray &append(char ch) { return append(&ch, 1); }
+    inline QSmallByteArray &append(const char *str) { return append(str, qstrlen(str)); }
+    inline QSmallByteArray &append(const QByteArray &ba) { return append(ba.constData(), ba.size()); }
+    QSmallByteArray &append(const QSmallByteArray &ba);
+    inline QSmallByteArray &operator+=(char ch) { return append(ch); }
+    inline QSmallByteArray &operator+=(const char *str) { return append(str); }
+    inline QSmallByteArray &operator+=(const QByteArray &ba) { return append(ba); }
+    inline QSmallByteArray &operator+=(const QSmallByteArray &ba) { return append(ba); }
+
+    QByteArray toByteArray() const;
+    inline operator QByteArray() const { return toByteArray(); }
+
+private:
+    enum { HeapMarker = 0xff };
+
+    // Inline mode: c[0..size) hold the bytes and c[InlineCapacity] holds
+    // InlineCapacity - size, which doubles as the terminating null of a
+    // full array. Heap mode: a QByteArray lives at the start of the
+    // storage and c[InlineCapacity] is HeapMarker.
+    union Data {
+        char c[InlineCapacity + 1];
+        void *alignment;
+    } d;
+
+    inline QByteArray &heap() { void *p = &d; return *static_cast<QByteArray *>(p); }
+    inline const QByteArray &heap() const { const void *p = &d; return *static_cast<const QByteArray *>(p); }
+
+    inline void initInline() { d.c[0] = 0; d.c[InlineCapacity] = char(InlineCapacity); }
+    inline void setInlineSize(int size)
+    {
+        Q_ASSERT(size >= 0 && size <= InlineCapacity);
+        d.c[size] = 0;
+        d.c[InlineCapacity] = char(InlineCapacity - size);
+    }
+    inline void setHeap(const QByteArray &ba)
+    {
+        new (&d) QByteArray(ba);
+        d.c[InlineCapacity] = char(HeapMarker);
+    }
+    inline void adoptHeap(QByteArray &ba)
+    {
+        new (&d) QByteArray;
+        heap().swap(ba);
+        d.c[InlineCapacity] = char(HeapMarker);
+    }
+};
+
+Q_DECLARE_TYPEINFO(QSmallByteArray, Q_MOVABLE_TYPE);
+
+inline QSmallByteArray::QSmallByteArray(const QSmallByteArray &other)
+{
+    if (other.isInline())
+        d = other.d;
+    else
+        setHeap(other.heap());
+}
+
+inline bool operator==(const QSmallByteArray &a1, const QSmallByteArray &a2)
+{ return a1.size() == a2.size() && memcmp(a1.constData(), a2.constData(), a1.size()) == 0; }
+inline bool operator==(const QSmallByteArray &a1, const QByteArray &a2)
+{ return a1.size() == a2.size() && memcmp(a1.constData(), a2.constData(), a1.size()) == 0; }
+inline bool operator==(const QByteArray &a1, const QSmallByteArray &a2)
+{ return a2 == a1; }
+inline bool operator==(const QSmallByteArray &a1, const char *a2)
+{ return a2 ? qstrcmp(a1.constData(), a2) == 0 : a1.isEmpty(); }
+inline bool operator==(const char *a1, const QSmallByteArray &a2)
+{ return a2 == a1; }
+inline bool operator!=(const QSmallByteArray &a1, const QSmallByteArray &a2) { return !(a1 == a2); }
+inline bool operator!=(const QSmallByteArray &a1, const QByteArray &a2) { return !(a1 == a2); }
+inline bool operator!=(const QByteArray &a1, const QSmallByteArray &a2) { return !(a2 == a1); }
+inline bool operator!=(const QSmallByteArray &a1, const char *a2) { return !(a1 == a2); }
+inline bool operator!=(const char *a1, const QSmallByteArray &a2) { return !(a2 == a1); }
+
+Q_CORE_EXPORT int qstrcmp(const QSmallByteArray &a1, const QSmallByteArray &a2);
+
+inline bool operator<(const QSmallByteArray &a1, const QSmallByteArray &a2) { return qstrcmp(a1, a2) < 0; }
+inline bool operator<=(const QSmallByteArray &a1, const QSmallByteArray &a2) { return qstrcmp(a1, a2) <= 0; }
+inline bool operator>(const QSmallByteArray &a1, const QSmallByteArray &a2) { return qstrcmp(a1, a2) > 0; }
+inline bool operator>=(const QSmallByteArray &a1, const QSmallByteArray &a2) { return qstrcmp(a1, a2) >= 0; }
+
+Q_CORE_EXPORT uint qHash(const QSmallByteArray &key, uint seed = 0) Q_DECL_NOTHROW;
+
+QT_END_NAMESPACE
+
+#endif // QSMALLBYTEARRAY_H
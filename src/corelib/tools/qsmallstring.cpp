@@ -0,0 +1,769 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsmallstring.h"
+
+#include <private/qutfcodec_p.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_STATIC_ASSERT(sizeof(QString) <= QSmallString::InlineCapacity * sizeof(ushort));
+
+static int ucstrcmp(const ushort *a, int alen, const ushort *b, int blen)
+{
+    const int l = qMin(alen, blen);
+    for (int i = 0; i < l; ++i) {
+        if (a[i] != b[i])
+            return int(a[i]) - int(b[i]);
+    }
+    return alen - blen;
+}
+
+static int ucstrcmp(const ushort *a, int alen, const uchar *b, int blen)
+{
+    const int l = qMin(alen, blen);
+    for (int i = 0; i < l; ++i) {
+        if (a[i] != b[i])
+            return int(a[i]) - int(b[i]);
+    }
+    return alen - blen;
+}
+
+// Case folds the code point starting at \a s[i] and advances i past it.
+static inline uint foldedCodePoint(const ushort *s, int len, int &i)
+{
+    uint uc = s[i++];
+    if (QChar::isHighSurrogate(uc) && i < len && QChar::isLowSurrogate(s[i]))
+        uc = QChar::surrogateToUcs4(ushort(uc), s[i++]);
+    return QChar::toCaseFolded(uc);
+}
+
+static int ucstricmp(const ushort *a, int alen, const ushort *b, int blen)
+{
+    int i = 0;
+    int j = 0;
+    while (i < alen && j < blen) {
+        const uint ca = foldedCodePoint(a, alen, i);
+        const uint cb = foldedCodePoint(b, blen, j);
+        if (ca != cb)
+            return int(ca) - int(cb);
+    }
+    return (alen - i) - (blen - j);
+}
+
+static int ucstricmp(const ushort *a, int alen, const uchar *b, int blen)
+{
+    int i = 0;
+    const int l = qMin(alen, blen);
+    for (; i < l; ++i) {
+        int j = i;
+        const uint ca = foldedCodePoint(a, alen, j);
+        const uint cb = QChar::toCaseFolded(uint(b[i]));
+        if (ca != cb)
+            return int(ca) - int(cb);
+    }
+    return alen - blen;
+}
+
+/*!
+    \class QSmallString
+    \inmodule QtCore
+    \brief The QSmallString class provides a Unicode string that stores
+    short strings without allocating memory.
+    \since 5.3
+
+    \ingroup tools
+    \ingroup string-processing
+
+    \reentrant
+
+    Every non-empty QString keeps its characters in a separately
+    allocated block of memory. For applications that handle very many
+    short strings, such as the keys of a JSON document or the role names
+    of a model, the cost of those allocations can dominate.
+
+    QSmallString stores strings of up to InlineCapacity (11) UTF-16
+    code units inside the object itself, without any heap allocation.
+    Longer strings are stored in a QString, which QSmallString shares
+    with the QString it was created from, so that constructing a
+    QSmallString from a long QString does not copy or allocate either.
+    A QSmallString takes the same space as three pointers on 64-bit
+    platforms.
+
+    QSmallString converts implicitly to QString, so it can be passed to
+    any function expecting a QString, and it can be constructed
+    implicitly from QString, QStringRef and QLatin1String. Note that
+    converting a string that is stored inline to a QString allocates
+    memory; code that converts back and forth loses the benefit of
+    QSmallString. The comparison operators and qHash() work directly on
+    the stored characters, and qHash() returns the same value as for the
+    equivalent QString, so QSmallString works well as the key type of a
+    QHash.
+
+    Unlike QString, QSmallString is not implicitly shared when it stores
+    a string inline: copying it copies the characters, which is cheap
+    for such short strings. QSmallString does not distinguish between
+    null and empty strings; toString() returns a null QString for an
+    empty QSmallString.
+
+    \sa QString, QSmallByteArray
+*/
+
+/*!
+    \enum QSmallString::anonymous
+
+    \value InlineCapacity The maximum number of UTF-16 code units stored
+    without allocating memory.
+*/
+
+/*! \fn QSmallString::QSmallString()
+
+    Constructs an empty string.
+*/
+
+/*!
+    Constructs a string initialized with the first \a size characters of
+    the QChar array \a unicode. \a unicode is copied.
+
+    If \a size is negative, \a unicode is assumed to point to a
+    '\\0'-terminated array.
+*/
+QSmallString::QSmallString(const QChar *unicode, int size)
+{
+    if (unicode && size < 0) {
+        size = 0;
+        while (unicode[size].unicode() != 0)
+            ++size;
+    }
+    initInline();
+    assign(unicode, size);
+}
+
+/*!
+    Constructs a copy of \a str. If \a str fits into the inline storage,
+    its characters are copied; otherwise the new string shares the data
+    of \a str.
+*/
+QSmallString::QSmallString(const QString &str)
+{
+    if (str.size() <= InlineCapacity) {
+        ::memcpy(d.u, str.unicode(), str.size() * sizeof(QChar));
+        setInlineSize(str.size());
+    } else {
+        setHeap(str);
+    }
+}
+
+/*!
+    Constructs a copy of the characters referenced by \a str. No memory
+    is allocated if the string fits into the inline storage.
+*/
+QSmallString::QSmallString(const QStringRef &str)
+{
+    initInline();
+    assign(str.unicode(), str.size());
+}
+
+/*!
+    Constructs a copy of the Latin-1 string \a str.
+*/
+QSmallString::QSmallString(QLatin1String str)
+{
+    if (str.size() <= InlineCapacity) {
+        const uchar *src = reinterpret_cast<const uchar *>(str.latin1());
+        for (int i = 0; i < str.size(); ++i)
+            d.u[i] = src[i];
+        setInlineSize(str.size());
+    } else {
+        QString copy(str);
+        adoptHeap(copy);
+    }
+}
+
+/*!
+    Constructs a string of size 1 containing the character \a ch.
+*/
+QSmallString::QSmallString(QChar ch)
+{
+    d.u[0] = ch.unicode();
+    setInlineSize(1);
+}
+
+/*! \fn QSmallString::QSmallString(const QSmallString &other)
+
+    Constructs a copy of \a other.
+*/
+
+/*! \fn QSmallString::QSmallString(QSmallString &&other)
+
+    Move-constructs a QSmallString instance, making it point at the same
+    object that \a other was pointing to. \a other is left empty.
+*/
+
+/*! \fn QSmallString::~QSmallString()
+
+    Destroys the string.
+*/
+
+/*!
+    Assigns \a other to this string and returns a reference to this
+    string.
+*/
+QSmallString &QSmallString::operator=(const QSmallString &other)
+{
+    if (this != &other) {
+        QSmallString copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+/*!
+    \overload operator=()
+
+    Assigns \a str to this string and returns a reference to this string.
+*/
+QSmallString &QSmallString::operator=(const QString &str)
+{
+    QSmallString copy(str);
+    swap(copy);
+    return *this;
+}
+
+/*!
+    \overload operator=()
+
+    Assigns the Latin-1 string \a str to this string and returns a
+    reference to this string.
+*/
+QSmallString &QSmallString::operator=(QLatin1String str)
+{
+    QSmallString copy(str);
+    swap(copy);
+    return *this;
+}
+
+/*! \fn QSmallString &QSmallString::operator=(QSmallString &&other)
+
+    Move-assigns \a other to this QSmallString instance.
+*/
+
+/*! \fn void QSmallString::swap(QSmallString &other)
+
+    Swaps string \a other with this string. This operation is very fast
+    and never fails.
+*/
+
+/*! \fn bool QSmallString::isInline() const
+
+    Returns true if the string is stored inside the QSmallString object;
+    returns false if it is stored in a heap-allocated QString.
+*/
+
+/*! \fn int QSmallString::size() const
+
+    Returns the number of characters in this string.
+
+    \sa isEmpty(), resize()
+*/
+
+/*! \fn int QSmallString::count() const
+
+    Same as size().
+*/
+
+/*! \fn int QSmallString::length() const
+
+    Same as size().
+*/
+
+/*! \fn bool QSmallString::isEmpty() const
+
+    Returns true if the string has no characters; otherwise returns
+    false.
+*/
+
+/*! \fn int QSmallString::capacity() const
+
+    Returns the maximum number of characters that can be stored in the
+    string without allocating memory. This is InlineCapacity for strings
+    stored inline.
+*/
+
+/*!
+    Sets the size of the string to \a size characters. If \a size is
+    greater than the current size, the string is extended and the new
+    characters are uninitialized, as with QString::resize(). A string
+    that grows beyond InlineCapacity moves to the heap.
+
+    \sa truncate(), chop()
+*/
+void QSmallString::resize(int size)
+{
+    if (size < 0)
+        size = 0;
+    if (!isInline()) {
+        heap().resize(size);
+    } else if (size <= InlineCapacity) {
+        setInlineSize(size);
+    } else {
+        QString str(size, Qt::Uninitialized);
+        ::memcpy(str.data(), d.u, this->size() * sizeof(QChar));
+        adoptHeap(str);
+    }
+}
+
+/*!
+    Truncates the string at index \a pos. If \a pos is beyond the end of
+    the string, nothing happens.
+
+    \sa chop(), resize()
+*/
+void QSmallString::truncate(int pos)
+{
+    if (pos < size())
+        resize(pos);
+}
+
+/*!
+    Removes \a n characters from the end of the string. If \a n is
+    greater than size(), the result is an empty string.
+
+    \sa truncate()
+*/
+void QSmallString::chop(int n)
+{
+    if (n > 0)
+        resize(size() - n);
+}
+
+/*!
+    Clears the contents of the string and makes it empty. Heap memory
+    held by the string is released.
+*/
+void QSmallString::clear()
+{
+    if (!isInline())
+        heap().~QString();
+    initInline();
+}
+
+/*! \fn const QChar *QSmallString::unicode() const
+
+    Returns a '\\0'-terminated Unicode representation of the string. The
+    result remains valid until the string is modified, moved or
+    destroyed.
+
+    \sa utf16(), constData()
+*/
+
+/*! \fn const QChar *QSmallString::constData() const
+
+    Same as unicode().
+*/
+
+/*! \fn const ushort *QSmallString::utf16() const
+
+    Returns the string as a '\\0'-terminated array of unsigned shorts.
+    The result remains valid until the string is modified, moved or
+    destroyed.
+*/
+
+/*! \fn QChar *QSmallString::data()
+
+    Returns a pointer to the characters stored in the string, which may
+    be used to modify them.
+*/
+
+/*! \fn const QChar QSmallString::at(int i) const
+
+    Returns the character at index position \a i, which must be a valid
+    index position in the string.
+*/
+
+/*! \fn const QChar QSmallString::operator[](int i) const
+
+    Same as at(\a i).
+*/
+
+/*! \fn QChar &QSmallString::operator[](int i)
+
+    \overload
+
+    Returns the character at index position \a i as a modifiable
+    reference.
+*/
+
+/*!
+    Appends the first \a size characters of \a unicode to this string
+    and returns a reference to it.
+*/
+QSmallString &QSmallString::append(const QChar *unicode, int size)
+{
+    if (!unicode || size <= 0)
+        return *this;
+
+    const int oldSize = this->size();
+    if (!isInline()) {
+        if (unicode >= heap().unicode() && unicode < heap().unicode() + oldSize) {
+            // appending from ourselves; QString::append may reallocate first
+            const QString copy(unicode, size);
+            heap().append(copy);
+        } else {
+            heap().append(unicode, size);
+        }
+    } else if (oldSize + size <= InlineCapacity) {
+        ::memmove(d.u + oldSize, unicode, size * sizeof(QChar));
+        setInlineSize(oldSize + size);
+    } else {
+        QString str;
+        str.reserve(oldSize + size);
+        str.append(reinterpret_cast<const QChar *>(d.u), oldSize);
+        str.append(unicode, size);
+        adoptHeap(str);
+    }
+    return *this;
+}
+
+/*! \fn QSmallString &QSmallString::append(QChar ch)
+
+    \overload append()
+
+    Appends the character \a ch to this string.
+*/
+
+/*! \fn QSmallString &QSmallString::append(const QString &str)
+
+    \overload append()
+
+    Appends the string \a str to this string.
+*/
+
+/*! \fn QSmallString &QSmallString::append(const QStringRef &str)
+
+    \overload append()
+
+    Appends the string reference \a str to this string.
+*/
+
+/*!
+    \overload append()
+
+    Appends the string \a str to this string.
+*/
+QSmallString &QSmallString::append(const QSmallString &str)
+{
+    if (isEmpty() && !str.isInline()) {
+        *this = str;
+        return *this;
+    }
+    return append(str.unicode(), str.size());
+}
+
+/*!
+    \overload append()
+
+    Appends the Latin-1 string \a str to this string.
+*/
+QSmallString &QSmallString::append(QLatin1String str)
+{
+    const int oldSize = size();
+    if (isInline() && oldSize + str.size() <= InlineCapacity) {
+        const uchar *src = reinterpret_cast<const uchar *>(str.latin1());
+        for (int i = 0; i < str.size(); ++i)
+            d.u[oldSize + i] = src[i];
+        setInlineSize(oldSize + str.size());
+        return *this;
+    }
+    return append(QString(str));
+}
+
+/*! \fn QSmallString &QSmallString::operator+=(QChar ch)
+
+    Same as append(\a ch).
+*/
+
+/*! \fn QSmallString &QSmallString::operator+=(const QString &str)
+
+    Same as append(\a str).
+*/
+
+/*! \fn QSmallString &QSmallString::operator+=(const QStringRef &str)
+
+    Same as append(\a str).
+*/
+
+/*! \fn QSmallString &QSmallString::operator+=(const QSmallString &str)
+
+    Same as append(\a str).
+*/
+
+/*! \fn QSmallString &QSmallString::operator+=(QLatin1String str)
+
+    Same as append(\a str).
+*/
+
+/*!
+    Compares this string with \a other and returns an integer less than,
+    equal to, or greater than zero if this string is less than, equal
+    to, or greater than \a other.
+
+    If \a cs is Qt::CaseSensitive, the comparison is based exclusively on
+    the numeric Unicode values of the characters, as with
+    QString::compare(). Otherwise the strings are compared after case
+    folding.
+*/
+int QSmallString::compare(const QSmallString &other, Qt::CaseSensitivity cs) const
+{
+    if (cs == Qt::CaseSensitive)
+        return ucstrcmp(utf16(), size(), other.utf16(), other.size());
+    return ucstricmp(utf16(), size(), other.utf16(), other.size());
+}
+
+/*!
+    \overload compare()
+*/
+int QSmallString::compare(const QString &other, Qt::CaseSensitivity cs) const
+{
+    if (cs == Qt::CaseSensitive)
+        return ucstrcmp(utf16(), size(), other.utf16(), other.size());
+    return ucstricmp(utf16(), size(), other.utf16(), other.size());
+}
+
+/*!
+    \overload compare()
+*/
+int QSmallString::compare(const QStringRef &other, Qt::CaseSensitivity cs) const
+{
+    const ushort *o = reinterpret_cast<const ushort *>(other.unicode());
+    if (cs == Qt::CaseSensitive)
+        return ucstrcmp(utf16(), size(), o, other.size());
+    return ucstricmp(utf16(), size(), o, other.size());
+}
+
+/*!
+    \overload compare()
+*/
+int QSmallString::compare(QLatin1String other, Qt::CaseSensitivity cs) const
+{
+    const uchar *o = reinterpret_cast<const uchar *>(other.latin1());
+    if (cs == Qt::CaseSensitive)
+        return ucstrcmp(utf16(), size(), o, other.size());
+    return ucstricmp(utf16(), size(), o, other.size());
+}
+
+/*!
+    Returns the string as a QString. This allocates memory if the string
+    is stored inline; otherwise the stored QString is returned.
+
+    \sa isInline()
+*/
+QString QSmallString::toString() const
+{
+    if (!isInline())
+        return heap();
+    if (isEmpty())
+        return QString();
+    return QString(reinterpret_cast<const QChar *>(d.u), size());
+}
+
+/*! \fn QSmallString::operator QString() const
+
+    Same as toString().
+*/
+
+/*!
+    Returns a Latin-1 representation of the string as a QByteArray.
+    Characters that cannot be represented in Latin-1 are replaced by a
+    question mark, as with QString::toLatin1().
+*/
+QByteArray QSmallString::toLatin1() const
+{
+    if (!isInline())
+        return heap().toLatin1();
+    const int n = size();
+    QByteArray ba(n, Qt::Uninitialized);
+    char *dst = ba.data();
+    for (int i = 0; i < n; ++i)
+        dst[i] = d.u[i] > 0xff ? '?' : char(d.u[i]);
+    return ba;
+}
+
+/*!
+    Returns a UTF-8 representation of the string as a QByteArray.
+*/
+QByteArray QSmallString::toUtf8() const
+{
+    if (!isInline())
+        return heap().toUtf8();
+    if (isEmpty())
+        return QByteArray();
+    return QUtf8::convertFromUnicode(reinterpret_cast<const QChar *>(d.u), size(), 0);
+}
+
+/*!
+    Returns a QSmallString initialized with the first \a size characters
+    of the Latin-1 string \a str. If \a size is -1, qstrlen(\a str) is
+    used instead.
+*/
+QSmallString QSmallString::fromLatin1(const char *str, int size)
+{
+    if (str && size < 0)
+        size = int(qstrlen(str));
+    return QSmallString(QLatin1String(str, qMax(size, 0)));
+}
+
+/*!
+    Returns a QSmallString initialized with the first \a size bytes of
+    the UTF-8 string \a str. If \a size is -1, qstrlen(\a str) is used
+    instead.
+
+    Short strings consisting only of US-ASCII characters are decoded
+    directly into the inline storage. Other strings are decoded with
+    QString::fromUtf8().
+*/
+QSmallString QSmallString::fromUtf8(const char *str, int size)
+{
+    if (str && size < 0)
+        size = int(qstrlen(str));
+    if (!str || size <= 0)
+        return QSmallString();
+
+    if (size <= InlineCapacity) {
+        QSmallString result;
+        const uchar *src = reinterpret_cast<const uchar *>(str);
+        int i = 0;
+        for ( ; i < size && src[i] < 0x80; ++i)
+            result.d.u[i] = src[i];
+        if (i == size) {
+            result.setInlineSize(size);
+            return result;
+        }
+    }
+
+    QSmallString result;
+    QString decoded = QString::fromUtf8(str, size);
+    if (decoded.size() <= InlineCapacity)
+        result.assign(decoded.unicode(), decoded.size());
+    else
+        result.adoptHeap(decoded);
+    return result;
+}
+
+/*! \fn QSmallString QSmallString::fromLatin1(const QByteArray &str)
+
+    \overload
+
+    Returns a QSmallString initialized with the Latin-1 string \a str.
+*/
+
+/*! \fn QSmallString QSmallString::fromUtf8(const QByteArray &str)
+
+    \overload
+
+    Returns a QSmallString initialized with the UTF-8 string \a str.
+*/
+
+void QSmallString::assign(const QChar *unicode, int size)
+{
+    Q_ASSERT(isInline());
+    if (!unicode || size <= 0) {
+        setInlineSize(0);
+    } else if (size <= InlineCapacity) {
+        ::memmove(d.u, unicode, size * sizeof(QChar));
+        setInlineSize(size);
+    } else {
+        QString str(unicode, size);
+        adoptHeap(str);
+    }
+}
+
+/*! \fn bool operator==(const QSmallString &s1, const QSmallString &s2)
+    \relates QSmallString
+
+    Returns true if string \a s1 is equal to string \a s2; otherwise
+    returns false.
+*/
+
+/*! \fn bool operator!=(const QSmallString &s1, const QSmallString &s2)
+    \relates QSmallString
+
+    Returns true if string \a s1 is not equal to string \a s2; otherwise
+    returns false.
+*/
+
+/*! \fn bool operator<(const QSmallString &s1, const QSmallString &s2)
+    \relates QSmallString
+
+    Returns true if string \a s1 is lexically less than string \a s2;
+    otherwise returns false.
+*/
+
+/*! \fn bool operator<=(const QSmallString &s1, const QSmallString &s2)
+    \relates QSmallString
+
+    Returns true if string \a s1 is lexically less than or equal to
+    string \a s2; otherwise returns false.
+*/
+
+/*! \fn bool operator>(const QSmallString &s1, const QSmallString &s2)
+    \relates QSmallString
+
+    Returns true if string \a s1 is lexically greater than string \a s2;
+    otherwise returns false.
+*/
+
+/*! \fn bool operator>=(const QSmallString &s1, const QSmallString &s2)
+    \relates QSmallString
+
+    Returns true if string \a s1 is lexically greater than or equal to
+    string \a s2; otherwise returns false.
+*/
+
+/*! \fn uint qHash(const QSmallString &key, uint seed = 0)
+    \relates QSmallString
+
+    Returns the hash value for \a key, using \a seed to seed the
+    calculation. The result is the same as for the equivalent QString.
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,215 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSMALLSTRING_H
+#define QSMALLSTRING_H
+
+#include <QtCore/qstring.h>
+
+#include <new>
+
+QT_BEGIN_NAMESPACE
+
+
+class Q_CORE_EXPORT QSmallString
+{
+public:
+    enum { InlineCapacity = 11 };
+
+    inline QSmallString() { initInline(); }
+    QSmallString(const QChar *unicode, int size);
+    QSmallString(const QString &str);
+    QSmallString(const QStringRef &str);
+    QSmallString(QLatin1String str);
+    explicit QSmallString(QChar ch);
+    inline QSmallString(const QSmallString &other);
+    inline ~QSmallString() { if (!isInline()) heap().~QString(); }
+
+    QSmallString &operator=(const QSmallString &other);
+    QSmallString &operator=(const QString &str);
+    QSmallString &operator=(QLatin1String str);
+#ifdef Q_COMPILER_RVALUE_REFS
+    inline QSmallString(QSmallString &&other) { d = other.d; other.initInline(); }
+    inline QSmallString &operator=(QSmallString &&other) { swap(other); return *this; }
+#endif
+    inline void swap(QSmallString &other) { Data t = d; d = other.d; other.d = t; }
+
+    inline bool isInline() const { return d.u[InlineCapacity] != HeapMarker; }
+    inline int size() const
+    { return isInline() ? InlineCapacity - d.u[InlineCapacity] : heap().size(); }
+    inline int count() const { return size(); }
+    inline int length() const { return size(); }
+    inline bool isEmpty() const { return size() == 0; }
+    inline int capacity() const { return isInline() ? int(InlineCapacity) : heap().capacity(); }
+
+    void resize(int size);
+    void truncate(int pos);
+    void chop(int n);
+    void clear();
+
+    inline const QChar *unicode() const
+    { return isInline() ? reinterpret_cast<const QChar *>(d.u) : heap().unicode(); }
+    inline const QChar *constData() const { return unicode(); }
+    inline const ushort *utf16() const { return reinterpret_cast<const ushort *>(unicode()); }
+    inline QChar *data()
+    { return isInline() ? reinterpret_cast<QChar *>(d.u) : heap().data(); }
+
+    inline const QChar at(int i) const
+    { Q_ASSERT(uint(i) < uint(size())); return unicode()[i]; }
+    inline const QChar operator[](int i) const { return at(i); }
+    inline QChar &operator[](int i)
+    { Q_ASSERT(uint(i) < uint(size())); return data()[i]; }
+
+    QSmallString &append(const QChar *unicode, int size);
+    inline QSmallString &append(QChar ch) { return append(&ch, 1); }
+    inline QSmallString &append(const QString &str) { return append(str.unicode(), str.size()); }
+    inline QSmallString &append(const QStringRef &str) { return append(str.unicode(), str.size()); }
+    QSmallString &append(const QSmallString &str);
+    QSmallString &append(QLatin1String str);
+    inline QSmallString &operator+=(QChar ch) { return append(ch); }
+    inline QSmallString &operator+=(const QString &str) { return append(str); }
+    inline QSmallString &operator+=(const QStringRef &str) { return append(str); }
+    inline QSmallString &operator+=(const QSmallString &str) { return append(str); }
+    inline QSmallString &operator+=(QLatin1String str) { return append(str); }
+
+    int compare(const QSmallString &other, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    int compare(const QString &other, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    int compare(const QStringRef &other, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    int compare(QLatin1String other, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+
+    QString toString() const;
+    inline operator QString() const { return toString(); }
+    QByteArray toLatin1() const;
+    QByteArray toUtf8() const;
+
+    static QSmallString fromLatin1(const char *str, int size = -1);
+    static QSmallString fromUtf8(const char *str, int size = -1);
+    static inline QSmallString fromLatin1(const QByteArray &str)
+    { return fromLatin1(str.constData(), qstrnlen(str.constData(), str.size())); }
+    static inline QSmallString fromUtf8(const QByteArray &str)
+    { return fromUtf8(str.constData(), qstrnlen(str.constData(), str.size())); }
+
+private:
+    enum { HeapMarker = 0xffff };
+
+    // Inline mode: u[0..size) hold the characters and u[InlineCapacity]
+    // holds InlineCapacity - size, which doubles as the terminating null
+    // of a full string. Heap mode: a QString lives at the start of the
+    // storage and u[InlineCapacity] is HeapMarker.
+    union Data {
+        ushort u[InlineCapacity + 1];
+        void *alignment;
+    } d;
+
+    inline QString &heap() { void *p = &d; return *static_cast<QString *>(p); }
+    inline const QString &heap() const { const void *p = &d; return *static_cast<const QString *>(p); }
+
+    inline void initInline() { d.u[0] = 0; d.u[InlineCapacity] = InlineCapacity; }
+    inline void setInlineSize(int size)
+    {
+        Q_ASSERT(size >= 0 && size <= InlineCapacity);
+        d.u[size] = 0;
+        d.u[InlineCapacity] = ushort(InlineCapacity - size);
+    }
+    inline void setHeap(const QString &str)
+    {
+        new (&d) QString(str);
+        d.u[InlineCapacity] = HeapMarker;
+    }
+    inline void adoptHeap(QString &str)
+    {
+        new (&d) QString;
+        heap().swap(str);
+        d.u[InlineCapacity] = HeapMarker;
+    }
+    void assign(const QChar *unicode, int size);
+};
+
+Q_DECLARE_TYPEINFO(QSmallString, Q_MOVABLE_TYPE);
+
+inline QSmallString::QSmallString(const QSmallString &other)
+{
+    if (other.isInline())
+        d = other.d;
+    else
+        setHeap(other.heap());
+}
+
+inline bool operator==(const QSmallString &s1, const QSmallString &s2)
+{ return s1.size() == s2.size() && s1.compare(s2) == 0; }
+inline bool operator!=(const QSmallString &s1, const QSmallString &s2) { return !(s1 == s2); }
+inline bool operator<(const QSmallString &s1, const QSmallString &s2) { return s1.compare(s2) < 0; }
+inline bool operator<=(const QSmallString &s1, const QSmallString &s2) { return s1.compare(s2) <= 0; }
+inline bool operator>(const QSmallString &s1, const QSmallString &s2) { return s1.compare(s2) > 0; }
+inline bool operator>=(const QSmallString &s1, const QSmallString &s2) { return s1.compare(s2) >= 0; }
+
+inline bool operator==(const QSmallString &s1, const QString &s2)
+{ return s1.size() == s2.size() && s1.compare(s2) == 0; }
+inline bool operator!=(const QSmallString &s1, const QString &s2) { return !(s1 == s2); }
+inline bool operator<(const QSmallString &s1, const QString &s2) { return s1.compare(s2) < 0; }
+inline bool operator<=(const QSmallString &s1, const QString &s2) { return s1.compare(s2) <= 0; }
+inline bool operator>(const QSmallString &s1, const QString &s2) { return s1.compare(s2) > 0; }
+inline bool operator>=(const QSmallString &s1, const QString &s2) { return s1.compare(s2) >= 0; }
+inline bool operator==(const QString &s1, const QSmallString &s2) { return s2 == s1; }
+inline bool operator!=(const QString &s1, const QSmallString &s2) { return !(s2 == s1); }
+inline bool operator<(const QString &s1, const QSmallString &s2) { return s2.compare(s1) > 0; }
+inline bool operator<=(const QString &s1, const QSmallString &s2) { return s2.compare(s1) >= 0; }
+inline bool operator>(const QString &s1, const QSmallString &s2) { return s2.compare(s1) < 0; }
+inline bool operator>=(const QString &s1, const QSmallString &s2) { return s2.compare(s1) <= 0; }
+
+inline bool operator==(const QSmallString &s1, const QStringRef &s2)
+{ return s1.size() == s2.size() && s1.compare(s2) == 0; }
+inline bool operator!=(const QSmallString &s1, const QStringRef &s2) { return !(s1 == s2); }
+inline bool operator==(const QStringRef &s1, const QSmallString &s2) { return s2 == s1; }
+inline bool operator!=(const QStringRef &s1, const QSmallString &s2) { return !(s2 == s1); }
+
+inline bool operator==(const QSmallString &s1, QLatin1String s2)
+{ return s1.size() == s2.size() && s1.compare(s2) == 0; }
+inline bool operator!=(const QSmallString &s1, QLatin1String s2) { return !(s1 == s2); }
+inline bool operator==(QLatin1String s1, const QSmallString &s2) { return s2 == s1; }
+inline bool operator!=(QLatin1String s1, const QSmallString &s2) { return !(s2 == s1); }
+
+Q_CORE_EXPORT uint qHash(const QSmallString &key, uint seed = 0) Q_DECL_NOTHROW;
+
+QT_END_NAMESPACE
+
+#endif // QSMALLSTRING_H
@@ -124,6 +124,170 @@ static inline bool qt_ends_with(const QChar *haystack, int haystackLen,
 static inline bool qt_ends_with(const QChar *haystack, int haystackLen,
                                 QLatin1String needle, Qt::CaseSensitivity cs);
 
+/*
+    SIMD helpers for the case-insensitive comparisons and the case
+    conversions below. They work on blocks of eight characters as long as
+    every character in the block is US-ASCII, where case folding and case
+    conversion amount to flipping bit 0x20 of the letters; any other block
+    is left to the per-character code, which looks up the Unicode tables.
+*/
+#if defined(__SSE2__)
+static inline bool simdIsAscii(__m128i data)
+{
+    const __m128i nonAscii = _mm_and_si128(data, _mm_set1_epi16(short(0xff80)));
+    return _mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) == 0xffff;
+}
+
+// returns all bits set for the characters in [first, last] and 0 for the others
+static inline __m128i simdInRange(__m128i data, ushort first, ushort last)
+{
+    return _mm_and_si128(_mm_cmpgt_epi16(data, _mm_set1_epi16(first - 1)),
+                         _mm_cmplt_epi16(data, _mm_set1_epi16(last + 1)));
+}
+
+// returns 0x20 for the characters in [first, last] and 0 for the others
+static inline __m128i simdCaseBit(__m128i data, ushort first, ushort last)
+{
+    return _mm_and_si128(simdInRange(data, first, last), _mm_set1_epi16(0x20));
+}
+
+static inline __m128i simdFoldAsciiCase(__m128i data)
+{
+    return _mm_or_si128(data, simdCaseBit(data, 'A', 'Z'));
+}
+
+// Advances a and b over the blocks in which both strings are US-ASCII and
+// equal up to case.
+static inline void simdSkipEqualAsciiCaseInsensitive(const ushort *&a, const ushort *&b, const ushort *e)
+{
+    for ( ; e - a >= 8; a += 8, b += 8) {
+        const __m128i da = _mm_loadu_si128((const __m128i *)a);
+        const __m128i db = _mm_loadu_si128((const __m128i *)b);
+        if (!simdIsAscii(_mm_or_si128(da, db)))
+            return;
+        const __m128i equal = _mm_cmpeq_epi16(simdFoldAsciiCase(da), simdFoldAsciiCase(db));
+        if (_mm_movemask_epi8(equal) != 0xffff)
+            return;
+    }
+}
+
+static inline void simdSkipEqualAsciiCaseInsensitive(const ushort *&a, const uchar *&b, const ushort *e)
+{
+    for ( ; e - a >= 8; a += 8, b += 8) {
+        const __m128i da = _mm_loadu_si128((const __m128i *)a);
+        const __m128i db = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)b), _mm_setzero_si128());
+        if (!simdIsAscii(_mm_or_si128(da, db)))
+            return;
+        const __m128i equal = _mm_cmpeq_epi16(simdFoldAsciiCase(da), simdFoldAsciiCase(db));
+        if (_mm_movemask_epi8(equal) != 0xffff)
+            return;
+    }
+}
+
+// Advances src over the US-ASCII blocks that contain no character in
+// [first, last], i.e. that the case conversion leaves unchanged.
+static inline void simdSkipAsciiCase(const ushort *&src, const ushort *e, ushort first, ushort last)
+{
+    for ( ; e - src >= 8; src += 8) {
+        const __m128i data = _mm_loadu_si128((const __m128i *)src);
+        if (!simdIsAscii(data))
+            return;
+        if (_mm_movemask_epi8(simdInRange(data, first, last)))
+            return;
+    }
+}
+
+// Converts the US-ASCII blocks of src to dst, flipping the case of the
+// characters in [first, last].
+static inline void simdConvertAsciiCase(ushort *&dst, const ushort *&src, const ushort *e,
+                                        ushort first, ushort last)
+{
+    for ( ; e - src >= 8; src += 8, dst += 8) {
+        const __m128i data = _mm_loadu_si128((const __m128i *)src);
+        if (!simdIsAscii(data))
+            return;
+        _mm_storeu_si128((__m128i *)dst, _mm_xor_si128(data, simdCaseBit(data, first, last)));
+    }
+}
+#elif defined(__ARM_NEON__)
+// Refer to the documentation of the SSE2 implementation.
+// NEON has unsigned comparisons but no movemask, so the comparison results
+// are narrowed and checked as a 64-bit integer instead.
+static inline bool neonAllSet(uint16x8_t mask)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(mask)), 0) == ~Q_UINT64_C(0);
+}
+
+static inline bool neonAnySet(uint16x8_t mask)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(mask)), 0) != 0;
+}
+
+static inline bool simdIsAscii(uint16x8_t data)
+{
+    return !neonAnySet(vcgtq_u16(data, vdupq_n_u16(0x7f)));
+}
+
+static inline uint16x8_t simdInRange(uint16x8_t data, ushort first, ushort last)
+{
+    return vandq_u16(vcgeq_u16(data, vdupq_n_u16(first)), vcleq_u16(data, vdupq_n_u16(last)));
+}
+
+static inline uint16x8_t simdCaseBit(uint16x8_t data, ushort first, ushort last)
+{
+    return vandq_u16(simdInRange(data, first, last), vdupq_n_u16(0x20));
+}
+
+static inline uint16x8_t simdFoldAsciiCase(uint16x8_t data)
+{
+    return vorrq_u16(data, simdCaseBit(data, 'A', 'Z'));
+}
+
+static inline void simdSkipEqualAsciiCaseInsensitive(const ushort *&a, const ushort *&b, const ushort *e)
+{
+    for ( ; e - a >= 8; a += 8, b += 8) {
+        const uint16x8_t da = vld1q_u16(a);
+        const uint16x8_t db = vld1q_u16(b);
+        if (!simdIsAscii(vorrq_u16(da, db)))
+            return;
+        if (!neonAllSet(vceqq_u16(simdFoldAsciiCase(da), simdFoldAsciiCase(db))))
+            return;
+    }
+}
+
+static inline void simdSkipEqualAsciiCaseInsensitive(const ushort *&a, const uchar *&b, const ushort *e)
+{
+    for ( ; e - a >= 8; a += 8, b += 8) {
+        const uint16x8_t da = vld1q_u16(a);
+        const uint16x8_t db = vmovl_u8(vld1_u8(b));
+        if (!simdIsAscii(vorrq_u16(da, db)))
+            return;
+        if (!neonAllSet(vceqq_u16(simdFoldAsciiCase(da), simdFoldAsciiCase(db))))
+            return;
+    }
+}
+
+static inline void simdSkipAsciiCase(const ushort *&src, const ushort *e, ushort first, ushort last)
+{
+    for ( ; e - src >= 8; src += 8) {
+        const uint16x8_t data = vld1q_u16(src);
+        if (!simdIsAscii(data) || neonAnySet(simdInRange(data, first, last)))
+            return;
+    }
+}
+
+static inline void simdConvertAsciiCase(ushort *&dst, const ushort *&src, const ushort *e,
+                                        ushort first, ushort last)
+{
+    for ( ; e - src >= 8; src += 8, dst += 8) {
+        const uint16x8_t data = vld1q_u16(src);
+        if (!simdIsAscii(data))
+            return;
+        vst1q_u16(dst, veorq_u16(data, simdCaseBit(data, first, last)));
+    }
+}
+#endif
+
 // Unicode case-insensitive comparison
 static int ucstricmp(const ushort *a, const ushort *ae, const ushort *b, const ushort *be)
 {
@@ -140,7 +304,26 @@ static int ucstricmp(const ushort *a, const ushort *ae, const ushort *b, const u
 
     uint alast = 0;
     uint blast = 0;
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+    // don't retry the vector code before this point
+    const ushort *nextSimd = a;
+#endif
     while (a < e) {
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+        if (a >= nextSimd) {
+            const ushort *start = a;
+            simdSkipEqualAsciiCaseInsensitive(a, b, e);
+            if (a != start) {
+                // only US-ASCII was skipped, so there is no surrogate pair to
+                // complete
+                alast = a[-1];
+                blast = b[-1];
+                if (a == e)
+                    break;
+            }
+            nextSimd = a + 8;
+        }
+#endif
 //         qDebug() << hex << alast << blast;
 //         qDebug() << hex << "*a=" << *a << "alast=" << alast << "folded=" << foldCase (*a, alast);
 //         qDebug() << hex << "*b=" << *b << "blast=" << blast << "folded=" << foldCase (*b, blast);
@@ -173,7 +356,18 @@ static int ucstricmp(const ushort *a, const ushort *ae, const uchar *b, const uc
     if (be - b < ae - a)
         e = a + (be - b);
 
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+    const ushort *nextSimd = a;
+#endif
     while (a < e) {
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+        if (a >= nextSimd) {
+            simdSkipEqualAsciiCaseInsensitive(a, b, e);
+            if (a == e)
+                break;
+            nextSimd = a + 8;
+        }
+#endif
         int diff = foldCase(*a) - foldCase(*b);
         if ((diff))
             return diff;
@@ -725,6 +919,10 @@ const QString::Null QString::null = { };
     formats, the \e precision represents the maximum number of
     significant digits (trailing zeroes are omitted).
 
+    If the \e precision is QLocale::FloatingPointShortest, the number is
+    written with the fewest digits that read back as exactly the same
+    \c double, whichever of the formats is used.
+
     \section1 More Efficient String Construction
 
     Many strings are known at compile time. But the trivial
@@ -2558,12 +2756,18 @@ int qFindString(
     if (sl == 1)
         return findChar(haystack0, haystackLen, needle0[0], from, cs);
 
+    const int simdIdx = simd_find((const ushort *)haystack0, l, from, (const ushort *)needle0, sl, cs);
+    if (simdIdx != -1)
+        return simdIdx;
+    if (from > l - sl)
+        return -1;
+
     /*
         We use the Boyer-Moore algorithm in cases where the overhead
         for the skip table should pay off, otherwise we use a simple
         hash function.
     */
-    if (l > 500 && sl > 5)
+    if (l - from > 500 && sl > 5)
         return qFindStringBoyerMoore(haystack0, haystackLen, from,
             needle0, needleLen, cs);
 
@@ -2644,6 +2848,23 @@ int QString::indexOf(const QStringRef &str, int from, Qt::CaseSensitivity cs) co
     return qFindString(unicode(), length(), from, str.unicode(), str.length(), cs);
 }
 
+/*!
+    \since 5.3
+
+    \overload indexOf()
+
+    Returns the index position of the first occurrence of the string
+    view \a str in this string, searching forward from index
+    position \a from. Returns -1 if \a str is not found.
+
+    If \a cs is Qt::CaseSensitive (default), the search is case
+    sensitive; otherwise the search is case insensitive.
+*/
+int QString::indexOf(QStringView str, int from, Qt::CaseSensitivity cs) const
+{
+    return qFindString(unicode(), length(), from, str.unicode(), str.length(), cs);
+}
+
 static int lastIndexOfHelper(const ushort *haystack, int from, const ushort *needle, int sl, Qt::CaseSensitivity cs)
 {
     /*
@@ -3192,6 +3413,18 @@ int QString::count(const QStringRef &str, Qt::CaseSensitivity cs) const
     \sa indexOf(), count()
 */
 
+/*! \fn bool QString::contains(QStringView str, Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+    \since 5.3
+
+    Returns \c true if this string contains an occurrence of the string
+    view \a str; otherwise returns \c false.
+
+    If \a cs is Qt::CaseSensitive (default), the search is
+    case sensitive; otherwise the search is case insensitive.
+
+    \sa indexOf(), count()
+*/
+
 /*! \fn bool QString::contains(const QRegExp &rx) const
 
     \overload contains()
@@ -5007,6 +5240,16 @@ int QString::compare(QLatin1String other, Qt::CaseSensitivity cs) const
   is less than, equal to, or greater than \a ref.
 */
 
+/*!
+  \fn int QString::compare(QStringView view, Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+  \overload compare()
+  \since 5.3
+
+  Compares the string view, \a view, with the string and returns
+  an integer less than, equal to, or greater than zero if the string
+  is less than, equal to, or greater than \a view.
+*/
+
 /*!
     \internal
     \since 5.0
@@ -5292,72 +5535,120 @@ QString QString::rightJustified(int width, QChar fill, bool truncate) const
     return result;
 }
 
-/*!
-    Returns a lowercase copy of the string.
-
-    \snippet qstring/main.cpp 75
-
-    The case conversion will always happen in the 'C' locale. For locale dependent
-    case folding use QLocale::toLower()
+struct LowerCaseTraits
+{
+    static inline int caseDiff(const QUnicodeTables::Properties *prop) { return prop->lowerCaseDiff; }
+    static inline bool caseSpecial(const QUnicodeTables::Properties *prop) { return prop->lowerCaseSpecial; }
+    // the US-ASCII characters that change
+    enum { AsciiFirst = 'A', AsciiLast = 'Z' };
+};
 
-    \sa toUpper(), QLocale::toLower()
-*/
+struct CaseFoldTraits
+{
+    static inline int caseDiff(const QUnicodeTables::Properties *prop) { return prop->caseFoldDiff; }
+    static inline bool caseSpecial(const QUnicodeTables::Properties *prop) { return prop->caseFoldSpecial; }
+    enum { AsciiFirst = 'A', AsciiLast = 'Z' };
+};
 
-QString QString::toLower() const
+struct UpperCaseTraits
 {
-    const ushort *p = d->data();
-    if (!p)
-        return *this;
+    static inline int caseDiff(const QUnicodeTables::Properties *prop) { return prop->upperCaseDiff; }
+    static inline bool caseSpecial(const QUnicodeTables::Properties *prop) { return prop->upperCaseSpecial; }
+    enum { AsciiFirst = 'a', AsciiLast = 'z' };
+};
 
-    const ushort *e = p + d->size;
+template <typename Traits>
+static QString convertCase(const QString &str)
+{
+    const ushort *const begin = reinterpret_cast<const ushort *>(str.constData());
+    const ushort *const end = begin + str.size();
+    const ushort *p = begin;
+    const ushort *e = end;
     // this avoids out of bounds check in the loop
     while (e != p && QChar::isHighSurrogate(*(e - 1)))
         --e;
 
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+    // don't retry the vector code before this point
+    const ushort *nextSimd = p;
+#endif
     const QUnicodeTables::Properties *prop;
     while (p != e) {
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+        if (p >= nextSimd) {
+            simdSkipAsciiCase(p, e, Traits::AsciiFirst, Traits::AsciiLast);
+            if (p == e)
+                break;
+            nextSimd = p + 8;
+        }
+#endif
         if (QChar::isHighSurrogate(*p) && QChar::isLowSurrogate(p[1])) {
             ushort high = *p++;
             prop = qGetProp(QChar::surrogateToUcs4(high, *p));
         } else {
             prop = qGetProp(*p);
         }
-        if (prop->lowerCaseDiff) {
+        if (Traits::caseDiff(prop)) {
             if (QChar::isLowSurrogate(*p))
                 --p; // safe; diff is 0 for surrogates
-            QString s(d->size, Qt::Uninitialized);
-            memcpy(s.d->data(), d->data(), (p - d->data())*sizeof(ushort));
-            ushort *pp = s.d->data() + (p - d->data());
+            QString s(str.size(), Qt::Uninitialized);
+            ushort *pp = reinterpret_cast<ushort *>(s.data());
+            memcpy(pp, begin, (p - begin)*sizeof(ushort));
+            pp += p - begin;
             while (p != e) {
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+                if (p >= nextSimd) {
+                    simdConvertAsciiCase(pp, p, e, Traits::AsciiFirst, Traits::AsciiLast);
+                    if (p == e)
+                        break;
+                    nextSimd = p + 8;
+                }
+#endif
                 if (QChar::isHighSurrogate(*p) && QChar::isLowSurrogate(p[1])) {
                     *pp = *p++;
                     prop = qGetProp(QChar::surrogateToUcs4(*pp++, *p));
                 } else {
                     prop = qGetProp(*p);
                 }
-                if (prop->lowerCaseSpecial) {
-                    const ushort *specialCase = specialCaseMap + prop->lowerCaseDiff;
+                if (Traits::caseSpecial(prop)) {
+                    const ushort *specialCase = specialCaseMap + Traits::caseDiff(prop);
                     ushort length = *specialCase++;
-                    int pos = pp - s.d->data();
-                    s.resize(s.d->size + length - 1);
-                    pp = s.d->data() + pos;
+                    int pos = pp - reinterpret_cast<ushort *>(s.data());
+                    s.resize(s.size() + length - 1);
+                    pp = reinterpret_cast<ushort *>(s.data()) + pos;
                     while (length--)
                         *pp++ = *specialCase++;
                 } else {
-                    *pp++ = *p + prop->lowerCaseDiff;
+                    *pp++ = *p + Traits::caseDiff(prop);
                 }
                 ++p;
             }
 
             // this restores high surrogate parts eaten above, if any
-            while (e != d->data() + d->size)
+            while (e != end)
                 *pp++ = *e++;
 
             return s;
         }
         ++p;
     }
-    return *this;
+    return str;
+}
+
+/*!
+    Returns a lowercase copy of the string.
+
+    \snippet qstring/main.cpp 75
+
+    The case conversion will always happen in the 'C' locale. For locale dependent
+    case folding use QLocale::toLower()
+
+    \sa toUpper(), QLocale::toLower()
+*/
+
+QString QString::toLower() const
+{
+    return convertCase<LowerCaseTraits>(*this);
 }
 
 /*!
@@ -5366,66 +5657,7 @@ QString QString::toLower() const
 */
 QString QString::toCaseFolded() const
 {
-    const ushort *p = d->data();
-    if (!p)
-        return *this;
-
-    const ushort *e = p + d->size;
-    // this avoids out of bounds check in the loop
-    while (e != p && QChar::isHighSurrogate(*(e - 1)))
-        --e;
-
-    const QUnicodeTables::Properties *prop;
-    while (p != e) {
-        if (QChar::isHighSurrogate(*p) && QChar::isLowSurrogate(p[1])) {
-            ushort high = *p++;
-            prop = qGetProp(QChar::surrogateToUcs4(high, *p));
-        } else {
-            prop = qGetProp(*p);
-        }
-        if (prop->caseFoldDiff) {
-            if (QChar::isLowSurrogate(*p))
-                --p; // safe; diff is 0 for surrogates
-            QString s(d->size, Qt::Uninitialized);
-            memcpy(s.d->data(), d->data(), (p - d->data())*sizeof(ushort));
-            ushort *pp = s.d->data() + (p - d->data());
-            while (p != e) {
-                if (QChar::isHighSurrogate(*p) && QChar::isLowSurrogate(p[1])) {
-                    *pp = *p++;
-                    prop = qGetProp(QChar::surrogateToUcs4(*pp++, *p));
-                } else {
-                    prop = qGetProp(*p);
-                }
-                if (prop->caseFoldSpecial) {
-                    const ushort *specialCase = specialCaseMap + prop->caseFoldDiff;
-                    ushort length = *specialCase++;
-#if 0
-                    int pos = pp - s.d->data;
-                    s.resize(s.d->size + length - 1);
-                    pp = s.d->data + pos;
-                    while (length--)
-                        *pp++ = *specialCase++;
-#else
-                    //### we currently don't support full case foldings
-                    Q_ASSERT(length == 1);
-                    Q_UNUSED(length)
-                    *pp++ = *specialCase;
-#endif
-                } else {
-                    *pp++ = *p + prop->caseFoldDiff;
-                }
-                ++p;
-            }
-
-            // this restores high surrogate parts eaten above, if any
-            while (e != d->data() + d->size)
-                *pp++ = *e++;
-
-            return s;
-        }
-        ++p;
-    }
-    return *this;
+    return convertCase<CaseFoldTraits>(*this);
 }
 
 /*!
@@ -5440,59 +5672,7 @@ QString QString::toCaseFolded() const
 */
 QString QString::toUpper() const
 {
-    const ushort *p = d->data();
-    if (!p)
-        return *this;
-
-    const ushort *e = p + d->size;
-    // this avoids out of bounds check in the loop
-    while (e != p && QChar::isHighSurrogate(*(e - 1)))
-        --e;
-
-    const QUnicodeTables::Properties *prop;
-    while (p != e) {
-        if (QChar::isHighSurrogate(*p) && QChar::isLowSurrogate(p[1])) {
-            ushort high = *p++;
-            prop = qGetProp(QChar::surrogateToUcs4(high, *p));
-        } else {
-            prop = qGetProp(*p);
-        }
-        if (prop->upperCaseDiff) {
-            if (QChar::isLowSurrogate(*p))
-                --p; // safe; diff is 0 for surrogates
-            QString s(d->size, Qt::Uninitialized);
-            memcpy(s.d->data(), d->data(), (p - d->data())*sizeof(ushort));
-            ushort *pp = s.d->data() + (p - d->data());
-            while (p != e) {
-                if (QChar::isHighSurrogate(*p) && QChar::isLowSurrogate(p[1])) {
-                    *pp = *p++;
-                    prop = qGetProp(QChar::surrogateToUcs4(*pp++, *p));
-                } else {
-                    prop = qGetProp(*p);
-                }
-                if (prop->upperCaseSpecial) {
-                    const ushort *specialCase = specialCaseMap + prop->upperCaseDiff;
-                    ushort length = *specialCase++;
-                    int pos = pp - s.d->data();
-                    s.resize(s.d->size + length - 1);
-                    pp = s.d->data() + pos;
-                    while (length--)
-                        *pp++ = *specialCase++;
-                } else {
-                    *pp++ = *p + prop->upperCaseDiff;
-                }
-                ++p;
-            }
-
-            // this restores high surrogate parts eaten above, if any
-            while (e != d->data() + d->size)
-                *pp++ = *e++;
-
-            return s;
-        }
-        ++p;
-    }
-    return *this;
+    return convertCase<UpperCaseTraits>(*this);
 }
 
 // ### Qt 6: Consider whether this function shouldn't be removed See task 202871.
@@ -9755,6 +9935,688 @@ float QStringRef::toFloat(bool *ok) const
     return float(d);
 }
 
+/*!
+    \class QStringView
+    \inmodule QtCore
+    \since 5.3
+    \brief The QStringView class provides a non-owning view on a sequence of UTF-16 characters.
+    \reentrant
+    \ingroup tools
+    \ingroup string-processing
+
+    QStringView provides a read-only subset of the QString API that
+    operates on a pointer and a size, without reference counting and
+    without requiring the characters to be stored in a QString.
+
+    A QStringView can be constructed implicitly from a QString or a
+    QStringRef, so functions taking a QStringView accept both without
+    any conversion cost. It can also be built from any array of QChar or
+    \c ushort, such as a buffer on the stack or a memory-mapped file.
+    Slicing with left(), mid(), right() and trimmed() only adjusts the
+    pointer and the size, and the number conversion functions parse the
+    characters in place.
+
+    Calling toString() returns a copy of the data as a real QString
+    instance.
+
+    \warning A QStringView is only valid as long as the characters it
+    refers to exist. If the underlying string is modified or deleted,
+    the view points to an invalid memory location.
+
+    \sa QStringRef, QByteArrayView
+*/
+
+/*!
+    \typedef QStringView::value_type
+    Typedef for QChar.
+*/
+
+/*!
+    \typedef QStringView::const_iterator
+    Typedef for \c{const QChar *}.
+*/
+
+/*!
+    \typedef QStringView::iterator
+    Typedef for \c{const QChar *}. A QStringView never modifies the
+    characters it refers to.
+*/
+
+/*!
+    \fn QStringView::QStringView()
+
+    Constructs a null string view.
+
+    \sa isNull()
+*/
+
+/*!
+    \fn QStringView::QStringView(const QChar *str, int len)
+
+    Constructs a view on the first \a len characters of \a str.
+*/
+
+/*!
+    \fn QStringView::QStringView(const ushort *str, int len)
+
+    Constructs a view on the first \a len UTF-16 code units of \a str.
+*/
+
+/*!
+    \fn QStringView::QStringView(const QString &str)
+
+    Constructs a view on the whole of \a str. The view is null if \a str
+    is null.
+*/
+
+/*!
+    \fn QStringView::QStringView(const QStringRef &str)
+
+    Constructs a view on the characters referenced by \a str.
+*/
+
+/*!
+    \fn int QStringView::size() const
+
+    Returns the number of characters in the view.
+*/
+
+/*!
+    \fn int QStringView::length() const
+
+    Same as size().
+*/
+
+/*!
+    \fn bool QStringView::isEmpty() const
+
+    Returns \c true if the view has no characters; otherwise returns
+    \c false.
+*/
+
+/*!
+    \fn bool QStringView::isNull() const
+
+    Returns \c true if the view does not refer to any data; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn const QChar *QStringView::unicode() const
+
+    Returns a pointer to the first character of the view. The data is
+    not '\\0'-terminated.
+*/
+
+/*!
+    \fn const QChar *QStringView::data() const
+
+    Same as unicode().
+*/
+
+/*!
+    \fn const QChar *QStringView::constData() const
+
+    Same as unicode().
+*/
+
+/*!
+    \fn const ushort *QStringView::utf16() const
+
+    Returns the data of the view as UTF-16 code units. The data is not
+    '\\0'-terminated.
+*/
+
+/*!
+    \fn const QChar QStringView::at(int i) const
+
+    Returns the character at index position \a i. \a i must be a valid
+    index position in the view.
+*/
+
+/*!
+    \fn const QChar QStringView::operator[](int i) const
+
+    Same as at(\a i).
+*/
+
+/*!
+    \fn QStringView::const_iterator QStringView::begin() const
+
+    Returns an STL-style iterator pointing to the first character in
+    the view.
+*/
+
+/*!
+    \fn QStringView::const_iterator QStringView::cbegin() const
+
+    Same as begin().
+*/
+
+/*!
+    \fn QStringView::const_iterator QStringView::end() const
+
+    Returns an STL-style iterator pointing to the imaginary character
+    after the last character in the view.
+*/
+
+/*!
+    \fn QStringView::const_iterator QStringView::cend() const
+
+    Same as end().
+*/
+
+/*!
+    \fn void QStringView::truncate(int pos)
+
+    Shrinks the view to the first \a pos characters. If \a pos is
+    beyond the end of the view, nothing happens.
+*/
+
+/*!
+    \fn void QStringView::chop(int n)
+
+    Removes \a n characters from the end of the view. If \a n is
+    greater than size(), the result is an empty view.
+*/
+
+/*!
+    \fn bool QStringView::contains(QChar ch, Qt::CaseSensitivity cs) const
+
+    Returns \c true if the view contains an occurrence of the character
+    \a ch; otherwise returns \c false.
+*/
+
+/*!
+    \fn bool QStringView::contains(QLatin1String str, Qt::CaseSensitivity cs) const
+    \overload contains()
+*/
+
+/*!
+    \fn bool QStringView::contains(QStringView str, Qt::CaseSensitivity cs) const
+    \overload contains()
+*/
+
+/*!
+    \fn int QStringView::compare(QStringView other, Qt::CaseSensitivity cs) const
+
+    Compares the view with \a other and returns an integer less than,
+    equal to, or greater than zero if the view is less than, equal to,
+    or greater than \a other.
+
+    If \a cs is Qt::CaseSensitive, the comparison is case sensitive;
+    otherwise the comparison is case insensitive.
+*/
+
+/*!
+    \fn int QStringView::compare(QLatin1String other, Qt::CaseSensitivity cs) const
+    \overload compare()
+*/
+
+/*!
+    Returns a view on the \a n leftmost characters.
+
+    If \a n is greater than size() or less than zero, the whole view is
+    returned.
+
+    \sa right(), mid()
+*/
+QStringView QStringView::left(int n) const
+{
+    if (uint(n) >= uint(m_size))
+        return *this;
+    return QStringView(m_data, n);
+}
+
+/*!
+    Returns a view on the \a n rightmost characters.
+
+    If \a n is greater than size() or less than zero, the whole view is
+    returned.
+
+    \sa left(), mid()
+*/
+QStringView QStringView::right(int n) const
+{
+    if (uint(n) >= uint(m_size))
+        return *this;
+    return QStringView(m_data + m_size - n, n);
+}
+
+/*!
+    Returns a view on \a n characters starting at position \a pos.
+
+    If \a pos exceeds size(), a null view is returned. If \a n is -1 or
+    extends past the end of the view, the view up to the end is
+    returned.
+
+    \sa left(), right()
+*/
+QStringView QStringView::mid(int pos, int n) const
+{
+    if (pos > m_size)
+        return QStringView();
+    if (pos < 0) {
+        if (n < 0 || n + pos >= m_size)
+            return *this;
+        if (n + pos <= 0)
+            return QStringView();
+        n += pos;
+        pos = 0;
+    } else if (uint(n) > uint(m_size - pos)) {
+        n = m_size - pos;
+    }
+    return QStringView(m_data + pos, n);
+}
+
+/*!
+    Returns a view with the whitespace at the start and the end
+    removed. No characters are copied.
+
+    \sa QString::trimmed()
+*/
+QStringView QStringView::trimmed() const
+{
+    if (m_size == 0 || m_data == 0)
+        return *this;
+    int start = 0;
+    int end = m_size - 1;
+    while (start <= end && m_data[start].isSpace())
+        start++;
+    if (start <= end) {
+        while (end && m_data[end].isSpace())
+            end--;
+    }
+    return QStringView(m_data + start, end - start + 1);
+}
+
+/*!
+    Returns the index position of the first occurrence of the character
+    \a ch in the view, searching forward from index position \a from.
+    Returns -1 if \a ch is not found.
+
+    If \a cs is Qt::CaseSensitive (default), the search is case
+    sensitive; otherwise the search is case insensitive.
+*/
+int QStringView::indexOf(QChar ch, int from, Qt::CaseSensitivity cs) const
+{
+    return findChar(m_data, m_size, ch, from, cs);
+}
+
+/*!
+    \overload indexOf()
+*/
+int QStringView::indexOf(QLatin1String str, int from, Qt::CaseSensitivity cs) const
+{
+    return qt_find_latin1_string(m_data, m_size, str, from, cs);
+}
+
+/*!
+    \overload indexOf()
+*/
+int QStringView::indexOf(QStringView str, int from, Qt::CaseSensitivity cs) const
+{
+    return qFindString(m_data, m_size, from, str.m_data, str.m_size, cs);
+}
+
+/*!
+    Returns the index position of the last occurrence of the character
+    \a ch in the view, searching backward from index position \a from.
+    If \a from is -1 (default), the search starts at the last character.
+    Returns -1 if \a ch is not found.
+*/
+int QStringView::lastIndexOf(QChar ch, int from, Qt::CaseSensitivity cs) const
+{
+    return qt_last_index_of(m_data, m_size, ch, from, cs);
+}
+
+/*!
+    Returns \c true if the view starts with \a str; otherwise returns
+    \c false.
+
+    If \a cs is Qt::CaseSensitive (default), the search is case
+    sensitive; otherwise the search is case insensitive.
+
+    \sa endsWith()
+*/
+bool QStringView::startsWith(QStringView str, Qt::CaseSensitivity cs) const
+{
+    return qt_starts_with(m_data, m_size, str.m_data, str.m_size, cs);
+}
+
+/*!
+    \overload startsWith()
+*/
+bool QStringView::startsWith(QLatin1String str, Qt::CaseSensitivity cs) const
+{
+    return qt_starts_with(m_data, m_size, str, cs);
+}
+
+/*!
+    \overload startsWith()
+*/
+bool QStringView::startsWith(QChar ch, Qt::CaseSensitivity cs) const
+{
+    if (!m_size)
+        return false;
+    if (cs == Qt::CaseSensitive)
+        return m_data[0] == ch;
+    return foldCase(m_data[0].unicode()) == foldCase(ch.unicode());
+}
+
+/*!
+    Returns \c true if the view ends with \a str; otherwise returns
+    \c false.
+
+    If \a cs is Qt::CaseSensitive (default), the search is case
+    sensitive; otherwise the search is case insensitive.
+
+    \sa startsWith()
+*/
+bool QStringView::endsWith(QStringView str, Qt::CaseSensitivity cs) const
+{
+    return qt_ends_with(m_data, m_size, str.m_data, str.m_size, cs);
+}
+
+/*!
+    \overload endsWith()
+*/
+bool QStringView::endsWith(QLatin1String str, Qt::CaseSensitivity cs) const
+{
+    return qt_ends_with(m_data, m_size, str, cs);
+}
+
+/*!
+    \overload endsWith()
+*/
+bool QStringView::endsWith(QChar ch, Qt::CaseSensitivity cs) const
+{
+    if (!m_size)
+        return false;
+    if (cs == Qt::CaseSensitive)
+        return m_data[m_size - 1] == ch;
+    return foldCase(m_data[m_size - 1].unicode()) == foldCase(ch.unicode());
+}
+
+/*!
+    Returns a copy of the viewed characters as a QString. A null view
+    gives a null string.
+*/
+QString QStringView::toString() const
+{
+    if (!m_data)
+        return QString();
+    return QString(m_data, m_size);
+}
+
+/*!
+    Returns a Latin-1 representation of the view as a QByteArray.
+
+    \sa QString::toLatin1()
+*/
+QByteArray QStringView::toLatin1() const
+{
+    return toLatin1_helper(m_data, m_size);
+}
+
+/*!
+    Returns a UTF-8 representation of the view as a QByteArray.
+
+    \sa QString::toUtf8()
+*/
+QByteArray QStringView::toUtf8() const
+{
+    if (isNull())
+        return QByteArray();
+    return QUtf8::convertFromUnicode(m_data, m_size, 0);
+}
+
+/*!
+    Returns the local 8-bit representation of the view as a QByteArray.
+
+    \sa QString::toLocal8Bit()
+*/
+QByteArray QStringView::toLocal8Bit() const
+{
+#ifndef QT_NO_TEXTCODEC
+    QTextCodec *localeCodec = QTextCodec::codecForLocale();
+    if (localeCodec)
+        return localeCodec->fromUnicode(m_data, m_size);
+#endif // QT_NO_TEXTCODEC
+    return toLatin1();
+}
+
+/*!
+    Returns the view converted to a \c{long long} using base \a base,
+    which is 10 by default and must be between 2 and 36, or 0. Returns 0
+    if the conversion fails.
+
+    If a conversion error occurs, *\a{ok} is set to false; otherwise
+    *\a{ok} is set to true.
+
+    The conversion always happens in the 'C' locale and does not
+    allocate. For locale dependent conversion use QLocale::toLongLong().
+
+    \sa QString::toLongLong()
+*/
+qlonglong QStringView::toLongLong(bool *ok, int base) const
+{
+#if defined(QT_CHECK_RANGE)
+    if (base != 0 && (base < 2 || base > 36)) {
+        qWarning("QStringView::toLongLong: Invalid base (%d)", base);
+        base = 10;
+    }
+#endif
+
+    QLocale c_locale(QLocale::C);
+    return c_locale.d->stringToLongLong(*this, base, ok, QLocalePrivate::FailOnGroupSeparators);
+}
+
+/*!
+    Returns the view converted to an \c{unsigned long long} using base
+    \a base, which is 10 by default and must be between 2 and 36, or 0.
+    Returns 0 if the conversion fails.
+
+    \sa toLongLong(), QString::toULongLong()
+*/
+qulonglong QStringView::toULongLong(bool *ok, int base) const
+{
+#if defined(QT_CHECK_RANGE)
+    if (base != 0 && (base < 2 || base > 36)) {
+        qWarning("QStringView::toULongLong: Invalid base (%d)", base);
+        base = 10;
+    }
+#endif
+
+    QLocale c_locale(QLocale::C);
+    return c_locale.d->stringToUnsLongLong(*this, base, ok, QLocalePrivate::FailOnGroupSeparators);
+}
+
+/*!
+    Returns the view converted to an \c int using base \a base.
+    Returns 0 if the conversion fails.
+
+    \sa toLongLong(), QString::toInt()
+*/
+int QStringView::toInt(bool *ok, int base) const
+{
+    qint64 v = toLongLong(ok, base);
+    if (v < INT_MIN || v > INT_MAX) {
+        if (ok)
+            *ok = false;
+        v = 0;
+    }
+    return int(v);
+}
+
+/*!
+    Returns the view converted to an \c{unsigned int} using base \a base.
+    Returns 0 if the conversion fails.
+
+    \sa toULongLong(), QString::toUInt()
+*/
+uint QStringView::toUInt(bool *ok, int base) const
+{
+    quint64 v = toULongLong(ok, base);
+    if (v > UINT_MAX) {
+        if (ok)
+            *ok = false;
+        v = 0;
+    }
+    return uint(v);
+}
+
+/*!
+    Returns the view converted to a \c short using base \a base.
+    Returns 0 if the conversion fails.
+
+    \sa toLongLong(), QString::toShort()
+*/
+short QStringView::toShort(bool *ok, int base) const
+{
+    qint64 v = toLongLong(ok, base);
+    if (v < SHRT_MIN || v > SHRT_MAX) {
+        if (ok)
+            *ok = false;
+        v = 0;
+    }
+    return short(v);
+}
+
+/*!
+    Returns the view converted to an \c{unsigned short} using base
+    \a base. Returns 0 if the conversion fails.
+
+    \sa toULongLong(), QString::toUShort()
+*/
+ushort QStringView::toUShort(bool *ok, int base) const
+{
+    quint64 v = toULongLong(ok, base);
+    if (v > USHRT_MAX) {
+        if (ok)
+            *ok = false;
+        v = 0;
+    }
+    return ushort(v);
+}
+
+/*!
+    Returns the view converted to a \c double value. Returns 0.0 if the
+    conversion fails.
+
+    If a conversion error occurs, \c{*}\a{ok} is set to false;
+    otherwise \c{*}\a{ok} is set to true.
+
+    The conversion always happens in the 'C' locale and does not
+    allocate. For locale dependent conversion use QLocale::toDouble().
+
+    \sa QString::toDouble()
+*/
+double QStringView::toDouble(bool *ok) const
+{
+    QLocale c_locale(QLocale::C);
+    return c_locale.d->stringToDouble(*this, ok, QLocalePrivate::FailOnGroupSeparators);
+}
+
+/*!
+    Returns the view converted to a \c float value. Returns 0.0 if the
+    conversion fails.
+
+    \sa toDouble(), QString::toFloat()
+*/
+float QStringView::toFloat(bool *ok) const
+{
+    bool myOk;
+    double d = toDouble(&myOk);
+    if (!myOk) {
+        if (ok != 0)
+            *ok = false;
+        return 0.0;
+    }
+    if (qIsInf(d))
+        return float(d);
+    if (d > QT_MAX_FLOAT || d < -QT_MAX_FLOAT) {
+        if (ok != 0)
+            *ok = false;
+        return 0.0;
+    }
+    if (ok)
+        *ok = true;
+    return float(d);
+}
+
+/*!
+    \fn bool operator==(QStringView s1, QStringView s2)
+    \relates QStringView
+
+    Returns \c true if \a s1 is lexically equal to \a s2; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool operator!=(QStringView s1, QStringView s2)
+    \relates QStringView
+
+    Returns \c true if \a s1 is lexically not equal to \a s2; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool operator<(QStringView s1, QStringView s2)
+    \relates QStringView
+
+    Returns \c true if \a s1 is lexically less than \a s2; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool operator<=(QStringView s1, QStringView s2)
+    \relates QStringView
+
+    Returns \c true if \a s1 is lexically less than or equal to \a s2;
+    otherwise returns \c false.
+*/
+
+/*!
+    \fn bool operator>(QStringView s1, QStringView s2)
+    \relates QStringView
+
+    Returns \c true if \a s1 is lexically greater than \a s2; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn bool operator>=(QStringView s1, QStringView s2)
+    \relates QStringView
+
+    Returns \c true if \a s1 is lexically greater than or equal to \a s2;
+    otherwise returns \c false.
+*/
+
+/*!
+    \fn bool operator==(QStringView s1, QLatin1String s2)
+    \relates QStringView
+    \overload operator==()
+*/
+
+/*!
+    \fn bool operator!=(QStringView s1, QLatin1String s2)
+    \relates QStringView
+    \overload operator!=()
+*/
+
+/*!
+    \fn bool operator==(QLatin1String s1, QStringView s2)
+    \relates QStringView
+    \overload operator==()
+*/
+
+/*!
+    \fn bool operator!=(QLatin1String s1, QStringView s2)
+    \relates QStringView
+    \overload operator!=()
+*/
+
 /*!
     \obsolete
     \fn QString Qt::escape(const QString &plain)
@@ -81,6 +81,7 @@ class QString;
 class QStringList;
 class QTextCodec;
 class QStringRef;
+class QStringView;
 template <typename T> class QVector;
 
 class QLatin1String
@@ -309,6 +310,7 @@ public:
     int indexOf(const QString &s, int from = 0, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     int indexOf(QLatin1String s, int from = 0, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     int indexOf(const QStringRef &s, int from = 0, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    int indexOf(QStringView s, int from = 0, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     int lastIndexOf(QChar c, int from = -1, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     int lastIndexOf(const QString &s, int from = -1, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     int lastIndexOf(QLatin1String s, int from = -1, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
@@ -317,6 +319,7 @@ public:
     inline bool contains(QChar c, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     inline bool contains(const QString &s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     inline bool contains(const QStringRef &s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    inline bool contains(QStringView s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     int count(QChar c, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     int count(const QString &s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     int count(const QStringRef &s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
@@ -521,6 +524,7 @@ public:
     int compare(const QStringRef &s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
     static int compare(const QString &s1, const QStringRef &s2,
                        Qt::CaseSensitivity = Qt::CaseSensitive);
+    int compare(QStringView s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
 
     int localeAwareCompare(const QString& s) const;
     static int localeAwareCompare(const QString& s1, const QString& s2)
@@ -722,6 +726,7 @@ private:
     friend class QCharRef;
     friend class QTextCodec;
     friend class QStringRef;
+    friend class QStringView;
     friend class QByteArray;
     friend class QCollator;
     friend struct QAbstractConcatenable;
@@ -1408,6 +1413,118 @@ inline bool QStringRef::contains(QChar c, Qt::CaseSensitivity cs) const
 inline bool QStringRef::contains(const QStringRef &s, Qt::CaseSensitivity cs) const
 { return indexOf(s, 0, cs) != -1; }
 
+class Q_CORE_EXPORT QStringView {
+    const QChar *m_data;
+    int m_size;
+public:
+    typedef QChar value_type;
+    typedef const QChar *const_iterator;
+    typedef const_iterator iterator;
+
+    Q_DECL_CONSTEXPR inline QStringView() : m_data(0), m_size(0) {}
+    Q_DECL_CONSTEXPR inline QStringView(const QChar *str, int len) : m_data(str), m_size(len) {}
+    inline QStringView(const ushort *str, int len)
+        : m_data(reinterpret_cast<const QChar *>(str)), m_size(len) {}
+    inline QStringView(const QString &str)
+        : m_data(str.isNull() ? 0 : str.constData()), m_size(str.size()) {}
+    inline QStringView(const QStringRef &str)
+        : m_data(str.isNull() ? 0 : str.constData()), m_size(str.size()) {}
+
+    inline int size() const { return m_size; }
+    inline int length() const { return m_size; }
+    inline bool isEmpty() const { return m_size == 0; }
+    inline bool isNull() const { return m_data == 0; }
+
+    inline const QChar *unicode() const { return m_data; }
+    inline const QChar *data() const { return m_data; }
+    inline const QChar *constData() const { return m_data; }
+    inline const ushort *utf16() const { return reinterpret_cast<const ushort *>(m_data); }
+
+    inline const QChar at(int i) const
+        { Q_ASSERT(uint(i) < uint(size())); return m_data[i]; }
+    inline const QChar operator[](int i) const { return at(i); }
+
+    inline const_iterator begin() const { return m_data; }
+    inline const_iterator cbegin() const { return m_data; }
+    inline const_iterator end() const { return m_data + m_size; }
+    inline const_iterator cend() const { return m_data + m_size; }
+
+    QStringView left(int n) const Q_REQUIRED_RESULT;
+    QStringView right(int n) const Q_REQUIRED_RESULT;
+    QStringView mid(int pos, int n = -1) const Q_REQUIRED_RESULT;
+    QStringView trimmed() const Q_REQUIRED_RESULT;
+
+    inline void truncate(int pos) { if (pos < m_size) m_size = qMax(pos, 0); }
+    inline void chop(int n) { if (n > 0) m_size = qMax(m_size - n, 0); }
+
+    int indexOf(QChar ch, int from = 0, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    int indexOf(QLatin1String str, int from = 0, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    int indexOf(QStringView str, int from = 0, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    int lastIndexOf(QChar ch, int from = -1, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+
+    inline bool contains(QChar ch, Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+    { return indexOf(ch, 0, cs) != -1; }
+    inline bool contains(QLatin1String str, Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+    { return indexOf(str, 0, cs) != -1; }
+    inline bool contains(QStringView str, Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+    { return indexOf(str, 0, cs) != -1; }
+
+    bool startsWith(QStringView s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    bool startsWith(QLatin1String s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    bool startsWith(QChar c, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+
+    bool endsWith(QStringView s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    bool endsWith(QLatin1String s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    bool endsWith(QChar c, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+
+    inline int compare(QStringView s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+    { return QString::compare_helper(m_data, m_size, s.m_data, s.m_size, cs); }
+    inline int compare(QLatin1String s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const
+    { return QString::compare_helper(m_data, m_size, s, cs); }
+
+    QString toString() const Q_REQUIRED_RESULT;
+    QByteArray toLatin1() const Q_REQUIRED_RESULT;
+    QByteArray toUtf8() const Q_REQUIRED_RESULT;
+    QByteArray toLocal8Bit() const Q_REQUIRED_RESULT;
+
+    short  toShort(bool *ok = 0, int base = 10) const;
+    ushort toUShort(bool *ok = 0, int base = 10) const;
+    int toInt(bool *ok = 0, int base = 10) const;
+    uint toUInt(bool *ok = 0, int base = 10) const;
+    qlonglong toLongLong(bool *ok = 0, int base = 10) const;
+    qulonglong toULongLong(bool *ok = 0, int base = 10) const;
+    float toFloat(bool *ok = 0) const;
+    double toDouble(bool *ok = 0) const;
+};
+Q_DECLARE_TYPEINFO(QStringView, Q_PRIMITIVE_TYPE);
+
+inline bool operator==(QStringView s1, QStringView s2)
+{ return s1.size() == s2.size() && s1.compare(s2) == 0; }
+inline bool operator!=(QStringView s1, QStringView s2)
+{ return !(s1 == s2); }
+inline bool operator<(QStringView s1, QStringView s2)
+{ return s1.compare(s2) < 0; }
+inline bool operator>(QStringView s1, QStringView s2)
+{ return s1.compare(s2) > 0; }
+inline bool operator<=(QStringView s1, QStringView s2)
+{ return s1.compare(s2) <= 0; }
+inline bool operator>=(QStringView s1, QStringView s2)
+{ return s1.compare(s2) >= 0; }
+
+inline bool operator==(QStringView s1, QLatin1String s2)
+{ return s1.size() == s2.size() && s1.compare(s2) == 0; }
+inline bool operator!=(QStringView s1, QLatin1String s2)
+{ return !(s1 == s2); }
+inline bool operator==(QLatin1String s1, QStringView s2)
+{ return s2 == s1; }
+inline bool operator!=(QLatin1String s1, QStringView s2)
+{ return !(s2 == s1); }
+
+inline int QString::compare(QStringView s, Qt::CaseSensitivity cs) const
+{ return QString::compare_helper(constData(), length(), s.constData(), s.length(), cs); }
+inline bool QString::contains(QStringView s, Qt::CaseSensitivity cs) const
+{ return indexOf(s, 0, cs) != -1; }
+
 namespace Qt {
 #if QT_DEPRECATED_SINCE(5, 0)
 QT_DEPRECATED inline QString escape(const QString &plain) {
@@ -40,6 +40,7 @@
 ****************************************************************************/
 
 #include "qstringmatcher.h"
+#include "qsimd_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -122,6 +123,84 @@ static inline int bm_find(const ushort *uc, uint l, int index, const ushort *puc
     return -1; // not found
 }
 
+#if defined(__SSE2__)
+static inline uint lowestBit(uint mask)
+{
+    Q_ASSERT(mask);
+#if defined(Q_CC_GNU)
+    return __builtin_ctz(mask);
+#else
+    uint i = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+static int findUShortsSse2(const ushort *uc, int l, int &index, const ushort *puc, int pl)
+{
+    // Compare the first and the last character of the pattern against eight
+    // candidate positions at a time; only the positions where both match
+    // are compared in full. Every character sets two bits in the mask.
+    const __m128i first = _mm_set1_epi16(puc[0]);
+    const __m128i last = _mm_set1_epi16(puc[pl - 1]);
+    for ( ; index + pl - 1 + 8 <= l; index += 8) {
+        const __m128i blockFirst = _mm_loadu_si128((const __m128i *)(uc + index));
+        const __m128i blockLast = _mm_loadu_si128((const __m128i *)(uc + index + pl - 1));
+        uint mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(blockFirst, first),
+                                                    _mm_cmpeq_epi16(blockLast, last)));
+        while (mask) {
+            const int candidate = index + lowestBit(mask) / 2;
+            if (pl <= 2 || memcmp(uc + candidate + 1, puc + 1, (pl - 2) * sizeof(ushort)) == 0)
+                return candidate;
+            mask &= mask - 1;
+            mask &= mask - 1;
+        }
+    }
+    return -1;
+}
+#endif
+
+/*
+    Searches for the pattern \a puc with the SIMD instructions available,
+    starting at \a index. If there is no match, \a index is advanced to the
+    first position that still has to be searched with bm_find().
+*/
+static inline int simd_find(const ushort *uc, int l, int &index, const ushort *puc, int pl,
+                            Qt::CaseSensitivity cs)
+{
+    if (pl == 0 || cs != Qt::CaseSensitive)
+        return -1;
+#if defined(QT_COMPILER_SUPPORTS_AVX2) && !defined(QT_BOOTSTRAPPED)
+    if (qCpuHasFeature(AVX2)) {
+        extern int qt_find_ushorts_avx2(const ushort *uc, int l, int &index, const ushort *puc, int pl);
+        const int idx = qt_find_ushorts_avx2(uc, l, index, puc, pl);
+        if (idx != -1)
+            return idx;
+    }
+#endif
+#if defined(__SSE2__)
+    return findUShortsSse2(uc, l, index, puc, pl);
+#else
+    Q_UNUSED(uc);
+    Q_UNUSED(l);
+    Q_UNUSED(index);
+    Q_UNUSED(puc);
+    return -1;
+#endif
+}
+
+static inline int simd_bm_find(const ushort *uc, int l, int index, const ushort *puc, int pl,
+                               const uchar *skiptable, Qt::CaseSensitivity cs)
+{
+    const int idx = simd_find(uc, l, index, puc, pl, cs);
+    if (idx != -1)
+        return idx;
+    return bm_find(uc, l, index, puc, pl, skiptable, cs);
+}
+
 /*!
     \class QStringMatcher
     \inmodule QtCore
@@ -184,6 +263,23 @@ QStringMatcher::QStringMatcher(const QChar *uc, int len, Qt::CaseSensitivity cs)
     bm_init_skiptable((const ushort *)p.uc, len, p.q_skiptable, cs);
 }
 
+/*!
+    \since 5.3
+
+    Constructs a string matcher that will search for the characters
+    viewed by \a pattern, with case sensitivity \a cs. The pattern is
+    copied, so \a pattern does not need to outlive the matcher.
+
+    Call indexIn() to perform a search.
+*/
+QStringMatcher::QStringMatcher(QStringView pattern, Qt::CaseSensitivity cs)
+    : d_ptr(0), q_pattern(pattern.toString()), q_cs(cs)
+{
+    p.uc = q_pattern.unicode();
+    p.len = q_pattern.size();
+    bm_init_skiptable((const ushort *)p.uc, p.len, p.q_skiptable, cs);
+}
+
 /*!
     Copies the \a other string matcher to this string matcher.
 */
@@ -271,9 +367,9 @@ int QStringMatcher::indexIn(const QString &str, int from) const
 {
     if (from < 0)
         from = 0;
-    return bm_find((const ushort *)str.unicode(), str.size(), from,
-                   (const ushort *)p.uc, p.len,
-                   p.q_skiptable, q_cs);
+    return simd_bm_find((const ushort *)str.unicode(), str.size(), from,
+                        (const ushort *)p.uc, p.len,
+                        p.q_skiptable, q_cs);
 }
 
 /*!
@@ -292,9 +388,29 @@ int QStringMatcher::indexIn(const QChar *str, int length, int from) const
 {
     if (from < 0)
         from = 0;
-    return bm_find((const ushort *)str, length, from,
-                   (const ushort *)p.uc, p.len,
-                   p.q_skiptable, q_cs);
+    return simd_bm_find((const ushort *)str, length, from,
+                        (const ushort *)p.uc, p.len,
+                        p.q_skiptable, q_cs);
+}
+
+/*!
+    \since 5.3
+
+    Searches the string view \a str from character position \a from
+    (default 0, i.e. from the first character), for the string
+    pattern() that was set in the constructor or in the most recent
+    call to setPattern(). Returns the position where the pattern()
+    matched in \a str, or -1 if no match was found.
+
+    \sa setPattern(), setCaseSensitivity()
+*/
+int QStringMatcher::indexIn(QStringView str, int from) const
+{
+    if (from < 0)
+        from = 0;
+    return simd_bm_find(str.utf16(), str.size(), from,
+                        (const ushort *)p.uc, p.len,
+                        p.q_skiptable, q_cs);
 }
 
 /*!
@@ -313,10 +429,14 @@ int qFindStringBoyerMoore(
     const QChar *haystack, int haystackLen, int haystackOffset,
     const QChar *needle, int needleLen, Qt::CaseSensitivity cs)
 {
-    uchar skiptable[256];
-    bm_init_skiptable((const ushort *)needle, needleLen, skiptable, cs);
     if (haystackOffset < 0)
         haystackOffset = 0;
+    const int idx = simd_find((const ushort *)haystack, haystackLen, haystackOffset,
+                              (const ushort *)needle, needleLen, cs);
+    if (idx != -1)
+        return idx;
+    uchar skiptable[256];
+    bm_init_skiptable((const ushort *)needle, needleLen, skiptable, cs);
     return bm_find((const ushort *)haystack, haystackLen, haystackOffset,
                    (const ushort *)needle, needleLen, skiptable, cs);
 }
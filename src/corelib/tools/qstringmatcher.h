@@ -57,6 +57,8 @@ public:
                    Qt::CaseSensitivity cs = Qt::CaseSensitive);
     QStringMatcher(const QChar *uc, int len,
                    Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    explicit QStringMatcher(QStringView pattern,
+                   Qt::CaseSensitivity cs = Qt::CaseSensitive);
     QStringMatcher(const QStringMatcher &other);
     ~QStringMatcher();
 
@@ -67,6 +69,7 @@ public:
 
     int indexIn(const QString &str, int from = 0) const;
     int indexIn(const QChar *str, int length, int from = 0) const;
+    int indexIn(QStringView str, int from = 0) const;
     QString pattern() const;
     inline Qt::CaseSensitivity caseSensitivity() const { return q_cs; }
 
@@ -2,6 +2,7 @@
 
 HEADERS +=  \
         tools/qalgorithms.h \
+        tools/qarena.h \
         tools/qarraydata.h \
         tools/qarraydataops.h \
         tools/qarraydatapointer.h \
@@ -21,6 +22,8 @@ HEADERS +=  \
         tools/qdatetime_p.h \
         tools/qdatetimeparser_p.h \
         tools/qeasingcurve.h \
+        tools/qflathash.h \
+        tools/qflatmap.h \
         tools/qfreelist_p.h \
         tools/qhash.h \
         tools/qiterator.h \
@@ -53,6 +56,8 @@ HEADERS +=  \
         tools/qset.h \
         tools/qsimd_p.h \
         tools/qsize.h \
+        tools/qsmallbytearray.h \
+        tools/qsmallstring.h \
         tools/qstack.h \
         tools/qstring.h \
         tools/qstringbuilder.h \
@@ -71,6 +76,7 @@ HEADERS +=  \
 
 
 SOURCES += \
+        tools/qarena.cpp \
         tools/qarraydata.cpp \
         tools/qbitarray.cpp \
         tools/qbytearray.cpp \
@@ -83,6 +89,7 @@ SOURCES += \
         tools/qdatetimeparser.cpp \
         tools/qeasingcurve.cpp \
         tools/qelapsedtimer.cpp \
+        tools/qflathash.cpp \
         tools/qfreelist.cpp \
         tools/qhash.cpp \
         tools/qline.cpp \
@@ -103,6 +110,8 @@ SOURCES += \
         tools/qsharedpointer.cpp \
         tools/qsimd.cpp \
         tools/qsize.cpp \
+        tools/qsmallbytearray.cpp \
+        tools/qsmallstring.cpp \
         tools/qstring.cpp \
         tools/qstringbuilder.cpp \
         tools/qstringlist.cpp \
@@ -129,6 +138,11 @@ else:win32:SOURCES += tools/qelapsedtimer_win.cpp tools/qlocale_win.cpp tools/qt
 else:integrity:SOURCES += tools/qelapsedtimer_unix.cpp tools/qlocale_unix.cpp
 else:SOURCES += tools/qelapsedtimer_generic.cpp
 
+AVX2_SOURCES += tools/qbytearraymatcher_avx2.cpp \
+                tools/qcryptographichash_avx2.cpp \
+                tools/qstringmatcher_avx2.cpp
+SHA_SOURCES += tools/qcryptographichash_sha.cpp
+
 contains(QT_CONFIG, zlib) {
     include($$PWD/../../3rdparty/zlib.pri)
     corelib_zlib_headers.files = $$PWD/../../3rdparty/zlib/zconf.h\
@@ -554,6 +554,8 @@ QAbstractSocketPrivate::QAbstractSocketPrivate()
       cachedSocketDescriptor(-1),
       readBufferMaxSize(0),
       writeBuffer(QABSTRACTSOCKET_BUFFERSIZE),
+      sendFileOffset(0),
+      sendFileRemaining(0),
       isBuffered(false),
       blockingTimeout(30000),
       connectTimer(0),
@@ -599,6 +601,18 @@ void QAbstractSocketPrivate::resetSocketLayer()
         disconnectTimer->stop();
 }
 
+/*! \internal
+
+    Drops everything that is waiting to be written.
+*/
+void QAbstractSocketPrivate::clearWriteBuffer()
+{
+    writeBuffer.clear();
+    sendFileSource.clear();
+    sendFileOffset = 0;
+    sendFileRemaining = 0;
+}
+
 /*! \internal
 
     Initializes the socket layer to by of type \a type, using the
@@ -801,20 +815,20 @@ bool QAbstractSocketPrivate::canWriteNotification()
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::canWriteNotification() flushing");
 #endif
-    int tmp = writeBuffer.size();
+    qint64 tmp = pendingWriteSize();
     flush();
 
     if (socketEngine) {
 #if defined (Q_OS_WIN)
-        if (!writeBuffer.isEmpty())
+        if (pendingWriteSize())
             socketEngine->setWriteNotificationEnabled(true);
 #else
-        if (writeBuffer.isEmpty() && socketEngine->bytesToWrite() == 0)
+        if (!pendingWriteSize() && socketEngine->bytesToWrite() == 0)
             socketEngine->setWriteNotificationEnabled(false);
 #endif
     }
 
-    return (writeBuffer.size() < tmp);
+    return (pendingWriteSize() < tmp);
 }
 
 /*! \internal
@@ -847,7 +861,7 @@ void QAbstractSocketPrivate::connectionNotification()
 bool QAbstractSocketPrivate::flush()
 {
     Q_Q(QAbstractSocket);
-    if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
+    if (!socketEngine || !socketEngine->isValid() || (!pendingWriteSize()
         && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::flush() nothing to do: valid ? %s, writeBuffer.isEmpty() ? %s",
@@ -861,11 +875,24 @@ bool QAbstractSocketPrivate::flush()
         return false;
     }
 
-    int nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
+    qint64 written;
+    if (sendFileRemaining) {
+        // The file segment was queued first, so it goes out first.
+        if (!sendFileSource || !sendFileSource->isOpen()) {
+            socketError = QAbstractSocket::UnknownSocketError;
+            q->setErrorString(QAbstractSocket::tr("File closed before it was sent"));
+            emit q->error(socketError);
+            q->abort();
+            return false;
+        }
+        written = socketEngine->sendFile(sendFileSource, sendFileOffset, sendFileRemaining);
+    } else {
+        int nextSize = writeBuffer.nextDataBlockSize();
+        const char *ptr = writeBuffer.readPointer();
 
-    // Attempt to write it all in one chunk.
-    qint64 written = socketEngine->write(ptr, nextSize);
+        // Attempt to write it all in one chunk.
+        written = socketEngine->write(ptr, nextSize);
+    }
     if (written < 0) {
         socketError = socketEngine->error();
         q->setErrorString(socketEngine->errorString());
@@ -884,7 +911,14 @@ bool QAbstractSocketPrivate::flush()
 #endif
 
     // Remove what we wrote so far.
-    writeBuffer.free(written);
+    if (sendFileRemaining) {
+        sendFileOffset += written;
+        sendFileRemaining -= written;
+        if (!sendFileRemaining)
+            sendFileSource.clear();
+    } else {
+        writeBuffer.free(written);
+    }
     if (written > 0) {
         // Don't emit bytesWritten() recursively.
         if (!emittedBytesWritten) {
@@ -894,7 +928,7 @@ bool QAbstractSocketPrivate::flush()
         }
     }
 
-    if (writeBuffer.isEmpty() && socketEngine && socketEngine->isWriteNotificationEnabled()
+    if (!pendingWriteSize() && socketEngine && socketEngine->isWriteNotificationEnabled()
         && !socketEngine->bytesToWrite())
         socketEngine->setWriteNotificationEnabled(false);
     if (state == QAbstractSocket::ClosingState)
@@ -1596,7 +1630,7 @@ void QAbstractSocket::connectToHost(const QString &hostName, quint16 port,
     d->port = port;
     d->state = UnconnectedState;
     d->buffer.clear();
-    d->writeBuffer.clear();
+    d->clearWriteBuffer();
     d->abortCalled = false;
     d->closeCalled = false;
     d->pendingClose = false;
@@ -1692,9 +1726,9 @@ qint64 QAbstractSocket::bytesToWrite() const
 {
     Q_D(const QAbstractSocket);
 #if defined(QABSTRACTSOCKET_DEBUG)
-    qDebug("QAbstractSocket::bytesToWrite() == %i", d->writeBuffer.size());
+    qDebug("QAbstractSocket::bytesToWrite() == %lld", d->pendingWriteSize());
 #endif
-    return (qint64)d->writeBuffer.size();
+    return d->pendingWriteSize();
 }
 
 /*!
@@ -1833,7 +1867,7 @@ bool QAbstractSocket::setSocketDescriptor(qintptr socketDescriptor, SocketState
     Q_D(QAbstractSocket);
 
     d->resetSocketLayer();
-    d->writeBuffer.clear();
+    d->clearWriteBuffer();
     d->buffer.clear();
     d->socketEngine = QAbstractSocketEngine::createSocketEngine(socketDescriptor, this);
     if (!d->socketEngine) {
@@ -2108,7 +2142,7 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
     do {
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, d->pendingWriteSize() != 0,
                                                qt_timeout_value(msecs, stopWatch.elapsed()))) {
             d->socketError = d->socketEngine->error();
             setErrorString(d->socketEngine->errorString());
@@ -2151,7 +2185,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (!d->pendingWriteSize())
         return false;
 
     QElapsedTimer stopWatch;
@@ -2166,7 +2200,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
     forever {
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, d->pendingWriteSize() != 0,
                                                qt_timeout_value(msecs, stopWatch.elapsed()))) {
             d->socketError = d->socketEngine->error();
             setErrorString(d->socketEngine->errorString());
@@ -2245,7 +2279,7 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               d->pendingWriteSize() != 0,
                                                qt_timeout_value(msecs, stopWatch.elapsed()))) {
             d->socketError = d->socketEngine->error();
             setErrorString(d->socketEngine->errorString());
@@ -2283,7 +2317,7 @@ void QAbstractSocket::abort()
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::abort()");
 #endif
-    d->writeBuffer.clear();
+    d->clearWriteBuffer();
     if (d->state == UnconnectedState)
         return;
 #ifndef QT_NO_SSL
@@ -2354,6 +2388,89 @@ bool QAbstractSocket::flush()
     return d->flush();
 }
 
+/*!
+    \since 5.3
+
+    Queues \a length bytes of \a file, starting at \a offset, to be sent
+    over this TCP socket. If \a length is -1, the file is sent from
+    \a offset to its end. Returns \c true if the data was queued;
+    otherwise returns \c false.
+
+    As with write(), the data is sent when control goes back to the event
+    loop, or when flush() or waitForBytesWritten() is called, and
+    bytesWritten() is emitted as it goes out. On Linux, it is sent with
+    sendfile(), so large files are served without being read into memory.
+    The file's current position is not changed.
+
+    \a file must stay open until all of it has been sent, that is, until
+    bytesToWrite() no longer includes it; closing it earlier aborts the
+    connection. If the socket still holds data from an earlier write() or
+    sendFile() call, or if it is a QSslSocket, which has to encrypt the
+    data, the data is read from \a file and written as by write() instead.
+
+    \sa write(), bytesToWrite()
+*/
+bool QAbstractSocket::sendFile(QFile *file, qint64 offset, qint64 length)
+{
+    Q_D(QAbstractSocket);
+    if (d->socketType != TcpSocket) {
+        qWarning("QAbstractSocket::sendFile: Only TCP sockets can send files");
+        return false;
+    }
+    if (!isWritable()) {
+        qWarning("QAbstractSocket::sendFile: Socket not open for writing");
+        return false;
+    }
+    if (!file || !file->isReadable()) {
+        qWarning("QAbstractSocket::sendFile: File not open for reading");
+        return false;
+    }
+    if (d->state == UnconnectedState) {
+        d->socketError = UnknownSocketError;
+        setErrorString(tr("Socket is not connected"));
+        return false;
+    }
+
+    const qint64 size = file->size();
+    if (offset < 0 || offset > size) {
+        qWarning("QAbstractSocket::sendFile: Offset outside the file");
+        return false;
+    }
+    if (length < 0 || length > size - offset)
+        length = size - offset;
+    if (!length)
+        return true;
+
+    // Whatever is still in QFile's write buffer has to reach the file.
+    if (file->isWritable() && !file->flush())
+        return false;
+
+    bool copyData = d->pendingWriteSize() != 0;
+#ifndef QT_NO_SSL
+    if (qobject_cast<QSslSocket *>(this))
+        copyData = true;
+#endif
+    if (copyData) {
+        const qint64 oldPos = file->pos();
+        bool ok = file->seek(offset);
+        char block[16384];
+        while (ok && length) {
+            const qint64 readBytes = file->read(block, qMin(length, qint64(sizeof block)));
+            ok = readBytes > 0 && write(block, readBytes) == readBytes;
+            length -= readBytes;
+        }
+        file->seek(oldPos);
+        return ok;
+    }
+
+    d->sendFileSource = file;
+    d->sendFileOffset = offset;
+    d->sendFileRemaining = length;
+    if (d->socketEngine)
+        d->socketEngine->setWriteNotificationEnabled(true);
+    return true;
+}
+
 /*! \reimp
 */
 qint64 QAbstractSocket::readData(char *data, qint64 maxSize)
@@ -2402,6 +2519,110 @@ qint64 QAbstractSocket::readData(char *data, qint64 maxSize)
 
 }
 
+/*! \internal
+
+    Unbuffered sockets read straight into \a buffers with a single engine
+    call; otherwise this falls back to readData() for each buffer.
+*/
+qint64 QAbstractSocketPrivate::readDataVector(const QIODevice::Buffer *buffers, int count)
+{
+    Q_Q(QAbstractSocket);
+
+    // readData() covers the buffered and not connected cases
+    if (isBuffered || !socketEngine || !socketEngine->isValid()
+        || state != QAbstractSocket::ConnectedState) {
+        return QIODevicePrivate::readDataVector(buffers, count);
+    }
+
+    // Check if the read notifier can be enabled again.
+    if (!socketEngine->isReadNotificationEnabled())
+        socketEngine->setReadNotificationEnabled(true);
+
+    qint64 maxSize = 0;
+    for (int i = 0; i < count; ++i)
+        maxSize += buffers[i].size;
+    if (!maxSize)
+        return 0;
+
+    qint64 readBytes = socketEngine->readVector(buffers, count);
+    if (readBytes == -2) {
+        // -2 from the engine means no bytes available (EAGAIN) so read more later
+        return 0;
+    } else if (readBytes < 0) {
+        socketError = socketEngine->error();
+        q->setErrorString(socketEngine->errorString());
+        resetSocketLayer();
+        state = QAbstractSocket::UnconnectedState;
+    } else if (!socketEngine->isReadNotificationEnabled()) {
+        // Only do this when there was no error
+        socketEngine->setReadNotificationEnabled(true);
+    }
+
+#if defined (QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocketPrivate::readDataVector(%p, %d) == %lld [engine]",
+           buffers, count, readBytes);
+#endif
+    return readBytes;
+}
+
+/*! \internal
+
+    Unbuffered sockets hand \a buffers to the engine in one call, so that
+    a connected QUdpSocket sends them as one datagram and an unbuffered
+    QTcpSocket sends them without joining them first.
+*/
+qint64 QAbstractSocketPrivate::writeDataVector(const QByteArrayView *buffers, int count)
+{
+    Q_Q(QAbstractSocket);
+
+    // writeData() covers the buffered and not connected cases
+    if (isBuffered || state == QAbstractSocket::UnconnectedState
+        || (socketType == QAbstractSocket::TcpSocket && pendingWriteSize())) {
+        return QIODevicePrivate::writeDataVector(buffers, count);
+    }
+
+    qint64 size = 0;
+    for (int i = 0; i < count; ++i)
+        size += buffers[i].size();
+
+    qint64 written = socketEngine->writeVector(buffers, count);
+    if (written < 0) {
+        socketError = socketEngine->error();
+        q->setErrorString(socketEngine->errorString());
+        return written;
+    }
+
+    if (socketType == QAbstractSocket::TcpSocket) {
+        if (written < size) {
+            // Buffer what was not written yet
+            qint64 skip = written;
+            for (int i = 0; i < count; ++i) {
+                const qint64 len = buffers[i].size();
+                if (skip >= len) {
+                    skip -= len;
+                    continue;
+                }
+                char *ptr = writeBuffer.reserve(len - skip);
+                memcpy(ptr, buffers[i].data() + skip, len - skip);
+                skip = 0;
+            }
+            socketEngine->setWriteNotificationEnabled(true);
+        }
+        return size; // size=actually written + what has been buffered
+    }
+
+    // This is for a QUdpSocket that was connect()ed
+    if (!writeBuffer.isEmpty())
+        socketEngine->setWriteNotificationEnabled(true);
+
+#if defined (QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocketPrivate::writeDataVector(%p, %d) == %lld",
+           buffers, count, written);
+#endif
+    emit q->bytesWritten(written);
+    return written;
+}
+
 /*! \reimp
 */
 qint64 QAbstractSocket::readLineData(char *data, qint64 maxlen)
@@ -2420,7 +2641,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
         return -1;
     }
 
-    if (!d->isBuffered && d->socketType == TcpSocket && d->writeBuffer.isEmpty()) {
+    if (!d->isBuffered && d->socketType == TcpSocket && !d->pendingWriteSize()) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = d->socketEngine->write(data, size);
         if (written < 0) {
@@ -2666,14 +2887,14 @@ void QAbstractSocket::disconnectFromHost()
         }
 
         // Wait for pending data to be written.
-        if (d->socketEngine && d->socketEngine->isValid() && (d->writeBuffer.size() > 0
+        if (d->socketEngine && d->socketEngine->isValid() && (d->pendingWriteSize() > 0
             || d->socketEngine->bytesToWrite() > 0)) {
             // hack: when we are waiting for the socket engine to write bytes (only
             // possible when using Socks5 or HTTP socket engine), then close
             // anyway after 2 seconds. This is to prevent a timeout on Mac, where we
             // sometimes just did not get the write notifier from the underlying
             // CFSocket and no progress was made.
-            if (d->writeBuffer.size() == 0 && d->socketEngine->bytesToWrite() > 0) {
+            if (d->pendingWriteSize() == 0 && d->socketEngine->bytesToWrite() > 0) {
                 if (!d->disconnectTimer) {
                     d->disconnectTimer = new QTimer(this);
                     connect(d->disconnectTimer, SIGNAL(timeout()), this,
@@ -2719,7 +2940,7 @@ void QAbstractSocket::disconnectFromHost()
         qDebug("QAbstractSocket::disconnectFromHost() closed!");
 #endif
         d->buffer.clear();
-        d->writeBuffer.clear();
+        d->clearWriteBuffer();
         QIODevice::close();
     }
 }
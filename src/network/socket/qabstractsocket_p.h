@@ -57,6 +57,8 @@
 #include "QtCore/qbytearray.h"
 #include "QtCore/qlist.h"
 #include "QtCore/qtimer.h"
+#include "QtCore/qfile.h"
+#include "QtCore/qpointer.h"
 #include "private/qringbuffer_p.h"
 #include "private/qiodevice_p.h"
 #include "private/qabstractsocketengine_p.h"
@@ -90,6 +92,9 @@ public:
     bool canWriteNotification();
     void canCloseNotification();
 
+    qint64 readDataVector(const QIODevice::Buffer *buffers, int count);
+    qint64 writeDataVector(const QByteArrayView *buffers, int count);
+
     // slots
     void _q_connectToNextAddress();
     void _q_startConnecting(const QHostInfo &hostInfo);
@@ -145,6 +150,13 @@ public:
     qint64 readBufferMaxSize;
     QRingBuffer writeBuffer;
 
+    // A file segment queued by sendFile(); it goes out before writeBuffer
+    QPointer<QFile> sendFileSource;
+    qint64 sendFileOffset;
+    qint64 sendFileRemaining;
+    inline qint64 pendingWriteSize() const { return writeBuffer.size() + sendFileRemaining; }
+    void clearWriteBuffer();
+
     bool isBuffered;
     int blockingTimeout;
 
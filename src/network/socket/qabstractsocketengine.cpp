@@ -45,6 +45,7 @@
 
 #include "qmutex.h"
 #include "qnetworkproxy.h"
+#include "qfile.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -128,6 +129,76 @@ QAbstractSocketEngine *QAbstractSocketEngine::createSocketEngine(qintptr socketD
     return new QNativeSocketEngine(parent);
 }
 
+/*
+    Reads into the \a count \a buffers, filling each one before moving on
+    to the next. Returns the number of bytes read, or what read() returned
+    if nothing could be read. Engines that can do this with one system
+    call reimplement it.
+*/
+qint64 QAbstractSocketEngine::readVector(const QIODevice::Buffer *buffers, int count)
+{
+    qint64 readSoFar = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 readBytes = read(buffers[i].data, buffers[i].size);
+        if (readBytes <= 0)
+            return readSoFar ? readSoFar : readBytes;
+        readSoFar += readBytes;
+        if (readBytes < buffers[i].size)
+            break;
+    }
+    return readSoFar;
+}
+
+/*
+    Writes the \a count \a buffers in order and returns the number of bytes
+    written, or -1 on error. Datagram sockets send the buffers as one
+    datagram.
+*/
+qint64 QAbstractSocketEngine::writeVector(const QByteArrayView *buffers, int count)
+{
+    if (socketType() != QAbstractSocket::TcpSocket) {
+        QByteArray datagram;
+        for (int i = 0; i < count; ++i)
+            datagram.append(buffers[i].data(), buffers[i].size());
+        return write(datagram.constData(), datagram.size());
+    }
+
+    qint64 writtenSoFar = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 written = write(buffers[i].data(), buffers[i].size());
+        if (written < 0)
+            return writtenSoFar ? writtenSoFar : written;
+        writtenSoFar += written;
+        if (written < buffers[i].size())
+            break;
+    }
+    return writtenSoFar;
+}
+
+/*
+    Sends up to \a length bytes of \a file, starting at \a offset, to the
+    stream socket. Returns the number of bytes sent, which is 0 if the
+    socket can't take any more for now, or -1 on error. Engines that can
+    send from the file without copying it through user space reimplement
+    this; this implementation reads a block and write()s it.
+*/
+qint64 QAbstractSocketEngine::sendFile(QFile *file, qint64 offset, qint64 length)
+{
+    char block[16384];
+    const qint64 oldPos = file->pos();
+    qint64 readBytes = -1;
+    if (file->seek(offset))
+        readBytes = file->read(block, qMin(length, qint64(sizeof block)));
+    file->seek(oldPos);
+
+    if (readBytes <= 0) {
+        setError(QAbstractSocket::UnknownSocketError,
+                 readBytes ? file->errorString() : tr("Unexpected end of file"));
+        return -1;
+    }
+    return write(block, readBytes);
+}
+
 QAbstractSocket::SocketError QAbstractSocketEngine::error() const
 {
     return d_func()->socketError;
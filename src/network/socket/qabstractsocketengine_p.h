@@ -60,6 +60,7 @@
 QT_BEGIN_NAMESPACE
 
 class QAuthenticator;
+class QFile;
 class QAbstractSocketEnginePrivate;
 #ifndef QT_NO_NETWORKINTERFACE
 class QNetworkInterface;
@@ -123,6 +124,9 @@ public:
 
     virtual qint64 read(char *data, qint64 maxlen) = 0;
     virtual qint64 write(const char *data, qint64 len) = 0;
+    virtual qint64 readVector(const QIODevice::Buffer *buffers, int count);
+    virtual qint64 writeVector(const QByteArrayView *buffers, int count);
+    virtual qint64 sendFile(QFile *file, qint64 offset, qint64 length);
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
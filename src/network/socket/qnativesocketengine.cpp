@@ -101,6 +101,7 @@
 #include <qabstracteventdispatcher.h>
 #include <qsocketnotifier.h>
 #include <qnetworkinterface.h>
+#include <qfile.h>
 
 #include <private/qthread_p.h>
 #include <private/qobject_p.h>
@@ -837,6 +838,76 @@ qint64 QNativeSocketEngine::read(char *data, qint64 maxSize)
     return readBytes;
 }
 
+#ifdef Q_OS_UNIX
+/*!
+    Reads into the \a count \a buffers with one system call, filling each
+    one before moving on to the next. Returns the number of bytes read, -2
+    if no data was available, or -1 if an error occurred.
+*/
+qint64 QNativeSocketEngine::readVector(const QIODevice::Buffer *buffers, int count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readVector(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readVector(), QAbstractSocket::ConnectedState, QAbstractSocket::BoundState, -1);
+
+    qint64 readBytes = d->nativeReadVector(buffers, count);
+
+    // Handle remote close
+    if (readBytes == 0 && d->socketType == QAbstractSocket::TcpSocket) {
+        d->setError(QAbstractSocket::RemoteHostClosedError,
+                    QNativeSocketEnginePrivate::RemoteHostClosedErrorString);
+        close();
+        return -1;
+    } else if (readBytes == -1) {
+        if (!d->hasSetSocketError) {
+            d->hasSetSocketError = true;
+            d->socketError = QAbstractSocket::NetworkError;
+            d->socketErrorString = qt_error_string();
+        }
+        close();
+        return -1;
+    }
+    return readBytes;
+}
+
+/*!
+    Writes the \a count \a buffers to the socket with one system call.
+    Returns the number of bytes written, or -1 if an error occurred. On a
+    UDP socket, the buffers make up one datagram.
+*/
+qint64 QNativeSocketEngine::writeVector(const QByteArrayView *buffers, int count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeVector(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeVector(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteVector(buffers, count);
+}
+#endif
+
+#ifdef Q_OS_LINUX
+/*!
+    Sends up to \a length bytes of \a file, starting at \a offset, with
+    sendfile(), so that the data does not pass through user space. Returns
+    the number of bytes sent, or -1 if an error occurred. Files that
+    sendfile() cannot read from are sent the ordinary way.
+*/
+qint64 QNativeSocketEngine::sendFile(QFile *file, qint64 offset, qint64 length)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::sendFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::sendFile(), QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::sendFile(), QAbstractSocket::TcpSocket, -1);
+
+    const int fd = file->handle();
+    if (fd != -1) {
+        const qint64 sent = d->nativeSendFile(fd, offset, length);
+        if (sent != -2)
+            return sent;
+    }
+    return QAbstractSocketEngine::sendFile(file, offset, length);
+}
+#endif
+
 /*!
     Closes the socket. In order to use the socket again, initialize()
     must be called.
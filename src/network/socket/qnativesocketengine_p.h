@@ -140,6 +140,13 @@ public:
 
     qint64 read(char *data, qint64 maxlen);
     qint64 write(const char *data, qint64 len);
+#ifdef Q_OS_UNIX
+    qint64 readVector(const QIODevice::Buffer *buffers, int count);
+    qint64 writeVector(const QByteArrayView *buffers, int count);
+#endif
+#ifdef Q_OS_LINUX
+    qint64 sendFile(QFile *file, qint64 offset, qint64 length);
+#endif
 
     qint64 readDatagram(char *data, qint64 maxlen, QHostAddress *addr = 0,
                             quint16 *port = 0);
@@ -269,6 +276,13 @@ public:
                                   const QHostAddress &host, quint16 port);
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#ifdef Q_OS_UNIX
+    qint64 nativeReadVector(const QIODevice::Buffer *buffers, int count);
+    qint64 nativeWriteVector(const QByteArrayView *buffers, int count);
+#endif
+#ifdef Q_OS_LINUX
+    qint64 nativeSendFile(int fd, qint64 offset, qint64 length);
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
 		     bool *selectForRead, bool *selectForWrite) const;
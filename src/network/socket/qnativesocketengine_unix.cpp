@@ -50,6 +50,10 @@
 #include <time.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/uio.h>
+#ifdef Q_OS_LINUX
+#include <sys/sendfile.h>
+#endif
 #ifndef QT_NO_IPV6IFNAME
 #include <net/if.h>
 #endif
@@ -1120,6 +1124,149 @@ qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
     return qint64(r);
 }
 
+#ifndef IOV_MAX
+#  define IOV_MAX 16
+#endif
+
+qint64 QNativeSocketEnginePrivate::nativeWriteVector(const QByteArrayView *buffers, int count)
+{
+    Q_Q(QNativeSocketEngine);
+
+    // A datagram has to go out in one piece.
+    if (count > IOV_MAX && socketType != QAbstractSocket::TcpSocket)
+        return q->QAbstractSocketEngine::writeVector(buffers, count);
+
+    QVarLengthArray<struct iovec, 16> iov(qMin(count, int(IOV_MAX)));
+    for (int i = 0; i < iov.size(); ++i) {
+        iov[i].iov_base = const_cast<char *>(buffers[i].data());
+        iov[i].iov_len = size_t(buffers[i].size());
+    }
+
+    qt_ignore_sigpipe();
+    ssize_t writtenBytes;
+    EINTR_LOOP(writtenBytes, ::writev(socketDescriptor, iov.constData(), iov.size()));
+
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        case EMSGSIZE:
+            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteVector(%p, %d) == %i",
+           buffers, count, (int) writtenBytes);
+#endif
+
+    return qint64(writtenBytes);
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReadVector(const QIODevice::Buffer *buffers, int count)
+{
+    Q_Q(QNativeSocketEngine);
+    if (!q->isValid()) {
+        qWarning("QNativeSocketEngine::nativeReadVector: Invalid socket");
+        return -1;
+    }
+
+    QVarLengthArray<struct iovec, 16> iov(qMin(count, int(IOV_MAX)));
+    for (int i = 0; i < iov.size(); ++i) {
+        iov[i].iov_base = buffers[i].data;
+        iov[i].iov_len = size_t(buffers[i].size);
+    }
+
+    ssize_t r = 0;
+    EINTR_LOOP(r, ::readv(socketDescriptor, iov.constData(), iov.size()));
+
+    if (r < 0) {
+        r = -1;
+        switch (errno) {
+#if EWOULDBLOCK-0 && EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+        case EAGAIN:
+            // No data was available for reading
+            r = -2;
+            break;
+        case ECONNRESET:
+#if defined(Q_OS_VXWORKS)
+        case ESHUTDOWN:
+#endif
+            r = 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeReadVector(%p, %d) == %i",
+           buffers, count, (int) r);
+#endif
+
+    return qint64(r);
+}
+
+#ifdef Q_OS_LINUX
+/*
+    Returns -2 if sendfile() can't read from \a fd, so that the caller falls
+    back to reading the data itself.
+*/
+qint64 QNativeSocketEnginePrivate::nativeSendFile(int fd, qint64 offset, qint64 length)
+{
+    Q_Q(QNativeSocketEngine);
+
+    // sendfile() moves at most 2 GB - 4 KB at a time
+    off_t off = offset;
+    ssize_t sentBytes;
+    qt_ignore_sigpipe();
+    EINTR_LOOP(sentBytes, ::sendfile(socketDescriptor, fd, &off, size_t(qMin(length, qint64(0x7ffff000)))));
+
+    if (sentBytes == 0) {
+        // the file is shorter than it was
+        sentBytes = -2;
+    } else if (sentBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            sentBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            sentBytes = 0;
+            break;
+        case EINVAL:
+        case ENOSYS:
+        case EOVERFLOW:
+            sentBytes = -2;
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendFile(%d, %lld, %lld) == %i",
+           fd, offset, length, (int) sentBytes);
+#endif
+
+    return qint64(sentBytes);
+}
+#endif
+
 int QNativeSocketEnginePrivate::nativeSelect(int timeout, bool selectForRead) const
 {
     fd_set fds;
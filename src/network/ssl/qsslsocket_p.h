@@ -106,6 +106,12 @@ public:
     void init();
     bool initialized;
 
+    // readData() and writeData() do the encryption; don't bypass them
+    qint64 readDataVector(const QIODevice::Buffer *buffers, int count)
+    { return QIODevicePrivate::readDataVector(buffers, count); }
+    qint64 writeDataVector(const QByteArrayView *buffers, int count)
+    { return QIODevicePrivate::writeDataVector(buffers, count); }
+
     QSslSocket::SslMode mode;
     bool autoStartHandshake;
     bool connectionEncrypted;
@@ -0,0 +1,274 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtconcurrentalgorithms.h>
+#include <QtTest/QtTest>
+
+class tst_QtConcurrentAlgorithms: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+    void forEach_data();
+    void forEach();
+    void sort_data();
+    void sort();
+    void stableSort();
+    void sortList();
+    void inclusiveScan_data();
+    void inclusiveScan();
+    void exclusiveScan_data();
+    void exclusiveScan();
+
+private:
+    int savedMaxThreadCount;
+};
+
+void tst_QtConcurrentAlgorithms::init()
+{
+    savedMaxThreadCount = QThreadPool::globalInstance()->maxThreadCount();
+}
+
+void tst_QtConcurrentAlgorithms::cleanup()
+{
+    QThreadPool::globalInstance()->setMaxThreadCount(savedMaxThreadCount);
+}
+
+static void addSizes()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("threadCount");
+
+    QTest::newRow("empty") << 0 << 4;
+    QTest::newRow("one") << 1 << 4;
+    QTest::newRow("small") << 1000 << 4;
+    QTest::newRow("one block per thread") << 10000 << 1;
+    QTest::newRow("many blocks") << 100000 << 8;
+    QTest::newRow("uneven") << 77777 << 3;
+}
+
+class CountIndexes
+{
+public:
+    CountIndexes(QVector<QAtomicInt> *counts) : counts(counts) { }
+    void operator()(int index) { (*counts)[index - 10].ref(); }
+private:
+    QVector<QAtomicInt> *counts;
+};
+
+void tst_QtConcurrentAlgorithms::forEach_data()
+{
+    addSizes();
+}
+
+void tst_QtConcurrentAlgorithms::forEach()
+{
+    QFETCH(int, size);
+    QFETCH(int, threadCount);
+    QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+
+    QVector<QAtomicInt> counts(size);
+    QFuture<void> future = QtConcurrent::forEach(10, 10 + size, CountIndexes(&counts));
+    future.waitForFinished();
+    for (int i = 0; i < size; ++i)
+        QCOMPARE(counts.at(i).load(), 1);
+
+    QtConcurrent::blockingForEach(10, 10 + size, CountIndexes(&counts),
+                                  QtConcurrent::ChunkingPolicy::fixedSize(7));
+    for (int i = 0; i < size; ++i)
+        QCOMPARE(counts.at(i).load(), 2);
+
+    // an empty or reversed range does nothing
+    QtConcurrent::blockingForEach(10 + size, 10, CountIndexes(&counts));
+}
+
+void tst_QtConcurrentAlgorithms::sort_data()
+{
+    addSizes();
+}
+
+void tst_QtConcurrentAlgorithms::sort()
+{
+    QFETCH(int, size);
+    QFETCH(int, threadCount);
+    QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+
+    qsrand(size);
+    QVector<int> data;
+    for (int i = 0; i < size; ++i)
+        data.append(qrand() % 1000);
+
+    QVector<int> expected = data;
+    std::sort(expected.begin(), expected.end());
+    QVector<int> sorted = data;
+    QFuture<void> future = QtConcurrent::sort(sorted.begin(), sorted.end());
+    future.waitForFinished();
+    QCOMPARE(sorted, expected);
+
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+    sorted = data;
+    QtConcurrent::sort(sorted.begin(), sorted.end(), std::greater<int>()).waitForFinished();
+    QCOMPARE(sorted, expected);
+
+    // already sorted and reversed input
+    QtConcurrent::sort(sorted.begin(), sorted.end()).waitForFinished();
+    std::sort(expected.begin(), expected.end());
+    QCOMPARE(sorted, expected);
+}
+
+struct Item
+{
+    int key;
+    int position;
+};
+
+static bool keyLessThan(const Item &a, const Item &b)
+{
+    return a.key < b.key;
+}
+
+void tst_QtConcurrentAlgorithms::stableSort()
+{
+    QThreadPool::globalInstance()->setMaxThreadCount(8);
+
+    QVector<Item> items;
+    for (int i = 0; i < 100000; ++i) {
+        Item item = { (i * 7919) % 13, i };
+        items.append(item);
+    }
+    QtConcurrent::sort(items.begin(), items.end(), keyLessThan).waitForFinished();
+    for (int i = 1; i < items.count(); ++i) {
+        QVERIFY(items.at(i - 1).key <= items.at(i).key);
+        if (items.at(i - 1).key == items.at(i).key)
+            QVERIFY(items.at(i - 1).position < items.at(i).position);
+    }
+}
+
+void tst_QtConcurrentAlgorithms::sortList()
+{
+    QStringList strings;
+    for (int i = 20000; i > 0; --i)
+        strings.append(QString::number(i));
+    QStringList expected = strings;
+    std::sort(expected.begin(), expected.end());
+
+    QtConcurrent::sort(strings.begin(), strings.end()).waitForFinished();
+    QCOMPARE(strings, expected);
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan_data()
+{
+    addSizes();
+}
+
+static int maximum(int a, int b)
+{
+    return qMax(a, b);
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan()
+{
+    QFETCH(int, size);
+    QFETCH(int, threadCount);
+    QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+
+    qsrand(size);
+    QVector<int> data;
+    for (int i = 0; i < size; ++i)
+        data.append(qrand() % 100 - 50);
+
+    QVector<int> sums(size);
+    QVector<int> maxima(size);
+    int sum = 0;
+    int max = INT_MIN;
+    for (int i = 0; i < size; ++i) {
+        sum += data.at(i);
+        max = qMax(max, data.at(i));
+        sums[i] = sum;
+        maxima[i] = max;
+    }
+
+    QVector<int> result(size);
+    QtConcurrent::inclusiveScan(data.constBegin(), data.constEnd(), result.begin()).waitForFinished();
+    QCOMPARE(result, sums);
+
+    QtConcurrent::inclusiveScan(data.constBegin(), data.constEnd(), result.begin(), maximum).waitForFinished();
+    QCOMPARE(result, maxima);
+
+    // in place
+    QtConcurrent::inclusiveScan(data.begin(), data.end(), data.begin()).waitForFinished();
+    QCOMPARE(data, sums);
+}
+
+void tst_QtConcurrentAlgorithms::exclusiveScan_data()
+{
+    addSizes();
+}
+
+void tst_QtConcurrentAlgorithms::exclusiveScan()
+{
+    QFETCH(int, size);
+    QFETCH(int, threadCount);
+    QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+
+    QVector<qint64> data;
+    for (int i = 0; i < size; ++i)
+        data.append(i % 17);
+
+    QVector<qint64> sums(size);
+    qint64 sum = 100;
+    for (int i = 0; i < size; ++i) {
+        sums[i] = sum;
+        sum += data.at(i);
+    }
+
+    QVector<qint64> result(size);
+    QtConcurrent::exclusiveScan(data.constBegin(), data.constEnd(), result.begin(), 100).waitForFinished();
+    QCOMPARE(result, sums);
+
+    // in place, with an operation
+    QtConcurrent::exclusiveScan(data.begin(), data.end(), data.begin(), Q_INT64_C(100),
+                                std::plus<qint64>()).waitForFinished();
+    QCOMPARE(data, sums);
+}
+
+QTEST_MAIN(tst_QtConcurrentAlgorithms)
+#include "tst_qtconcurrentalgorithms.moc"
@@ -95,6 +95,7 @@ private slots:
     void noIterations();
     void throttling();
     void blockSize();
+    void chunkingPolicy();
     void multipleResults();
 };
 
@@ -273,6 +274,55 @@ void tst_QtConcurrentIterateKernel::blockSize()
     QVERIFY(peakBlockSize >= expectedMinimumBlockSize);
 }
 
+QMutex blockSizesMutex;
+QMap<int, int> blockSizes; // by first iteration
+class BlockSizesRecorder : public IterateKernel<TestIterator, void>
+{
+public:
+    BlockSizesRecorder(TestIterator begin, TestIterator end, const ChunkingPolicy &policy)
+        : IterateKernel<TestIterator, void>(begin, end)
+    {
+        chunkingPolicy = policy;
+        blockSizes.clear();
+    }
+    inline bool runIterations(TestIterator, int begin, int end, void *)
+    {
+        QMutexLocker locker(&blockSizesMutex);
+        blockSizes.insert(begin, end - begin);
+        return false;
+    }
+};
+
+void tst_QtConcurrentIterateKernel::chunkingPolicy()
+{
+    const int threadCount = QThreadPool::globalInstance()->maxThreadCount();
+
+    BlockSizesRecorder(0, 100, ChunkingPolicy::fixedSize(7)).startBlocking();
+    QCOMPARE(blockSizes.count(), 15);
+    foreach (int begin, blockSizes.keys())
+        QCOMPARE(blockSizes.value(begin), begin == 98 ? 2 : 7);
+
+    // shares of what is left, never below the minimum except at the end
+    BlockSizesRecorder(0, 1000, ChunkingPolicy::guided(5)).startBlocking();
+    int next = 0;
+    QMap<int, int>::const_iterator it = blockSizes.constBegin();
+    for (; it != blockSizes.constEnd(); ++it) {
+        QCOMPARE(it.key(), next);
+        QVERIFY(it.value() >= 5 || it.key() + it.value() == 1000);
+        next += it.value();
+    }
+    QCOMPARE(next, 1000);
+    QCOMPARE(blockSizes.value(0), qMax(1000 / threadCount, 5));
+
+    // a cost hint of 100 ns per iteration starts with blocks of 20 us
+    BlockSizesRecorder(0, 10000, ChunkingPolicy::adaptive(100)).startBlocking();
+    QCOMPARE(blockSizes.value(0), qMin(200, qMax(10000 / (2 * threadCount), 1)));
+    int total = 0;
+    foreach (int size, blockSizes)
+        total += size;
+    QCOMPARE(total, 10000);
+}
+
 class MultipleResultsFor : public IterateKernel<TestIterator, int>
 {
 public:
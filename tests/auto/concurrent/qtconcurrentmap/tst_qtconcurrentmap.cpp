@@ -68,8 +68,11 @@ private slots:
     void noDetach();
     void stlContainers();
     void qFutureAssignmentLeak();
+    void thenOnTemporary();
     void stressTest();
     void persistentResultTest();
+    void chunkingPolicy();
+    void parallelReduce();
 public slots:
     void throttling();
 };
@@ -2346,6 +2349,26 @@ void tst_QtConcurrentMap::qFutureAssignmentLeak()
     QCOMPARE(currentInstanceCount.load(), 0);
 }
 
+// A continuation attached to the temporary returned by mapped() must still
+// see the results after the thread engine has dropped its own reference.
+void tst_QtConcurrentMap::thenOnTemporary()
+{
+#if defined(Q_COMPILER_DECLTYPE) && defined(Q_COMPILER_LAMBDA)
+    QList<int> list;
+    for (int i = 1; i <= 100; ++i)
+        list << i;
+
+    for (int i = 0; i < 20; ++i) {
+        QFuture<int> f = QtConcurrent::mapped(list, multiplyBy2).then([](int first) {
+            return first + 1;
+        });
+        QCOMPARE(f.result(), 3);
+    }
+#else
+    QSKIP("This test requires a compiler that supports decltype and lambdas");
+#endif
+}
+
 inline void increment(int &num)
 {
     ++num;
@@ -2431,5 +2454,89 @@ void tst_QtConcurrentMap::persistentResultTest()
     QCOMPARE(ref.loadAcquire(), 3);
 }
 
+void tst_QtConcurrentMap::chunkingPolicy()
+{
+    QList<QtConcurrent::ChunkingPolicy> policies;
+    policies << QtConcurrent::ChunkingPolicy()
+             << QtConcurrent::ChunkingPolicy::adaptive(1000)
+             << QtConcurrent::ChunkingPolicy::fixedSize(1)
+             << QtConcurrent::ChunkingPolicy::fixedSize(333)
+             << QtConcurrent::ChunkingPolicy::guided()
+             << QtConcurrent::ChunkingPolicy::guided(64);
+
+    QList<int> list;
+    QList<int> doubled;
+    int sumOfSquares = 0;
+    for (int i = 0; i < 10000; ++i) {
+        list << i;
+        doubled << 2 * i;
+        sumOfSquares += i * i;
+    }
+
+    foreach (const QtConcurrent::ChunkingPolicy &policy, policies) {
+        QList<int> inPlace = list;
+        QtConcurrent::map(inPlace, multiplyBy2InPlace, policy).waitForFinished();
+        QCOMPARE(inPlace, doubled);
+
+        QCOMPARE(QtConcurrent::mapped(list, multiplyBy2, policy).results(), doubled);
+        QCOMPARE(QtConcurrent::mapped(list.constBegin(), list.constEnd(), multiplyBy2, policy).results(),
+                 doubled);
+
+        QCOMPARE(QtConcurrent::mappedReduced(list, intSquare, intSumReduce,
+                                             QtConcurrent::UnorderedReduce, policy).result(),
+                 sumOfSquares);
+    }
+}
+
+QString appendX(const QString &s)
+{
+    return s + QLatin1Char('x');
+}
+
+void stringConcatenate(QString &result, const QString &s)
+{
+    result += s;
+}
+
+void tst_QtConcurrentMap::parallelReduce()
+{
+    QList<int> list;
+    int sumOfSquares = 0;
+    for (int i = 0; i < 10000; ++i) {
+        list << i;
+        sumOfSquares += i * i;
+    }
+
+    const QtConcurrent::ReduceOptions parallel = QtConcurrent::ParallelReduce;
+    QCOMPARE(QtConcurrent::mappedReduced(list, intSquare, intSumReduce, parallel).result(),
+             sumOfSquares);
+    QCOMPARE(QtConcurrent::blockingMappedReduced(list, intSquare, intSumReduce,
+                                                 QtConcurrent::UnorderedReduce | parallel),
+             sumOfSquares);
+    QCOMPARE(QtConcurrent::mappedReduced(list, intSquare, intSumReduce,
+                                         parallel, QtConcurrent::ChunkingPolicy::fixedSize(1)).result(),
+             sumOfSquares);
+
+    // the order is kept when partial results are combined
+    QStringList strings;
+    QString expected;
+    for (int i = 0; i < 5000; ++i) {
+        strings << QString::number(i);
+        expected += QString::number(i) + QLatin1Char('x');
+    }
+    QCOMPARE(QtConcurrent::mappedReduced(strings, appendX, stringConcatenate,
+                                         QtConcurrent::OrderedReduce | parallel).result(),
+             expected);
+    QCOMPARE(QtConcurrent::mappedReduced(strings, appendX, stringConcatenate,
+                                         QtConcurrent::OrderedReduce | parallel,
+                                         QtConcurrent::ChunkingPolicy::guided()).result(),
+             expected);
+
+    // reduction into another type falls back to sequential reduction
+    QCOMPARE(QtConcurrent::mappedReduced<QList<int> >(list, multiplyBy2, QtPrivate::PushBackWrapper(),
+                                                      QtConcurrent::OrderedReduce | parallel).result().count(),
+             list.count());
+}
+
 QTEST_MAIN(tst_QtConcurrentMap)
 #include "tst_qtconcurrentmap.moc"
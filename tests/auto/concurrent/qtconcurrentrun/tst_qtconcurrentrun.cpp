@@ -57,6 +57,7 @@ private slots:
     void implicitConvertibleTypes();
     void runWaitLoop();
     void recursive();
+    void recursiveWorkStealing();
 #ifndef QT_NO_EXCEPTIONS
     void exceptions();
 #endif
@@ -336,6 +337,35 @@ void tst_QtConcurrentRun::recursive()
     }
 }
 
+class RecursiveRunTask : public QRunnable
+{
+public:
+    RecursiveRunTask(int levels) : levels(levels) { }
+    void run() { recursiveRun(levels); }
+private:
+    int levels;
+};
+
+// The nested waits happen on the only pool thread, which has to take the
+// tasks it is waiting for back from its own deque.
+void tst_QtConcurrentRun::recursiveWorkStealing()
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    const bool workStealing = pool->isWorkStealingEnabled();
+    pool->setWorkStealingEnabled(true);
+    pool->setMaxThreadCount(1);
+
+    const int levels = 10;
+    count.store(0);
+    pool->start(new RecursiveRunTask(levels));
+    QVERIFY(pool->waitForDone(60000));
+    QCOMPARE(count.load(), (1 << levels) - 1);
+
+    pool->setMaxThreadCount(maxThreadCount);
+    pool->setWorkStealingEnabled(workStealing);
+}
+
 int e;
 void vfn0()
 {
@@ -18,6 +18,7 @@ SUBDIRS=\
     qlockfile \
     qloggingcategory \
     qnodebug \
+    qparalleldiriterator \
     qprocess \
     qprocess-noapplication \
     qprocessenvironment \
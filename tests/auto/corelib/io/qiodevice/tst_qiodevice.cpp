@@ -66,6 +66,13 @@ private slots:
     void readLine2();
 
     void peekBug();
+
+    void readBuffers_data();
+    void readBuffers();
+    void writeBuffers_data();
+    void writeBuffers();
+    void writeBuffers_udp();
+    void buffers_unbufferedTcp();
 };
 
 void tst_QIODevice::initTestCase()
@@ -585,5 +592,201 @@ void tst_QIODevice::peekBug()
 
 }
 
+static QByteArray patternData(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        data[i] = char(i % 251);
+    return data;
+}
+
+void tst_QIODevice::readBuffers_data()
+{
+    QTest::addColumn<QString>("device");
+    QTest::addColumn<bool>("unbuffered");
+    QTest::addColumn<int>("fileSize");
+    QTest::addColumn<int>("peekFirst");
+
+    QTest::newRow("buffer") << "QBuffer" << false << 100000 << 0;
+    QTest::newRow("file-small") << "QFile" << false << 100 << 0;
+    QTest::newRow("file-large") << "QFile" << false << 100000 << 0;
+    QTest::newRow("file-large-peek") << "QFile" << false << 100000 << 10;
+    QTest::newRow("file-unbuffered") << "QFile" << true << 100000 << 0;
+    QTest::newRow("file-unbuffered-peek") << "QFile" << true << 100000 << 10;
+}
+
+void tst_QIODevice::readBuffers()
+{
+    QFETCH(QString, device);
+    QFETCH(bool, unbuffered);
+    QFETCH(int, fileSize);
+    QFETCH(int, peekFirst);
+
+    const QByteArray data = patternData(fileSize);
+    QBuffer buffer;
+    QTemporaryFile file;
+    QIODevice *dev;
+    if (device == QLatin1String("QBuffer")) {
+        buffer.setData(data);
+        dev = &buffer;
+    } else {
+        QVERIFY(file.open());
+        QCOMPARE(file.write(data), qint64(data.size()));
+        file.close();
+        dev = &file;
+    }
+    QIODevice::OpenMode mode = QIODevice::ReadOnly;
+    if (unbuffered)
+        mode |= QIODevice::Unbuffered;
+    QVERIFY(dev->open(mode));
+
+    if (peekFirst)
+        QCOMPARE(dev->peek(peekFirst), data.left(peekFirst));
+
+    // Ask for more than there is, so that the last buffer is only partly
+    // filled and the one after it is left alone.
+    const int chunk = fileSize / 4 + 7;
+    QByteArray out(4 * chunk + 16, 'x');
+    QVarLengthArray<QIODevice::Buffer, 8> buffers;
+    for (int i = 0; i < 5; ++i) {
+        QIODevice::Buffer b = { out.data() + i * chunk, i < 4 ? chunk : 16 };
+        buffers.append(b);
+    }
+
+    QCOMPARE(dev->read(buffers), qint64(fileSize));
+    QCOMPARE(out.left(fileSize), data);
+    QCOMPARE(out.mid(fileSize), QByteArray(out.size() - fileSize, 'x'));
+    QCOMPARE(dev->pos(), qint64(fileSize));
+    QVERIFY(dev->atEnd());
+    QCOMPARE(dev->read(buffers), qint64(0));
+
+    // Reading resumes at the current position after a seek.
+    QVERIFY(dev->seek(fileSize / 2));
+    QCOMPARE(dev->read(buffers), qint64(fileSize - fileSize / 2));
+    QCOMPARE(out.left(fileSize - fileSize / 2), data.mid(fileSize / 2));
+}
+
+void tst_QIODevice::writeBuffers_data()
+{
+    QTest::addColumn<QString>("device");
+    QTest::addColumn<bool>("unbuffered");
+    QTest::addColumn<int>("chunkSize");
+
+    QTest::newRow("buffer") << "QBuffer" << false << 30000;
+    QTest::newRow("file-small") << "QFile" << false << 10;
+    QTest::newRow("file-large") << "QFile" << false << 30000;
+    QTest::newRow("file-unbuffered-small") << "QFile" << true << 10;
+    QTest::newRow("file-unbuffered-large") << "QFile" << true << 30000;
+}
+
+void tst_QIODevice::writeBuffers()
+{
+    QFETCH(QString, device);
+    QFETCH(bool, unbuffered);
+    QFETCH(int, chunkSize);
+
+    const QByteArray data = patternData(3 * chunkSize);
+    QBuffer buffer;
+    QTemporaryFile file;
+    QIODevice *dev;
+    QIODevice::OpenMode mode = QIODevice::WriteOnly;
+    if (unbuffered)
+        mode |= QIODevice::Unbuffered;
+    if (device == QLatin1String("QBuffer")) {
+        QVERIFY(buffer.open(mode));
+        dev = &buffer;
+    } else {
+        QVERIFY(file.open());
+        file.close();
+        dev = &file;
+        QVERIFY(dev->open(mode));
+    }
+
+    // Something already buffered has to come out first.
+    QCOMPARE(dev->write("head"), qint64(4));
+
+    QVarLengthArray<QByteArrayView, 4> buffers;
+    buffers.append(QByteArrayView(data.constData(), chunkSize));
+    buffers.append(QByteArrayView());
+    buffers.append(QByteArrayView(data.constData() + chunkSize, 2 * chunkSize));
+    QCOMPARE(dev->write(buffers), qint64(data.size()));
+    QCOMPARE(dev->pos(), qint64(4 + data.size()));
+    QCOMPARE(dev->write("tail"), qint64(4));
+
+    const QByteArray expected = "head" + data + "tail";
+    if (device == QLatin1String("QBuffer")) {
+        QCOMPARE(buffer.data(), expected);
+        return;
+    }
+
+    file.close();
+    QVERIFY(dev->open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), expected);
+}
+
+void tst_QIODevice::writeBuffers_udp()
+{
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress(QHostAddress::LocalHost), 0));
+
+    QUdpSocket sender;
+    sender.connectToHost(QHostAddress::LocalHost, receiver.localPort());
+    QVERIFY(sender.waitForConnected(5000));
+
+    QVarLengthArray<QByteArrayView, 4> buffers;
+    buffers.append(QByteArrayView("Hello, "));
+    buffers.append(QByteArrayView("vectored "));
+    buffers.append(QByteArrayView("world"));
+    QCOMPARE(sender.write(buffers), qint64(21));
+
+    QTRY_VERIFY(receiver.hasPendingDatagrams());
+    QCOMPARE(receiver.pendingDatagramSize(), qint64(21));
+    QByteArray datagram(21, Qt::Uninitialized);
+    QCOMPARE(receiver.readDatagram(datagram.data(), datagram.size()), qint64(21));
+    QCOMPARE(datagram, QByteArray("Hello, vectored world"));
+    QVERIFY(!receiver.hasPendingDatagrams());
+}
+
+void tst_QIODevice::buffers_unbufferedTcp()
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QTcpSocket client;
+    client.connectToHost(QHostAddress::LocalHost, server.serverPort(), QIODevice::ReadWrite | QIODevice::Unbuffered);
+    QVERIFY(client.waitForConnected(5000));
+    QVERIFY(server.waitForNewConnection(5000));
+    QTcpSocket *peer = server.nextPendingConnection();
+    QVERIFY(peer);
+
+    const QByteArray data = patternData(200000);
+    QVarLengthArray<QByteArrayView, 4> out;
+    out.append(QByteArrayView(data.constData(), 1000));
+    out.append(QByteArrayView(data.constData() + 1000, data.size() - 1000));
+    QCOMPARE(client.write(out), qint64(data.size()));
+
+    QByteArray received;
+    while (received.size() < data.size()) {
+        client.flush(); // whatever the kernel did not take was buffered
+        QVERIFY(peer->waitForReadyRead(5000));
+        received += peer->readAll();
+    }
+    QCOMPARE(received, data);
+
+    // Now the other way round, reading on the unbuffered side.
+    QCOMPARE(peer->write(data.left(5000)), qint64(5000));
+    QVERIFY(peer->waitForBytesWritten(5000));
+    QByteArray in(5000, 'x');
+    QVarLengthArray<QIODevice::Buffer, 4> buffers;
+    QIODevice::Buffer first = { in.data(), 100 };
+    QIODevice::Buffer second = { in.data() + 100, 4900 };
+    buffers.append(first);
+    buffers.append(second);
+
+    QTRY_VERIFY(client.bytesAvailable() >= 5000);
+    QCOMPARE(client.read(buffers), qint64(5000));
+    QCOMPARE(in, data.left(5000));
+}
+
 QTEST_MAIN(tst_QIODevice)
 #include "tst_qiodevice.moc"
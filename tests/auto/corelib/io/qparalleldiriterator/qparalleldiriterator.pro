@@ -0,0 +1,6 @@
+CONFIG += testcase
+CONFIG += parallel_test
+TARGET = tst_qparalleldiriterator
+QT = core testlib
+SOURCES = tst_qparalleldiriterator.cpp
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
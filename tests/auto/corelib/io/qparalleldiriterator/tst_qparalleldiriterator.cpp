@@ -0,0 +1,247 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qdiriterator.h>
+#include <qparalleldiriterator.h>
+#include <qtemporarydir.h>
+#include <qthreadpool.h>
+
+Q_DECLARE_METATYPE(QDirIterator::IteratorFlags)
+Q_DECLARE_METATYPE(QDir::Filters)
+
+class tst_QParallelDirIterator : public QObject
+{
+    Q_OBJECT
+
+private:
+    bool createFile(const QString &fileName)
+    {
+        QFile file(tempDir.path() + QLatin1Char('/') + fileName);
+        return file.open(QIODevice::WriteOnly);
+    }
+
+    bool createDirectory(const QString &dirName)
+    {
+        return QDir(tempDir.path()).mkpath(dirName);
+    }
+
+    QTemporaryDir tempDir;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void sameAsDirIterator_data();
+    void sameAsDirIterator();
+    void fromQDir();
+    void stopLinkLoop();
+    void nonExistingDirectory();
+    void earlyDestruction();
+};
+
+void tst_QParallelDirIterator::initTestCase()
+{
+    QVERIFY(tempDir.isValid());
+
+    for (int i = 0; i < 8; ++i) {
+        const QString dir = QString::fromLatin1("dir%1").arg(i);
+        for (int j = 0; j < 4; ++j) {
+            const QString subDir = dir + QString::fromLatin1("/sub%1").arg(j);
+            QVERIFY(createDirectory(subDir + QLatin1String("/deeper")));
+            QVERIFY(createFile(subDir + QLatin1String("/deeper/leaf.txt")));
+            for (int k = 0; k < 10; ++k) {
+                QVERIFY(createFile(subDir + QString::fromLatin1("/file%1.txt").arg(k)));
+                QVERIFY(createFile(subDir + QString::fromLatin1("/file%1.cpp").arg(k)));
+            }
+        }
+        QVERIFY(createFile(dir + QLatin1String("/.hidden")));
+    }
+    QVERIFY(createDirectory(QLatin1String(".hiddendir")));
+    QVERIFY(createFile(QLatin1String(".hiddendir/inside.txt")));
+    QVERIFY(createDirectory(QLatin1String("empty")));
+    QVERIFY(createFile(QLatin1String("top.txt")));
+}
+
+void tst_QParallelDirIterator::cleanupTestCase()
+{
+    // Let the workers of the iterators destroyed early finish
+    QThreadPool::globalInstance()->waitForDone();
+}
+
+void tst_QParallelDirIterator::sameAsDirIterator_data()
+{
+    QTest::addColumn<QStringList>("nameFilters");
+    QTest::addColumn<QDir::Filters>("filters");
+    QTest::addColumn<QDirIterator::IteratorFlags>("flags");
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("maxQueueSize");
+
+    const QDirIterator::IteratorFlags recursive = QDirIterator::Subdirectories;
+    const QDir::Filters all = QDir::AllEntries | QDir::NoDotAndDotDot;
+
+    QTest::newRow("flat") << QStringList() << QDir::Filters(QDir::NoFilter)
+                          << QDirIterator::IteratorFlags(QDirIterator::NoIteratorFlags) << 4 << 4096;
+    QTest::newRow("recursive") << QStringList() << all << recursive << 4 << 4096;
+    QTest::newRow("recursive-dots") << QStringList() << QDir::Filters(QDir::NoFilter) << recursive << 4 << 4096;
+    QTest::newRow("recursive-hidden") << QStringList() << (all | QDir::Hidden) << recursive << 4 << 4096;
+    QTest::newRow("files") << QStringList() << QDir::Filters(QDir::Files) << recursive << 4 << 4096;
+    QTest::newRow("dirs") << QStringList() << QDir::Filters(QDir::Dirs | QDir::NoDotAndDotDot) << recursive << 4 << 4096;
+    QTest::newRow("name-filter") << (QStringList() << QLatin1String("*.txt")) << QDir::Filters(QDir::Files)
+                                 << recursive << 4 << 4096;
+    QTest::newRow("name-filter-alldirs") << (QStringList() << QLatin1String("*.cpp"))
+                                         << (QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot)
+                                         << recursive << 4 << 4096;
+    QTest::newRow("no-pool") << QStringList() << all << recursive << 0 << 4096;
+    QTest::newRow("one-thread") << QStringList() << all << recursive << 1 << 4096;
+    QTest::newRow("small-queue") << QStringList() << all << recursive << 4 << 1;
+}
+
+void tst_QParallelDirIterator::sameAsDirIterator()
+{
+    QFETCH(QStringList, nameFilters);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QDirIterator::IteratorFlags, flags);
+    QFETCH(int, threads);
+    QFETCH(int, maxQueueSize);
+
+    QStringList expected;
+    QDirIterator dirIt(tempDir.path(), nameFilters, filters, flags);
+    while (dirIt.hasNext())
+        expected << dirIt.next();
+    QVERIFY(!expected.isEmpty());
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, threads));
+
+    QStringList actual;
+    QParallelDirIterator it(tempDir.path(), nameFilters, filters, flags);
+    QCOMPARE(it.threadPool(), QThreadPool::globalInstance());
+    it.setThreadPool(threads ? &pool : 0);
+    it.setMaxQueueSize(maxQueueSize);
+    QCOMPARE(it.maxQueueSize(), maxQueueSize);
+    QCOMPARE(it.path(), tempDir.path());
+    while (it.hasNext()) {
+        const QString path = it.next();
+        QCOMPARE(it.filePath(), path);
+        QCOMPARE(it.fileInfo().filePath(), path);
+        QCOMPARE(it.fileName(), it.fileInfo().fileName());
+        actual << path;
+    }
+    QVERIFY(it.next().isNull());
+    QVERIFY(!it.hasNext());
+
+    expected.sort();
+    actual.sort();
+    QCOMPARE(actual, expected);
+}
+
+void tst_QParallelDirIterator::fromQDir()
+{
+    QDir dir(tempDir.path(), QLatin1String("*.cpp"), QDir::Name, QDir::Files);
+
+    QStringList expected;
+    QDirIterator dirIt(dir, QDirIterator::Subdirectories);
+    while (dirIt.hasNext())
+        expected << dirIt.next();
+
+    QStringList actual;
+    QParallelDirIterator it(dir, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        actual << it.next();
+
+    QCOMPARE(actual.size(), 8 * 4 * 10);
+    expected.sort();
+    actual.sort();
+    QCOMPARE(actual, expected);
+}
+
+void tst_QParallelDirIterator::stopLinkLoop()
+{
+#ifdef Q_OS_UNIX
+    QTemporaryDir loopDir;
+    QVERIFY(loopDir.isValid());
+    QVERIFY(QDir(loopDir.path()).mkpath(QLatin1String("a/b")));
+    QVERIFY(QFile::link(loopDir.path(), loopDir.path() + QLatin1String("/a/b/toRoot")));
+    QVERIFY(QFile::link(QLatin1String(".."), loopDir.path() + QLatin1String("/a/b/toParent")));
+
+    const QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System;
+    const QDirIterator::IteratorFlags flags = QDirIterator::Subdirectories | QDirIterator::FollowSymlinks;
+
+    QStringList expected;
+    QDirIterator dirIt(loopDir.path(), filters, flags);
+    while (dirIt.hasNext())
+        expected << dirIt.next();
+
+    QStringList actual;
+    QParallelDirIterator it(loopDir.path(), filters, flags);
+    while (it.hasNext())
+        actual << it.next();
+
+    expected.sort();
+    actual.sort();
+    QCOMPARE(actual, expected);
+#else
+    QSKIP("Symbolic links are only tested on Unix");
+#endif
+}
+
+void tst_QParallelDirIterator::nonExistingDirectory()
+{
+    QParallelDirIterator it(tempDir.path() + QLatin1String("/does-not-exist"), QDirIterator::Subdirectories);
+    QVERIFY(!it.hasNext());
+    QVERIFY(it.next().isNull());
+    QVERIFY(it.fileInfo().filePath().isEmpty());
+}
+
+void tst_QParallelDirIterator::earlyDestruction()
+{
+    for (int i = 0; i < 20; ++i) {
+        QParallelDirIterator it(tempDir.path(), QDirIterator::Subdirectories);
+        it.setMaxQueueSize(8);
+        for (int j = 0; j < i && it.hasNext(); ++j)
+            it.next();
+    }
+}
+
+QTEST_MAIN(tst_QParallelDirIterator)
+
+#include "tst_qparalleldiriterator.moc"
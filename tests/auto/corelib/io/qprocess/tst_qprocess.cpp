@@ -50,6 +50,9 @@
 #include <QtCore/QMetaType>
 #include <QtNetwork/QHostInfo>
 #include <stdlib.h>
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
 
 #ifndef QT_NO_PROCESS
 # if defined(Q_OS_WIN)
@@ -157,6 +160,10 @@ private slots:
     void onlyOneStartedSignal();
     void finishProcessBeforeReadingDone();
     void waitForStartedWithoutStart();
+#if defined(Q_OS_UNIX) && !defined(Q_OS_QNX)
+    void setNonExistentWorkingDirectory();
+    void setupChildProcess();
+#endif
 
     // keep these at the end, since they use lots of processes and sometimes
     // caused obscure failures to occur in tests that followed them (esp. on the Mac)
@@ -2276,6 +2283,38 @@ void tst_QProcess::waitForStartedWithoutStart()
     QVERIFY(!process.waitForStarted(5000));
 }
 
+#if defined(Q_OS_UNIX) && !defined(Q_OS_QNX)
+void tst_QProcess::setNonExistentWorkingDirectory()
+{
+    QProcess process;
+    process.setWorkingDirectory("this/directory/should/not/exist/for/sure");
+    process.start("testProcessNormal/testProcessNormal");
+    QVERIFY(!process.waitForStarted());
+    QCOMPARE(process.error(), QProcess::FailedToStart);
+    QVERIFY2(process.errorString().startsWith("chdir: "), qPrintable(process.errorString()));
+    QCOMPARE(process.state(), QProcess::NotRunning);
+}
+
+class SetupChildProcess : public QProcess
+{
+protected:
+    void setupChildProcess()
+    {
+        ::write(STDOUT_FILENO, "setup ", 6);
+    }
+};
+
+void tst_QProcess::setupChildProcess()
+{
+    // a reimplemented setupChildProcess() must still run in the child
+    SetupChildProcess process;
+    process.start("testProcessOutput/testProcessOutput");
+    QVERIFY(process.waitForFinished(10000));
+    QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+    QVERIFY(process.readAllStandardOutput().startsWith("setup 0 -this is a number"));
+}
+#endif
+
 #endif //QT_NO_PROCESS
 
 QTEST_MAIN(tst_QProcess)
@@ -460,6 +460,111 @@ void tst_QCoreApplication::deliverInDefinedOrder()
     QObject::connect(&obj, SIGNAL(done()), &app, SLOT(quit()));
     app.exec();
 }
+
+// Queued calls and other events posted by one thread must arrive in the
+// order they were posted, no matter how many threads post at once.
+class SequenceEvent : public QEvent
+{
+public:
+    SequenceEvent(int producer, int sequence)
+        : QEvent(QEvent::User), producer(producer), sequence(sequence)
+    { }
+    int producer;
+    int sequence;
+};
+
+class SequenceReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    SequenceReceiver(int producers, int expected)
+        : next(producers, 0), expected(expected), received(0), outOfOrder(0)
+    { }
+
+    QVector<int> next;
+    int expected;
+    int received;
+    int outOfOrder;
+
+signals:
+    void done();
+
+public slots:
+    void record(int producer, int sequence)
+    {
+        if (next[producer] != sequence)
+            ++outOfOrder;
+        next[producer] = sequence + 1;
+        if (++received == expected)
+            emit done();
+    }
+
+protected:
+    bool event(QEvent *e)
+    {
+        if (e->type() == QEvent::User) {
+            SequenceEvent *se = static_cast<SequenceEvent *>(e);
+            record(se->producer, se->sequence);
+            return true;
+        }
+        return QObject::event(e);
+    }
+};
+
+class SequenceProducer : public QThread
+{
+public:
+    SequenceProducer(SequenceReceiver *receiver, int id, int count)
+        : receiver(receiver), id(id), count(count)
+    { }
+
+protected:
+    void run()
+    {
+        for (int i = 0; i < count; ++i) {
+            // mix queued calls with events that go through the locked path
+            if (i % 10 == 9)
+                QCoreApplication::postEvent(receiver, new SequenceEvent(id, i));
+            else
+                QMetaObject::invokeMethod(receiver, "record", Qt::QueuedConnection,
+                                          Q_ARG(int, id), Q_ARG(int, i));
+        }
+    }
+
+private:
+    SequenceReceiver *receiver;
+    int id;
+    int count;
+};
+
+void tst_QCoreApplication::postFromManyThreads()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    const int producerCount = 8;
+    const int eventCount = 10000;
+    SequenceReceiver receiver(producerCount, producerCount * eventCount);
+    QEventLoop loop;
+    connect(&receiver, SIGNAL(done()), &loop, SLOT(quit()));
+    QTimer::singleShot(60000, &loop, SLOT(quit()));
+
+    QVector<SequenceProducer *> producers;
+    for (int i = 0; i < producerCount; ++i) {
+        producers << new SequenceProducer(&receiver, i, eventCount);
+        producers.last()->start();
+    }
+
+    loop.exec();
+
+    for (int i = 0; i < producerCount; ++i)
+        QVERIFY(producers.at(i)->wait());
+    qDeleteAll(producers);
+
+    QCOMPARE(receiver.received, producerCount * eventCount);
+    QCOMPARE(receiver.outOfOrder, 0);
+}
 #endif // QT_NO_QTHREAD
 
 void tst_QCoreApplication::applicationPid()
@@ -58,6 +58,7 @@ private slots:
     void removePostedEvents();
 #ifndef QT_NO_THREAD
     void deliverInDefinedOrder();
+    void postFromManyThreads();
 #endif
     void applicationPid();
     void globalPostedEventsCount();
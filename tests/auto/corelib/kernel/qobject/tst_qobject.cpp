@@ -154,6 +154,15 @@ private slots:
     void qmlConnect();
     void exceptions();
     void noDeclarativeParentChangedOnDestruction();
+    void queuedCallArguments();
+    void batchedQueuedCalls();
+    void batchedQueuedCallsDeleteReceiver();
+    void batchedQueuedCallsMoveReceiver();
+    void batchedQueuedCallsRemovePostedEvents();
+    void batchedQueuedCallsEventFilter();
+    void queuedCoalescedConnection();
+    void queuedCoalescedConnectionAcrossThreads();
+    void emitWhileConnecting();
 };
 
 struct QObjectCreatedOnShutdown
@@ -6313,6 +6322,454 @@ void tst_QObject::noDeclarativeParentChangedOnDestruction()
 #endif
 }
 
+struct LargeArgument
+{
+    LargeArgument(int value = 0)
+        : value(value)
+    { ++instances; memset(padding, 0, sizeof(padding)); }
+    LargeArgument(const LargeArgument &other)
+        : value(other.value)
+    { ++instances; memset(padding, 0, sizeof(padding)); }
+    ~LargeArgument()
+    { --instances; }
+
+    int value;
+    char padding[60];
+    static int instances;
+};
+int LargeArgument::instances = 0;
+Q_DECLARE_METATYPE(LargeArgument)
+
+class QueuedCallObject : public QObject
+{
+    Q_OBJECT
+public:
+    QueuedCallObject() : metaCallEvents(0), deleteAt(-1), removeAt(-1), moveAt(-1), moveTo(0), calls(0) { }
+
+    int metaCallEvents;
+    int deleteAt;
+    int removeAt;
+    int moveAt;
+    QThread *moveTo;
+    int calls;
+    QList<int> values;
+    QList<QThread *> threads;
+
+    QString string;
+    QVariant variant;
+    QPointF point;
+    double real;
+    LargeArgument large;
+
+    bool event(QEvent *e)
+    {
+        if (e->type() == QEvent::MetaCall)
+            ++metaCallEvents;
+        return QObject::event(e);
+    }
+
+    static int *destroyedCalls;
+    ~QueuedCallObject()
+    {
+        if (destroyedCalls)
+            *destroyedCalls = calls;
+    }
+
+signals:
+    void valueChanged(int value);
+    void manyArguments(int value, const QString &string, const QVariant &variant,
+                       const QPointF &point, double real, const LargeArgument &large);
+
+public slots:
+    void setValue(int value)
+    {
+        ++calls;
+        values.append(value);
+        threads.append(QThread::currentThread());
+        if (calls == deleteAt) {
+            delete this;
+            return;
+        }
+        if (calls == moveAt) {
+            emit valueChanged(-1);
+            moveToThread(moveTo);
+        }
+        if (calls == removeAt)
+            QCoreApplication::removePostedEvents(this, QEvent::MetaCall);
+    }
+
+    void setManyArguments(int value, const QString &string, const QVariant &variant,
+                          const QPointF &point, double real, const LargeArgument &large)
+    {
+        ++calls;
+        values.append(value);
+        this->string = string;
+        this->variant = variant;
+        this->point = point;
+        this->real = real;
+        this->large = large;
+    }
+};
+int *QueuedCallObject::destroyedCalls = 0;
+
+void tst_QObject::queuedCallArguments()
+{
+    qRegisterMetaType<LargeArgument>();
+    const int instancesBefore = LargeArgument::instances;
+    {
+        QueuedCallObject sender;
+        QueuedCallObject receiver;
+        QVERIFY(connect(&sender, SIGNAL(manyArguments(int,QString,QVariant,QPointF,double,LargeArgument)),
+                        &receiver, SLOT(setManyArguments(int,QString,QVariant,QPointF,double,LargeArgument)),
+                        Qt::QueuedConnection));
+
+        emit sender.manyArguments(1, QString("one"), QVariant(QStringList() << "a" << "b"),
+                                  QPointF(1.5, 2.5), 3.25, LargeArgument(42));
+        emit sender.manyArguments(2, QString("two"), QVariant(7), QPointF(), 0.5, LargeArgument(43));
+        QCOMPARE(receiver.calls, 0);
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+
+        QCOMPARE(receiver.calls, 2);
+        QCOMPARE(receiver.values, QList<int>() << 1 << 2);
+        QCOMPARE(receiver.string, QString("two"));
+        QCOMPARE(receiver.variant, QVariant(7));
+        QCOMPARE(receiver.point, QPointF());
+        QCOMPARE(receiver.real, 0.5);
+        QCOMPARE(receiver.large.value, 43);
+
+        // undelivered calls release their arguments
+        emit sender.manyArguments(3, QString("three"), QVariant(), QPointF(), 0, LargeArgument(44));
+    }
+    QCOMPARE(LargeArgument::instances, instancesBefore);
+}
+
+void tst_QObject::batchedQueuedCalls()
+{
+    QueuedCallObject sender;
+    QueuedCallObject receiver;
+    QueuedCallObject other;
+    connect(&sender, SIGNAL(valueChanged(int)), &receiver, SLOT(setValue(int)), Qt::QueuedConnection);
+    connect(&sender, SIGNAL(valueChanged(int)), &other, SLOT(setValue(int)), Qt::QueuedConnection);
+
+    for (int i = 0; i < 10; ++i)
+        emit sender.valueChanged(i);
+    QCoreApplication::sendPostedEvents();
+
+    // the calls alternate between the receivers, so they cannot be batched
+    QCOMPARE(receiver.calls, 10);
+    QCOMPARE(receiver.metaCallEvents, 10);
+    QCOMPARE(other.calls, 10);
+
+    sender.disconnect(&other);
+    receiver.metaCallEvents = 0;
+    receiver.values.clear();
+    for (int i = 0; i < 10; ++i)
+        emit sender.valueChanged(i);
+    QCoreApplication::sendPostedEvents();
+
+    // consecutive calls to one receiver are delivered with a single event, in order
+    QCOMPARE(receiver.metaCallEvents, 1);
+    QCOMPARE(receiver.values.count(), 10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(receiver.values.at(i), i);
+
+    // removing the posted events drops the whole batch
+    receiver.values.clear();
+    for (int i = 0; i < 10; ++i)
+        emit sender.valueChanged(i);
+    QCoreApplication::removePostedEvents(&receiver, QEvent::MetaCall);
+    QCoreApplication::sendPostedEvents();
+    QVERIFY(receiver.values.isEmpty());
+}
+
+void tst_QObject::batchedQueuedCallsDeleteReceiver()
+{
+    int destroyedCalls = -1;
+    QueuedCallObject::destroyedCalls = &destroyedCalls;
+
+    QueuedCallObject sender;
+    QueuedCallObject *receiver = new QueuedCallObject;
+    receiver->deleteAt = 3;
+    connect(&sender, SIGNAL(valueChanged(int)), receiver, SLOT(setValue(int)), Qt::QueuedConnection);
+
+    for (int i = 0; i < 10; ++i)
+        emit sender.valueChanged(i);
+    QCoreApplication::sendPostedEvents();
+
+    QueuedCallObject::destroyedCalls = 0;
+    QCOMPARE(destroyedCalls, 3);
+}
+
+void tst_QObject::batchedQueuedCallsMoveReceiver()
+{
+    QThread thread;
+    thread.start();
+
+    QueuedCallObject sender;
+    QueuedCallObject *receiver = new QueuedCallObject;
+    receiver->moveAt = 3;
+    receiver->moveTo = &thread;
+    connect(&sender, SIGNAL(valueChanged(int)), receiver, SLOT(setValue(int)), Qt::QueuedConnection);
+    connect(receiver, SIGNAL(valueChanged(int)), receiver, SLOT(setValue(int)), Qt::QueuedConnection);
+    connect(&thread, SIGNAL(finished()), receiver, SLOT(deleteLater()));
+
+    for (int i = 0; i < 10; ++i)
+        emit sender.valueChanged(i);
+    QCoreApplication::sendPostedEvents();
+
+    // the remaining calls are delivered in the new thread, before the
+    // call posted while the receiver was being moved
+    QTRY_COMPARE(receiver->calls, 11);
+    for (int i = 0; i < 10; ++i) {
+        QCOMPARE(receiver->values.at(i), i);
+        QCOMPARE(receiver->threads.at(i), i < 3 ? QThread::currentThread() : &thread);
+    }
+    QCOMPARE(receiver->values.at(10), -1);
+
+    thread.quit();
+    QVERIFY(thread.wait());
+}
+
+void tst_QObject::batchedQueuedCallsRemovePostedEvents()
+{
+    QueuedCallObject sender;
+    QueuedCallObject receiver;
+    receiver.removeAt = 3;
+    connect(&sender, SIGNAL(valueChanged(int)), &receiver, SLOT(setValue(int)), Qt::QueuedConnection);
+
+    for (int i = 0; i < 10; ++i)
+        emit sender.valueChanged(i);
+    QCoreApplication::sendPostedEvents();
+
+    // the calls batched behind the current one count as posted events
+    QCOMPARE(receiver.metaCallEvents, 1);
+    QCOMPARE(receiver.calls, 3);
+
+    emit sender.valueChanged(10);
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(receiver.calls, 4);
+    QCOMPARE(receiver.values.last(), 10);
+}
+
+class MetaCallFilter : public QObject
+{
+public:
+    MetaCallFilter() : metaCallEvents(0) { }
+    int metaCallEvents;
+    bool eventFilter(QObject *, QEvent *e)
+    {
+        if (e->type() == QEvent::MetaCall)
+            ++metaCallEvents;
+        return false;
+    }
+};
+
+void tst_QObject::batchedQueuedCallsEventFilter()
+{
+    QueuedCallObject sender;
+    QueuedCallObject receiver;
+    connect(&sender, SIGNAL(valueChanged(int)), &receiver, SLOT(setValue(int)), Qt::QueuedConnection);
+
+    // event filters see every call as an event of its own
+    {
+        MetaCallFilter filter;
+        receiver.installEventFilter(&filter);
+        for (int i = 0; i < 10; ++i)
+            emit sender.valueChanged(i);
+        QCoreApplication::sendPostedEvents();
+        QCOMPARE(filter.metaCallEvents, 10);
+        QCOMPARE(receiver.metaCallEvents, 10);
+    }
+
+    receiver.metaCallEvents = 0;
+    {
+        MetaCallFilter filter;
+        qApp->installEventFilter(&filter);
+        for (int i = 0; i < 10; ++i)
+            emit sender.valueChanged(i);
+        QCoreApplication::sendPostedEvents();
+        QCOMPARE(filter.metaCallEvents, 10);
+        QCOMPARE(receiver.metaCallEvents, 10);
+    }
+
+    receiver.metaCallEvents = 0;
+    for (int i = 0; i < 10; ++i)
+        emit sender.valueChanged(i);
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(receiver.metaCallEvents, 1);
+    QCOMPARE(receiver.calls, 30);
+}
+
+void tst_QObject::queuedCoalescedConnection()
+{
+    QueuedCallObject sender;
+    QueuedCallObject receiver;
+    QVERIFY(connect(&sender, SIGNAL(valueChanged(int)), &receiver, SLOT(setValue(int)),
+                    Qt::QueuedCoalescedConnection));
+
+    for (int i = 0; i < 100; ++i)
+        emit sender.valueChanged(i);
+    QCOMPARE(receiver.calls, 0);
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(receiver.calls, 1);
+    QCOMPARE(receiver.values, QList<int>() << 99);
+
+    emit sender.valueChanged(100);
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(receiver.values, QList<int>() << 99 << 100);
+
+#if defined(Q_COMPILER_LAMBDA)
+    // functor based connections
+    int latest = -1;
+    QObject context;
+    connect(&sender, &QueuedCallObject::valueChanged, &context, [&](int value) {
+        latest = value;
+    }, Qt::QueuedCoalescedConnection);
+    emit sender.valueChanged(1);
+    emit sender.valueChanged(2);
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(latest, 2);
+
+    // an emission while the slot runs is delivered with the next event
+    QList<int> values;
+    QueuedCallObject sender2;
+    connect(&sender2, &QueuedCallObject::valueChanged, &context, [&](int value) {
+        values.append(value);
+        if (value == 1)
+            emit sender2.valueChanged(2);
+    }, Qt::QueuedCoalescedConnection);
+    emit sender2.valueChanged(1);
+    QCoreApplication::sendPostedEvents();
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(values, QList<int>() << 1 << 2);
+#endif
+
+    // pending calls are dropped with the receiver
+    const int instancesBefore = LargeArgument::instances;
+    {
+        QueuedCallObject receiver2;
+        connect(&sender, SIGNAL(manyArguments(int,QString,QVariant,QPointF,double,LargeArgument)),
+                &receiver2, SLOT(setManyArguments(int,QString,QVariant,QPointF,double,LargeArgument)),
+                Qt::QueuedCoalescedConnection);
+        emit sender.manyArguments(1, QString(), QVariant(), QPointF(), 0, LargeArgument(1));
+        emit sender.manyArguments(2, QString(), QVariant(), QPointF(), 0, LargeArgument(2));
+    }
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(LargeArgument::instances, instancesBefore);
+
+    // invokeMethod treats it as a queued connection
+    receiver.values.clear();
+    QVERIFY(QMetaObject::invokeMethod(&receiver, "setValue", Qt::QueuedCoalescedConnection, Q_ARG(int, 5)));
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(receiver.values, QList<int>() << 5);
+}
+
+class CoalescedEmitter : public QThread
+{
+    Q_OBJECT
+public:
+    void run()
+    {
+        for (int i = 1; i <= 10000; ++i)
+            emit valueChanged(i);
+    }
+signals:
+    void valueChanged(int value);
+};
+
+void tst_QObject::queuedCoalescedConnectionAcrossThreads()
+{
+    CoalescedEmitter emitter;
+    QueuedCallObject receiver;
+    connect(&emitter, SIGNAL(valueChanged(int)), &receiver, SLOT(setValue(int)),
+            Qt::QueuedCoalescedConnection);
+
+    emitter.start();
+    QTRY_VERIFY(!receiver.values.isEmpty() && receiver.values.last() == 10000);
+    QVERIFY(emitter.wait());
+    QCoreApplication::sendPostedEvents();
+
+    // every delivered value is newer than the previous one
+    for (int i = 1; i < receiver.values.count(); ++i)
+        QVERIFY(receiver.values.at(i - 1) < receiver.values.at(i));
+    QCOMPARE(receiver.values.last(), 10000);
+}
+
+class ConcurrentSender : public QObject
+{
+    Q_OBJECT
+public:
+    void emitTriggered() { emit triggered(); }
+signals:
+    void triggered();
+};
+
+class ConcurrentReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    QAtomicInt count;
+public slots:
+    void slot() { count.ref(); }
+};
+
+class ConcurrentEmitter : public QThread
+{
+public:
+    ConcurrentEmitter(ConcurrentSender *sender, int count) : sender(sender), count(count) {}
+    void run() Q_DECL_OVERRIDE
+    {
+        for (int i = 0; i < count; ++i)
+            sender->emitTriggered();
+    }
+    ConcurrentSender * const sender;
+    const int count;
+};
+
+static QAtomicInt concurrentFunctionCalls;
+static void concurrentFunction()
+{
+    concurrentFunctionCalls.ref();
+}
+
+void tst_QObject::emitWhileConnecting()
+{
+    // signals are emitted without locking the sender, connect and disconnect
+    // must not disturb the emissions running meanwhile
+    ConcurrentSender sender;
+    ConcurrentReceiver always;
+    QObject::connect(&sender, SIGNAL(triggered()), &always, SLOT(slot()), Qt::DirectConnection);
+
+    const int count = 20000;
+    ConcurrentEmitter emitter1(&sender, count);
+    ConcurrentEmitter emitter2(&sender, count);
+    emitter1.start();
+    emitter2.start();
+
+    ConcurrentReceiver sometimes;
+    int iterations = 0;
+    while (!emitter1.isFinished() || !emitter2.isFinished()) {
+        QMetaObject::Connection slotConnection =
+            QObject::connect(&sender, SIGNAL(triggered()), &sometimes, SLOT(slot()), Qt::DirectConnection);
+        QMetaObject::Connection functionConnection =
+            QObject::connect(&sender, &ConcurrentSender::triggered, concurrentFunction);
+        // let the emitters run with the connections in place
+        QThread::yieldCurrentThread();
+        if (++iterations % 2)
+            QVERIFY(QObject::disconnect(slotConnection));
+        else
+            QVERIFY(QObject::disconnect(&sender, SIGNAL(triggered()), &sometimes, SLOT(slot())));
+        QVERIFY(QObject::disconnect(functionConnection));
+    }
+    QVERIFY(emitter1.wait());
+    QVERIFY(emitter2.wait());
+
+    // the permanent connection saw every emission
+    QCOMPARE(always.count.load(), 2 * count);
+    QVERIFY(sometimes.count.load() <= 2 * count);
+    QVERIFY(concurrentFunctionCalls.load() <= 2 * count);
+}
+
 // Test for QtPrivate::HasQ_OBJECT_Macro
 Q_STATIC_ASSERT(QtPrivate::HasQ_OBJECT_Macro<tst_QObject>::Value);
 Q_STATIC_ASSERT(!QtPrivate::HasQ_OBJECT_Macro<SiblingDeleter>::Value);
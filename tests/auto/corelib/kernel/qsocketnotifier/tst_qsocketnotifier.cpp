@@ -53,6 +53,13 @@
 #ifdef Q_OS_UNIX
 #include <private/qnet_unix_p.h>
 #include <sys/select.h>
+#include <sys/resource.h>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QThread>
+#endif
+#ifdef Q_OS_LINUX
+#include <private/qeventdispatcher_epoll_p.h>
 #endif
 #include <limits>
 
@@ -69,6 +76,7 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+    void epollDispatcher();
 #endif
 };
 
@@ -303,5 +311,137 @@ void tst_QSocketNotifier::posixSockets()
 }
 #endif
 
+#ifdef Q_OS_UNIX
+// Watches more sockets than select() can handle; runs in its own thread
+class ManySocketsTester : public QObject
+{
+    Q_OBJECT
+public:
+    ManySocketsTester(int pairCount) : pairCount(pairCount), activations(0) {}
+
+    int pairCount;
+    int activations;
+    QString error;
+
+public slots:
+    void run()
+    {
+        test();
+        thread()->quit();
+    }
+
+    void readActivated(int fd)
+    {
+        char c;
+        if (::read(fd, &c, 1) == 1)
+            ++activations;
+    }
+
+private:
+    bool processUntil(int count)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (activations < count && !timer.hasExpired(5000))
+            thread()->eventDispatcher()->processEvents(QEventLoop::WaitForMoreEvents);
+        return activations == count;
+    }
+
+    void processPending()
+    {
+        for (int i = 0; i < 3; ++i)
+            thread()->eventDispatcher()->processEvents(QEventLoop::AllEvents);
+    }
+
+    void test()
+    {
+        QVector<int> fds;
+        QList<QSocketNotifier *> notifiers;
+        for (int i = 0; i < pairCount; ++i) {
+            int pair[2];
+            if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == -1) {
+                error = "socketpair failed";
+                break;
+            }
+            fds << pair[0] << pair[1];
+            QSocketNotifier *n = new QSocketNotifier(pair[0], QSocketNotifier::Read, this);
+            connect(n, SIGNAL(activated(int)), SLOT(readActivated(int)));
+            notifiers << n;
+        }
+
+        if (error.isEmpty()) {
+            // wake up a spread of sockets, including the highest ones
+            int expected = 0;
+            for (int i = 0; i < pairCount; i += 17, ++expected)
+                ::write(fds.at(2 * i + 1), "x", 1);
+            if (!processUntil(expected))
+                error = QString("got %1 of %2 activations").arg(activations).arg(expected);
+            processPending();
+            if (error.isEmpty() && activations != expected)
+                error = "spurious activations";
+        }
+
+        if (error.isEmpty()) {
+            // disabled notifiers stay quiet, and fire once enabled again
+            const int count = activations;
+            QSocketNotifier *n = notifiers.last();
+            n->setEnabled(false);
+            ::write(fds.last(), "x", 1);
+            processPending();
+            if (activations != count)
+                error = "disabled notifier was activated";
+            n->setEnabled(true);
+            if (error.isEmpty() && !processUntil(count + 1))
+                error = "re-enabled notifier was not activated";
+        }
+
+        if (error.isEmpty()) {
+            // select() reports regular files as always readable
+            QTemporaryFile file;
+            bool activated = false;
+            if (file.open() && file.write("x", 1) == 1 && file.flush()) {
+                QSocketNotifier n(file.handle(), QSocketNotifier::Read);
+                QSignalSpy spy(&n, SIGNAL(activated(int)));
+                processPending();
+                activated = spy.count() > 0;
+            }
+            if (!activated)
+                error = "regular file notifier was not activated";
+        }
+
+        qDeleteAll(notifiers);
+        for (int i = 0; i < fds.size(); ++i)
+            qt_safe_close(fds.at(i));
+    }
+};
+
+void tst_QSocketNotifier::epollDispatcher()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("epoll(7) is only available on Linux");
+#else
+    // use more descriptors than select() can handle, if we are allowed to
+    rlimit limit;
+    QVERIFY(::getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    if (limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = qMin<rlim_t>(limit.rlim_max, 8192);
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+        ::getrlimit(RLIMIT_NOFILE, &limit);
+    }
+    const int pairCount = int(qMin<rlim_t>(2 * FD_SETSIZE, (limit.rlim_cur - 100) / 2));
+
+    QThread thread;
+    thread.setEventDispatcher(new QEventDispatcherEpoll);
+    ManySocketsTester tester(pairCount);
+    tester.moveToThread(&thread);
+    connect(&thread, SIGNAL(started()), &tester, SLOT(run()));
+    thread.start();
+    QVERIFY(thread.wait(30000));
+
+    QVERIFY2(tester.error.isEmpty(), qPrintable(tester.error));
+#endif
+}
+#endif
+
 QTEST_MAIN(tst_QSocketNotifier)
 #include <tst_qsocketnotifier.moc>
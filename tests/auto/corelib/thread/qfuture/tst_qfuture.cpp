@@ -49,6 +49,7 @@
 #include <qresultstore.h>
 #include <qexception.h>
 #include <private/qfutureinterface_p.h>
+#include <qthreadpool.h>
 
 // COM interface macro.
 #if defined(Q_OS_WIN) && defined(interface)
@@ -76,9 +77,16 @@ private slots:
     void pause();
     void throttling();
     void voidConversions();
+    void then();
+    void thenOnThreadPool();
+    void thenCanceled();
+    void thenParentDestroyed();
+    void whenAll();
+    void whenAny();
 #ifndef QT_NO_EXCEPTIONS
     void exceptions();
     void nestedExceptions();
+    void thenExceptions();
 #endif
 };
 
@@ -1280,6 +1288,265 @@ void tst_QFuture::voidConversions()
 }
 
 
+#if defined(Q_COMPILER_DECLTYPE) && defined(Q_COMPILER_LAMBDA)
+#  define HAVE_CONTINUATIONS
+#endif
+
+void tst_QFuture::then()
+{
+#ifdef HAVE_CONTINUATIONS
+    // continuation runs on the thread that finishes the parent
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        QThread *continuationThread = 0;
+        QFuture<QString> f = i.future().then([&continuationThread](int value) {
+            continuationThread = QThread::currentThread();
+            return QString::number(value * 2);
+        });
+        QVERIFY(f.isRunning());
+        QVERIFY(!f.isFinished());
+
+        i.reportResult(21);
+        QVERIFY(!f.isFinished());
+        i.reportFinished();
+
+        QVERIFY(f.isFinished());
+        QVERIFY(!f.isCanceled());
+        QCOMPARE(f.result(), QString("42"));
+        QCOMPARE(continuationThread, QThread::currentThread());
+    }
+
+    // chaining through void
+    {
+        QFutureInterface<void> i;
+        i.reportStarted();
+        int calls = 0;
+        QFuture<int> f = i.future().then([&calls]() {
+            ++calls;
+        }).then([&calls]() {
+            ++calls;
+            return 7;
+        });
+
+        QCOMPARE(calls, 0);
+        i.reportFinished();
+        QCOMPARE(calls, 2);
+        QCOMPARE(f.result(), 7);
+    }
+
+    // attaching to an already finished future runs the continuation right away
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        i.reportFinished(new int(5));
+        QFuture<int> f = i.future().then([](int value) { return value + 1; });
+        QVERIFY(f.isFinished());
+        QCOMPARE(f.result(), 6);
+    }
+
+    // several continuations on the same future
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        QFuture<int> f1 = i.future().then([](int value) { return value + 1; });
+        QFuture<int> f2 = i.future().then([](int value) { return value + 2; });
+        i.reportResult(1);
+        i.reportFinished();
+        QCOMPARE(f1.result(), 2);
+        QCOMPARE(f2.result(), 3);
+    }
+
+    // the parent's results outlive the last typed interface, as with a
+    // thread engine that drops its typed interface before finishing
+    {
+        QFutureInterface<int> *typed = new QFutureInterface<int>;
+        typed->reportStarted();
+        QFutureInterfaceBase base(*typed);
+        QFuture<int> f = QFuture<int>(typed).then([](int value) { return value * 3; });
+        typed->reportResult(3);
+        delete typed;
+        base.reportFinished();
+        QVERIFY(f.isFinished());
+        QVERIFY(!f.isCanceled());
+        QCOMPARE(f.result(), 9);
+    }
+#else
+    QSKIP("This test requires a compiler that supports decltype and lambdas");
+#endif
+}
+
+void tst_QFuture::thenOnThreadPool()
+{
+#ifdef HAVE_CONTINUATIONS
+    QThreadPool pool;
+    QFutureInterface<int> i;
+    i.reportStarted();
+
+    QThread *mainThread = QThread::currentThread();
+    QFuture<int> f = i.future().then(&pool, [mainThread](int value) {
+        return QThread::currentThread() != mainThread ? value : -1;
+    }).then([](int value) {
+        return value * 10;
+    });
+
+    i.reportResult(4);
+    i.reportFinished();
+    QCOMPARE(f.result(), 40);
+    QVERIFY(pool.waitForDone());
+#else
+    QSKIP("This test requires a compiler that supports decltype and lambdas");
+#endif
+}
+
+void tst_QFuture::thenCanceled()
+{
+#ifdef HAVE_CONTINUATIONS
+    // a canceled parent cancels the continuation without calling it
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        bool called = false;
+        QFuture<void> f = i.future().then([&called](int) { called = true; });
+        i.reportResult(1);
+        i.cancel();
+        QVERIFY(!f.isFinished());
+        i.reportFinished();
+        QVERIFY(f.isFinished());
+        QVERIFY(f.isCanceled());
+        QVERIFY(!called);
+    }
+
+    // a parent without result cancels the continuation
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        bool called = false;
+        QFuture<void> f = i.future().then([&called](int) { called = true; });
+        i.reportFinished();
+        QVERIFY(f.isCanceled());
+        QVERIFY(!called);
+    }
+
+    // canceling the continuation's future skips the call
+    {
+        QFutureInterface<void> i;
+        i.reportStarted();
+        bool called = false;
+        QFuture<void> f = i.future().then([&called]() { called = true; });
+        f.cancel();
+        i.reportFinished();
+        QVERIFY(f.isFinished());
+        QVERIFY(!called);
+    }
+#else
+    QSKIP("This test requires a compiler that supports decltype and lambdas");
+#endif
+}
+
+void tst_QFuture::thenParentDestroyed()
+{
+#ifdef HAVE_CONTINUATIONS
+    QFuture<int> f;
+    {
+        QFutureInterface<int> i;
+        i.reportStarted();
+        f = i.future().then([](int value) { return value; });
+    }
+    QVERIFY(f.isFinished());
+    QVERIFY(f.isCanceled());
+
+    QFuture<QList<QFuture<void> > > all;
+    {
+        QFutureInterface<void> i1;
+        QFutureInterface<void> i2;
+        i1.reportStarted();
+        i2.reportStarted();
+        all = QtFuture::whenAll(QList<QFuture<void> >() << i1.future() << i2.future());
+        i1.reportFinished();
+        QVERIFY(!all.isFinished());
+    }
+    QVERIFY(all.isFinished());
+    QVERIFY(all.isCanceled());
+#else
+    QSKIP("This test requires a compiler that supports decltype and lambdas");
+#endif
+}
+
+void tst_QFuture::whenAll()
+{
+    QList<QFutureInterface<int> > interfaces;
+    QList<QFuture<int> > futures;
+    for (int i = 0; i < 3; ++i) {
+        interfaces.append(QFutureInterface<int>());
+        interfaces[i].reportStarted();
+        futures.append(interfaces[i].future());
+    }
+
+    QFuture<QList<QFuture<int> > > all = QtFuture::whenAll(futures);
+    QVERIFY(all.isRunning());
+
+    interfaces[2].reportFinished(new int(2));
+    interfaces[0].reportFinished(new int(0));
+    QVERIFY(!all.isFinished());
+    interfaces[1].reportFinished(new int(1));
+    QVERIFY(all.isFinished());
+
+    const QList<QFuture<int> > results = all.result();
+    QCOMPARE(results.count(), 3);
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(results.at(i) == futures.at(i));
+        QCOMPARE(results.at(i).result(), i);
+    }
+
+    QFuture<QList<QFuture<int> > > empty = QtFuture::whenAll(QList<QFuture<int> >());
+    QVERIFY(empty.isFinished());
+    QVERIFY(empty.result().isEmpty());
+
+#ifdef HAVE_CONTINUATIONS
+    QFutureInterface<int> a;
+    QFutureInterface<int> b;
+    a.reportStarted();
+    b.reportStarted();
+    QFuture<int> sum = QtFuture::whenAll(QList<QFuture<int> >() << a.future() << b.future())
+            .then([](const QList<QFuture<int> > &futures) {
+        return futures.at(0).result() + futures.at(1).result();
+    });
+    a.reportFinished(new int(3));
+    b.reportFinished(new int(4));
+    QCOMPARE(sum.result(), 7);
+#endif
+}
+
+void tst_QFuture::whenAny()
+{
+    QList<QFutureInterface<int> > interfaces;
+    QList<QFuture<int> > futures;
+    for (int i = 0; i < 3; ++i) {
+        interfaces.append(QFutureInterface<int>());
+        interfaces[i].reportStarted();
+        futures.append(interfaces[i].future());
+    }
+
+    QFuture<QtFuture::WhenAnyResult<int> > any = QtFuture::whenAny(futures);
+    QVERIFY(any.isRunning());
+
+    interfaces[1].reportFinished(new int(10));
+    QVERIFY(any.isFinished());
+    interfaces[0].reportFinished(new int(0));
+    interfaces[2].reportFinished(new int(20));
+
+    const QtFuture::WhenAnyResult<int> result = any.result();
+    QCOMPARE(result.index, 1);
+    QVERIFY(result.future == futures.at(1));
+    QCOMPARE(result.future.result(), 10);
+    QCOMPARE(any.resultCount(), 1);
+
+    QFuture<QtFuture::WhenAnyResult<int> > empty = QtFuture::whenAny(QList<QFuture<int> >());
+    QVERIFY(empty.isFinished());
+    QCOMPARE(empty.resultCount(), 0);
+}
+
 #ifndef QT_NO_EXCEPTIONS
 
 QFuture<void> createExceptionFuture()
@@ -1444,6 +1711,46 @@ void tst_QFuture::nestedExceptions()
     QVERIFY(MyClass::caught);
 }
 
+void tst_QFuture::thenExceptions()
+{
+#ifdef HAVE_CONTINUATIONS
+    // exceptions of the parent are passed on
+    {
+        bool called = false;
+        QFuture<int> f = createExceptionResultFuture().then([&called](int value) {
+            called = true;
+            return value;
+        });
+        QVERIFY(f.isFinished());
+        QVERIFY(!called);
+        bool caught = false;
+        try {
+            f.waitForFinished();
+        } catch (QException &) {
+            caught = true;
+        }
+        QVERIFY(caught);
+    }
+
+    // exceptions thrown by the continuation end up in its future
+    {
+        QFutureInterface<void> i;
+        i.reportStarted();
+        QFuture<void> f = i.future().then([]() { throw DerivedException(); });
+        i.reportFinished();
+        bool caught = false;
+        try {
+            f.waitForFinished();
+        } catch (DerivedException &) {
+            caught = true;
+        }
+        QVERIFY(caught);
+    }
+#else
+    QSKIP("This test requires a compiler that supports decltype and lambdas");
+#endif
+}
+
 #endif // QT_NO_EXCEPTIONS
 
 QTEST_MAIN(tst_QFuture)
@@ -100,6 +100,8 @@ private slots:
     void countingTest();
     void limitedReaders();
     void deleteOnUnlock();
+    void writerTimeoutReleasesReaders_data();
+    void writerTimeoutReleasesReaders();
 
 /*
     Performance tests
@@ -498,6 +500,26 @@ public:
 };
 
 
+/*
+    try to write-lock for timeout msecs
+    unlock
+*/
+class TryWriteLockThread : public QThread
+{
+public:
+    QReadWriteLock &testRwlock;
+    const int timeout;
+    bool result;
+    inline TryWriteLockThread(QReadWriteLock &l, int timeout)
+        : testRwlock(l), timeout(timeout), result(false) { }
+    void run()
+    {
+        result = testRwlock.tryLockForWrite(timeout);
+        if (result)
+            testRwlock.unlock();
+    }
+};
+
 /*
     for(runTime msecs)
         read-lock
@@ -1119,6 +1141,38 @@ void tst_QReadWriteLock::recursiveWriteLock()
     QVERIFY(thread.wait());
 }
 
+void tst_QReadWriteLock::writerTimeoutReleasesReaders_data()
+{
+    QTest::addColumn<int>("recursionMode");
+    QTest::newRow("non-recursive") << int(QReadWriteLock::NonRecursive);
+    QTest::newRow("recursive") << int(QReadWriteLock::Recursive);
+}
+
+/*
+    A reader waits behind a writer that is blocked by another reader. When
+    the writer gives up, the waiting reader gets the lock.
+*/
+void tst_QReadWriteLock::writerTimeoutReleasesReaders()
+{
+    QFETCH(int, recursionMode);
+    QReadWriteLock testLock(static_cast<QReadWriteLock::RecursionMode>(recursionMode));
+    testLock.lockForRead();
+
+    TryWriteLockThread writer(testLock, 500);
+    writer.start();
+    QTest::qSleep(100);
+
+    threadDone = false;
+    ReadLockThread reader(testLock);
+    reader.start();
+
+    QVERIFY(writer.wait());
+    QVERIFY(!writer.result);
+    QVERIFY(reader.wait(5000));
+    QVERIFY(threadDone);
+    testLock.unlock();
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 
 #include "tst_qreadwritelock.moc"
@@ -102,6 +102,9 @@ private slots:
     void waitForDoneTimeout();
     void destroyingWaitsForTasksToFinish();
     void stressTest();
+    void workStealing_data();
+    void workStealing();
+    void workStealingClear();
 
 private:
     QMutex m_functionTestMutex;
@@ -1009,5 +1012,98 @@ void tst_QThreadPool::stressTest()
     }
 }
 
+class SpawningRunnable : public QRunnable
+{
+public:
+    SpawningRunnable(QThreadPool *pool, int depth)
+        : pool(pool), depth(depth)
+    { }
+
+    void run()
+    {
+        if (depth > 0) {
+            // mix in tasks that have to go through the shared queue
+            const int priority = depth % 3 == 0 ? 1 : 0;
+            pool->start(new SpawningRunnable(pool, depth - 1), priority);
+            pool->start(new SpawningRunnable(pool, depth - 1));
+        }
+        count.ref();
+    }
+
+private:
+    QThreadPool *pool;
+    int depth;
+};
+
+void tst_QThreadPool::workStealing_data()
+{
+    QTest::addColumn<int>("maxThreadCount");
+    QTest::addColumn<bool>("workStealing");
+
+    QTest::newRow("1 thread") << 1 << true;
+    QTest::newRow("2 threads") << 2 << true;
+    QTest::newRow("8 threads") << 8 << true;
+    QTest::newRow("8 threads, shared queue") << 8 << false;
+}
+
+void tst_QThreadPool::workStealing()
+{
+    QFETCH(int, maxThreadCount);
+    QFETCH(bool, workStealing);
+
+    QThreadPool threadPool;
+    QVERIFY(!threadPool.isWorkStealingEnabled());
+    threadPool.setWorkStealingEnabled(workStealing);
+    QCOMPARE(threadPool.isWorkStealingEnabled(), workStealing);
+    threadPool.setMaxThreadCount(maxThreadCount);
+
+    const int depth = 14;
+    for (int i = 0; i < 3; ++i) {
+        count.store(0);
+        threadPool.start(new SpawningRunnable(&threadPool, depth));
+        QVERIFY(threadPool.waitForDone(60000));
+        QCOMPARE(count.load(), (2 << depth) - 1);
+        QVERIFY(threadPool.activeThreadCount() == 0);
+    }
+}
+
+void tst_QThreadPool::workStealingClear()
+{
+    class SpawnThenBlockRunnable : public QRunnable
+    {
+    public:
+        SpawnThenBlockRunnable(QThreadPool *pool, QSemaphore &spawned, QSemaphore &release)
+            : pool(pool), spawned(spawned), release(release)
+        { }
+
+        void run()
+        {
+            // these go to this thread's own queue and are never run
+            for (int i = 0; i < 100; ++i)
+                pool->start(new CountingRunnable);
+            spawned.release();
+            release.acquire();
+        }
+
+    private:
+        QThreadPool *pool;
+        QSemaphore &spawned;
+        QSemaphore &release;
+    };
+
+    QSemaphore spawned;
+    QSemaphore release;
+    QThreadPool threadPool;
+    threadPool.setWorkStealingEnabled(true);
+    threadPool.setMaxThreadCount(1);
+    count.store(0);
+    threadPool.start(new SpawnThenBlockRunnable(&threadPool, spawned, release));
+    spawned.acquire();
+    threadPool.clear();
+    release.release();
+    QVERIFY(threadPool.waitForDone(60000));
+    QCOMPARE(count.load(), 0);
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
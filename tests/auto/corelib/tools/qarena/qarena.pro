@@ -0,0 +1,5 @@
+CONFIG += testcase parallel_test
+TARGET = tst_qarena
+QT = core testlib
+SOURCES = tst_qarena.cpp
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -0,0 +1,247 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qarena.h>
+#include <qbytearray.h>
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qvector.h>
+
+#include <list>
+#include <map>
+#include <vector>
+
+class tst_QArena : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void allocate();
+    void alignment();
+    void largeAllocation();
+    void reset();
+    void owner();
+    void deallocate();
+    void deallocateInOtherThread();
+    void allocator();
+};
+
+void tst_QArena::allocate()
+{
+    QArena arena(1024);
+    QCOMPARE(arena.size(), qint64(0));
+    QCOMPARE(arena.capacity(), qint64(0));
+
+    char *a = static_cast<char *>(arena.allocate(10));
+    char *b = static_cast<char *>(arena.allocate(20));
+    QVERIFY(a);
+    QVERIFY(b);
+    QVERIFY(b >= a + 10);
+    QVERIFY(arena.owns(a));
+    QVERIFY(arena.owns(b));
+    QCOMPARE(arena.size(), qint64(30));
+    QCOMPARE(arena.capacity(), qint64(1024));
+
+    memset(a, 'a', 10);
+    memset(b, 'b', 20);
+    QCOMPARE(a[9], 'a');
+    QCOMPARE(b[0], 'b');
+
+    QArena other;
+    void *c = other.allocate(10);
+    QVERIFY(!arena.owns(c));
+    QVERIFY(other.owns(c));
+    QVERIFY(!arena.owns(0));
+}
+
+void tst_QArena::alignment()
+{
+    QArena arena;
+    for (size_t align = 1; align <= 256; align *= 2) {
+        arena.allocate(1, 1);
+        void *p = arena.allocate(3, align);
+        QVERIFY2(!(quintptr(p) & (align - 1)), qPrintable(QString::number(align)));
+    }
+    void *p = arena.allocate(1);
+    QVERIFY(!(quintptr(p) & (QArena::DefaultAlignment - 1)));
+}
+
+void tst_QArena::largeAllocation()
+{
+    QArena arena(512);
+    void *small = arena.allocate(100);
+    void *large = arena.allocate(100000);
+    QVERIFY(arena.owns(small));
+    QVERIFY(arena.owns(large));
+    QVERIFY(arena.capacity() >= 100512);
+    memset(large, 0, 100000);
+
+    // the arena keeps serving from the newest block
+    void *next = arena.allocate(16);
+    QVERIFY(arena.owns(next));
+}
+
+void tst_QArena::reset()
+{
+    QArena arena(256);
+    for (int i = 0; i < 100; ++i)
+        arena.allocate(100);
+    QCOMPARE(arena.size(), qint64(10000));
+    const qint64 capacity = arena.capacity();
+    QVERIFY(capacity >= 10000);
+
+    arena.reset();
+    QCOMPARE(arena.size(), qint64(0));
+    QVERIFY(arena.capacity() > 0);
+    QVERIFY(arena.capacity() <= capacity);
+
+    // a reset arena reuses its remaining block before growing again
+    const qint64 kept = arena.capacity();
+    void *p = arena.allocate(64);
+    QVERIFY(arena.owns(p));
+    QCOMPARE(arena.capacity(), kept);
+}
+
+void tst_QArena::owner()
+{
+    QArena a;
+    QArena b;
+    void *pa = a.allocate(1);
+    void *pb = b.allocate(100, 64);
+    QCOMPARE(QArena::owner(pa), &a);
+    QCOMPARE(QArena::owner(pb), &b);
+    QCOMPARE(QArena::owner(0), static_cast<QArena *>(0));
+
+    // ownership does not depend on which block the memory came from
+    for (int i = 0; i < 100; ++i)
+        a.allocate(1000);
+    QCOMPARE(QArena::owner(pa), &a);
+    QCOMPARE(QArena::owner(a.allocate(1)), &a);
+}
+
+void tst_QArena::deallocate()
+{
+    QArena arena;
+    void *a = arena.allocate(16);
+    void *b = arena.allocate(32);
+    QCOMPARE(arena.size(), qint64(48));
+
+    // the most recent allocation is handed back to the block
+    arena.deallocate(b);
+    QCOMPARE(arena.size(), qint64(16));
+    QCOMPARE(arena.allocate(32), b);
+
+    // older ones are only accounted for
+    arena.deallocate(a);
+    QCOMPARE(arena.size(), qint64(32));
+    QVERIFY(arena.allocate(16) != a);
+
+    arena.deallocate(0);
+    QCOMPARE(arena.size(), qint64(48));
+}
+
+class ReleasingThread : public QThread
+{
+public:
+    void run()
+    {
+        for (int i = 0; i < pointers.size(); ++i)
+            QArena::owner(pointers.at(i))->deallocate(pointers.at(i));
+    }
+    QVector<void *> pointers;
+};
+
+void tst_QArena::deallocateInOtherThread()
+{
+    QArena arena(256);
+    ReleasingThread thread;
+    for (int i = 0; i < 1000; ++i)
+        thread.pointers.append(arena.allocate(i % 50));
+    void *kept = arena.allocate(24);
+    const qint64 size = arena.size();
+
+    thread.start();
+    QVERIFY(thread.wait());
+    QCOMPARE(arena.size(), qint64(24));
+    QVERIFY(arena.size() < size);
+    QVERIFY(arena.owns(kept));
+
+    // releases from other threads are collected by the arena's thread
+    arena.deallocate(kept);
+    QCOMPARE(arena.size(), qint64(0));
+    arena.allocate(100000);
+    QCOMPARE(arena.size(), qint64(100000));
+}
+
+void tst_QArena::allocator()
+{
+    QArena arena;
+
+    std::vector<int, QArenaAllocator<int> > v((QArenaAllocator<int>(&arena)));
+    for (int i = 0; i < 1000; ++i)
+        v.push_back(i);
+    QVERIFY(arena.owns(&v.front()));
+    QCOMPARE(v.at(999), 999);
+
+    typedef std::map<int, QByteArray, std::less<int>,
+                     QArenaAllocator<std::pair<const int, QByteArray> > > Map;
+    Map m((std::less<int>()), Map::allocator_type(&arena));
+    for (int i = 0; i < 100; ++i)
+        m[i] = QByteArray::number(i);
+    QCOMPARE(m[42], QByteArray("42"));
+    m.erase(42);
+    QCOMPARE(m.size(), size_t(99));
+
+    std::list<QByteArray, QArenaAllocator<QByteArray> > l((QArenaAllocator<QByteArray>(&arena)));
+    const qint64 used = arena.size();
+    l.push_back("x");
+    QVERIFY(arena.size() > used);
+    QVERIFY(l.get_allocator() == QArenaAllocator<int>(&arena));
+
+    l.clear();
+    m.clear();
+    std::vector<int, QArenaAllocator<int> >(v.get_allocator()).swap(v);
+    QCOMPARE(arena.size(), qint64(0));
+}
+
+QTEST_APPLESS_MAIN(tst_QArena)
+#include "tst_qarena.moc"
@@ -110,6 +110,7 @@ private slots:
     void indexOf();
     void lastIndexOf_data();
     void lastIndexOf();
+    void countChar();
     void toULong_data();
     void toULong();
     void toULongLong_data();
@@ -1209,6 +1210,26 @@ void tst_QByteArray::lastIndexOf()
     }
 }
 
+void tst_QByteArray::countChar()
+{
+    // long enough for the per-lane counters to be flushed more than once
+    QByteArray ba;
+    int expected = 0;
+    for (int i = 0; i < 20000; ++i) {
+        const char c = (i % 7 == 0 || i % 251 == 0) ? '\n' : char('a' + i % 26);
+        if (c == '\n')
+            ++expected;
+        ba += c;
+    }
+    QCOMPARE(ba.count('\n'), expected);
+    for (int len = 0; len < 100; ++len) {
+        const QByteArray part = ba.mid(3, len);
+        QCOMPARE(part.count('\n'), part.count(QByteArray("\n")));
+    }
+    QCOMPARE(QByteArray(1000, '\xff').count('\xff'), 1000);
+    QCOMPARE(QByteArray().count('a'), 0);
+}
+
 void tst_QByteArray::number()
 {
     QCOMPARE(QString(QByteArray::number((quint64) 0)),
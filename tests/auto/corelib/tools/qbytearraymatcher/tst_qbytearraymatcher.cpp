@@ -56,6 +56,7 @@ class tst_QByteArrayMatcher : public QObject
 private slots:
     void interface();
     void indexIn();
+    void indexInAllPositions();
 };
 
 static QByteArrayMatcher matcher1;
@@ -125,5 +126,45 @@ void tst_QByteArrayMatcher::indexIn()
     QCOMPARE(matcher.indexIn(haystack, 2), 5);
 }
 
+static int naiveIndexOf(const QByteArray &haystack, const QByteArray &needle, int from)
+{
+    for (int i = from; i + needle.size() <= haystack.size(); ++i) {
+        if (memcmp(haystack.constData() + i, needle.constData(), needle.size()) == 0)
+            return i;
+    }
+    return -1;
+}
+
+void tst_QByteArrayMatcher::indexInAllPositions()
+{
+    // exercise every offset relative to the vector blocks, with a haystack
+    // full of candidates that match the first and the last byte only
+    for (int needleSize = 1; needleSize <= 40; needleSize += 3) {
+        QByteArray needle(needleSize, 'x');
+        needle[0] = 'a';
+        needle[needleSize - 1] = 'z';
+        QByteArray filler;
+        while (filler.size() < 100)
+            filler += needle.left(needleSize - 1) + 'a';
+        filler.truncate(100);
+
+        const QByteArrayMatcher matcher(needle);
+        for (int pos = 0; pos <= filler.size(); ++pos) {
+            QByteArray haystack = filler;
+            haystack.insert(pos, needle);
+            for (int from = 0; from < haystack.size(); from += 13) {
+                const int expected = naiveIndexOf(haystack, needle, from);
+                QCOMPARE(matcher.indexIn(haystack, from), expected);
+                QCOMPARE(matcher.indexIn(haystack.constData(), haystack.size(), from), expected);
+                QCOMPARE(haystack.indexOf(needle, from), expected);
+            }
+            // a truncated occurrence at the end must not be reported
+            const QByteArray cut = haystack.left(pos + needleSize - 1);
+            QCOMPARE(matcher.indexIn(cut), naiveIndexOf(cut, needle, 0));
+            QCOMPARE(cut.indexOf(needle), naiveIndexOf(cut, needle, 0));
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QByteArrayMatcher)
 #include "tst_qbytearraymatcher.moc"
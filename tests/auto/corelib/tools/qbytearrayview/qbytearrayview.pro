@@ -0,0 +1,5 @@
+CONFIG += testcase parallel_test
+TARGET = tst_qbytearrayview
+QT = core testlib
+SOURCES = tst_qbytearrayview.cpp
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -0,0 +1,338 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qbytearray.h>
+#include <qhash.h>
+
+class tst_QByteArrayView : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void constructors();
+    void slicing_data();
+    void slicing();
+    void trimmed_data();
+    void trimmed();
+    void truncateAndChop();
+    void indexOf_data();
+    void indexOf();
+    void lastIndexOf();
+    void startsWithEndsWith();
+    void compare_data();
+    void compare();
+    void toNumber_data();
+    void toNumber();
+    void toDouble();
+    void hash();
+};
+
+void tst_QByteArrayView::constructors()
+{
+    QByteArrayView null;
+    QVERIFY(null.isNull());
+    QVERIFY(null.isEmpty());
+    QCOMPARE(null.size(), 0);
+    QVERIFY(QByteArrayView(QByteArray()).isNull());
+    QVERIFY(QByteArrayView(static_cast<const char *>(0)).isNull());
+
+    QByteArrayView empty("");
+    QVERIFY(!empty.isNull());
+    QVERIFY(empty.isEmpty());
+
+    const QByteArray ba("Hello World");
+    QByteArrayView v(ba);
+    QCOMPARE(v.size(), ba.size());
+    QCOMPARE(v.length(), ba.size());
+    QVERIFY(v.data() == ba.constData());
+    QCOMPARE(v.at(4), 'o');
+    QCOMPARE(v[6], 'W');
+
+    const char *literal = "literal";
+    QByteArrayView fromLiteral(literal);
+    QCOMPARE(fromLiteral.size(), 7);
+    QVERIFY(fromLiteral.data() == literal);
+
+    QByteArrayView withNul("a\0b", 3);
+    QCOMPARE(withNul.size(), 3);
+    QCOMPARE(withNul.toByteArray(), QByteArray("a\0b", 3));
+
+    QByteArray iterated;
+    for (QByteArrayView::const_iterator it = v.begin(); it != v.end(); ++it)
+        iterated += *it;
+    QCOMPARE(iterated, ba);
+}
+
+void tst_QByteArrayView::slicing_data()
+{
+    QTest::addColumn<int>("pos");
+    QTest::addColumn<int>("n");
+
+    QTest::newRow("all") << 0 << -1;
+    QTest::newRow("middle") << 3 << 4;
+    QTest::newRow("tail") << 5 << -1;
+    QTest::newRow("past-end") << 20 << 2;
+    QTest::newRow("negative-pos") << -2 << 5;
+    QTest::newRow("negative-both") << -3 << -1;
+    QTest::newRow("too-long") << 8 << 100;
+    QTest::newRow("empty") << 11 << 3;
+}
+
+void tst_QByteArrayView::slicing()
+{
+    QFETCH(int, pos);
+    QFETCH(int, n);
+
+    const QByteArray ba("Hello World");
+    const QByteArrayView v(ba);
+
+    QCOMPARE(v.mid(pos, n).toByteArray(), ba.mid(pos, n));
+    QCOMPARE(v.left(pos).toByteArray(), ba.left(pos));
+    QCOMPARE(v.right(pos).toByteArray(), ba.right(pos));
+}
+
+void tst_QByteArrayView::trimmed_data()
+{
+    QTest::addColumn<QByteArray>("input");
+
+    QTest::newRow("empty") << QByteArray("");
+    QTest::newRow("blank") << QByteArray(" \t\n ");
+    QTest::newRow("none") << QByteArray("abc");
+    QTest::newRow("both") << QByteArray("  a b c\t");
+    QTest::newRow("leading") << QByteArray("\n\nabc");
+    QTest::newRow("trailing") << QByteArray("abc  ");
+}
+
+void tst_QByteArrayView::trimmed()
+{
+    QFETCH(QByteArray, input);
+
+    const QByteArrayView v(input);
+    const QByteArrayView t = v.trimmed();
+    QCOMPARE(t.toByteArray(), input.trimmed());
+    QVERIFY(t.isEmpty() || (t.data() >= v.data() && t.end() <= v.end()));
+}
+
+void tst_QByteArrayView::truncateAndChop()
+{
+    QByteArrayView v("abcdef");
+    v.truncate(10);
+    QCOMPARE(v.size(), 6);
+    v.truncate(4);
+    QVERIFY(v == "abcd");
+    v.chop(1);
+    QVERIFY(v == "abc");
+    v.chop(-1);
+    QCOMPARE(v.size(), 3);
+    v.chop(10);
+    QVERIFY(v.isEmpty());
+    QVERIFY(!v.isNull());
+}
+
+void tst_QByteArrayView::indexOf_data()
+{
+    QTest::addColumn<QByteArray>("haystack");
+    QTest::addColumn<QByteArray>("needle");
+    QTest::addColumn<int>("from");
+
+    QTest::newRow("simple") << QByteArray("Hello World") << QByteArray("World") << 0;
+    QTest::newRow("from") << QByteArray("abcabc") << QByteArray("bc") << 2;
+    QTest::newRow("missing") << QByteArray("abcabc") << QByteArray("cd") << 0;
+    QTest::newRow("char") << QByteArray("Hello World") << QByteArray("o") << 5;
+    QTest::newRow("char-missing") << QByteArray("Hello World") << QByteArray("z") << 0;
+    QTest::newRow("negative-from") << QByteArray("abcabc") << QByteArray("a") << -3;
+    QTest::newRow("empty-needle") << QByteArray("abc") << QByteArray("") << 1;
+    QTest::newRow("past-end") << QByteArray("abc") << QByteArray("bc") << 5;
+    QTest::newRow("long") << QByteArray(600, 'x') + "needle" << QByteArray("needle") << 0;
+}
+
+void tst_QByteArrayView::indexOf()
+{
+    QFETCH(QByteArray, haystack);
+    QFETCH(QByteArray, needle);
+    QFETCH(int, from);
+
+    const int expected = haystack.indexOf(needle, from);
+    const QByteArrayView v(haystack);
+
+    QCOMPARE(v.indexOf(QByteArrayView(needle), from), expected);
+    QCOMPARE(v.indexOf(needle, from), expected);
+    QCOMPARE(v.indexOf(needle.constData(), from), expected);
+    QCOMPARE(v.contains(QByteArrayView(needle)), haystack.contains(needle));
+    QCOMPARE(v.contains(needle), haystack.contains(needle));
+    if (needle.size() == 1) {
+        QCOMPARE(v.indexOf(needle.at(0), from), expected);
+        QCOMPARE(v.contains(needle.at(0)), haystack.contains(needle.at(0)));
+    }
+}
+
+void tst_QByteArrayView::lastIndexOf()
+{
+    const QByteArray ba("a,b,c,d");
+    const QByteArrayView v(ba);
+    QCOMPARE(v.lastIndexOf(','), ba.lastIndexOf(','));
+    QCOMPARE(v.lastIndexOf(',', 4), ba.lastIndexOf(',', 4));
+    QCOMPARE(v.lastIndexOf(',', -3), ba.lastIndexOf(',', -3));
+    QCOMPARE(v.lastIndexOf(',', 100), ba.lastIndexOf(',', 100));
+    QCOMPARE(v.lastIndexOf('x'), -1);
+    QCOMPARE(QByteArrayView().lastIndexOf('a'), -1);
+}
+
+void tst_QByteArrayView::startsWithEndsWith()
+{
+    const QByteArrayView v("Hello World");
+
+    QVERIFY(v.startsWith("Hello"));
+    QVERIFY(v.startsWith(QByteArray("Hell")));
+    QVERIFY(v.startsWith(""));
+    QVERIFY(!v.startsWith("hello"));
+    QVERIFY(!v.startsWith("Hello World!"));
+    QVERIFY(v.startsWith('H'));
+    QVERIFY(!v.startsWith('h'));
+
+    QVERIFY(v.endsWith("World"));
+    QVERIFY(v.endsWith(QByteArray("ld")));
+    QVERIFY(v.endsWith(""));
+    QVERIFY(!v.endsWith("world"));
+    QVERIFY(v.endsWith('d'));
+    QVERIFY(!v.endsWith('D'));
+
+    QVERIFY(!QByteArrayView().startsWith('a'));
+    QVERIFY(!QByteArrayView().endsWith('a'));
+}
+
+void tst_QByteArrayView::compare_data()
+{
+    QTest::addColumn<QByteArray>("a1");
+    QTest::addColumn<QByteArray>("a2");
+
+    QTest::newRow("equal") << QByteArray("abc") << QByteArray("abc");
+    QTest::newRow("less") << QByteArray("abc") << QByteArray("abd");
+    QTest::newRow("greater") << QByteArray("abd") << QByteArray("abc");
+    QTest::newRow("prefix") << QByteArray("ab") << QByteArray("abc");
+    QTest::newRow("empty") << QByteArray("") << QByteArray("a");
+    QTest::newRow("high-bit") << QByteArray("\x80") << QByteArray("\x7f");
+}
+
+void tst_QByteArrayView::compare()
+{
+    QFETCH(QByteArray, a1);
+    QFETCH(QByteArray, a2);
+
+    const QByteArrayView v1(a1);
+    const QByteArrayView v2(a2);
+
+    QCOMPARE(v1 == v2, a1 == a2);
+    QCOMPARE(v1 != v2, a1 != a2);
+    QCOMPARE(v1 < v2, a1 < a2);
+    QCOMPARE(v1 <= v2, a1 <= a2);
+    QCOMPARE(v1 > v2, a1 > a2);
+    QCOMPARE(v1 >= v2, a1 >= a2);
+    QCOMPARE(v1.compare(v2) == 0, a1 == a2);
+    QCOMPARE(v1 == a2.constData(), a1 == a2);
+}
+
+void tst_QByteArrayView::toNumber_data()
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<int>("base");
+
+    QTest::newRow("int") << QByteArray("1234") << 10;
+    QTest::newRow("negative") << QByteArray("-42") << 10;
+    QTest::newRow("spaces") << QByteArray("  17 ") << 10;
+    QTest::newRow("hex") << QByteArray("ff") << 16;
+    QTest::newRow("auto-hex") << QByteArray("0x1F") << 0;
+    QTest::newRow("overflow-int") << QByteArray("4294967296") << 10;
+    QTest::newRow("overflow-short") << QByteArray("70000") << 10;
+    QTest::newRow("garbage") << QByteArray("12a") << 10;
+    QTest::newRow("empty") << QByteArray("") << 10;
+    QTest::newRow("long") << QByteArray(100, ' ') + "99" << 10;
+}
+
+void tst_QByteArrayView::toNumber()
+{
+    QFETCH(QByteArray, input);
+    QFETCH(int, base);
+
+    // embed the number so that the view is not '\0'-terminated
+    const QByteArray padded = input + "123";
+    const QByteArrayView v = QByteArrayView(padded).left(input.size());
+    bool ok1, ok2;
+
+    QCOMPARE(v.toShort(&ok1, base), input.toShort(&ok2, base));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(v.toUShort(&ok1, base), input.toUShort(&ok2, base));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(v.toInt(&ok1, base), input.toInt(&ok2, base));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(v.toUInt(&ok1, base), input.toUInt(&ok2, base));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(v.toLongLong(&ok1, base), input.toLongLong(&ok2, base));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(v.toULongLong(&ok1, base), input.toULongLong(&ok2, base));
+    QCOMPARE(ok1, ok2);
+}
+
+void tst_QByteArrayView::toDouble()
+{
+    const QByteArrayView v("x=3.25;y=-1e3;z=oops");
+    bool ok;
+
+    QCOMPARE(v.mid(2, 4).toDouble(&ok), 3.25);
+    QVERIFY(ok);
+    QCOMPARE(v.mid(9, 4).toDouble(&ok), -1000.0);
+    QVERIFY(ok);
+    QCOMPARE(v.mid(16).toDouble(&ok), 0.0);
+    QVERIFY(!ok);
+    QCOMPARE(v.mid(2, 4).toFloat(&ok), 3.25f);
+    QVERIFY(ok);
+}
+
+void tst_QByteArrayView::hash()
+{
+    const QByteArray ba("key=value");
+    QCOMPARE(qHash(QByteArrayView(ba)), qHash(ba));
+    QCOMPARE(qHash(QByteArrayView(ba).left(3), 42), qHash(QByteArray("key"), 42));
+}
+
+QTEST_APPLESS_MAIN(tst_QByteArrayView)
+#include "tst_qbytearrayview.moc"
@@ -52,11 +52,31 @@ private slots:
     void intermediary_result_data();
     void intermediary_result();
     void sha1();
+    void sha256();
     void sha3();
+    void chunks_data();
+    void chunks();
+    void multiBuffer_data();
+    void multiBuffer();
     void files_data();
     void files();
+    void largeFile_data();
+    void largeFile();
 };
 
+static QByteArray testData(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    uint x = 0x9e3779b9;
+    for (int i = 0; i < size; ++i) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        data[i] = char(x);
+    }
+    return data;
+}
+
 void tst_QCryptographicHash::repeated_result_data()
 {
     intermediary_result_data();
@@ -185,6 +205,22 @@ void tst_QCryptographicHash::sha1()
              QByteArray("34AA973CD4C4DAA4F61EEB2BDBAD27316534016F"));
 }
 
+void tst_QCryptographicHash::sha256()
+{
+    // FIPS 180-2, appendix B
+    QCOMPARE(QCryptographicHash::hash("abc", QCryptographicHash::Sha256).toHex(),
+             QByteArray("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    QCOMPARE(QCryptographicHash::hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+                                      QCryptographicHash::Sha256).toHex(),
+             QByteArray("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+
+    const QByteArray as(1000000, 'a');
+    QCOMPARE(QCryptographicHash::hash(as, QCryptographicHash::Sha256).toHex(),
+             QByteArray("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+    QCOMPARE(QCryptographicHash::hash(as, QCryptographicHash::Sha224).toHex(),
+             QByteArray("20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67"));
+}
+
 void tst_QCryptographicHash::sha3()
 {
     // SHA3-224("The quick brown fox jumps over the lazy dog")
@@ -237,6 +273,79 @@ void tst_QCryptographicHash::sha3()
 
 Q_DECLARE_METATYPE(QCryptographicHash::Algorithm);
 
+static void addAlgorithmRows()
+{
+    QTest::newRow("md5") << QCryptographicHash::Md5;
+    QTest::newRow("sha1") << QCryptographicHash::Sha1;
+    QTest::newRow("sha224") << QCryptographicHash::Sha224;
+    QTest::newRow("sha256") << QCryptographicHash::Sha256;
+    QTest::newRow("sha512") << QCryptographicHash::Sha512;
+    QTest::newRow("sha3_256") << QCryptographicHash::Sha3_256;
+}
+
+void tst_QCryptographicHash::chunks_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    addAlgorithmRows();
+}
+
+void tst_QCryptographicHash::chunks()
+{
+    // whole blocks and the partial blocks around them take different
+    // paths, so feed the data in every kind of chunk size
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    const QByteArray data = testData(20000);
+    const QByteArray expected = QCryptographicHash::hash(data, algorithm);
+
+    static const int chunkSizes[] = { 1, 3, 55, 56, 63, 64, 65, 127, 128, 129, 1000, 4096 };
+    for (uint i = 0; i < sizeof chunkSizes / sizeof *chunkSizes; ++i) {
+        QCryptographicHash hash(algorithm);
+        for (int pos = 0; pos < data.size(); pos += chunkSizes[i])
+            hash.addData(data.constData() + pos, qMin(chunkSizes[i], data.size() - pos));
+        QCOMPARE(hash.result().toHex(), expected.toHex());
+    }
+
+    // alternating sizes keep the buffered remainder moving
+    QCryptographicHash hash(algorithm);
+    for (int pos = 0, n = 1; pos < data.size(); pos += n, n = (n * 7 + 3) % 300)
+        hash.addData(data.constData() + pos, qMin(n, data.size() - pos));
+    QCOMPARE(hash.result().toHex(), expected.toHex());
+}
+
+void tst_QCryptographicHash::multiBuffer_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    addAlgorithmRows();
+}
+
+void tst_QCryptographicHash::multiBuffer()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+
+    QCOMPARE(QCryptographicHash::hash(QList<QByteArray>(), algorithm), QList<QByteArray>());
+
+    // a mix of sizes around the padding boundaries, with a few long items
+    // so that lanes finish at different times and get refilled
+    QList<QByteArray> data;
+    const QByteArray source = testData(70000);
+    static const int sizes[] = { 0, 1, 3, 55, 56, 57, 63, 64, 65, 119, 120, 128, 200, 1000,
+                                 4095, 4096, 4097, 65536, 0, 17, 64, 64, 64, 64, 64, 64, 64,
+                                 64, 12345, 2 };
+    for (uint i = 0; i < sizeof sizes / sizeof *sizes; ++i)
+        data << source.mid(int(i) * 7, sizes[i]);
+
+    const QList<QByteArray> results = QCryptographicHash::hash(data, algorithm);
+    QCOMPARE(results.size(), data.size());
+    for (int i = 0; i < data.size(); ++i)
+        QCOMPARE(results.at(i).toHex(), QCryptographicHash::hash(data.at(i), algorithm).toHex());
+
+    // a single item goes through the same API
+    QList<QByteArray> one;
+    one << QByteArray("abc");
+    QCOMPARE(QCryptographicHash::hash(one, algorithm),
+             QList<QByteArray>() << QCryptographicHash::hash("abc", algorithm));
+}
+
 void tst_QCryptographicHash::files_data() {
     QTest::addColumn<QString>("filename");
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
@@ -266,6 +375,34 @@ void tst_QCryptographicHash::files()
     }
 }
 
+void tst_QCryptographicHash::largeFile_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    addAlgorithmRows();
+}
+
+void tst_QCryptographicHash::largeFile()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    const QByteArray data = testData(3 * 1024 * 1024 + 123);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), qint64(data.size()));
+    QVERIFY(file.seek(0));
+
+    QCryptographicHash hash(algorithm);
+    QVERIFY(hash.addData(&file));
+    QVERIFY(file.atEnd());
+    QCOMPARE(hash.result().toHex(), QCryptographicHash::hash(data, algorithm).toHex());
+
+    // start in the middle of the file, after some buffered reading
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.read(1000), data.left(1000));
+    hash.reset();
+    QVERIFY(hash.addData(&file));
+    QCOMPARE(hash.result().toHex(), QCryptographicHash::hash(data.mid(1000), algorithm).toHex());
+}
 
 QTEST_MAIN(tst_QCryptographicHash)
 #include "tst_qcryptographichash.moc"
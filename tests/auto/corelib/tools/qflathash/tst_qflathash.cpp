@@ -0,0 +1,520 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qflathash.h>
+#include <qhash.h>
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insert();
+    void insertReplaces();
+    void operator_bracket();
+    void remove();
+    void take();
+    void erase();
+    void clear();
+    void reserveAndSqueeze();
+    void copyOnWrite();
+    void operator_eq();
+    void iterators();
+    void javaIterators();
+    void keysAndValues();
+    void complexType();
+    void manyTombstones();
+    void compareWithQHash();
+    void initializerList();
+
+    void flatSet();
+};
+
+struct Counted
+{
+    static int count;
+    int value;
+
+    Counted(int v = 0) : value(v) { ++count; }
+    Counted(const Counted &other) : value(other.value) { ++count; }
+    ~Counted() { --count; }
+    Counted &operator=(const Counted &other) { value = other.value; return *this; }
+    bool operator==(const Counted &other) const { return value == other.value; }
+};
+int Counted::count = 0;
+
+inline uint qHash(const Counted &c, uint seed = 0)
+{
+    // deliberately poor, so that everything collides in H2
+    return qHash(c.value & ~0x7f, seed);
+}
+
+void tst_QFlatHash::insert()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.size(), 0);
+    QVERIFY(!hash.contains(42));
+    QCOMPARE(hash.value(42), 0);
+    QCOMPARE(hash.value(42, -1), -1);
+
+    for (int i = 0; i < 1000; ++i) {
+        QFlatHash<int, int>::iterator it = hash.insert(i, i * 2);
+        QCOMPARE(it.key(), i);
+        QCOMPARE(it.value(), i * 2);
+        QCOMPARE(hash.size(), i + 1);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        QVERIFY(hash.contains(i));
+        QCOMPARE(hash.count(i), 1);
+        QCOMPARE(hash.value(i), i * 2);
+    }
+    QVERIFY(!hash.contains(1000));
+    QVERIFY(!hash.contains(-1));
+    QVERIFY(hash.capacity() >= hash.size());
+}
+
+void tst_QFlatHash::insertReplaces()
+{
+    QFlatHash<QString, int> hash;
+    hash.insert("one", 1);
+    hash.insert("two", 2);
+    hash.insert("one", 11);
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value("one"), 11);
+    QCOMPARE(hash.value("two"), 2);
+}
+
+void tst_QFlatHash::operator_bracket()
+{
+    QFlatHash<QString, int> hash;
+    hash["a"] = 1;
+    ++hash["a"];
+    hash["b"];
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value("a"), 2);
+    QVERIFY(hash.contains("b"));
+    QCOMPARE(hash.value("b"), 0);
+
+    const QFlatHash<QString, int> &constHash = hash;
+    QCOMPARE(constHash["c"], 0);
+    QCOMPARE(hash.size(), 2);
+}
+
+void tst_QFlatHash::remove()
+{
+    QFlatHash<int, QString> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, QString::number(i));
+
+    QCOMPARE(hash.remove(1000), 0);
+    for (int i = 0; i < 100; i += 2)
+        QCOMPARE(hash.remove(i), 1);
+    QCOMPARE(hash.size(), 50);
+    for (int i = 0; i < 100; ++i) {
+        QCOMPARE(hash.contains(i), bool(i & 1));
+        if (i & 1)
+            QCOMPARE(hash.value(i), QString::number(i));
+    }
+
+    QFlatHash<int, QString> empty;
+    QCOMPARE(empty.remove(1), 0);
+}
+
+void tst_QFlatHash::take()
+{
+    QFlatHash<int, QString> hash;
+    hash.insert(1, "one");
+    hash.insert(2, "two");
+
+    QCOMPARE(hash.take(1), QString("one"));
+    QCOMPARE(hash.take(1), QString());
+    QCOMPARE(hash.size(), 1);
+    QVERIFY(!hash.contains(1));
+    QVERIFY(hash.contains(2));
+}
+
+void tst_QFlatHash::erase()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i);
+
+    QFlatHash<int, int> copy = hash;
+
+    QFlatHash<int, int>::iterator it = hash.begin();
+    while (it != hash.end()) {
+        if (it.key() % 3 == 0)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(hash.size(), 66);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.contains(i), i % 3 != 0);
+
+    // the copy was not affected
+    QCOMPARE(copy.size(), 100);
+
+    // erasing through a shared iterator detaches
+    QFlatHash<int, int> shared = copy;
+    QFlatHash<int, int>::iterator sit = shared.find(5);
+    QVERIFY(sit != shared.end());
+    shared.erase(sit);
+    QCOMPARE(shared.size(), 99);
+    QVERIFY(!shared.contains(5));
+    QCOMPARE(copy.size(), 100);
+    QVERIFY(copy.contains(5));
+}
+
+void tst_QFlatHash::clear()
+{
+    QFlatHash<int, int> hash;
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+
+    for (int i = 0; i < 10; ++i)
+        hash.insert(i, i);
+    QFlatHash<int, int> copy = hash;
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.capacity(), 0);
+    QCOMPARE(copy.size(), 10);
+
+    hash.insert(1, 1);
+    QCOMPARE(hash.value(1), 1);
+}
+
+void tst_QFlatHash::reserveAndSqueeze()
+{
+    QFlatHash<int, int> hash;
+    hash.reserve(1000);
+    const int capacity = hash.capacity();
+    QVERIFY(capacity >= 1000);
+
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity);
+
+    for (int i = 10; i < 1000; ++i)
+        hash.remove(i);
+    hash.squeeze();
+    QVERIFY(hash.capacity() < capacity);
+    QVERIFY(hash.capacity() >= 10);
+    QCOMPARE(hash.size(), 10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(hash.value(i), i);
+
+    hash.clear();
+    hash.squeeze();
+    QCOMPARE(hash.capacity(), 0);
+}
+
+void tst_QFlatHash::copyOnWrite()
+{
+    QFlatHash<int, QString> hash;
+    hash.insert(1, "one");
+
+    QFlatHash<int, QString> copy(hash);
+    QVERIFY(hash.isSharedWith(copy));
+    QVERIFY(!hash.isDetached());
+
+    copy.insert(2, "two");
+    QVERIFY(!hash.isSharedWith(copy));
+    QVERIFY(hash.isDetached());
+    QVERIFY(copy.isDetached());
+    QCOMPARE(hash.size(), 1);
+    QCOMPARE(copy.size(), 2);
+
+    QFlatHash<int, QString> assigned;
+    assigned = copy;
+    QVERIFY(assigned.isSharedWith(copy));
+    assigned[1] = "uno";
+    QCOMPARE(copy.value(1), QString("one"));
+    QCOMPARE(assigned.value(1), QString("uno"));
+
+    QFlatHash<int, QString> swapped;
+    swapped.swap(assigned);
+    QVERIFY(assigned.isEmpty());
+    QCOMPARE(swapped.value(1), QString("uno"));
+}
+
+void tst_QFlatHash::operator_eq()
+{
+    QFlatHash<int, int> a, b;
+    QVERIFY(a == b);
+
+    for (int i = 0; i < 50; ++i)
+        a.insert(i, i);
+    QVERIFY(a != b);
+
+    // insert in a different order, with a removal on the way
+    for (int i = 60; i >= 0; --i)
+        b.insert(i, i);
+    QVERIFY(a != b);
+    for (int i = 50; i <= 60; ++i)
+        b.remove(i);
+    QVERIFY(a == b);
+
+    b[10] = -1;
+    QVERIFY(a != b);
+}
+
+void tst_QFlatHash::iterators()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(hash.begin() == hash.end());
+    QVERIFY(hash.constBegin() == hash.constEnd());
+
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i * 10);
+
+    QSet<int> seen;
+    for (QFlatHash<int, int>::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it) {
+        QCOMPARE(*it, it.key() * 10);
+        seen.insert(it.key());
+    }
+    QCOMPARE(seen.size(), 100);
+
+    // backwards
+    seen.clear();
+    QFlatHash<int, int>::const_iterator it = hash.constEnd();
+    while (it != hash.constBegin()) {
+        --it;
+        seen.insert(it.key());
+    }
+    QCOMPARE(seen.size(), 100);
+
+    for (QFlatHash<int, int>::iterator it = hash.begin(); it != hash.end(); ++it)
+        it.value() = -it.key();
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(i), -i);
+
+    int sum = 0;
+    foreach (int v, hash)
+        sum += v;
+    QCOMPARE(sum, -4950);
+}
+
+void tst_QFlatHash::javaIterators()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 20; ++i)
+        hash.insert(i, i);
+
+    int count = 0;
+    QFlatHashIterator<int, int> it(hash);
+    while (it.hasNext()) {
+        it.next();
+        QCOMPARE(it.key(), it.value());
+        ++count;
+    }
+    QCOMPARE(count, 20);
+
+    QFlatHash<int, int> copy = hash;
+    QMutableFlatHashIterator<int, int> mit(hash);
+    while (mit.hasNext()) {
+        mit.next();
+        if (mit.key() & 1)
+            mit.remove();
+        else
+            mit.setValue(100);
+    }
+    QCOMPARE(hash.size(), 10);
+    foreach (int v, hash)
+        QCOMPARE(v, 100);
+    QCOMPARE(copy.size(), 20);
+}
+
+void tst_QFlatHash::keysAndValues()
+{
+    QFlatHash<QString, int> hash;
+    hash.insert("a", 1);
+    hash.insert("b", 2);
+    hash.insert("c", 3);
+
+    QStringList keys = hash.keys();
+    keys.sort();
+    QCOMPARE(keys, QStringList() << "a" << "b" << "c");
+
+    QList<int> values = hash.values();
+    std::sort(values.begin(), values.end());
+    QCOMPARE(values, QList<int>() << 1 << 2 << 3);
+
+    QCOMPARE(hash.key(2), QString("b"));
+    QCOMPARE(hash.key(4), QString());
+    QCOMPARE(hash.key(4, "none"), QString("none"));
+}
+
+void tst_QFlatHash::complexType()
+{
+    QCOMPARE(Counted::count, 0);
+    {
+        QFlatHash<Counted, Counted> hash;
+        for (int i = 0; i < 500; ++i)
+            hash.insert(Counted(i), Counted(i * 2));
+        QCOMPARE(Counted::count, 1000);
+
+        for (int i = 0; i < 500; ++i)
+            QCOMPARE(hash.value(Counted(i)).value, i * 2);
+
+        QFlatHash<Counted, Counted> copy = hash;
+        QCOMPARE(Counted::count, 1000);
+        copy.remove(Counted(0));
+        QCOMPARE(Counted::count, 1998);
+
+        for (int i = 0; i < 500; i += 2)
+            hash.remove(Counted(i));
+        QCOMPARE(hash.size(), 250);
+        QCOMPARE(Counted::count, 1498);
+    }
+    QCOMPARE(Counted::count, 0);
+}
+
+void tst_QFlatHash::manyTombstones()
+{
+    // keep the size constant while churning through keys, so that the
+    // table fills up with deleted slots and must clean them up itself
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 10; ++i)
+        hash.insert(i, i);
+    const int capacity = hash.capacity();
+
+    for (int i = 10; i < 10000; ++i) {
+        hash.insert(i, i);
+        hash.remove(i - 10);
+        QCOMPARE(hash.size(), 10);
+    }
+    QCOMPARE(hash.capacity(), capacity);
+    for (int i = 9990; i < 10000; ++i)
+        QCOMPARE(hash.value(i), i);
+}
+
+void tst_QFlatHash::compareWithQHash()
+{
+    QHash<QString, int> reference;
+    QFlatHash<QString, int> hash;
+
+    qsrand(42);
+    for (int i = 0; i < 20000; ++i) {
+        const QString key = QString::number(qrand() % 5000);
+        switch (qrand() % 3) {
+        case 0:
+        case 1:
+            reference.insert(key, i);
+            hash.insert(key, i);
+            break;
+        case 2:
+            QCOMPARE(hash.remove(key), reference.remove(key));
+            break;
+        }
+    }
+
+    QCOMPARE(hash.size(), reference.size());
+    for (QHash<QString, int>::const_iterator it = reference.constBegin(); it != reference.constEnd(); ++it)
+        QCOMPARE(hash.value(it.key(), -1), it.value());
+    for (QFlatHash<QString, int>::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it)
+        QCOMPARE(reference.value(it.key(), -1), it.value());
+}
+
+void tst_QFlatHash::initializerList()
+{
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    QFlatHash<int, QString> hash = {{1, "bar"}, {1, "hello"}, {2, "initializer_list"}};
+    QCOMPARE(hash.count(), 2);
+    QCOMPARE(hash[1], QString("hello"));
+    QCOMPARE(hash[2], QString("initializer_list"));
+
+    QFlatSet<int> set = {1, 2, 2, 3};
+    QCOMPARE(set.size(), 3);
+    QVERIFY(set.contains(2));
+#else
+    QSKIP("Compiler doesn't support initializer lists");
+#endif
+}
+
+void tst_QFlatHash::flatSet()
+{
+    QFlatSet<QString> set;
+    QVERIFY(set.isEmpty());
+
+    set.insert("a");
+    set.insert("b");
+    set.insert("a");
+    QCOMPARE(set.size(), 2);
+    QVERIFY(set.contains("a"));
+    QVERIFY(!set.contains("c"));
+    QVERIFY(set.find("b") != set.constEnd());
+    QVERIFY(set.constFind("c") == set.constEnd());
+
+    QFlatSet<QString> copy = set;
+    QVERIFY(set == copy);
+    QVERIFY(copy.remove("a"));
+    QVERIFY(!copy.remove("a"));
+    QVERIFY(set != copy);
+    QCOMPARE(set.size(), 2);
+
+    QStringList list = set.toList();
+    list.sort();
+    QCOMPARE(list, QStringList() << "a" << "b");
+
+    int count = 0;
+    for (QFlatSet<QString>::const_iterator it = set.constBegin(); it != set.constEnd(); ++it) {
+        QVERIFY(*it == "a" || *it == "b");
+        ++count;
+    }
+    QCOMPARE(count, 2);
+
+    count = 0;
+    QFlatSetIterator<QString> jit(set);
+    while (jit.hasNext()) {
+        jit.next();
+        ++count;
+    }
+    QCOMPARE(count, 2);
+
+    set.clear();
+    QVERIFY(set.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+#include "tst_qflathash.moc"
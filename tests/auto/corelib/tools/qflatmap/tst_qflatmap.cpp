@@ -0,0 +1,452 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qflatmap.h>
+#include <qmap.h>
+
+#include <numeric>
+
+class tst_QFlatMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insert();
+    void insertReplaces();
+    void operator_bracket();
+    void remove();
+    void take();
+    void erase();
+    void bulkConstruction();
+    void bulkConstructionDuplicates();
+    void fromAndToMap();
+    void bounds();
+    void firstAndLast();
+    void copyOnWrite();
+    void iterators();
+    void javaIterators();
+    void keysAndValues();
+    void complexType();
+    void compareWithQMap();
+    void initializerList();
+};
+
+void tst_QFlatMap::insert()
+{
+    QFlatMap<int, int> map;
+    QVERIFY(map.isEmpty());
+    map.insert(3, 30);
+    map.insert(1, 10);
+    map.insert(2, 20);
+    map.insert(5, 50);
+    map.insert(4, 40);
+    QCOMPARE(map.size(), 5);
+    for (int i = 1; i <= 5; ++i) {
+        QVERIFY(map.contains(i));
+        QCOMPARE(map.value(i), i * 10);
+        QCOMPARE(map.count(i), 1);
+    }
+    QVERIFY(!map.contains(0));
+    QVERIFY(!map.contains(6));
+    QCOMPARE(map.value(6, -1), -1);
+    QCOMPARE(map.keyVector(), QVector<int>() << 1 << 2 << 3 << 4 << 5);
+
+    QFlatMap<int, int>::iterator it = map.insert(0, 0);
+    QCOMPARE(it.key(), 0);
+    QCOMPARE(it.value(), 0);
+    QVERIFY(it == map.begin());
+}
+
+void tst_QFlatMap::insertReplaces()
+{
+    QFlatMap<QString, int> map;
+    map.insert("a", 1);
+    map.insert("b", 2);
+    map.insert("a", 3);
+    QCOMPARE(map.size(), 2);
+    QCOMPARE(map.value("a"), 3);
+    QCOMPARE(map.value("b"), 2);
+}
+
+void tst_QFlatMap::operator_bracket()
+{
+    QFlatMap<int, QString> map;
+    map[2] = "two";
+    map[1] = "one";
+    QCOMPARE(map.size(), 2);
+    QCOMPARE(map[1], QString("one"));
+    QCOMPARE(map.size(), 2);
+    QVERIFY(map[3].isNull());
+    QCOMPARE(map.size(), 3);
+
+    const QFlatMap<int, QString> &cmap = map;
+    QVERIFY(cmap[4].isNull());
+    QCOMPARE(map.size(), 3);
+}
+
+void tst_QFlatMap::remove()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 10; ++i)
+        map.insert(i, i);
+    QCOMPARE(map.remove(5), 1);
+    QCOMPARE(map.remove(5), 0);
+    QCOMPARE(map.remove(100), 0);
+    QCOMPARE(map.size(), 9);
+    QVERIFY(!map.contains(5));
+    QVERIFY(map.contains(4));
+    QVERIFY(map.contains(6));
+    map.clear();
+    QVERIFY(map.isEmpty());
+    QCOMPARE(map.remove(1), 0);
+}
+
+void tst_QFlatMap::take()
+{
+    QFlatMap<int, QString> map;
+    map.insert(1, "one");
+    map.insert(2, "two");
+    QCOMPARE(map.take(1), QString("one"));
+    QVERIFY(map.take(1).isNull());
+    QCOMPARE(map.size(), 1);
+    QCOMPARE(map.firstKey(), 2);
+}
+
+void tst_QFlatMap::erase()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 10; ++i)
+        map.insert(i, i * i);
+
+    QFlatMap<int, int>::iterator it = map.begin();
+    while (it != map.end()) {
+        if (it.key() % 2)
+            it = map.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(map.size(), 5);
+    QCOMPARE(map.keyVector(), QVector<int>() << 0 << 2 << 4 << 6 << 8);
+    QCOMPARE(map.value(8), 64);
+}
+
+void tst_QFlatMap::bulkConstruction()
+{
+    QVector<int> keys;
+    QVector<QString> values;
+    const int n = 1000;
+    for (int i = 0; i < n; ++i) {
+        const int key = (i * 7919) % n;
+        keys.append(key);
+        values.append(QString::number(key));
+    }
+
+    QFlatMap<int, QString> map(keys, values);
+    QCOMPARE(map.size(), n);
+    for (int i = 0; i < n; ++i) {
+        QCOMPARE(map.keyVector().at(i), i);
+        QCOMPARE(map.valueVector().at(i), QString::number(i));
+    }
+
+    // already sorted input
+    QFlatMap<int, QString> sorted(map.keyVector(), map.valueVector());
+    QVERIFY(sorted == map);
+
+    QFlatMap<int, QString> empty((QVector<int>()), QVector<QString>());
+    QVERIFY(empty.isEmpty());
+}
+
+void tst_QFlatMap::bulkConstructionDuplicates()
+{
+    QVector<int> keys;
+    QVector<int> values;
+    keys << 3 << 1 << 3 << 2 << 1 << 3;
+    values << 1 << 2 << 3 << 4 << 5 << 6;
+
+    QFlatMap<int, int> map(keys, values);
+    QMap<int, int> reference;
+    for (int i = 0; i < keys.size(); ++i)
+        reference.insert(keys.at(i), values.at(i));
+
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(map.toMap(), reference);
+    QCOMPARE(map.value(1), 5);
+    QCOMPARE(map.value(2), 4);
+    QCOMPARE(map.value(3), 6);
+}
+
+void tst_QFlatMap::fromAndToMap()
+{
+    QMap<QString, int> qmap;
+    qmap.insert("pear", 3);
+    qmap.insert("apple", 1);
+    qmap.insert("orange", 2);
+
+    QFlatMap<QString, int> map(qmap);
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(map.keys(), qmap.keys());
+    QCOMPARE(map.values(), qmap.values());
+    QCOMPARE(map.toMap(), qmap);
+}
+
+void tst_QFlatMap::bounds()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 10; i += 2)
+        map.insert(i, i);
+
+    QCOMPARE(map.lowerBound(4).key(), 4);
+    QCOMPARE(map.upperBound(4).key(), 6);
+    QCOMPARE(map.lowerBound(5).key(), 6);
+    QCOMPARE(map.upperBound(5).key(), 6);
+    QVERIFY(map.lowerBound(-1) == map.begin());
+    QVERIFY(map.lowerBound(9) == map.end());
+    QVERIFY(map.upperBound(8) == map.end());
+
+    const QFlatMap<int, int> &cmap = map;
+    QCOMPARE(cmap.lowerBound(3).key(), 4);
+    QCOMPARE(cmap.upperBound(0).key(), 2);
+
+    QVERIFY(map.find(3) == map.end());
+    QCOMPARE(map.find(2).value(), 2);
+    QVERIFY(cmap.constFind(7) == cmap.constEnd());
+    QCOMPARE(cmap.constFind(6).value(), 6);
+}
+
+void tst_QFlatMap::firstAndLast()
+{
+    QFlatMap<int, int> map;
+    map.insert(5, 50);
+    map.insert(-3, -30);
+    map.insert(12, 120);
+    QCOMPARE(map.firstKey(), -3);
+    QCOMPARE(map.lastKey(), 12);
+    QCOMPARE(map.first(), -30);
+    QCOMPARE(map.last(), 120);
+    map.first() = 0;
+    QCOMPARE(map.value(-3), 0);
+}
+
+void tst_QFlatMap::copyOnWrite()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 100; ++i)
+        map.insert(i, i);
+
+    QFlatMap<int, int> copy = map;
+    QVERIFY(!map.isDetached());
+    QVERIFY(copy == map);
+
+    copy.insert(100, 100);
+    copy[0] = -1;
+    QCOMPARE(map.size(), 100);
+    QCOMPARE(copy.size(), 101);
+    QCOMPARE(map.value(0), 0);
+    QCOMPARE(copy.value(0), -1);
+    QVERIFY(copy != map);
+
+    QFlatMap<int, int> copy2 = map;
+    *copy2.begin() = 42;
+    QCOMPARE(map.value(0), 0);
+    QCOMPARE(copy2.value(0), 42);
+
+    QFlatMap<int, int> copy3 = map;
+    copy3.erase(copy3.begin());
+    QCOMPARE(map.size(), 100);
+    QCOMPARE(copy3.size(), 99);
+    QCOMPARE(copy3.firstKey(), 1);
+}
+
+void tst_QFlatMap::iterators()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 20; ++i)
+        map.insert(19 - i, i);
+
+    int expected = 0;
+    for (QFlatMap<int, int>::const_iterator it = map.constBegin(); it != map.constEnd(); ++it) {
+        QCOMPARE(it.key(), expected);
+        QCOMPARE(*it, 19 - expected);
+        ++expected;
+    }
+    QCOMPARE(expected, 20);
+
+    for (QFlatMap<int, int>::iterator it = map.begin(); it != map.end(); ++it)
+        it.value() = it.key();
+    QCOMPARE(map.valueVector(), map.keyVector());
+
+    QFlatMap<int, int>::iterator it = map.begin();
+    QCOMPARE((it + 5).key(), 5);
+    it += 10;
+    QCOMPARE(it.key(), 10);
+    QCOMPARE(it - map.begin(), 10);
+    QVERIFY(map.begin() < it);
+    --it;
+    QCOMPARE(it.key(), 9);
+
+    QFlatMap<int, int>::const_iterator cit = it;
+    QVERIFY(cit == it);
+    QCOMPARE(map.cend() - map.cbegin(), 20);
+
+    QCOMPARE(std::accumulate(map.constBegin(), map.constEnd(), 0), 190);
+}
+
+void tst_QFlatMap::javaIterators()
+{
+    QFlatMap<int, QString> map;
+    map.insert(2, "b");
+    map.insert(1, "a");
+    map.insert(3, "c");
+
+    QFlatMapIterator<int, QString> it(map);
+    QString keys;
+    QString values;
+    while (it.hasNext()) {
+        it.next();
+        keys += QString::number(it.key());
+        values += it.value();
+    }
+    QCOMPARE(keys, QString("123"));
+    QCOMPARE(values, QString("abc"));
+
+    it.toBack();
+    QVERIFY(it.hasPrevious());
+    QCOMPARE(it.previous().key(), 3);
+    QVERIFY(it.findPrevious("a"));
+}
+
+void tst_QFlatMap::keysAndValues()
+{
+    QFlatMap<QString, int> map;
+    map.insert("c", 3);
+    map.insert("a", 1);
+    map.insert("b", 2);
+    QCOMPARE(map.keys(), QList<QString>() << "a" << "b" << "c");
+    QCOMPARE(map.values(), QList<int>() << 1 << 2 << 3);
+    QCOMPARE(map.key(2), QString("b"));
+    QCOMPARE(map.key(4, "none"), QString("none"));
+}
+
+struct Counted
+{
+    static int count;
+    int value;
+
+    Counted(int v = 0) : value(v) { ++count; }
+    Counted(const Counted &other) : value(other.value) { ++count; }
+    ~Counted() { --count; }
+    Counted &operator=(const Counted &other) { value = other.value; return *this; }
+    bool operator==(const Counted &other) const { return value == other.value; }
+    bool operator<(const Counted &other) const { return value < other.value; }
+};
+int Counted::count = 0;
+
+void tst_QFlatMap::complexType()
+{
+    Counted::count = 0;
+    {
+        QFlatMap<Counted, Counted> map;
+        for (int i = 0; i < 100; ++i)
+            map.insert(Counted(99 - i), Counted(i));
+        QCOMPARE(map.size(), 100);
+        QCOMPARE(Counted::count, 200);
+        for (int i = 0; i < 100; i += 2)
+            map.remove(Counted(i));
+        QCOMPARE(Counted::count, 100);
+
+        QVector<Counted> keys;
+        QVector<Counted> values;
+        for (int i = 0; i < 50; ++i) {
+            keys.append(Counted(i % 25));
+            values.append(Counted(i));
+        }
+        QFlatMap<Counted, Counted> bulk(keys, values);
+        QCOMPARE(bulk.size(), 25);
+        QCOMPARE(bulk.value(Counted(3)).value, 28);
+    }
+    QCOMPARE(Counted::count, 0);
+}
+
+void tst_QFlatMap::compareWithQMap()
+{
+    QMap<int, int> reference;
+    QFlatMap<int, int> map;
+    qsrand(42);
+    for (int i = 0; i < 5000; ++i) {
+        const int key = qrand() % 1000;
+        switch (qrand() % 3) {
+        case 0:
+        case 1:
+            reference.insert(key, i);
+            map.insert(key, i);
+            break;
+        case 2:
+            QCOMPARE(map.remove(key), reference.remove(key));
+            break;
+        }
+    }
+    QCOMPARE(map.size(), reference.size());
+    QCOMPARE(map.toMap(), reference);
+    for (int key = -1; key <= 1000; ++key) {
+        QCOMPARE(map.contains(key), reference.contains(key));
+        QCOMPARE(map.value(key, -1), reference.value(key, -1));
+        if (reference.lowerBound(key) == reference.end())
+            QVERIFY(map.lowerBound(key) == map.end());
+        else
+            QCOMPARE(map.lowerBound(key).key(), reference.lowerBound(key).key());
+    }
+}
+
+void tst_QFlatMap::initializerList()
+{
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    QFlatMap<int, QString> map = { {3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"} };
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(map.keyVector(), QVector<int>() << 1 << 2 << 3);
+    QCOMPARE(map.value(1), QString("uno"));
+#else
+    QSKIP("Compiler doesn't support initializer lists");
+#endif
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatMap)
+#include "tst_qflatmap.moc"
@@ -155,6 +155,11 @@ private slots:
     void testInfAndNan();
     void fpExceptions();
     void negativeZero();
+    void doubleShortest_data();
+    void doubleShortest();
+    void doubleShortestRoundTrip();
+    void toDoubleExact_data();
+    void toDoubleExact();
     void dayOfWeek();
     void dayOfWeek_data();
     void formatDate();
@@ -988,6 +993,133 @@ void tst_QLocale::negativeZero()
     QCOMPARE(s, QString("0"));
 }
 
+void tst_QLocale::doubleShortest_data()
+{
+    QTest::addColumn<double>("num");
+    QTest::addColumn<char>("format");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("0") << 0.0 << 'g' << QString("0");
+    QTest::newRow("-0") << -0.0 << 'g' << QString("0");
+    QTest::newRow("0.1") << 0.1 << 'g' << QString("0.1");
+    QTest::newRow("0.1+0.2") << 0.1 + 0.2 << 'g' << QString("0.30000000000000004");
+    QTest::newRow("1/3") << 1.0 / 3 << 'g' << QString("0.3333333333333333");
+    QTest::newRow("-1.5") << -1.5 << 'g' << QString("-1.5");
+    QTest::newRow("123456") << 123456.0 << 'g' << QString("123456");
+    QTest::newRow("1234500") << 1234500.0 << 'g' << QString("1234500");
+    QTest::newRow("2^53") << 9007199254740992.0 << 'g' << QString("9007199254740992");
+    QTest::newRow("1e16") << 1e16 << 'g' << QString("10000000000000000");
+    QTest::newRow("1e17") << 1e17 << 'g' << QString("1e+17");
+    QTest::newRow("1e23") << 1e23 << 'g' << QString("1e+23");
+    QTest::newRow("0.001") << 0.001 << 'g' << QString("0.001");
+    QTest::newRow("0.0001") << 0.0001 << 'g' << QString("0.0001");
+    QTest::newRow("0.00001") << 0.00001 << 'g' << QString("1e-05");
+    QTest::newRow("5e-324") << 5e-324 << 'g' << QString("5e-324");
+    QTest::newRow("DBL_MIN") << 2.2250738585072014e-308 << 'g' << QString("2.2250738585072014e-308");
+    QTest::newRow("DBL_MAX") << 1.7976931348623157e308 << 'g' << QString("1.7976931348623157e+308");
+    QTest::newRow("2^-1022 * 3") << 6.675221575521604e-308 << 'g' << QString("6.675221575521604e-308");
+    QTest::newRow("G") << 1e-10 << 'G' << QString("1E-10");
+
+    QTest::newRow("e 123.456") << 123.456 << 'e' << QString("1.23456e+02");
+    QTest::newRow("e 1") << 1.0 << 'e' << QString("1e+00");
+    QTest::newRow("e 0.1") << 0.1 << 'e' << QString("1e-01");
+
+    QTest::newRow("f 0.1") << 0.1 << 'f' << QString("0.1");
+    QTest::newRow("f 1e21") << 1e21 << 'f' << QString("1000000000000000000000");
+    QTest::newRow("f 1.5e-7") << 1.5e-7 << 'f' << QString("0.00000015");
+    QTest::newRow("f 12.5") << 12.5 << 'f' << QString("12.5");
+}
+
+void tst_QLocale::doubleShortest()
+{
+    QFETCH(double, num);
+    QFETCH(char, format);
+    QFETCH(QString, expected);
+
+    QCOMPARE(QString::number(num, format, QLocale::FloatingPointShortest), expected);
+    QCOMPARE(QByteArray::number(num, format, QLocale::FloatingPointShortest), expected.toLatin1());
+    QLocale c = QLocale::c();
+    c.setNumberOptions(QLocale::OmitGroupSeparator);
+    QCOMPARE(c.toString(num, format, QLocale::FloatingPointShortest), expected);
+
+    bool ok;
+    QCOMPARE(expected.toDouble(&ok), num);
+    QVERIFY(ok);
+}
+
+void tst_QLocale::doubleShortestRoundTrip()
+{
+    // random bit patterns cover all exponents, and the neighbours of
+    // powers of two have asymmetric rounding intervals
+    quint64 state = Q_UINT64_C(0x9e3779b97f4a7c15);
+    for (int i = 0; i < 100000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        quint64 bits = state;
+        if (i % 10 == 0)
+            bits &= Q_UINT64_C(0xfff0000000000001);
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        if (qIsNaN(d) || qIsInf(d))
+            continue;
+
+        const QString shortest = QString::number(d, 'g', QLocale::FloatingPointShortest);
+        bool ok;
+        const double back = shortest.toDouble(&ok);
+        QVERIFY2(ok, qPrintable(shortest));
+        QVERIFY2(memcmp(&back, &d, sizeof(d)) == 0 || (d == 0 && back == 0), qPrintable(shortest));
+
+        // one digit less must not be enough
+        const QString exponentForm = QString::number(d, 'e', QLocale::FloatingPointShortest);
+        const QString mantissa = exponentForm.left(exponentForm.indexOf(QLatin1Char('e')));
+        const int digits = mantissa.length() - mantissa.count(QLatin1Char('-'))
+                - mantissa.count(QLatin1Char('.'));
+        QCOMPARE(exponentForm.toDouble(), d);
+        if (digits > 1)
+            QVERIFY2(QString::number(d, 'e', digits - 2).toDouble() != d, qPrintable(shortest));
+    }
+}
+
+void tst_QLocale::toDoubleExact_data()
+{
+    QTest::addColumn<QString>("str");
+    QTest::addColumn<double>("num");
+
+    // these take the fast path for short decimals, and their neighbours
+    // the exact one
+    QTest::newRow("0.1") << QString("0.1") << 0.1;
+    QTest::newRow("-0.0") << QString("-0.0") << -0.0;
+    QTest::newRow("+12.5e3") << QString("+12.5e3") << 12500.0;
+    QTest::newRow("1e22") << QString("1e22") << 1e22;
+    QTest::newRow("1e23") << QString("1e23") << 1e23;
+    QTest::newRow("12e30") << QString("12e30") << 12e30;
+    QTest::newRow("1e-22") << QString("1e-22") << 1e-22;
+    QTest::newRow("1e-23") << QString("1e-23") << 1e-23;
+    QTest::newRow("2^53") << QString("9007199254740992") << 9007199254740992.0;
+    QTest::newRow("2^53+1") << QString("9007199254740993") << 9007199254740992.0;
+    QTest::newRow("2^53+3") << QString("9007199254740995") << 9007199254740996.0;
+    QTest::newRow("19 digits") << QString("1234567890123456789") << 1234567890123456789.0;
+    QTest::newRow("20 digits") << QString("0.12345678901234567890") << 0.12345678901234567890;
+    QTest::newRow("leading zeros") << QString("0000.000123") << 0.000123;
+    QTest::newRow("trailing point") << QString("3.") << 3.0;
+    QTest::newRow("leading point") << QString(".5") << 0.5;
+    QTest::newRow("DBL_MAX") << QString("1.7976931348623157e308") << 1.7976931348623157e308;
+    QTest::newRow("denormal") << QString("4.9406564584124654e-324") << 5e-324;
+}
+
+void tst_QLocale::toDoubleExact()
+{
+    QFETCH(QString, str);
+    QFETCH(double, num);
+
+    bool ok;
+    const double d = str.toDouble(&ok);
+    QVERIFY(ok);
+    QVERIFY(memcmp(&d, &num, sizeof(d)) == 0);
+    QVERIFY(str.toLatin1().toDouble() == num);
+}
+
 void tst_QLocale::dayOfWeek_data()
 {
     QTest::addColumn<QDate>("date");
@@ -0,0 +1,285 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qsmallbytearray.h>
+#include <qhash.h>
+
+class tst_QSmallByteArray : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void layout();
+    void constructors_data();
+    void constructors();
+    void inlineAndHeap();
+    void copyAndAssign();
+    void append_data();
+    void append();
+    void appendSelf();
+    void resize();
+    void compare();
+    void hash();
+};
+
+void tst_QSmallByteArray::layout()
+{
+    QCOMPARE(sizeof(QSmallByteArray), size_t(QSmallByteArray::InlineCapacity + 1));
+    QVERIFY(QTypeInfo<QSmallByteArray>::isStatic == false);
+}
+
+void tst_QSmallByteArray::constructors_data()
+{
+    QTest::addColumn<QByteArray>("array");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("one") << QByteArray("a");
+    QTest::newRow("twentytwo") << QByteArray(22, 'x');
+    QTest::newRow("twentythree") << QByteArray(23, 'x');
+    QTest::newRow("twentyfour") << QByteArray(24, 'x');
+    QTest::newRow("long") << QByteArray("The quick brown fox jumps over the lazy dog");
+    QTest::newRow("embedded-null") << QByteArray("a\0b", 3);
+}
+
+void tst_QSmallByteArray::constructors()
+{
+    QFETCH(QByteArray, array);
+
+    const bool expectInline = array.size() <= QSmallByteArray::InlineCapacity;
+
+    QSmallByteArray fromArray(array);
+    QCOMPARE(fromArray.size(), array.size());
+    QCOMPARE(fromArray.isEmpty(), array.isEmpty());
+    QCOMPARE(fromArray.isInline(), expectInline);
+    QCOMPARE(fromArray.toByteArray(), array);
+    QVERIFY(fromArray == array);
+    QCOMPARE(fromArray.constData()[fromArray.size()], '\0');
+
+    QSmallByteArray fromData(array.constData(), array.size());
+    QCOMPARE(fromData.isInline(), expectInline);
+    QCOMPARE(fromData.toByteArray(), array);
+
+    QSmallByteArray fromCString(array.constData());
+    QCOMPARE(fromCString.toByteArray(), QByteArray(array.constData()));
+
+    QSmallByteArray filled(array.size(), 'f');
+    QCOMPARE(filled.toByteArray(), QByteArray(array.size(), 'f'));
+
+    QSmallByteArray copy(fromArray);
+    QVERIFY(copy == fromArray);
+    QCOMPARE(copy.isInline(), expectInline);
+}
+
+void tst_QSmallByteArray::inlineAndHeap()
+{
+    QSmallByteArray ba;
+    QVERIFY(ba.isEmpty());
+    QVERIFY(ba.isInline());
+    QCOMPARE(ba.capacity(), int(QSmallByteArray::InlineCapacity));
+    QCOMPARE(ba.constData()[0], '\0');
+
+    const QByteArray longArray(100, 'x');
+    QSmallByteArray shared(longArray);
+    QVERIFY(!shared.isInline());
+    // a long QByteArray is shared, not copied
+    QCOMPARE(shared.constData(), longArray.constData());
+
+    shared.clear();
+    QVERIFY(shared.isInline());
+    QVERIFY(shared.isEmpty());
+}
+
+void tst_QSmallByteArray::copyAndAssign()
+{
+    QSmallByteArray a("short");
+    QSmallByteArray b(QByteArray(50, 'b'));
+
+    QSmallByteArray c = a;
+    c[0] = 'S';
+    QCOMPARE(a.toByteArray(), QByteArray("short"));
+    QCOMPARE(c.toByteArray(), QByteArray("Short"));
+
+    QSmallByteArray d = b;
+    d.data()[0] = 'x';
+    QCOMPARE(b.at(0), 'b');
+    QCOMPARE(d.at(0), 'x');
+
+    c = b;
+    QVERIFY(!c.isInline());
+    QVERIFY(c == b);
+    c = a;
+    QVERIFY(c.isInline());
+    QVERIFY(c == a);
+
+    c = "from C string";
+    QVERIFY(c == "from C string");
+    c = QByteArray("from QByteArray");
+    QVERIFY(c == QByteArray("from QByteArray"));
+
+    a.swap(b);
+    QVERIFY(!a.isInline());
+    QCOMPARE(b.toByteArray(), QByteArray("short"));
+
+#ifdef Q_COMPILER_RVALUE_REFS
+    QSmallByteArray moved(std::move(a));
+    QCOMPARE(moved.size(), 50);
+    QVERIFY(a.isEmpty());
+    a = std::move(moved);
+    QCOMPARE(a.size(), 50);
+#endif
+}
+
+void tst_QSmallByteArray::append_data()
+{
+    QTest::addColumn<QByteArray>("first");
+    QTest::addColumn<QByteArray>("second");
+
+    QTest::newRow("inline+inline") << QByteArray("abc") << QByteArray("def");
+    QTest::newRow("inline+inline=full") << QByteArray(20, 'a') << QByteArray("bcd");
+    QTest::newRow("inline+inline=heap") << QByteArray(20, 'a') << QByteArray("bcde");
+    QTest::newRow("heap+inline") << QByteArray(30, 'x') << QByteArray("y");
+    QTest::newRow("empty+heap") << QByteArray() << QByteArray(30, 'y');
+}
+
+void tst_QSmallByteArray::append()
+{
+    QFETCH(QByteArray, first);
+    QFETCH(QByteArray, second);
+    const QByteArray expected = first + second;
+
+    QSmallByteArray ba(first);
+    ba.append(second);
+    QCOMPARE(ba.toByteArray(), expected);
+    QCOMPARE(ba.isInline(), expected.size() <= QSmallByteArray::InlineCapacity);
+
+    ba = first;
+    ba += QSmallByteArray(second);
+    QCOMPARE(ba.toByteArray(), expected);
+
+    ba = first;
+    ba += second.constData();
+    QCOMPARE(ba.toByteArray(), expected);
+
+    ba = first;
+    for (int i = 0; i < second.size(); ++i)
+        ba += second.at(i);
+    QCOMPARE(ba.toByteArray(), expected);
+}
+
+void tst_QSmallByteArray::appendSelf()
+{
+    QSmallByteArray ba("abcdef");
+    ba.append(ba);
+    QCOMPARE(ba.toByteArray(), QByteArray("abcdefabcdef"));
+    ba.append(ba);
+    QVERIFY(!ba.isInline());
+    QCOMPARE(ba.toByteArray(), QByteArray("abcdefabcdefabcdefabcdef"));
+    ba.append(ba.constData() + 1, 2);
+    QCOMPARE(ba.toByteArray(), QByteArray("abcdefabcdefabcdefabcdefbc"));
+}
+
+void tst_QSmallByteArray::resize()
+{
+    QSmallByteArray ba("abcdef");
+    ba.truncate(3);
+    QCOMPARE(ba.toByteArray(), QByteArray("abc"));
+    QCOMPARE(ba.constData()[3], '\0');
+    ba.chop(1);
+    QCOMPARE(ba.toByteArray(), QByteArray("ab"));
+    ba.chop(10);
+    QVERIFY(ba.isEmpty());
+
+    ba = "abc";
+    ba.resize(40);
+    QVERIFY(!ba.isInline());
+    QCOMPARE(ba.size(), 40);
+    QVERIFY(ba.toByteArray().startsWith("abc"));
+
+    ba.clear();
+    ba.resize(QSmallByteArray::InlineCapacity);
+    QVERIFY(ba.isInline());
+    QCOMPARE(ba.size(), int(QSmallByteArray::InlineCapacity));
+    QCOMPARE(ba.constData()[QSmallByteArray::InlineCapacity], '\0');
+}
+
+void tst_QSmallByteArray::compare()
+{
+    const QList<QByteArray> arrays = QList<QByteArray>()
+            << QByteArray() << "a" << "ab" << "abc" << "b" << "ba" << "\xff"
+            << QByteArray(30, 'a') << QByteArray(31, 'a');
+
+    foreach (const QByteArray &a, arrays) {
+        foreach (const QByteArray &b, arrays) {
+            const QSmallByteArray sa(a);
+            const QSmallByteArray sb(b);
+            QCOMPARE(sa == sb, a == b);
+            QCOMPARE(sa != sb, a != b);
+            QCOMPARE(sa < sb, a < b);
+            QCOMPARE(sa <= sb, a <= b);
+            QCOMPARE(sa > sb, a > b);
+            QCOMPARE(sa >= sb, a >= b);
+            QCOMPARE(sa == b, a == b);
+            QCOMPARE(a == sb, a == b);
+            QCOMPARE(sa == b.constData(), a == b);
+            QCOMPARE(b.constData() != sa, a != b);
+        }
+    }
+}
+
+void tst_QSmallByteArray::hash()
+{
+    const QList<QByteArray> arrays = QList<QByteArray>()
+            << QByteArray() << "a" << "hello" << QByteArray(23, 'x') << QByteArray(64, 'y');
+    foreach (const QByteArray &ba, arrays) {
+        QCOMPARE(qHash(QSmallByteArray(ba)), qHash(ba));
+        QCOMPARE(qHash(QSmallByteArray(ba), 42), qHash(ba, 42));
+    }
+
+    QHash<QSmallByteArray, int> hash;
+    hash.insert("one", 1);
+    hash.insert(QByteArray(40, 't'), 2);
+    QCOMPARE(hash.value("one"), 1);
+    QCOMPARE(hash.value(QByteArray(40, 't')), 2);
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallByteArray)
+#include "tst_qsmallbytearray.moc"
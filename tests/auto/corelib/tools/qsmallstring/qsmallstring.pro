@@ -0,0 +1,5 @@
+CONFIG += testcase parallel_test
+TARGET = tst_qsmallstring
+QT = core testlib
+SOURCES = tst_qsmallstring.cpp
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -0,0 +1,390 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qsmallstring.h>
+#include <qhash.h>
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void layout();
+    void constructors_data();
+    void constructors();
+    void inlineAndHeap();
+    void copyAndAssign();
+    void append_data();
+    void append();
+    void appendSelf();
+    void resize();
+    void compare();
+    void compareCaseInsensitive();
+    void conversions_data();
+    void conversions();
+    void fromUtf8_data();
+    void fromUtf8();
+    void hash();
+    void asHashKey();
+};
+
+void tst_QSmallString::layout()
+{
+    QCOMPARE(sizeof(QSmallString), sizeof(ushort) * (QSmallString::InlineCapacity + 1));
+    QVERIFY(QTypeInfo<QSmallString>::isStatic == false);
+}
+
+void tst_QSmallString::constructors_data()
+{
+    QTest::addColumn<QString>("string");
+
+    QTest::newRow("empty") << QString();
+    QTest::newRow("one") << QString("a");
+    QTest::newRow("ten") << QString("0123456789");
+    QTest::newRow("eleven") << QString("0123456789a");
+    QTest::newRow("twelve") << QString("0123456789ab");
+    QTest::newRow("long") << QString("The quick brown fox jumps over the lazy dog");
+    QTest::newRow("non-latin1") << QString::fromUtf8("\xe2\x82\xac\xe2\x82\xac\xf0\x9f\x98\x80");
+}
+
+void tst_QSmallString::constructors()
+{
+    QFETCH(QString, string);
+
+    const bool expectInline = string.size() <= QSmallString::InlineCapacity;
+
+    QSmallString fromString(string);
+    QCOMPARE(fromString.size(), string.size());
+    QCOMPARE(fromString.isEmpty(), string.isEmpty());
+    QCOMPARE(fromString.isInline(), expectInline);
+    QCOMPARE(fromString.toString(), string);
+    QVERIFY(fromString == string);
+    QCOMPARE(fromString.unicode()[fromString.size()], QChar());
+
+    QSmallString fromUnicode(string.unicode(), string.size());
+    QCOMPARE(fromUnicode.isInline(), expectInline);
+    QCOMPARE(fromUnicode.toString(), string);
+
+    QSmallString fromRef(string.midRef(0));
+    QCOMPARE(fromRef.isInline(), expectInline);
+    QVERIFY(fromRef == string.midRef(0));
+
+    QSmallString copy(fromString);
+    QVERIFY(copy == fromString);
+    QCOMPARE(copy.isInline(), expectInline);
+
+    const QByteArray latin1 = string.toLatin1();
+    QSmallString fromLatin1(QLatin1String(latin1.constData(), latin1.size()));
+    QCOMPARE(fromLatin1.toString(), QString::fromLatin1(latin1));
+}
+
+void tst_QSmallString::inlineAndHeap()
+{
+    QSmallString s;
+    QVERIFY(s.isEmpty());
+    QVERIFY(s.isInline());
+    QCOMPARE(s.capacity(), int(QSmallString::InlineCapacity));
+    QVERIFY(s.toString().isNull());
+
+    const QString longString(100, QLatin1Char('x'));
+    QSmallString shared(longString);
+    QVERIFY(!shared.isInline());
+    // a long QString is shared, not copied
+    QCOMPARE(shared.unicode(), longString.unicode());
+
+    shared.clear();
+    QVERIFY(shared.isInline());
+    QVERIFY(shared.isEmpty());
+
+    QSmallString single(QChar('z'));
+    QCOMPARE(single.size(), 1);
+    QCOMPARE(single.at(0), QChar('z'));
+}
+
+void tst_QSmallString::copyAndAssign()
+{
+    QSmallString a(QLatin1String("short"));
+    QSmallString b(QString(50, QLatin1Char('b')));
+
+    QSmallString c = a;
+    c[0] = QLatin1Char('S');
+    QCOMPARE(a.toString(), QString("short"));
+    QCOMPARE(c.toString(), QString("Short"));
+
+    QSmallString d = b;
+    d.data()[0] = QLatin1Char('x');
+    QCOMPARE(b.at(0), QChar('b'));
+    QCOMPARE(d.at(0), QChar('x'));
+
+    c = b;
+    QVERIFY(!c.isInline());
+    QVERIFY(c == b);
+    c = a;
+    QVERIFY(c.isInline());
+    QVERIFY(c == a);
+    c = c;
+    QVERIFY(c == a);
+
+    c = QString("from QString");
+    QCOMPARE(c.toString(), QString("from QString"));
+    c = QLatin1String("latin1");
+    QCOMPARE(c.toString(), QString("latin1"));
+
+    a.swap(b);
+    QVERIFY(!a.isInline());
+    QVERIFY(b.isInline());
+    QCOMPARE(b.toString(), QString("short"));
+
+#ifdef Q_COMPILER_RVALUE_REFS
+    QSmallString moved(std::move(a));
+    QCOMPARE(moved.toString(), QString(50, QLatin1Char('b')));
+    QVERIFY(a.isEmpty());
+    a = std::move(moved);
+    QCOMPARE(a.size(), 50);
+#endif
+}
+
+void tst_QSmallString::append_data()
+{
+    QTest::addColumn<QString>("first");
+    QTest::addColumn<QString>("second");
+
+    QTest::newRow("inline+inline") << QString("abc") << QString("def");
+    QTest::newRow("inline+inline=full") << QString("abcde") << QString("fghijk");
+    QTest::newRow("inline+inline=heap") << QString("abcdef") << QString("ghijkl");
+    QTest::newRow("heap+inline") << QString(30, QLatin1Char('x')) << QString("y");
+    QTest::newRow("empty+heap") << QString() << QString(30, QLatin1Char('y'));
+}
+
+void tst_QSmallString::append()
+{
+    QFETCH(QString, first);
+    QFETCH(QString, second);
+    const QString expected = first + second;
+
+    QSmallString s(first);
+    s.append(second);
+    QCOMPARE(s.toString(), expected);
+    QCOMPARE(s.isInline(), expected.size() <= QSmallString::InlineCapacity);
+
+    s = first;
+    s += QSmallString(second);
+    QCOMPARE(s.toString(), expected);
+
+    s = first;
+    const QByteArray latin1 = second.toLatin1();
+    s += QLatin1String(latin1.constData(), latin1.size());
+    QCOMPARE(s.toString(), expected);
+
+    s = first;
+    s += second.midRef(0);
+    QCOMPARE(s.toString(), expected);
+
+    s = first;
+    for (int i = 0; i < second.size(); ++i)
+        s += second.at(i);
+    QCOMPARE(s.toString(), expected);
+}
+
+void tst_QSmallString::appendSelf()
+{
+    QSmallString s(QLatin1String("abc"));
+    s.append(s);
+    QCOMPARE(s.toString(), QString("abcabc"));
+    s.append(s);
+    QCOMPARE(s.toString(), QString("abcabcabcabc"));
+    QVERIFY(!s.isInline());
+    s.append(s);
+    QCOMPARE(s.toString(), QString("abcabcabcabcabcabcabcabc"));
+    s.append(s.unicode() + 1, 2);
+    QCOMPARE(s.toString(), QString("abcabcabcabcabcabcabcabcbc"));
+}
+
+void tst_QSmallString::resize()
+{
+    QSmallString s(QLatin1String("abcdef"));
+    s.truncate(3);
+    QCOMPARE(s.toString(), QString("abc"));
+    QCOMPARE(s.unicode()[3], QChar());
+    s.chop(1);
+    QCOMPARE(s.toString(), QString("ab"));
+    s.chop(10);
+    QVERIFY(s.isEmpty());
+
+    s = QLatin1String("abc");
+    s.resize(20);
+    QVERIFY(!s.isInline());
+    QCOMPARE(s.size(), 20);
+    QCOMPARE(s.toString().left(3), QString("abc"));
+    s.truncate(2);
+    QCOMPARE(s.toString(), QString("ab"));
+
+    s.clear();
+    s.resize(QSmallString::InlineCapacity);
+    QVERIFY(s.isInline());
+    QCOMPARE(s.size(), int(QSmallString::InlineCapacity));
+    QCOMPARE(s.unicode()[QSmallString::InlineCapacity], QChar());
+}
+
+void tst_QSmallString::compare()
+{
+    const QStringList strings = QStringList()
+            << QString() << "a" << "ab" << "abc" << "b" << "ba"
+            << "0123456789abcdef" << "0123456789abcdeg" << QString::fromUtf8("\xc3\xa9");
+
+    foreach (const QString &a, strings) {
+        foreach (const QString &b, strings) {
+            const QSmallString sa(a);
+            const QSmallString sb(b);
+            const int expected = qBound(-1, QString::compare(a, b), 1);
+            QCOMPARE(qBound(-1, sa.compare(sb), 1), expected);
+            QCOMPARE(qBound(-1, sa.compare(b), 1), expected);
+            QCOMPARE(qBound(-1, sa.compare(b.midRef(0)), 1), expected);
+            QCOMPARE(sa == sb, a == b);
+            QCOMPARE(sa != sb, a != b);
+            QCOMPARE(sa < sb, a < b);
+            QCOMPARE(sa <= sb, a <= b);
+            QCOMPARE(sa > sb, a > b);
+            QCOMPARE(sa >= sb, a >= b);
+            QCOMPARE(sa == b, a == b);
+            QCOMPARE(a == sb, a == b);
+            QCOMPARE(a < sb, a < b);
+            QCOMPARE(sa < b, a < b);
+            QCOMPARE(sa == b.midRef(0), a == b);
+
+            const QByteArray latin1 = b.toLatin1();
+            if (QString::fromLatin1(latin1) == b)
+                QCOMPARE(sa == QLatin1String(latin1), a == b);
+        }
+    }
+}
+
+void tst_QSmallString::compareCaseInsensitive()
+{
+    QSmallString s(QLatin1String("Hello"));
+    QVERIFY(s.compare(QString("hELLO"), Qt::CaseInsensitive) == 0);
+    QVERIFY(s.compare(QLatin1String("HELLO"), Qt::CaseInsensitive) == 0);
+    QVERIFY(s.compare(QSmallString(QLatin1String("hellp")), Qt::CaseInsensitive) < 0);
+    QVERIFY(s.compare(QString("hell"), Qt::CaseInsensitive) > 0);
+    QVERIFY(s.compare(QString("hello"), Qt::CaseSensitive) != 0);
+
+    // U+10400 DESERET CAPITAL LETTER LONG I folds to U+10428
+    const uint upperUcs4 = 0x10400;
+    const uint lowerUcs4 = 0x10428;
+    const QString upper = QString::fromUcs4(&upperUcs4, 1);
+    const QString lower = QString::fromUcs4(&lowerUcs4, 1);
+    QVERIFY(QSmallString(upper).compare(lower, Qt::CaseInsensitive) == 0);
+}
+
+void tst_QSmallString::conversions_data()
+{
+    constructors_data();
+}
+
+void tst_QSmallString::conversions()
+{
+    QFETCH(QString, string);
+
+    QSmallString s(string);
+    const QString converted = s;
+    QCOMPARE(converted, string);
+    QCOMPARE(s.toUtf8(), string.toUtf8());
+    QCOMPARE(s.toLatin1(), string.toLatin1());
+    QCOMPARE(QString(s).size(), string.size());
+
+    // QString API accepts QSmallString through the implicit conversion
+    QCOMPARE(string.compare(s), 0);
+    QVERIFY(QString("prefix").append(s).endsWith(string));
+}
+
+void tst_QSmallString::fromUtf8_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+
+    QTest::newRow("null") << QByteArray();
+    QTest::newRow("ascii-short") << QByteArray("key");
+    QTest::newRow("ascii-full") << QByteArray("0123456789a");
+    QTest::newRow("ascii-long") << QByteArray("0123456789ab");
+    QTest::newRow("non-ascii-short") << QByteArray("caf\xc3\xa9");
+    QTest::newRow("non-ascii-long") << QByteArray("\xe2\x82\xac\xe2\x82\xac\xe2\x82\xac\xe2\x82\xac\xe2\x82\xac");
+    QTest::newRow("bom") << QByteArray("\xef\xbb\xbfkey");
+    QTest::newRow("invalid") << QByteArray("a\xff" "b");
+    QTest::newRow("embedded-null") << QByteArray("a\0b", 3);
+}
+
+void tst_QSmallString::fromUtf8()
+{
+    QFETCH(QByteArray, utf8);
+
+    const QString expected = QString::fromUtf8(utf8.constData(), utf8.size());
+    QSmallString s = QSmallString::fromUtf8(utf8.constData(), utf8.size());
+    QCOMPARE(s.toString(), expected);
+    QCOMPARE(s.isInline(), expected.size() <= QSmallString::InlineCapacity);
+
+    QCOMPARE(QSmallString::fromUtf8(utf8).toString(), QString::fromUtf8(utf8));
+    QCOMPARE(QSmallString::fromLatin1(utf8).toString(), QString::fromLatin1(utf8));
+    QCOMPARE(QSmallString::fromLatin1(utf8.constData(), utf8.size()).toString(),
+             QString::fromLatin1(utf8.constData(), utf8.size()));
+}
+
+void tst_QSmallString::hash()
+{
+    const QStringList strings = QStringList()
+            << QString() << "a" << "hello" << "0123456789a" << "a considerably longer string";
+    foreach (const QString &str, strings) {
+        QCOMPARE(qHash(QSmallString(str)), qHash(str));
+        QCOMPARE(qHash(QSmallString(str), 42), qHash(str, 42));
+    }
+}
+
+void tst_QSmallString::asHashKey()
+{
+    QHash<QSmallString, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(QSmallString(QString::number(i * 1000000007LL)), i);
+    QCOMPARE(hash.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(QSmallString(QString::number(i * 1000000007LL))), i);
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallString)
+#include "tst_qsmallstring.moc"
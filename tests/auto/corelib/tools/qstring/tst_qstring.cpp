@@ -143,6 +143,8 @@ private slots:
     void toUpper();
     void toLower();
     void toCaseFolded();
+    void caseConversionBlocks();
+    void compareCaseInsensitiveBlocks();
     void rightJustified();
     void leftJustified();
     void mid();
@@ -1999,6 +2001,65 @@ void tst_QString::toCaseFolded()
     }
 }
 
+static QString perCharacter(const QString &str, QChar (QChar::*convert)() const)
+{
+    QString result = str;
+    for (int i = 0; i < result.size(); ++i)
+        result[i] = (result.at(i).*convert)();
+    return result;
+}
+
+void tst_QString::caseConversionBlocks()
+{
+    // place a character that changes, or a non-ASCII one, at every offset
+    // relative to the blocks the vectorized code works on
+    const QChar specials[] = { QLatin1Char('Q'), QLatin1Char('q'), QChar(0xc4), QChar(0xe4), QChar(0x3a3) };
+    for (int size = 1; size < 40; ++size) {
+        for (int pos = 0; pos < size; ++pos) {
+            for (uint i = 0; i < sizeof specials / sizeof specials[0]; ++i) {
+                QString str(size, QLatin1Char('7'));
+                for (int j = 0; j < size; j += 3)
+                    str[j] = QLatin1Char(" -x"[j % 3]);
+                str[pos] = specials[i];
+                QCOMPARE(str.toLower(), perCharacter(str, &QChar::toLower));
+                QCOMPARE(str.toUpper(), perCharacter(str, &QChar::toUpper));
+                QCOMPARE(str.toCaseFolded(), perCharacter(str, &QChar::toCaseFolded));
+            }
+        }
+    }
+}
+
+void tst_QString::compareCaseInsensitiveBlocks()
+{
+    const QString base = QStringLiteral("Content-Type: Application/JSON; Charset=UTF-8");
+    const QString lower = base.toLower();
+    const QByteArray latin1 = lower.toLatin1();
+    QCOMPARE(QString::compare(base, lower, Qt::CaseInsensitive), 0);
+    QCOMPARE(QString::compare(base, QLatin1String(latin1), Qt::CaseInsensitive), 0);
+
+    // a difference at every offset, with ASCII and non-ASCII characters
+    for (int pos = 0; pos < base.size(); ++pos) {
+        QString other = lower;
+        other[pos] = QLatin1Char('~');
+        const int expected = base.at(pos).toCaseFolded().unicode() - '~';
+        QCOMPARE(qBound(-1, QString::compare(base, other, Qt::CaseInsensitive), 1), qBound(-1, expected, 1));
+        QCOMPARE(qBound(-1, QString::compare(base, QLatin1String(other.toLatin1()), Qt::CaseInsensitive), 1),
+                 qBound(-1, expected, 1));
+
+        QString accented = base;
+        accented[pos] = QChar(0xc9);
+        QString accentedLower = lower;
+        accentedLower[pos] = QChar(0xe9);
+        QCOMPARE(QString::compare(accented, accentedLower, Qt::CaseInsensitive), 0);
+        QCOMPARE(QString::compare(accented, QLatin1String(accentedLower.toLatin1()), Qt::CaseInsensitive), 0);
+        QVERIFY(QString::compare(accented, lower, Qt::CaseInsensitive) != 0);
+    }
+
+    // '@' and '[' surround the upper case letters, '`' and '{' the lower case ones
+    QVERIFY(QString::compare(QStringLiteral("@@@@@@@@@@"), QStringLiteral("``````````"), Qt::CaseInsensitive) != 0);
+    QVERIFY(QString::compare(QStringLiteral("[[[[[[[[[["), QStringLiteral("{{{{{{{{{{"), Qt::CaseInsensitive) != 0);
+}
+
 void tst_QString::trimmed()
 {
     QString a;
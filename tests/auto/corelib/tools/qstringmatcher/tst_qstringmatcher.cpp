@@ -54,6 +54,7 @@ private slots:
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
+    void indexInAllPositions();
 };
 
 void tst_QStringMatcher::qstringmatcher()
@@ -146,6 +147,45 @@ void tst_QStringMatcher::assignOperator()
     QCOMPARE(m2.indexIn(hayStack), 3);
 }
 
+static int naiveIndexOf(const QString &haystack, const QString &needle, int from)
+{
+    for (int i = from; i + needle.size() <= haystack.size(); ++i) {
+        if (haystack.midRef(i, needle.size()) == needle)
+            return i;
+    }
+    return -1;
+}
+
+void tst_QStringMatcher::indexInAllPositions()
+{
+    // exercise every offset relative to the vector blocks, with a haystack
+    // full of candidates that match the first and the last character only
+    for (int needleSize = 1; needleSize <= 40; needleSize += 3) {
+        QString needle(needleSize, QChar(0x436));
+        needle[0] = QLatin1Char('a');
+        needle[needleSize - 1] = QChar(0x7a7a);
+        QString filler;
+        while (filler.size() < 100)
+            filler += needle.left(needleSize - 1) + QLatin1Char('a');
+        filler.truncate(100);
+
+        const QStringMatcher matcher(needle);
+        for (int pos = 0; pos <= filler.size(); ++pos) {
+            QString haystack = filler;
+            haystack.insert(pos, needle);
+            for (int from = 0; from < haystack.size(); from += 13) {
+                const int expected = naiveIndexOf(haystack, needle, from);
+                QCOMPARE(matcher.indexIn(haystack, from), expected);
+                QCOMPARE(matcher.indexIn(haystack.constData(), haystack.size(), from), expected);
+                QCOMPARE(haystack.indexOf(needle, from), expected);
+            }
+            const QString cut = haystack.left(pos + needleSize - 1);
+            QCOMPARE(matcher.indexIn(cut), naiveIndexOf(cut, needle, 0));
+            QCOMPARE(cut.indexOf(needle), naiveIndexOf(cut, needle, 0));
+        }
+    }
+}
+
 QTEST_MAIN(tst_QStringMatcher)
 #include "tst_qstringmatcher.moc"
 
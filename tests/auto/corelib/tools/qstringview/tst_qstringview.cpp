@@ -0,0 +1,484 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qstring.h>
+#include <qlocale.h>
+#include <qstringmatcher.h>
+#include <qregularexpression.h>
+#include <qhash.h>
+
+class tst_QStringView : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void constructors();
+    void slicing_data();
+    void slicing();
+    void trimmed_data();
+    void trimmed();
+    void truncateAndChop();
+    void indexOf_data();
+    void indexOf();
+    void lastIndexOf();
+    void startsWithEndsWith();
+    void compare_data();
+    void compare();
+    void conversions();
+    void toNumber_data();
+    void toNumber();
+    void toDouble();
+    void hash();
+    void stringOverloads();
+    void localeToNumber_data();
+    void localeToNumber();
+    void stringMatcher();
+    void regularExpression();
+};
+
+void tst_QStringView::constructors()
+{
+    QStringView null;
+    QVERIFY(null.isNull());
+    QVERIFY(null.isEmpty());
+    QCOMPARE(null.size(), 0);
+
+    const QString nullString;
+    QVERIFY(QStringView(nullString).isNull());
+
+    const QString empty(QLatin1String(""));
+    QVERIFY(!QStringView(empty).isNull());
+    QVERIFY(QStringView(empty).isEmpty());
+
+    const QString str(QStringLiteral("Hello World"));
+    QStringView v(str);
+    QCOMPARE(v.size(), str.size());
+    QCOMPARE(v.length(), str.size());
+    QVERIFY(v.data() == str.constData());
+    QVERIFY(v.utf16() == str.utf16());
+    QCOMPARE(v.at(4), QChar('o'));
+    QCOMPARE(v[6], QChar('W'));
+
+    QStringRef ref = str.midRef(6);
+    QStringView fromRef(ref);
+    QCOMPARE(fromRef.size(), 5);
+    QVERIFY(fromRef.data() == str.constData() + 6);
+    QVERIFY(fromRef == QLatin1String("World"));
+
+    const ushort utf16[] = { 'a', 'b', 'c' };
+    QStringView fromUtf16(utf16, 3);
+    QCOMPARE(fromUtf16.toString(), QString("abc"));
+
+    QString iterated;
+    for (QStringView::const_iterator it = v.begin(); it != v.end(); ++it)
+        iterated += *it;
+    QCOMPARE(iterated, str);
+}
+
+void tst_QStringView::slicing_data()
+{
+    QTest::addColumn<int>("pos");
+    QTest::addColumn<int>("n");
+
+    QTest::newRow("all") << 0 << -1;
+    QTest::newRow("middle") << 3 << 4;
+    QTest::newRow("tail") << 5 << -1;
+    QTest::newRow("past-end") << 20 << 2;
+    QTest::newRow("negative-pos") << -2 << 5;
+    QTest::newRow("negative-both") << -3 << -1;
+    QTest::newRow("too-long") << 8 << 100;
+    QTest::newRow("empty") << 11 << 3;
+}
+
+void tst_QStringView::slicing()
+{
+    QFETCH(int, pos);
+    QFETCH(int, n);
+
+    const QString str(QStringLiteral("Hello World"));
+    const QStringView v(str);
+
+    QCOMPARE(v.mid(pos, n).toString(), str.mid(pos, n));
+    QCOMPARE(v.left(pos).toString(), str.left(pos));
+    QCOMPARE(v.right(pos).toString(), str.right(pos));
+    QCOMPARE(v.mid(pos, n).isNull(), str.midRef(pos, n).isNull());
+}
+
+void tst_QStringView::trimmed_data()
+{
+    QTest::addColumn<QString>("input");
+
+    QTest::newRow("empty") << QString("");
+    QTest::newRow("blank") << QString(" \t\n ");
+    QTest::newRow("none") << QString("abc");
+    QTest::newRow("both") << QString("  a b c\t");
+    QTest::newRow("leading") << QString("\n\nabc");
+    QTest::newRow("trailing") << QString("abc  ");
+}
+
+void tst_QStringView::trimmed()
+{
+    QFETCH(QString, input);
+
+    const QStringView v(input);
+    const QStringView t = v.trimmed();
+    QCOMPARE(t.toString(), input.trimmed());
+    QVERIFY(t.isEmpty() || (t.data() >= v.data() && t.end() <= v.end()));
+}
+
+void tst_QStringView::truncateAndChop()
+{
+    const QString str(QStringLiteral("abcdef"));
+    QStringView v(str);
+    v.truncate(10);
+    QCOMPARE(v.size(), 6);
+    v.truncate(4);
+    QVERIFY(v == QLatin1String("abcd"));
+    v.chop(1);
+    QVERIFY(v == QLatin1String("abc"));
+    v.chop(-1);
+    QCOMPARE(v.size(), 3);
+    v.chop(10);
+    QVERIFY(v.isEmpty());
+    QVERIFY(!v.isNull());
+    v = QStringView(str);
+    v.truncate(-1);
+    QVERIFY(v.isEmpty());
+}
+
+void tst_QStringView::indexOf_data()
+{
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<QString>("needle");
+    QTest::addColumn<int>("from");
+    QTest::addColumn<bool>("caseSensitive");
+
+    QTest::newRow("simple") << QString("Hello World") << QString("World") << 0 << true;
+    QTest::newRow("from") << QString("abcabc") << QString("bc") << 2 << true;
+    QTest::newRow("missing") << QString("abcabc") << QString("cd") << 0 << true;
+    QTest::newRow("insensitive") << QString("Hello World") << QString("wORLD") << 0 << false;
+    QTest::newRow("char") << QString("Hello World") << QString("o") << 5 << true;
+    QTest::newRow("char-insensitive") << QString("Hello World") << QString("W") << 0 << false;
+    QTest::newRow("negative-from") << QString("abcabc") << QString("a") << -3 << true;
+    QTest::newRow("empty-needle") << QString("abc") << QString("") << 1 << true;
+    QTest::newRow("long") << QString(600, 'x') + QString("needle") << QString("needle") << 0 << true;
+}
+
+void tst_QStringView::indexOf()
+{
+    QFETCH(QString, haystack);
+    QFETCH(QString, needle);
+    QFETCH(int, from);
+    QFETCH(bool, caseSensitive);
+
+    const Qt::CaseSensitivity cs = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    const int expected = haystack.indexOf(needle, from, cs);
+    const QStringView v(haystack);
+    const QByteArray latin1 = needle.toLatin1();
+
+    QCOMPARE(v.indexOf(QStringView(needle), from, cs), expected);
+    QCOMPARE(v.indexOf(QLatin1String(latin1), from, cs), expected);
+    QCOMPARE(v.contains(QStringView(needle), cs), haystack.contains(needle, cs));
+    if (needle.size() == 1) {
+        QCOMPARE(v.indexOf(needle.at(0), from, cs), expected);
+        QCOMPARE(v.contains(needle.at(0), cs), expected != -1 || haystack.contains(needle, cs));
+    }
+}
+
+void tst_QStringView::lastIndexOf()
+{
+    const QString str(QStringLiteral("a,b,c,D"));
+    const QStringView v(str);
+    QCOMPARE(v.lastIndexOf(QChar(',')), 5);
+    QCOMPARE(v.lastIndexOf(QChar(','), 4), 3);
+    QCOMPARE(v.lastIndexOf(QChar(','), -3), 3);
+    QCOMPARE(v.lastIndexOf(QChar('d')), -1);
+    QCOMPARE(v.lastIndexOf(QChar('d'), -1, Qt::CaseInsensitive), 6);
+    QCOMPARE(QStringView().lastIndexOf(QChar('a')), -1);
+}
+
+void tst_QStringView::startsWithEndsWith()
+{
+    const QString str(QStringLiteral("Hello World"));
+    const QStringView v(str);
+
+    QVERIFY(v.startsWith(QStringView(str).left(5)));
+    QVERIFY(v.startsWith(QLatin1String("Hello")));
+    QVERIFY(v.startsWith(QLatin1String("hELLO"), Qt::CaseInsensitive));
+    QVERIFY(!v.startsWith(QLatin1String("hello")));
+    QVERIFY(v.startsWith(QChar('H')));
+    QVERIFY(v.startsWith(QChar('h'), Qt::CaseInsensitive));
+    QVERIFY(!v.startsWith(QChar('h')));
+
+    QVERIFY(v.endsWith(QStringView(str).right(5)));
+    QVERIFY(v.endsWith(QLatin1String("World")));
+    QVERIFY(v.endsWith(QLatin1String("WORLD"), Qt::CaseInsensitive));
+    QVERIFY(!v.endsWith(QLatin1String("WORLD")));
+    QVERIFY(v.endsWith(QChar('d')));
+    QVERIFY(v.endsWith(QChar('D'), Qt::CaseInsensitive));
+    QVERIFY(!v.endsWith(QLatin1String("Hello World!")));
+
+    QVERIFY(!QStringView().startsWith(QChar('a')));
+    QVERIFY(!QStringView().endsWith(QChar('a')));
+}
+
+void tst_QStringView::compare_data()
+{
+    QTest::addColumn<QString>("s1");
+    QTest::addColumn<QString>("s2");
+
+    QTest::newRow("equal") << QString("abc") << QString("abc");
+    QTest::newRow("less") << QString("abc") << QString("abd");
+    QTest::newRow("greater") << QString("abd") << QString("abc");
+    QTest::newRow("prefix") << QString("ab") << QString("abc");
+    QTest::newRow("case") << QString("ABC") << QString("abc");
+    QTest::newRow("empty") << QString("") << QString("a");
+    QTest::newRow("unicode") << QString::fromUtf8("\xc3\xa9t\xc3\xa9") << QString::fromUtf8("\xc3\x89T\xc3\x89");
+}
+
+static inline int sign(int x)
+{
+    return x < 0 ? -1 : (x > 0 ? 1 : 0);
+}
+
+void tst_QStringView::compare()
+{
+    QFETCH(QString, s1);
+    QFETCH(QString, s2);
+
+    const QStringView v1(s1);
+    const QStringView v2(s2);
+
+    QCOMPARE(sign(v1.compare(v2)), sign(s1.compare(s2)));
+    QCOMPARE(sign(v1.compare(v2, Qt::CaseInsensitive)), sign(s1.compare(s2, Qt::CaseInsensitive)));
+    QCOMPARE(sign(s1.compare(v2)), sign(s1.compare(s2)));
+    QCOMPARE(v1 == v2, s1 == s2);
+    QCOMPARE(v1 != v2, s1 != s2);
+    QCOMPARE(v1 < v2, s1 < s2);
+    QCOMPARE(v1 <= v2, s1 <= s2);
+    QCOMPARE(v1 > v2, s1 > s2);
+    QCOMPARE(v1 >= v2, s1 >= s2);
+
+    const QByteArray latin1 = s2.toLatin1();
+    if (QString::fromLatin1(latin1) == s2) {
+        QCOMPARE(sign(v1.compare(QLatin1String(latin1))), sign(s1.compare(s2)));
+        QCOMPARE(v1 == QLatin1String(latin1), s1 == s2);
+        QCOMPARE(QLatin1String(latin1) != v1, s1 != s2);
+    }
+}
+
+void tst_QStringView::conversions()
+{
+    const QString str = QString::fromUtf8("gr\xc3\xbc\xc3\x9f Gott");
+    const QStringView v(str);
+    QCOMPARE(v.toString(), str);
+    QCOMPARE(v.toUtf8(), str.toUtf8());
+    QCOMPARE(v.toLatin1(), str.toLatin1());
+    QCOMPARE(v.toLocal8Bit(), str.toLocal8Bit());
+    QCOMPARE(v.left(3).toUtf8(), QByteArray("gr\xc3\xbc"));
+
+    QVERIFY(QStringView().toString().isNull());
+    QVERIFY(QStringView().toUtf8().isNull());
+    QVERIFY(!QStringView(str).left(0).toString().isNull());
+}
+
+void tst_QStringView::toNumber_data()
+{
+    QTest::addColumn<QString>("input");
+    QTest::addColumn<int>("base");
+
+    QTest::newRow("int") << QString("1234") << 10;
+    QTest::newRow("negative") << QString("-42") << 10;
+    QTest::newRow("spaces") << QString("  17 ") << 10;
+    QTest::newRow("hex") << QString("ff") << 16;
+    QTest::newRow("auto-hex") << QString("0x1F") << 0;
+    QTest::newRow("overflow-int") << QString("4294967296") << 10;
+    QTest::newRow("overflow-short") << QString("70000") << 10;
+    QTest::newRow("garbage") << QString("12a") << 10;
+    QTest::newRow("empty") << QString("") << 10;
+    QTest::newRow("large") << QString("18446744073709551615") << 10;
+}
+
+void tst_QStringView::toNumber()
+{
+    QFETCH(QString, input);
+    QFETCH(int, base);
+
+    const QStringView v(input);
+    bool ok1, ok2;
+
+    QCOMPARE(v.toShort(&ok1, base), input.toShort(&ok2, base));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(v.toUShort(&ok1, base), input.toUShort(&ok2, base));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(v.toInt(&ok1, base), input.toInt(&ok2, base));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(v.toUInt(&ok1, base), input.toUInt(&ok2, base));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(v.toLongLong(&ok1, base), input.toLongLong(&ok2, base));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(v.toULongLong(&ok1, base), input.toULongLong(&ok2, base));
+    QCOMPARE(ok1, ok2);
+}
+
+void tst_QStringView::toDouble()
+{
+    const QString str(QStringLiteral("x=3.25;y=-1e3;z=oops"));
+    const QStringView v(str);
+    bool ok;
+
+    QCOMPARE(v.mid(2, 4).toDouble(&ok), 3.25);
+    QVERIFY(ok);
+    QCOMPARE(v.mid(9, 4).toDouble(&ok), -1000.0);
+    QVERIFY(ok);
+    QCOMPARE(v.mid(16).toDouble(&ok), 0.0);
+    QVERIFY(!ok);
+    QCOMPARE(v.mid(2, 4).toFloat(&ok), 3.25f);
+    QVERIFY(ok);
+    QCOMPARE(QStringView(QString("1e300")).toFloat(&ok), 0.0f);
+    QVERIFY(!ok);
+}
+
+void tst_QStringView::hash()
+{
+    const QString str(QStringLiteral("key=value"));
+    QCOMPARE(qHash(QStringView(str)), qHash(str));
+    QCOMPARE(qHash(QStringView(str).left(3), 42), qHash(QString("key"), 42));
+}
+
+void tst_QStringView::stringOverloads()
+{
+    const QString haystack(QStringLiteral("The quick brown fox"));
+    const QString source(QStringLiteral("[brown]"));
+    const QStringView needle = QStringView(source).mid(1, 5);
+
+    QCOMPARE(haystack.indexOf(needle), 10);
+    QCOMPARE(haystack.indexOf(needle, 11), -1);
+    QCOMPARE(haystack.indexOf(QStringView(QString("BROWN")), 0, Qt::CaseInsensitive), 10);
+    QVERIFY(haystack.contains(needle));
+    QVERIFY(!haystack.contains(QStringView(QString("BROWN"))));
+    QVERIFY(haystack.contains(QStringView(QString("BROWN")), Qt::CaseInsensitive));
+    QCOMPARE(QString("brown").compare(needle), 0);
+    QVERIFY(QString("Brown").compare(needle) < 0);
+    QCOMPARE(QString("Brown").compare(needle, Qt::CaseInsensitive), 0);
+}
+
+void tst_QStringView::localeToNumber_data()
+{
+    QTest::addColumn<QString>("locale");
+    QTest::addColumn<QString>("input");
+
+    QTest::newRow("C-int") << QString("C") << QString("123456");
+    QTest::newRow("C-double") << QString("C") << QString("-1.5e2");
+    QTest::newRow("de-group") << QString("de_DE") << QString("1.234,5");
+    QTest::newRow("fr-space") << QString("fr_FR") << QString::fromUtf8(" 1\xc2\xa0""234 ");
+    QTest::newRow("en-bad") << QString("en_US") << QString("12x");
+}
+
+void tst_QStringView::localeToNumber()
+{
+    QFETCH(QString, locale);
+    QFETCH(QString, input);
+
+    const QLocale l(locale);
+    const QString padded = QLatin1String("<<") + input + QLatin1String(">>");
+    const QStringView v = QStringView(padded).mid(2, input.size());
+    bool ok1, ok2;
+
+    QCOMPARE(l.toShort(v, &ok1), l.toShort(input, &ok2));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(l.toUShort(v, &ok1), l.toUShort(input, &ok2));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(l.toInt(v, &ok1), l.toInt(input, &ok2));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(l.toUInt(v, &ok1), l.toUInt(input, &ok2));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(l.toLongLong(v, &ok1), l.toLongLong(input, &ok2));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(l.toULongLong(v, &ok1), l.toULongLong(input, &ok2));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(l.toFloat(v, &ok1), l.toFloat(input, &ok2));
+    QCOMPARE(ok1, ok2);
+    QCOMPARE(l.toDouble(v, &ok1), l.toDouble(input, &ok2));
+    QCOMPARE(ok1, ok2);
+}
+
+void tst_QStringView::stringMatcher()
+{
+    const QString source(QStringLiteral("(needle)"));
+    const QStringMatcher matcher(QStringView(source).mid(1, 6));
+    QCOMPARE(matcher.pattern(), QString("needle"));
+
+    const QString haystack = QString(100, 'x') + QLatin1String("needle") + QString(10, 'y');
+    QCOMPARE(matcher.indexIn(QStringView(haystack)), 100);
+    QCOMPARE(matcher.indexIn(QStringView(haystack), 101), -1);
+    QCOMPARE(matcher.indexIn(QStringView(haystack).left(105)), -1);
+    QCOMPARE(matcher.indexIn(QStringView()), -1);
+
+    const QStringMatcher insensitive(QStringView(source).mid(1, 6), Qt::CaseInsensitive);
+    QCOMPARE(insensitive.indexIn(QStringView(QString("a NEEDLE"))), 2);
+}
+
+void tst_QStringView::regularExpression()
+{
+    const QRegularExpression re(QStringLiteral("(\\d+)-(\\d+)"));
+    const QString str(QStringLiteral("range: 10-20, 30-40"));
+    const QStringView v = QStringView(str).mid(14);
+
+    QRegularExpressionMatch m = re.match(v);
+    QVERIFY(m.hasMatch());
+    QCOMPARE(m.capturedStart(), 0);
+    QCOMPARE(m.captured(1), QString("30"));
+    QCOMPARE(m.capturedRef(2).toString(), QString("40"));
+
+    m = re.match(QStringView(str), 8);
+    QVERIFY(m.hasMatch());
+    QCOMPARE(m.captured(0), QString("0-20"));
+
+    m = re.match(QStringView(str).left(9));
+    QVERIFY(!m.hasMatch());
+    m = re.match(QStringView(str).left(9), 0, QRegularExpression::PartialPreferCompleteMatch);
+    QVERIFY(m.hasPartialMatch());
+}
+
+QTEST_APPLESS_MAIN(tst_QStringView)
+#include "tst_qstringview.moc"
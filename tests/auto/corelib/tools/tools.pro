@@ -1,10 +1,12 @@
 TEMPLATE=subdirs
 SUBDIRS=\
     qalgorithms \
+    qarena \
     qarraydata \
     qbitarray \
     qbytearray \
     qbytearraymatcher \
+    qbytearrayview \
     qbytedatabuffer \
     qcache \
     qchar \
@@ -17,6 +19,8 @@ SUBDIRS=\
     qeasingcurve \
     qelapsedtimer \
     qexplicitlyshareddatapointer \
+    qflathash \
+    qflatmap \
     qfreelist \
     qhash \
     qline \
@@ -40,6 +44,8 @@ SUBDIRS=\
     qsharedpointer \
     qsize \
     qsizef \
+    qsmallbytearray \
+    qsmallstring \
     qstl \
     qstring \
     qstring_no_cast_from_bytearray \
@@ -47,6 +53,7 @@ SUBDIRS=\
     qstringlist \
     qstringmatcher \
     qstringref \
+    qstringview \
     qtextboundaryfinder \
     qtime \
     qtimezone \
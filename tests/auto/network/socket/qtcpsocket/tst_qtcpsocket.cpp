@@ -199,6 +199,8 @@ private slots:
     void qtbug14268_peek();
 
     void setSocketOption();
+    void sendFile_data();
+    void sendFile();
 
 
 protected slots:
@@ -2746,5 +2748,63 @@ void tst_QTcpSocket::setSocketOption()
     QVERIFY(v.isValid() && v.toInt() == 32);
 }
 
+void tst_QTcpSocket::sendFile_data()
+{
+    QTest::addColumn<bool>("writeFirst");
+
+    QTest::newRow("empty-write-buffer") << false;
+    QTest::newRow("after-write") << true;
+}
+
+void tst_QTcpSocket::sendFile()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+    QFETCH(bool, writeFirst);
+
+    QByteArray data(1024 * 1024, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i % 251);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), qint64(data.size()));
+    QVERIFY(file.seek(10));
+
+    SocketPair socketPair;
+    QVERIFY(socketPair.create());
+    QTcpSocket *outgoing = socketPair.endPoints[0];
+    QTcpSocket *incoming = socketPair.endPoints[1];
+    QSignalSpy spy(outgoing, SIGNAL(bytesWritten(qint64)));
+
+    QByteArray expected;
+    if (writeFirst) {
+        outgoing->write("head");
+        expected += "head";
+    }
+    const int offset = 1000;
+    const int length = data.size() - 2000;
+    QVERIFY(outgoing->sendFile(&file, offset, length));
+    QCOMPARE(outgoing->bytesToWrite(), qint64(expected.size() + length));
+    outgoing->write("tail");
+    expected += data.mid(offset, length) + "tail";
+
+    QByteArray received;
+    QElapsedTimer timer;
+    timer.start();
+    while (received.size() < expected.size() && timer.elapsed() < 10000) {
+        QTest::qWait(10);
+        received += incoming->readAll();
+    }
+    QCOMPARE(received, expected);
+
+    qint64 written = 0;
+    for (int i = 0; i < spy.count(); ++i)
+        written += spy.at(i).at(0).toLongLong();
+    QCOMPARE(written, qint64(expected.size()));
+    QCOMPARE(outgoing->bytesToWrite(), qint64(0));
+    QCOMPARE(file.pos(), qint64(10));
+}
+
 QTEST_MAIN(tst_QTcpSocket)
 #include "tst_qtcpsocket.moc"
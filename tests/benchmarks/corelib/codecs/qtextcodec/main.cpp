@@ -55,6 +55,10 @@ private slots:
     void fromUnicode() const;
     void toUnicode_data() const;
     void toUnicode() const;
+    void fromUtf8_data() const;
+    void fromUtf8() const;
+    void toUtf8_data() const;
+    void toUtf8() const;
 };
 
 void tst_QTextCodec::codecForName() const
@@ -174,7 +178,59 @@ void tst_QTextCodec::toUnicode() const
     }
 }
 
+void tst_QTextCodec::fromUtf8_data() const
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QString testFile = QFINDTESTDATA("utf-8.txt");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file utf-8.txt!");
+    QFile file(testFile);
+    QVERIFY(file.open(QFile::ReadOnly));
+    QByteArray mixed = file.readAll();
+
+    // mostly ASCII, like typical JSON or HTTP payloads
+    QByteArray ascii;
+    for (int i = 0; i < 1024; ++i)
+        ascii += "{\"key\": \"value\", \"number\": 12345, \"array\": [1, 2, 3]}\n";
+
+    QByteArray asciiWithAccents;
+    for (int i = 0; i < 1024; ++i)
+        asciiWithAccents += "{\"key\": \"val\xc3\xa9ur\", \"number\": 12345, \"array\": [1, 2, 3]}\n";
+
+    QTest::newRow("ascii") << ascii;
+    QTest::newRow("ascii-with-accents") << asciiWithAccents;
+    QTest::newRow("utf-8.txt") << mixed;
+}
+
+void tst_QTextCodec::fromUtf8() const
+{
+    QFETCH(QByteArray, data);
+    QString result;
+
+    QBENCHMARK {
+        for (int i = 0; i < 10; i ++)
+            result = QString::fromUtf8(data);
+    }
+    QVERIFY(!result.isEmpty());
+}
+
+void tst_QTextCodec::toUtf8_data() const
+{
+    fromUtf8_data();
+}
 
+void tst_QTextCodec::toUtf8() const
+{
+    QFETCH(QByteArray, data);
+    QString s = QString::fromUtf8(data);
+    QByteArray result;
+
+    QBENCHMARK {
+        for (int i = 0; i < 10; i ++)
+            result = s.toUtf8();
+    }
+    QCOMPARE(result, data);
+}
 
 
 QTEST_MAIN(tst_QTextCodec)
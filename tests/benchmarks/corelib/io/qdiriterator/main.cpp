@@ -40,7 +40,11 @@
 ****************************************************************************/
 #include <QDebug>
 #include <QDirIterator>
+#include <QFile>
+#include <QParallelDirIterator>
 #include <QString>
+#include <QTemporaryDir>
+#include <QThreadPool>
 
 #ifdef Q_OS_WIN
 #   include <qt_windows.h>
@@ -66,9 +70,74 @@ private slots:
     void diriterator_data() { data(); }
     void fsiterator();
     void fsiterator_data() { data(); }
+    void paralleliterator();
+    void paralleliterator_data() { data(); }
     void data();
+
+private:
+    QByteArray bigDirPath();
+    QByteArray treePath();
+
+    QScopedPointer<QTemporaryDir> bigDir;
+    QScopedPointer<QTemporaryDir> tree;
 };
 
+// A flat directory with this many files; set QDIRITERATOR_BENCH_ENTRIES
+// (e.g. to 1000000) to measure really large directories
+static int bigDirEntryCount()
+{
+    const QByteArray count = qgetenv("QDIRITERATOR_BENCH_ENTRIES");
+    return count.isEmpty() ? 10000 : count.toInt();
+}
+
+QByteArray tst_qdiriterator::bigDirPath()
+{
+    if (!bigDir) {
+        bigDir.reset(new QTemporaryDir);
+        if (!bigDir->isValid()) {
+            fprintf(stderr, "Could not create a temporary directory\n");
+            exit(1);
+        }
+        const QString path = bigDir->path() + QLatin1Char('/');
+        const int count = bigDirEntryCount();
+        for (int i = 0; i < count; ++i) {
+            QFile file(path + QString::number(i));
+            if (!file.open(QIODevice::WriteOnly)) {
+                fprintf(stderr, "Could not create %s\n", qPrintable(file.fileName()));
+                exit(1);
+            }
+        }
+    }
+    return QFile::encodeName(bigDir->path());
+}
+
+// 100 directories with 10 subdirectories of 100 files each
+QByteArray tst_qdiriterator::treePath()
+{
+    if (!tree) {
+        tree.reset(new QTemporaryDir);
+        if (!tree->isValid()) {
+            fprintf(stderr, "Could not create a temporary directory\n");
+            exit(1);
+        }
+        QDir root(tree->path());
+        for (int i = 0; i < 100; ++i) {
+            for (int j = 0; j < 10; ++j) {
+                const QString dir = QString::fromLatin1("%1/%2").arg(i).arg(j);
+                root.mkpath(dir);
+                for (int k = 0; k < 100; ++k) {
+                    QFile file(root.filePath(dir + QLatin1Char('/') + QString::number(k)));
+                    if (!file.open(QIODevice::WriteOnly)) {
+                        fprintf(stderr, "Could not create %s\n", qPrintable(file.fileName()));
+                        exit(1);
+                    }
+                }
+            }
+        }
+    }
+    return QFile::encodeName(tree->path());
+}
+
 
 void tst_qdiriterator::data()
 {
@@ -81,17 +150,19 @@ void tst_qdiriterator::data()
 #else
     const char *qtdir = ::getenv("QTDIR");
 #endif
-    if (!qtdir) {
-        fprintf(stderr, "QTDIR not set\n");
-        exit(1);
-    }
 #endif
 
     QTest::addColumn<QByteArray>("dirpath");
-    QByteArray ba = QByteArray(qtdir) + "/src/corelib";
-    QByteArray ba1 = ba + "/io";
-    QTest::newRow(ba) << ba;
-    //QTest::newRow(ba1) << ba1;
+    if (qtdir) {
+        QByteArray ba = QByteArray(qtdir) + "/src/corelib";
+        QByteArray ba1 = ba + "/io";
+        QTest::newRow(ba) << ba;
+        //QTest::newRow(ba1) << ba1;
+    }
+
+    const QByteArray bigDirName = QByteArray::number(bigDirEntryCount()) + " entries";
+    QTest::newRow(bigDirName) << bigDirPath();
+    QTest::newRow("100x10x100 tree") << treePath();
 }
 
 #ifdef Q_OS_WIN
@@ -247,6 +318,28 @@ void tst_qdiriterator::fsiterator()
     qDebug() << count;
 }
 
+void tst_qdiriterator::paralleliterator()
+{
+    QFETCH(QByteArray, dirpath);
+
+    int count = 0;
+
+    QBENCHMARK {
+        int c = 0;
+
+        QParallelDirIterator dir(dirpath,
+            QDir::Files,
+            QDirIterator::Subdirectories);
+
+        while (dir.hasNext()) {
+            dir.next();
+            ++c;
+        }
+        count = c;
+    }
+    qDebug() << count << "using" << QThreadPool::globalInstance()->maxThreadCount() << "threads";
+}
+
 QTEST_MAIN(tst_qdiriterator)
 
 #include "main.moc"
@@ -120,6 +120,9 @@ private slots:
     void readBigFile_posix();
     void readBigFile_Win32();
 
+    void copy_data();
+    void copy();
+
 private:
     void readBigFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -720,6 +723,35 @@ void tst_qfile::readSmallFiles()
     delete[] buffer;
 }
 
+void tst_qfile::copy_data()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("64k") << 64 * 1024;
+    QTest::newRow("1M") << 1024 * 1024;
+    QTest::newRow("64M") << 64 * 1024 * 1024;
+}
+
+void tst_qfile::copy()
+{
+    QFETCH(int, size);
+
+    QTemporaryFile source;
+    QVERIFY(source.open());
+    const QByteArray block(BUFSIZE, 'x');
+    for (int written = 0; written < size; written += block.size())
+        QVERIFY(source.write(block.constData(), qMin(block.size(), size - written)) > 0);
+    QVERIFY(source.flush());
+
+    const QString target = source.fileName() + QLatin1String(".copy");
+    QFile::remove(target);
+
+    QBENCHMARK {
+        QVERIFY(QFile::copy(source.fileName(), target));
+        QVERIFY(QFile::remove(target));
+    }
+}
+
 QTEST_MAIN(tst_qfile)
 
 #include "main.moc"
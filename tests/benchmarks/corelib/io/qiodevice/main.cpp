@@ -42,6 +42,8 @@
 #include <QIODevice>
 #include <QFile>
 #include <QString>
+#include <QTemporaryFile>
+#include <QVarLengthArray>
 
 #include <qtest.h>
 
@@ -54,8 +56,13 @@ private slots:
     void read_old_data() { read_data(); }
     //void read_new();
     //void read_new_data() { read_data(); }
+    void writeRecords_data() { records_data(); }
+    void writeRecords();
+    void readRecords_data() { records_data(); }
+    void readRecords();
 private:
     void read_data();
+    void records_data();
 };
 
 
@@ -99,6 +106,108 @@ void tst_qiodevice::read_old()
     }
 }
 
+enum RecordMethod { Joined, PerBuffer, Vectored };
+Q_DECLARE_METATYPE(RecordMethod)
+
+static const int recordCount = 1000;
+static const int headerSize = 16;
+
+void tst_qiodevice::records_data()
+{
+    QTest::addColumn<RecordMethod>("method");
+    QTest::addColumn<int>("payloadSize");
+
+    for (int payloadSize = 512; payloadSize <= 32768; payloadSize *= 8) {
+        const QByteArray size = QByteArray::number(payloadSize);
+        QTest::newRow("joined-" + size) << Joined << payloadSize;
+        QTest::newRow("per-buffer-" + size) << PerBuffer << payloadSize;
+        QTest::newRow("vectored-" + size) << Vectored << payloadSize;
+    }
+}
+
+// Writes header + payload records to an unbuffered file, as a log or a
+// storage engine would.
+void tst_qiodevice::writeRecords()
+{
+    QFETCH(RecordMethod, method);
+    QFETCH(int, payloadSize);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.close();
+    QIODevice &dev = file;
+    QVERIFY(dev.open(QIODevice::WriteOnly | QIODevice::Unbuffered));
+
+    const QByteArray header(headerSize, 'h');
+    const QByteArray payload(payloadSize, 'p');
+
+    QBENCHMARK {
+        file.seek(0);
+        for (int i = 0; i < recordCount; ++i) {
+            switch (method) {
+            case Joined:
+                file.write(header + payload);
+                break;
+            case PerBuffer:
+                file.write(header);
+                file.write(payload);
+                break;
+            case Vectored: {
+                QVarLengthArray<QByteArrayView, 2> buffers;
+                buffers.append(header);
+                buffers.append(payload);
+                file.write(buffers);
+                break;
+            }
+            }
+        }
+    }
+    QCOMPARE(file.size(), qint64(recordCount) * (headerSize + payloadSize));
+}
+
+void tst_qiodevice::readRecords()
+{
+    QFETCH(RecordMethod, method);
+    QFETCH(int, payloadSize);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(QByteArray(recordCount * (headerSize + payloadSize), 'r'));
+    file.close();
+    QIODevice &dev = file;
+    QVERIFY(dev.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+
+    char header[headerSize];
+    QByteArray payload(payloadSize, Qt::Uninitialized);
+    QByteArray joined(headerSize + payloadSize, Qt::Uninitialized);
+
+    QBENCHMARK {
+        file.seek(0);
+        for (int i = 0; i < recordCount; ++i) {
+            switch (method) {
+            case Joined:
+                file.read(joined.data(), joined.size());
+                memcpy(header, joined.constData(), headerSize);
+                memcpy(payload.data(), joined.constData() + headerSize, payloadSize);
+                break;
+            case PerBuffer:
+                file.read(header, headerSize);
+                file.read(payload.data(), payloadSize);
+                break;
+            case Vectored: {
+                QVarLengthArray<QIODevice::Buffer, 2> buffers;
+                const QIODevice::Buffer h = { header, headerSize };
+                const QIODevice::Buffer p = { payload.data(), payloadSize };
+                buffers.append(h);
+                buffers.append(p);
+                file.read(buffers);
+                break;
+            }
+            }
+        }
+    }
+    QCOMPARE(file.pos(), qint64(recordCount) * (headerSize + payloadSize));
+}
 
 QTEST_MAIN(tst_qiodevice)
 
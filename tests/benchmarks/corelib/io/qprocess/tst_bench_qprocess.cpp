@@ -50,6 +50,10 @@ class tst_QProcess : public QObject
 private slots:
 
     void echoTest_performance();
+    void startFinish_data();
+    void startFinish();
+    void startManyFinish_data();
+    void startManyFinish();
 
 #endif // QT_NO_PROCESS
 };
@@ -101,6 +105,79 @@ void tst_QProcess::echoTest_performance()
     QVERIFY(process.waitForFinished());
 }
 
+// A reimplemented setupChildProcess() makes QProcess fall back to fork().
+class ForkedProcess : public QProcess
+{
+protected:
+    void setupChildProcess() {}
+};
+
+void tst_QProcess::startFinish_data()
+{
+    QTest::addColumn<bool>("forked");
+    QTest::addColumn<int>("parentMegabytes");
+
+    QTest::newRow("QProcess, small parent") << false << 0;
+    QTest::newRow("QProcess, 256 MB parent") << false << 256;
+    QTest::newRow("subclass, small parent") << true << 0;
+    QTest::newRow("subclass, 256 MB parent") << true << 256;
+}
+
+void tst_QProcess::startFinish()
+{
+    QFETCH(bool, forked);
+    QFETCH(int, parentMegabytes);
+
+    // fork() has to copy the page tables of all the memory we touched
+    QByteArray ballast(parentMegabytes * 1024 * 1024, 'a');
+
+    QBENCHMARK {
+        QScopedPointer<QProcess> process(forked ? new ForkedProcess : new QProcess);
+        process->start("testProcessLoopback/testProcessLoopback");
+        QVERIFY(process->waitForStarted());
+        process->closeWriteChannel();
+        QVERIFY(process->waitForFinished());
+    }
+    QCOMPARE(ballast.size(), parentMegabytes * 1024 * 1024);
+}
+
+void tst_QProcess::startManyFinish_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("8") << 8;
+    QTest::newRow("64") << 64;
+}
+
+void tst_QProcess::startManyFinish()
+{
+    QFETCH(int, count);
+
+    // the children are reaped through the event loop
+    QBENCHMARK {
+        QList<QProcess *> processes;
+        QEventLoop loop;
+        int running = count;
+        for (int i = 0; i < count; ++i) {
+            QProcess *process = new QProcess;
+            QObject::connect(process, SIGNAL(finished(int,QProcess::ExitStatus)), &loop, SLOT(quit()));
+            process->start("testProcessLoopback/testProcessLoopback");
+            process->closeWriteChannel();
+            processes << process;
+        }
+        while (running) {
+            running = 0;
+            foreach (QProcess *process, processes) {
+                if (process->state() != QProcess::NotRunning)
+                    ++running;
+            }
+            if (running)
+                loop.exec();
+        }
+        qDeleteAll(processes);
+    }
+}
+
 #endif // QT_NO_PROCESS && Q_OS_WINCE
 
 QTEST_MAIN(tst_QProcess)
@@ -56,6 +56,7 @@ private Q_SLOTS:
     void cleanup();
 
     void parseNumbers();
+    void writeNumbers();
     void parseJson();
     void parseJsonToVariant();
 
@@ -105,6 +106,20 @@ void BenchmarkQtBinaryJson::parseNumbers()
     }
 }
 
+void BenchmarkQtBinaryJson::writeNumbers()
+{
+    QString testFile = QFINDTESTDATA("numbers.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file numbers.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    QVERIFY(!doc.isNull());
+
+    QBENCHMARK {
+        QByteArray json = doc.toJson(QJsonDocument::Compact);
+    }
+}
+
 void BenchmarkQtBinaryJson::parseJson()
 {
     QString testFile = QFINDTESTDATA("test.json");
@@ -96,6 +96,59 @@ int EventTester::foo(int bar)
     return bar + 1;
 }
 
+// Counts the calls and events posted to it from other threads
+class Sink : public QObject
+{
+    Q_OBJECT
+public:
+    Sink() : m_received(0), m_expected(0) {}
+    void expect(int count) { m_received = 0; m_expected = count; }
+
+public slots:
+    void call()
+    {
+        if (++m_received == m_expected)
+            QTestEventLoop::instance().exitLoop();
+    }
+
+protected:
+    bool event(QEvent *e)
+    {
+        if (e->type() != QEvent::User)
+            return QObject::event(e);
+        call();
+        return true;
+    }
+
+private:
+    int m_received;
+    int m_expected;
+};
+
+class Producer : public QThread
+{
+public:
+    Producer(Sink *sink, int count, bool queuedCalls)
+        : m_sink(sink), m_count(count), m_queuedCalls(queuedCalls)
+    { }
+
+protected:
+    void run()
+    {
+        for (int i = 0; i < m_count; ++i) {
+            if (m_queuedCalls)
+                QMetaObject::invokeMethod(m_sink, "call", Qt::QueuedConnection);
+            else
+                QCoreApplication::postEvent(m_sink, new QEvent(QEvent::User));
+        }
+    }
+
+private:
+    Sink *m_sink;
+    int m_count;
+    bool m_queuedCalls;
+};
+
 class EventsBench : public QObject
 {
     Q_OBJECT
@@ -109,6 +162,8 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+    void postFromThreads_data();
+    void postFromThreads();
 };
 
 void EventsBench::initTestCase()
@@ -182,6 +237,42 @@ void EventsBench::postEvent()
     }
 }
 
+void EventsBench::postFromThreads_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<bool>("queuedCalls");
+
+    for (int threads = 1; threads <= 8; threads *= 2) {
+        QTest::newRow(qPrintable(QString::fromLatin1("events, %1 threads").arg(threads)))
+            << threads << false;
+        QTest::newRow(qPrintable(QString::fromLatin1("queued calls, %1 threads").arg(threads)))
+            << threads << true;
+    }
+}
+
+// N threads post to one object in the main thread, which drains them
+void EventsBench::postFromThreads()
+{
+    QFETCH(int, threads);
+    QFETCH(bool, queuedCalls);
+
+    const int perThread = 20000;
+    Sink sink;
+    QBENCHMARK {
+        sink.expect(threads * perThread);
+        QVector<Producer *> producers;
+        for (int i = 0; i < threads; ++i) {
+            producers << new Producer(&sink, perThread, queuedCalls);
+            producers.last()->start();
+        }
+        QTestEventLoop::instance().enterLoop(60);
+        for (int i = 0; i < threads; ++i)
+            producers.at(i)->wait();
+        qDeleteAll(producers);
+        QVERIFY(!QTestEventLoop::instance().timeout());
+    }
+}
+
 QTEST_MAIN(EventsBench)
 
 #include "main.moc"
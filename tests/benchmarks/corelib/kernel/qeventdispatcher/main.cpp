@@ -0,0 +1,211 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSocketNotifier>
+#include <QtCore/QThread>
+#include <QtCore/QVector>
+#include <QtTest/QtTest>
+
+#include <private/qeventdispatcher_unix_p.h>
+#ifdef Q_OS_LINUX
+#include <private/qeventdispatcher_epoll_p.h>
+#endif
+
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Owns the sockets and notifiers; lives in a thread with the
+// dispatcher under test.
+class SocketWorker : public QObject
+{
+    Q_OBJECT
+public:
+    SocketWorker() : received(0) {}
+    ~SocketWorker() { teardown(); }
+
+    QVector<int> fds;
+    QVector<int> writeEnds;
+    int received;
+    bool ok;
+
+public slots:
+    // Idle sockets are unbound datagram sockets that never become readable;
+    // the active ones are socket pairs spread evenly between them.
+    void setup(int idle, int active)
+    {
+        ok = true;
+        const int total = idle + active;
+        const int stride = total / active;
+        for (int i = 0; i < total; ++i) {
+            int fd;
+            if (i % stride == 0 && writeEnds.size() < active) {
+                int pair[2];
+                if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == -1) {
+                    ok = false;
+                    return;
+                }
+                fds << pair[1];
+                writeEnds << pair[1];
+                fd = pair[0];
+            } else {
+                fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+                if (fd == -1) {
+                    ok = false;
+                    return;
+                }
+            }
+            fds << fd;
+            QSocketNotifier *n = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+            connect(n, SIGNAL(activated(int)), SLOT(readActivated(int)));
+        }
+    }
+
+    void teardown()
+    {
+        qDeleteAll(findChildren<QSocketNotifier *>());
+        for (int i = 0; i < fds.size(); ++i)
+            ::close(fds.at(i));
+        fds.clear();
+        writeEnds.clear();
+    }
+
+    // writes to every active socket and waits until all of them have
+    // been serviced
+    void round()
+    {
+        received = 0;
+        for (int i = 0; i < writeEnds.size(); ++i)
+            ::write(writeEnds.at(i), "x", 1);
+        while (received < writeEnds.size())
+            thread()->eventDispatcher()->processEvents(QEventLoop::WaitForMoreEvents);
+    }
+
+    void readActivated(int fd)
+    {
+        char c;
+        if (::read(fd, &c, 1) == 1)
+            ++received;
+    }
+};
+
+class tst_QEventDispatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void activeSockets_data();
+    void activeSockets();
+};
+
+void tst_QEventDispatcher::initTestCase()
+{
+    rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = qMin<rlim_t>(limit.rlim_max, 32768);
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+void tst_QEventDispatcher::activeSockets_data()
+{
+    QTest::addColumn<bool>("epoll");
+    QTest::addColumn<int>("idle");
+    QTest::addColumn<int>("active");
+
+    QTest::newRow("select-0-100") << false << 0 << 100;
+    QTest::newRow("select-400-100") << false << 400 << 100;
+#ifdef Q_OS_LINUX
+    QTest::newRow("epoll-0-100") << true << 0 << 100;
+    QTest::newRow("epoll-400-100") << true << 400 << 100;
+    QTest::newRow("epoll-10000-100") << true << 10000 << 100;
+#endif
+}
+
+void tst_QEventDispatcher::activeSockets()
+{
+    QFETCH(bool, epoll);
+    QFETCH(int, idle);
+    QFETCH(int, active);
+
+    rlimit limit;
+    QVERIFY(::getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    if (rlim_t(idle + 2 * active + 64) > limit.rlim_cur)
+        QSKIP("Not enough file descriptors available");
+
+    QThread thread;
+#ifdef Q_OS_LINUX
+    if (epoll)
+        thread.setEventDispatcher(new QEventDispatcherEpoll);
+    else
+#endif
+        thread.setEventDispatcher(new QEventDispatcherUNIX);
+
+    SocketWorker worker;
+    worker.moveToThread(&thread);
+    thread.start();
+
+    QMetaObject::invokeMethod(&worker, "setup", Qt::BlockingQueuedConnection,
+                              Q_ARG(int, idle), Q_ARG(int, active));
+    QVERIFY(worker.ok);
+    // select() cannot watch descriptors at or above FD_SETSIZE
+    if (!epoll && worker.fds.last() >= int(FD_SETSIZE)) {
+        QMetaObject::invokeMethod(&worker, "teardown", Qt::BlockingQueuedConnection);
+        thread.quit();
+        thread.wait();
+        QSKIP("Descriptors exceed FD_SETSIZE");
+    }
+
+    QBENCHMARK {
+        QMetaObject::invokeMethod(&worker, "round", Qt::BlockingQueuedConnection);
+    }
+
+    QMetaObject::invokeMethod(&worker, "teardown", Qt::BlockingQueuedConnection);
+    thread.quit();
+    thread.wait();
+}
+
+QTEST_MAIN(tst_QEventDispatcher)
+
+#include "main.moc"
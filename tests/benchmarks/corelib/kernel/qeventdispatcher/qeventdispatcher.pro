@@ -0,0 +1,5 @@
+TARGET = tst_bench_qeventdispatcher
+QT = core-private testlib
+
+SOURCES += main.cpp
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
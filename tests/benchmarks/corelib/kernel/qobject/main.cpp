@@ -62,6 +62,10 @@ private slots:
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
     void receiver_destroyed_benchmark();
+    void queued_signal_benchmark_data();
+    void queued_signal_benchmark();
+    void concurrent_signal_benchmark_data();
+    void concurrent_signal_benchmark();
 };
 
 struct Functor {
@@ -246,6 +250,60 @@ void QObjectBenchmark::receiver_destroyed_benchmark()
     }
 }
 
+void QObjectBenchmark::queued_signal_benchmark_data()
+{
+    QTest::addColumn<int>("type");
+    QTest::newRow("queued") << int(Qt::QueuedConnection);
+    QTest::newRow("queued coalesced") << int(Qt::QueuedCoalescedConnection);
+}
+
+void QObjectBenchmark::queued_signal_benchmark()
+{
+    QFETCH(int, type);
+    QBENCHMARK {
+        ValueEmitter emitter(SignalsAndSlotsBenchmarkConstant / 10);
+        Object receiver;
+        QObject::connect(&emitter, SIGNAL(valueChanged(int)), &receiver, SLOT(setValue(int)),
+                         Qt::ConnectionType(type));
+        // finished() is queued behind the last call
+        QEventLoop loop;
+        QObject::connect(&emitter, SIGNAL(finished()), &loop, SLOT(quit()));
+        emitter.start();
+        loop.exec();
+        emitter.wait();
+    }
+}
+
+void QObjectBenchmark::concurrent_signal_benchmark_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+}
+
+void QObjectBenchmark::concurrent_signal_benchmark()
+{
+    QFETCH(int, threadCount);
+    Object sender;
+    Object receiver;
+    QObject::connect(&sender, SIGNAL(signal0()), &receiver, SLOT(slot0()), Qt::DirectConnection);
+
+    // the threads share the work, so that the time per emission shows how
+    // well emissions of the same signal scale
+    const int count = SignalsAndSlotsBenchmarkConstant / threadCount;
+    QBENCHMARK {
+        QVector<SignalEmitter *> emitters;
+        for (int i = 0; i < threadCount; ++i)
+            emitters.append(new SignalEmitter(&sender, count));
+        for (int i = 0; i < threadCount; ++i)
+            emitters.at(i)->start();
+        for (int i = 0; i < threadCount; ++i)
+            emitters.at(i)->wait();
+        qDeleteAll(emitters);
+    }
+}
+
 QTEST_MAIN(QObjectBenchmark)
 
 #include "main.moc"
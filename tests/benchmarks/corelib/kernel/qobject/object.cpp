@@ -66,3 +66,17 @@ void Object::slot8()
 { }
 void Object::slot9()
 { }
+void Object::setValue(int value)
+{ this->value = value; }
+
+void ValueEmitter::run()
+{
+    for (int i = 1; i <= count; ++i)
+        emit valueChanged(i);
+}
+
+void SignalEmitter::run()
+{
+    for (int i = 0; i < count; ++i)
+        sender->emitSignal0();
+}
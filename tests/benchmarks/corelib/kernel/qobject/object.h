@@ -42,11 +42,15 @@
 #define OBJECT_H
 
 #include <qobject.h>
+#include <qthread.h>
 
 class Object : public QObject
 {
     Q_OBJECT
 public:
+    Object() : value(0) { }
+    int value;
+
     void emitSignal0();
     void emitSignal1();
 signals:
@@ -71,6 +75,29 @@ public slots:
     void slot7();
     void slot8();
     void slot9();
+    void setValue(int value);
+};
+
+class ValueEmitter : public QThread
+{
+    Q_OBJECT
+public:
+    explicit ValueEmitter(int count) : count(count) { }
+    const int count;
+protected:
+    void run();
+signals:
+    void valueChanged(int value);
+};
+
+class SignalEmitter : public QThread
+{
+public:
+    SignalEmitter(Object *sender, int count) : sender(sender), count(count) { }
+    Object * const sender;
+    const int count;
+protected:
+    void run();
 };
 
 #endif // OBJECT_H
@@ -0,0 +1,171 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QVector>
+#include <QtTest/QtTest>
+
+// Stands in for objects that keep a timeout running, e.g. one per
+// network connection.
+class TimerOwner : public QObject
+{
+public:
+    TimerOwner() : fired(0) {}
+    int fired;
+
+protected:
+    void timerEvent(QTimerEvent *)
+    {
+        ++fired;
+    }
+};
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void registerTimers_data();
+    void registerTimers();
+    void restartTimer_data();
+    void restartTimer();
+    void fireWithManyIdle_data();
+    void fireWithManyIdle();
+
+private:
+    void startIdleTimers(TimerOwner *owner, int count, Qt::TimerType type);
+};
+
+// Intervals between 30 s and 60 s so that none of them fires while we
+// measure; spread so that insertion order and expiry order differ.
+void tst_QTimer::startIdleTimers(TimerOwner *owner, int count, Qt::TimerType type)
+{
+    for (int i = 0; i < count; ++i)
+        owner->startTimer(30000 + (i * 7919) % 30000, type);
+}
+
+static void addTimerRows()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("type");
+
+    QTest::newRow("precise-1000") << 1000 << int(Qt::PreciseTimer);
+    QTest::newRow("precise-100000") << 100000 << int(Qt::PreciseTimer);
+    QTest::newRow("coarse-1000") << 1000 << int(Qt::CoarseTimer);
+    QTest::newRow("coarse-100000") << 100000 << int(Qt::CoarseTimer);
+}
+
+void tst_QTimer::registerTimers_data()
+{
+    addTimerRows();
+}
+
+// starts and then kills count timers, each owned by its own object
+void tst_QTimer::registerTimers()
+{
+    QFETCH(int, count);
+    QFETCH(int, type);
+
+    QVector<TimerOwner *> owners(count);
+    for (int i = 0; i < count; ++i)
+        owners[i] = new TimerOwner;
+    QVector<int> ids(count);
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            ids[i] = owners.at(i)->startTimer(30000 + (i * 7919) % 30000, Qt::TimerType(type));
+        for (int i = 0; i < count; ++i)
+            owners.at(i)->killTimer(ids.at(i));
+    }
+    qDeleteAll(owners);
+}
+
+void tst_QTimer::restartTimer_data()
+{
+    addTimerRows();
+}
+
+// restarts one timer while count others are registered, like a connection
+// pushing back its timeout whenever data arrives
+void tst_QTimer::restartTimer()
+{
+    QFETCH(int, count);
+    QFETCH(int, type);
+
+    TimerOwner idle;
+    startIdleTimers(&idle, count, Qt::TimerType(type));
+
+    TimerOwner owner;
+    int id = owner.startTimer(45000, Qt::TimerType(type));
+    QBENCHMARK {
+        owner.killTimer(id);
+        id = owner.startTimer(45000, Qt::TimerType(type));
+    }
+    owner.killTimer(id);
+}
+
+void tst_QTimer::fireWithManyIdle_data()
+{
+    addTimerRows();
+}
+
+// cost of one event loop iteration that fires a zero timer while count
+// other timers are waiting
+void tst_QTimer::fireWithManyIdle()
+{
+    QFETCH(int, count);
+    QFETCH(int, type);
+
+    TimerOwner idle;
+    startIdleTimers(&idle, count, Qt::TimerType(type));
+
+    TimerOwner owner;
+    const int id = owner.startTimer(0);
+    QBENCHMARK {
+        QCoreApplication::processEvents();
+    }
+    owner.killTimer(id);
+    QVERIFY(owner.fired > 0);
+    QCOMPARE(idle.fired, 0);
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "main.moc"
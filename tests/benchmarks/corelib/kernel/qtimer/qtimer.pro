@@ -0,0 +1,5 @@
+TARGET = tst_bench_qtimer
+QT = core testlib
+
+SOURCES += main.cpp
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -0,0 +1,185 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QtCore>
+#include <QtTest/QtTest>
+
+// Lookups in a hash shared by several threads, the way caches and
+// registries protected by a lock are used.
+
+enum LockType {
+    MutexLock,
+    ReadWriteLock
+};
+
+class LookupThread : public QThread
+{
+public:
+    LookupThread(LockType lockType, QMutex *mutex, QReadWriteLock *readWriteLock,
+                 QHash<int, int> *hash, int iterations, int writeInterval)
+        : lockType(lockType), mutex(mutex), readWriteLock(readWriteLock), hash(hash),
+          iterations(iterations), writeInterval(writeInterval), sum(0)
+    { }
+
+    void run()
+    {
+        for (int i = 0; i < iterations; ++i) {
+            const bool write = writeInterval && i % writeInterval == 0;
+            if (lockType == MutexLock)
+                mutex->lock();
+            else if (write)
+                readWriteLock->lockForWrite();
+            else
+                readWriteLock->lockForRead();
+
+            if (write)
+                hash->insert(i & 0xff, i);
+            else
+                sum += hash->value(i & 0xff);
+
+            if (lockType == MutexLock)
+                mutex->unlock();
+            else
+                readWriteLock->unlock();
+        }
+    }
+
+    const LockType lockType;
+    QMutex * const mutex;
+    QReadWriteLock * const readWriteLock;
+    QHash<int, int> * const hash;
+    const int iterations;
+    const int writeInterval;
+    int sum;
+};
+
+class tst_QReadWriteLock : public QObject
+{
+    Q_OBJECT
+private slots:
+    void uncontended_data();
+    void uncontended();
+    void lookups_data();
+    void lookups();
+};
+
+void tst_QReadWriteLock::uncontended_data()
+{
+    QTest::addColumn<int>("lockType");
+    QTest::addColumn<bool>("write");
+
+    QTest::newRow("QMutex") << int(MutexLock) << false;
+    QTest::newRow("QReadWriteLock, read") << int(ReadWriteLock) << false;
+    QTest::newRow("QReadWriteLock, write") << int(ReadWriteLock) << true;
+}
+
+void tst_QReadWriteLock::uncontended()
+{
+    QFETCH(int, lockType);
+    QFETCH(bool, write);
+
+    QMutex mutex;
+    QReadWriteLock readWriteLock;
+    if (lockType == MutexLock) {
+        QBENCHMARK {
+            mutex.lock();
+            mutex.unlock();
+        }
+    } else if (write) {
+        QBENCHMARK {
+            readWriteLock.lockForWrite();
+            readWriteLock.unlock();
+        }
+    } else {
+        QBENCHMARK {
+            readWriteLock.lockForRead();
+            readWriteLock.unlock();
+        }
+    }
+}
+
+void tst_QReadWriteLock::lookups_data()
+{
+    QTest::addColumn<int>("lockType");
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<int>("writeInterval");
+
+    for (int threadCount = 1; threadCount <= 64; threadCount *= 2) {
+        QTest::newRow(qPrintable(QString::fromLatin1("QMutex, %1 threads").arg(threadCount)))
+                << int(MutexLock) << threadCount << 0;
+        QTest::newRow(qPrintable(QString::fromLatin1("QReadWriteLock, %1 threads").arg(threadCount)))
+                << int(ReadWriteLock) << threadCount << 0;
+        QTest::newRow(qPrintable(QString::fromLatin1("QReadWriteLock, 1% writes, %1 threads").arg(threadCount)))
+                << int(ReadWriteLock) << threadCount << 100;
+    }
+}
+
+// Each thread does the same number of lookups, so the time stays the same
+// as long as the lock lets the threads run in parallel.
+void tst_QReadWriteLock::lookups()
+{
+    QFETCH(int, lockType);
+    QFETCH(int, threadCount);
+    QFETCH(int, writeInterval);
+
+    QMutex mutex;
+    QReadWriteLock readWriteLock;
+    QHash<int, int> hash;
+    for (int i = 0; i < 0x100; ++i)
+        hash.insert(i, i);
+
+    QBENCHMARK {
+        QVector<LookupThread *> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.append(new LookupThread(LockType(lockType), &mutex, &readWriteLock, &hash,
+                                            10000, writeInterval));
+        }
+        for (int i = 0; i < threadCount; ++i)
+            threads.at(i)->start();
+        for (int i = 0; i < threadCount; ++i)
+            threads.at(i)->wait();
+        qDeleteAll(threads);
+    }
+}
+
+QTEST_MAIN(tst_QReadWriteLock)
+
+#include "tst_qreadwritelock.moc"
@@ -53,6 +53,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void tinyTasks_data();
+    void tinyTasks();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -88,5 +90,53 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+static QAtomicInt tinyTaskCount;
+
+// Starts two more of itself until the given depth is reached, so that
+// nearly all tasks are started from within the pool.
+class FanOutRunnable : public QRunnable
+{
+public:
+    FanOutRunnable(QThreadPool *pool, int depth)
+        : pool(pool), depth(depth)
+    { }
+
+    void run() Q_DECL_OVERRIDE {
+        if (depth > 0) {
+            pool->start(new FanOutRunnable(pool, depth - 1));
+            pool->start(new FanOutRunnable(pool, depth - 1));
+        }
+        tinyTaskCount.ref();
+    }
+
+private:
+    QThreadPool *pool;
+    int depth;
+};
+
+void tst_QThreadPool::tinyTasks_data()
+{
+    QTest::addColumn<bool>("workStealing");
+
+    QTest::newRow("shared queue") << false;
+    QTest::newRow("work stealing") << true;
+}
+
+void tst_QThreadPool::tinyTasks()
+{
+    QFETCH(bool, workStealing);
+
+    // 2^20 - 1 tasks, about one million
+    const int depth = 19;
+    QThreadPool threadPool;
+    threadPool.setWorkStealingEnabled(workStealing);
+    QBENCHMARK {
+        tinyTaskCount.store(0);
+        threadPool.start(new FanOutRunnable(&threadPool, depth));
+        threadPool.waitForDone();
+    }
+    QCOMPARE(tinyTaskCount.load(), (2 << depth) - 1);
+}
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
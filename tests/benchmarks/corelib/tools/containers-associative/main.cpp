@@ -39,9 +39,19 @@
 **
 ****************************************************************************/
 #include <QString>
+#include <QFlatHash>
+#include <QFlatMap>
 
 #include <qtest.h>
 
+enum ContainerType {
+    HashContainer,
+    MapContainer,
+    FlatHashContainer,
+    FlatMapContainer
+};
+Q_DECLARE_METATYPE(ContainerType)
+
 class tst_associative_containers : public QObject
 {
     Q_OBJECT
@@ -50,6 +60,12 @@ private slots:
     void insert();
     void lookup_data();
     void lookup();
+    void lookupLarge_data();
+    void lookupLarge();
+    void iterate_data();
+    void iterate();
+    void constructUnsorted_data();
+    void constructUnsorted();
 };
 
 template <typename T>
@@ -63,32 +79,45 @@ void testInsert(int size)
     }
 }
 
-void tst_associative_containers::insert_data()
+static void addContainerRows()
 {
-    QTest::addColumn<bool>("useHash");
+    QTest::addColumn<ContainerType>("container");
     QTest::addColumn<int>("size");
 
     for (int size = 10; size < 20000; size += 100) {
 
         const QByteArray sizeString = QByteArray::number(size);
 
-        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
-        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
+        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << HashContainer << size;
+        QTest::newRow(QByteArray("map--" + sizeString).constData()) << MapContainer << size;
+        QTest::newRow(QByteArray("flathash--" + sizeString).constData()) << FlatHashContainer << size;
+        QTest::newRow(QByteArray("flatmap--" + sizeString).constData()) << FlatMapContainer << size;
     }
 }
 
+void tst_associative_containers::insert_data()
+{
+    addContainerRows();
+}
+
 void tst_associative_containers::insert()
 {
-    QFETCH(bool, useHash);
+    QFETCH(ContainerType, container);
     QFETCH(int, size);
 
-    QHash<int, int> testHash;
-    QMap<int, int> testMap;
-
-    if (useHash) {
+    switch (container) {
+    case HashContainer:
         testInsert<QHash<int, int> >(size);
-    } else {
+        break;
+    case MapContainer:
         testInsert<QMap<int, int> >(size);
+        break;
+    case FlatHashContainer:
+        testInsert<QFlatHash<int, int> >(size);
+        break;
+    case FlatMapContainer:
+        testInsert<QFlatMap<int, int> >(size);
+        break;
     }
 }
 
@@ -97,16 +126,7 @@ void tst_associative_containers::lookup_data()
 //    setReportType(LineChartReport);
 //    setChartTitle("Time to call value(), with an increasing number of items in the container");
 
-    QTest::addColumn<bool>("useHash");
-    QTest::addColumn<int>("size");
-
-    for (int size = 10; size < 20000; size += 100) {
-
-        const QByteArray sizeString = QByteArray::number(size);
-
-        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
-        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
-    }
+    addContainerRows();
 }
 
 template <typename T>
@@ -128,14 +148,185 @@ void testLookup(int size)
 
 void tst_associative_containers::lookup()
 {
-    QFETCH(bool, useHash);
+    QFETCH(ContainerType, container);
     QFETCH(int, size);
 
-    if (useHash) {
+    switch (container) {
+    case HashContainer:
         testLookup<QHash<int, int> >(size);
-    } else {
+        break;
+    case MapContainer:
         testLookup<QMap<int, int> >(size);
+        break;
+    case FlatHashContainer:
+        testLookup<QFlatHash<int, int> >(size);
+        break;
+    case FlatMapContainer:
+        testLookup<QFlatMap<int, int> >(size);
+        break;
+    }
+}
+
+void tst_associative_containers::lookupLarge_data()
+{
+    QTest::addColumn<ContainerType>("container");
+    QTest::addColumn<int>("size");
+
+    for (int size = 100000; size <= 1000000; size *= 10) {
+        const QByteArray sizeString = QByteArray::number(size);
+
+        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << HashContainer << size;
+        QTest::newRow(QByteArray("map--" + sizeString).constData()) << MapContainer << size;
+        QTest::newRow(QByteArray("flathash--" + sizeString).constData()) << FlatHashContainer << size;
+        QTest::newRow(QByteArray("flatmap--" + sizeString).constData()) << FlatMapContainer << size;
+    }
+}
+
+template <typename T>
+inline void reserve(T &container, int size)
+{
+    container.reserve(size);
+}
+
+template <>
+inline void reserve(QMap<int, int> &, int)
+{
+}
+
+template <typename T>
+void testLookupLarge(int size)
+{
+    T container;
+    reserve(container, size);
+
+    // spread the keys so that lookups don't walk memory sequentially
+    for (int i = 0; i < size; ++i)
+        container.insert(i * 1021, i);
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < size; ++i)
+            sum += container.value(((i * 31) % size) * 1021);
+    }
+    QVERIFY(sum > 0);
+}
+
+void tst_associative_containers::lookupLarge()
+{
+    QFETCH(ContainerType, container);
+    QFETCH(int, size);
+
+    switch (container) {
+    case HashContainer:
+        testLookupLarge<QHash<int, int> >(size);
+        break;
+    case FlatHashContainer:
+        testLookupLarge<QFlatHash<int, int> >(size);
+        break;
+    case MapContainer:
+        testLookupLarge<QMap<int, int> >(size);
+        break;
+    case FlatMapContainer:
+        testLookupLarge<QFlatMap<int, int> >(size);
+        break;
+    }
+}
+
+void tst_associative_containers::iterate_data()
+{
+    QTest::addColumn<ContainerType>("container");
+    QTest::addColumn<int>("size");
+
+    const int size = 1000000;
+    QTest::newRow("hash") << HashContainer << size;
+    QTest::newRow("map") << MapContainer << size;
+    QTest::newRow("flathash") << FlatHashContainer << size;
+    QTest::newRow("flatmap") << FlatMapContainer << size;
+}
+
+template <typename T>
+void testIterate(int size)
+{
+    T container;
+    for (int i = 0; i < size; ++i)
+        container.insert(i, i);
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        for (typename T::const_iterator it = container.constBegin(); it != container.constEnd(); ++it)
+            sum += it.value();
+    }
+    QVERIFY(sum > 0);
+}
+
+void tst_associative_containers::iterate()
+{
+    QFETCH(ContainerType, container);
+    QFETCH(int, size);
+
+    switch (container) {
+    case HashContainer:
+        testIterate<QHash<int, int> >(size);
+        break;
+    case MapContainer:
+        testIterate<QMap<int, int> >(size);
+        break;
+    case FlatHashContainer:
+        testIterate<QFlatHash<int, int> >(size);
+        break;
+    case FlatMapContainer:
+        testIterate<QFlatMap<int, int> >(size);
+        break;
+    }
+}
+
+void tst_associative_containers::constructUnsorted_data()
+{
+    QTest::addColumn<ContainerType>("container");
+    QTest::addColumn<int>("size");
+
+    for (int size = 1000; size <= 1000000; size *= 10) {
+        const QByteArray sizeString = QByteArray::number(size);
+
+        QTest::newRow(QByteArray("map--" + sizeString).constData()) << MapContainer << size;
+        QTest::newRow(QByteArray("flatmap--" + sizeString).constData()) << FlatMapContainer << size;
+    }
+}
+
+// Builds a sorted container from keys in random order: one insert() per
+// item for QMap, a single sort for the QFlatMap bulk constructor.
+void tst_associative_containers::constructUnsorted()
+{
+    QFETCH(ContainerType, container);
+    QFETCH(int, size);
+
+    QVector<int> keys(size);
+    QVector<int> values(size);
+    for (int i = 0; i < size; ++i) {
+        keys[i] = (i * 7919) % size;
+        values[i] = i;
+    }
+
+    int result = 0;
+    switch (container) {
+    case MapContainer:
+        QBENCHMARK {
+            QMap<int, int> map;
+            for (int i = 0; i < size; ++i)
+                map.insert(keys.at(i), values.at(i));
+            result = map.size();
+        }
+        break;
+    case FlatMapContainer:
+        QBENCHMARK {
+            QFlatMap<int, int> map(keys, values);
+            result = map.size();
+        }
+        break;
+    default:
+        QSKIP("Not applicable");
     }
+    QVERIFY(result > 0);
 }
 
 QTEST_MAIN(tst_associative_containers)
@@ -1,4 +1,4 @@
 TARGET = tst_bench_qalgorithms
-QT = core testlib
+QT = core testlib concurrent
 SOURCES = tst_qalgorithms.cpp
 DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -47,6 +47,8 @@
 #include <sstream>
 #include <algorithm>
 #include <qalgorithms.h>
+#include <numeric>
+#include <QtConcurrent/qtconcurrentalgorithms.h>
 #include <QStringList>
 #include <QString>
 #include <QVector>
@@ -62,6 +64,11 @@ private slots:
 
     void sort_data();
     void sort();
+
+    void largeSort_data();
+    void largeSort();
+    void largeScan_data();
+    void largeScan();
 };
 
 template <typename DataType>
@@ -134,6 +141,51 @@ void tst_QAlgorithms::sort()
     }
 }
 
+void tst_QAlgorithms::largeSort_data()
+{
+    const int dataSize = 1000000;
+    QTest::addColumn<QVector<int> >("unsorted");
+    QTest::addColumn<bool>("concurrent");
+    QTest::newRow("Random, std::stable_sort") << (generateData<int>("Random", dataSize)) << false;
+    QTest::newRow("Random, QtConcurrent::sort") << (generateData<int>("Random", dataSize)) << true;
+    QTest::newRow("Almost Sorted, std::stable_sort") << (generateData<int>("Almost Sorted", dataSize)) << false;
+    QTest::newRow("Almost Sorted, QtConcurrent::sort") << (generateData<int>("Almost Sorted", dataSize)) << true;
+}
+
+void tst_QAlgorithms::largeSort()
+{
+    QFETCH(QVector<int>, unsorted);
+    QFETCH(bool, concurrent);
+
+    QBENCHMARK {
+        QVector<int> sorted = unsorted;
+        if (concurrent)
+            QtConcurrent::sort(sorted.begin(), sorted.end()).waitForFinished();
+        else
+            std::stable_sort(sorted.begin(), sorted.end());
+    }
+}
+
+void tst_QAlgorithms::largeScan_data()
+{
+    QTest::addColumn<bool>("concurrent");
+    QTest::newRow("std::partial_sum") << false;
+    QTest::newRow("QtConcurrent::inclusiveScan") << true;
+}
+
+void tst_QAlgorithms::largeScan()
+{
+    QFETCH(bool, concurrent);
+    const QVector<int> data = generateData<int>("Duplicates", 10000000);
+    QVector<int> sums(data.size());
+
+    QBENCHMARK {
+        if (concurrent)
+            QtConcurrent::inclusiveScan(data.constBegin(), data.constEnd(), sums.begin()).waitForFinished();
+        else
+            std::partial_sum(data.constBegin(), data.constEnd(), sums.begin());
+    }
+}
 
 QTEST_MAIN(tst_QAlgorithms)
 #include "tst_qalgorithms.moc"
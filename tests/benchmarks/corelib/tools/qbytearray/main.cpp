@@ -42,9 +42,13 @@
 #include <QIODevice>
 #include <QFile>
 #include <QString>
+#include <QSmallByteArray>
+#include <QByteArrayMatcher>
 
 #include <qtest.h>
 
+#include "../../../../shared/malloccounter.h"
+
 
 class tst_qbytearray : public QObject
 {
@@ -52,6 +56,18 @@ class tst_qbytearray : public QObject
 private slots:
     void append();
     void append_data();
+
+    void smallArrays_data();
+    void smallArrays();
+    void smallArraysAllocations_data();
+    void smallArraysAllocations();
+
+    void indexOf_data();
+    void indexOf();
+    void matcher_data();
+    void matcher();
+    void countChar_data();
+    void countChar();
 };
 
 
@@ -81,6 +97,160 @@ void tst_qbytearray::append()
     }
 }
 
+enum ArrayType {
+    PlainArray,
+    SmallArray
+};
+Q_DECLARE_METATYPE(ArrayType)
+
+// Creates 1000 short byte arrays, such as keys read from a file.
+void tst_qbytearray::smallArrays_data()
+{
+    QTest::addColumn<ArrayType>("type");
+    QTest::addColumn<QList<QByteArray> >("keys");
+
+    static const int lengths[] = { 3, 8, 16, 23, 32, 64 };
+    for (uint i = 0; i < sizeof lengths / sizeof lengths[0]; ++i) {
+        QList<QByteArray> keys;
+        for (int j = 0; j < 1000; ++j)
+            keys << QByteArray::number(j).rightJustified(lengths[i], 'k');
+
+        const QByteArray length = QByteArray::number(lengths[i]);
+        QTest::newRow(QByteArray("qbytearray-" + length).constData()) << PlainArray << keys;
+        QTest::newRow(QByteArray("qsmallbytearray-" + length).constData()) << SmallArray << keys;
+    }
+}
+
+template <typename Array>
+static void createArrays(const QList<QByteArray> &keys, QVector<Array> &arrays)
+{
+    for (int i = 0; i < keys.size(); ++i)
+        arrays[i] = Array(keys.at(i).constData(), keys.at(i).size());
+}
+
+void tst_qbytearray::smallArrays()
+{
+    QFETCH(ArrayType, type);
+    QFETCH(QList<QByteArray>, keys);
+
+    if (type == PlainArray) {
+        QVector<QByteArray> arrays(keys.size());
+        QBENCHMARK {
+            createArrays(keys, arrays);
+        }
+    } else {
+        QVector<QSmallByteArray> arrays(keys.size());
+        QBENCHMARK {
+            createArrays(keys, arrays);
+        }
+    }
+}
+
+void tst_qbytearray::smallArraysAllocations_data()
+{
+    smallArrays_data();
+}
+
+void tst_qbytearray::smallArraysAllocations()
+{
+#ifdef QT_TESTS_HAVE_MALLOCCOUNTER
+    QFETCH(ArrayType, type);
+    QFETCH(QList<QByteArray>, keys);
+
+    int count;
+    if (type == PlainArray) {
+        QVector<QByteArray> arrays(keys.size());
+        MallocCounter counter;
+        createArrays(keys, arrays);
+        count = counter.count();
+    } else {
+        QVector<QSmallByteArray> arrays(keys.size());
+        MallocCounter counter;
+        createArrays(keys, arrays);
+        count = counter.count();
+    }
+    QTest::setBenchmarkResult(count, QTest::Events);
+#else
+    QSKIP("Counting allocations is only supported with glibc");
+#endif
+}
+
+// A multi-megabyte body of log lines, such as an HTTP response or a log
+// file being scanned for a delimiter.
+static QByteArray logBody()
+{
+    static QByteArray body;
+    if (body.isEmpty()) {
+        const QByteArray line("2013-11-07 12:34:56.789 INFO  [worker-3] GET /api/v1/items?page=7 200 OK 1532 bytes\n");
+        body.reserve(4 * 1024 * 1024);
+        while (body.size() < 4 * 1024 * 1024 - line.size())
+            body += line;
+    }
+    return body;
+}
+
+void tst_qbytearray::indexOf_data()
+{
+    QTest::addColumn<QByteArray>("needle");
+
+    // none of the needles occurs in the body, so the whole body is scanned
+    QTest::newRow("1") << QByteArray("#");
+    QTest::newRow("2") << QByteArray("\r\n");
+    QTest::newRow("4") << QByteArray("\r\n\r\n");
+    QTest::newRow("8") << QByteArray("ERROR  [");
+    QTest::newRow("16") << QByteArray("--boundary-7f3a9");
+    QTest::newRow("32") << QByteArray("Content-Disposition: form-data;");
+    QTest::newRow("64") << QByteArray("GET /api/v1/items?page=7 200 OK 1532 bytes\n2013-11-07 12:34:56.78X");
+}
+
+void tst_qbytearray::indexOf()
+{
+    QFETCH(QByteArray, needle);
+    const QByteArray body = logBody();
+
+    int result = 0;
+    QBENCHMARK {
+        result = body.indexOf(needle);
+    }
+    QCOMPARE(result, -1);
+}
+
+void tst_qbytearray::matcher_data()
+{
+    indexOf_data();
+}
+
+void tst_qbytearray::matcher()
+{
+    QFETCH(QByteArray, needle);
+    const QByteArray body = logBody();
+    const QByteArrayMatcher matcher(needle);
+
+    int result = 0;
+    QBENCHMARK {
+        result = matcher.indexIn(body);
+    }
+    QCOMPARE(result, -1);
+}
+
+void tst_qbytearray::countChar_data()
+{
+    QTest::addColumn<char>("ch");
+    QTest::newRow("newline") << '\n';
+    QTest::newRow("absent") << '#';
+}
+
+void tst_qbytearray::countChar()
+{
+    QFETCH(char, ch);
+    const QByteArray body = logBody();
+
+    int result = 0;
+    QBENCHMARK {
+        result = body.count(ch);
+    }
+    QVERIFY(result >= 0);
+}
 
 QTEST_MAIN(tst_qbytearray)
 
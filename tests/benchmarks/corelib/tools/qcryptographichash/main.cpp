@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QCryptographicHash>
+#include <QTemporaryFile>
+#include <QTest>
+
+class tst_QCryptographicHash : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void hash_data();
+    void hash();
+    void multiBuffer_data();
+    void multiBuffer();
+    void multiBufferSerial_data() { multiBuffer_data(); }
+    void multiBufferSerial();
+    void file_data();
+    void file();
+};
+
+Q_DECLARE_METATYPE(QCryptographicHash::Algorithm)
+
+static QByteArray data(int size)
+{
+    QByteArray result(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        result[i] = char(i * 131 + (i >> 8));
+    return result;
+}
+
+static void addAlgorithmRows(const char *suffix)
+{
+    static const struct {
+        const char *name;
+        QCryptographicHash::Algorithm algorithm;
+    } algorithms[] = {
+        { "md5", QCryptographicHash::Md5 },
+        { "sha1", QCryptographicHash::Sha1 },
+        { "sha256", QCryptographicHash::Sha256 },
+        { "sha512", QCryptographicHash::Sha512 },
+        { "sha3_256", QCryptographicHash::Sha3_256 }
+    };
+    for (uint i = 0; i < sizeof algorithms / sizeof *algorithms; ++i)
+        QTest::newRow(QByteArray(algorithms[i].name).append(suffix))
+                << algorithms[i].algorithm;
+}
+
+void tst_QCryptographicHash::hash_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<int>("size");
+
+    static const int sizes[] = { 64, 4096, 1024 * 1024 };
+    for (uint i = 0; i < sizeof sizes / sizeof *sizes; ++i) {
+        const QByteArray suffix = '-' + QByteArray::number(sizes[i]);
+        QTest::newRow(("md5" + suffix).constData()) << QCryptographicHash::Md5 << sizes[i];
+        QTest::newRow(("sha1" + suffix).constData()) << QCryptographicHash::Sha1 << sizes[i];
+        QTest::newRow(("sha256" + suffix).constData()) << QCryptographicHash::Sha256 << sizes[i];
+        QTest::newRow(("sha512" + suffix).constData()) << QCryptographicHash::Sha512 << sizes[i];
+        QTest::newRow(("sha3_256" + suffix).constData()) << QCryptographicHash::Sha3_256 << sizes[i];
+    }
+}
+
+void tst_QCryptographicHash::hash()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    QFETCH(int, size);
+    const QByteArray input = data(size);
+
+    QBENCHMARK {
+        QCryptographicHash::hash(input, algorithm);
+    }
+}
+
+void tst_QCryptographicHash::multiBuffer_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    addAlgorithmRows("");
+}
+
+// 256 chunks of 4 KB, as when hashing a file in fixed-size pieces
+static QList<QByteArray> chunks()
+{
+    const QByteArray input = data(1024 * 1024);
+    QList<QByteArray> result;
+    for (int i = 0; i < input.size(); i += 4096)
+        result << input.mid(i, 4096);
+    return result;
+}
+
+void tst_QCryptographicHash::multiBuffer()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    const QList<QByteArray> input = chunks();
+
+    QBENCHMARK {
+        QCryptographicHash::hash(input, algorithm);
+    }
+}
+
+void tst_QCryptographicHash::multiBufferSerial()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    const QList<QByteArray> input = chunks();
+
+    QBENCHMARK {
+        for (int i = 0; i < input.size(); ++i)
+            QCryptographicHash::hash(input.at(i), algorithm);
+    }
+}
+
+void tst_QCryptographicHash::file_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    addAlgorithmRows("");
+}
+
+void tst_QCryptographicHash::file()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    const QByteArray block = data(1024 * 1024);
+    for (int i = 0; i < 16; ++i)
+        QCOMPARE(file.write(block), qint64(block.size()));
+
+    QBENCHMARK {
+        QVERIFY(file.seek(0));
+        QCryptographicHash hash(algorithm);
+        QVERIFY(hash.addData(&file));
+        hash.result();
+    }
+}
+
+QTEST_MAIN(tst_QCryptographicHash)
+
+#include "main.moc"
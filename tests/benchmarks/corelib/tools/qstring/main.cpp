@@ -54,8 +54,12 @@
 
 #include <private/qsimd_p.h>
 
+#include <qsmallstring.h>
+
 #include "data.h"
 
+#include "../../../../shared/malloccounter.h"
+
 class tst_QString: public QObject
 {
     Q_OBJECT
@@ -82,6 +86,13 @@ private slots:
     void toLower();
     void toCaseFolded_data();
     void toCaseFolded();
+    void compareCaseInsensitive_data();
+    void compareCaseInsensitive();
+
+    void smallStrings_data();
+    void smallStrings();
+    void smallStringsAllocations_data();
+    void smallStringsAllocations();
 };
 
 void tst_QString::equals() const
@@ -2639,15 +2650,21 @@ void tst_QString::toUpper_data()
     QTest::newRow("300A+150<10428>") << (upperLatin1 + lowerDeseret);
 
     QTest::newRow("600<FB03> (ligature)") << lowerLigature;
+
+    QTest::newRow("header") << QString::fromLatin1("Content-Type: Application/JSON; Charset=UTF-8");
+    QTest::newRow("600 mixed") << QString(lowerLatin1 + upperLatin1).replace(QLatin1Char('a'), QLatin1String("aB"));
+    QTest::newRow("600 latin1") << QString(600, QChar(0xe4));
 }
 
 void tst_QString::toUpper()
 {
     QFETCH(QString, s);
+    QString result;
 
     QBENCHMARK {
-        s.toUpper();
+        result = s.toUpper();
     }
+    QCOMPARE(result.isEmpty(), s.isEmpty());
 }
 
 void tst_QString::toLower_data()
@@ -2658,10 +2675,12 @@ void tst_QString::toLower_data()
 void tst_QString::toLower()
 {
     QFETCH(QString, s);
+    QString result;
 
     QBENCHMARK {
-        s.toLower();
+        result = s.toLower();
     }
+    QCOMPARE(result.isEmpty(), s.isEmpty());
 }
 
 void tst_QString::toCaseFolded_data()
@@ -2672,10 +2691,125 @@ void tst_QString::toCaseFolded_data()
 void tst_QString::toCaseFolded()
 {
     QFETCH(QString, s);
+    QString result;
 
     QBENCHMARK {
-        s.toCaseFolded();
+        result = s.toCaseFolded();
     }
+    QCOMPARE(result.isEmpty(), s.isEmpty());
+}
+
+void tst_QString::compareCaseInsensitive_data()
+{
+    QTest::addColumn<QString>("a");
+    QTest::addColumn<QString>("b");
+
+    // header names, as matched by an HTTP parser
+    QTest::newRow("header-short") << QString::fromLatin1("Content-Length")
+                                  << QString::fromLatin1("content-length");
+    QTest::newRow("header-long") << QString::fromLatin1("Access-Control-Allow-Credentials")
+                                 << QString::fromLatin1("access-control-allow-credentials");
+
+    QString upper(600, QLatin1Char('A'));
+    QString lower(600, QLatin1Char('a'));
+    QTest::newRow("600 ascii") << upper << lower;
+    QTest::newRow("600 latin1") << QString(600, QChar(0xc4)) << QString(600, QChar(0xe4));
+    QTest::newRow("300 ascii+300 latin1") << (upper.left(300) + QString(300, QChar(0xc4)))
+                                          << (lower.left(300) + QString(300, QChar(0xe4)));
+}
+
+void tst_QString::compareCaseInsensitive()
+{
+    QFETCH(QString, a);
+    QFETCH(QString, b);
+    const QByteArray latin1 = b.toLatin1();
+    const QLatin1String l1(latin1);
+
+    int result = 0;
+    QBENCHMARK {
+        result += a.compare(b, Qt::CaseInsensitive);
+        result += a.compare(l1, Qt::CaseInsensitive);
+    }
+    QCOMPARE(result, 0);
+}
+
+enum StringType {
+    PlainString,
+    SmallString
+};
+Q_DECLARE_METATYPE(StringType)
+
+// Creates 1000 short strings from UTF-8 data, as a JSON parser or a model
+// reading role names would.
+void tst_QString::smallStrings_data()
+{
+    QTest::addColumn<StringType>("type");
+    QTest::addColumn<QList<QByteArray> >("keys");
+
+    static const int lengths[] = { 3, 8, 11, 16, 32 };
+    for (uint i = 0; i < sizeof lengths / sizeof lengths[0]; ++i) {
+        QList<QByteArray> keys;
+        for (int j = 0; j < 1000; ++j)
+            keys << QByteArray::number(j).rightJustified(lengths[i], 'k');
+
+        const QByteArray length = QByteArray::number(lengths[i]);
+        QTest::newRow(QByteArray("qstring-" + length).constData()) << PlainString << keys;
+        QTest::newRow(QByteArray("qsmallstring-" + length).constData()) << SmallString << keys;
+    }
+}
+
+template <typename String>
+static void createStrings(const QList<QByteArray> &keys, QVector<String> &strings)
+{
+    for (int i = 0; i < keys.size(); ++i)
+        strings[i] = String::fromUtf8(keys.at(i).constData(), keys.at(i).size());
+}
+
+void tst_QString::smallStrings()
+{
+    QFETCH(StringType, type);
+    QFETCH(QList<QByteArray>, keys);
+
+    if (type == PlainString) {
+        QVector<QString> strings(keys.size());
+        QBENCHMARK {
+            createStrings(keys, strings);
+        }
+    } else {
+        QVector<QSmallString> strings(keys.size());
+        QBENCHMARK {
+            createStrings(keys, strings);
+        }
+    }
+}
+
+void tst_QString::smallStringsAllocations_data()
+{
+    smallStrings_data();
+}
+
+void tst_QString::smallStringsAllocations()
+{
+#ifdef QT_TESTS_HAVE_MALLOCCOUNTER
+    QFETCH(StringType, type);
+    QFETCH(QList<QByteArray>, keys);
+
+    int count;
+    if (type == PlainString) {
+        QVector<QString> strings(keys.size());
+        MallocCounter counter;
+        createStrings(keys, strings);
+        count = counter.count();
+    } else {
+        QVector<QSmallString> strings(keys.size());
+        MallocCounter counter;
+        createStrings(keys, strings);
+        count = counter.count();
+    }
+    QTest::setBenchmarkResult(count, QTest::Events);
+#else
+    QSKIP("Counting allocations is only supported with glibc");
+#endif
 }
 
 QTEST_APPLESS_MAIN(tst_QString)
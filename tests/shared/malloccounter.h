@@ -0,0 +1,86 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 Digia Plc and/or its subsidiary(-ies).
+** Contact: http://www.qt-project.org/legal
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Digia.  For licensing terms and
+** conditions see http://qt.digia.com/licensing.  For further information
+** use the contact form at http://qt.digia.com/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU Lesser General Public License version 2.1 requirements
+** will be met: http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Digia gives you certain additional
+** rights.  These rights are described in the Digia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL included in the
+** packaging of this file.  Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met: http://www.gnu.org/copyleft/gpl.html.
+**
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT_TESTS_SHARED_MALLOCCOUNTER_H_INCLUDED
+#define QT_TESTS_SHARED_MALLOCCOUNTER_H_INCLUDED
+
+#include <QtCore/qatomic.h>
+#include <stdlib.h>
+
+// Counts the calls to malloc() made by the current process while a
+// MallocCounter is alive. This works by interposing malloc() itself, so the
+// header must be included by exactly one source file of a test binary.
+// Outside a MallocCounter the interposer only forwards to the C library.
+// Counting is only available with glibc, which provides __libc_malloc();
+// test code should check QT_TESTS_HAVE_MALLOCCOUNTER before using it.
+
+#if defined(__GLIBC__) && !defined(QT_TESTS_NO_MALLOCCOUNTER)
+#define QT_TESTS_HAVE_MALLOCCOUNTER
+
+extern "C" void *__libc_malloc(size_t);
+
+static QBasicAtomicInt qt_tests_mallocCounters = Q_BASIC_ATOMIC_INITIALIZER(0);
+static QBasicAtomicInt qt_tests_mallocCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+extern "C" void *malloc(size_t size)
+{
+    if (qt_tests_mallocCounters.load())
+        qt_tests_mallocCount.fetchAndAddRelaxed(1);
+    return __libc_malloc(size);
+}
+
+class MallocCounter
+{
+public:
+    MallocCounter() : m_start(qt_tests_mallocCount.load()) { qt_tests_mallocCounters.ref(); }
+    ~MallocCounter() { qt_tests_mallocCounters.deref(); }
+
+    // Allocations made by all threads since this counter was created.
+    int count() const { return qt_tests_mallocCount.load() - m_start; }
+
+private:
+    Q_DISABLE_COPY(MallocCounter)
+    const int m_start;
+};
+
+#endif
+
+#endif // QT_TESTS_SHARED_MALLOCCOUNTER_H_INCLUDED
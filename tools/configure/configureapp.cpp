@@ -171,6 +171,7 @@ Configure::Configure(int& argc, char** argv)
     dictionary[ "SSE4_2" ]          = "auto";
     dictionary[ "AVX" ]             = "auto";
     dictionary[ "AVX2" ]            = "auto";
+    dictionary[ "SHA" ]             = "auto";
     dictionary[ "IWMMXT" ]          = "auto";
     dictionary[ "SYNCQT" ]          = "auto";
     dictionary[ "CE_CRT" ]          = "no";
@@ -839,6 +840,10 @@ void Configure::parseCmdLine()
             dictionary[ "AVX2" ] = "no";
         else if (configCmdLine.at(i) == "-avx2")
             dictionary[ "AVX2" ] = "yes";
+        else if (configCmdLine.at(i) == "-no-sha")
+            dictionary[ "SHA" ] = "no";
+        else if (configCmdLine.at(i) == "-sha")
+            dictionary[ "SHA" ] = "yes";
         else if (configCmdLine.at(i) == "-no-iwmmxt")
             dictionary[ "IWMMXT" ] = "no";
         else if (configCmdLine.at(i) == "-iwmmxt")
@@ -1625,6 +1630,7 @@ void Configure::applySpecSpecifics()
         dictionary[ "SSE4_2" ]              = "no";
         dictionary[ "AVX" ]                 = "no";
         dictionary[ "AVX2" ]                = "no";
+        dictionary[ "SHA" ]                 = "no";
         dictionary[ "IWMMXT" ]              = "no";
         dictionary[ "CE_CRT" ]              = "yes";
         dictionary[ "LARGE_FILE" ]          = "no";
@@ -1917,7 +1923,9 @@ bool Configure::displayHelp()
         desc("AVX", "no",       "-no-avx",              "Do not compile with use of AVX instructions.");
         desc("AVX", "yes",      "-avx",                 "Compile with use of AVX instructions.");
         desc("AVX2", "no",      "-no-avx2",             "Do not compile with use of AVX2 instructions.");
-        desc("AVX2", "yes",     "-avx2",                "Compile with use of AVX2 instructions.\n");
+        desc("AVX2", "yes",     "-avx2",                "Compile with use of AVX2 instructions.");
+        desc("SHA", "no",       "-no-sha",              "Do not compile with use of SHA extensions instructions.");
+        desc("SHA", "yes",      "-sha",                 "Compile with use of SHA extensions instructions.\n");
         desc("OPENSSL", "no",    "-no-openssl",         "Do not compile support for OpenSSL.");
         desc("OPENSSL", "yes",   "-openssl",            "Enable run-time OpenSSL support.");
         desc("OPENSSL", "linked","-openssl-linked",     "Enable linked OpenSSL support.\n");
@@ -2172,6 +2180,8 @@ bool Configure::checkAvailability(const QString &part)
         available = tryCompileProject("common/avx");
     else if (part == "AVX2")
         available = tryCompileProject("common/avx2");
+    else if (part == "SHA")
+        available = tryCompileProject("common/sha");
     else if (part == "OPENSSL")
         available = findFile("openssl\\ssl.h");
     else if (part == "DBUS")
@@ -2314,6 +2324,8 @@ void Configure::autoDetection()
         dictionary["AVX"] = checkAvailability("AVX") ? "yes" : "no";
     if (dictionary["AVX2"] == "auto")
         dictionary["AVX2"] = checkAvailability("AVX2") ? "yes" : "no";
+    if (dictionary["SHA"] == "auto")
+        dictionary["SHA"] = checkAvailability("SHA") ? "yes" : "no";
     if (dictionary["IWMMXT"] == "auto")
         dictionary["IWMMXT"] = checkAvailability("IWMMXT") ? "yes" : "no";
     if (dictionary["NEON"] == "auto")
@@ -2923,6 +2935,8 @@ void Configure::generateCachefile()
             moduleStream << " avx";
         if (dictionary[ "AVX2" ] == "yes")
             moduleStream << " avx2";
+        if (dictionary[ "SHA" ] == "yes")
+            moduleStream << " sha";
         if (dictionary[ "IWMMXT" ] == "yes")
             moduleStream << " iwmmxt";
         if (dictionary[ "NEON" ] == "yes")
@@ -3337,6 +3351,8 @@ void Configure::generateConfigfiles()
             tmpStream << "#define QT_COMPILER_SUPPORTS_AVX" << endl;
         if (dictionary[ "AVX2" ] == "yes")
             tmpStream << "#define QT_COMPILER_SUPPORTS_AVX2" << endl;
+        if (dictionary[ "SHA" ] == "yes")
+            tmpStream << "#define QT_COMPILER_SUPPORTS_SHA" << endl;
         if (dictionary[ "IWMMXT" ] == "yes")
             tmpStream << "#define QT_COMPILER_SUPPORTS_IWMMXT" << endl;
         if (dictionary[ "NEON" ] == "yes")
@@ -3528,6 +3544,7 @@ void Configure::displayConfig()
     sout << "SSE4.2 support.............." << dictionary[ "SSE4_2" ] << endl;
     sout << "AVX support................." << dictionary[ "AVX" ] << endl;
     sout << "AVX2 support................" << dictionary[ "AVX2" ] << endl;
+    sout << "SHA support................." << dictionary[ "SHA" ] << endl;
     sout << "NEON support................" << dictionary[ "NEON" ] << endl;
     sout << "IWMMXT support.............." << dictionary[ "IWMMXT" ] << endl;
     sout << "OpenGL support.............." << dictionary[ "OPENGL" ] << endl;